@@ -18,6 +18,9 @@
 
 #include <hadesmem/detail/dump.hpp>
 #include <hadesmem/detail/filesystem.hpp>
+#if defined(HADESMEM_DETOUR_PROFILE)
+#include <hadesmem/detail/hook_profile.hpp>
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
 
 #include "callbacks.hpp"
 #include "chaiscript.hpp"
@@ -1876,6 +1879,80 @@ void HandleInputQueueEntry(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
   }
 }
 
+#if defined(HADESMEM_DETOUR_PROFILE)
+void DrawHookProfileWindow(bool* show)
+{
+  ImGui::SetNextWindowSize(ImVec2(520, 300), ImGuiSetCond_FirstUseEver);
+  if (ImGui::Begin("Hook Profile", show))
+  {
+    auto& imgui = hadesmem::cerberus::GetImguiInterface();
+    auto& registry = hadesmem::detail::GetHookProfileRegistry();
+    auto const snapshots = registry.GetSnapshots();
+
+    if (ImGui::Button("Reset"))
+    {
+      registry.Reset();
+    }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Save"))
+    {
+      try
+      {
+        auto const path = hadesmem::detail::CombinePath(
+          hadesmem::detail::GetSelfDirPath(), L"hook_profile.csv");
+        auto const file = hadesmem::detail::OpenFile<char>(path, std::ios::out);
+        if (!*file)
+        {
+          HADESMEM_DETAIL_THROW_EXCEPTION(
+            hadesmem::Error{}
+            << hadesmem::ErrorString{"Failed to create file."});
+        }
+        hadesmem::detail::WriteHookProfilesCsv(*file, snapshots);
+        imgui.LogFormat("[Info]: Saved hook profile. Path: [%s].",
+                        hadesmem::detail::WideCharToMultiByte(path).c_str());
+      }
+      catch (...)
+      {
+        imgui.LogFormat(
+          "[Error]: %s",
+          boost::current_exception_diagnostic_information().c_str());
+      }
+    }
+
+    // Timings are in TSC ticks.
+    ImGui::Separator();
+    ImGui::Columns(5, "hook_profile");
+    ImGui::Text("Target");
+    ImGui::NextColumn();
+    ImGui::Text("Calls");
+    ImGui::NextColumn();
+    ImGui::Text("Mean");
+    ImGui::NextColumn();
+    ImGui::Text("P50");
+    ImGui::NextColumn();
+    ImGui::Text("P99");
+    ImGui::NextColumn();
+    ImGui::Separator();
+    for (auto const& snapshot : snapshots)
+    {
+      ImGui::Text("%p", snapshot.target);
+      ImGui::NextColumn();
+      ImGui::Text("%llu", snapshot.num_calls);
+      ImGui::NextColumn();
+      ImGui::Text("%.0f", snapshot.GetMeanTicks());
+      ImGui::NextColumn();
+      ImGui::Text("%llu", snapshot.GetPercentileTicks(50));
+      ImGui::NextColumn();
+      ImGui::Text("%llu", snapshot.GetPercentileTicks(99));
+      ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+  }
+  ImGui::End();
+}
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
+
 void OnFrameImgui(hadesmem::cerberus::RenderApi api, void* /*device*/)
 {
   if (!ImguiInitializedAny() || !GetAllImguiVisibility())
@@ -1909,6 +1986,9 @@ void OnFrameImgui(hadesmem::cerberus::RenderApi api, void* /*device*/)
   // Move this state somwhere we can properly manage its lifetime.
   static bool show_log_window = false;
   static bool show_console_window = false;
+#if defined(HADESMEM_DETOUR_PROFILE)
+  static bool show_hook_profile_window = false;
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
 
   auto& imgui = hadesmem::cerberus::GetImguiInterface();
 
@@ -2077,6 +2157,14 @@ void OnFrameImgui(hadesmem::cerberus::RenderApi api, void* /*device*/)
     {
       show_log_window ^= 1;
     }
+
+#if defined(HADESMEM_DETOUR_PROFILE)
+    ImGui::SameLine();
+    if (ImGui::Button("Hook Profile"))
+    {
+      show_hook_profile_window ^= 1;
+    }
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
   }
   ImGui::End();
 
@@ -2092,6 +2180,13 @@ void OnFrameImgui(hadesmem::cerberus::RenderApi api, void* /*device*/)
     log.Draw("Log", &show_log_window);
   }
 
+#if defined(HADESMEM_DETOUR_PROFILE)
+  if (show_hook_profile_window)
+  {
+    DrawHookProfileWindow(&show_hook_profile_window);
+  }
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
+
   auto const& callbacks = GetOnImguiFrameCallbacks();
   callbacks.Run();
 
@@ -0,0 +1,651 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include "cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/crypto.hpp>
+#include <hadesmem/detail/filesystem.hpp>
+#include <hadesmem/detail/mapped_file.hpp>
+#include <hadesmem/error.hpp>
+
+#include "print.hpp"
+
+namespace
+{
+std::uint32_t const kCacheMagic = 0x43444D48; // 'HMDC'
+std::uint32_t const kCacheFormatVersion = 2;
+
+// Hashed from each end of the file for the partial hash.
+std::uint64_t const kPartialHashSize = 0x10000;
+
+// The data file is only compacted once it's at least this big and more than
+// half of it is no longer referenced.
+std::uint64_t const kCompactMinSize = 0x1000000;
+
+struct CacheEntry
+{
+  FileCacheKey key;
+  std::uint64_t full_hash;
+  bool warned;
+  // Where the output lives in the data file. Copies of the same file share
+  // the same output.
+  std::uint64_t data_offset;
+  std::uint64_t data_size;
+  // Whether the path was dumped or replayed this run. Entries which weren't
+  // (i.e. the file was deleted, renamed, or just not scanned) are dropped
+  // when the cache is saved.
+  bool seen;
+};
+
+std::mutex g_cache_mutex;
+bool g_cache_enabled = false;
+std::wstring g_cache_path;
+std::string g_cache_config_key;
+std::unordered_map<std::wstring, CacheEntry> g_cache_by_path;
+// Paths of entries with the same size and partial hash, for finding copies.
+std::unordered_map<std::uint64_t, std::vector<std::wstring>>
+  g_cache_by_content;
+// The outputs are kept on disk rather than in memory. The data file is only
+// appended to while the cache is open, and is replaced (with the generation
+// bumped) when it is compacted.
+std::mutex g_cache_data_mutex;
+std::unique_ptr<std::fstream> g_cache_data;
+std::uint32_t g_cache_data_generation = 0;
+std::uint64_t g_cache_data_size = 0;
+std::atomic<std::uint64_t> g_cache_hits{0};
+std::atomic<std::uint64_t> g_cache_content_hits{0};
+std::atomic<std::uint64_t> g_cache_misses{0};
+std::uint64_t g_cache_pruned = 0;
+
+std::uint64_t GetContentKey(FileCacheKey const& key)
+{
+  return key.partial_hash ^ (key.size * 0x9E3779B97F4A7C15ULL);
+}
+
+std::wstring GetDataPath(std::uint32_t generation)
+{
+  return g_cache_path + L".data." + std::to_wstring(generation);
+}
+
+template <typename T> void WritePod(std::ostream& out, T const& t)
+{
+  out.write(reinterpret_cast<char const*>(&t), sizeof(t));
+}
+
+template <typename T> bool ReadPod(std::istream& in, T& t)
+{
+  return !!in.read(reinterpret_cast<char*>(&t), sizeof(t));
+}
+
+template <typename CharT>
+void WriteString(std::ostream& out, std::basic_string<CharT> const& str)
+{
+  WritePod(out, static_cast<std::uint32_t>(str.size()));
+  out.write(reinterpret_cast<char const*>(str.data()),
+            static_cast<std::streamsize>(str.size() * sizeof(CharT)));
+}
+
+template <typename CharT>
+bool ReadString(std::istream& in, std::basic_string<CharT>& str)
+{
+  std::uint32_t size = 0;
+  if (!ReadPod(in, size))
+  {
+    return false;
+  }
+
+  // Don't trust the size from a (possibly truncated or corrupt) file enough
+  // to allocate it all up front.
+  str.clear();
+  std::size_t const kChunkSize = 0x100000;
+  while (size)
+  {
+    auto const n = (std::min)(static_cast<std::size_t>(size), kChunkSize);
+    auto const old_size = str.size();
+    str.resize(old_size + n);
+    if (!in.read(reinterpret_cast<char*>(&str[old_size]),
+                 static_cast<std::streamsize>(n * sizeof(CharT))))
+    {
+      return false;
+    }
+    size -= static_cast<std::uint32_t>(n);
+  }
+
+  return true;
+}
+
+void AddEntry(std::wstring const& path, CacheEntry const& entry)
+{
+  auto const iter = g_cache_by_path.find(path);
+  if (iter == std::end(g_cache_by_path))
+  {
+    g_cache_by_content[GetContentKey(entry.key)].push_back(path);
+  }
+  else if (GetContentKey(iter->second.key) != GetContentKey(entry.key))
+  {
+    auto& old_paths = g_cache_by_content[GetContentKey(iter->second.key)];
+    old_paths.erase(
+      std::remove(std::begin(old_paths), std::end(old_paths), path),
+      std::end(old_paths));
+    g_cache_by_content[GetContentKey(entry.key)].push_back(path);
+  }
+
+  g_cache_by_path[path] = entry;
+}
+
+void ClearEntries()
+{
+  g_cache_by_path.clear();
+  g_cache_by_content.clear();
+  g_cache_data_size = 0;
+}
+
+// Only the index (paths, keys, and where each output lives in the data file)
+// is loaded. Outputs are read from the data file on a hit.
+bool LoadIndex(std::wstring const& path, std::string const& config_key)
+{
+  auto const file =
+    hadesmem::detail::OpenFile<char>(path, std::ios::in | std::ios::binary);
+  if (!*file)
+  {
+    return false;
+  }
+
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  std::string file_config_key;
+  std::uint64_t count = 0;
+  if (!ReadPod(*file, magic) || magic != kCacheMagic ||
+      !ReadPod(*file, version) || version != kCacheFormatVersion ||
+      !ReadString(*file, file_config_key) || file_config_key != config_key ||
+      !ReadPod(*file, g_cache_data_generation) ||
+      !ReadPod(*file, g_cache_data_size) || !ReadPod(*file, count))
+  {
+    return false;
+  }
+
+  for (std::uint64_t i = 0; i < count; ++i)
+  {
+    std::wstring entry_path;
+    CacheEntry entry{};
+    std::uint8_t warned = 0;
+    if (!ReadString(*file, entry_path) || !ReadPod(*file, entry.key) ||
+        !ReadPod(*file, entry.full_hash) || !ReadPod(*file, warned) ||
+        !ReadPod(*file, entry.data_offset) ||
+        !ReadPod(*file, entry.data_size))
+    {
+      // Keep whatever was read successfully.
+      return true;
+    }
+
+    if (entry.data_offset > g_cache_data_size ||
+        entry.data_size > g_cache_data_size - entry.data_offset)
+    {
+      return false;
+    }
+
+    entry.warned = !!warned;
+    AddEntry(entry_path, entry);
+  }
+
+  return true;
+}
+
+// Opens the data file for the current generation, discarding anything past
+// the end recorded in the index (e.g. from a run which didn't finish). The
+// index is reset if the data file is missing or too short.
+void OpenDataFile()
+{
+  auto const data_path = GetDataPath(g_cache_data_generation);
+  if (g_cache_data_size)
+  {
+    g_cache_data = hadesmem::detail::OpenFile<char>(
+      data_path, std::ios::in | std::ios::out | std::ios::binary);
+    if (*g_cache_data && g_cache_data->seekg(0, std::ios::end) &&
+        static_cast<std::uint64_t>(g_cache_data->tellg()) >= g_cache_data_size)
+    {
+      return;
+    }
+
+    ClearEntries();
+  }
+
+  g_cache_data = hadesmem::detail::OpenFile<char>(
+    data_path,
+    std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!*g_cache_data)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to open cache data file."});
+  }
+}
+
+bool ReadOutput(CacheEntry const& entry, std::string& output)
+{
+  std::lock_guard<std::mutex> lock(g_cache_data_mutex);
+
+  g_cache_data->clear();
+  output.resize(static_cast<std::size_t>(entry.data_size));
+  return g_cache_data->seekg(static_cast<std::streamoff>(entry.data_offset)) &&
+         (output.empty() ||
+          g_cache_data->read(&output[0],
+                             static_cast<std::streamsize>(output.size())));
+}
+
+std::uint64_t AppendOutput(std::string const& output)
+{
+  std::lock_guard<std::mutex> lock(g_cache_data_mutex);
+
+  g_cache_data->clear();
+  if (!g_cache_data->seekp(static_cast<std::streamoff>(g_cache_data_size)) ||
+      !g_cache_data->write(output.data(),
+                           static_cast<std::streamsize>(output.size())))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to write cache data file."});
+  }
+
+  auto const offset = g_cache_data_size;
+  g_cache_data_size += output.size();
+  return offset;
+}
+
+// Copies the outputs which are still referenced into the next generation's
+// data file. Outputs shared by several paths are only copied once.
+void CompactDataFile()
+{
+  auto const new_path = GetDataPath(g_cache_data_generation + 1);
+  auto new_data = hadesmem::detail::OpenFile<char>(
+    new_path,
+    std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!*new_data)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to open cache data file."});
+  }
+
+  std::unordered_map<std::uint64_t, std::uint64_t> new_offsets;
+  std::uint64_t new_size = 0;
+  std::string output;
+  for (auto& entry : g_cache_by_path)
+  {
+    // Empty outputs can share their offset with the next output.
+    if (!entry.second.data_size)
+    {
+      entry.second.data_offset = 0;
+      continue;
+    }
+
+    auto const iter = new_offsets.find(entry.second.data_offset);
+    if (iter != std::end(new_offsets))
+    {
+      entry.second.data_offset = iter->second;
+      continue;
+    }
+
+    if (!ReadOutput(entry.second, output) ||
+        !new_data->write(output.data(),
+                         static_cast<std::streamsize>(output.size())))
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        hadesmem::Error{}
+        << hadesmem::ErrorString{"Failed to compact cache data file."});
+    }
+
+    new_offsets[entry.second.data_offset] = new_size;
+    entry.second.data_offset = new_size;
+    new_size += output.size();
+  }
+
+  if (!new_data->flush())
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to compact cache data file."});
+  }
+
+  g_cache_data = std::move(new_data);
+  ++g_cache_data_generation;
+  g_cache_data_size = new_size;
+}
+
+void WriteIndex()
+{
+  // Write to a temporary file and then replace the old index, so a crash
+  // can't leave a truncated index behind. The data it refers to has already
+  // been flushed.
+  auto const temp_path = g_cache_path + L".tmp";
+  {
+    auto const file = hadesmem::detail::OpenFile<char>(
+      temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!*file)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        hadesmem::Error{}
+        << hadesmem::ErrorString{"Failed to open cache file for output."});
+    }
+
+    WritePod(*file, kCacheMagic);
+    WritePod(*file, kCacheFormatVersion);
+    WriteString(*file, g_cache_config_key);
+    WritePod(*file, g_cache_data_generation);
+    WritePod(*file, g_cache_data_size);
+    WritePod(*file, static_cast<std::uint64_t>(g_cache_by_path.size()));
+    for (auto const& entry : g_cache_by_path)
+    {
+      WriteString(*file, entry.first);
+      WritePod(*file, entry.second.key);
+      WritePod(*file, entry.second.full_hash);
+      WritePod(*file, static_cast<std::uint8_t>(entry.second.warned));
+      WritePod(*file, entry.second.data_offset);
+      WritePod(*file, entry.second.data_size);
+    }
+
+    file->close();
+    if (!*file)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        hadesmem::Error{}
+        << hadesmem::ErrorString{"Failed to write cache file."});
+    }
+  }
+
+  if (!::MoveFileExW(
+        temp_path.c_str(), g_cache_path.c_str(), MOVEFILE_REPLACE_EXISTING))
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{} << hadesmem::ErrorString{"MoveFileExW failed."}
+                        << hadesmem::ErrorCodeWinLast{last_error});
+  }
+}
+
+// New outputs have already been appended to the data file, so saving only
+// rewrites the index, unless enough of the data file is dead (after pruning)
+// to be worth compacting.
+void SaveCache()
+{
+  std::unordered_map<std::uint64_t, std::uint64_t> live;
+  for (auto iter = std::begin(g_cache_by_path);
+       iter != std::end(g_cache_by_path);)
+  {
+    if (!iter->second.seen)
+    {
+      iter = g_cache_by_path.erase(iter);
+      ++g_cache_pruned;
+      continue;
+    }
+
+    if (iter->second.data_size)
+    {
+      live[iter->second.data_offset] = iter->second.data_size;
+    }
+    ++iter;
+  }
+  g_cache_by_content.clear();
+
+  if (!g_cache_data->flush())
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to write cache data file."});
+  }
+
+  std::uint64_t live_size = 0;
+  for (auto const& range : live)
+  {
+    live_size += range.second;
+  }
+
+  auto const old_generation = g_cache_data_generation;
+  if (g_cache_data_size >= kCompactMinSize &&
+      live_size < g_cache_data_size / 2)
+  {
+    CompactDataFile();
+  }
+
+  WriteIndex();
+
+  g_cache_data.reset();
+  if (old_generation != g_cache_data_generation)
+  {
+    ::DeleteFileW(GetDataPath(old_generation).c_str());
+  }
+}
+
+bool GetFullHashForPath(std::wstring const& path, std::uint64_t& full_hash)
+{
+  try
+  {
+    hadesmem::detail::MappedFile file;
+    file.Open(path);
+    full_hash = GetFileCacheFullHash(
+      file.GetData(), static_cast<std::size_t>(file.GetSize()));
+    return true;
+  }
+  catch (std::exception const& /*e*/)
+  {
+    return false;
+  }
+}
+}
+
+void OpenCache(std::wstring const& path, std::string const& config_key)
+{
+  g_cache_path = path;
+  g_cache_config_key = config_key;
+  ClearEntries();
+  g_cache_data_generation = 0;
+  if (!LoadIndex(path, config_key))
+  {
+    ClearEntries();
+  }
+  OpenDataFile();
+  g_cache_enabled = true;
+}
+
+void CloseCache()
+{
+  if (!g_cache_enabled)
+  {
+    return;
+  }
+
+  SaveCache();
+  g_cache_enabled = false;
+}
+
+bool IsCacheEnabled() noexcept
+{
+  return g_cache_enabled;
+}
+
+bool GetFileCacheKey(std::wstring const& path, FileCacheKey& key)
+{
+  WIN32_FILE_ATTRIBUTE_DATA attributes{};
+  if (!::GetFileAttributesExW(
+        path.c_str(), GetFileExInfoStandard, &attributes))
+  {
+    return false;
+  }
+
+  key.size = (static_cast<std::uint64_t>(attributes.nFileSizeHigh) << 32) |
+             attributes.nFileSizeLow;
+  key.last_write_time =
+    (static_cast<std::uint64_t>(attributes.ftLastWriteTime.dwHighDateTime)
+     << 32) |
+    attributes.ftLastWriteTime.dwLowDateTime;
+
+  auto const file =
+    hadesmem::detail::OpenFile<char>(path, std::ios::in | std::ios::binary);
+  if (!*file)
+  {
+    return false;
+  }
+
+  // The start of the file covers the headers, and the end covers the overlay
+  // (where installers, signatures, etc. live), which between them catch
+  // nearly every real modification without reading the whole file.
+  hadesmem::detail::XxHash64 hash;
+  std::vector<char> buf(static_cast<std::size_t>(kPartialHashSize));
+  auto const head_size = (std::min)(key.size, kPartialHashSize);
+  if (!file->read(buf.data(), static_cast<std::streamsize>(head_size)))
+  {
+    return false;
+  }
+  // Only PE files are worth caching, and checking here means other files
+  // don't pay for the rest of the hash.
+  if (head_size < 2 || buf[0] != 'M' || buf[1] != 'Z')
+  {
+    return false;
+  }
+  hash.Update(buf.data(), static_cast<std::size_t>(head_size));
+
+  if (key.size > kPartialHashSize)
+  {
+    auto const tail_offset =
+      (std::max)(key.size - kPartialHashSize, kPartialHashSize);
+    auto const tail_size = key.size - tail_offset;
+    if (!file->seekg(static_cast<std::streamoff>(tail_offset)) ||
+        !file->read(buf.data(), static_cast<std::streamsize>(tail_size)))
+    {
+      return false;
+    }
+    hash.Update(buf.data(), static_cast<std::size_t>(tail_size));
+  }
+
+  key.partial_hash = hash.FinalValue();
+  return true;
+}
+
+bool LookupCache(std::wstring const& path,
+                 FileCacheKey const& key,
+                 CachedResult& result)
+{
+  CacheEntry path_entry{};
+  bool path_hit = false;
+  std::vector<CacheEntry> candidates;
+  {
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+
+    auto const iter = g_cache_by_path.find(path);
+    if (iter != std::end(g_cache_by_path))
+    {
+      iter->second.seen = true;
+      path_entry = iter->second;
+      path_hit = path_entry.key.size == key.size &&
+                 path_entry.key.last_write_time == key.last_write_time &&
+                 path_entry.key.partial_hash == key.partial_hash;
+    }
+
+    auto const content_iter = path_hit
+                                ? std::end(g_cache_by_content)
+                                : g_cache_by_content.find(GetContentKey(key));
+    if (content_iter != std::end(g_cache_by_content))
+    {
+      for (auto const& other_path : content_iter->second)
+      {
+        auto const& entry = g_cache_by_path[other_path];
+        if (entry.key.size == key.size &&
+            entry.key.partial_hash == key.partial_hash)
+        {
+          candidates.push_back(entry);
+        }
+      }
+    }
+  }
+
+  // The output is read outside the lock, as it hits the disk.
+  if (path_hit)
+  {
+    if (ReadOutput(path_entry, result.output))
+    {
+      result.warned = path_entry.warned;
+      ++g_cache_hits;
+      return true;
+    }
+
+    ++g_cache_misses;
+    return false;
+  }
+
+  // Only pay for hashing the whole file when there's something to compare it
+  // against. Done outside the lock as it reads the entire file.
+  std::uint64_t full_hash = 0;
+  if (candidates.empty() || !GetFullHashForPath(path, full_hash))
+  {
+    ++g_cache_misses;
+    return false;
+  }
+
+  for (auto const& entry : candidates)
+  {
+    if (entry.full_hash == full_hash && ReadOutput(entry, result.output))
+    {
+      result.warned = entry.warned;
+      ++g_cache_content_hits;
+
+      // Remember the new path (and write time) so the next run takes the
+      // fast path. The output itself is shared rather than copied.
+      auto new_entry = entry;
+      new_entry.key = key;
+      new_entry.seen = true;
+      std::lock_guard<std::mutex> lock(g_cache_mutex);
+      AddEntry(path, new_entry);
+      return true;
+    }
+  }
+
+  ++g_cache_misses;
+  return false;
+}
+
+void InsertCache(std::wstring const& path,
+                 FileCacheKey const& key,
+                 std::uint64_t full_hash,
+                 CachedResult const& result)
+{
+  auto const data_offset = AppendOutput(result.output);
+  std::lock_guard<std::mutex> lock(g_cache_mutex);
+  AddEntry(path,
+           CacheEntry{key,
+                      full_hash,
+                      result.warned,
+                      data_offset,
+                      result.output.size(),
+                      true});
+}
+
+std::uint64_t GetFileCacheFullHash(void const* data, std::size_t size)
+{
+  hadesmem::detail::XxHash64 hash;
+  hash.Update(data, size);
+  return hash.FinalValue();
+}
+
+void DumpCacheSummary(std::wostream& out)
+{
+  WriteNewline(out);
+  WriteNormal(out, L"Cache:", 0);
+  WriteNamedNormal(out, L"Hits", g_cache_hits.load(), 1);
+  WriteNamedNormal(out, L"Hits (Content)", g_cache_content_hits.load(), 1);
+  WriteNamedNormal(out, L"Misses", g_cache_misses.load(), 1);
+  WriteNamedNormal(out, L"Pruned", g_cache_pruned, 1);
+}
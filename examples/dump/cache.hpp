@@ -0,0 +1,58 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Persistent cache of per-file results for directory scans, so files which
+// haven't changed since the last run are replayed rather than parsed again.
+// Entries are found by path first (size, last write time, and a hash of the
+// start and end of the file must all match), then by content (size and the
+// same partial hash, confirmed with a hash of the whole file), so copied and
+// renamed files are also hits.
+// The whole cache is invalidated if the tool version or any option which
+// affects the output changes, or if the user supplied key changes.
+// Only the index is held in memory. Outputs are appended to a separate data
+// file as they are produced and read back on a hit, so saving only rewrites
+// the index. Entries for paths which weren't seen during a run are dropped
+// when it is saved, and the data file is compacted once most of it is dead.
+
+struct FileCacheKey
+{
+  std::uint64_t size;
+  std::uint64_t last_write_time;
+  std::uint64_t partial_hash;
+};
+
+struct CachedResult
+{
+  bool warned;
+  // Text output (as wide characters) or the record body, depending on the
+  // mode the cache was created with.
+  std::string output;
+};
+
+void OpenCache(std::wstring const& path, std::string const& config_key);
+
+void CloseCache();
+
+bool IsCacheEnabled() noexcept;
+
+bool GetFileCacheKey(std::wstring const& path, FileCacheKey& key);
+
+bool LookupCache(std::wstring const& path,
+                 FileCacheKey const& key,
+                 CachedResult& result);
+
+void InsertCache(std::wstring const& path,
+                 FileCacheKey const& key,
+                 std::uint64_t full_hash,
+                 CachedResult const& result);
+
+std::uint64_t GetFileCacheFullHash(void const* data, std::size_t size);
+
+void DumpCacheSummary(std::wostream& out);
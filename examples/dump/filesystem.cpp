@@ -1,166 +1,341 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#include "filesystem.hpp"
-
-#include <fstream>
-#include <iostream>
-#include <iterator>
-#include <memory>
-#include <vector>
-
-#include <hadesmem/detail/filesystem.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/pelib/nt_headers.hpp>
-#include <hadesmem/pelib/pe_file.hpp>
-#include <hadesmem/process.hpp>
-
-#include "main.hpp"
-#include "print.hpp"
-
-void DumpFile(std::wstring const& path)
-{
-  try
-  {
-    std::wostream& out = GetOutputStreamW();
-
-    SetCurrentFilePath(path);
-
-    std::vector<char> buf;
-
-    try
-    {
-      buf = hadesmem::detail::PeFileToBuffer(path);
-    }
-    catch (std::bad_alloc const&)
-    {
-      WriteNewline(out);
-      WriteNormal(out, L"WARNING! File too large.", 0);
-      WarnForCurrentFile(WarningType::kUnsupported);
-      return;
-    }
-    catch (...)
-    {
-      return;
-    }
-
-    hadesmem::Process const process(GetCurrentProcessId());
-
-    hadesmem::PeFile const pe_file(process,
-                                   buf.data(),
-                                   hadesmem::PeFileType::kData,
-                                   static_cast<DWORD>(buf.size()));
-
-    try
-    {
-      hadesmem::NtHeaders const nt_hdr(process, pe_file);
-    }
-    catch (std::exception const& /*e*/)
-    {
-      WriteNewline(out);
-      WriteNormal(out, L"Not a PE file or wrong architecture (Pass 2).", 0);
-      return;
-    }
-
-    DumpPeFile(process, pe_file, path);
-  }
-  catch (...)
-  {
-    std::cerr << "\nError!\n"
-              << boost::current_exception_diagnostic_information() << '\n';
-
-    auto const current_file_path = GetCurrentFilePath();
-    if (!current_file_path.empty())
-    {
-      std::wcerr << "\nCurrent file: " << current_file_path << "\n";
-    }
-  }
-}
-
-void DumpDir(std::wstring const& path, hadesmem::detail::ThreadPool& pool)
-{
-  std::wostream& out = GetOutputStreamW();
-
-  WriteNewline(out);
-  WriteNormal(out, L"Entering dir: \"" + path + L"\".", 0);
-
-  auto const f = [&](std::wstring const& cur_file) {
-    std::wstring const cur_path = hadesmem::detail::MakeExtendedPath(
-      hadesmem::detail::CombinePath(path, cur_file));
-
-    WriteNewline(out);
-    WriteNormal(out, L"Current path: \"" + cur_path + L"\".", 0);
-
-    try
-    {
-      if (hadesmem::detail::IsDirectory(cur_path))
-      {
-        if (hadesmem::detail::IsSymlink(cur_path))
-        {
-          WriteNewline(out);
-          WriteNormal(out, L"Skipping symlink.", 0);
-        }
-        else
-        {
-          DumpDir(cur_path, pool);
-        }
-      }
-      else
-      {
-        auto const task = [cur_path]() { DumpFile(cur_path); };
-
-        do
-        {
-          pool.WaitForSlot();
-        } while (!pool.QueueTask(task));
-      }
-    }
-    catch (hadesmem::Error const& e)
-    {
-      auto const last_error_ptr =
-        boost::get_error_info<hadesmem::ErrorCodeWinLast>(e);
-      if (last_error_ptr && *last_error_ptr == ERROR_SHARING_VIOLATION)
-      {
-        WriteNewline(out);
-        WriteNormal(out, L"Sharing violation.", 0);
-        return true;
-      }
-
-      if (last_error_ptr && *last_error_ptr == ERROR_ACCESS_DENIED)
-      {
-        WriteNewline(out);
-        WriteNormal(out, L"Access denied.", 0);
-        return true;
-      }
-
-      if (last_error_ptr && *last_error_ptr == ERROR_FILE_NOT_FOUND)
-      {
-        WriteNewline(out);
-        WriteNormal(out, L"File not found.", 0);
-        return true;
-      }
-
-      throw;
-    }
-
-    return true;
-  };
-
-  bool empty = false;
-  bool access_denied = false;
-  hadesmem::detail::EnumDir(path, f, &empty, &access_denied);
-
-  if (empty)
-  {
-    WriteNewline(out);
-    WriteNormal(out, L"Directory is empty.", 0);
-    return;
-  }
-
-  if (access_denied)
-  {
-    WriteNewline(out);
-    WriteNormal(out, L"Access denied to directory.", 0);
-    return;
-  }
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include "filesystem.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <hadesmem/detail/filesystem.hpp>
+#include <hadesmem/detail/mapped_file.hpp>
+#include <hadesmem/detail/pe_checksum.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/pelib/nt_headers.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/process.hpp>
+
+#include "cache.hpp"
+#include "main.hpp"
+#include "print.hpp"
+#include "record.hpp"
+#include "warning.hpp"
+
+namespace
+{
+std::atomic<std::uint64_t> g_checksums_verified{0};
+std::atomic<std::uint64_t> g_checksums_unset{0};
+std::atomic<std::uint64_t> g_checksums_mismatched{0};
+std::mutex g_checksum_report_mutex;
+
+// Maps the file rather than reading it into a buffer, and only looks at as
+// much of the headers as is needed to find the checksum, so this runs at
+// close to the speed of the disk.
+void VerifyFileChecksum(std::wstring const& path)
+{
+  hadesmem::detail::MappedFile file;
+  try
+  {
+    file.Open(path);
+  }
+  catch (std::exception const& /*e*/)
+  {
+    return;
+  }
+
+  auto const data = file.GetData();
+  auto const size = static_cast<std::size_t>(file.GetSize());
+  auto const checksum_offset =
+    hadesmem::detail::GetPeChecksumOffset(data, size);
+  // Signature, file header, then 64 bytes into the optional header.
+  std::size_t const kChecksumToSignature = 4 + 20 + 64;
+  if (!checksum_offset || data[0] != 'M' || data[1] != 'Z' ||
+      std::memcmp(data + checksum_offset - kChecksumToSignature,
+                  "PE\0\0",
+                  4) != 0)
+  {
+    return;
+  }
+
+  auto const stored = hadesmem::detail::GetPeStoredChecksum(data, size);
+  if (!stored)
+  {
+    ++g_checksums_unset;
+    return;
+  }
+
+  auto const calculated = hadesmem::detail::GetPeChecksum(data, size);
+  if (stored == calculated)
+  {
+    ++g_checksums_verified;
+    return;
+  }
+
+  ++g_checksums_mismatched;
+
+  // Formatted up front so lines from different threads don't interleave.
+  std::wostringstream report;
+  WriteNewline(report);
+  WriteNormal(report, L"Checksum mismatch: \"" + path + L"\".", 0);
+  WriteNamedHex(report, L"Stored", stored, 1);
+  WriteNamedHex(report, L"Calculated", calculated, 1);
+
+  std::lock_guard<std::mutex> lock(g_checksum_report_mutex);
+  std::wcout << report.str();
+}
+
+// Produces the same output and warnings as dumping the file again.
+void ReplayCachedResult(std::wstring const& path,
+                        CachedResult const& cached,
+                        bool records)
+{
+  if (records)
+  {
+    WriteCachedRecord(path, cached.output);
+  }
+  else
+  {
+    std::wstring const text(
+      reinterpret_cast<wchar_t const*>(cached.output.data()),
+      cached.output.size() / sizeof(wchar_t));
+    GetOutputStreamW() << text;
+  }
+
+  ClearWarnForCurrentFile();
+  if (cached.warned)
+  {
+    WarnForCurrentFile(GetWarnedType());
+  }
+  HandleWarnings(path);
+}
+}
+
+void DumpFile(std::wstring const& path)
+{
+  try
+  {
+    if (IsVerifyChecksums())
+    {
+      VerifyFileChecksum(path);
+      return;
+    }
+
+    // Records replace the normal output, which is only generated (and then
+    // discarded) if it's needed to find out whether the file warns.
+    bool const records = IsRecordOutputEnabled();
+    BufferedOutputScope output_scope(records);
+    std::wostream& out = GetOutputStreamW();
+
+    SetCurrentFilePath(path);
+
+    FileCacheKey cache_key{};
+    bool const cache = IsCacheEnabled() && GetFileCacheKey(path, cache_key);
+    if (cache)
+    {
+      CachedResult cached;
+      if (LookupCache(path, cache_key, cached))
+      {
+        ReplayCachedResult(path, cached, records);
+        return;
+      }
+    }
+
+    std::vector<char> buf;
+
+    try
+    {
+      buf = hadesmem::detail::PeFileToBuffer(path);
+    }
+    catch (std::bad_alloc const&)
+    {
+      WriteNewline(out);
+      WriteNormal(out, L"WARNING! File too large.", 0);
+      WarnForCurrentFile(WarningType::kUnsupported);
+      if (records)
+      {
+        WriteErrorRecord(path, "File too large.");
+      }
+      return;
+    }
+    catch (...)
+    {
+      return;
+    }
+
+    hadesmem::Process const process(GetCurrentProcessId());
+
+    // Reused for each file this thread dumps, so it only allocates for the
+    // first file with an unusually large number of problems.
+    thread_local static hadesmem::PeDiagnostics diagnostics;
+    diagnostics.Clear();
+    hadesmem::PeFile const pe_file(process,
+                                   buf.data(),
+                                   hadesmem::PeFileType::kData,
+                                   static_cast<DWORD>(buf.size()),
+                                   &diagnostics);
+
+    try
+    {
+      hadesmem::NtHeaders const nt_hdr(process, pe_file);
+    }
+    catch (std::exception const& /*e*/)
+    {
+      WriteNewline(out);
+      WriteNormal(out, L"Not a PE file or wrong architecture (Pass 2).", 0);
+      if (records)
+      {
+        WriteErrorRecord(path, "Not a PE file or wrong architecture.");
+      }
+      return;
+    }
+
+    CachedResult result{};
+    if (!records)
+    {
+      DumpPeFile(process, pe_file, path);
+      result.warned = IsCurrentFileWarned();
+      if (cache)
+      {
+        auto const text = output_scope.GetBuffered();
+        result.output.assign(reinterpret_cast<char const*>(text.data()),
+                             text.size() * sizeof(wchar_t));
+      }
+    }
+    else
+    {
+      bool warned = false;
+      if (GetWarningsEnabled())
+      {
+        DumpPeFile(process, pe_file, path);
+        warned = IsCurrentFileWarned();
+      }
+      result.warned = warned;
+      result.output = WriteFileRecord(
+        process, pe_file, path, GetWarningsEnabled() ? &warned : nullptr);
+    }
+
+    if (cache)
+    {
+      InsertCache(path,
+                  cache_key,
+                  GetFileCacheFullHash(buf.data(), buf.size()),
+                  result);
+    }
+  }
+  catch (...)
+  {
+    std::cerr << "\nError!\n"
+              << boost::current_exception_diagnostic_information() << '\n';
+
+    auto const current_file_path = GetCurrentFilePath();
+    if (!current_file_path.empty())
+    {
+      std::wcerr << "\nCurrent file: " << current_file_path << "\n";
+    }
+  }
+}
+
+void DumpDir(std::wstring const& path, hadesmem::detail::ThreadPool& pool)
+{
+  std::wostream& out = GetOutputStreamW();
+
+  WriteNewline(out);
+  WriteNormal(out, L"Entering dir: \"" + path + L"\".", 0);
+
+  auto const f = [&](std::wstring const& cur_file) {
+    std::wstring const cur_path = hadesmem::detail::MakeExtendedPath(
+      hadesmem::detail::CombinePath(path, cur_file));
+
+    WriteNewline(out);
+    WriteNormal(out, L"Current path: \"" + cur_path + L"\".", 0);
+
+    try
+    {
+      if (hadesmem::detail::IsDirectory(cur_path))
+      {
+        if (hadesmem::detail::IsSymlink(cur_path))
+        {
+          WriteNewline(out);
+          WriteNormal(out, L"Skipping symlink.", 0);
+        }
+        else
+        {
+          DumpDir(cur_path, pool);
+        }
+      }
+      else
+      {
+        auto const task = [cur_path]() { DumpFile(cur_path); };
+
+        do
+        {
+          pool.WaitForSlot();
+        } while (!pool.QueueTask(task));
+      }
+    }
+    catch (hadesmem::Error const& e)
+    {
+      auto const last_error_ptr =
+        boost::get_error_info<hadesmem::ErrorCodeWinLast>(e);
+      if (last_error_ptr && *last_error_ptr == ERROR_SHARING_VIOLATION)
+      {
+        WriteNewline(out);
+        WriteNormal(out, L"Sharing violation.", 0);
+        return true;
+      }
+
+      if (last_error_ptr && *last_error_ptr == ERROR_ACCESS_DENIED)
+      {
+        WriteNewline(out);
+        WriteNormal(out, L"Access denied.", 0);
+        return true;
+      }
+
+      if (last_error_ptr && *last_error_ptr == ERROR_FILE_NOT_FOUND)
+      {
+        WriteNewline(out);
+        WriteNormal(out, L"File not found.", 0);
+        return true;
+      }
+
+      throw;
+    }
+
+    return true;
+  };
+
+  bool empty = false;
+  bool access_denied = false;
+  hadesmem::detail::EnumDir(path, f, &empty, &access_denied);
+
+  if (empty)
+  {
+    WriteNewline(out);
+    WriteNormal(out, L"Directory is empty.", 0);
+    return;
+  }
+
+  if (access_denied)
+  {
+    WriteNewline(out);
+    WriteNormal(out, L"Access denied to directory.", 0);
+    return;
+  }
+}
+
+void DumpChecksumSummary(std::wostream& out)
+{
+  WriteNewline(out);
+  WriteNormal(out, L"Checksums:", 0);
+  WriteNamedNormal(out, L"Verified", g_checksums_verified.load(), 1);
+  WriteNamedNormal(out, L"Not Set", g_checksums_unset.load(), 1);
+  WriteNamedNormal(out, L"Mismatched", g_checksums_mismatched.load(), 1);
+}
@@ -0,0 +1,273 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Minimal JSON writer for output records. Everything is appended to a single
+// std::string which can be reused between records, and numbers are formatted
+// by hand rather than through iostreams (which are slow, and locale
+// dependent).
+// Wide strings are written as UTF-8. Narrow strings from PE files have no
+// defined encoding, so bytes outside of ASCII are written as the code point of
+// the same value (i.e. as if they were Latin-1), which keeps the output valid
+// and reversible.
+class JsonWriter
+{
+public:
+  void Clear()
+  {
+    buf_.clear();
+    need_comma_ = false;
+  }
+
+  std::string const& GetString() const noexcept
+  {
+    return buf_;
+  }
+
+  // For discarding a partially written value (e.g. when gathering the data
+  // for it throws).
+  struct Mark
+  {
+    std::size_t size;
+    bool need_comma;
+  };
+
+  Mark GetMark() const noexcept
+  {
+    return Mark{buf_.size(), need_comma_};
+  }
+
+  void Rollback(Mark const& mark)
+  {
+    buf_.resize(mark.size);
+    need_comma_ = mark.need_comma;
+  }
+
+  void BeginObject()
+  {
+    Separate();
+    buf_ += '{';
+    need_comma_ = false;
+  }
+
+  void EndObject()
+  {
+    buf_ += '}';
+    need_comma_ = true;
+  }
+
+  void BeginArray()
+  {
+    Separate();
+    buf_ += '[';
+    need_comma_ = false;
+  }
+
+  void EndArray()
+  {
+    buf_ += ']';
+    need_comma_ = true;
+  }
+
+  void Key(char const* key)
+  {
+    Separate();
+    buf_ += '"';
+    buf_ += key;
+    buf_ += "\":";
+    need_comma_ = false;
+  }
+
+  void Null()
+  {
+    Separate();
+    buf_ += "null";
+    need_comma_ = true;
+  }
+
+  void Bool(bool value)
+  {
+    Separate();
+    buf_ += value ? "true" : "false";
+    need_comma_ = true;
+  }
+
+  void UInt(std::uint64_t value)
+  {
+    Separate();
+    AppendUInt(value);
+    need_comma_ = true;
+  }
+
+  // Fixed point, which is plenty for the values we write (entropy etc.).
+  void Double(double value, unsigned int decimals = 6)
+  {
+    if (!std::isfinite(value))
+    {
+      Null();
+      return;
+    }
+
+    Separate();
+    if (value < 0)
+    {
+      buf_ += '-';
+      value = -value;
+    }
+
+    std::uint64_t scale = 1;
+    for (unsigned int i = 0; i < decimals; ++i)
+    {
+      scale *= 10;
+    }
+    auto const scaled = static_cast<std::uint64_t>(value * scale + 0.5);
+    AppendUInt(scaled / scale);
+    if (decimals)
+    {
+      buf_ += '.';
+      auto frac = scaled % scale;
+      char digits[20];
+      for (unsigned int i = decimals; i; --i)
+      {
+        digits[i - 1] = static_cast<char>('0' + frac % 10);
+        frac /= 10;
+      }
+      buf_.append(digits, decimals);
+    }
+    need_comma_ = true;
+  }
+
+  void String(std::string const& value)
+  {
+    Separate();
+    buf_ += '"';
+    for (auto const c : value)
+    {
+      AppendCodePoint(static_cast<unsigned char>(c));
+    }
+    buf_ += '"';
+    need_comma_ = true;
+  }
+
+  void String(std::wstring const& value)
+  {
+    Separate();
+    buf_ += '"';
+    for (std::size_t i = 0; i < value.size(); ++i)
+    {
+      auto cp = static_cast<std::uint32_t>(value[i]);
+      // Combine UTF-16 surrogate pairs (a no-op where wchar_t is UTF-32). A
+      // lone surrogate can't be represented, so it's replaced.
+      if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < value.size() &&
+          value[i + 1] >= 0xDC00 && value[i + 1] <= 0xDFFF)
+      {
+        cp = 0x10000 + ((cp - 0xD800) << 10) +
+             (static_cast<std::uint32_t>(value[++i]) - 0xDC00);
+      }
+      else if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+      {
+        cp = 0xFFFD;
+      }
+      AppendCodePoint(cp);
+    }
+    buf_ += '"';
+    need_comma_ = true;
+  }
+
+  template <std::size_t Size>
+  void Hex(std::array<std::uint8_t, Size> const& bytes)
+  {
+    Hex(bytes.data(), Size);
+  }
+
+  void Hex(std::uint8_t const* bytes, std::size_t size)
+  {
+    char const digits[] = "0123456789abcdef";
+    Separate();
+    buf_ += '"';
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      buf_ += digits[bytes[i] >> 4];
+      buf_ += digits[bytes[i] & 0xF];
+    }
+    buf_ += '"';
+    need_comma_ = true;
+  }
+
+  // Appends previously formatted output verbatim (e.g. the tail of a cached
+  // record), so it must already be valid at this position.
+  void Raw(std::string const& json)
+  {
+    buf_ += json;
+    need_comma_ = true;
+  }
+
+private:
+  void Separate()
+  {
+    if (need_comma_)
+    {
+      buf_ += ',';
+    }
+  }
+
+  void AppendUInt(std::uint64_t value)
+  {
+    char digits[20];
+    std::size_t n = 0;
+    do
+    {
+      digits[sizeof(digits) - ++n] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value);
+    buf_.append(digits + sizeof(digits) - n, n);
+  }
+
+  void AppendCodePoint(std::uint32_t cp)
+  {
+    if (cp == '"' || cp == '\\')
+    {
+      buf_ += '\\';
+      buf_ += static_cast<char>(cp);
+    }
+    else if (cp < 0x20)
+    {
+      char const digits[] = "0123456789abcdef";
+      buf_ += "\\u00";
+      buf_ += digits[cp >> 4];
+      buf_ += digits[cp & 0xF];
+    }
+    else if (cp < 0x80)
+    {
+      buf_ += static_cast<char>(cp);
+    }
+    else if (cp < 0x800)
+    {
+      buf_ += static_cast<char>(0xC0 | (cp >> 6));
+      buf_ += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+      buf_ += static_cast<char>(0xE0 | (cp >> 12));
+      buf_ += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      buf_ += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+      buf_ += static_cast<char>(0xF0 | (cp >> 18));
+      buf_ += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      buf_ += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      buf_ += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+
+  std::string buf_;
+  bool need_comma_{false};
+};
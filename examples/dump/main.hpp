@@ -1,57 +1,90 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <algorithm>
-#include <cstddef>
-#include <ctime>
-#include <iomanip>
-#include <locale>
-#include <ostream>
-#include <string>
-#include <vector>
-
-#include "warning.hpp"
-
-namespace hadesmem
-{
-class Process;
-class PeFile;
-}
-
-std::wstring GetCurrentFilePath();
-
-void SetCurrentFilePath(std::wstring const& path);
-
-std::ostream& GetOutputStreamA();
-
-std::wostream& GetOutputStreamW();
-
-void DumpPeFile(hadesmem::Process const& process,
-                hadesmem::PeFile const& pe_file,
-                std::wstring const& path);
-
-void HandleLongOrUnprintableString(std::wstring const& name,
-                                   std::wstring const& description,
-                                   std::size_t tabs,
-                                   WarningType warning_type,
-                                   std::string value);
-
-bool ConvertTimeStamp(std::time_t time, std::wstring& str);
-
-template <typename CharT>
-typename std::basic_string<CharT>::size_type
-  FindFirstUnprintableClassicLocale(std::basic_string<CharT> const& s)
-{
-  auto const i = std::find_if(std::begin(s),
-                              std::end(s),
-                              [](CharT c)
-                              {
-    return !std::isprint(c, std::locale::classic());
-  });
-  return i == std::end(s) ? std::basic_string<CharT>::npos
-                          : std::distance(std::begin(s), i);
-}
-
-bool IsQuiet() noexcept;
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <iomanip>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "warning.hpp"
+
+namespace hadesmem
+{
+class Process;
+class PeFile;
+}
+
+std::wstring GetCurrentFilePath();
+
+void SetCurrentFilePath(std::wstring const& path);
+
+std::ostream& GetOutputStreamA();
+
+std::wostream& GetOutputStreamW();
+
+// Redirects GetOutputStreamW on the current thread to a buffer for the
+// lifetime of the scope, then writes the buffer out in one go, so the output
+// for a file isn't interleaved with output from other threads. Output can
+// also be discarded entirely (e.g. when only warnings are wanted).
+class BufferedOutputScope
+{
+public:
+  explicit BufferedOutputScope(bool discard = false);
+
+  BufferedOutputScope(BufferedOutputScope const&) = delete;
+
+  BufferedOutputScope& operator=(BufferedOutputScope const&) = delete;
+
+  ~BufferedOutputScope();
+
+  // Everything written so far (nothing if output is discarded).
+  std::wstring GetBuffered() const;
+
+private:
+  std::wostringstream buf_;
+  std::wostream* prev_;
+  bool discard_;
+};
+
+void DumpPeFile(hadesmem::Process const& process,
+                hadesmem::PeFile const& pe_file,
+                std::wstring const& path);
+
+void HandleLongOrUnprintableString(std::wstring const& name,
+                                   std::wstring const& description,
+                                   std::size_t tabs,
+                                   WarningType warning_type,
+                                   std::string value);
+
+bool ConvertTimeStamp(std::time_t time, std::wstring& str);
+
+template <typename CharT>
+typename std::basic_string<CharT>::size_type
+  FindFirstUnprintableClassicLocale(std::basic_string<CharT> const& s)
+{
+  auto const i = std::find_if(std::begin(s),
+                              std::end(s),
+                              [](CharT c)
+                              {
+    return !std::isprint(c, std::locale::classic());
+  });
+  return i == std::end(s) ? std::basic_string<CharT>::npos
+                          : std::distance(std::begin(s), i);
+}
+
+bool IsQuiet() noexcept;
+
+// Zero if entropy maps are disabled.
+std::size_t GetEntropyBlockSize() noexcept;
+
+std::size_t GetEntropyStep() noexcept;
+
+// Only verify file checksums rather than dumping files.
+bool IsVerifyChecksums() noexcept;
@@ -0,0 +1,360 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include "record.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/entropy.hpp>
+#include <hadesmem/detail/filesystem.hpp>
+#include <hadesmem/detail/pe_digest.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/pelib/export_dir.hpp>
+#include <hadesmem/pelib/import_dir.hpp>
+#include <hadesmem/pelib/import_dir_list.hpp>
+#include <hadesmem/pelib/import_thunk.hpp>
+#include <hadesmem/pelib/import_thunk_list.hpp>
+#include <hadesmem/pelib/nt_headers.hpp>
+#include <hadesmem/pelib/overlay.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/pelib/section.hpp>
+#include <hadesmem/pelib/section_list.hpp>
+#include <hadesmem/pelib/tls_dir.hpp>
+#include <hadesmem/process.hpp>
+
+#include "json.hpp"
+
+namespace
+{
+std::mutex g_record_file_mutex;
+std::unique_ptr<std::fstream> g_record_file;
+
+JsonWriter& GetRecordWriter()
+{
+  // Reused so the buffer only needs to grow once per thread.
+  thread_local static JsonWriter writer;
+  writer.Clear();
+  return writer;
+}
+
+void EmitRecord(JsonWriter const& writer)
+{
+  auto const& record = writer.GetString();
+
+  std::lock_guard<std::mutex> lock(g_record_file_mutex);
+  g_record_file->write(record.data(),
+                       static_cast<std::streamsize>(record.size()));
+  g_record_file->put('\n');
+  if (!*g_record_file)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{} << hadesmem::ErrorString{"Failed to write record."});
+  }
+}
+
+void WriteHeaders(JsonWriter& writer,
+                  hadesmem::Process const& process,
+                  hadesmem::PeFile const& pe_file)
+{
+  hadesmem::NtHeaders const nt_headers(process, pe_file);
+  writer.Key("machine");
+  writer.UInt(nt_headers.GetMachine());
+  writer.Key("time_date_stamp");
+  writer.UInt(nt_headers.GetTimeDateStamp());
+  writer.Key("characteristics");
+  writer.UInt(nt_headers.GetCharacteristics());
+  writer.Key("image_base");
+  writer.UInt(nt_headers.GetImageBase());
+  writer.Key("address_of_entry_point");
+  writer.UInt(nt_headers.GetAddressOfEntryPoint());
+  writer.Key("size_of_image");
+  writer.UInt(nt_headers.GetSizeOfImage());
+  writer.Key("subsystem");
+  writer.UInt(nt_headers.GetSubsystem());
+  writer.Key("dll_characteristics");
+  writer.UInt(nt_headers.GetDllCharacteristics());
+}
+
+void WriteDigest(JsonWriter& writer,
+                 hadesmem::Process const& process,
+                 hadesmem::PeFile const& pe_file)
+{
+  auto const base = static_cast<std::uint8_t const*>(pe_file.GetBase());
+  auto const digest = hadesmem::detail::GetPeDigest(base, pe_file.GetSize());
+
+  writer.Key("entropy");
+  writer.Double(hadesmem::detail::GetEntropy(base, pe_file.GetSize()));
+  writer.Key("sha1");
+  writer.Hex(digest.sha1);
+  writer.Key("sha256");
+  writer.Hex(digest.sha256);
+  writer.Key("xxh64");
+  writer.Hex(digest.xxhash);
+  writer.Key("authenticode_sha256");
+  writer.Hex(digest.authenticode_sha256);
+  writer.Key("imphash");
+  if (digest.imphash.empty())
+  {
+    writer.Null();
+  }
+  else
+  {
+    writer.String(digest.imphash);
+  }
+  writer.Key("checksum");
+  writer.BeginObject();
+  writer.Key("stored");
+  writer.UInt(digest.header_checksum);
+  writer.Key("calculated");
+  writer.UInt(digest.checksum);
+  writer.EndObject();
+
+  hadesmem::SectionList const sections(process, pe_file);
+  auto section = std::begin(sections);
+  writer.Key("sections");
+  writer.BeginArray();
+  for (auto const& s : digest.sections)
+  {
+    writer.BeginObject();
+    writer.Key("name");
+    writer.String(s.name);
+    writer.Key("virtual_address");
+    writer.UInt(section->GetVirtualAddress());
+    writer.Key("virtual_size");
+    writer.UInt(section->GetVirtualSize());
+    writer.Key("pointer_to_raw_data");
+    writer.UInt(s.pointer_to_raw_data);
+    writer.Key("size_of_raw_data");
+    writer.UInt(section->GetSizeOfRawData());
+    writer.Key("characteristics");
+    writer.UInt(section->GetCharacteristics());
+    writer.Key("entropy");
+    writer.Double(hadesmem::detail::GetEntropy(
+      base + (std::min)(s.pointer_to_raw_data, pe_file.GetSize()),
+      s.size_of_raw_data));
+    writer.Key("sha256");
+    writer.Hex(s.sha256);
+    writer.Key("xxh64");
+    writer.Hex(s.xxhash);
+    writer.EndObject();
+    ++section;
+  }
+  writer.EndArray();
+}
+
+void WriteDirectories(JsonWriter& writer,
+                      hadesmem::Process const& process,
+                      hadesmem::PeFile const& pe_file)
+{
+  std::size_t num_import_dirs = 0;
+  std::size_t num_imports = 0;
+  hadesmem::ImportDirList const import_dirs(process, pe_file);
+  for (auto const& dir : import_dirs)
+  {
+    ++num_import_dirs;
+    hadesmem::ImportThunkList const thunks(
+      process,
+      pe_file,
+      dir.GetOriginalFirstThunk() ? dir.GetOriginalFirstThunk()
+                                  : dir.GetFirstThunk());
+    num_imports += static_cast<std::size_t>(
+      std::distance(std::begin(thunks), std::end(thunks)));
+  }
+  writer.Key("import_dirs");
+  writer.UInt(num_import_dirs);
+  writer.Key("imports");
+  writer.UInt(num_imports);
+
+  // Each of these throws if the directory doesn't exist.
+  writer.Key("exports");
+  try
+  {
+    hadesmem::ExportDir const export_dir(process, pe_file);
+    writer.UInt(export_dir.GetNumberOfFunctions());
+  }
+  catch (std::exception const& /*e*/)
+  {
+    writer.Null();
+  }
+
+  writer.Key("tls");
+  try
+  {
+    hadesmem::TlsDir const tls_dir(process, pe_file);
+    writer.Bool(true);
+  }
+  catch (std::exception const& /*e*/)
+  {
+    writer.Bool(false);
+  }
+
+  writer.Key("overlay");
+  try
+  {
+    hadesmem::Overlay const overlay(process, pe_file);
+    writer.BeginObject();
+    writer.Key("offset");
+    writer.UInt(overlay.GetOffset());
+    writer.Key("size");
+    writer.UInt(overlay.GetSize());
+    writer.EndObject();
+  }
+  catch (std::exception const& /*e*/)
+  {
+    writer.Null();
+  }
+}
+}
+
+void OpenRecordFile(std::wstring const& path)
+{
+  g_record_file = hadesmem::detail::OpenFile<char>(
+    path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!*g_record_file)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to open record file for output."});
+  }
+}
+
+void CloseRecordFile()
+{
+  if (!g_record_file)
+  {
+    return;
+  }
+
+  g_record_file->close();
+  if (!*g_record_file)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      hadesmem::Error{}
+      << hadesmem::ErrorString{"Failed to close record file."});
+  }
+  g_record_file.reset();
+}
+
+bool IsRecordOutputEnabled() noexcept
+{
+  return !!g_record_file;
+}
+
+std::string WriteFileRecord(hadesmem::Process const& process,
+                            hadesmem::PeFile const& pe_file,
+                            std::wstring const& path,
+                            bool const* warned)
+{
+  HADESMEM_DETAIL_ASSERT(pe_file.GetType() == hadesmem::PeFileType::kData);
+
+  auto& writer = GetRecordWriter();
+  writer.BeginObject();
+  writer.Key("path");
+  writer.String(path);
+  auto const body_offset = writer.GetString().size();
+  writer.Key("size");
+  writer.UInt(pe_file.GetSize());
+  writer.Key("is64");
+  writer.Bool(pe_file.Is64());
+
+  // A malformed directory shouldn't lose the rest of the record, so each
+  // group of fields which fails is dropped and listed instead.
+  char const* failed[3];
+  std::size_t num_failed = 0;
+  using WriteGroupFn = void (*)(
+    JsonWriter&, hadesmem::Process const&, hadesmem::PeFile const&);
+  auto const write_group = [&](char const* key, WriteGroupFn f) {
+    auto const mark = writer.GetMark();
+    try
+    {
+      writer.Key(key);
+      writer.BeginObject();
+      f(writer, process, pe_file);
+      writer.EndObject();
+    }
+    catch (std::exception const& /*e*/)
+    {
+      writer.Rollback(mark);
+      failed[num_failed++] = key;
+    }
+  };
+  write_group("headers", &WriteHeaders);
+  write_group("digest", &WriteDigest);
+  write_group("directories", &WriteDirectories);
+
+  writer.Key("errors");
+  writer.BeginArray();
+  for (std::size_t i = 0; i < num_failed; ++i)
+  {
+    writer.String(std::string(failed[i]));
+  }
+  writer.EndArray();
+
+  // Written last, as the groups above are what find most of them.
+  if (auto const diagnostics = pe_file.GetDiagnostics())
+  {
+    writer.Key("diagnostics");
+    writer.BeginArray();
+    for (std::size_t i = 0; i < diagnostics->GetSize(); ++i)
+    {
+      auto const& diagnostic = (*diagnostics)[i];
+      writer.BeginObject();
+      writer.Key("component");
+      writer.String(
+        std::string(hadesmem::GetPeComponentName(diagnostic.component)));
+      writer.Key("description");
+      writer.String(
+        std::string(hadesmem::GetPeDiagnosticDescription(diagnostic.code)));
+      writer.Key("code");
+      writer.UInt(static_cast<std::uint64_t>(diagnostic.code));
+      writer.Key("rva");
+      writer.UInt(diagnostic.rva);
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("diagnostics_truncated");
+    writer.Bool(diagnostics->IsTruncated());
+  }
+
+  if (warned)
+  {
+    writer.Key("warned");
+    writer.Bool(*warned);
+  }
+
+  writer.EndObject();
+  EmitRecord(writer);
+
+  return writer.GetString().substr(body_offset);
+}
+
+void WriteCachedRecord(std::wstring const& path, std::string const& body)
+{
+  auto& writer = GetRecordWriter();
+  writer.BeginObject();
+  writer.Key("path");
+  writer.String(path);
+  writer.Raw(body);
+  EmitRecord(writer);
+}
+
+void WriteErrorRecord(std::wstring const& path, std::string const& error)
+{
+  auto& writer = GetRecordWriter();
+  writer.BeginObject();
+  writer.Key("path");
+  writer.String(path);
+  writer.Key("error");
+  writer.String(error);
+  writer.EndObject();
+  EmitRecord(writer);
+}
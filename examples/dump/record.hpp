@@ -0,0 +1,34 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <string>
+
+namespace hadesmem
+{
+class Process;
+class PeFile;
+}
+
+// Machine readable output. Each file is written as a single JSON object on its
+// own line (JSON Lines), formatted on the calling thread and then written in
+// one go, so records from different threads are never interleaved.
+
+void OpenRecordFile(std::wstring const& path);
+
+void CloseRecordFile();
+
+bool IsRecordOutputEnabled() noexcept;
+
+// warned is null if warnings are disabled. Returns everything in the record
+// after the path, which can be passed to WriteCachedRecord to write the same
+// record again (for the same or a different path) without redoing the work.
+std::string WriteFileRecord(hadesmem::Process const& process,
+                            hadesmem::PeFile const& pe_file,
+                            std::wstring const& path,
+                            bool const* warned);
+
+void WriteCachedRecord(std::wstring const& path, std::string const& body);
+
+void WriteErrorRecord(std::wstring const& path, std::string const& error);
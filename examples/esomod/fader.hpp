@@ -1,9 +1,9 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-namespace hadesmem
-{
-class Process;
-}
-
-void ToggleFader(hadesmem::Process const& process);
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+namespace hadesmem
+{
+class Process;
+}
+
+void ToggleFader(hadesmem::Process const& process);
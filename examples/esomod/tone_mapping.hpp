@@ -1,11 +1,11 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#include <cstdint>
-
-namespace hadesmem
-{
-class Process;
-}
-
-void SetToneMappingType(hadesmem::Process const& process, std::uint32_t type);
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <cstdint>
+
+namespace hadesmem
+{
+class Process;
+}
+
+void SetToneMappingType(hadesmem::Process const& process, std::uint32_t type);
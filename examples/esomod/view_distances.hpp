@@ -1,12 +1,12 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-namespace hadesmem
-{
-class Process;
-}
-
-void SetViewDistances(hadesmem::Process const& process,
-                      float* min,
-                      float* max,
-                      float* value);
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+namespace hadesmem
+{
+class Process;
+}
+
+void SetViewDistances(hadesmem::Process const& process,
+                      float* min,
+                      float* max,
+                      float* value);
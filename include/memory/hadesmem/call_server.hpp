@@ -0,0 +1,476 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+
+#include <hadesmem/alloc.hpp>
+#include <hadesmem/call.hpp>
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/call_ring.hpp>
+#include <hadesmem/detail/call_server_code.hpp>
+#include <hadesmem/detail/smart_handle.hpp>
+#include <hadesmem/detail/trace.hpp>
+#include <hadesmem/detail/type_traits.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/find_procedure.hpp>
+#include <hadesmem/flush.hpp>
+#include <hadesmem/module.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/read.hpp>
+#include <hadesmem/write.hpp>
+
+// A persistent alternative to Call/CallMulti. Rather than allocating memory
+// and creating a thread for every call, the server code and a ring of call
+// descriptors are installed in the target once, along with a thread which
+// waits for work. Each batch of calls then costs one write
+// of the descriptors, one event round trip, and one read of the results.
+// As with CallMulti, the last error code is cleared at the start of each batch
+// and carries over between the calls within it.
+
+namespace hadesmem
+{
+namespace detail
+{
+template <typename ArgsForwardIterator>
+inline void EncodeCallDescriptor(void* address,
+                                 CallConv call_conv,
+                                 ArgsForwardIterator args_beg,
+                                 ArgsForwardIterator args_end,
+                                 CallDescriptor& descriptor)
+{
+  auto const args = ToCallDescriptorArgs(args_beg, args_end);
+  EncodeCallDescriptor(GetNativeCallAbi(),
+                       GetNumRegArgs(call_conv),
+                       reinterpret_cast<std::uintptr_t>(address),
+                       std::begin(args),
+                       std::end(args),
+                       descriptor);
+}
+
+inline SmartHandle CreateCallServerEvent()
+{
+  SmartHandle event{::CreateEventW(nullptr, FALSE, FALSE, nullptr)};
+  if (!event.GetHandle())
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"CreateEventW failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+
+  return event;
+}
+
+inline HANDLE DuplicateHandleToProcess(Process const& process, HANDLE handle)
+{
+  HANDLE remote_handle = nullptr;
+  if (!::DuplicateHandle(::GetCurrentProcess(),
+                         handle,
+                         process.GetHandle(),
+                         &remote_handle,
+                         0,
+                         FALSE,
+                         DUPLICATE_SAME_ACCESS))
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"DuplicateHandle failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+
+  return remote_handle;
+}
+}
+
+// Not thread-safe to destroy while calls are in progress, but calls may be
+// made from multiple threads (they are serialized).
+class CallServer
+{
+public:
+  explicit CallServer(Process const& process,
+                      std::uint32_t capacity = 64,
+                      DWORD timeout = INFINITE)
+    : process_{&process},
+      mask_{capacity - 1},
+      timeout_{timeout},
+      work_event_{detail::CreateCallServerEvent()},
+      done_event_{detail::CreateCallServerEvent()}
+  {
+    if (!capacity || (capacity & mask_))
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Capacity must be a power of two."});
+    }
+
+    auto const code = detail::GetCallServerCode(detail::GetNativeCallAbi());
+    std::size_t const ring_size = detail::GetCallRingSize(capacity);
+    memory_ = std::make_unique<Allocator>(process, ring_size + code.size);
+    auto const ring = static_cast<std::uint8_t*>(memory_->GetBase());
+    auto const code_remote = ring + ring_size;
+
+    Write(process, code_remote, code.code, code.size);
+    FlushInstructionCache(process, code_remote, code.size);
+
+    Module const kernel32{process, L"kernel32.dll"};
+    auto const find = [&](char const* name) {
+      return reinterpret_cast<std::uintptr_t>(
+        FindProcedure(process, kernel32, name));
+    };
+
+    detail::CallRingHeader header{};
+    header.mask = mask_;
+    header.wait_for_single_object = find("WaitForSingleObject");
+    header.set_event = find("SetEvent");
+    header.get_last_error = find("GetLastError");
+    header.set_last_error = find("SetLastError");
+    header.is_debugger_present = find("IsDebuggerPresent");
+    header.debug_break = find("DebugBreak");
+    // Closed by the destructor, once the server has stopped.
+    work_event_remote_ =
+      detail::DuplicateHandleToProcess(process, work_event_.GetHandle());
+    header.work_event = reinterpret_cast<std::uintptr_t>(work_event_remote_);
+    done_event_remote_ =
+      detail::DuplicateHandleToProcess(process, done_event_.GetHandle());
+    header.done_event = reinterpret_cast<std::uintptr_t>(done_event_remote_);
+    Write(process, ring, header);
+
+    HADESMEM_DETAIL_TRACE_FORMAT_A("Starting call server. Ring = %p.", ring);
+
+    thread_ = ::CreateRemoteThread(
+      process.GetHandle(),
+      nullptr,
+      0,
+      reinterpret_cast<LPTHREAD_START_ROUTINE>(
+        reinterpret_cast<std::uintptr_t>(code_remote)),
+      ring,
+      0,
+      nullptr);
+    if (!thread_.GetHandle())
+    {
+      DWORD const last_error = ::GetLastError();
+      CloseRemoteHandles();
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"CreateRemoteThread failed."}
+                << ErrorCodeWinLast{last_error});
+    }
+  }
+
+  explicit CallServer(Process const&& process,
+                      std::uint32_t capacity = 64,
+                      DWORD timeout = INFINITE) = delete;
+
+  CallServer(CallServer const& other) = delete;
+
+  CallServer& operator=(CallServer const& other) = delete;
+
+  ~CallServer()
+  {
+    StopUnchecked();
+  }
+
+  Process const& GetProcess() const noexcept
+  {
+    return *process_;
+  }
+
+  // Executes the descriptors in order (in batches if there are more than
+  // will fit in the ring), and fills in their results.
+  void Execute(std::vector<detail::CallDescriptor>& descriptors)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (broken_)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Call server is no longer usable."});
+    }
+
+    std::size_t const capacity = mask_ + 1;
+    for (std::size_t i = 0; i < descriptors.size(); i += capacity)
+    {
+      auto const count = static_cast<std::uint32_t>(
+        (std::min)(capacity, descriptors.size() - i));
+      try
+      {
+        ExecuteBatch(&descriptors[i], count);
+      }
+      catch (...)
+      {
+        // We don't know what state the server is in (it may still be
+        // executing the batch), so don't allow it to be used again.
+        broken_ = true;
+        throw;
+      }
+    }
+  }
+
+private:
+  void ExecuteBatch(detail::CallDescriptor* descriptors, std::uint32_t count)
+  {
+    auto const ring = static_cast<std::uint8_t*>(memory_->GetBase());
+
+    descriptors[0].flags |= detail::kCallBatchStart;
+
+    // The slots may wrap around the end of the ring.
+    auto const write_slots = [&](std::uint32_t index,
+                                 detail::CallDescriptor const* beg,
+                                 std::uint32_t n) {
+      auto const first_run = detail::GetCallRingFirstRun(index, mask_, n);
+      Write(*process_,
+            ring + detail::GetCallRingSlotOffset(index, mask_),
+            beg,
+            first_run);
+      if (first_run != n)
+      {
+        Write(*process_,
+              ring + detail::GetCallRingSlotOffset(0, mask_),
+              beg + first_run,
+              n - first_run);
+      }
+    };
+    write_slots(submitted_, descriptors, count);
+
+    std::uint32_t const target = submitted_ + count;
+    Write(*process_,
+          ring + offsetof(detail::CallRingHeader, submitted),
+          target);
+    submitted_ = target;
+
+    if (!::SetEvent(work_event_.GetHandle()))
+    {
+      DWORD const last_error = ::GetLastError();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"SetEvent failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+
+    for (;;)
+    {
+      HANDLE const handles[] = {done_event_.GetHandle(), thread_.GetHandle()};
+      DWORD const wait_res =
+        ::WaitForMultipleObjects(2, handles, FALSE, timeout_);
+      if (wait_res == WAIT_OBJECT_0)
+      {
+        auto const completed = Read<std::uint32_t>(
+          *process_, ring + offsetof(detail::CallRingHeader, completed));
+        if (completed == target)
+        {
+          break;
+        }
+      }
+      else if (wait_res == WAIT_OBJECT_0 + 1)
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"Call server exited unexpectedly."});
+      }
+      else if (wait_res == WAIT_TIMEOUT)
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"Timed out waiting for call server."});
+      }
+      else
+      {
+        DWORD const last_error = ::GetLastError();
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"WaitForMultipleObjects failed."}
+                  << ErrorCodeWinLast{last_error});
+      }
+    }
+
+    // Read back the whole slots rather than just the results, as it's simpler
+    // and the cost is dominated by the number of reads, not their size.
+    auto const read_slots = [&](std::uint32_t index,
+                                detail::CallDescriptor* beg,
+                                std::uint32_t n) {
+      auto const first_run = detail::GetCallRingFirstRun(index, mask_, n);
+      auto const first = ReadVector<detail::CallDescriptor>(
+        *process_,
+        ring + detail::GetCallRingSlotOffset(index, mask_),
+        first_run);
+      std::copy(std::begin(first), std::end(first), beg);
+      if (first_run != n)
+      {
+        auto const second = ReadVector<detail::CallDescriptor>(
+          *process_,
+          ring + detail::GetCallRingSlotOffset(0, mask_),
+          n - first_run);
+        std::copy(std::begin(second), std::end(second), beg + first_run);
+      }
+    };
+    read_slots(target - count, descriptors, count);
+  }
+
+  void CloseRemoteHandles() noexcept
+  {
+    for (auto const handle : {work_event_remote_, done_event_remote_})
+    {
+      if (handle)
+      {
+        ::DuplicateHandle(process_->GetHandle(),
+                          handle,
+                          nullptr,
+                          nullptr,
+                          0,
+                          FALSE,
+                          DUPLICATE_CLOSE_SOURCE);
+      }
+    }
+
+    work_event_remote_ = nullptr;
+    done_event_remote_ = nullptr;
+  }
+
+  void StopUnchecked() noexcept
+  {
+    if (!thread_.GetHandle())
+    {
+      return;
+    }
+
+    try
+    {
+      auto const ring = static_cast<std::uint8_t*>(memory_->GetBase());
+      Write(*process_,
+            ring + offsetof(detail::CallRingHeader, stop),
+            static_cast<std::uint32_t>(1));
+      ::SetEvent(work_event_.GetHandle());
+
+      // The server only checks for the stop request between calls, so if a
+      // call is hung (or we've lost track of it) we have no choice but to leak
+      // its memory rather than free it out from under it.
+      DWORD const kStopTimeout = 5000;
+      if (::WaitForSingleObject(thread_.GetHandle(), kStopTimeout) !=
+          WAIT_OBJECT_0)
+      {
+        HADESMEM_DETAIL_TRACE_A("WARNING! Call server failed to stop.");
+        memory_.release();
+        return;
+      }
+
+      CloseRemoteHandles();
+    }
+    catch (...)
+    {
+      HADESMEM_DETAIL_TRACE_A(
+        boost::current_exception_diagnostic_information().c_str());
+      HADESMEM_DETAIL_ASSERT(false);
+      memory_.release();
+    }
+  }
+
+  Process const* process_;
+  std::uint32_t mask_;
+  DWORD timeout_;
+  detail::SmartHandle work_event_;
+  detail::SmartHandle done_event_;
+  HANDLE work_event_remote_{};
+  HANDLE done_event_remote_{};
+  std::unique_ptr<Allocator> memory_;
+  detail::SmartHandle thread_;
+  std::mutex mutex_;
+  std::uint32_t submitted_{};
+  bool broken_{false};
+};
+
+template <typename AddressesForwardIterator,
+          typename ConvForwardIterator,
+          typename ArgsForwardIterator,
+          typename ResultsOutputIterator>
+inline void CallMulti(CallServer& server,
+                      AddressesForwardIterator addresses_beg,
+                      AddressesForwardIterator addresses_end,
+                      ConvForwardIterator call_convs_beg,
+                      ArgsForwardIterator args_full_beg,
+                      ResultsOutputIterator results)
+{
+  std::vector<detail::CallDescriptor> descriptors(
+    static_cast<std::size_t>(std::distance(addresses_beg, addresses_end)));
+  for (auto& descriptor : descriptors)
+  {
+    auto const& args = *args_full_beg;
+    detail::EncodeCallDescriptor(*addresses_beg,
+                                 *call_convs_beg,
+                                 std::begin(args),
+                                 std::end(args),
+                                 descriptor);
+    ++addresses_beg;
+    ++call_convs_beg;
+    ++args_full_beg;
+  }
+
+  server.Execute(descriptors);
+
+  std::transform(std::begin(descriptors),
+                 std::end(descriptors),
+                 results,
+                 [](detail::CallDescriptor const& d) {
+                   return CallResultRaw{d.return_i64,
+                                        d.return_float,
+                                        d.return_double,
+                                        d.last_error};
+                 });
+}
+
+template <typename ArgsForwardIterator>
+inline CallResultRaw CallRaw(CallServer& server,
+                             void* address,
+                             CallConv call_conv,
+                             ArgsForwardIterator args_beg,
+                             ArgsForwardIterator args_end)
+{
+  std::vector<detail::CallDescriptor> descriptors(1);
+  detail::EncodeCallDescriptor(
+    address, call_conv, args_beg, args_end, descriptors.front());
+  server.Execute(descriptors);
+  auto const& d = descriptors.front();
+  return CallResultRaw{
+    d.return_i64, d.return_float, d.return_double, d.last_error};
+}
+
+template <typename FuncT, typename... Args>
+inline CallResult<detail::FuncResultT<FuncT>> Call(CallServer& server,
+                                                   void* address,
+                                                   CallConv call_conv,
+                                                   Args&&... args)
+{
+  HADESMEM_DETAIL_STATIC_ASSERT(detail::FuncArity<FuncT>::value ==
+                                sizeof...(args));
+
+  std::vector<CallArg> call_args;
+  call_args.reserve(sizeof...(args));
+  detail::BuildCallArgs<FuncT, 0>(std::back_inserter(call_args),
+                                  std::forward<Args>(args)...);
+
+  CallResultRaw const ret = CallRaw(
+    server, address, call_conv, std::begin(call_args), std::end(call_args));
+  using ResultT = detail::FuncResultT<FuncT>;
+  return detail::CallResultRawToCallResult<ResultT>(ret);
+}
+
+template <typename FuncT, typename... Args>
+inline CallResult<detail::FuncResultT<FuncT>> Call(CallServer& server,
+                                                   FuncT address,
+                                                   CallConv call_conv,
+                                                   Args&&... args)
+{
+  HADESMEM_DETAIL_STATIC_ASSERT(detail::IsFunction<FuncT>::value);
+
+  return Call<FuncT>(server,
+                     detail::FuncToPointer(address),
+                     call_conv,
+                     std::forward<Args>(args)...);
+}
+}
@@ -0,0 +1,213 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+#include <hadesmem/error.hpp>
+
+// Shared memory protocol between the host and the persistent call server (see
+// CallServer and call_server_code.hpp). The host writes call descriptors into
+// a ring in the target, then bumps 'submitted'. The server executes each one,
+// writes the results back into it, then bumps 'completed'.
+// Arguments are lowered on the host into the exact register and stack layout
+// the callee expects, so the server is the same for every calling convention
+// and signature.
+// Everything here is plain data, so the encoding can be tested on any OS.
+
+namespace hadesmem
+{
+namespace detail
+{
+enum class CallArgKind : std::uint32_t
+{
+  kInt32,
+  kInt64,
+  kFloat32,
+  kFloat64
+};
+
+struct CallDescriptorArg
+{
+  CallArgKind kind;
+  // Zero extended. Floating point values are stored as their bit pattern.
+  std::uint64_t bits;
+};
+
+enum class CallAbi
+{
+  kX86,
+  kX64
+};
+
+std::size_t const kCallMaxStackWords = 64;
+
+// Set on the first descriptor of each batch. The server breaks into the
+// debugger (if one is attached) and clears the last error code before
+// executing it, so the last error carries over between the calls in a batch
+// (as it would in normal code), but not between batches.
+std::uint32_t const kCallBatchStart = 1;
+
+// Field offsets are baked into the server code, so don't change this without
+// regenerating it.
+struct CallDescriptor
+{
+  std::uint64_t address;
+  // x86: ECX and EDX.
+  // x64: RCX, RDX, R8 and R9, which are also loaded into XMM0-XMM3.
+  std::uint64_t regs[4];
+  std::uint32_t num_stack_words;
+  std::uint32_t flags;
+  // In memory order (i.e. the first argument is at the lowest address).
+  std::uint32_t stack[kCallMaxStackWords];
+  // Written by the server.
+  std::uint64_t return_i64;
+  double return_double;
+  float return_float;
+  std::uint32_t last_error;
+};
+
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, regs) == 8);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, num_stack_words) == 40);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, flags) == 44);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, stack) == 48);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, return_i64) == 304);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, return_double) == 312);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, return_float) == 320);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallDescriptor, last_error) == 324);
+HADESMEM_DETAIL_STATIC_ASSERT(sizeof(CallDescriptor) == 328);
+
+// Immediately followed by the slots. Pointers and handles are 64-bit
+// regardless of the target architecture so the layout is the same for both.
+struct CallRingHeader
+{
+  std::uint32_t submitted;
+  std::uint32_t completed;
+  // Number of slots minus one. The number of slots must be a power of two.
+  std::uint32_t mask;
+  std::uint32_t stop;
+  // Auto-reset events, signalled by the host when descriptors are submitted
+  // and by the server when it runs out of work (or stops).
+  std::uint64_t work_event;
+  std::uint64_t done_event;
+  std::uint64_t wait_for_single_object;
+  std::uint64_t set_event;
+  std::uint64_t get_last_error;
+  std::uint64_t set_last_error;
+  std::uint64_t is_debugger_present;
+  std::uint64_t debug_break;
+};
+
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallRingHeader, work_event) == 16);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallRingHeader, debug_break) == 72);
+HADESMEM_DETAIL_STATIC_ASSERT(sizeof(CallRingHeader) == 80);
+
+inline CallAbi GetNativeCallAbi() noexcept
+{
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+  return CallAbi::kX64;
+#elif defined(HADESMEM_DETAIL_ARCH_X86)
+  return CallAbi::kX86;
+#else
+#error "[HadesMem] Unsupported architecture."
+#endif
+}
+
+inline std::size_t GetCallRingSize(std::uint32_t capacity) noexcept
+{
+  return sizeof(CallRingHeader) + capacity * sizeof(CallDescriptor);
+}
+
+inline std::size_t GetCallRingSlotOffset(std::uint32_t index,
+                                         std::uint32_t mask) noexcept
+{
+  return sizeof(CallRingHeader) + (index & mask) * sizeof(CallDescriptor);
+}
+
+// Number of the n slots starting at index which fit before the end of the
+// ring. The rest wrap around to slot zero.
+inline std::uint32_t GetCallRingFirstRun(std::uint32_t index,
+                                         std::uint32_t mask,
+                                         std::uint32_t n) noexcept
+{
+  std::uint32_t const to_end = mask + 1 - (index & mask);
+  return n < to_end ? n : to_end;
+}
+
+// num_reg_args is only used for x86, and is the number of 32-bit (or smaller)
+// integral arguments passed in registers (one for thiscall, two for
+// fastcall). As with MSVC, the first suitable arguments from left to right are
+// used, skipping over any others.
+template <typename ArgsForwardIterator>
+inline void EncodeCallDescriptor(CallAbi abi,
+                                 std::size_t num_reg_args,
+                                 std::uint64_t address,
+                                 ArgsForwardIterator args_beg,
+                                 ArgsForwardIterator args_end,
+                                 CallDescriptor& descriptor)
+{
+  descriptor = CallDescriptor{};
+  descriptor.address = address;
+
+  std::size_t num_words = 0;
+  auto const push_word = [&](std::uint32_t word) {
+    if (num_words == kCallMaxStackWords)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Too many call arguments."});
+    }
+
+    descriptor.stack[num_words++] = word;
+  };
+  auto const push_qword = [&](std::uint64_t qword) {
+    push_word(static_cast<std::uint32_t>(qword & 0xFFFFFFFFUL));
+    push_word(static_cast<std::uint32_t>((qword >> 32) & 0xFFFFFFFFUL));
+  };
+
+  std::size_t num_regs = 0;
+  for (; args_beg != args_end; ++args_beg)
+  {
+    CallDescriptorArg const& arg = *args_beg;
+    bool const is_qword =
+      arg.kind == CallArgKind::kInt64 || arg.kind == CallArgKind::kFloat64;
+
+    if (abi == CallAbi::kX64)
+    {
+      // Every argument gets a slot, whether it's in a register or not.
+      if (num_regs < 4)
+      {
+        descriptor.regs[num_regs++] =
+          is_qword ? arg.bits : (arg.bits & 0xFFFFFFFFUL);
+      }
+      else
+      {
+        push_qword(is_qword ? arg.bits : (arg.bits & 0xFFFFFFFFUL));
+      }
+    }
+    else
+    {
+      if (arg.kind == CallArgKind::kInt32 && num_regs < num_reg_args &&
+          num_regs < 2)
+      {
+        descriptor.regs[num_regs++] = arg.bits & 0xFFFFFFFFUL;
+      }
+      else if (is_qword)
+      {
+        push_qword(arg.bits);
+      }
+      else
+      {
+        push_word(static_cast<std::uint32_t>(arg.bits & 0xFFFFFFFFUL));
+      }
+    }
+  }
+
+  descriptor.num_stack_words = static_cast<std::uint32_t>(num_words);
+}
+}
+}
@@ -0,0 +1,230 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <hadesmem/detail/call_ring.hpp>
+
+// Prebuilt call server (see call_ring.hpp for the protocol). It's a thread
+// procedure which takes a pointer to the CallRingHeader, and uses nothing but
+// the ring (all APIs are called through the function pointers in the header),
+// so it's position independent and can be written anywhere in the target
+// as-is.
+// Pseudocode:
+//   for (;;)
+//   {
+//     WaitForSingleObject(ring->work_event, INFINITE);
+//     while (!ring->stop && ring->completed != ring->submitted)
+//     {
+//       auto d = &slots[ring->completed & ring->mask];
+//       if (d->flags & kCallBatchStart)
+//       {
+//         if (IsDebuggerPresent()) DebugBreak();
+//         SetLastError(0);
+//       }
+//       <load regs, copy stack words, call d->address, store results>
+//       d->last_error = GetLastError();
+//       ++ring->completed;
+//     }
+//     SetEvent(ring->done_event);
+//     if (ring->stop) return 0;
+//   }
+// The x86 version only stores the FPU return value if ST(0) is in use, so the
+// FPU stack can't overflow over many calls.
+
+namespace hadesmem
+{
+namespace detail
+{
+struct CallServerCode
+{
+  std::uint8_t const* code;
+  std::size_t size;
+};
+
+inline CallServerCode GetCallServerCode(CallAbi abi) noexcept
+{
+  static std::uint8_t const kCode32[] = {
+    0x55,                                    // push ebp
+    0x89, 0xE5,                              // mov ebp,esp
+    0x53,                                    // push ebx
+    0x56,                                    // push esi
+    0x57,                                    // push edi
+    0x83, 0xEC, 0x04,                        // sub esp,0x4
+    0x8B, 0x5D, 0x08,                        // mov ebx,dword ptr [ebp+0x8]
+    0x8D, 0x7B, 0x50,                        // lea edi,[ebx+0x50]
+    // wait:
+    0x6A, 0xFF,                              // push 0xffffffff
+    0xFF, 0x73, 0x10,                        // push dword ptr [ebx+0x10]
+    0xFF, 0x53, 0x20,                        // call dword ptr [ebx+0x20]
+    // drain:
+    0x83, 0x7B, 0x0C, 0x00,                  // cmp dword ptr [ebx+0xc],0x0
+    0x0F, 0x85, 0x8A, 0x00, 0x00, 0x00,      // jne exit
+    0x8B, 0x43, 0x04,                        // mov eax,dword ptr [ebx+0x4]
+    0x3B, 0x03,                              // cmp eax,dword ptr [ebx]
+    0x74, 0x78,                              // je idle
+    0x23, 0x43, 0x08,                        // and eax,dword ptr [ebx+0x8]
+    0x69, 0xF0, 0x48, 0x01, 0x00, 0x00,      // imul esi,eax,0x148
+    0x01, 0xFE,                              // add esi,edi
+    0xF7, 0x46, 0x2C, 0x01, 0x00, 0x00, 0x00, // test dword ptr [esi+0x2c],0x1
+    0x74, 0x0F,                              // je args
+    0xFF, 0x53, 0x40,                        // call dword ptr [ebx+0x40]
+    0x85, 0xC0,                              // test eax,eax
+    0x74, 0x03,                              // je nodebug
+    0xFF, 0x53, 0x48,                        // call dword ptr [ebx+0x48]
+    // nodebug:
+    0x6A, 0x00,                              // push 0x0
+    0xFF, 0x53, 0x38,                        // call dword ptr [ebx+0x38]
+    // args:
+    0x89, 0x65, 0xF0,                        // mov dword ptr [ebp-0x10],esp
+    0x8B, 0x4E, 0x28,                        // mov ecx,dword ptr [esi+0x28]
+    0x85, 0xC9,                              // test ecx,ecx
+    0x74, 0x07,                              // je pushed
+    // push:
+    0xFF, 0x74, 0x8E, 0x2C,                  // push dword ptr [esi+ecx*4+0x2c]
+    0x49,                                    // dec ecx
+    0x75, 0xF9,                              // jne push
+    // pushed:
+    0x8B, 0x4E, 0x08,                        // mov ecx,dword ptr [esi+0x8]
+    0x8B, 0x56, 0x10,                        // mov edx,dword ptr [esi+0x10]
+    0xFF, 0x16,                              // call dword ptr [esi]
+    0x8B, 0x65, 0xF0,                        // mov esp,dword ptr [ebp-0x10]
+    0x89, 0x86, 0x30, 0x01, 0x00, 0x00,      // mov dword ptr [esi+0x130],eax
+    0x89, 0x96, 0x34, 0x01, 0x00, 0x00,      // mov dword ptr [esi+0x134],edx
+    0xD9, 0xE5,                              // fxam
+    0xDF, 0xE0,                              // fnstsw ax
+    0x80, 0xE4, 0x41,                        // and ah,0x41
+    0x80, 0xFC, 0x41,                        // cmp ah,0x41
+    0x74, 0x0C,                              // je nofpu
+    0xD9, 0x96, 0x40, 0x01, 0x00, 0x00,      // fst dword ptr [esi+0x140]
+    0xDD, 0x9E, 0x38, 0x01, 0x00, 0x00,      // fstp qword ptr [esi+0x138]
+    // nofpu:
+    0xFF, 0x53, 0x30,                        // call dword ptr [ebx+0x30]
+    0x89, 0x86, 0x44, 0x01, 0x00, 0x00,      // mov dword ptr [esi+0x144],eax
+    0x8B, 0x43, 0x04,                        // mov eax,dword ptr [ebx+0x4]
+    0x40,                                    // inc eax
+    0x89, 0x43, 0x04,                        // mov dword ptr [ebx+0x4],eax
+    0xE9, 0x77, 0xFF, 0xFF, 0xFF,            // jmp drain
+    // idle:
+    0xFF, 0x73, 0x18,                        // push dword ptr [ebx+0x18]
+    0xFF, 0x53, 0x28,                        // call dword ptr [ebx+0x28]
+    0xE9, 0x64, 0xFF, 0xFF, 0xFF,            // jmp wait
+    // exit:
+    0xFF, 0x73, 0x18,                        // push dword ptr [ebx+0x18]
+    0xFF, 0x53, 0x28,                        // call dword ptr [ebx+0x28]
+    0x31, 0xC0,                              // xor eax,eax
+    0x8D, 0x65, 0xF4,                        // lea esp,[ebp-0xc]
+    0x5F,                                    // pop edi
+    0x5E,                                    // pop esi
+    0x5B,                                    // pop ebx
+    0x5D,                                    // pop ebp
+    0xC2, 0x04, 0x00,                        // ret 0x4
+  };
+
+  static std::uint8_t const kCode64[] = {
+    0x53,                                    // push rbx
+    0x56,                                    // push rsi
+    0x41, 0x54,                              // push r12
+    0x41, 0x55,                              // push r13
+    0x55,                                    // push rbp
+    0x48, 0x89, 0xE5,                        // mov rbp,rsp
+    0x48, 0x83, 0xE4, 0xF0,                  // and rsp,-16
+    0x49, 0x89, 0xE5,                        // mov r13,rsp
+    0x48, 0x89, 0xCB,                        // mov rbx,rcx
+    0x4C, 0x8D, 0x63, 0x50,                  // lea r12,[rbx+0x50]
+    // wait:
+    0x48, 0x8B, 0x4B, 0x10,                  // mov rcx,qword ptr [rbx+0x10]
+    0xBA, 0xFF, 0xFF, 0xFF, 0xFF,            // mov edx,0xffffffff
+    0x48, 0x83, 0xEC, 0x20,                  // sub rsp,0x20
+    0xFF, 0x53, 0x20,                        // call qword ptr [rbx+0x20]
+    0x48, 0x83, 0xC4, 0x20,                  // add rsp,0x20
+    // drain:
+    0x83, 0x7B, 0x0C, 0x00,                  // cmp dword ptr [rbx+0xc],0x0
+    0x0F, 0x85, 0xD4, 0x00, 0x00, 0x00,      // jne exit
+    0x8B, 0x43, 0x04,                        // mov eax,dword ptr [rbx+0x4]
+    0x3B, 0x03,                              // cmp eax,dword ptr [rbx]
+    0x0F, 0x84, 0xB5, 0x00, 0x00, 0x00,      // je idle
+    0x23, 0x43, 0x08,                        // and eax,dword ptr [rbx+0x8]
+    0x48, 0x69, 0xF0, 0x48, 0x01, 0x00, 0x00, // imul rsi,rax,0x148
+    0x4C, 0x01, 0xE6,                        // add rsi,r12
+    0xF7, 0x46, 0x2C, 0x01, 0x00, 0x00, 0x00, // test dword ptr [rsi+0x2c],0x1
+    0x74, 0x17,                              // je args
+    0x48, 0x83, 0xEC, 0x20,                  // sub rsp,0x20
+    0xFF, 0x53, 0x40,                        // call qword ptr [rbx+0x40]
+    0x85, 0xC0,                              // test eax,eax
+    0x74, 0x03,                              // je nodebug
+    0xFF, 0x53, 0x48,                        // call qword ptr [rbx+0x48]
+    // nodebug:
+    0x31, 0xC9,                              // xor ecx,ecx
+    0xFF, 0x53, 0x38,                        // call qword ptr [rbx+0x38]
+    0x48, 0x83, 0xC4, 0x20,                  // add rsp,0x20
+    // args:
+    0x8B, 0x4E, 0x28,                        // mov ecx,dword ptr [rsi+0x28]
+    0x48, 0x8D, 0x04, 0x8D, 0x0F, 0x00, 0x00, 0x00, // lea rax,[rcx*4+0xf]
+    0x48, 0x83, 0xE0, 0xF0,                  // and rax,-16
+    0x48, 0x29, 0xC4,                        // sub rsp,rax
+    0x48, 0x83, 0xEC, 0x20,                  // sub rsp,0x20
+    0x31, 0xD2,                              // xor edx,edx
+    0x85, 0xC9,                              // test ecx,ecx
+    0x74, 0x0E,                              // je copied
+    // copy:
+    // mov eax,dword ptr [rsi+rdx*4+0x30]
+    0x8B, 0x44, 0x96, 0x30,
+    // mov dword ptr [rsp+rdx*4+0x20],eax
+    0x89, 0x44, 0x94, 0x20,
+    0xFF, 0xC2,                              // inc edx
+    0x39, 0xCA,                              // cmp edx,ecx
+    0x72, 0xF2,                              // jb copy
+    // copied:
+    0x48, 0x8B, 0x4E, 0x08,                  // mov rcx,qword ptr [rsi+0x8]
+    0x48, 0x8B, 0x56, 0x10,                  // mov rdx,qword ptr [rsi+0x10]
+    0x4C, 0x8B, 0x46, 0x18,                  // mov r8,qword ptr [rsi+0x18]
+    0x4C, 0x8B, 0x4E, 0x20,                  // mov r9,qword ptr [rsi+0x20]
+    0x66, 0x48, 0x0F, 0x6E, 0xC1,            // movq xmm0,rcx
+    0x66, 0x48, 0x0F, 0x6E, 0xCA,            // movq xmm1,rdx
+    0x66, 0x49, 0x0F, 0x6E, 0xD0,            // movq xmm2,r8
+    0x66, 0x49, 0x0F, 0x6E, 0xD9,            // movq xmm3,r9
+    0xFF, 0x16,                              // call qword ptr [rsi]
+    0x4C, 0x89, 0xEC,                        // mov rsp,r13
+    0x48, 0x89, 0x86, 0x30, 0x01, 0x00, 0x00, // mov qword ptr [rsi+0x130],rax
+    // movsd qword ptr [rsi+0x138],xmm0
+    0xF2, 0x0F, 0x11, 0x86, 0x38, 0x01, 0x00, 0x00,
+    // movss dword ptr [rsi+0x140],xmm0
+    0xF3, 0x0F, 0x11, 0x86, 0x40, 0x01, 0x00, 0x00,
+    0x48, 0x83, 0xEC, 0x20,                  // sub rsp,0x20
+    0xFF, 0x53, 0x30,                        // call qword ptr [rbx+0x30]
+    0x48, 0x83, 0xC4, 0x20,                  // add rsp,0x20
+    0x89, 0x86, 0x44, 0x01, 0x00, 0x00,      // mov dword ptr [rsi+0x144],eax
+    0x8B, 0x43, 0x04,                        // mov eax,dword ptr [rbx+0x4]
+    0xFF, 0xC0,                              // inc eax
+    0x89, 0x43, 0x04,                        // mov dword ptr [rbx+0x4],eax
+    0xE9, 0x36, 0xFF, 0xFF, 0xFF,            // jmp drain
+    // idle:
+    0x48, 0x8B, 0x4B, 0x18,                  // mov rcx,qword ptr [rbx+0x18]
+    0x48, 0x83, 0xEC, 0x20,                  // sub rsp,0x20
+    0xFF, 0x53, 0x28,                        // call qword ptr [rbx+0x28]
+    0x48, 0x83, 0xC4, 0x20,                  // add rsp,0x20
+    0xE9, 0x0E, 0xFF, 0xFF, 0xFF,            // jmp wait
+    // exit:
+    0x48, 0x8B, 0x4B, 0x18,                  // mov rcx,qword ptr [rbx+0x18]
+    0x48, 0x83, 0xEC, 0x20,                  // sub rsp,0x20
+    0xFF, 0x53, 0x28,                        // call qword ptr [rbx+0x28]
+    0x48, 0x83, 0xC4, 0x20,                  // add rsp,0x20
+    0x31, 0xC0,                              // xor eax,eax
+    0x48, 0x89, 0xEC,                        // mov rsp,rbp
+    0x5D,                                    // pop rbp
+    0x41, 0x5D,                              // pop r13
+    0x41, 0x5C,                              // pop r12
+    0x5E,                                    // pop rsi
+    0x5B,                                    // pop rbx
+    0xC3,                                    // ret
+  };
+
+  return abi == CallAbi::kX64 ? CallServerCode{kCode64, sizeof(kCode64)}
+                              : CallServerCode{kCode32, sizeof(kCode32)};
+}
+}
+}
@@ -0,0 +1,609 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/call_ring.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+#include <hadesmem/error.hpp>
+
+// Call thunks for CallMulti. The code to marshal the arguments for a call
+// only depends on the calling convention and the kinds of the arguments, not
+// their values, so a thunk is generated once per shape and reads everything
+// else (the target, the arguments, where to put the results) from a block of
+// data. A batch of calls is then just data: a runner (also generated once)
+// walks a list of (thunk, block) pairs and calls each thunk in turn.
+// Code is emitted as raw bytes rather than via a JIT so it can be generated
+// for either architecture, and executed on any x64 OS for testing (the thunks
+// always use the Windows calling conventions).
+
+namespace hadesmem
+{
+namespace detail
+{
+struct CallThunkKey
+{
+  CallAbi abi;
+  // Always zero for x64.
+  std::uint32_t num_reg_args;
+  std::vector<CallArgKind> kinds;
+};
+
+inline bool operator<(CallThunkKey const& lhs, CallThunkKey const& rhs)
+{
+  return std::tie(lhs.abi, lhs.num_reg_args, lhs.kinds) <
+         std::tie(rhs.abi, rhs.num_reg_args, rhs.kinds);
+}
+
+template <typename ArgsForwardIterator>
+inline CallThunkKey MakeCallThunkKey(CallAbi abi,
+                                     std::size_t num_reg_args,
+                                     ArgsForwardIterator args_beg,
+                                     ArgsForwardIterator args_end)
+{
+  CallThunkKey key{abi, 0, {}};
+  if (abi == CallAbi::kX86)
+  {
+    key.num_reg_args = static_cast<std::uint32_t>(num_reg_args);
+  }
+
+  for (; args_beg != args_end; ++args_beg)
+  {
+    CallDescriptorArg const& arg = *args_beg;
+    key.kinds.push_back(arg.kind);
+  }
+
+  return key;
+}
+
+// Immediately followed by one qword per argument (zero extended, with
+// floating point values stored as their bit pattern).
+struct CallThunkBlock
+{
+  std::uint64_t address;
+  // Optional. Called after the target to fill in last_error.
+  std::uint64_t get_last_error;
+  // Written by the thunk.
+  std::uint64_t return_i64;
+  double return_double;
+  float return_float;
+  std::uint32_t last_error;
+};
+
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBlock, get_last_error) == 8);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBlock, return_i64) == 16);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBlock, return_double) == 24);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBlock, return_float) == 32);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBlock, last_error) == 36);
+HADESMEM_DETAIL_STATIC_ASSERT(sizeof(CallThunkBlock) == 40);
+
+struct CallThunkEntry
+{
+  std::uint64_t thunk;
+  std::uint64_t block;
+};
+
+// Immediately followed by num_calls entries. Pointers are 64-bit regardless
+// of the target architecture, as with the call ring.
+struct CallThunkBatch
+{
+  std::uint64_t num_calls;
+  // Optional. Called with zero before the first call.
+  std::uint64_t set_last_error;
+  // Optional. If both are set, the runner breaks into the debugger (if one is
+  // attached) before the first call.
+  std::uint64_t is_debugger_present;
+  std::uint64_t debug_break;
+};
+
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBatch, set_last_error) == 8);
+HADESMEM_DETAIL_STATIC_ASSERT(offsetof(CallThunkBatch, debug_break) == 24);
+HADESMEM_DETAIL_STATIC_ASSERT(sizeof(CallThunkBatch) == 32);
+
+std::size_t const kCallThunkMaxArgs = 64;
+
+inline std::size_t GetCallThunkBlockSize(std::size_t num_args) noexcept
+{
+  return sizeof(CallThunkBlock) + num_args * sizeof(std::uint64_t);
+}
+
+inline std::uint32_t GetCallThunkArgOffset(std::size_t index) noexcept
+{
+  return static_cast<std::uint32_t>(sizeof(CallThunkBlock) +
+                                    index * sizeof(std::uint64_t));
+}
+
+std::size_t const kCallThunkUnbound = static_cast<std::size_t>(-1);
+
+class CallThunkEmitter
+{
+public:
+  using Label = std::size_t;
+
+  void Emit(std::initializer_list<std::uint8_t> bytes)
+  {
+    code_.insert(std::end(code_), bytes);
+  }
+
+  void EmitU32(std::uint32_t value)
+  {
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      code_.push_back(static_cast<std::uint8_t>((value >> (i * 8)) & 0xFF));
+    }
+  }
+
+  Label NewLabel()
+  {
+    labels_.push_back(kCallThunkUnbound);
+    return labels_.size() - 1;
+  }
+
+  void Bind(Label label)
+  {
+    labels_[label] = code_.size();
+  }
+
+  // A short jump (Jcc or JMP) with an 8-bit displacement.
+  void EmitJump8(std::uint8_t opcode, Label label)
+  {
+    code_.push_back(opcode);
+    code_.push_back(0);
+    fixups_.emplace_back(code_.size() - 1, label);
+  }
+
+  std::vector<std::uint8_t> Finalize()
+  {
+    for (auto const& fixup : fixups_)
+    {
+      HADESMEM_DETAIL_ASSERT(labels_[fixup.second] != kCallThunkUnbound);
+      auto const disp = static_cast<std::ptrdiff_t>(labels_[fixup.second]) -
+                        static_cast<std::ptrdiff_t>(fixup.first + 1);
+      if (disp < -128 || disp > 127)
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"Jump displacement out of range."});
+      }
+
+      code_[fixup.first] = static_cast<std::uint8_t>(disp & 0xFF);
+    }
+
+    return std::move(code_);
+  }
+
+private:
+  std::vector<std::uint8_t> code_;
+  std::vector<std::size_t> labels_;
+  std::vector<std::pair<std::size_t, Label>> fixups_;
+};
+
+// void Thunk(CallThunkBlock* block), using the native calling convention.
+// Preserves the stack pointer (so it works for both caller and callee cleanup)
+// and stores every kind of return value, as the return type isn't part of the
+// key.
+inline std::vector<std::uint8_t> GenerateCallThunk64(CallThunkKey const& key)
+{
+  auto const num_args = key.kinds.size();
+  auto const num_stack_args = num_args > 4 ? num_args - 4 : 0;
+  // Home space plus stack arguments, keeping RSP 16-byte aligned (it's 8 mod
+  // 16 on entry, which the push of RBX fixes).
+  auto const frame_size =
+    static_cast<std::uint32_t>((32 + num_stack_args * 8 + 15) & ~15U);
+
+  CallThunkEmitter e;
+  auto const skip_last_error = e.NewLabel();
+
+  // push rbx; mov rbx, rcx; sub rsp, frame_size
+  e.Emit({0x53, 0x48, 0x89, 0xCB, 0x48, 0x81, 0xEC});
+  e.EmitU32(frame_size);
+
+  for (std::size_t i = 4; i < num_args; ++i)
+  {
+    // mov rax, [rbx+arg]; mov [rsp+i*8], rax
+    e.Emit({0x48, 0x8B, 0x83});
+    e.EmitU32(GetCallThunkArgOffset(i));
+    e.Emit({0x48, 0x89, 0x84, 0x24});
+    e.EmitU32(static_cast<std::uint32_t>(i * 8));
+  }
+
+  for (std::size_t i = 0; i < num_args && i < 4; ++i)
+  {
+    auto const reg = static_cast<std::uint8_t>(i);
+    switch (key.kinds[i])
+    {
+    case CallArgKind::kInt32:
+    case CallArgKind::kInt64:
+    {
+      // mov rcx/rdx/r8/r9, [rbx+arg]
+      std::uint8_t const rex[] = {0x48, 0x48, 0x4C, 0x4C};
+      std::uint8_t const modrm[] = {0x8B, 0x93, 0x83, 0x8B};
+      e.Emit({rex[i], 0x8B, modrm[i]});
+      break;
+    }
+    case CallArgKind::kFloat32:
+      // movss xmmN, [rbx+arg]
+      e.Emit({0xF3, 0x0F, 0x10, static_cast<std::uint8_t>(0x83 | reg << 3)});
+      break;
+    case CallArgKind::kFloat64:
+      // movsd xmmN, [rbx+arg]
+      e.Emit({0xF2, 0x0F, 0x10, static_cast<std::uint8_t>(0x83 | reg << 3)});
+      break;
+    }
+    e.EmitU32(GetCallThunkArgOffset(i));
+  }
+
+  // mov rax, [rbx]; call rax
+  e.Emit({0x48, 0x8B, 0x03, 0xFF, 0xD0});
+  // mov [rbx+return_i64], rax
+  e.Emit({0x48, 0x89, 0x43, offsetof(CallThunkBlock, return_i64)});
+  // movsd [rbx+return_double], xmm0
+  e.Emit({0xF2, 0x0F, 0x11, 0x43, offsetof(CallThunkBlock, return_double)});
+  // movss [rbx+return_float], xmm0
+  e.Emit({0xF3, 0x0F, 0x11, 0x43, offsetof(CallThunkBlock, return_float)});
+
+  // mov rax, [rbx+get_last_error]; test rax, rax; jz skip_last_error
+  e.Emit({0x48, 0x8B, 0x43, offsetof(CallThunkBlock, get_last_error)});
+  e.Emit({0x48, 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_last_error);
+  // call rax; mov [rbx+last_error], eax
+  e.Emit({0xFF, 0xD0, 0x89, 0x43, offsetof(CallThunkBlock, last_error)});
+  e.Bind(skip_last_error);
+
+  // add rsp, frame_size; pop rbx; ret
+  e.Emit({0x48, 0x81, 0xC4});
+  e.EmitU32(frame_size);
+  e.Emit({0x5B, 0xC3});
+
+  return e.Finalize();
+}
+
+inline std::vector<std::uint8_t> GenerateCallThunk32(CallThunkKey const& key)
+{
+  auto const num_args = key.kinds.size();
+
+  // As with MSVC, the first suitable arguments from left to right are passed
+  // in ECX and EDX (see EncodeCallDescriptor).
+  std::vector<std::size_t> reg_args;
+  std::vector<std::size_t> stack_args;
+  for (std::size_t i = 0; i < num_args; ++i)
+  {
+    if (key.kinds[i] == CallArgKind::kInt32 &&
+        reg_args.size() < key.num_reg_args && reg_args.size() < 2)
+    {
+      reg_args.push_back(i);
+    }
+    else
+    {
+      stack_args.push_back(i);
+    }
+  }
+
+  CallThunkEmitter e;
+  auto const skip_fpu = e.NewLabel();
+  auto const skip_last_error = e.NewLabel();
+
+  // push ebp; mov ebp, esp; push ebx; mov ebx, [ebp+8]
+  e.Emit({0x55, 0x89, 0xE5, 0x53, 0x8B, 0x5D, 0x08});
+
+  // Right to left, high dword first.
+  for (auto i = stack_args.rbegin(); i != stack_args.rend(); ++i)
+  {
+    auto const kind = key.kinds[*i];
+    auto const offset = GetCallThunkArgOffset(*i);
+    if (kind == CallArgKind::kInt64 || kind == CallArgKind::kFloat64)
+    {
+      // push dword [ebx+arg+4]
+      e.Emit({0xFF, 0xB3});
+      e.EmitU32(offset + 4);
+    }
+    // push dword [ebx+arg]
+    e.Emit({0xFF, 0xB3});
+    e.EmitU32(offset);
+  }
+
+  for (std::size_t i = 0; i < reg_args.size(); ++i)
+  {
+    // mov ecx/edx, [ebx+arg]
+    e.Emit({0x8B, static_cast<std::uint8_t>(i == 0 ? 0x8B : 0x93)});
+    e.EmitU32(GetCallThunkArgOffset(reg_args[i]));
+  }
+
+  // mov eax, [ebx]; call eax
+  e.Emit({0x8B, 0x03, 0xFF, 0xD0});
+  // mov [ebx+return_i64], eax; mov [ebx+return_i64+4], edx
+  e.Emit({0x89, 0x43, offsetof(CallThunkBlock, return_i64)});
+  e.Emit({0x89, 0x53, offsetof(CallThunkBlock, return_i64) + 4});
+
+  // Floating point values are returned in ST(0), which is only in use if the
+  // target returned one. Popping an empty register would corrupt the FPU
+  // state, so check its tag first.
+  // fxam; fnstsw ax; and ah, 0x45; cmp ah, 0x41; je skip_fpu
+  e.Emit({0xD9, 0xE5, 0xDF, 0xE0, 0x80, 0xE4, 0x45, 0x80, 0xFC, 0x41});
+  e.EmitJump8(0x74, skip_fpu);
+  // fst dword [ebx+return_float]; fstp qword [ebx+return_double]
+  e.Emit({0xD9, 0x53, offsetof(CallThunkBlock, return_float)});
+  e.Emit({0xDD, 0x5B, offsetof(CallThunkBlock, return_double)});
+  e.Bind(skip_fpu);
+
+  // mov eax, [ebx+get_last_error]; test eax, eax; jz skip_last_error
+  e.Emit({0x8B, 0x43, offsetof(CallThunkBlock, get_last_error), 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_last_error);
+  // call eax; mov [ebx+last_error], eax
+  e.Emit({0xFF, 0xD0, 0x89, 0x43, offsetof(CallThunkBlock, last_error)});
+  e.Bind(skip_last_error);
+
+  // lea esp, [ebp-4]; pop ebx; pop ebp; ret
+  e.Emit({0x8D, 0x65, 0xFC, 0x5B, 0x5D, 0xC3});
+
+  return e.Finalize();
+}
+
+inline std::vector<std::uint8_t> GenerateCallThunk(CallThunkKey const& key)
+{
+  if (key.kinds.size() > kCallThunkMaxArgs)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Too many call arguments."});
+  }
+
+  return key.abi == CallAbi::kX64 ? GenerateCallThunk64(key)
+                                  : GenerateCallThunk32(key);
+}
+
+// DWORD WINAPI Runner(CallThunkBatch* batch), suitable for use as a thread
+// start routine.
+inline std::vector<std::uint8_t> GenerateCallThunkRunner64()
+{
+  CallThunkEmitter e;
+  auto const skip_debug = e.NewLabel();
+  auto const skip_last_error = e.NewLabel();
+  auto const loop = e.NewLabel();
+  auto const done = e.NewLabel();
+
+  // push rbx; push rsi; push rdi; sub rsp, 0x20; mov rbx, rcx
+  e.Emit({0x53, 0x56, 0x57, 0x48, 0x83, 0xEC, 0x20, 0x48, 0x89, 0xCB});
+
+  // mov rax, [rbx+is_debugger_present]; test rax, rax; jz skip_debug
+  e.Emit({0x48, 0x8B, 0x43, offsetof(CallThunkBatch, is_debugger_present)});
+  e.Emit({0x48, 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_debug);
+  // call rax; test eax, eax; jz skip_debug
+  e.Emit({0xFF, 0xD0, 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_debug);
+  // mov rax, [rbx+debug_break]; call rax
+  e.Emit({0x48, 0x8B, 0x43, offsetof(CallThunkBatch, debug_break)});
+  e.Emit({0xFF, 0xD0});
+  e.Bind(skip_debug);
+
+  // mov rax, [rbx+set_last_error]; test rax, rax; jz skip_last_error
+  e.Emit({0x48, 0x8B, 0x43, offsetof(CallThunkBatch, set_last_error)});
+  e.Emit({0x48, 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_last_error);
+  // xor ecx, ecx; call rax
+  e.Emit({0x31, 0xC9, 0xFF, 0xD0});
+  e.Bind(skip_last_error);
+
+  // mov rsi, [rbx+num_calls]; lea rdi, [rbx+sizeof(CallThunkBatch)]
+  e.Emit({0x48, 0x8B, 0x33, 0x48, 0x8D, 0x7B, sizeof(CallThunkBatch)});
+  e.Bind(loop);
+  // test rsi, rsi; jz done
+  e.Emit({0x48, 0x85, 0xF6});
+  e.EmitJump8(0x74, done);
+  // mov rcx, [rdi+block]; mov rax, [rdi+thunk]; call rax
+  e.Emit({0x48, 0x8B, 0x4F, offsetof(CallThunkEntry, block)});
+  e.Emit({0x48, 0x8B, 0x07, 0xFF, 0xD0});
+  // add rdi, sizeof(CallThunkEntry); dec rsi; jmp loop
+  e.Emit({0x48, 0x83, 0xC7, sizeof(CallThunkEntry), 0x48, 0xFF, 0xCE});
+  e.EmitJump8(0xEB, loop);
+  e.Bind(done);
+
+  // xor eax, eax; add rsp, 0x20; pop rdi; pop rsi; pop rbx; ret
+  e.Emit({0x31, 0xC0, 0x48, 0x83, 0xC4, 0x20, 0x5F, 0x5E, 0x5B, 0xC3});
+
+  return e.Finalize();
+}
+
+inline std::vector<std::uint8_t> GenerateCallThunkRunner32()
+{
+  CallThunkEmitter e;
+  auto const skip_debug = e.NewLabel();
+  auto const skip_last_error = e.NewLabel();
+  auto const loop = e.NewLabel();
+  auto const done = e.NewLabel();
+
+  // push ebp; mov ebp, esp; push ebx; push esi; push edi; mov ebx, [ebp+8]
+  e.Emit({0x55, 0x89, 0xE5, 0x53, 0x56, 0x57, 0x8B, 0x5D, 0x08});
+
+  // mov eax, [ebx+is_debugger_present]; test eax, eax; jz skip_debug
+  e.Emit({0x8B, 0x43, offsetof(CallThunkBatch, is_debugger_present)});
+  e.Emit({0x85, 0xC0});
+  e.EmitJump8(0x74, skip_debug);
+  // call eax; test eax, eax; jz skip_debug
+  e.Emit({0xFF, 0xD0, 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_debug);
+  // mov eax, [ebx+debug_break]; call eax
+  e.Emit({0x8B, 0x43, offsetof(CallThunkBatch, debug_break), 0xFF, 0xD0});
+  e.Bind(skip_debug);
+
+  // mov eax, [ebx+set_last_error]; test eax, eax; jz skip_last_error
+  e.Emit({0x8B, 0x43, offsetof(CallThunkBatch, set_last_error), 0x85, 0xC0});
+  e.EmitJump8(0x74, skip_last_error);
+  // push 0; call eax
+  e.Emit({0x6A, 0x00, 0xFF, 0xD0});
+  e.Bind(skip_last_error);
+
+  // mov esi, [ebx+num_calls]; lea edi, [ebx+sizeof(CallThunkBatch)]
+  e.Emit({0x8B, 0x33, 0x8D, 0x7B, sizeof(CallThunkBatch)});
+  e.Bind(loop);
+  // test esi, esi; jz done
+  e.Emit({0x85, 0xF6});
+  e.EmitJump8(0x74, done);
+  // push dword [edi+block]; mov eax, [edi+thunk]; call eax; add esp, 4
+  e.Emit({0xFF, 0x77, offsetof(CallThunkEntry, block)});
+  e.Emit({0x8B, 0x07, 0xFF, 0xD0, 0x83, 0xC4, 0x04});
+  // add edi, sizeof(CallThunkEntry); dec esi; jmp loop
+  e.Emit({0x83, 0xC7, sizeof(CallThunkEntry), 0x4E});
+  e.EmitJump8(0xEB, loop);
+  e.Bind(done);
+
+  // xor eax, eax; lea esp, [ebp-12]; pop edi; pop esi; pop ebx; pop ebp;
+  // ret 4
+  e.Emit({0x31, 0xC0, 0x8D, 0x65, 0xF4, 0x5F, 0x5E, 0x5B, 0x5D});
+  e.Emit({0xC2, 0x04, 0x00});
+
+  return e.Finalize();
+}
+
+inline std::vector<std::uint8_t> GenerateCallThunkRunner(CallAbi abi)
+{
+  return abi == CallAbi::kX64 ? GenerateCallThunkRunner64()
+                              : GenerateCallThunkRunner32();
+}
+
+struct CallThunkRequest
+{
+  std::uint64_t thunk;
+  std::uint64_t address;
+  std::vector<CallDescriptorArg> args;
+};
+
+inline std::size_t
+  GetCallThunkBatchSize(std::vector<CallThunkRequest> const& requests) noexcept
+{
+  std::size_t size =
+    sizeof(CallThunkBatch) + requests.size() * sizeof(CallThunkEntry);
+  for (auto const& request : requests)
+  {
+    size += GetCallThunkBlockSize(request.args.size());
+  }
+
+  return size;
+}
+
+// Lays out a batch (the header, then the entries, then the blocks) as it will
+// appear at base in the target. block_offsets receives the offset of each
+// block in the returned buffer.
+inline std::vector<std::uint8_t>
+  BuildCallThunkBatch(std::uint64_t base,
+                      CallThunkBatch header,
+                      std::uint64_t get_last_error,
+                      std::vector<CallThunkRequest> const& requests,
+                      std::vector<std::size_t>& block_offsets)
+{
+  header.num_calls = requests.size();
+
+  std::size_t offset =
+    sizeof(CallThunkBatch) + requests.size() * sizeof(CallThunkEntry);
+  block_offsets.clear();
+  block_offsets.reserve(requests.size());
+  for (auto const& request : requests)
+  {
+    block_offsets.push_back(offset);
+    offset += GetCallThunkBlockSize(request.args.size());
+  }
+
+  std::vector<std::uint8_t> buffer(offset);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  for (std::size_t i = 0; i < requests.size(); ++i)
+  {
+    auto const& request = requests[i];
+
+    CallThunkEntry const entry{request.thunk, base + block_offsets[i]};
+    std::memcpy(buffer.data() + sizeof(CallThunkBatch) +
+                  i * sizeof(CallThunkEntry),
+                &entry,
+                sizeof(entry));
+
+    CallThunkBlock block{};
+    block.address = request.address;
+    block.get_last_error = get_last_error;
+    std::memcpy(buffer.data() + block_offsets[i], &block, sizeof(block));
+
+    for (std::size_t j = 0; j < request.args.size(); ++j)
+    {
+      std::uint64_t bits = request.args[j].bits;
+      if (request.args[j].kind == CallArgKind::kInt32 ||
+          request.args[j].kind == CallArgKind::kFloat32)
+      {
+        bits &= 0xFFFFFFFFUL;
+      }
+      std::memcpy(buffer.data() + block_offsets[i] + GetCallThunkArgOffset(j),
+                  &bits,
+                  sizeof(bits));
+    }
+  }
+
+  return buffer;
+}
+
+// BackendT must provide:
+//   std::uint64_t WriteCode(std::vector<std::uint8_t> const& code);
+// which copies the code somewhere executable in the target and returns its
+// address. The code must stay valid for the lifetime of the backend.
+template <typename BackendT> class BasicCallThunkCache
+{
+public:
+  explicit BasicCallThunkCache(BackendT backend = BackendT())
+    : backend_(std::move(backend))
+  {
+  }
+
+  BasicCallThunkCache(BasicCallThunkCache const& other) = delete;
+
+  BasicCallThunkCache& operator=(BasicCallThunkCache const& other) = delete;
+
+  std::uint64_t GetThunk(CallThunkKey const& key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto const iter = thunks_.find(key);
+    if (iter != std::end(thunks_))
+    {
+      return iter->second;
+    }
+
+    auto const thunk = backend_.WriteCode(GenerateCallThunk(key));
+    thunks_.emplace(key, thunk);
+    return thunk;
+  }
+
+  std::uint64_t GetRunner(CallAbi abi)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& runner = runners_[abi == CallAbi::kX64 ? 1 : 0];
+    if (!runner)
+    {
+      runner = backend_.WriteCode(GenerateCallThunkRunner(abi));
+    }
+
+    return runner;
+  }
+
+  std::size_t GetNumThunks() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return thunks_.size();
+  }
+
+private:
+  BackendT backend_;
+  mutable std::mutex mutex_;
+  std::map<CallThunkKey, std::uint64_t> thunks_;
+  std::uint64_t runners_[2]{};
+};
+}
+}
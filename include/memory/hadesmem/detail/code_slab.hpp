@@ -0,0 +1,490 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <windows.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/error.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <hadesmem/alloc.hpp>
+#include <hadesmem/process.hpp>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// Shared allocator for small pieces of generated code (trampolines, stub gates,
+// far jump targets, etc.) which usually have to be within rel32 range of the
+// code they're patched into.
+// Rather than probing for a free page near each target (one allocation attempt
+// per page, which in a fragmented 64-bit address space can mean thousands of
+// failed syscalls per hook) and then using a whole page for a few bytes, the
+// free gaps in the range are found with a single walk of the address space, a
+// block of allocation granularity is claimed from the closest one, and slots
+// are handed out from it (and re-used via a free list, after a quarantine
+// period) until it's full.
+// The OS specific parts live in a backend so the placement logic can be tested
+// against a simulated address space.
+
+namespace hadesmem
+{
+namespace detail
+{
+struct CodeSlabRange
+{
+  std::uintptr_t base;
+  std::uintptr_t size;
+};
+
+// Returns the address of a free block of block_size bytes (aligned to
+// granularity) which lies entirely within [beg, end) and is as close to
+// preferred as possible, or zero if there is none.
+// Blocks at or above preferred are always chosen over ones below it, because
+// some third party code (e.g. Steam's overlay, see AllocatePageNear) doesn't
+// sign-extend negative displacements when following our jumps.
+inline std::uintptr_t FindCodeSlabBlock(
+  std::vector<CodeSlabRange> const& free_ranges,
+  std::uintptr_t preferred,
+  std::uintptr_t beg,
+  std::uintptr_t end,
+  std::uintptr_t block_size,
+  std::uintptr_t granularity) noexcept
+{
+  HADESMEM_DETAIL_ASSERT(granularity && !(granularity & (granularity - 1)));
+
+  auto const align_down = [&](std::uintptr_t a) {
+    return a & ~(granularity - 1);
+  };
+
+  std::uintptr_t best_above = 0;
+  std::uintptr_t best_below = 0;
+  for (auto const& range : free_ranges)
+  {
+    // Overflow checks are needed because the ranges near the top of the
+    // address space can end at (or wrap past) zero.
+    auto const range_end = range.base + range.size < range.base
+                             ? ~static_cast<std::uintptr_t>(0)
+                             : range.base + range.size;
+    auto const lo_unaligned = (std::max)(range.base, beg);
+    if (lo_unaligned > ~static_cast<std::uintptr_t>(0) - granularity)
+    {
+      continue;
+    }
+    auto const lo = align_down(lo_unaligned + granularity - 1);
+    auto const hi = (std::min)(range_end, end);
+    if (lo >= hi || hi - lo < block_size)
+    {
+      continue;
+    }
+    // Highest usable block address in this range.
+    auto const last = align_down(hi - block_size);
+    if (last < lo)
+    {
+      continue;
+    }
+
+    if (last >= preferred)
+    {
+      auto const above =
+        preferred <= lo ? lo : align_down(preferred + granularity - 1);
+      if (above <= last && above >= preferred &&
+          (!best_above || above < best_above))
+      {
+        best_above = above;
+      }
+    }
+
+    if (lo < preferred)
+    {
+      auto const below = (std::min)(last, align_down(preferred - 1));
+      if (below >= lo && below > best_below)
+      {
+        best_below = below;
+      }
+    }
+  }
+
+  return best_above ? best_above : best_below;
+}
+
+template <typename BackendT> class BasicCodeSlab;
+
+// Owns a slot in a BasicCodeSlab, which is returned to it on destruction.
+// Mirrors the interface of Allocator so it can be used in its place.
+template <typename BackendT> class BasicCodeSlot
+{
+public:
+  BasicCodeSlot() noexcept
+  {
+  }
+
+  explicit BasicCodeSlot(BasicCodeSlab<BackendT>& slab,
+                         void* base,
+                         std::size_t size) noexcept
+    : slab_{&slab}, base_{base}, size_{size}
+  {
+  }
+
+  BasicCodeSlot(BasicCodeSlot const& other) = delete;
+
+  BasicCodeSlot& operator=(BasicCodeSlot const& other) = delete;
+
+  BasicCodeSlot(BasicCodeSlot&& other) noexcept : slab_{other.slab_},
+                                                  base_{other.base_},
+                                                  size_{other.size_}
+  {
+    other.slab_ = nullptr;
+    other.base_ = nullptr;
+    other.size_ = 0;
+  }
+
+  BasicCodeSlot& operator=(BasicCodeSlot&& other) noexcept
+  {
+    Free();
+
+    slab_ = other.slab_;
+    other.slab_ = nullptr;
+
+    base_ = other.base_;
+    other.base_ = nullptr;
+
+    size_ = other.size_;
+    other.size_ = 0;
+
+    return *this;
+  }
+
+  ~BasicCodeSlot()
+  {
+    Free();
+  }
+
+  void Free() noexcept
+  {
+    if (!slab_)
+    {
+      return;
+    }
+
+    slab_->Free(base_, size_);
+
+    slab_ = nullptr;
+    base_ = nullptr;
+    size_ = 0;
+  }
+
+  void* GetBase() const noexcept
+  {
+    return base_;
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return size_;
+  }
+
+private:
+  BasicCodeSlab<BackendT>* slab_{};
+  void* base_{};
+  std::size_t size_{};
+};
+
+// BackendT must provide:
+//   std::uintptr_t GetGranularity() const;
+//   std::vector<CodeSlabRange> GetFreeRanges(std::uintptr_t beg,
+//                                            std::uintptr_t end) const;
+//   void* Reserve(std::uintptr_t address, std::size_t size);
+//   void Release(void* address, std::size_t size) noexcept;
+//   std::uint64_t GetTime() const noexcept; // Milliseconds, monotonic.
+// Reserve returns null (rather than throwing) if the address is no longer
+// free, as another allocator can take it between the walk and the call.
+template <typename BackendT> class BasicCodeSlab
+{
+public:
+  using SlotT = BasicCodeSlot<BackendT>;
+
+  static std::size_t const kSlotAlignment = 16;
+
+  // Minimum time (in milliseconds) between a slot being freed and reused.
+  static std::uint64_t const kQuarantineTime = 1000;
+
+  explicit BasicCodeSlab(BackendT backend = BackendT())
+    : backend_(std::move(backend))
+  {
+  }
+
+  BasicCodeSlab(BasicCodeSlab const& other) = delete;
+
+  BasicCodeSlab& operator=(BasicCodeSlab const& other) = delete;
+
+  ~BasicCodeSlab()
+  {
+    for (auto const& block : blocks_)
+    {
+      backend_.Release(reinterpret_cast<void*>(block.base), block.size);
+    }
+  }
+
+  // Allocates a slot which lies entirely within [beg, end), preferring
+  // addresses close to (and at or above) preferred.
+  SlotT Allocate(std::size_t size,
+                 std::uintptr_t beg,
+                 std::uintptr_t end,
+                 std::uintptr_t preferred)
+  {
+    HADESMEM_DETAIL_ASSERT(size);
+    auto const slot_size = (size + kSlotAlignment - 1) & ~(kSlotAlignment - 1);
+    auto const fits = [&](std::uintptr_t address) {
+      return address >= beg && address < end && end - address >= slot_size;
+    };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ReleaseQuarantine();
+
+    auto const free_iter = free_slots_.find(slot_size);
+    if (free_iter != std::end(free_slots_))
+    {
+      auto& slots = free_iter->second;
+      for (auto i = std::begin(slots); i != std::end(slots); ++i)
+      {
+        if (fits(*i))
+        {
+          auto const address = *i;
+          *i = slots.back();
+          slots.pop_back();
+          return SlotT{*this, reinterpret_cast<void*>(address), slot_size};
+        }
+      }
+    }
+
+    for (auto& block : blocks_)
+    {
+      auto const address = block.base + block.used;
+      if (block.size - block.used >= slot_size && fits(address))
+      {
+        block.used += slot_size;
+        return SlotT{*this, reinterpret_cast<void*>(address), slot_size};
+      }
+    }
+
+    auto const granularity = backend_.GetGranularity();
+    auto const block_size = static_cast<std::size_t>(
+      (slot_size + granularity - 1) & ~(granularity - 1));
+    // Retry a few times in case we lose a race for the block we found.
+    std::size_t const kMaxAttempts = 4;
+    for (std::size_t i = 0; i < kMaxAttempts; ++i)
+    {
+      auto const free_ranges = backend_.GetFreeRanges(beg, end);
+      auto const address = FindCodeSlabBlock(
+        free_ranges, preferred, beg, end, block_size, granularity);
+      if (!address)
+      {
+        break;
+      }
+
+      if (backend_.Reserve(address, block_size))
+      {
+        blocks_.push_back(Block{address, block_size, slot_size});
+        return SlotT{*this, reinterpret_cast<void*>(address), slot_size};
+      }
+    }
+
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Failed to find a free code block in range."});
+  }
+
+  // Allocates a slot within rel32 range of address (i.e. reachable with a
+  // relative jump or call, or RIP-relative addressing).
+  SlotT AllocateNear(void* address, std::size_t size)
+  {
+    auto const target = reinterpret_cast<std::uintptr_t>(address);
+    auto const max_address = ~static_cast<std::uintptr_t>(0);
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+    std::uintptr_t const kReach = 0x7FFFFF00;
+    auto const beg = target > kReach ? target - kReach : 0;
+    auto const end =
+      max_address - target > kReach ? target + kReach : max_address;
+    return Allocate(size, beg, end, target);
+#elif defined(HADESMEM_DETAIL_ARCH_X86)
+    // Displacements wrap, so everything is in range.
+    return Allocate(size, 0, max_address, target);
+#else
+#error "[HadesMem] Unsupported architecture."
+#endif
+  }
+
+  // Slots are never released back to the OS. Nor are they reused straight
+  // away, as a thread can still be in one after the patch which owned it is
+  // removed (e.g. preempted part way through a trampoline, or returning
+  // through a stub gate). Freed slots are quarantined for kQuarantineTime
+  // first, which makes reusing one under a running thread unlikely but not
+  // impossible, so owners should still avoid freeing slots which they know
+  // are in use (e.g. while a detour's ref count is non-zero).
+  void Free(void* address, std::size_t size) noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    try
+    {
+      quarantine_.push_back(QuarantinedSlot{
+        reinterpret_cast<std::uintptr_t>(address), size, backend_.GetTime()});
+    }
+    catch (...)
+    {
+      // Leaking the slot is the only option.
+    }
+  }
+
+  std::size_t GetNumBlocks() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return blocks_.size();
+  }
+
+private:
+  struct Block
+  {
+    std::uintptr_t base;
+    std::size_t size;
+    std::size_t used;
+  };
+
+  struct QuarantinedSlot
+  {
+    std::uintptr_t address;
+    std::size_t size;
+    std::uint64_t freed_at;
+  };
+
+  // Moves slots which have been quarantined for long enough to the free
+  // list. Slots are quarantined in the order they're freed, so this stops at
+  // the first one which hasn't.
+  void ReleaseQuarantine()
+  {
+    auto const now = backend_.GetTime();
+    while (!quarantine_.empty() &&
+           now - quarantine_.front().freed_at >= kQuarantineTime)
+    {
+      auto const& slot = quarantine_.front();
+      free_slots_[slot.size].push_back(slot.address);
+      quarantine_.pop_front();
+    }
+  }
+
+  BackendT backend_;
+  mutable std::mutex mutex_;
+  std::vector<Block> blocks_;
+  // Keyed by (aligned) slot size.
+  std::map<std::size_t, std::vector<std::uintptr_t>> free_slots_;
+  std::deque<QuarantinedSlot> quarantine_;
+};
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+class ProcessCodeSlabBackend
+{
+public:
+  explicit ProcessCodeSlabBackend(Process const& process) : process_(process)
+  {
+    SYSTEM_INFO sys_info{};
+    ::GetSystemInfo(&sys_info);
+    granularity_ = sys_info.dwAllocationGranularity;
+    min_address_ =
+      reinterpret_cast<std::uintptr_t>(sys_info.lpMinimumApplicationAddress);
+    max_address_ =
+      reinterpret_cast<std::uintptr_t>(sys_info.lpMaximumApplicationAddress);
+  }
+
+  std::uintptr_t GetGranularity() const noexcept
+  {
+    return granularity_;
+  }
+
+  // Only walks the regions overlapping [beg, end), not the whole address
+  // space.
+  std::vector<CodeSlabRange> GetFreeRanges(std::uintptr_t beg,
+                                           std::uintptr_t end) const
+  {
+    std::vector<CodeSlabRange> free_ranges;
+    auto address = (std::max)(beg, min_address_);
+    end = (std::min)(end, max_address_);
+    while (address < end)
+    {
+      MEMORY_BASIC_INFORMATION mbi{};
+      if (::VirtualQueryEx(process_.GetHandle(),
+                           reinterpret_cast<void const*>(address),
+                           &mbi,
+                           sizeof(mbi)) != sizeof(mbi))
+      {
+        break;
+      }
+
+      auto const region_base =
+        reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+      auto const region_end = region_base + mbi.RegionSize;
+      if (mbi.State == MEM_FREE)
+      {
+        free_ranges.push_back(CodeSlabRange{region_base, mbi.RegionSize});
+      }
+
+      if (region_end <= address)
+      {
+        break;
+      }
+      address = region_end;
+    }
+
+    return free_ranges;
+  }
+
+  void* Reserve(std::uintptr_t address, std::size_t size) noexcept
+  {
+    return TryAlloc(process_, size, reinterpret_cast<void*>(address));
+  }
+
+  void Release(void* address, std::size_t /*size*/) noexcept
+  {
+    ::VirtualFreeEx(process_.GetHandle(), address, 0, MEM_RELEASE);
+  }
+
+  std::uint64_t GetTime() const noexcept
+  {
+    return ::GetTickCount64();
+  }
+
+private:
+  Process process_;
+  std::uintptr_t granularity_{};
+  std::uintptr_t min_address_{};
+  std::uintptr_t max_address_{};
+};
+
+using CodeSlab = BasicCodeSlab<ProcessCodeSlabBackend>;
+using CodeSlot = CodeSlab::SlotT;
+
+// Shared by all patchers in the current process. Intentionally leaked, as
+// patches which are destroyed during static destruction (or code which is
+// still running in a slot) may outlive any static object.
+inline CodeSlab& GetLocalCodeSlab()
+{
+  static CodeSlab* const slab = new CodeSlab{
+    ProcessCodeSlabBackend{Process{::GetCurrentProcessId()}}};
+  return *slab;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+}
@@ -3,64 +3,558 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
-#include <windows.h>
-
 #include <hadesmem/config.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/detail/smart_handle.hpp>
+
+// Incremental hashes. Each hasher is used the same way: construct it, call
+// Update any number of times, then call Final once to get the digest.
+// MD5 and SHA-1 are only here for compatibility with existing tools (e.g.
+// imphash, which is defined in terms of MD5) and shouldn't be relied on for
+// anything security sensitive.
+// XxHash64 is a fast non-cryptographic hash, for things like deduplication
+// and cache keys where speed matters more than collision resistance against
+// an attacker.
 
 namespace hadesmem
 {
 namespace detail
 {
-inline std::array<std::uint8_t, 20> GetSha1Hash(void* base, std::uint32_t size)
+inline std::uint32_t RotateLeft32(std::uint32_t value, unsigned int count)
+{
+  return (value << count) | (value >> (32 - count));
+}
+
+inline std::uint32_t RotateRight32(std::uint32_t value, unsigned int count)
+{
+  return (value >> count) | (value << (32 - count));
+}
+
+inline std::uint64_t RotateLeft64(std::uint64_t value, unsigned int count)
+{
+  return (value << count) | (value >> (64 - count));
+}
+
+inline std::uint32_t LoadBigEndian32(std::uint8_t const* p)
+{
+  return (static_cast<std::uint32_t>(p[0]) << 24) |
+         (static_cast<std::uint32_t>(p[1]) << 16) |
+         (static_cast<std::uint32_t>(p[2]) << 8) | p[3];
+}
+
+inline void StoreBigEndian32(std::uint8_t* p, std::uint32_t value)
+{
+  p[0] = static_cast<std::uint8_t>(value >> 24);
+  p[1] = static_cast<std::uint8_t>(value >> 16);
+  p[2] = static_cast<std::uint8_t>(value >> 8);
+  p[3] = static_cast<std::uint8_t>(value);
+}
+
+inline std::uint32_t LoadLittleEndian32(std::uint8_t const* p)
+{
+  return (static_cast<std::uint32_t>(p[3]) << 24) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[1]) << 8) | p[0];
+}
+
+inline std::uint64_t LoadLittleEndian64(std::uint8_t const* p)
+{
+  return (static_cast<std::uint64_t>(LoadLittleEndian32(p + 4)) << 32) |
+         LoadLittleEndian32(p);
+}
+
+inline void StoreLittleEndian32(std::uint8_t* p, std::uint32_t value)
+{
+  p[0] = static_cast<std::uint8_t>(value);
+  p[1] = static_cast<std::uint8_t>(value >> 8);
+  p[2] = static_cast<std::uint8_t>(value >> 16);
+  p[3] = static_cast<std::uint8_t>(value >> 24);
+}
+
+// Buffering and padding shared by the Merkle-Damgard hashes (MD5, SHA-1 and
+// SHA-256), which all use 64-byte blocks and differ only in the compression
+// function, the initial state, and the byte order of the message length.
+template <typename Derived, bool BigEndian> class BlockHash
+{
+public:
+  void Update(void const* data, std::size_t len)
+  {
+    auto p = static_cast<std::uint8_t const*>(data);
+    total_len_ += len;
+
+    if (buffer_len_)
+    {
+      auto const n = (std::min)(len, kBlockSize - buffer_len_);
+      std::memcpy(&buffer_[buffer_len_], p, n);
+      buffer_len_ += n;
+      p += n;
+      len -= n;
+      if (buffer_len_ != kBlockSize)
+      {
+        return;
+      }
+      static_cast<Derived*>(this)->Transform(buffer_.data());
+      buffer_len_ = 0;
+    }
+
+    for (; len >= kBlockSize; p += kBlockSize, len -= kBlockSize)
+    {
+      static_cast<Derived*>(this)->Transform(p);
+    }
+
+    std::memcpy(buffer_.data(), p, len);
+    buffer_len_ = len;
+  }
+
+protected:
+  static std::size_t const kBlockSize = 64;
+
+  void Pad()
+  {
+    auto const bit_len = total_len_ * 8;
+
+    std::uint8_t const marker = 0x80;
+    Update(&marker, 1);
+    std::uint8_t const zeroes[kBlockSize] = {};
+    Update(zeroes,
+           (kBlockSize * 2 - 8 - buffer_len_) % kBlockSize);
+
+    std::uint8_t len_buf[8];
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      auto const shift = BigEndian ? (56 - i * 8) : (i * 8);
+      len_buf[i] = static_cast<std::uint8_t>(bit_len >> shift);
+    }
+    Update(len_buf, sizeof(len_buf));
+  }
+
+private:
+  std::array<std::uint8_t, kBlockSize> buffer_{};
+  std::size_t buffer_len_{0};
+  std::uint64_t total_len_{0};
+};
+
+class Md5 : public BlockHash<Md5, false>
+{
+public:
+  using Digest = std::array<std::uint8_t, 16>;
+
+  Digest Final()
+  {
+    Pad();
+
+    Digest digest;
+    for (std::size_t i = 0; i < state_.size(); ++i)
+    {
+      StoreLittleEndian32(&digest[i * 4], state_[i]);
+    }
+    return digest;
+  }
+
+private:
+  friend class BlockHash<Md5, false>;
+
+  void Transform(std::uint8_t const* block)
+  {
+    static std::uint32_t const k[64] = {
+      0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+      0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+      0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+      0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+      0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+      0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+      0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+      0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+      0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+      0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+      0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+    static unsigned int const r[64] = {
+      7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+      5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+      4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+      6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+    std::uint32_t m[16];
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+      m[i] = LoadLittleEndian32(block + i * 4);
+    }
+
+    auto a = state_[0];
+    auto b = state_[1];
+    auto c = state_[2];
+    auto d = state_[3];
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+      std::uint32_t f;
+      std::size_t g;
+      if (i < 16)
+      {
+        f = (b & c) | (~b & d);
+        g = i;
+      }
+      else if (i < 32)
+      {
+        f = (d & b) | (~d & c);
+        g = (5 * i + 1) % 16;
+      }
+      else if (i < 48)
+      {
+        f = b ^ c ^ d;
+        g = (3 * i + 5) % 16;
+      }
+      else
+      {
+        f = c ^ (b | ~d);
+        g = (7 * i) % 16;
+      }
+
+      auto const tmp = d;
+      d = c;
+      c = b;
+      b += RotateLeft32(a + f + k[i] + m[g], r[i]);
+      a = tmp;
+    }
+
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+  }
+
+  std::array<std::uint32_t, 4> state_{
+    {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476}};
+};
+
+class Sha1 : public BlockHash<Sha1, true>
+{
+public:
+  using Digest = std::array<std::uint8_t, 20>;
+
+  Digest Final()
+  {
+    Pad();
+
+    Digest digest;
+    for (std::size_t i = 0; i < state_.size(); ++i)
+    {
+      StoreBigEndian32(&digest[i * 4], state_[i]);
+    }
+    return digest;
+  }
+
+private:
+  friend class BlockHash<Sha1, true>;
+
+  void Transform(std::uint8_t const* block)
+  {
+    std::uint32_t w[80];
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+      w[i] = LoadBigEndian32(block + i * 4);
+    }
+    for (std::size_t i = 16; i < 80; ++i)
+    {
+      w[i] = RotateLeft32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    auto a = state_[0];
+    auto b = state_[1];
+    auto c = state_[2];
+    auto d = state_[3];
+    auto e = state_[4];
+    for (std::size_t i = 0; i < 80; ++i)
+    {
+      std::uint32_t f;
+      std::uint32_t k;
+      if (i < 20)
+      {
+        f = (b & c) | (~b & d);
+        k = 0x5a827999;
+      }
+      else if (i < 40)
+      {
+        f = b ^ c ^ d;
+        k = 0x6ed9eba1;
+      }
+      else if (i < 60)
+      {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8f1bbcdc;
+      }
+      else
+      {
+        f = b ^ c ^ d;
+        k = 0xca62c1d6;
+      }
+
+      auto const tmp = RotateLeft32(a, 5) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = RotateLeft32(b, 30);
+      b = a;
+      a = tmp;
+    }
+
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+  }
+
+  std::array<std::uint32_t, 5> state_{
+    {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0}};
+};
+
+class Sha256 : public BlockHash<Sha256, true>
 {
-  HCRYPTPROV provider = 0;
-  if (!::CryptAcquireContextW(
-        &provider, nullptr, nullptr, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT))
+public:
+  using Digest = std::array<std::uint8_t, 32>;
+
+  Digest Final()
   {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      hadesmem::Error{} << hadesmem::ErrorString{"CryptAcquireContextW failed."}
-                        << hadesmem::ErrorCodeWinLast{last_error});
+    Pad();
+
+    Digest digest;
+    for (std::size_t i = 0; i < state_.size(); ++i)
+    {
+      StoreBigEndian32(&digest[i * 4], state_[i]);
+    }
+    return digest;
   }
-  hadesmem::detail::SmartCryptContextHandle release_provider{provider};
 
-  HCRYPTHASH hash = 0;
-  if (!::CryptCreateHash(provider, CALG_SHA1, 0, 0, &hash))
+private:
+  friend class BlockHash<Sha256, true>;
+
+  void Transform(std::uint8_t const* block)
   {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      hadesmem::Error{} << hadesmem::ErrorString{"CryptCreateHash failed."}
-                        << hadesmem::ErrorCodeWinLast{last_error});
+    static std::uint32_t const k[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+      0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+      0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+      0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+      0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+      0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+      0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+      0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    std::uint32_t w[64];
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+      w[i] = LoadBigEndian32(block + i * 4);
+    }
+    for (std::size_t i = 16; i < 64; ++i)
+    {
+      auto const s0 = RotateRight32(w[i - 15], 7) ^
+                      RotateRight32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      auto const s1 = RotateRight32(w[i - 2], 17) ^
+                      RotateRight32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    auto a = state_[0];
+    auto b = state_[1];
+    auto c = state_[2];
+    auto d = state_[3];
+    auto e = state_[4];
+    auto f = state_[5];
+    auto g = state_[6];
+    auto h = state_[7];
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+      auto const s1 =
+        RotateRight32(e, 6) ^ RotateRight32(e, 11) ^ RotateRight32(e, 25);
+      auto const ch = (e & f) ^ (~e & g);
+      auto const t1 = h + s1 + ch + k[i] + w[i];
+      auto const s0 =
+        RotateRight32(a, 2) ^ RotateRight32(a, 13) ^ RotateRight32(a, 22);
+      auto const maj = (a & b) ^ (a & c) ^ (b & c);
+      auto const t2 = s0 + maj;
+
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+    state_[5] += f;
+    state_[6] += g;
+    state_[7] += h;
   }
-  hadesmem::detail::SmartCryptHashHandle release_hash{hash};
 
-  if (!::CryptHashData(hash, static_cast<std::uint8_t*>(base), size, 0))
+  std::array<std::uint32_t, 8> state_{{0x6a09e667,
+                                       0xbb67ae85,
+                                       0x3c6ef372,
+                                       0xa54ff53a,
+                                       0x510e527f,
+                                       0x9b05688c,
+                                       0x1f83d9ab,
+                                       0x5be0cd19}};
+};
+
+// XXH64. The digest is stored big endian, so its string form matches the
+// canonical representation used by other implementations.
+class XxHash64
+{
+public:
+  using Digest = std::array<std::uint8_t, 8>;
+
+  explicit XxHash64(std::uint64_t seed = 0)
+    : seed_{seed},
+      acc_{{seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1}}
   {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      hadesmem::Error{} << hadesmem::ErrorString{"CryptHashData failed."}
-                        << hadesmem::ErrorCodeWinLast{last_error});
   }
 
-  std::uint32_t const kSha1Len = 20;
-  std::array<BYTE, kSha1Len> sha1 = {};
-  DWORD sha1_len = kSha1Len;
-  if (!::CryptGetHashParam(hash, HP_HASHVAL, sha1.data(), &sha1_len, 0) ||
-      sha1_len != kSha1Len)
+  void Update(void const* data, std::size_t len)
   {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      hadesmem::Error{} << hadesmem::ErrorString{"CryptGetHashParam failed."}
-                        << hadesmem::ErrorCodeWinLast{last_error});
+    auto p = static_cast<std::uint8_t const*>(data);
+    total_len_ += len;
+
+    if (buffer_len_)
+    {
+      auto const n = (std::min)(len, kStripeSize - buffer_len_);
+      std::memcpy(&buffer_[buffer_len_], p, n);
+      buffer_len_ += n;
+      p += n;
+      len -= n;
+      if (buffer_len_ != kStripeSize)
+      {
+        return;
+      }
+      ConsumeStripe(buffer_.data());
+      buffer_len_ = 0;
+    }
+
+    for (; len >= kStripeSize; p += kStripeSize, len -= kStripeSize)
+    {
+      ConsumeStripe(p);
+    }
+
+    std::memcpy(buffer_.data(), p, len);
+    buffer_len_ = len;
+  }
+
+  std::uint64_t FinalValue() const
+  {
+    std::uint64_t h;
+    if (total_len_ >= kStripeSize)
+    {
+      h = RotateLeft64(acc_[0], 1) + RotateLeft64(acc_[1], 7) +
+          RotateLeft64(acc_[2], 12) + RotateLeft64(acc_[3], 18);
+      for (auto const acc : acc_)
+      {
+        h = (h ^ Round(0, acc)) * kPrime1 + kPrime4;
+      }
+    }
+    else
+    {
+      h = seed_ + kPrime5;
+    }
+
+    h += total_len_;
+
+    auto p = buffer_.data();
+    auto const end = p + buffer_len_;
+    for (; p + 8 <= end; p += 8)
+    {
+      h ^= Round(0, LoadLittleEndian64(p));
+      h = RotateLeft64(h, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end)
+    {
+      h ^= LoadLittleEndian32(p) * kPrime1;
+      h = RotateLeft64(h, 23) * kPrime2 + kPrime3;
+      p += 4;
+    }
+    for (; p != end; ++p)
+    {
+      h ^= *p * kPrime5;
+      h = RotateLeft64(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  Digest Final() const
+  {
+    auto const value = FinalValue();
+    Digest digest;
+    for (std::size_t i = 0; i < digest.size(); ++i)
+    {
+      digest[i] = static_cast<std::uint8_t>(value >> (56 - i * 8));
+    }
+    return digest;
+  }
+
+private:
+  static std::uint64_t const kPrime1 = 0x9E3779B185EBCA87ULL;
+  static std::uint64_t const kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  static std::uint64_t const kPrime3 = 0x165667B19E3779F9ULL;
+  static std::uint64_t const kPrime4 = 0x85EBCA77C2B2AE63ULL;
+  static std::uint64_t const kPrime5 = 0x27D4EB2F165667C5ULL;
+  static std::size_t const kStripeSize = 32;
+
+  static std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+  {
+    return RotateLeft64(acc + input * kPrime2, 31) * kPrime1;
   }
 
-  return sha1;
+  void ConsumeStripe(std::uint8_t const* p)
+  {
+    for (std::size_t i = 0; i < acc_.size(); ++i)
+    {
+      acc_[i] = Round(acc_[i], LoadLittleEndian64(p + i * 8));
+    }
+  }
+
+  std::uint64_t seed_;
+  std::array<std::uint64_t, 4> acc_;
+  std::array<std::uint8_t, kStripeSize> buffer_{};
+  std::size_t buffer_len_{0};
+  std::uint64_t total_len_{0};
+};
+
+template <typename Hash>
+inline typename Hash::Digest GetHash(void const* base, std::size_t size)
+{
+  Hash hash;
+  hash.Update(base, size);
+  return hash.Final();
+}
+
+inline std::array<std::uint8_t, 20> GetSha1Hash(void const* base,
+                                                std::size_t size)
+{
+  return GetHash<Sha1>(base, size);
+}
+
+inline std::array<std::uint8_t, 32> GetSha256Hash(void const* base,
+                                                  std::size_t size)
+{
+  return GetHash<Sha256>(base, size);
 }
 
 template <std::size_t Size>
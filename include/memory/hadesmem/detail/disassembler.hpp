@@ -0,0 +1,152 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/insn_decoder.hpp>
+#include <hadesmem/error.hpp>
+
+// Interface to whatever is being used to decode instructions, so patching
+// code doesn't depend on a particular library. Decoding produces compact
+// records with no string formatting. Text is only produced on request, by
+// backends which support it.
+
+namespace hadesmem
+{
+namespace detail
+{
+struct InsnRecord
+{
+  std::uint8_t length;
+  InsnBranch branch;
+  // Jcc condition code (the low nibble of the opcode).
+  std::uint8_t condition;
+  // Offset and size of the relative operand, if any. For branches this is the
+  // displacement to the target, for RIP-relative operands the disp32.
+  std::uint8_t rel_offset;
+  std::uint8_t rel_size;
+  bool rip_relative;
+};
+
+class Disassembler
+{
+public:
+  explicit Disassembler(InsnMode mode) noexcept : mode_{mode}
+  {
+  }
+
+  virtual ~Disassembler()
+  {
+  }
+
+  InsnMode GetMode() const noexcept
+  {
+    return mode_;
+  }
+
+  // Identifies the backend, so results from different decoders are never
+  // mixed up (e.g. by DisassemblyCache). Any address unique to the backend,
+  // normally that of a static.
+  virtual void const* GetBackendId() const noexcept = 0;
+
+  // Decodes a single instruction from code, which lives at address. Returns
+  // false if it isn't valid or doesn't fit in size.
+  virtual bool Decode(std::uint8_t const* code,
+                      std::size_t size,
+                      std::uint64_t address,
+                      InsnRecord& insn) const = 0;
+
+  // Text for a single instruction, or an empty string if this backend can't
+  // format instructions.
+  virtual std::string Format(std::uint8_t const* code,
+                             std::size_t size,
+                             std::uint64_t address) const
+  {
+    (void)code;
+    (void)size;
+    (void)address;
+    return {};
+  }
+
+  // Decodes whole instructions until at least min_size bytes are covered.
+  std::vector<InsnRecord> DecodeUntil(std::uint8_t const* code,
+                                      std::size_t size,
+                                      std::uint64_t address,
+                                      std::size_t min_size) const
+  {
+    std::vector<InsnRecord> insns;
+    std::size_t offset = 0;
+    while (offset < min_size)
+    {
+      InsnRecord insn{};
+      if (!Decode(code + offset, size - offset, address + offset, insn))
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                        << ErrorString{"Disassembly failed."});
+      }
+
+      offset += insn.length;
+      insns.push_back(insn);
+    }
+
+    return insns;
+  }
+
+private:
+  InsnMode mode_;
+};
+
+// Backed by the built-in decoder in insn_decoder.hpp. Can't format.
+class InsnDecoderDisassembler : public Disassembler
+{
+public:
+  explicit InsnDecoderDisassembler(InsnMode mode) noexcept : Disassembler{mode}
+  {
+  }
+
+  virtual void const* GetBackendId() const noexcept override
+  {
+    static char const id{};
+    return &id;
+  }
+
+  virtual bool Decode(std::uint8_t const* code,
+                      std::size_t size,
+                      std::uint64_t address,
+                      InsnRecord& insn) const override
+  {
+    (void)address;
+
+    InsnInfo info{};
+    if (!DecodeInsn(code, size, GetMode(), info))
+    {
+      return false;
+    }
+
+    insn = InsnRecord{};
+    insn.length = info.length;
+    insn.branch = info.branch;
+    insn.condition = info.condition;
+    insn.rip_relative = info.rip_relative;
+    if (info.branch != InsnBranch::kNone)
+    {
+      insn.rel_offset = info.imm_offset;
+      insn.rel_size = info.imm_size;
+    }
+    else if (info.rip_relative)
+    {
+      insn.rel_offset = info.disp_offset;
+      insn.rel_size = info.disp_size;
+    }
+
+    return true;
+  }
+};
+}
+}
@@ -0,0 +1,172 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/disassembler.hpp>
+
+// Remembers the result of Disassembler::DecodeUntil, so re-applying a hook (or
+// walking a hook chain) doesn't decode the same prologue again. Entries are
+// keyed by backend, address, mode, size and a hash of the bytes. The bytes
+// themselves are stored as well and compared on lookup, so a patched or
+// reused address is never given stale results.
+
+namespace hadesmem
+{
+namespace detail
+{
+class DisassemblyCache
+{
+public:
+  explicit DisassemblyCache(std::size_t max_entries = 1024)
+    : max_entries_{max_entries}
+  {
+  }
+
+  DisassemblyCache(DisassemblyCache const&) = delete;
+
+  DisassemblyCache& operator=(DisassemblyCache const&) = delete;
+
+  std::vector<InsnRecord> DecodeUntil(Disassembler const& disassembler,
+                                      std::uint8_t const* code,
+                                      std::size_t size,
+                                      std::uint64_t address,
+                                      std::size_t min_size)
+  {
+    Key const key{disassembler.GetBackendId(),
+                  address,
+                  HashBytes(code, (std::min)(size, min_size)),
+                  min_size,
+                  disassembler.GetMode()};
+
+    {
+      std::lock_guard<std::mutex> const lock{mutex_};
+      auto const iter = cache_.find(key);
+      if (iter != std::end(cache_))
+      {
+        auto const& bytes = iter->second.bytes;
+        if (bytes.size() <= size &&
+            std::memcmp(bytes.data(), code, bytes.size()) == 0)
+        {
+          ++num_hits_;
+          return iter->second.insns;
+        }
+      }
+
+      ++num_misses_;
+    }
+
+    // Decode outside the lock, it may throw and doesn't need it.
+    Entry entry;
+    entry.insns = disassembler.DecodeUntil(code, size, address, min_size);
+    std::size_t covered = 0;
+    for (auto const& insn : entry.insns)
+    {
+      covered += insn.length;
+    }
+    entry.bytes.assign(code, code + covered);
+
+    std::lock_guard<std::mutex> const lock{mutex_};
+    // Don't bother with LRU, the working set is normally much smaller than
+    // the limit. This is just to stop unbounded growth.
+    if (cache_.size() >= max_entries_)
+    {
+      cache_.clear();
+    }
+    cache_[key] = entry;
+    return entry.insns;
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    cache_.clear();
+  }
+
+  std::size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    return cache_.size();
+  }
+
+  std::size_t GetNumHits() const
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    return num_hits_;
+  }
+
+  std::size_t GetNumMisses() const
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    return num_misses_;
+  }
+
+private:
+  // FNV-1a.
+  static std::uint64_t HashBytes(std::uint8_t const* code,
+                                 std::size_t size) noexcept
+  {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash = (hash ^ code[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+  }
+
+  struct Key
+  {
+    void const* backend;
+    std::uint64_t address;
+    std::uint64_t hash;
+    std::size_t min_size;
+    InsnMode mode;
+
+    bool operator==(Key const& other) const noexcept
+    {
+      return backend == other.backend && address == other.address &&
+             hash == other.hash && min_size == other.min_size &&
+             mode == other.mode;
+    }
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(Key const& key) const noexcept
+    {
+      return static_cast<std::size_t>(
+        key.address ^ key.hash ^ (key.min_size << 1) ^
+        static_cast<std::size_t>(key.mode) ^
+        reinterpret_cast<std::uintptr_t>(key.backend));
+    }
+  };
+
+  struct Entry
+  {
+    std::vector<std::uint8_t> bytes;
+    std::vector<InsnRecord> insns;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, Entry, KeyHash> cache_;
+  std::size_t max_entries_;
+  std::size_t num_hits_{};
+  std::size_t num_misses_{};
+};
+
+inline DisassemblyCache& GetLocalDisassemblyCache()
+{
+  static DisassemblyCache* const cache = new DisassemblyCache{};
+  return *cache;
+}
+}
+}
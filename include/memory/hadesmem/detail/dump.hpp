@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -14,10 +16,17 @@
 #include <psapi.h>
 
 #include <hadesmem/config.hpp>
+#include <hadesmem/detail/dump_capture.hpp>
+#include <hadesmem/detail/export_index.hpp>
 #include <hadesmem/detail/filesystem.hpp>
+#include <hadesmem/detail/mapped_file.hpp>
+#include <hadesmem/detail/parallel_for.hpp>
+#include <hadesmem/detail/pe_checksum.hpp>
 #include <hadesmem/detail/peb.hpp>
+#include <hadesmem/detail/read_impl.hpp>
 #include <hadesmem/detail/str_conv.hpp>
 #include <hadesmem/find_procedure.hpp>
+#include <hadesmem/memory_snapshot.hpp>
 #include <hadesmem/pelib/dos_header.hpp>
 #include <hadesmem/pelib/export.hpp>
 #include <hadesmem/pelib/export_dir.hpp>
@@ -34,6 +43,8 @@
 #include <hadesmem/process_helpers.hpp>
 #include <hadesmem/region.hpp>
 #include <hadesmem/region_list.hpp>
+#include <hadesmem/region_snapshot.hpp>
+#include <hadesmem/scanner.hpp>
 
 // TODO: Clean this up. It's a mess right now...
 
@@ -55,7 +66,8 @@ struct DumpFlags
     kUseOriginalImagePath = 1 << 1,
     kReconstructImports = 1 << 2,
     kAddNewSection = 1 << 3,
-    kInvalidFlagMaxValue = 1 << 4,
+    kFixChecksum = 1 << 4,
+    kInvalidFlagMaxValue = 1 << 5,
   };
 };
 
@@ -75,11 +87,10 @@ inline std::uint64_t RoundUp(std::uint64_t n, std::uint64_t m)
   return n + m - r;
 }
 
-inline void WriteDumpFile(Process const& process,
-                          std::wstring const& region_name,
-                          void const* buffer,
-                          std::size_t size,
-                          std::wstring const& dir_name = L"dumps")
+inline std::wstring MakeDumpFilePath(std::wstring const& proc_path,
+                                     DWORD pid,
+                                     std::wstring const& region_name,
+                                     std::wstring const& dir_name)
 {
   HADESMEM_DETAIL_TRACE_A("Creating dump dir.");
 
@@ -88,12 +99,10 @@ inline void WriteDumpFile(Process const& process,
 
   HADESMEM_DETAIL_TRACE_A("Generating file name.");
 
-  auto const proc_path = GetPath(process);
   auto const proc_name_dir =
     CombinePath(dumps_dir, proc_path.substr(proc_path.rfind(L'\\') + 1));
   CreateDirectoryWrapper(proc_name_dir, false);
-  auto const proc_pid_dir =
-    CombinePath(proc_name_dir, std::to_wstring(process.GetId()));
+  auto const proc_pid_dir = CombinePath(proc_name_dir, std::to_wstring(pid));
   CreateDirectoryWrapper(proc_pid_dir, false);
   std::wstring dump_path = CombinePath(proc_pid_dir, region_name);
 
@@ -103,6 +112,19 @@ inline void WriteDumpFile(Process const& process,
       Error() << ErrorString("Target file already exists."));
   }
 
+  return dump_path;
+}
+
+inline void WriteDumpFile(std::wstring const& proc_path,
+                          DWORD pid,
+                          std::wstring const& region_name,
+                          void const* buffer,
+                          std::size_t size,
+                          std::wstring const& dir_name = L"dumps")
+{
+  auto const dump_path =
+    MakeDumpFilePath(proc_path, pid, region_name, dir_name);
+
   HADESMEM_DETAIL_TRACE_A("Opening file.");
 
   auto const dump_file =
@@ -122,6 +144,121 @@ inline void WriteDumpFile(Process const& process,
   }
 }
 
+inline void WriteDumpFile(Process const& process,
+                          std::wstring const& region_name,
+                          void const* buffer,
+                          std::size_t size,
+                          std::wstring const& dir_name = L"dumps")
+{
+  WriteDumpFile(
+    GetPath(process), process.GetId(), region_name, buffer, size, dir_name);
+}
+
+// A buffer backed by a sparse file mapping, used to rebuild dumps in place
+// rather than on the heap. The capacity is fixed up front, but disk space and
+// memory are only used for pages which are touched, and dirty pages can be
+// written back by the OS under memory pressure. Pointers into the buffer stay
+// valid as it grows (which the PeFile objects pointing into it rely on). The
+// file is deleted on destruction unless Commit is called.
+class DumpFileBuffer
+{
+public:
+  DumpFileBuffer(std::wstring const& path,
+                 std::size_t size,
+                 std::size_t capacity)
+    : path_(path), size_{size}
+  {
+    HADESMEM_DETAIL_ASSERT(capacity != 0);
+    HADESMEM_DETAIL_ASSERT(size <= capacity);
+
+    file_.Create(path, capacity);
+    capacity_ = capacity;
+  }
+
+  DumpFileBuffer(DumpFileBuffer const& other) = delete;
+
+  DumpFileBuffer& operator=(DumpFileBuffer const& other) = delete;
+
+  ~DumpFileBuffer()
+  {
+    if (!committed_)
+    {
+      file_.Close();
+      ::DeleteFileW(path_.c_str());
+    }
+  }
+
+  std::uint8_t* GetData() const noexcept
+  {
+    return file_.GetData();
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return size_;
+  }
+
+  std::size_t GetCapacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  // Same semantics as std::vector::resize. Data past the new size is zeroed
+  // when shrinking, so growing again always exposes zeroes.
+  void Resize(std::size_t size)
+  {
+    if (size > capacity_)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error() << ErrorString("Dump file buffer capacity exceeded."));
+    }
+
+    if (size < size_)
+    {
+      std::fill(GetData() + size, GetData() + size_, std::uint8_t{0});
+    }
+
+    size_ = size;
+  }
+
+  void Append(void const* data, std::size_t len)
+  {
+    auto const offset = size_;
+    Resize(size_ + len);
+    std::memcpy(GetData() + offset, data, len);
+  }
+
+  // Trims the file to its current size and closes it.
+  void Commit()
+  {
+    HADESMEM_DETAIL_ASSERT(!committed_);
+
+    if (!size_)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error() << ErrorString("Dump file buffer is empty."));
+    }
+
+    file_.Resize(size_);
+    file_.Close();
+    committed_ = true;
+  }
+
+private:
+  std::wstring path_;
+  MappedFile file_;
+  std::size_t size_{};
+  std::size_t capacity_{};
+  bool committed_{false};
+};
+
+inline bool IsExecuteProtect(DWORD protect) noexcept
+{
+  DWORD const exec_prot = PAGE_EXECUTE | PAGE_EXECUTE_READ |
+                          PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+  return !!(protect & exec_prot);
+}
+
 inline std::wstring GetRegionPathOrDefault(Process const& process,
                                            void* p,
                                            void* imagebase,
@@ -279,8 +416,8 @@ struct ModuleLight
               bool use_disk_headers,
               void* imagebase,
               bool use_original_image_path)
-    : process_{process},
-      pe_file_{process_, base, PeFileType::kImage, static_cast<DWORD>(size)},
+    : base_{base},
+      size_{static_cast<DWORD>(size)},
       path_{GetRegionPath(process, base, imagebase, use_original_image_path)},
       name_{MakeNameFromPath(path_)},
       priority_{GetModulePriority(name_, path_)}
@@ -308,7 +445,8 @@ struct ModuleLight
     {
       // If on-disk headers are not found or not requested, try to verify using
       // in-memory headers.
-      NtHeaders nt_headers{process_, pe_file_};
+      PeFile const pe_file{process, base_, PeFileType::kImage, size_};
+      NtHeaders nt_headers{process, pe_file};
 
       HADESMEM_DETAIL_TRACE_A("Successfully verified NT headers.");
     }
@@ -338,8 +476,17 @@ struct ModuleLight
     }
   }
 
-  Process process_;
-  PeFile pe_file_;
+  explicit ModuleLight(DumpCaptureModule const& m)
+    : base_{reinterpret_cast<void*>(m.base)},
+      size_{m.size},
+      path_{m.path},
+      name_{m.name},
+      priority_{m.priority}
+  {
+  }
+
+  void* base_;
+  DWORD size_;
   std::wstring path_;
   std::wstring name_;
   std::int32_t priority_;
@@ -364,7 +511,11 @@ struct ProcessLight
   ~ProcessLight() = default;
 
   std::vector<ModuleLight> modules_;
-  std::map<void*, std::vector<ExportLight>> export_map_;
+  FlatAddressMap<ExportLight> export_map_;
+  // Superset of the VAs which can resolve to an export (directly or via a
+  // redirection stub). Used to reject most words in the memory scan without
+  // a hash lookup.
+  AddressSpanFilter import_filter_;
 };
 
 struct PeDumper
@@ -374,12 +525,32 @@ public:
            void* base,
            std::uint32_t flags,
            DWORD oep,
-           ModuleLight const* m = nullptr)
+           ModuleLight const* m = nullptr,
+           std::size_t num_threads = 1)
     : process_{&process},
       base_{base},
       flags_{flags},
       oep_{oep},
       m_{m},
+      num_threads_{num_threads},
+      process_light_(MakeProcessLight())
+  {
+  }
+
+  // Runs entirely from a capture (see dump_capture.hpp) rather than a live
+  // process. image is the capture's memory snapshot.
+  PeDumper(DumpCapture const& capture,
+           ScanSource const& image,
+           void* base,
+           std::uint32_t flags,
+           DWORD oep,
+           std::size_t num_threads = 1)
+    : base_{base},
+      flags_{flags},
+      oep_{oep},
+      num_threads_{num_threads},
+      capture_{&capture},
+      image_{&image},
       process_light_(MakeProcessLight())
   {
   }
@@ -388,7 +559,7 @@ public:
   {
     if (base_)
     {
-      DumpSingleModule(base_);
+      DumpSingleModule(base_, nullptr, num_threads_);
     }
     else
     {
@@ -401,6 +572,65 @@ public:
     process_light_ = MakeProcessLight();
   }
 
+  // Writes everything needed to run the dumper later without the process.
+  // The export map is only built when reconstructing imports, so that flag
+  // must be set.
+  void Capture(std::wstring const& path) const
+  {
+    HADESMEM_DETAIL_ASSERT(process_);
+    HADESMEM_DETAIL_ASSERT(!!(flags_ & DumpFlags::kReconstructImports));
+
+    HADESMEM_DETAIL_TRACE_A("Writing capture.");
+
+    auto const& modules = process_light_.modules_;
+    DumpCapture capture;
+    capture.pid = process_->GetId();
+    capture.process_path = GetPath(*process_);
+    for (auto const& m : modules)
+    {
+      capture.modules.push_back(
+        DumpCaptureModule{reinterpret_cast<std::uintptr_t>(m.base_),
+                          m.size_,
+                          m.priority_,
+                          m.path_,
+                          m.name_});
+    }
+    process_light_.export_map_.ForEach(
+      [&](std::uintptr_t va, ExportLight const& e) {
+        capture.exports.push_back(DumpCaptureExport{
+          va,
+          static_cast<std::uint32_t>(e.module_ - modules.data()),
+          e.ordinal_,
+          e.by_name_,
+          e.name_});
+      });
+    SaveDumpCapture(capture, path);
+
+    HADESMEM_DETAIL_TRACE_A("Writing capture memory snapshot.");
+
+    ProcessScanSource const process_source(*process_);
+    SpanScanSource source(process_source);
+    for (auto const& m : modules)
+    {
+      auto const base = reinterpret_cast<std::uintptr_t>(m.base_);
+      source.Add(base, base + m.size_);
+    }
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+    RegionSnapshot regions;
+    process_source.GetRegions(regions);
+    for (auto const& region : regions)
+    {
+      if (IsExecuteProtect(region.protect))
+      {
+        source.Add(region.base, region.base + region.size);
+      }
+    }
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X64)
+    source.Finalize();
+
+    MemorySnapshot const snapshot(source, GetDumpCaptureMemoryPath(path));
+  }
+
 private:
   ProcessLight BuildModuleList()
   {
@@ -435,6 +665,17 @@ private:
         continue;
       }
 
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+      // Redirected imports point to stubs in executable memory which may be
+      // outside of any module (see ResolveRedirectedImport).
+      if (IsExecuteProtect(region.GetProtect()))
+      {
+        process_info.import_filter_.Add(
+          reinterpret_cast<std::uintptr_t>(region_beg),
+          reinterpret_cast<std::uintptr_t>(region_end));
+      }
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X64)
+
       // TODO: Add a config flag to search for modules which are not aligned on
       // a page boundary.
       for (auto p = region_beg; p + page_size <= region_end; p += page_size)
@@ -503,6 +744,7 @@ private:
     {
       HADESMEM_DETAIL_TRACE_A("Skipping export map generation because import "
                               "reconstruction is disabled.");
+      FinalizeExportMap(process_info);
       return;
     }
 
@@ -515,7 +757,8 @@ private:
       // TODO: Use on disk headers here if we have the option? Or both?
       // TODO: If the module is loaded in our own process we could theoretically
       // enumerate exports locally?
-      ExportList exports(m.process_, m.pe_file_);
+      PeFile const pe_file(*process_, m.base_, PeFileType::kImage, m.size_);
+      ExportList exports(*process_, pe_file);
       for (auto const& e : exports)
       {
         ModuleLight const* resolved_module = &m;
@@ -650,34 +893,93 @@ private:
 
         HADESMEM_DETAIL_TRACE_A("Adding to export map.");
 
-        process_info.export_map_[va].emplace_back(ExportLight{
-          resolved_module, e.ByName(), e.GetName(), e.GetProcedureNumber()});
+        auto const va_num = reinterpret_cast<std::uintptr_t>(va);
+        process_info.export_map_.Insert(
+          va_num,
+          ExportLight{
+            resolved_module, e.ByName(), e.GetName(), e.GetProcedureNumber()});
+        process_info.import_filter_.Add(va_num, va_num + 1);
       }
     }
 
+    FinalizeExportMap(process_info);
+
     HADESMEM_DETAIL_TRACE_FORMAT_A("Num Modules: [%Iu].",
                                    process_info.modules_.size());
     HADESMEM_DETAIL_TRACE_FORMAT_A("Num Export VAs: [%Iu].",
                                    process_info.export_map_.size());
   }
 
+  void FinalizeExportMap(ProcessLight& process_info)
+  {
+    process_info.export_map_.Finalize();
+
+    // Exports are clustered by module, so merging nearby VAs leaves roughly
+    // one span per module rather than one per export.
+    process_info.import_filter_.Finalize(0x10000);
+
+    HADESMEM_DETAIL_TRACE_FORMAT_A("Num Import Filter Spans: [%Iu].",
+                                   process_info.import_filter_.size());
+  }
+
   void SortExportMapModules(ProcessLight& process_info)
   {
     HADESMEM_DETAIL_TRACE_A("Sorting export map modules by priority.");
 
-    for (auto& i : process_info.export_map_)
+    process_info.export_map_.SortValues(
+      [](ExportLight const& lhs, ExportLight const& rhs) {
+        return lhs.module_->priority_ < rhs.module_->priority_;
+      });
+  }
+
+  ProcessLight MakeProcessLightFromCapture()
+  {
+    HADESMEM_DETAIL_TRACE_A("Loading module list and export map from capture.");
+
+    ProcessLight process_info;
+    process_info.modules_.reserve(capture_->modules.size());
+    for (auto const& m : capture_->modules)
     {
-      auto& modules = i.second;
-      std::sort(std::begin(modules),
-                std::end(modules),
-                [](ExportLight const& lhs, ExportLight const& rhs) {
-                  return lhs.module_->priority_ < rhs.module_->priority_;
-                });
+      process_info.modules_.emplace_back(m);
     }
+
+    image_->GetRegions(image_regions_);
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+    for (auto const& region : image_regions_)
+    {
+      if (IsExecuteProtect(region.protect))
+      {
+        process_info.import_filter_.Add(region.base,
+                                        region.base + region.size);
+      }
+    }
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X64)
+
+    // Exports were captured in their final order, so they're not re-sorted.
+    if (!!(flags_ & DumpFlags::kReconstructImports))
+    {
+      for (auto const& e : capture_->exports)
+      {
+        process_info.export_map_.Insert(
+          e.va,
+          ExportLight{
+            &process_info.modules_[e.module], e.by_name, e.name, e.ordinal});
+        process_info.import_filter_.Add(e.va, e.va + 1);
+      }
+    }
+
+    FinalizeExportMap(process_info);
+
+    return process_info;
   }
 
   ProcessLight MakeProcessLight()
   {
+    if (capture_)
+    {
+      return MakeProcessLightFromCapture();
+    }
+
     auto process_info = BuildModuleList();
     BuildExportMap(process_info);
     SortExportMapModules(process_info);
@@ -691,15 +993,19 @@ private:
     DWORD virtual_size_;
   };
 
-  std::vector<SectionData> CopySectionData(Process const& local_process,
-                                           PeFile const& pe_file_headers,
-                                           NtHeaders const& nt_headers,
-                                           std::vector<std::uint8_t>& raw_new,
-                                           std::vector<std::uint8_t> const& raw)
+  // Computes where each section will be placed in the rebuilt file and the
+  // size of the file (before any new import data is added), so the file can
+  // be created at its final size and filled in place.
+  std::vector<SectionData> GetSectionLayout(Process const& local_process,
+                                            PeFile const& pe_file_headers,
+                                            NtHeaders const& nt_headers,
+                                            std::size_t raw_size,
+                                            std::size_t& file_size)
   {
-    HADESMEM_DETAIL_TRACE_A("Copying section data.");
+    HADESMEM_DETAIL_TRACE_A("Calculating section layout.");
 
     std::vector<SectionData> section_datas;
+    std::size_t end = nt_headers.GetSizeOfHeaders();
 
     SectionList const sections(local_process, pe_file_headers);
     for (auto const& section : sections)
@@ -725,9 +1031,8 @@ private:
         (std::max)(section.GetVirtualSize(), section.GetSizeOfRawData()),
         nt_headers.GetSectionAlignment()));
       auto const ptr_raw_data_new_tmp =
-        section.GetPointerToRawData() < raw_new.size()
-          ? static_cast<DWORD>(
-              RoundUp(raw_new.size(), nt_headers.GetFileAlignment()))
+        section.GetPointerToRawData() < end
+          ? static_cast<DWORD>(RoundUp(end, nt_headers.GetFileAlignment()))
           : section.GetPointerToRawData();
       auto const ptr_raw_data_new = static_cast<DWORD>(
         RoundUp(ptr_raw_data_new_tmp, nt_headers.GetFileAlignment()));
@@ -737,39 +1042,63 @@ private:
         ptr_raw_data_new,
         section_size);
 
-      if (ptr_raw_data_new > raw_new.size())
-      {
-        raw_new.resize(ptr_raw_data_new);
-      }
-
       section_datas.emplace_back(
         SectionData{ptr_raw_data_new, section_size, section_size});
 
-      if (section.GetVirtualAddress() >= raw.size())
+      // Sections with no data to copy don't take up any space, but the next
+      // section still starts after their aligned raw pointer.
+      end = section.GetVirtualAddress() < raw_size
+              ? ptr_raw_data_new + static_cast<std::size_t>(section_size)
+              : (std::max<std::size_t>)(end, ptr_raw_data_new);
+    }
+
+    file_size = end;
+    return section_datas;
+  }
+
+  void CopySectionData(Process const& local_process,
+                       PeFile const& pe_file_headers,
+                       NtHeaders const& nt_headers,
+                       std::vector<SectionData>& section_datas,
+                       DumpFileBuffer& raw_new,
+                       DumpFileBuffer const& raw)
+  {
+    HADESMEM_DETAIL_TRACE_A("Copying section data.");
+
+    std::size_t n = 0;
+    SectionList const sections(local_process, pe_file_headers);
+    for (auto const& section : sections)
+    {
+      auto& section_data = section_datas[n++];
+      auto const ptr_raw_data_new = section_data.raw_data_;
+      auto const section_size = section_data.virtual_size_;
+
+      if (section.GetVirtualAddress() >= raw.GetSize())
       {
         HADESMEM_DETAIL_TRACE_A("WARNING! Not writing any data for current "
                                 "section due to out-of-bounds VA.");
         continue;
       }
 
-      auto const raw_data = raw.data() + section.GetVirtualAddress();
+      auto const raw_data = raw.GetData() + section.GetVirtualAddress();
       auto const raw_data_end =
-        (std::min)(raw_data + section_size, raw.data() + raw.size());
+        (std::min)(raw_data + section_size, raw.GetData() + raw.GetSize());
       if (raw_data_end != raw_data + section_size)
       {
         HADESMEM_DETAIL_TRACE_A("WARNING! Truncating read for current section "
                                 "due to out-of-bounds VA.");
       }
 
-      auto const new_size = raw_new.size() + section_size;
-      raw_new.reserve(new_size);
-      std::copy(raw_data, raw_data_end, std::back_inserter(raw_new));
-      raw_new.resize(new_size);
+      // The layout was calculated up front, and anything past the source
+      // data is already zero.
+      auto const section_beg = raw_new.GetData() + ptr_raw_data_new;
+      HADESMEM_DETAIL_ASSERT(ptr_raw_data_new + section_size <=
+                             raw_new.GetSize());
+      std::copy(raw_data, raw_data_end, section_beg);
 
       auto raw_section_size = section_size;
-      for (auto p = raw_new.data() + raw_new.size() - sizeof(std::uint32_t);
-           (p >
-            raw_new.data() + ptr_raw_data_new + section.GetSizeOfRawData()) &&
+      for (auto p = section_beg + section_size - sizeof(std::uint32_t);
+           (p > section_beg + section.GetSizeOfRawData()) &&
            *reinterpret_cast<std::uint32_t*>(p);
            p -= sizeof(std::uint32_t))
       {
@@ -779,10 +1108,8 @@ private:
       raw_section_size = static_cast<DWORD>(
         RoundUp(raw_section_size, nt_headers.GetFileAlignment()));
 
-      section_datas.back().raw_size_ = raw_section_size;
+      section_data.raw_size_ = raw_section_size;
     }
-
-    return section_datas;
   }
 
   void FixSectionHeaders(SectionList& sections_new,
@@ -855,13 +1182,121 @@ private:
     return nt_headers_new;
   }
 
+  struct ImportCandidate
+  {
+    std::size_t pos_;
+    void* va_;
+    FlatAddressMap<ExportLight>::Range exports_;
+  };
+
+  // Finds every 4-byte step of the image which holds a pointer to an export
+  // (directly or via a redirection stub). This is the expensive part of the
+  // memory scan and has no state carried between steps, so large images are
+  // split into chunks which are scanned concurrently. Results are returned in
+  // image order regardless of the number of threads.
+  std::vector<ImportCandidate>
+    FindImportCandidates(DumpFileBuffer const& raw_new,
+                         FlatAddressMap<ExportLight> const& export_map,
+                         AddressSpanFilter const& import_filter,
+                         std::size_t num_threads) const
+  {
+    std::size_t const kChunkSize = 0x100000;
+
+    auto const data = raw_new.GetData();
+    auto const size = raw_new.GetSize();
+    std::size_t const num_chunks = (size + kChunkSize - 1) / kChunkSize;
+    std::vector<std::vector<ImportCandidate>> chunks(num_chunks);
+    ParallelFor(num_chunks, num_threads, [&](std::size_t chunk) {
+      auto& candidates = chunks[chunk];
+      auto const chunk_end = (std::min)(size, (chunk + 1) * kChunkSize);
+
+      // Candidates are checked against the import filter 16 bytes at a time.
+      // A set bit in block_mask means the candidate at block_beg + n * 4
+      // needs a closer look.
+      std::size_t block_beg = 0;
+      std::size_t block_end = 0;
+      std::uint32_t block_mask = 0;
+      for (auto pos = chunk * kChunkSize;
+           pos < chunk_end && pos + sizeof(void*) <= size;
+           pos += 4)
+      {
+        auto const p = data + pos;
+        if (pos >= block_end)
+        {
+          block_beg = pos;
+          if (pos + AddressSpanFilter::kPrefilterReadSize <= size)
+          {
+            block_end = pos + 16;
+            block_mask = import_filter.Prefilter(p);
+            if (!block_mask)
+            {
+              pos = block_end - 4;
+              continue;
+            }
+          }
+          else
+          {
+            block_end = size;
+            block_mask = 0xFFFFFFFFUL;
+          }
+        }
+
+        auto const va = *reinterpret_cast<void* const*>(p);
+        if (!((block_mask >> ((pos - block_beg) / 4)) & 1) ||
+            !import_filter.Contains(reinterpret_cast<std::uintptr_t>(va)))
+        {
+          continue;
+        }
+
+        auto exports = export_map.Find(reinterpret_cast<std::uintptr_t>(va));
+        if (exports.empty())
+        {
+          // TODO: Make sure this doesn't overlap with any previous fixups,
+          // redirected or otherwise?
+          auto const resolved_va = ResolveRedirectedImport(va);
+          if (!resolved_va)
+          {
+            continue;
+          }
+
+          HADESMEM_DETAIL_TRACE_FORMAT_A(
+            "Resolved redirected import (unverified). Old: [%p]. New: [%p].",
+            va,
+            resolved_va);
+
+          exports =
+            export_map.Find(reinterpret_cast<std::uintptr_t>(resolved_va));
+          if (exports.empty())
+          {
+            HADESMEM_DETAIL_TRACE_A("WARNING! Successfully resolved "
+                                    "redirected import, but then failed to "
+                                    "match it to an export.");
+            continue;
+          }
+        }
+
+        candidates.push_back(ImportCandidate{pos, va, exports});
+      }
+    });
+
+    std::vector<ImportCandidate> candidates;
+    for (auto& chunk : chunks)
+    {
+      candidates.insert(
+        std::end(candidates), std::begin(chunk), std::end(chunk));
+    }
+    return candidates;
+  }
+
   std::map<DWORD, ExportLight const*>
-    DoMemoryScan(std::vector<std::uint8_t>& raw_new,
-                 std::map<void*, std::vector<ExportLight>> const& export_map,
+    DoMemoryScan(DumpFileBuffer const& raw_new,
+                 FlatAddressMap<ExportLight> const& export_map,
+                 AddressSpanFilter const& import_filter,
                  void* base,
                  std::size_t pe_size,
                  Process const& local_process,
-                 PeFile const& pe_file_new)
+                 PeFile const& pe_file_new,
+                 std::size_t num_threads)
   {
     HADESMEM_DETAIL_TRACE_A("Performing memory scan.");
 
@@ -871,43 +1306,32 @@ private:
     // TODO: Ensure imports to hidden modules are found correctly. Required
     // for when a manually mapped module is manually mapping its dependencies.
     // TODO: Check section characteristics as an additional heuristic?
+    auto const candidates = FindImportCandidates(
+      raw_new, export_map, import_filter, num_threads);
+
+    // Replay the candidates in order. Every 4-byte step which isn't a
+    // candidate is a miss, which breaks adjacency, and a fixup consumes a
+    // whole pointer.
     std::map<DWORD, ExportLight const*> fixup_map;
     bool fixup_adjacent = false;
-    for (auto p = raw_new.data(); p < raw_new.data() + raw_new.size() - 3;
-         p += 4)
+    std::size_t next_pos = 0;
+    for (auto const& candidate : candidates)
     {
-      auto const offset =
-        static_cast<DWORD>(reinterpret_cast<std::uintptr_t>(p) -
-                           reinterpret_cast<std::uintptr_t>(raw_new.data()));
-
-      auto va = *reinterpret_cast<void**>(p);
-      auto i = export_map.find(va);
-      if (i == std::end(export_map))
+      auto const pos = candidate.pos_;
+      if (pos < next_pos)
       {
-        // TODO: Make sure this doesn't overlap with any previous fixups,
-        // redirected or otherwise?
-        auto const resolved_va = ResolveRedirectedImport(va);
-        if (!resolved_va)
-        {
-          fixup_adjacent = false;
-          continue;
-        }
-
-        HADESMEM_DETAIL_TRACE_FORMAT_A(
-          "Resolved redirected import (unverified). Old: [%p]. New: [%p].",
-          va,
-          resolved_va);
-
-        i = export_map.find(resolved_va);
-        if (i == std::end(export_map))
-        {
-          HADESMEM_DETAIL_TRACE_A("WARNING! Successfully resolved redirected "
-                                  "import, but then failed to match it to an "
-                                  "export.");
-          fixup_adjacent = false;
-          continue;
-        }
+        continue;
       }
+      if (pos != next_pos)
+      {
+        fixup_adjacent = false;
+      }
+      next_pos = pos + 4;
+
+      auto const p = raw_new.GetData() + pos;
+      auto const va = candidate.va_;
+      auto const& exports = candidate.exports_;
+      auto const offset = static_cast<DWORD>(pos);
 
       if (va >= base && va <= static_cast<std::uint8_t*>(base) + pe_size)
       {
@@ -919,7 +1343,7 @@ private:
       }
 
       {
-        auto const e = i->second.back();
+        auto const& e = exports.back();
         HADESMEM_DETAIL_TRACE_FORMAT_W(
           L"Found matching VA. Logging last entry only. Offset: [%08X]. VA: "
           L"[%p]. Module: [%s]. Name: [%hs]. Ordinal: [%lu]. ByName: [%d].",
@@ -942,9 +1366,10 @@ private:
       // TODO: Add a config flag to control this behavior.
       if (!(reinterpret_cast<std::uintptr_t>(va) % 0x1000) && !fixup_adjacent)
       {
-        auto const next_va = *reinterpret_cast<void**>(p + 8);
-        auto const next_e = export_map.find(next_va);
-        if (next_e == std::end(export_map))
+        if (pos + 8 + sizeof(void*) > raw_new.GetSize() ||
+            export_map
+              .Find(*reinterpret_cast<std::uintptr_t const*>(p + 8))
+              .empty())
         {
           HADESMEM_DETAIL_TRACE_A("WARNING! Skipping page aligned VA.");
           continue;
@@ -955,7 +1380,7 @@ private:
 
       // Modules are sorted by priority. Lowest to highest.
       auto& fixup_export = fixup_map[rva];
-      fixup_export = &i->second.back();
+      fixup_export = &exports.back();
 
       // Try and match to use the same module as the previous adjacent fixup
       // if possible (there could be a different match because of forwarded
@@ -969,13 +1394,13 @@ private:
       auto const prev_module_base =
         prev_fixup_iter == std::end(fixup_map)
           ? nullptr
-          : prev_fixup_iter->second->module_->pe_file_.GetBase();
+          : prev_fixup_iter->second->module_->base_;
       if (prev_module_base)
       {
-        for (auto& e : i->second)
+        for (auto const& e : exports)
         {
           if (fixup_export != &e &&
-              e.module_->pe_file_.GetBase() == prev_module_base)
+              e.module_->base_ == prev_module_base)
           {
             HADESMEM_DETAIL_TRACE_FORMAT_W(
               L"Adjusting fixup to match module of "
@@ -990,7 +1415,7 @@ private:
       }
 
       fixup_adjacent = true;
-      p += sizeof(void*) - 4;
+      next_pos = pos + sizeof(void*);
     }
 
     if (fixup_map.empty())
@@ -1001,29 +1426,22 @@ private:
     return fixup_map;
   }
 
-  void CopyHeaders(std::vector<std::uint8_t>& raw_new,
+  void CopyHeaders(DumpFileBuffer& raw_new,
                    NtHeaders const& nt_headers,
-                   std::size_t pe_size,
                    bool has_disk_headers,
-                   std::vector<std::uint8_t> const& raw,
-                   std::vector<char> const& pe_file_disk_data)
+                   DumpFileBuffer const& raw,
+                   MappedFile const& pe_file_disk_data)
   {
     HADESMEM_DETAIL_TRACE_A("Copying headers.");
 
-    // TODO: Fix this hack properly. We reserve plenty of size in the buffer so
-    // when we open the PE file object later pointing to the buffer, if we add
-    // more data to the buffer it won't be reallocated.
-    raw_new.reserve(pe_size * 5);
     auto const headers_buf_beg =
-      has_disk_headers
-        ? reinterpret_cast<std::uint8_t const*>(pe_file_disk_data.data())
-        : raw.data();
+      has_disk_headers ? pe_file_disk_data.GetData() : raw.GetData();
     std::copy(headers_buf_beg,
               headers_buf_beg + nt_headers.GetSizeOfHeaders(),
-              raw_new.data());
+              raw_new.GetData());
   }
 
-  std::tuple<bool, std::vector<char>, std::unique_ptr<PeFile>>
+  std::tuple<bool, MappedFile, std::unique_ptr<PeFile>>
     GetPeFileHeaders(bool has_disk_headers,
                      std::wstring const& region_path,
                      Process const& local_process,
@@ -1032,7 +1450,7 @@ private:
     if (!has_disk_headers)
     {
       return std::make_tuple(
-        false, std::vector<char>(), std::make_unique<PeFile>(pe_file));
+        false, MappedFile(), std::make_unique<PeFile>(pe_file));
     }
 
     try
@@ -1047,12 +1465,15 @@ private:
       // (Sounds like it defeats the purpose but it's more common than you
       // might think...)
 
-      std::vector<char> pe_file_disk_data = PeFileToBuffer(region_path);
-      auto pe_file_disk =
-        std::make_unique<PeFile>(local_process,
-                                 pe_file_disk_data.data(),
-                                 PeFileType::kData,
-                                 static_cast<DWORD>(pe_file_disk_data.size()));
+      // Mapped rather than read, as only the headers and import directories
+      // are ever touched.
+      MappedFile pe_file_disk_data;
+      pe_file_disk_data.Open(region_path);
+      auto pe_file_disk = std::make_unique<PeFile>(
+        local_process,
+        pe_file_disk_data.GetData(),
+        PeFileType::kData,
+        static_cast<DWORD>(pe_file_disk_data.GetSize()));
       return std::make_tuple(
         true, std::move(pe_file_disk_data), std::move(pe_file_disk));
     }
@@ -1064,11 +1485,13 @@ private:
         boost::current_exception_diagnostic_information().c_str());
 
       return std::make_tuple(
-        false, std::vector<char>(), std::make_unique<PeFile>(pe_file));
+        false, MappedFile(), std::make_unique<PeFile>(pe_file));
     }
   }
 
-  void DumpSingleModule(void* base, ModuleLight const* m = nullptr)
+  void DumpSingleModule(void* base,
+                        ModuleLight const* m = nullptr,
+                        std::size_t num_scan_threads = 1)
   {
     auto const& process_info = process_light_;
     auto const& modules = process_info.modules_;
@@ -1076,7 +1499,7 @@ private:
 
     auto const module_iter = std::find_if(
       std::begin(modules), std::end(modules), [&](ModuleLight const& m) {
-        return m.pe_file_.GetBase() == base;
+        return m.base_ == base;
       });
 
     if (module_iter == std::end(modules))
@@ -1087,7 +1510,7 @@ private:
 
     m = &*module_iter;
 
-    auto const pe_size = m->pe_file_.GetSize();
+    auto const pe_size = m->size_;
 
     HADESMEM_DETAIL_TRACE_FORMAT_W(
       L"Starting module dumping. Name: [%s]. Base: [%p]. Size: [%X].",
@@ -1095,13 +1518,19 @@ private:
       base,
       pe_size);
 
-    auto raw = ReadVectorEx<std::uint8_t>(
-      *process_, base, pe_size, ReadFlags::kZeroFillReserved);
+    // Both the source image and the rebuilt file are file backed, so memory
+    // use doesn't scale with the size of the image. The source is a temporary
+    // file next to the dump, which is deleted when we're done.
+    // TODO: Write to a new sub-directory each time (e.g.
+    // pe_dumps\foo.exe\1234\1).
+    auto const dump_path = GetModuleDumpPath(base, *m);
+    DumpFileBuffer raw(dump_path + L".tmp", pe_size, pe_size);
+    ReadImage(base, raw.GetData(), pe_size);
     Process const local_process(::GetCurrentProcessId());
     PeFile const pe_file(local_process,
-                         raw.data(),
+                         raw.GetData(),
                          PeFileType::kImage,
-                         static_cast<DWORD>(raw.size()));
+                         static_cast<DWORD>(raw.GetSize()));
 
     bool has_disk_headers = !!(flags_ & DumpFlags::kUseDiskHeaders);
 
@@ -1113,7 +1542,7 @@ private:
       has_disk_headers = false;
     }
 
-    std::vector<char> pe_file_disk_data;
+    MappedFile pe_file_disk_data;
     std::unique_ptr<PeFile> pe_file_headers_ptr;
     std::tie(has_disk_headers, pe_file_disk_data, pe_file_headers_ptr) =
       GetPeFileHeaders(has_disk_headers, region_path, local_process, pe_file);
@@ -1121,22 +1550,37 @@ private:
     PeFile const& pe_file_headers = *pe_file_headers_ptr;
     NtHeaders nt_headers(local_process, pe_file_headers);
 
-    std::vector<std::uint8_t> raw_new(nt_headers.GetSizeOfHeaders());
-    CopyHeaders(
-      raw_new, nt_headers, pe_size, has_disk_headers, raw, pe_file_disk_data);
-
-    auto const section_datas =
-      CopySectionData(local_process, pe_file_headers, nt_headers, raw_new, raw);
-    raw_new.reserve(raw_new.size() * 2);
+    std::size_t file_size = 0;
+    auto section_datas = GetSectionLayout(
+      local_process, pe_file_headers, nt_headers, raw.GetSize(), file_size);
 
+    // The only growth after this point is the new import data, which is
+    // bounded by the number of pointers in the image. The capacity is only
+    // address space and sparse file space, so be generous.
+    std::uint64_t const kImportSlack = 0x1000000;
     const auto dword_max = (std::numeric_limits<DWORD>::max)();
-    HADESMEM_DETAIL_ASSERT(raw_new.size() < dword_max);
-    HADESMEM_DETAIL_ASSERT(raw_new.capacity() < dword_max);
+    if (file_size >= dword_max)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error() << ErrorString("Rebuilt image is too large."));
+    }
+    auto const capacity = static_cast<std::size_t>(
+      (std::min)(static_cast<std::uint64_t>(file_size) * 2 + kImportSlack,
+                 static_cast<std::uint64_t>(dword_max - 1)));
+
+    DumpFileBuffer raw_new(dump_path, file_size, capacity);
+    CopyHeaders(raw_new, nt_headers, has_disk_headers, raw, pe_file_disk_data);
+    CopySectionData(local_process,
+                    pe_file_headers,
+                    nt_headers,
+                    section_datas,
+                    raw_new,
+                    raw);
+
     PeFile const pe_file_new(local_process,
-                             raw_new.data(),
+                             raw_new.GetData(),
                              PeFileType::kData,
-                             static_cast<DWORD>(raw_new.size()));
-    auto const raw_new_capacity = raw_new.capacity();
+                             static_cast<DWORD>(raw_new.GetSize()));
 
     std::unique_ptr<PeFile> pe_file_none;
     auto nt_headers_new =
@@ -1172,8 +1616,14 @@ private:
           : static_cast<DWORD>(RoundUp(last_section.GetVirtualSize(),
                                        nt_headers_new.GetSectionAlignment()));
 
-      auto const fixup_map = DoMemoryScan(
-        raw_new, export_map, base, pe_size, local_process, pe_file_new);
+      auto const fixup_map = DoMemoryScan(raw_new,
+                                          export_map,
+                                          process_info.import_filter_,
+                                          base,
+                                          pe_size,
+                                          local_process,
+                                          pe_file_new,
+                                          num_scan_threads);
 
       auto coalesced_fixup_map = CoalesceImportDescriptors(fixup_map);
 
@@ -1202,7 +1652,6 @@ private:
                                       last_section,
                                       old_section_end,
                                       import_directories_buf,
-                                      pe_size,
                                       descriptors_cur);
 
       AddExistingImportDirs(local_process,
@@ -1217,7 +1666,6 @@ private:
       WriteImportDirectories(raw_new,
                              last_section,
                              old_section_end,
-                             raw_new_capacity,
                              new_size,
                              old_size,
                              import_directories_buf);
@@ -1236,19 +1684,86 @@ private:
       FixImports(local_process, pe_file, pe_file_new);
     }
 
-    // TODO: Write to a new sub-directory each time (e.g.
-    // pe_dumps\foo.exe\1234\1).
-    WriteDumpFile(*process_,
-                  PtrToHexString<wchar_t>(base) + L"_" + m->name_,
-                  raw_new.data(),
-                  raw_new.size(),
-                  L"pe_dumps");
+    // Has to be last, as it covers the entire file.
+    if (!!(flags_ & DumpFlags::kFixChecksum))
+    {
+      HADESMEM_DETAIL_TRACE_A("Fixing checksum.");
+
+      FixPeChecksum(raw_new.GetData(), raw_new.GetSize());
+    }
+
+    HADESMEM_DETAIL_TRACE_A("Writing file.");
+
+    raw_new.Commit();
+  }
+
+  std::wstring GetModuleDumpPath(void* base, ModuleLight const& m) const
+  {
+    auto const dump_name = PtrToHexString<wchar_t>(base) + L"_" + m.name_;
+    if (capture_)
+    {
+      return MakeDumpFilePath(
+        capture_->process_path, capture_->pid, dump_name, L"pe_dumps");
+    }
+
+    return MakeDumpFilePath(
+      GetPath(*process_), process_->GetId(), dump_name, L"pe_dumps");
+  }
+
+  // Reads in large chunks straight into the (file backed) destination, so the
+  // image is never held on the heap.
+  void ReadImage(void* base, std::uint8_t* data, std::size_t size) const
+  {
+    if (!capture_)
+    {
+      std::size_t const kChunkSize = 0x100000;
+      for (std::size_t offset = 0; offset < size; offset += kChunkSize)
+      {
+        auto const len = (std::min)(kChunkSize, size - offset);
+        ReadImpl(*process_,
+                 static_cast<std::uint8_t*>(base) + offset,
+                 data + offset,
+                 len,
+                 ReadFlags::kZeroFillReserved);
+      }
+      return;
+    }
+
+    // Pages which weren't captured (e.g. reserved pages) are left zero
+    // filled, the same as for a live read.
+    auto const address = reinterpret_cast<std::uintptr_t>(base);
+    for (std::size_t offset = 0; offset < size;
+         offset += kMemorySnapshotPageSize)
+    {
+      auto const len = (std::min)(kMemorySnapshotPageSize, size - offset);
+      image_->Read(address + offset, data + offset, len);
+    }
+  }
+
+  // Reads from executable memory only.
+  bool ReadCode(void const* address, void* data, std::size_t len) const
+  {
+    if (!capture_)
+    {
+      if (!CanExecute(*process_, address))
+      {
+        return false;
+      }
+
+      auto const buf = ReadVector<std::uint8_t>(*process_, address, len);
+      auto const out = static_cast<std::uint8_t*>(data);
+      std::copy(std::begin(buf), std::end(buf), out);
+      return true;
+    }
+
+    auto const region = image_regions_.Find(address);
+    return region && IsExecuteProtect(region->protect) &&
+           image_->Read(reinterpret_cast<std::uintptr_t>(address), data, len);
   }
 
-  void WriteImportDirectories(std::vector<std::uint8_t>& raw_new,
+  void WriteImportDirectories(DumpFileBuffer& raw_new,
                               Section const& last_section,
                               DWORD old_section_end,
-                              std::size_t raw_new_capacity,
                               DWORD new_size,
                               DWORD old_size,
                               std::vector<char> const& import_directories_buf)
@@ -1260,31 +1775,21 @@ private:
     HADESMEM_DETAIL_TRACE_FORMAT_A("Expanding last section to its previous "
                                    "virtual size. New End: [0x%lX].",
                                    prev_virt_end);
-    raw_new.resize(prev_virt_end);
+    raw_new.Resize(prev_virt_end);
 
-    (void)raw_new_capacity;
-    HADESMEM_DETAIL_ASSERT(raw_new.capacity() == raw_new_capacity);
-
-    auto const new_end = raw_new.size() + (new_size - old_size);
+    auto const new_end = raw_new.GetSize() + (new_size - old_size);
+    (void)new_end;
     HADESMEM_DETAIL_TRACE_FORMAT_A(
       "Appending new data after old virtual end. New End: [0x%IX].", new_end);
-    raw_new.reserve(new_end);
-
-    HADESMEM_DETAIL_ASSERT(raw_new.capacity() == raw_new_capacity);
-
-    std::copy(std::begin(import_directories_buf),
-              std::end(import_directories_buf),
-              std::back_inserter(raw_new));
 
-    HADESMEM_DETAIL_ASSERT(raw_new.capacity() == raw_new_capacity);
+    raw_new.Append(import_directories_buf.data(),
+                   import_directories_buf.size());
 
     auto const new_raw_size =
       last_section.GetPointerToRawData() + last_section.GetSizeOfRawData();
     HADESMEM_DETAIL_TRACE_FORMAT_A(
       "Expanding to section aligned size. New End: [0x%lX].", new_raw_size);
-    raw_new.resize(new_raw_size);
-
-    HADESMEM_DETAIL_ASSERT(raw_new.capacity() == raw_new_capacity);
+    raw_new.Resize(new_raw_size);
   }
 
   std::map<DWORD, std::vector<ExportLight const*>> CoalesceImportDescriptors(
@@ -1298,7 +1803,7 @@ private:
     DWORD prev_rva = 0;
     for (auto const& f : fixup_map)
     {
-      auto const cur_module_base = f.second->module_->pe_file_.GetBase();
+      auto const cur_module_base = f.second->module_->base_;
       if (!prev_rva || f.first != prev_rva + sizeof(void*) ||
           cur_module_base != prev_module_base)
       {
@@ -1332,7 +1837,7 @@ private:
       filtered_fixup_map;
     for (auto const& fixup : coalesced_fixup_map)
     {
-      auto const module_base = fixup.second.back()->module_->pe_file_.GetBase();
+      auto const module_base = fixup.second.back()->module_->base_;
       auto& filtered = filtered_fixup_map[module_base];
       if (!filtered.first || filtered.second.size() < fixup.second.size())
       {
@@ -1400,7 +1905,6 @@ private:
     Section const& last_section,
     DWORD old_section_end,
     std::vector<char>& import_directories_buf,
-    std::size_t size,
     DWORD& descriptors_cur)
   {
     HADESMEM_DETAIL_TRACE_A("Building raw import directories buffer.");
@@ -1414,9 +1918,22 @@ private:
     auto const descriptors_end_rva =
       last_section.GetVirtualAddress() + old_section_end + descriptors_size;
     import_directories_buf.resize(descriptors_size);
-    // TODO: Fix this hack (see above for the same thing being done to
-    // raw_new).
-    import_directories_buf.reserve(size * 2);
+
+    // Thunks are written through a pointer into the buffer while names are
+    // still being appended, so reserve enough up front that it's never
+    // reallocated. This is an upper bound, as names are only added once (and
+    // module names take at most three UTF-8 bytes per UTF-16 unit).
+    std::size_t max_size = descriptors_size;
+    for (auto const& va_map : coalesced_fixup_map)
+    {
+      max_size += va_map.second.back()->module_->name_.size() * 3 + 1 +
+                  sizeof(IMAGE_THUNK_DATA) * (va_map.second.size() + 1);
+      for (auto const& e : va_map.second)
+      {
+        max_size += sizeof(IMAGE_IMPORT_BY_NAME::Hint) + e->name_.size() + 1;
+      }
+    }
+    import_directories_buf.reserve(max_size);
 
     std::map<std::wstring, DWORD> module_name_rvas;
     std::map<std::string, DWORD> import_by_name_rvas;
@@ -1563,7 +2080,7 @@ private:
   bool TryAddNewSection(Process const& local_process,
                         PeFile const& pe_file_new,
                         NtHeaders& nt_headers_new,
-                        std::vector<std::uint8_t> const& raw_new)
+                        DumpFileBuffer const& raw_new)
   {
     if (!(flags_ & DumpFlags::kAddNewSection))
     {
@@ -1579,7 +2096,7 @@ private:
     auto const new_section_header_end =
       new_section_header_beg + sizeof(IMAGE_SECTION_HEADER);
     if (new_section_header_end >
-        raw_new.data() + nt_headers_new.GetSizeOfHeaders())
+        raw_new.GetData() + nt_headers_new.GetSizeOfHeaders())
     {
       // TODO: What can we do to handle this? Is it possible to expand the size
       // of the headers safely?
@@ -1722,8 +2239,6 @@ private:
               nt_headers.GetSectionAlignment()));
     nt_headers_new.SetSizeOfImage(new_image_size);
 
-    // TODO: Fix checksums (with flag).
-
     // TODO: Strip DOS stub (with flag).
 
     nt_headers_new.UpdateWrite();
@@ -1802,10 +2317,42 @@ private:
   inline void DumpAllModules()
   {
     auto const& modules = process_light_.modules_;
+    if (num_threads_ == 1)
+    {
+      for (auto const& m : modules)
+      {
+        DumpSingleModule(m.base_, &m);
+      }
+
+      return;
+    }
+
+    // The export map is shared read-only and every module is built in its own
+    // buffer and written to its own file, so the output doesn't depend on the
+    // order in which modules finish. Start the largest modules first so a big
+    // main image doesn't end up running alone at the end.
+    std::vector<ModuleLight const*> order;
     for (auto const& m : modules)
     {
-      DumpSingleModule(m.pe_file_.GetBase(), &m);
+      order.push_back(&m);
     }
+    std::stable_sort(std::begin(order),
+                     std::end(order),
+                     [](ModuleLight const* lhs, ModuleLight const* rhs) {
+                       return lhs->size_ > rhs->size_;
+                     });
+
+    // Only images large enough to be worth splitting use more than one thread
+    // for the reference scan, which keeps oversubscription bounded.
+    std::size_t const kParallelScanMinSize = 0x1000000;
+    ParallelFor(order.size(), num_threads_, [&](std::size_t i) {
+      auto const m = order[i];
+      DumpSingleModule(m->base_,
+                       m,
+                       m->size_ >= kParallelScanMinSize
+                         ? num_threads_
+                         : 1);
+    });
   }
 
   // Overwatch redirects all entries in the IAT to a dynamically generated stub
@@ -1838,13 +2385,12 @@ private:
     try
     {
       auto const stub = static_cast<std::uint8_t*>(va);
-      if (!CanExecute(*process_, stub))
+      std::array<std::uint8_t, 0x12> stub_buf;
+      if (!ReadCode(stub, stub_buf.data(), stub_buf.size()))
       {
         return nullptr;
       }
 
-      const auto stub_buf = ReadVector<std::uint8_t>(*process_, stub, 0x11);
-
       // mov rax, imm64
       if (stub_buf[0] != 0x48 || stub_buf[1] != 0xB8)
       {
@@ -1889,6 +2435,10 @@ private:
   std::uint32_t flags_{};
   DWORD oep_{};
   ModuleLight const* m_{};
+  std::size_t num_threads_{1};
+  DumpCapture const* capture_{};
+  ScanSource const* image_{};
+  RegionSnapshot image_regions_;
 
   ProcessLight process_light_;
 };
@@ -1910,7 +2460,8 @@ inline void
              DWORD oep = 0,
              void* module_base = nullptr,
              void* base = nullptr,
-             std::size_t size = 0)
+             std::size_t size = 0,
+             std::size_t num_threads = 1)
 {
   if (base && size)
   {
@@ -1920,9 +2471,33 @@ inline void
   {
     // TODO: What happens vs targets which unmap themselves when we specify not
     // to fall back to the original image path (e.g. Overwatch, some malware).
-    PeDumper dumper(process, module_base, flags, oep);
+    PeDumper dumper(process, module_base, flags, oep, nullptr, num_threads);
     dumper.Dump();
   }
 }
+
+// Captures the module list, export map and module images of a process so they
+// can be dumped later with DumpCapturedMemory. Import reconstruction is always
+// enabled for the capture so the export map is available.
+inline void CaptureMemory(Process const& process,
+                          std::wstring const& path,
+                          std::uint32_t flags = DumpFlags::kNone)
+{
+  PeDumper const dumper(
+    process, nullptr, flags | DumpFlags::kReconstructImports, 0);
+  dumper.Capture(path);
+}
+
+inline void DumpCapturedMemory(std::wstring const& path,
+                               std::uint32_t flags = DumpFlags::kNone,
+                               DWORD oep = 0,
+                               void* module_base = nullptr,
+                               std::size_t num_threads = 1)
+{
+  auto const capture = LoadDumpCapture(path);
+  MemorySnapshot const image(GetDumpCaptureMemoryPath(path));
+  PeDumper dumper(capture, image, module_base, flags, oep, num_threads);
+  dumper.Dump();
+}
 }
 }
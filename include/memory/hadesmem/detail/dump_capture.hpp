@@ -0,0 +1,389 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/mapped_file.hpp>
+#include <hadesmem/detail/str_conv.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/region_snapshot.hpp>
+#include <hadesmem/scanner.hpp>
+
+// A dump capture is everything PeDumper needs from a live process, so that the
+// expensive part (rebuilding the modules and reconstructing their imports) can
+// be done later, elsewhere, and without the target being suspended.
+// A capture is stored in two files:
+// - The capture file itself, holding the process info, module list and
+// resolved export table.
+// - A MemorySnapshot (see memory_snapshot.hpp) of the module images (and on
+// x64, executable memory for resolving redirected imports), stored next to
+// it at GetDumpCaptureMemoryPath.
+//
+// Capture file format (little endian):
+// - Magic ("HMDUMPC\0"), version, pointer size and process ID (u32 each).
+// - Process path.
+// - Module count (u32), then base (u64), size (u32), priority (i32), path and
+// name for each module.
+// - Export count (u32), then VA (u64), module index (u32), ordinal (u32),
+// by name (u8) and name for each export.
+// Strings are stored as a u32 length followed by UTF-8.
+
+namespace hadesmem
+{
+namespace detail
+{
+struct DumpCaptureModule
+{
+  std::uintptr_t base;
+  std::uint32_t size;
+  std::int32_t priority;
+  std::wstring path;
+  std::wstring name;
+};
+
+// Exports are stored in the same order PeDumper uses them: sorted by VA, then
+// by module priority for exports which share a VA.
+struct DumpCaptureExport
+{
+  std::uintptr_t va;
+  std::uint32_t module;
+  std::uint32_t ordinal;
+  bool by_name;
+  std::string name;
+};
+
+struct DumpCapture
+{
+  std::uint32_t pid{};
+  std::wstring process_path;
+  std::vector<DumpCaptureModule> modules;
+  std::vector<DumpCaptureExport> exports;
+};
+
+std::uint8_t const kDumpCaptureMagic[8] = {
+  'H', 'M', 'D', 'U', 'M', 'P', 'C', 0};
+std::uint32_t const kDumpCaptureVersion = 1;
+
+inline std::wstring GetDumpCaptureMemoryPath(std::wstring const& path)
+{
+  return path + L".mem";
+}
+
+class DumpCaptureWriter
+{
+public:
+  void WriteBytes(void const* data, std::size_t len)
+  {
+    auto const bytes = static_cast<std::uint8_t const*>(data);
+    buffer_.insert(std::end(buffer_), bytes, bytes + len);
+  }
+
+  template <typename T> void Write(T value)
+  {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void WriteString(std::string const& str)
+  {
+    Write(static_cast<std::uint32_t>(str.size()));
+    WriteBytes(str.data(), str.size());
+  }
+
+  void WriteString(std::wstring const& str)
+  {
+    WriteString(WideCharToMultiByte(str));
+  }
+
+  std::vector<std::uint8_t> const& GetBuffer() const noexcept
+  {
+    return buffer_;
+  }
+
+private:
+  std::vector<std::uint8_t> buffer_;
+};
+
+class DumpCaptureReader
+{
+public:
+  DumpCaptureReader(std::uint8_t const* data, std::size_t size) noexcept
+    : data_{data}, size_{size}
+  {
+  }
+
+  void ReadBytes(void* data, std::size_t len)
+  {
+    if (len > size_ - pos_)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Unexpected end of dump capture."});
+    }
+
+    std::memcpy(data, data_ + pos_, len);
+    pos_ += len;
+  }
+
+  template <typename T> T Read()
+  {
+    T value;
+    ReadBytes(&value, sizeof(value));
+    return value;
+  }
+
+  std::string ReadString()
+  {
+    auto const len = Read<std::uint32_t>();
+    std::string str(len, '\0');
+    ReadBytes(&str[0], len);
+    return str;
+  }
+
+  std::wstring ReadWideString()
+  {
+    return MultiByteToWideChar(ReadString());
+  }
+
+  std::size_t GetRemaining() const noexcept
+  {
+    return size_ - pos_;
+  }
+
+private:
+  std::uint8_t const* data_;
+  std::size_t size_;
+  std::size_t pos_{0};
+};
+
+inline void SaveDumpCapture(DumpCapture const& capture,
+                            std::wstring const& path)
+{
+  DumpCaptureWriter writer;
+  writer.WriteBytes(kDumpCaptureMagic, sizeof(kDumpCaptureMagic));
+  writer.Write(kDumpCaptureVersion);
+  writer.Write(static_cast<std::uint32_t>(sizeof(void*)));
+  writer.Write(capture.pid);
+  writer.WriteString(capture.process_path);
+
+  writer.Write(static_cast<std::uint32_t>(capture.modules.size()));
+  for (auto const& m : capture.modules)
+  {
+    writer.Write(static_cast<std::uint64_t>(m.base));
+    writer.Write(m.size);
+    writer.Write(m.priority);
+    writer.WriteString(m.path);
+    writer.WriteString(m.name);
+  }
+
+  writer.Write(static_cast<std::uint32_t>(capture.exports.size()));
+  for (auto const& e : capture.exports)
+  {
+    writer.Write(static_cast<std::uint64_t>(e.va));
+    writer.Write(e.module);
+    writer.Write(e.ordinal);
+    writer.Write(static_cast<std::uint8_t>(e.by_name));
+    writer.WriteString(e.name);
+  }
+
+  auto const& buffer = writer.GetBuffer();
+  MappedFile file;
+  file.Create(path, buffer.size());
+  std::memcpy(file.GetData(), buffer.data(), buffer.size());
+}
+
+inline DumpCapture LoadDumpCapture(std::wstring const& path)
+{
+  MappedFile file;
+  file.Open(path);
+  DumpCaptureReader reader(file.GetData(),
+                           static_cast<std::size_t>(file.GetSize()));
+
+  std::uint8_t magic[sizeof(kDumpCaptureMagic)];
+  reader.ReadBytes(magic, sizeof(magic));
+  if (std::memcmp(magic, kDumpCaptureMagic, sizeof(magic)) ||
+      reader.Read<std::uint32_t>() != kDumpCaptureVersion)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Invalid dump capture header."});
+  }
+
+  // Addresses are only meaningful to a dumper of the same bitness as the
+  // target, as they're compared against pointers read from the images.
+  if (reader.Read<std::uint32_t>() != sizeof(void*))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Dump capture pointer size mismatch."});
+  }
+
+  DumpCapture capture;
+  capture.pid = reader.Read<std::uint32_t>();
+  capture.process_path = reader.ReadWideString();
+
+  // Each module and export takes at least this many bytes, so checking
+  // counts against the remaining size up front stops a corrupt count from
+  // causing a huge allocation.
+  std::size_t const kMinModuleSize = 24;
+  std::size_t const kMinExportSize = 21;
+
+  auto const num_modules = reader.Read<std::uint32_t>();
+  if (num_modules > reader.GetRemaining() / kMinModuleSize)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Invalid dump capture module count."});
+  }
+  capture.modules.reserve(num_modules);
+  for (std::uint32_t i = 0; i < num_modules; ++i)
+  {
+    DumpCaptureModule m;
+    m.base = static_cast<std::uintptr_t>(reader.Read<std::uint64_t>());
+    m.size = reader.Read<std::uint32_t>();
+    m.priority = reader.Read<std::int32_t>();
+    m.path = reader.ReadWideString();
+    m.name = reader.ReadWideString();
+    capture.modules.emplace_back(std::move(m));
+  }
+
+  auto const num_exports = reader.Read<std::uint32_t>();
+  if (num_exports > reader.GetRemaining() / kMinExportSize)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Invalid dump capture export count."});
+  }
+  capture.exports.reserve(num_exports);
+  for (std::uint32_t i = 0; i < num_exports; ++i)
+  {
+    DumpCaptureExport e;
+    e.va = static_cast<std::uintptr_t>(reader.Read<std::uint64_t>());
+    e.module = reader.Read<std::uint32_t>();
+    e.ordinal = reader.Read<std::uint32_t>();
+    e.by_name = !!reader.Read<std::uint8_t>();
+    e.name = reader.ReadString();
+    if (!e.va || e.module >= capture.modules.size())
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Invalid dump capture export."});
+    }
+    capture.exports.emplace_back(std::move(e));
+  }
+
+  return capture;
+}
+
+// Restricts another source to a set of address ranges, e.g. to snapshot only
+// the module images of a process rather than all of its memory.
+class SpanScanSource : public ScanSource
+{
+public:
+  explicit SpanScanSource(ScanSource const& source) : source_{&source}
+  {
+  }
+
+  explicit SpanScanSource(ScanSource&& source) = delete;
+
+  void Add(std::uintptr_t begin, std::uintptr_t end)
+  {
+    if (begin < end)
+    {
+      spans_.emplace_back(begin, end);
+    }
+  }
+
+  // Must be called after adding spans and before use.
+  void Finalize()
+  {
+    std::sort(std::begin(spans_), std::end(spans_));
+
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> merged;
+    for (auto const& span : spans_)
+    {
+      if (!merged.empty() && span.first <= merged.back().second)
+      {
+        merged.back().second = (std::max)(merged.back().second, span.second);
+      }
+      else
+      {
+        merged.push_back(span);
+      }
+    }
+    spans_.swap(merged);
+  }
+
+  virtual void GetRegions(RegionSnapshot& snapshot) const override
+  {
+    RegionSnapshot all;
+    source_->GetRegions(all);
+
+    std::vector<MEMORY_BASIC_INFORMATION> regions;
+    for (auto const& region : all)
+    {
+      auto const region_end = region.base + region.size;
+      auto iter = std::upper_bound(
+        std::begin(spans_),
+        std::end(spans_),
+        region.base,
+        [](std::uintptr_t a,
+           std::pair<std::uintptr_t, std::uintptr_t> const& s) {
+          return a < s.first;
+        });
+      if (iter != std::begin(spans_))
+      {
+        --iter;
+      }
+
+      for (; iter != std::end(spans_) && iter->first < region_end; ++iter)
+      {
+        auto const beg = (std::max)(region.base, iter->first);
+        auto const end = (std::min)(region_end, iter->second);
+        if (beg >= end)
+        {
+          continue;
+        }
+
+        MEMORY_BASIC_INFORMATION mbi{};
+        mbi.BaseAddress = reinterpret_cast<PVOID>(beg);
+        mbi.AllocationBase = reinterpret_cast<PVOID>(region.alloc_base);
+        mbi.RegionSize = end - beg;
+        mbi.State = region.state;
+        mbi.Protect = region.protect;
+        mbi.Type = region.type;
+        regions.push_back(mbi);
+      }
+    }
+
+    snapshot.Assign(std::begin(regions), std::end(regions));
+  }
+
+  virtual bool
+    Read(std::uintptr_t address, void* data, std::size_t len) const override
+  {
+    auto const iter = std::upper_bound(
+      std::begin(spans_),
+      std::end(spans_),
+      address,
+      [](std::uintptr_t a, std::pair<std::uintptr_t, std::uintptr_t> const& s) {
+        return a < s.first;
+      });
+    if (iter == std::begin(spans_) || address >= (iter - 1)->second ||
+        len > (iter - 1)->second - address)
+    {
+      return false;
+    }
+
+    return source_->Read(address, data, len);
+  }
+
+private:
+  ScanSource const* source_;
+  std::vector<std::pair<std::uintptr_t, std::uintptr_t>> spans_;
+};
+}
+}
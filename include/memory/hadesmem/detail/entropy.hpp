@@ -3,39 +3,224 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <string>
-#include <map>
-#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+
+// Byte histograms and Shannon entropy (in bits per byte).
+// Counting is done into several independent tables which are summed at the
+// end. With a single table, runs of the same byte (very common in PE files)
+// make every increment wait on the store from the previous one.
 
 namespace hadesmem
 {
 namespace detail
 {
-double Log2(double number)
+using ByteHistogram = std::array<std::uint64_t, 256>;
+
+inline double Log2(double number)
 {
   return std::log(number) / std::log(2);
 }
 
-double GetEntropy(void const* p, std::size_t s)
+inline void UpdateByteHistogram(ByteHistogram& histogram,
+                                void const* p,
+                                std::size_t s)
+{
+  auto b = static_cast<std::uint8_t const*>(p);
+
+  // Not worth clearing and summing the lanes for a handful of bytes.
+  std::size_t const kMinLaneSize = 0x400;
+  if (s < kMinLaneSize)
+  {
+    for (auto const end = b + s; b != end; ++b)
+    {
+      ++histogram[*b];
+    }
+    return;
+  }
+
+  // Small enough that a lane can't overflow.
+  std::size_t const kChunkSize = 0x40000000;
+
+  // One lane per byte of a 64-bit word.
+  std::uint32_t lanes[8][256] = {};
+
+  while (s)
+  {
+    auto const chunk = (std::min)(s, kChunkSize);
+    auto const end = b + chunk;
+
+    for (; b + 8 <= end; b += 8)
+    {
+      std::uint64_t w;
+      std::memcpy(&w, b, sizeof(w));
+      ++lanes[0][w & 0xFF];
+      ++lanes[1][(w >> 8) & 0xFF];
+      ++lanes[2][(w >> 16) & 0xFF];
+      ++lanes[3][(w >> 24) & 0xFF];
+      ++lanes[4][(w >> 32) & 0xFF];
+      ++lanes[5][(w >> 40) & 0xFF];
+      ++lanes[6][(w >> 48) & 0xFF];
+      ++lanes[7][w >> 56];
+    }
+    for (; b != end; ++b)
+    {
+      ++lanes[0][*b];
+    }
+
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+      std::uint64_t total = 0;
+      for (auto const& lane : lanes)
+      {
+        total += lane[i];
+      }
+      histogram[i] += total;
+    }
+    std::memset(lanes, 0, sizeof(lanes));
+
+    s -= chunk;
+  }
+}
+
+inline ByteHistogram GetByteHistogram(void const* p, std::size_t s)
+{
+  ByteHistogram histogram{};
+  UpdateByteHistogram(histogram, p, s);
+  return histogram;
+}
+
+inline double GetEntropy(ByteHistogram const& histogram)
 {
-  std::map<std::uint8_t, std::size_t> frequencies;
-  for (std::size_t i = 0; i != s; ++i)
+  std::uint64_t total = 0;
+  double sum = 0;
+  for (auto const c : histogram)
   {
-    ++frequencies[static_cast<std::uint8_t const*>(p)[i]];
+    if (c)
+    {
+      total += c;
+      sum += static_cast<double>(c) * Log2(static_cast<double>(c));
+    }
   }
 
-  double entropy = 0;
-  for (auto const& f : frequencies)
+  if (!total)
   {
-    double freq = static_cast<double>(f.second) / s;
-    entropy += freq * Log2(freq);
+    return 0;
   }
 
-  entropy *= -1;
+  // -sum(c/n * log2(c/n)) = log2(n) - sum(c * log2(c)) / n
+  auto const n = static_cast<double>(total);
+  return (std::max)(0.0, Log2(n) - sum / n);
+}
+
+inline double GetEntropy(void const* p, std::size_t s)
+{
+  return GetEntropy(GetByteHistogram(p, s));
+}
+
+struct EntropyBlock
+{
+  std::size_t offset;
+  std::size_t size;
+  double entropy;
+};
+
+// Entropy of each block_size window, with windows starting every step bytes.
+// A final window is aligned to the end of the buffer if the others don't
+// cover it, and a buffer smaller than block_size is a single window.
+// Overlapping windows are updated incrementally rather than recounted.
+inline std::vector<EntropyBlock> GetEntropyMap(void const* p,
+                                               std::size_t s,
+                                               std::size_t block_size,
+                                               std::size_t step)
+{
+  HADESMEM_DETAIL_ASSERT(block_size != 0);
+  HADESMEM_DETAIL_ASSERT(step != 0);
+
+  std::vector<EntropyBlock> blocks;
+  if (!s)
+  {
+    return blocks;
+  }
+
+  auto const b = static_cast<std::uint8_t const*>(p);
+  block_size = (std::min)(block_size, s);
+
+  std::vector<std::size_t> offsets;
+  for (std::size_t offset = 0; offset <= s - block_size; offset += step)
+  {
+    offsets.push_back(offset);
+    if (step > s - block_size - offset)
+    {
+      break;
+    }
+  }
+  if (offsets.back() != s - block_size)
+  {
+    offsets.push_back(s - block_size);
+  }
+
+  // Every window is the same size, so c * log2(c) can be looked up rather
+  // than calculated, as long as the table is a reasonable size.
+  std::size_t const kMaxTableSize = 0x10000;
+  std::vector<double> table;
+  if (block_size <= kMaxTableSize)
+  {
+    table.resize(block_size + 1);
+    for (std::size_t c = 1; c <= block_size; ++c)
+    {
+      table[c] = static_cast<double>(c) * Log2(static_cast<double>(c));
+    }
+  }
+
+  ByteHistogram histogram{};
+  std::size_t prev = 0;
+  blocks.reserve(offsets.size());
+  for (std::size_t i = 0; i < offsets.size(); ++i)
+  {
+    auto const offset = offsets[i];
+    if (!i || offset - prev >= block_size)
+    {
+      histogram = GetByteHistogram(b + offset, block_size);
+    }
+    else
+    {
+      for (auto cur = b + prev; cur != b + offset; ++cur)
+      {
+        --histogram[*cur];
+      }
+      UpdateByteHistogram(histogram, b + prev + block_size, offset - prev);
+    }
+    prev = offset;
+
+    double entropy = 0;
+    if (!table.empty())
+    {
+      double sum = 0;
+      for (auto const c : histogram)
+      {
+        sum += table[static_cast<std::size_t>(c)];
+      }
+      auto const n = static_cast<double>(block_size);
+      entropy = (std::max)(0.0, Log2(n) - sum / n);
+    }
+    else
+    {
+      entropy = GetEntropy(histogram);
+    }
+
+    blocks.emplace_back(EntropyBlock{offset, block_size, entropy});
+  }
 
-  return entropy;
+  return blocks;
 }
 }
 }
@@ -0,0 +1,333 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <emmintrin.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+
+// Lookup structures for the dumper's import reference scan, which checks
+// every 4-byte step of an image against the set of export VAs. Almost every
+// word is a miss, so the common path has to be cheap:
+// - AddressSpanFilter rejects words which don't point into any interesting
+// span (e.g. a loaded module) with a SIMD compare over four candidates at a
+// time, falling back to a binary search over the merged spans.
+// - FlatAddressMap replaces a node based map with an open addressing hash
+// table over a flat, key-sorted array of values.
+// Neither depends on the target process, so both can be built and benchmarked
+// offline from a captured image and export list.
+
+namespace hadesmem
+{
+namespace detail
+{
+class AddressSpanFilter
+{
+public:
+  // Number of bytes Prefilter reads, starting from the pointer passed to it.
+  static std::size_t const kPrefilterReadSize = 12 + sizeof(void*);
+
+  void Add(std::uintptr_t begin, std::uintptr_t end)
+  {
+    if (begin < end)
+    {
+      spans_.emplace_back(begin, end);
+    }
+  }
+
+  // Must be called after adding spans and before querying. Spans separated
+  // by at most merge_gap bytes are merged, which trades a few false positives
+  // (which the caller has to handle anyway) for a shorter search.
+  void Finalize(std::uintptr_t merge_gap = 0)
+  {
+    std::sort(std::begin(spans_), std::end(spans_));
+
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> merged;
+    for (auto const& span : spans_)
+    {
+      if (!merged.empty() && (span.first <= merged.back().second ||
+                              span.first - merged.back().second <= merge_gap))
+      {
+        merged.back().second = (std::max)(merged.back().second, span.second);
+      }
+      else
+      {
+        merged.push_back(span);
+      }
+    }
+    spans_.swap(merged);
+
+    min_ = spans_.empty() ? 1 : spans_.front().first;
+    max_ = spans_.empty() ? 0 : spans_.back().second - 1;
+
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+    // Only the high halves are compared in the prefilter.
+    std::uint32_t const lo = static_cast<std::uint32_t>(min_ >> 32);
+    std::uint32_t const hi = static_cast<std::uint32_t>(max_ >> 32);
+#else
+    std::uint32_t const lo = static_cast<std::uint32_t>(min_);
+    std::uint32_t const hi = static_cast<std::uint32_t>(max_);
+#endif
+    // SSE2 only has signed compares, so bias everything by 2^31.
+    if (!spans_.empty())
+    {
+      lo_biased_ = static_cast<std::int32_t>(lo ^ 0x80000000UL);
+      hi_biased_ = static_cast<std::int32_t>(hi ^ 0x80000000UL);
+    }
+  }
+
+  bool Contains(std::uintptr_t address) const noexcept
+  {
+    if (address < min_ || address > max_)
+    {
+      return false;
+    }
+
+    auto const iter = std::upper_bound(
+      std::begin(spans_),
+      std::end(spans_),
+      address,
+      [](std::uintptr_t a, std::pair<std::uintptr_t, std::uintptr_t> const& s)
+      {
+        return a < s.first;
+      });
+    return iter != std::begin(spans_) && address < (iter - 1)->second;
+  }
+
+  // Returns a mask with bit n set if the pointer sized value at p + n * 4
+  // (for n in [0, 4)) may be in one of the spans. A clear bit means the value
+  // is definitely not in any span. Reads kPrefilterReadSize bytes.
+  std::uint32_t Prefilter(std::uint8_t const* p) const noexcept
+  {
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+    // The high halves of the four candidates.
+    p += 4;
+#endif
+    __m128i const bias = _mm_set1_epi32(static_cast<int>(0x80000000UL));
+    __m128i const values = _mm_xor_si128(
+      _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)), bias);
+    __m128i const out_of_range = _mm_or_si128(
+      _mm_cmplt_epi32(values, _mm_set1_epi32(lo_biased_)),
+      _mm_cmpgt_epi32(values, _mm_set1_epi32(hi_biased_)));
+    return ~static_cast<std::uint32_t>(
+             _mm_movemask_ps(_mm_castsi128_ps(out_of_range))) &
+           0xF;
+  }
+
+  std::size_t size() const noexcept
+  {
+    return spans_.size();
+  }
+
+private:
+  std::vector<std::pair<std::uintptr_t, std::uintptr_t>> spans_;
+  std::uintptr_t min_{1};
+  std::uintptr_t max_{0};
+  std::int32_t lo_biased_{(std::numeric_limits<std::int32_t>::max)()};
+  std::int32_t hi_biased_{(std::numeric_limits<std::int32_t>::min)()};
+};
+
+// Multimap from non-zero addresses to values. Values are inserted up front,
+// then Finalize groups them by key (preserving insertion order within a key)
+// and builds the hash table, after which the map is read-only apart from
+// SortValues. Pointers to values are stable after Finalize.
+template <typename Value> class FlatAddressMap
+{
+public:
+  class Range
+  {
+  public:
+    Range() = default;
+
+    Range(Value const* first, Value const* last) noexcept
+      : first_{first}, last_{last}
+    {
+    }
+
+    Value const* begin() const noexcept
+    {
+      return first_;
+    }
+
+    Value const* end() const noexcept
+    {
+      return last_;
+    }
+
+    bool empty() const noexcept
+    {
+      return first_ == last_;
+    }
+
+    std::size_t size() const noexcept
+    {
+      return static_cast<std::size_t>(last_ - first_);
+    }
+
+    Value const& back() const noexcept
+    {
+      HADESMEM_DETAIL_ASSERT(!empty());
+      return *(last_ - 1);
+    }
+
+  private:
+    Value const* first_{nullptr};
+    Value const* last_{nullptr};
+  };
+
+  void Insert(std::uintptr_t key, Value value)
+  {
+    HADESMEM_DETAIL_ASSERT(key != 0);
+    HADESMEM_DETAIL_ASSERT(!finalized_);
+
+    pending_.emplace_back(key, std::move(value));
+  }
+
+  void Finalize()
+  {
+    std::stable_sort(std::begin(pending_),
+                     std::end(pending_),
+                     [](std::pair<std::uintptr_t, Value> const& lhs,
+                        std::pair<std::uintptr_t, Value> const& rhs)
+                     {
+                       return lhs.first < rhs.first;
+                     });
+
+    values_.reserve(values_.size() + pending_.size());
+    for (auto& entry : pending_)
+    {
+      if (group_keys_.empty() || group_keys_.back() != entry.first)
+      {
+        group_keys_.push_back(entry.first);
+        group_begins_.push_back(static_cast<std::uint32_t>(values_.size()));
+      }
+      values_.emplace_back(std::move(entry.second));
+    }
+    group_begins_.push_back(static_cast<std::uint32_t>(values_.size()));
+    decltype(pending_)().swap(pending_);
+
+    // Keep the load factor at or below 0.5 so probe sequences stay short.
+    std::size_t capacity = 16;
+    shift_ = 64 - 4;
+    while (capacity < group_keys_.size() * 2)
+    {
+      capacity *= 2;
+      --shift_;
+    }
+    keys_.assign(capacity, 0);
+    groups_.assign(capacity, 0);
+    for (std::size_t g = 0; g < group_keys_.size(); ++g)
+    {
+      std::size_t slot = Hash(group_keys_[g]);
+      while (keys_[slot])
+      {
+        slot = (slot + 1) & (capacity - 1);
+      }
+      keys_[slot] = group_keys_[g];
+      groups_[slot] = static_cast<std::uint32_t>(g);
+    }
+
+    finalized_ = true;
+  }
+
+  Range Find(std::uintptr_t key) const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(finalized_);
+
+    if (!key || keys_.empty())
+    {
+      return Range();
+    }
+
+    std::size_t const mask = keys_.size() - 1;
+    for (std::size_t slot = Hash(key); keys_[slot]; slot = (slot + 1) & mask)
+    {
+      if (keys_[slot] == key)
+      {
+        std::uint32_t const g = groups_[slot];
+        return Range(values_.data() + group_begins_[g],
+                     values_.data() + group_begins_[g + 1]);
+      }
+    }
+
+    return Range();
+  }
+
+  template <typename Compare> void SortValues(Compare const& compare)
+  {
+    HADESMEM_DETAIL_ASSERT(finalized_);
+
+    for (std::size_t g = 0; g < group_keys_.size(); ++g)
+    {
+      std::sort(values_.begin() + group_begins_[g],
+                values_.begin() + group_begins_[g + 1],
+                compare);
+    }
+  }
+
+  // Calls func(key, value) for every value, in key order. Values which share
+  // a key are visited in their current order.
+  template <typename Func> void ForEach(Func const& func) const
+  {
+    HADESMEM_DETAIL_ASSERT(finalized_);
+
+    for (std::size_t g = 0; g < group_keys_.size(); ++g)
+    {
+      for (auto i = group_begins_[g]; i < group_begins_[g + 1]; ++i)
+      {
+        func(group_keys_[g], values_[i]);
+      }
+    }
+  }
+
+  // Number of distinct keys.
+  std::size_t size() const noexcept
+  {
+    return group_keys_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return group_keys_.empty();
+  }
+
+  std::uintptr_t GetMinKey() const noexcept
+  {
+    return group_keys_.empty() ? 0 : group_keys_.front();
+  }
+
+  std::uintptr_t GetMaxKey() const noexcept
+  {
+    return group_keys_.empty() ? 0 : group_keys_.back();
+  }
+
+private:
+  std::size_t Hash(std::uintptr_t key) const noexcept
+  {
+    // Fibonacci hashing. Export VAs share their high bits and are often
+    // aligned, so the multiply is needed to spread them across the table.
+    return static_cast<std::size_t>(
+      (static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> shift_);
+  }
+
+  std::vector<std::pair<std::uintptr_t, Value>> pending_;
+  std::vector<std::uintptr_t> group_keys_;
+  std::vector<std::uint32_t> group_begins_;
+  std::vector<Value> values_;
+  std::vector<std::uintptr_t> keys_;
+  std::vector<std::uint32_t> groups_;
+  unsigned int shift_{64};
+  bool finalized_{false};
+};
+}
+}
@@ -0,0 +1,322 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+
+// Address keyed lookup table for exception based hooks (INT3, DR, etc.), which
+// have to find the hook for an address from inside the exception handler on
+// every hit.
+// Lookups take no locks and never write to shared state other than a striped
+// reader count. Each table is an immutable open addressed snapshot. Writers
+// (serialized by a mutex) build a new snapshot and publish it with an atomic
+// pointer swap. Old snapshots are freed using epoch based reclamation: readers
+// announce the epoch they started in, and a snapshot retired in epoch N is
+// only freed once the epoch has advanced to N + 2, which can only happen once
+// no reader from epoch N is left.
+// Readers never wait for writers, and writers never wait for readers (retired
+// snapshots are just freed later instead), so a reader which is suspended in
+// the middle of a lookup can't deadlock anything.
+
+namespace hadesmem
+{
+namespace detail
+{
+// Key zero is reserved. ValueT is copied out of the table, so that readers
+// never have to touch anything which a writer could free.
+template <typename ValueT> class HookDispatchTable
+{
+public:
+  HADESMEM_DETAIL_STATIC_ASSERT(std::is_trivially_copyable<ValueT>::value);
+
+  HookDispatchTable() = default;
+
+  HookDispatchTable(HookDispatchTable const& other) = delete;
+
+  HookDispatchTable& operator=(HookDispatchTable const& other) = delete;
+
+  ~HookDispatchTable()
+  {
+    delete table_.load(std::memory_order_relaxed);
+    for (auto const& retired : retired_)
+    {
+      delete retired.first;
+    }
+  }
+
+  bool Find(std::uintptr_t key, ValueT& value) const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(key != 0);
+
+    auto& reader_count = reader_counts_[GetReaderStripe()];
+    std::uintptr_t const epoch = EnterReader(reader_count);
+
+    bool found = false;
+    if (Table const* const table = table_.load(std::memory_order_acquire))
+    {
+      for (std::size_t i = Hash(key, table->shift);;
+           i = (i + 1) & table->mask)
+      {
+        Entry const& entry = table->entries[i];
+        if (entry.key == key)
+        {
+          value = entry.value;
+          found = true;
+          break;
+        }
+
+        if (entry.key == 0)
+        {
+          break;
+        }
+      }
+    }
+
+    reader_count.count[epoch & 1].fetch_sub(1, std::memory_order_release);
+
+    return found;
+  }
+
+  bool Contains(std::uintptr_t key) const noexcept
+  {
+    ValueT value{};
+    return Find(key, value);
+  }
+
+  // Returns false (and leaves the table unchanged) if the key already exists.
+  bool Insert(std::uintptr_t key, ValueT const& value)
+  {
+    HADESMEM_DETAIL_ASSERT(key != 0);
+
+    std::lock_guard<std::mutex> const lock{writer_mutex_};
+
+    Table const* const table = table_.load(std::memory_order_relaxed);
+    std::vector<Entry> entries;
+    if (table)
+    {
+      entries.reserve(table->size + 1);
+      for (auto const& entry : table->entries)
+      {
+        if (entry.key == key)
+        {
+          return false;
+        }
+
+        if (entry.key != 0)
+        {
+          entries.push_back(entry);
+        }
+      }
+    }
+
+    entries.push_back(Entry{key, value});
+    Publish(entries);
+
+    return true;
+  }
+
+  // Returns false if the key doesn't exist.
+  bool Erase(std::uintptr_t key)
+  {
+    HADESMEM_DETAIL_ASSERT(key != 0);
+
+    std::lock_guard<std::mutex> const lock{writer_mutex_};
+
+    Table const* const table = table_.load(std::memory_order_relaxed);
+    if (!table)
+    {
+      return false;
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(table->size);
+    bool found = false;
+    for (auto const& entry : table->entries)
+    {
+      if (entry.key == key)
+      {
+        found = true;
+      }
+      else if (entry.key != 0)
+      {
+        entries.push_back(entry);
+      }
+    }
+
+    if (found)
+    {
+      Publish(entries);
+    }
+
+    return found;
+  }
+
+  std::size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> const lock{writer_mutex_};
+    Table const* const table = table_.load(std::memory_order_relaxed);
+    return table ? table->size : 0;
+  }
+
+  // Number of old snapshots which are still waiting for readers to move on.
+  std::size_t GetNumRetired() const
+  {
+    std::lock_guard<std::mutex> const lock{writer_mutex_};
+    return retired_.size();
+  }
+
+private:
+  struct Entry
+  {
+    std::uintptr_t key;
+    ValueT value;
+  };
+
+  struct Table
+  {
+    std::size_t shift;
+    std::size_t mask;
+    std::size_t size;
+    std::vector<Entry> entries;
+  };
+
+  // Counts are additive, so threads sharing a stripe is fine. Stripes are
+  // padded out to a cache line so readers on different threads (usually)
+  // don't contend.
+  struct ReaderCount
+  {
+    std::atomic<std::uint32_t> count[2];
+    char padding[64 - 2 * sizeof(std::atomic<std::uint32_t>)];
+  };
+
+  static std::size_t const kNumReaderStripes = 16;
+
+  static std::size_t Hash(std::uintptr_t key, std::size_t shift) noexcept
+  {
+    // Fibonacci hashing. Code addresses tend to share their low bits (due to
+    // alignment), so use the high bits of the product.
+    return static_cast<std::size_t>(
+      (static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> shift);
+  }
+
+  static std::size_t GetReaderStripe() noexcept
+  {
+    return std::hash<std::thread::id>()(std::this_thread::get_id()) %
+           kNumReaderStripes;
+  }
+
+  std::uintptr_t EnterReader(ReaderCount& reader_count) const noexcept
+  {
+    std::uintptr_t epoch = epoch_.load(std::memory_order_seq_cst);
+    for (;;)
+    {
+      reader_count.count[epoch & 1].fetch_add(1, std::memory_order_seq_cst);
+      std::uintptr_t const cur_epoch = epoch_.load(std::memory_order_seq_cst);
+      if (cur_epoch == epoch)
+      {
+        return epoch;
+      }
+
+      // The epoch moved on before we were counted, so the writer may not
+      // have seen us. Try again in the new one.
+      reader_count.count[epoch & 1].fetch_sub(1, std::memory_order_release);
+      epoch = cur_epoch;
+    }
+  }
+
+  // Must be called with the writer mutex held.
+  void Publish(std::vector<Entry> const& entries)
+  {
+    std::size_t bits = 3;
+    while ((static_cast<std::size_t>(1) << bits) < entries.size() * 2)
+    {
+      ++bits;
+    }
+
+    auto new_table = std::make_unique<Table>();
+    new_table->shift = 64 - bits;
+    new_table->mask = (static_cast<std::size_t>(1) << bits) - 1;
+    new_table->size = entries.size();
+    new_table->entries.resize(new_table->mask + 1, Entry{0, ValueT{}});
+    for (auto const& entry : entries)
+    {
+      std::size_t i = Hash(entry.key, new_table->shift);
+      while (new_table->entries[i].key != 0)
+      {
+        i = (i + 1) & new_table->mask;
+      }
+      new_table->entries[i] = entry;
+    }
+
+    std::uintptr_t const epoch = epoch_.load(std::memory_order_relaxed);
+    retired_.reserve(retired_.size() + 1);
+    Table const* const old_table =
+      table_.exchange(new_table.release(), std::memory_order_seq_cst);
+    if (old_table)
+    {
+      retired_.emplace_back(old_table, epoch);
+    }
+
+    Reclaim();
+  }
+
+  // Must be called with the writer mutex held.
+  void Reclaim() noexcept
+  {
+    // Moving from epoch N to N + 1 requires that every reader from N - 1 has
+    // finished, so try twice in case we can get straight past the epoch the
+    // most recent snapshot was retired in.
+    for (std::size_t i = 0; i < 2 && !retired_.empty(); ++i)
+    {
+      std::uintptr_t const epoch = epoch_.load(std::memory_order_relaxed);
+      for (auto const& reader_count : reader_counts_)
+      {
+        if (reader_count.count[(epoch - 1) & 1].load(
+              std::memory_order_seq_cst) != 0)
+        {
+          return;
+        }
+      }
+
+      epoch_.store(epoch + 1, std::memory_order_seq_cst);
+
+      auto const iter = std::remove_if(
+        std::begin(retired_),
+        std::end(retired_),
+        [&](std::pair<Table const*, std::uintptr_t> const& retired) {
+          if (epoch + 1 - retired.second < 2)
+          {
+            return false;
+          }
+
+          delete retired.first;
+          return true;
+        });
+      retired_.erase(iter, std::end(retired_));
+    }
+  }
+
+  std::atomic<Table const*> table_{nullptr};
+  std::atomic<std::uintptr_t> epoch_{2};
+  mutable ReaderCount reader_counts_[kNumReaderStripes]{};
+  mutable std::mutex writer_mutex_;
+  // Old snapshot and the epoch it was retired in.
+  std::vector<std::pair<Table const*, std::uintptr_t>> retired_;
+};
+}
+}
@@ -0,0 +1,342 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <intrin.h>
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <x86intrin.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// Per-hook call counts and latency histograms. Only used by the patchers when
+// HADESMEM_DETOUR_PROFILE is defined, otherwise nothing here is referenced
+// and there is no cost at all.
+// Counters are sharded by thread so hooks called from many threads at once
+// don't fight over a cache line. Latency is measured in TSC ticks (for the
+// whole call through the detour, including the trampoline) and recorded in a
+// log-linear histogram: exact below 8 ticks, then 4 buckets per power of two
+// (so within 25% of the real value).
+// Snapshots just read the counters, so they never block or slow down hooks,
+// but may be very slightly inconsistent with each other while calls are in
+// flight.
+
+namespace hadesmem
+{
+namespace detail
+{
+inline std::uint64_t ReadTimestampCounter() noexcept
+{
+  return __rdtsc();
+}
+
+std::size_t const kHookProfileNumBuckets = 188;
+
+inline unsigned int FloorLog2(std::uint64_t value) noexcept
+{
+  unsigned int result = 0;
+  for (unsigned int shift = 32; shift; shift >>= 1)
+  {
+    if (value >> shift)
+    {
+      value >>= shift;
+      result += shift;
+    }
+  }
+  return result;
+}
+
+inline std::size_t GetHookProfileBucket(std::uint64_t ticks) noexcept
+{
+  if (ticks < 8)
+  {
+    return static_cast<std::size_t>(ticks);
+  }
+
+  unsigned int const log2 = FloorLog2(ticks);
+  std::size_t const bucket =
+    8 + (log2 - 3) * 4 + static_cast<std::size_t>((ticks >> (log2 - 2)) & 3);
+  return (std::min)(bucket, kHookProfileNumBuckets - 1);
+}
+
+// Smallest value which falls in the given bucket.
+inline std::uint64_t GetHookProfileBucketMin(std::size_t bucket) noexcept
+{
+  if (bucket < 8)
+  {
+    return bucket;
+  }
+
+  std::size_t const log2 = (bucket - 8) / 4 + 3;
+  std::uint64_t const sub = (bucket - 8) % 4;
+  return (4 + sub) << (log2 - 2);
+}
+
+struct HookProfileSnapshot
+{
+  void const* target;
+  std::uint64_t num_calls;
+  std::uint64_t num_samples;
+  std::uint64_t total_ticks;
+  std::vector<std::uint64_t> buckets;
+
+  double GetMeanTicks() const noexcept
+  {
+    return num_samples ? static_cast<double>(total_ticks) /
+                           static_cast<double>(num_samples)
+                       : 0.0;
+  }
+
+  // Upper bound (in ticks) of the bucket containing the given percentile
+  // (0-100) of sampled calls.
+  std::uint64_t GetPercentileTicks(double percentile) const noexcept
+  {
+    std::uint64_t total = 0;
+    for (auto const count : buckets)
+    {
+      total += count;
+    }
+    if (!total)
+    {
+      return 0;
+    }
+
+    auto const wanted = static_cast<std::uint64_t>(
+      static_cast<double>(total) * percentile / 100.0);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+      seen += buckets[i];
+      if (seen > wanted || seen == total)
+      {
+        return i + 1 < kHookProfileNumBuckets
+                 ? GetHookProfileBucketMin(i + 1) - 1
+                 : ~std::uint64_t{};
+      }
+    }
+    return ~std::uint64_t{};
+  }
+};
+
+class HookProfile;
+
+class HookProfileRegistry
+{
+public:
+  void Register(HookProfile* profile)
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    profiles_.push_back(profile);
+  }
+
+  void Unregister(HookProfile* profile)
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    profiles_.erase(std::remove(std::begin(profiles_), std::end(profiles_),
+                                profile),
+                    std::end(profiles_));
+  }
+
+  // Only blocks hooks being created or destroyed, not called.
+  std::vector<HookProfileSnapshot> GetSnapshots() const;
+
+  void Reset();
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<HookProfile*> profiles_;
+};
+
+inline HookProfileRegistry& GetHookProfileRegistry()
+{
+  static HookProfileRegistry* const registry = new HookProfileRegistry{};
+  return *registry;
+}
+
+class HookProfile
+{
+public:
+  explicit HookProfile(void const* target) : target_{target}
+  {
+    GetHookProfileRegistry().Register(this);
+  }
+
+  HookProfile(HookProfile const&) = delete;
+
+  HookProfile& operator=(HookProfile const&) = delete;
+
+  ~HookProfile()
+  {
+    GetHookProfileRegistry().Unregister(this);
+  }
+
+  void const* GetTarget() const noexcept
+  {
+    return target_;
+  }
+
+  // Only time 1 in 2^shift calls (per shard). Calls are always counted.
+  void SetSampleShift(unsigned int shift) noexcept
+  {
+    sample_mask_.store((std::uint64_t{1} << shift) - 1,
+                       std::memory_order_relaxed);
+  }
+
+  // Returns whether this call should be timed.
+  bool BeginCall() noexcept
+  {
+    auto const num_calls =
+      GetShard().num_calls.fetch_add(1, std::memory_order_relaxed);
+    return (num_calls & sample_mask_.load(std::memory_order_relaxed)) == 0;
+  }
+
+  void EndCall(std::uint64_t ticks) noexcept
+  {
+    auto& shard = GetShard();
+    shard.num_samples.fetch_add(1, std::memory_order_relaxed);
+    shard.total_ticks.fetch_add(ticks, std::memory_order_relaxed);
+    shard.buckets[GetHookProfileBucket(ticks)].fetch_add(
+      1, std::memory_order_relaxed);
+  }
+
+  HookProfileSnapshot GetSnapshot() const
+  {
+    HookProfileSnapshot snapshot{};
+    snapshot.target = target_;
+    snapshot.buckets.resize(kHookProfileNumBuckets);
+    for (auto const& shard : shards_)
+    {
+      snapshot.num_calls += shard.num_calls.load(std::memory_order_relaxed);
+      snapshot.num_samples +=
+        shard.num_samples.load(std::memory_order_relaxed);
+      snapshot.total_ticks +=
+        shard.total_ticks.load(std::memory_order_relaxed);
+      for (std::size_t i = 0; i < kHookProfileNumBuckets; ++i)
+      {
+        snapshot.buckets[i] +=
+          shard.buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+    return snapshot;
+  }
+
+  // Not atomic with respect to calls in flight, so a few may be lost or
+  // only partially counted.
+  void Reset() noexcept
+  {
+    for (auto& shard : shards_)
+    {
+      shard.num_calls.store(0, std::memory_order_relaxed);
+      shard.num_samples.store(0, std::memory_order_relaxed);
+      shard.total_ticks.store(0, std::memory_order_relaxed);
+      for (auto& bucket : shard.buckets)
+      {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  // Padded so the frequently written counters at the start of each shard
+  // aren't on the same cache line as the end of the previous one.
+  struct Shard
+  {
+    std::atomic<std::uint64_t> num_calls;
+    std::atomic<std::uint64_t> num_samples;
+    std::atomic<std::uint64_t> total_ticks;
+    std::atomic<std::uint64_t> buckets[kHookProfileNumBuckets];
+    char padding[64];
+  };
+
+  static std::size_t const kNumShards = 8;
+
+  Shard& GetShard() noexcept
+  {
+    return shards_[std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                   kNumShards];
+  }
+
+  void const* target_;
+  std::atomic<std::uint64_t> sample_mask_{0};
+  Shard shards_[kNumShards]{};
+};
+
+inline std::vector<HookProfileSnapshot> HookProfileRegistry::GetSnapshots()
+  const
+{
+  std::lock_guard<std::mutex> const lock{mutex_};
+  std::vector<HookProfileSnapshot> snapshots;
+  snapshots.reserve(profiles_.size());
+  for (auto const profile : profiles_)
+  {
+    snapshots.push_back(profile->GetSnapshot());
+  }
+  return snapshots;
+}
+
+inline void HookProfileRegistry::Reset()
+{
+  std::lock_guard<std::mutex> const lock{mutex_};
+  for (auto const profile : profiles_)
+  {
+    profile->Reset();
+  }
+}
+
+// Times a call through a hook. Profile may be null.
+class HookProfileScope
+{
+public:
+  explicit HookProfileScope(HookProfile* profile) noexcept
+    : profile_{profile && profile->BeginCall() ? profile : nullptr},
+      start_{profile_ ? ReadTimestampCounter() : 0}
+  {
+  }
+
+  HookProfileScope(HookProfileScope const&) = delete;
+
+  HookProfileScope& operator=(HookProfileScope const&) = delete;
+
+  ~HookProfileScope()
+  {
+    if (profile_)
+    {
+      profile_->EndCall(ReadTimestampCounter() - start_);
+    }
+  }
+
+private:
+  HookProfile* profile_;
+  std::uint64_t start_;
+};
+
+// One line per hook: target, calls, samples, mean, p50, p90, p99, max bucket
+// (all in ticks).
+inline void WriteHookProfilesCsv(
+  std::ostream& out, std::vector<HookProfileSnapshot> const& snapshots)
+{
+  out << "Target,Calls,Samples,Mean,P50,P90,P99,Max\n";
+  for (auto const& snapshot : snapshots)
+  {
+    out << snapshot.target << ',' << snapshot.num_calls << ','
+        << snapshot.num_samples << ',' << snapshot.GetMeanTicks() << ','
+        << snapshot.GetPercentileTicks(50) << ','
+        << snapshot.GetPercentileTicks(90) << ','
+        << snapshot.GetPercentileTicks(99) << ','
+        << snapshot.GetPercentileTicks(100) << '\n';
+  }
+}
+}
+}
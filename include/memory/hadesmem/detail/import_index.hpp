@@ -0,0 +1,540 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <mutex>
+
+#include <hadesmem/module.hpp>
+#include <hadesmem/module_list.hpp>
+#include <hadesmem/process.hpp>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// Maps (module, function) to the address of every IAT slot which imports it,
+// across a set of mapped images. Built in one pass per image, rather than
+// walking every import table each time something wants to hook an import.
+// Images are parsed in image layout (i.e. RVAs are offsets from the base)
+// through an ImageReader, without any Win32 PE definitions, so the index can
+// be built and tested on any OS from a captured image. Live images are read
+// with ReadProcessMemory rather than dereferenced, so a module unloaded while
+// it's being parsed throws instead of faulting.
+// Module names are matched case insensitively (ASCII only, which is all the
+// loader supports for import names anyway), function names exactly.
+
+namespace hadesmem
+{
+namespace detail
+{
+std::size_t const kImageReaderPageSize = 0x1000;
+
+// Where the bytes of an image come from. Offsets are relative to the image
+// base, and have already been bounds checked against the image size.
+class ImageReader
+{
+public:
+  virtual ~ImageReader()
+  {
+  }
+
+  virtual bool Read(std::size_t offset, void* data, std::size_t len) const = 0;
+};
+
+class BufferImageReader : public ImageReader
+{
+public:
+  explicit BufferImageReader(std::uint8_t const* image) noexcept
+    : image_{image}
+  {
+  }
+
+  virtual bool
+    Read(std::size_t offset, void* data, std::size_t len) const override
+  {
+    std::memcpy(data, image_ + offset, len);
+    return true;
+  }
+
+private:
+  std::uint8_t const* image_;
+};
+
+class ImportIndex
+{
+public:
+  // Indexes the imports of an image mapped at base. Replaces anything already
+  // indexed at that base.
+  void AddImage(std::uintptr_t base,
+                std::uint8_t const* image,
+                std::size_t size)
+  {
+    AddImage(base, BufferImageReader{image}, size);
+  }
+
+  void AddImage(std::uintptr_t base,
+                ImageReader const& reader,
+                std::size_t size)
+  {
+    // Parse everything up front so a malformed image leaves no trace.
+    std::vector<std::pair<std::string, DWORD>> imports;
+    ImageParser const parser{reader, size};
+    parser.ForEachImport(
+      [&](std::string const& module, std::string const& function, DWORD rva) {
+        imports.emplace_back(MakeKey(module, function), rva);
+      });
+
+    RemoveImage(base);
+
+    ImageInfo info{size, GetImageTimeStamp(reader, size), {}};
+    for (auto& import : imports)
+    {
+      auto& slots = slots_[import.first];
+      if (slots.empty() || !IsInImage(slots.back(), base, size))
+      {
+        info.keys.push_back(import.first);
+      }
+      slots.push_back(base + import.second);
+    }
+
+    images_[base] = std::move(info);
+  }
+
+  bool RemoveImage(std::uintptr_t base)
+  {
+    auto const iter = images_.find(base);
+    if (iter == std::end(images_))
+    {
+      return false;
+    }
+
+    std::size_t const size = iter->second.size;
+    for (auto const& key : iter->second.keys)
+    {
+      auto const slots_iter = slots_.find(key);
+      if (slots_iter == std::end(slots_))
+      {
+        continue;
+      }
+
+      auto& slots = slots_iter->second;
+      slots.erase(std::remove_if(std::begin(slots),
+                                 std::end(slots),
+                                 [&](std::uintptr_t slot) {
+                                   return IsInImage(slot, base, size);
+                                 }),
+                  std::end(slots));
+      if (slots.empty())
+      {
+        slots_.erase(slots_iter);
+      }
+    }
+
+    images_.erase(iter);
+    return true;
+  }
+
+  // Whether the image at base has been indexed and still looks the same
+  // (i.e. hasn't been unloaded and replaced by something else).
+  bool HasImage(std::uintptr_t base,
+                std::uint8_t const* image,
+                std::size_t size) const
+  {
+    return HasImage(base, BufferImageReader{image}, size);
+  }
+
+  bool HasImage(std::uintptr_t base,
+                ImageReader const& reader,
+                std::size_t size) const
+  {
+    auto const iter = images_.find(base);
+    return iter != std::end(images_) && iter->second.size == size &&
+           iter->second.time_stamp == GetImageTimeStamp(reader, size);
+  }
+
+  std::vector<std::uintptr_t> GetImages() const
+  {
+    std::vector<std::uintptr_t> bases;
+    bases.reserve(images_.size());
+    for (auto const& image : images_)
+    {
+      bases.push_back(image.first);
+    }
+    return bases;
+  }
+
+  // Addresses of the IAT slots importing function (by name) from module.
+  std::vector<std::uintptr_t> Find(std::string const& module,
+                                   std::string const& function) const
+  {
+    auto const iter = slots_.find(MakeKey(module, function));
+    return iter != std::end(slots_) ? iter->second
+                                    : std::vector<std::uintptr_t>{};
+  }
+
+  // Addresses of the IAT slots importing function (by ordinal) from module.
+  std::vector<std::uintptr_t> Find(std::string const& module,
+                                   WORD ordinal) const
+  {
+    return Find(module, MakeOrdinalName(ordinal));
+  }
+
+  std::size_t GetNumImages() const noexcept
+  {
+    return images_.size();
+  }
+
+  std::size_t GetNumImports() const noexcept
+  {
+    return slots_.size();
+  }
+
+  void Clear()
+  {
+    images_.clear();
+    slots_.clear();
+  }
+
+private:
+  struct ImageInfo
+  {
+    std::size_t size;
+    DWORD time_stamp;
+    // Keys with at least one slot in this image, to make removal cheap.
+    std::vector<std::string> keys;
+  };
+
+  // Bounds checked reads of the bits of a PE image needed to walk its import
+  // directory. Malformed (or unreadable) images throw. Reads go through a
+  // page cache, as the import data is scattered across a handful of pages
+  // and a live reader costs a syscall per read.
+  class ImageParser
+  {
+  public:
+    ImageParser(ImageReader const& reader, std::size_t size)
+      : reader_{&reader}, size_{size}
+    {
+      if (Read<WORD>(0) != 0x5A4D)
+      {
+        ThrowInvalid("Invalid DOS header.");
+      }
+
+      nt_offset_ = Read<DWORD>(0x3C);
+      if (Read<DWORD>(nt_offset_) != 0x00004550)
+      {
+        ThrowInvalid("Invalid NT headers.");
+      }
+
+      // Optional header magic. Data directories start at a different offset,
+      // and thunks are a different size, for PE32 and PE32+.
+      std::size_t const opt_offset = nt_offset_ + 24;
+      WORD const magic = Read<WORD>(opt_offset);
+      if (magic == 0x10B)
+      {
+        is_64_ = false;
+      }
+      else if (magic == 0x20B)
+      {
+        is_64_ = true;
+      }
+      else
+      {
+        ThrowInvalid("Unknown optional header magic.");
+      }
+
+      std::size_t const num_dirs_offset = opt_offset + (is_64_ ? 108 : 92);
+      std::size_t const dirs_offset = num_dirs_offset + 4;
+      std::size_t const kImportDirIndex = 1;
+      if (Read<DWORD>(num_dirs_offset) > kImportDirIndex)
+      {
+        import_dir_rva_ = Read<DWORD>(dirs_offset + kImportDirIndex * 8);
+      }
+    }
+
+    template <typename Func> void ForEachImport(Func func) const
+    {
+      if (!import_dir_rva_)
+      {
+        return;
+      }
+
+      std::size_t const kDescSize = 20;
+      for (std::size_t desc = import_dir_rva_;; desc += kDescSize)
+      {
+        DWORD const orig_first_thunk = Read<DWORD>(desc);
+        DWORD const name = Read<DWORD>(desc + 12);
+        DWORD const first_thunk = Read<DWORD>(desc + 16);
+        // Same as the loader, which stops at the first entry with no name or
+        // no IAT.
+        if (!name || !first_thunk)
+        {
+          break;
+        }
+
+        // Without an INT the names are only in the IAT, which has been
+        // overwritten in a loaded image, so there's nothing to match on.
+        if (!orig_first_thunk)
+        {
+          continue;
+        }
+
+        std::string const module = ReadString(name);
+        std::size_t const thunk_size = is_64_ ? 8 : 4;
+        for (std::size_t i = 0;; ++i)
+        {
+          std::uint64_t const thunk =
+            is_64_ ? Read<std::uint64_t>(orig_first_thunk + i * thunk_size)
+                   : Read<DWORD>(orig_first_thunk + i * thunk_size);
+          if (!thunk)
+          {
+            break;
+          }
+
+          std::uint64_t const ordinal_flag =
+            is_64_ ? 0x8000000000000000ULL : 0x80000000ULL;
+          std::string const function =
+            (thunk & ordinal_flag)
+              ? MakeOrdinalName(static_cast<WORD>(thunk & 0xFFFF))
+              // Skip the hint.
+              : ReadString(static_cast<std::size_t>(thunk & 0x7FFFFFFF) + 2);
+          func(module,
+               function,
+               static_cast<DWORD>(first_thunk + i * thunk_size));
+        }
+      }
+    }
+
+  private:
+    template <typename T> T Read(std::size_t offset) const
+    {
+      if (offset > size_ || size_ - offset < sizeof(T))
+      {
+        ThrowInvalid("Read outside of image.");
+      }
+
+      T value;
+      auto const out = reinterpret_cast<std::uint8_t*>(&value);
+      for (std::size_t i = 0; i < sizeof(T);)
+      {
+        std::size_t const page_offset = (offset + i) % kImageReaderPageSize;
+        std::size_t const len =
+          (std::min)(sizeof(T) - i, kImageReaderPageSize - page_offset);
+        std::memcpy(out + i, GetPage(offset + i) + page_offset, len);
+        i += len;
+      }
+      return value;
+    }
+
+    std::string ReadString(std::size_t offset) const
+    {
+      if (offset >= size_)
+      {
+        ThrowInvalid("Read outside of image.");
+      }
+
+      std::string str;
+      while (offset < size_)
+      {
+        std::size_t const page_offset = offset % kImageReaderPageSize;
+        std::size_t const len =
+          (std::min)(kImageReaderPageSize - page_offset, size_ - offset);
+        auto const begin =
+          reinterpret_cast<char const*>(GetPage(offset) + page_offset);
+        auto const end = begin + len;
+        auto const terminator = std::find(begin, end, '\0');
+        str.append(begin, terminator);
+        if (terminator != end)
+        {
+          return str;
+        }
+        offset += len;
+      }
+
+      ThrowInvalid("Unterminated string.");
+      return str;
+    }
+
+    // The (possibly partial, at the end of the image) page holding offset.
+    std::uint8_t const* GetPage(std::size_t offset) const
+    {
+      std::size_t const page = offset - offset % kImageReaderPageSize;
+      auto iter = pages_.find(page);
+      if (iter == std::end(pages_))
+      {
+        std::vector<std::uint8_t> data(
+          (std::min)(kImageReaderPageSize, size_ - page));
+        if (!reader_->Read(page, data.data(), data.size()))
+        {
+          ThrowInvalid("Failed to read image.");
+        }
+        iter = pages_.emplace(page, std::move(data)).first;
+      }
+      return iter->second.data();
+    }
+
+    static void ThrowInvalid(char const* what)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{what});
+    }
+
+    ImageReader const* reader_;
+    std::size_t size_;
+    mutable std::unordered_map<std::size_t, std::vector<std::uint8_t>> pages_;
+    std::size_t nt_offset_{};
+    bool is_64_{};
+    DWORD import_dir_rva_{};
+  };
+
+  static bool IsInImage(std::uintptr_t address,
+                        std::uintptr_t base,
+                        std::size_t size) noexcept
+  {
+    return address >= base && address - base < size;
+  }
+
+  // Zero if the headers can't be read, which HasImage treats like any other
+  // value (the image will fail to parse again anyway).
+  static DWORD GetImageTimeStamp(ImageReader const& reader, std::size_t size)
+  {
+    DWORD nt_offset = 0;
+    if (size < 0x40 ||
+        !reader.Read(0x3C, &nt_offset, sizeof(nt_offset)) ||
+        nt_offset > size || size - nt_offset < 12)
+    {
+      return 0;
+    }
+
+    DWORD time_stamp = 0;
+    if (!reader.Read(nt_offset + 8, &time_stamp, sizeof(time_stamp)))
+    {
+      return 0;
+    }
+    return time_stamp;
+  }
+
+  static std::string MakeOrdinalName(WORD ordinal)
+  {
+    return "#" + std::to_string(ordinal);
+  }
+
+  static std::string MakeKey(std::string const& module,
+                             std::string const& function)
+  {
+    std::string key;
+    key.reserve(module.size() + function.size() + 1);
+    std::transform(std::begin(module),
+                   std::end(module),
+                   std::back_inserter(key),
+                   [](char c) {
+                     return (c >= 'a' && c <= 'z')
+                              ? static_cast<char>(c - 'a' + 'A')
+                              : c;
+                   });
+    key += '!';
+    key += function;
+    return key;
+  }
+
+  std::map<std::uintptr_t, ImageInfo> images_;
+  std::unordered_map<std::string, std::vector<std::uintptr_t>> slots_;
+};
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// Reads an image mapped in a (normally the current) process. Fails rather
+// than faulting if the image is unloaded under us.
+class ProcessImageReader : public ImageReader
+{
+public:
+  ProcessImageReader(Process const& process, std::uintptr_t base) noexcept
+    : process_{&process}, base_{base}
+  {
+  }
+
+  ProcessImageReader(Process&& process, std::uintptr_t base) = delete;
+
+  virtual bool
+    Read(std::size_t offset, void* data, std::size_t len) const override
+  {
+    SIZE_T bytes_read = 0;
+    return ::ReadProcessMemory(process_->GetHandle(),
+                               reinterpret_cast<LPCVOID>(base_ + offset),
+                               data,
+                               len,
+                               &bytes_read) &&
+           bytes_read == len;
+  }
+
+private:
+  Process const* process_;
+  std::uintptr_t base_;
+};
+
+// Index of every module loaded in the current process. Refresh only parses
+// modules which have been loaded (or replaced) since the last one, and drops
+// those which have been unloaded.
+class LocalImportIndex
+{
+public:
+  void Refresh(Process const& process)
+  {
+    ModuleList const modules{process};
+
+    std::lock_guard<std::mutex> const lock{mutex_};
+
+    std::vector<std::uintptr_t> loaded;
+    for (auto const& module : modules)
+    {
+      auto const base = reinterpret_cast<std::uintptr_t>(module.GetHandle());
+      ProcessImageReader const reader{process, base};
+      loaded.push_back(base);
+      if (!index_.HasImage(base, reader, module.GetSize()))
+      {
+        index_.AddImage(base, reader, module.GetSize());
+      }
+    }
+
+    std::sort(std::begin(loaded), std::end(loaded));
+    for (auto const base : index_.GetImages())
+    {
+      if (!std::binary_search(std::begin(loaded), std::end(loaded), base))
+      {
+        index_.RemoveImage(base);
+      }
+    }
+  }
+
+  std::vector<std::uintptr_t> Find(std::string const& module,
+                                   std::string const& function) const
+  {
+    std::lock_guard<std::mutex> const lock{mutex_};
+    return index_.Find(module, function);
+  }
+
+private:
+  mutable std::mutex mutex_;
+  ImportIndex index_;
+};
+
+inline LocalImportIndex& GetLocalImportIndex()
+{
+  static LocalImportIndex* const index = new LocalImportIndex{};
+  return *index;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+}
@@ -0,0 +1,546 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <hadesmem/config.hpp>
+
+// Minimal x86/x64 instruction decoder. Only works out what is needed to move
+// an instruction somewhere else: its length, where its displacement and
+// immediate are, whether it's RIP-relative, and what kind of relative branch
+// (if any) it is. No string formatting, no operand details beyond that.
+// Doesn't touch memory other than the buffer it's given, so it can be tested
+// on any OS.
+// Coverage compared to udis86 (which is what the patchers used before):
+// - EVEX (AVX-512) and XOP (AMD) encodings are rejected rather than decoded.
+//   udis86 doesn't know AVX-512 either, but does decode XOP.
+// - Only 32-bit and 64-bit code. udis86 also handles 16-bit mode.
+// - Undefined opcodes aren't detected in the 0F, 0F38 and 0F3A maps, so
+//   garbage may decode to some length where udis86 would report
+//   UD_Iinvalid. Only the one byte map is checked (and only for x64).
+// - No operand types, registers or mnemonics, so nothing can be formatted.
+
+namespace hadesmem
+{
+namespace detail
+{
+enum class InsnMode
+{
+  kX86,
+  kX64
+};
+
+enum class InsnBranch : std::uint8_t
+{
+  kNone,
+  // JMP rel8/rel32.
+  kJmp,
+  // Jcc rel8/rel32.
+  kJcc,
+  // CALL rel32.
+  kCall,
+  // LOOP, LOOPE, LOOPNE, JECXZ and JRCXZ (rel8 only).
+  kLoop,
+  // Relative, but can't be relocated (XBEGIN, 16-bit branches, etc.).
+  kUnsupported
+};
+
+enum class InsnMap : std::uint8_t
+{
+  kOneByte,
+  k0F,
+  k0F38,
+  k0F3A
+};
+
+struct InsnInfo
+{
+  std::uint8_t length;
+  // Offset of the opcode byte (i.e. the size of the prefixes, REX, VEX,
+  // etc).
+  std::uint8_t opcode_offset;
+  std::uint8_t opcode;
+  InsnMap map;
+  bool has_modrm;
+  std::uint8_t modrm;
+  std::uint8_t disp_offset;
+  std::uint8_t disp_size;
+  // For relative branches this is the displacement to the target.
+  std::uint8_t imm_offset;
+  std::uint8_t imm_size;
+  // Memory operand is [RIP+disp32].
+  bool rip_relative;
+  InsnBranch branch;
+  // Jcc condition code (the low nibble of the opcode).
+  std::uint8_t condition;
+};
+
+std::size_t const kMaxInsnLength = 15;
+
+namespace insn_decoder
+{
+inline bool HasModRmOneByte(std::uint8_t op) noexcept
+{
+  if (op < 0x40)
+  {
+    return (op & 7) < 4;
+  }
+
+  switch (op)
+  {
+  case 0x62:
+  case 0x63:
+  case 0x69:
+  case 0x6B:
+  case 0xC0:
+  case 0xC1:
+  case 0xC4:
+  case 0xC5:
+  case 0xC6:
+  case 0xC7:
+  case 0xF6:
+  case 0xF7:
+  case 0xFE:
+  case 0xFF:
+    return true;
+  default:
+    return (op >= 0x80 && op <= 0x8F) || (op >= 0xD0 && op <= 0xD3) ||
+           (op >= 0xD8 && op <= 0xDF);
+  }
+}
+
+inline bool HasModRm0F(std::uint8_t op) noexcept
+{
+  switch (op)
+  {
+  case 0x05:
+  case 0x06:
+  case 0x07:
+  case 0x08:
+  case 0x09:
+  case 0x0B:
+  case 0x0E:
+  case 0x77:
+  case 0xA0:
+  case 0xA1:
+  case 0xA2:
+  case 0xA8:
+  case 0xA9:
+  case 0xAA:
+    return false;
+  default:
+    return !(op >= 0x30 && op <= 0x37) && !(op >= 0x80 && op <= 0x8F) &&
+           !(op >= 0xC8 && op <= 0xCF);
+  }
+}
+
+inline bool HasImm8_0F(std::uint8_t op) noexcept
+{
+  switch (op)
+  {
+  case 0x0F:
+  case 0x70:
+  case 0x71:
+  case 0x72:
+  case 0x73:
+  case 0xA4:
+  case 0xAC:
+  case 0xBA:
+  case 0xC2:
+  case 0xC4:
+  case 0xC5:
+  case 0xC6:
+    return true;
+  default:
+    return false;
+  }
+}
+
+inline bool IsInvalidX64(std::uint8_t op) noexcept
+{
+  switch (op)
+  {
+  case 0x06:
+  case 0x07:
+  case 0x0E:
+  case 0x16:
+  case 0x17:
+  case 0x1E:
+  case 0x1F:
+  case 0x27:
+  case 0x2F:
+  case 0x37:
+  case 0x3F:
+  case 0x60:
+  case 0x61:
+  case 0x82:
+  case 0x9A:
+  case 0xD4:
+  case 0xD5:
+  case 0xD6:
+  case 0xEA:
+    return true;
+  default:
+    return false;
+  }
+}
+}
+
+// Returns false if the instruction is invalid, unsupported (e.g. EVEX or
+// XOP), or runs past the end of the buffer.
+inline bool DecodeInsn(std::uint8_t const* code,
+                       std::size_t size,
+                       InsnMode mode,
+                       InsnInfo& info) noexcept
+{
+  info = InsnInfo{};
+
+  bool const is_x64 = mode == InsnMode::kX64;
+  if (size > kMaxInsnLength)
+  {
+    size = kMaxInsnLength;
+  }
+
+  std::size_t pos = 0;
+  bool opsize16 = false;
+  bool addrsize = false;
+  bool rex_w = false;
+
+  for (;; ++pos)
+  {
+    if (pos >= size)
+    {
+      return false;
+    }
+
+    std::uint8_t const b = code[pos];
+    if (b == 0x66)
+    {
+      opsize16 = true;
+    }
+    else if (b == 0x67)
+    {
+      addrsize = true;
+    }
+    else if (b != 0xF0 && b != 0xF2 && b != 0xF3 && b != 0x2E && b != 0x36 &&
+             b != 0x3E && b != 0x26 && b != 0x64 && b != 0x65)
+    {
+      break;
+    }
+  }
+
+  // REX is only meaningful immediately before the opcode.
+  if (is_x64 && (code[pos] & 0xF0) == 0x40)
+  {
+    rex_w = (code[pos] & 0x08) != 0;
+    if (++pos >= size)
+    {
+      return false;
+    }
+  }
+
+  bool const addr16 = !is_x64 && addrsize;
+  bool vex = false;
+  std::uint8_t op = code[pos];
+  InsnMap map = InsnMap::kOneByte;
+
+  // VEX. Outside of long mode C4/C5 are LES/LDS unless the next byte would be
+  // a register operand.
+  if ((op == 0xC4 || op == 0xC5) && pos + 1 < size &&
+      (is_x64 || (code[pos + 1] & 0xC0) == 0xC0))
+  {
+    vex = true;
+    if (op == 0xC5)
+    {
+      map = InsnMap::k0F;
+      pos += 2;
+    }
+    else
+    {
+      if (pos + 2 >= size)
+      {
+        return false;
+      }
+
+      switch (code[pos + 1] & 0x1F)
+      {
+      case 1:
+        map = InsnMap::k0F;
+        break;
+      case 2:
+        map = InsnMap::k0F38;
+        break;
+      case 3:
+        map = InsnMap::k0F3A;
+        break;
+      default:
+        return false;
+      }
+      rex_w = (code[pos + 2] & 0x80) != 0;
+      pos += 3;
+    }
+  }
+  else if (op == 0x62 && is_x64)
+  {
+    // EVEX.
+    return false;
+  }
+  else if (op == 0x0F)
+  {
+    if (++pos >= size)
+    {
+      return false;
+    }
+
+    map = InsnMap::k0F;
+    if (code[pos] == 0x38 || code[pos] == 0x3A)
+    {
+      map = code[pos] == 0x38 ? InsnMap::k0F38 : InsnMap::k0F3A;
+      ++pos;
+    }
+  }
+
+  if (pos >= size)
+  {
+    return false;
+  }
+
+  op = code[pos];
+  info.opcode_offset = static_cast<std::uint8_t>(pos);
+  info.opcode = op;
+  info.map = map;
+  ++pos;
+
+  if (map == InsnMap::kOneByte && is_x64 && insn_decoder::IsInvalidX64(op))
+  {
+    return false;
+  }
+
+  std::size_t const size_z = opsize16 ? 2 : 4;
+  std::size_t imm_size = 0;
+  bool has_modrm = false;
+
+  switch (map)
+  {
+  case InsnMap::kOneByte:
+    has_modrm = insn_decoder::HasModRmOneByte(op);
+    if (op < 0x40)
+    {
+      imm_size = (op & 7) == 4 ? 1 : ((op & 7) == 5 ? size_z : 0);
+    }
+    else if (op >= 0x70 && op <= 0x7F)
+    {
+      imm_size = 1;
+      info.branch = InsnBranch::kJcc;
+      info.condition = op & 0x0F;
+    }
+    else if (op >= 0xB0 && op <= 0xB7)
+    {
+      imm_size = 1;
+    }
+    else if (op >= 0xB8 && op <= 0xBF)
+    {
+      imm_size = rex_w ? 8 : size_z;
+    }
+    else if (op >= 0xA0 && op <= 0xA3)
+    {
+      // moffs.
+      imm_size = is_x64 ? (addrsize ? 4 : 8) : (addrsize ? 2 : 4);
+    }
+    else if (op >= 0xE0 && op <= 0xE3)
+    {
+      imm_size = 1;
+      info.branch = InsnBranch::kLoop;
+    }
+    else
+    {
+      switch (op)
+      {
+      case 0x68:
+      case 0x69:
+      case 0x81:
+      case 0xA9:
+      case 0xC7:
+        imm_size = size_z;
+        break;
+      case 0x6A:
+      case 0x6B:
+      case 0x80:
+      case 0x82:
+      case 0x83:
+      case 0xA8:
+      case 0xC0:
+      case 0xC1:
+      case 0xC6:
+      case 0xCD:
+      case 0xD4:
+      case 0xD5:
+      case 0xE4:
+      case 0xE5:
+      case 0xE6:
+      case 0xE7:
+        imm_size = 1;
+        break;
+      case 0xC2:
+      case 0xCA:
+        imm_size = 2;
+        break;
+      case 0xC8:
+        imm_size = 3;
+        break;
+      case 0x9A:
+      case 0xEA:
+        imm_size = size_z + 2;
+        break;
+      case 0xE8:
+      case 0xE9:
+        imm_size = is_x64 ? 4 : size_z;
+        info.branch = op == 0xE8 ? InsnBranch::kCall : InsnBranch::kJmp;
+        if (opsize16)
+        {
+          info.branch = InsnBranch::kUnsupported;
+        }
+        break;
+      case 0xEB:
+        imm_size = 1;
+        info.branch = InsnBranch::kJmp;
+        break;
+      default:
+        break;
+      }
+    }
+    break;
+
+  case InsnMap::k0F:
+    if (vex)
+    {
+      // VZEROUPPER/VZEROALL.
+      has_modrm = op != 0x77;
+      imm_size =
+        (op >= 0x70 && op <= 0x73) || (op >= 0xC4 && op <= 0xC6) || op == 0xC2
+          ? 1
+          : 0;
+    }
+    else
+    {
+      has_modrm = insn_decoder::HasModRm0F(op);
+      imm_size = insn_decoder::HasImm8_0F(op) ? 1 : 0;
+      if (op >= 0x80 && op <= 0x8F)
+      {
+        imm_size = is_x64 ? 4 : size_z;
+        info.branch =
+          opsize16 ? InsnBranch::kUnsupported : InsnBranch::kJcc;
+        info.condition = op & 0x0F;
+      }
+    }
+    break;
+
+  case InsnMap::k0F38:
+    has_modrm = true;
+    break;
+
+  case InsnMap::k0F3A:
+    has_modrm = true;
+    imm_size = 1;
+    break;
+  }
+
+  if (has_modrm)
+  {
+    if (pos >= size)
+    {
+      return false;
+    }
+
+    std::uint8_t const modrm = code[pos++];
+    std::uint8_t const mod = modrm >> 6;
+    std::uint8_t const reg = (modrm >> 3) & 7;
+    std::uint8_t const rm = modrm & 7;
+    info.has_modrm = true;
+    info.modrm = modrm;
+
+    if (map == InsnMap::kOneByte)
+    {
+      // XOP. POP r/m is the only thing 8F encodes.
+      if (op == 0x8F && reg != 0)
+      {
+        return false;
+      }
+
+      if ((op == 0xF6 || op == 0xF7) && reg < 2)
+      {
+        imm_size = op == 0xF6 ? 1 : size_z;
+      }
+
+      // XBEGIN.
+      if (op == 0xC7 && modrm == 0xF8)
+      {
+        info.branch = InsnBranch::kUnsupported;
+      }
+    }
+
+    std::size_t disp_size = 0;
+    if (addr16)
+    {
+      if ((mod == 0 && rm == 6) || mod == 2)
+      {
+        disp_size = 2;
+      }
+      else if (mod == 1)
+      {
+        disp_size = 1;
+      }
+    }
+    else if (mod != 3)
+    {
+      if (rm == 4)
+      {
+        if (pos >= size)
+        {
+          return false;
+        }
+
+        std::uint8_t const sib = code[pos++];
+        if (mod == 0 && (sib & 7) == 5)
+        {
+          disp_size = 4;
+        }
+      }
+
+      if (mod == 0 && rm == 5)
+      {
+        disp_size = 4;
+        info.rip_relative = is_x64;
+      }
+      else if (mod == 1)
+      {
+        disp_size = 1;
+      }
+      else if (mod == 2)
+      {
+        disp_size = 4;
+      }
+    }
+
+    info.disp_offset = static_cast<std::uint8_t>(pos);
+    info.disp_size = static_cast<std::uint8_t>(disp_size);
+    pos += disp_size;
+  }
+
+  info.imm_offset = static_cast<std::uint8_t>(pos);
+  info.imm_size = static_cast<std::uint8_t>(imm_size);
+  pos += imm_size;
+
+  if (pos > size)
+  {
+    return false;
+  }
+
+  info.length = static_cast<std::uint8_t>(pos);
+  return true;
+}
+}
+}
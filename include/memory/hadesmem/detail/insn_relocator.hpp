@@ -0,0 +1,446 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/disassembler.hpp>
+#include <hadesmem/detail/patch_ip_map.hpp>
+#include <hadesmem/error.hpp>
+
+// Moves whole instructions from the start of a function into a trampoline,
+// followed by a jump back to the rest of the function.
+// Anything which depends on where it executes is rewritten:
+//   Relative JMP, CALL and Jcc (rel8 or rel32) are rewritten to rel32, or to
+//     an absolute form if the target is out of range of the trampoline.
+//   LOOP/JECXZ/JRCXZ (which only have a rel8 form) branch over a jump to the
+//     original target.
+//   Any other RIP-relative memory operand has its displacement adjusted. JMP
+//     and CALL through a RIP-relative pointer (e.g. a hook chain) which can't
+//     be reached any more are resolved to an absolute branch to the pointer's
+//     current value instead.
+//   Branches to an instruction which is itself being relocated are pointed
+//     at its copy, as the original is about to be overwritten.
+// This works on bytes and addresses only, so it can be tested on any OS.
+
+namespace hadesmem
+{
+namespace detail
+{
+struct RelocatedCode
+{
+  std::vector<std::uint8_t> code;
+  // Number of bytes relocated from the source. Always whole instructions,
+  // so may be more than was asked for.
+  std::size_t source_size;
+  PatchIpMap ip_map;
+};
+
+namespace insn_relocator
+{
+// JMP QWORD PTR [RIP+0] followed by the target.
+std::size_t const kAbsJmpSize = 14;
+// CALL QWORD PTR [RIP+2], JMP SHORT +8, then the target.
+std::size_t const kAbsCallSize = 16;
+std::size_t const kRel32JmpSize = 5;
+std::size_t const kRel32JccSize = 6;
+
+struct Insn
+{
+  InsnRecord info;
+  std::size_t source_offset;
+  std::size_t dest_offset;
+  std::size_t dest_size;
+  std::uint64_t target;
+  bool internal;
+  std::uint64_t internal_target;
+  // JMP or CALL through a RIP-relative pointer at target. Resolved to a
+  // direct branch if the pointer is out of range of the destination.
+  InsnBranch indirect;
+};
+
+// Reads the pointer at address, to resolve an indirect branch.
+using PointerReader = std::function<std::uint64_t(std::uint64_t address)>;
+
+
+inline bool FitsRel32(std::int64_t value) noexcept
+{
+  return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+inline std::int64_t ReadSigned(std::uint8_t const* p, std::size_t size)
+{
+  switch (size)
+  {
+  case 1:
+    return static_cast<std::int8_t>(p[0]);
+  case 2:
+  {
+    std::int16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  case 4:
+  {
+    std::int32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  default:
+    HADESMEM_DETAIL_ASSERT(false);
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"Invalid operand size."});
+  }
+}
+
+// JMP or CALL through a RIP-relative pointer, i.e. FF /4 or FF /2 with no
+// immediate.
+inline InsnBranch GetIndirectBranch(InsnRecord const& info,
+                                    std::uint8_t const* raw) noexcept
+{
+  if (!info.rip_relative || info.rel_offset < 2 ||
+      info.length != info.rel_offset + 4u || raw[info.rel_offset - 2] != 0xFF ||
+      (info.rel_offset >= 3 && raw[info.rel_offset - 3] == 0x0F))
+  {
+    return InsnBranch::kNone;
+  }
+
+  switch ((raw[info.rel_offset - 1] >> 3) & 7)
+  {
+  case 2:
+    return InsnBranch::kCall;
+  case 4:
+    return InsnBranch::kJmp;
+  default:
+    return InsnBranch::kNone;
+  }
+}
+
+inline void AppendU32(std::vector<std::uint8_t>& code, std::uint32_t value)
+{
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    code.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+inline void AppendU64(std::vector<std::uint8_t>& code, std::uint64_t value)
+{
+  AppendU32(code, static_cast<std::uint32_t>(value));
+  AppendU32(code, static_cast<std::uint32_t>(value >> 32));
+}
+
+class Relocator
+{
+public:
+  Relocator(InsnMode mode, std::uint64_t source, std::uint64_t dest)
+    : mode_{mode}, source_{source}, dest_{dest}
+  {
+  }
+
+  // Whether a rel32 at the end of an instruction ending at dest_end can reach
+  // target. Always true outside of long mode, as the address space wraps.
+  bool IsNear(std::size_t dest_end, std::uint64_t target) const noexcept
+  {
+    return mode_ == InsnMode::kX86 ||
+           FitsRel32(static_cast<std::int64_t>(target - (dest_ + dest_end)));
+  }
+
+  std::uint32_t GetRel32(std::size_t dest_end, std::uint64_t target) const
+    noexcept
+  {
+    return static_cast<std::uint32_t>(target - (dest_ + dest_end));
+  }
+
+  std::uint64_t Mask(std::uint64_t address) const noexcept
+  {
+    return mode_ == InsnMode::kX86 ? (address & 0xFFFFFFFFULL) : address;
+  }
+
+  std::size_t GetJmpSize(std::size_t dest_offset, std::uint64_t target) const
+  {
+    return IsNear(dest_offset + kRel32JmpSize, target) ? kRel32JmpSize
+                                                       : kAbsJmpSize;
+  }
+
+  void EmitJmp(std::vector<std::uint8_t>& code, std::uint64_t target) const
+  {
+    if (IsNear(code.size() + kRel32JmpSize, target))
+    {
+      code.push_back(0xE9);
+      AppendU32(code, GetRel32(code.size() + 4, target));
+    }
+    else
+    {
+      code.insert(std::end(code), {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00});
+      AppendU64(code, target);
+    }
+  }
+
+  std::size_t GetSize(Insn const& insn) const
+  {
+    // Prefixes and opcode.
+    std::size_t const prefix_size = insn.info.rel_offset - 1;
+    switch (insn.info.branch)
+    {
+    case InsnBranch::kJmp:
+      return GetJmpSize(insn.dest_offset, insn.target);
+
+    case InsnBranch::kCall:
+      return IsNear(insn.dest_offset + kRel32JmpSize, insn.target)
+               ? kRel32JmpSize
+               : kAbsCallSize;
+
+    case InsnBranch::kJcc:
+      return IsNear(insn.dest_offset + kRel32JccSize, insn.target)
+               ? kRel32JccSize
+               : 2 + kAbsJmpSize;
+
+    case InsnBranch::kLoop:
+      return prefix_size + 4 +
+             GetJmpSize(insn.dest_offset + prefix_size + 4, insn.target);
+
+    default:
+      return insn.info.length;
+    }
+  }
+
+  void Emit(std::vector<std::uint8_t>& code,
+            Insn const& insn,
+            std::uint8_t const* raw) const
+  {
+    HADESMEM_DETAIL_ASSERT(code.size() == insn.dest_offset);
+
+    InsnRecord const& info = insn.info;
+    switch (info.branch)
+    {
+    case InsnBranch::kJmp:
+      EmitJmp(code, insn.target);
+      break;
+
+    case InsnBranch::kCall:
+      if (IsNear(code.size() + kRel32JmpSize, insn.target))
+      {
+        code.push_back(0xE8);
+        AppendU32(code, GetRel32(code.size() + 4, insn.target));
+      }
+      else
+      {
+        code.insert(std::end(code),
+                    {0xFF, 0x15, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x08});
+        AppendU64(code, insn.target);
+      }
+      break;
+
+    case InsnBranch::kJcc:
+      if (IsNear(code.size() + kRel32JccSize, insn.target))
+      {
+        code.push_back(0x0F);
+        code.push_back(static_cast<std::uint8_t>(0x80 | info.condition));
+        AppendU32(code, GetRel32(code.size() + 4, insn.target));
+      }
+      else
+      {
+        // Inverted condition over an absolute jump. Always the absolute form,
+        // as that's what the skip (and GetSize) assumed, even if the target
+        // happens to be in range from the end of the short Jcc.
+        code.push_back(
+          static_cast<std::uint8_t>(0x70 | (info.condition ^ 1)));
+        code.push_back(static_cast<std::uint8_t>(kAbsJmpSize));
+        code.insert(std::end(code), {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00});
+        AppendU64(code, insn.target);
+      }
+      break;
+
+    case InsnBranch::kLoop:
+    {
+      // Prefixes are kept, as an address size prefix changes which counter
+      // register is used.
+      code.insert(std::end(code), raw, raw + info.rel_offset);
+      code.push_back(0x02);
+      std::size_t const jmp_size =
+        GetJmpSize(code.size() + 2, insn.target);
+      code.push_back(0xEB);
+      code.push_back(static_cast<std::uint8_t>(jmp_size));
+      EmitJmp(code, insn.target);
+      break;
+    }
+
+    default:
+      code.insert(std::end(code), raw, raw + info.length);
+      if (info.rip_relative)
+      {
+        std::uint64_t const end = source_ + insn.source_offset + info.length;
+        std::uint64_t const address =
+          end + ReadSigned(raw + info.rel_offset, info.rel_size);
+        std::int64_t const disp = static_cast<std::int64_t>(
+          address - (dest_ + insn.dest_offset + info.length));
+        if (!FitsRel32(disp))
+        {
+          HADESMEM_DETAIL_THROW_EXCEPTION(
+            Error{} << ErrorString{
+              "RIP-relative operand is out of range of the destination."});
+        }
+
+        auto const disp32 = static_cast<std::int32_t>(disp);
+        std::memcpy(
+          &code[insn.dest_offset + info.rel_offset], &disp32, sizeof(disp32));
+      }
+      break;
+    }
+
+    HADESMEM_DETAIL_ASSERT(code.size() == insn.dest_offset + insn.dest_size);
+  }
+
+private:
+  InsnMode mode_;
+  std::uint64_t source_;
+  std::uint64_t dest_;
+};
+}
+
+// Relocates already decoded instructions from code (which lives at source),
+// for execution at dest. Without read_pointer, an indirect branch whose
+// pointer is out of range of dest can't be relocated.
+inline RelocatedCode RelocateCode(
+  std::uint8_t const* code,
+  std::vector<InsnRecord> const& records,
+  std::uint64_t source,
+  std::uint64_t dest,
+  InsnMode mode,
+  insn_relocator::PointerReader const& read_pointer = nullptr)
+{
+  insn_relocator::Relocator const relocator{mode, source, dest};
+
+  std::vector<insn_relocator::Insn> insns;
+  insns.reserve(records.size());
+  std::size_t source_size = 0;
+  for (auto const& record : records)
+  {
+    insn_relocator::Insn insn{};
+    insn.info = record;
+    insn.source_offset = source_size;
+
+    if (insn.info.branch == InsnBranch::kUnsupported)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Unsupported relative instruction."});
+    }
+
+    insn.indirect =
+      insn_relocator::GetIndirectBranch(insn.info, code + source_size);
+    if (insn.info.branch != InsnBranch::kNone ||
+        insn.indirect != InsnBranch::kNone)
+    {
+      std::uint64_t const end = source + source_size + insn.info.length;
+      insn.target = relocator.Mask(
+        end + insn_relocator::ReadSigned(code + source_size +
+                                           insn.info.rel_offset,
+                                         insn.info.rel_size));
+    }
+
+    source_size += insn.info.length;
+    insns.push_back(insn);
+  }
+
+  RelocatedCode relocated;
+  relocated.source_size = source_size;
+
+  // Branches back into the relocated instructions have to go to the copy, so
+  // work out where everything goes first. Those are always in range of a
+  // rel32, so their size doesn't depend on where anything else goes.
+  std::size_t dest_size = 0;
+  for (auto& insn : insns)
+  {
+    if (insn.indirect != InsnBranch::kNone &&
+        !insn_relocator::FitsRel32(static_cast<std::int64_t>(
+          insn.target - (dest + dest_size + insn.info.length))))
+    {
+      if (!read_pointer)
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{
+            "RIP-relative operand is out of range of the destination."});
+      }
+
+      // Branch to wherever the pointer currently points, like any other
+      // relative branch.
+      insn.info.branch = insn.indirect;
+      insn.target = read_pointer(insn.target);
+    }
+
+    if (insn.info.branch != InsnBranch::kNone && insn.target >= source &&
+        insn.target < source + source_size)
+    {
+      insn.internal = true;
+      insn.internal_target = insn.target;
+      // Placeholder which is definitely near, fixed up below.
+      insn.target = dest + dest_size;
+    }
+
+    insn.dest_offset = dest_size;
+    insn.dest_size = relocator.GetSize(insn);
+    relocated.ip_map.Add(insn.source_offset, insn.dest_offset);
+    dest_size += insn.dest_size;
+  }
+
+  for (std::size_t i = 0; i < insns.size(); ++i)
+  {
+    auto& insn = insns[i];
+    if (!insn.internal)
+    {
+      continue;
+    }
+
+    std::size_t target_offset = 0;
+    if (!relocated.ip_map.Remap(
+          static_cast<std::size_t>(insn.internal_target - source),
+          target_offset))
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Branch into the middle of an instruction."});
+    }
+
+    insn.target = dest + target_offset;
+  }
+
+  relocated.code.reserve(dest_size + insn_relocator::kAbsJmpSize);
+  for (auto const& insn : insns)
+  {
+    relocator.Emit(relocated.code, insn, code + insn.source_offset);
+  }
+
+  relocator.EmitJmp(relocated.code, source + source_size);
+
+  return relocated;
+}
+
+// Relocates instructions from code (which lives at source) until at least
+// min_size bytes have been covered, for execution at dest.
+inline RelocatedCode RelocateCode(std::uint8_t const* code,
+                                  std::size_t code_size,
+                                  std::uint64_t source,
+                                  std::uint64_t dest,
+                                  std::size_t min_size,
+                                  InsnMode mode,
+                                  insn_relocator::PointerReader const&
+                                    read_pointer = nullptr)
+{
+  InsnDecoderDisassembler const disassembler{mode};
+  return RelocateCode(
+    code,
+    disassembler.DecodeUntil(code, code_size, source, min_size),
+    source,
+    dest,
+    mode,
+    read_pointer);
+}
+}
+}
@@ -0,0 +1,422 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/error.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
+
+// Translates /proc/<pid>/maps into the MEMORY_BASIC_INFORMATION model used by
+// the rest of the library. The translation is necessarily approximate:
+// - Gaps between mappings are reported as MEM_FREE regions, so walking the
+// list covers the whole user address space just like VirtualQueryEx does.
+// - Anonymous PROT_NONE mappings are reported as MEM_RESERVE, as that's how
+// reservations are done on Linux.
+// - File mappings are MEM_IMAGE if any mapping of the same file is executable
+// (i.e. it's a loaded ELF object), and MEM_MAPPED otherwise.
+// - The allocation base of a file mapping is the preceding mapping of the same
+// file at offset zero (i.e. the load base of the object).
+
+namespace hadesmem
+{
+namespace detail
+{
+struct LinuxMapsEntry
+{
+  std::uintptr_t start;
+  std::uintptr_t end;
+  std::uint64_t offset;
+  bool read;
+  bool write;
+  bool execute;
+  bool shared;
+  std::string path;
+};
+
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+// Default TASK_SIZE for 4-level paging. Anything mapped above the canonical
+// hole (i.e. [vsyscall]) is kernel memory and can't be accessed remotely.
+std::uintptr_t const kLinuxUserAddressEnd = 0x800000000000ULL;
+std::uintptr_t const kLinuxKernelAddressStart = 0xFFFF800000000000ULL;
+#elif defined(HADESMEM_DETAIL_ARCH_X86)
+std::uintptr_t const kLinuxUserAddressEnd = 0xC0000000UL;
+std::uintptr_t const kLinuxKernelAddressStart = 0xFFFFFFFFUL;
+#endif
+
+inline bool ParseMapsLine(std::string const& line, LinuxMapsEntry& entry)
+{
+  // Format: "start-end perms offset dev inode [path]"
+  char const* cur = line.c_str();
+  char* next = nullptr;
+
+  entry.start = static_cast<std::uintptr_t>(std::strtoull(cur, &next, 16));
+  if (next == cur || *next != '-')
+  {
+    return false;
+  }
+  cur = next + 1;
+
+  entry.end = static_cast<std::uintptr_t>(std::strtoull(cur, &next, 16));
+  if (next == cur || *next != ' ' || entry.end <= entry.start)
+  {
+    return false;
+  }
+  cur = next + 1;
+
+  if (std::char_traits<char>::length(cur) < 5 || cur[4] != ' ')
+  {
+    return false;
+  }
+  entry.read = cur[0] == 'r';
+  entry.write = cur[1] == 'w';
+  entry.execute = cur[2] == 'x';
+  entry.shared = cur[3] == 's';
+  cur += 5;
+
+  entry.offset = std::strtoull(cur, &next, 16);
+  if (next == cur)
+  {
+    return false;
+  }
+  cur = next;
+
+  // Skip the device and inode fields.
+  for (int i = 0; i < 2; ++i)
+  {
+    while (*cur == ' ')
+    {
+      ++cur;
+    }
+    while (*cur && *cur != ' ')
+    {
+      ++cur;
+    }
+  }
+
+  while (*cur == ' ')
+  {
+    ++cur;
+  }
+  entry.path = cur;
+
+  return true;
+}
+
+inline DWORD LinuxMapsEntryToProtect(LinuxMapsEntry const& entry) noexcept
+{
+  if (entry.execute)
+  {
+    if (entry.write)
+    {
+      return PAGE_EXECUTE_READWRITE;
+    }
+
+    return entry.read ? PAGE_EXECUTE_READ : PAGE_EXECUTE;
+  }
+
+  if (entry.write)
+  {
+    return PAGE_READWRITE;
+  }
+
+  return entry.read ? PAGE_READONLY : PAGE_NOACCESS;
+}
+
+inline bool IsLinuxMapsEntryFile(LinuxMapsEntry const& entry) noexcept
+{
+  return !entry.path.empty() && entry.path[0] == '/';
+}
+
+// Replaces the contents of regions (and images, which is scratch space) with
+// the translation of [first, last), so callers which keep both around
+// don't allocate once they have grown to fit.
+inline void LinuxMapsToRegions(LinuxMapsEntry const* first,
+                               LinuxMapsEntry const* last,
+                               std::vector<MEMORY_BASIC_INFORMATION>& regions,
+                               std::vector<std::string const*>& images)
+{
+  auto const less_path = [](std::string const* lhs, std::string const* rhs)
+  {
+    return *lhs < *rhs;
+  };
+  images.clear();
+  for (auto entry = first; entry != last; ++entry)
+  {
+    if ((IsLinuxMapsEntryFile(*entry) && entry->execute) ||
+        entry->path == "[vdso]")
+    {
+      images.push_back(&entry->path);
+    }
+  }
+  std::sort(std::begin(images), std::end(images), less_path);
+
+  regions.clear();
+  regions.reserve(static_cast<std::size_t>(last - first) * 2 + 1);
+
+  auto const add_free = [&](std::uintptr_t start, std::uintptr_t end)
+  {
+    if (start >= end)
+    {
+      return;
+    }
+
+    MEMORY_BASIC_INFORMATION mbi{};
+    mbi.BaseAddress = reinterpret_cast<PVOID>(start);
+    mbi.RegionSize = end - start;
+    mbi.State = MEM_FREE;
+    mbi.Protect = PAGE_NOACCESS;
+    regions.push_back(mbi);
+  };
+
+  std::uintptr_t prev_end = 0;
+  LinuxMapsEntry const* alloc_base = nullptr;
+  for (auto iter = first; iter != last; ++iter)
+  {
+    auto const& entry = *iter;
+    if (entry.start >= kLinuxKernelAddressStart || entry.start < prev_end)
+    {
+      continue;
+    }
+
+    add_free(prev_end, entry.start);
+
+    DWORD const protect = LinuxMapsEntryToProtect(entry);
+    bool const is_file = IsLinuxMapsEntryFile(entry);
+
+    if (!alloc_base || entry.path != alloc_base->path ||
+        (is_file && entry.offset == 0) || !is_file)
+    {
+      alloc_base = &entry;
+    }
+
+    MEMORY_BASIC_INFORMATION mbi{};
+    mbi.BaseAddress = reinterpret_cast<PVOID>(entry.start);
+    mbi.AllocationBase = reinterpret_cast<PVOID>(alloc_base->start);
+    mbi.AllocationProtect = LinuxMapsEntryToProtect(*alloc_base);
+    mbi.RegionSize = entry.end - entry.start;
+    mbi.State =
+      (!is_file && protect == PAGE_NOACCESS) ? MEM_RESERVE : MEM_COMMIT;
+    mbi.Protect = protect;
+    if (std::binary_search(
+          std::begin(images), std::end(images), &entry.path, less_path))
+    {
+      mbi.Type = MEM_IMAGE;
+    }
+    else if (is_file || entry.shared)
+    {
+      mbi.Type = MEM_MAPPED;
+    }
+    else
+    {
+      mbi.Type = MEM_PRIVATE;
+    }
+    regions.push_back(mbi);
+
+    prev_end = entry.end;
+  }
+
+  add_free(prev_end, (std::max)(prev_end, kLinuxUserAddressEnd));
+}
+
+inline std::vector<MEMORY_BASIC_INFORMATION>
+  LinuxMapsToRegions(std::vector<LinuxMapsEntry> const& entries)
+{
+  std::vector<MEMORY_BASIC_INFORMATION> regions;
+  std::vector<std::string const*> images;
+  LinuxMapsToRegions(
+    entries.data(), entries.data() + entries.size(), regions, images);
+  return regions;
+}
+
+inline std::vector<MEMORY_BASIC_INFORMATION> ParseLinuxMaps(std::istream& in)
+{
+  std::vector<LinuxMapsEntry> entries;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    LinuxMapsEntry entry{};
+    if (!ParseMapsLine(line, entry))
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Invalid line in maps file."});
+    }
+    entries.emplace_back(std::move(entry));
+  }
+
+  return LinuxMapsToRegions(entries);
+}
+
+inline std::vector<MEMORY_BASIC_INFORMATION> QueryLinuxMaps(DWORD pid)
+{
+  std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+  if (!maps)
+  {
+    int const last_error = errno;
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"Failed to open maps file."}
+                                    << ErrorCodeErrno{last_error});
+  }
+
+  return ParseLinuxMaps(maps);
+}
+
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+
+// Reads and translates a process's maps file into storage which is reused
+// across calls, so once it has grown to fit the target's address space
+// reading it again doesn't allocate.
+class LinuxMapsReader
+{
+public:
+  // The result is only valid until the next call.
+  std::vector<MEMORY_BASIC_INFORMATION> const& Read(DWORD pid)
+  {
+    std::size_t const len = ReadFile(pid);
+
+    std::size_t num_entries = 0;
+    std::size_t pos = 0;
+    while (pos < len)
+    {
+      std::size_t line_end = buf_.find('\n', pos);
+      if (line_end == std::string::npos || line_end > len)
+      {
+        line_end = len;
+      }
+
+      line_.assign(buf_, pos, line_end - pos);
+      if (entries_.size() == num_entries)
+      {
+        entries_.emplace_back();
+      }
+      if (!ParseMapsLine(line_, entries_[num_entries]))
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"Invalid line in maps file."});
+      }
+      ++num_entries;
+
+      pos = line_end + 1;
+    }
+
+    LinuxMapsToRegions(
+      entries_.data(), entries_.data() + num_entries, regions_, images_);
+    return regions_;
+  }
+
+private:
+  std::size_t ReadFile(DWORD pid)
+  {
+    // Not std::to_string, so the path doesn't allocate either.
+    char path[32];
+    std::snprintf(
+      path, sizeof(path), "/proc/%lu/maps", static_cast<unsigned long>(pid));
+    int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+      int const last_error = errno;
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Failed to open maps file."}
+                << ErrorCodeErrno{last_error});
+    }
+
+    // The file is generated on the fly and its size isn't known up front.
+    if (buf_.empty())
+    {
+      buf_.resize(0x10000);
+    }
+
+    std::size_t len = 0;
+    int last_error = 0;
+    for (;;)
+    {
+      if (len == buf_.size())
+      {
+        buf_.resize(buf_.size() * 2);
+      }
+
+      ::ssize_t const bytes_read = ::read(fd, &buf_[len], buf_.size() - len);
+      if (bytes_read == -1)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+
+        last_error = errno;
+        break;
+      }
+
+      if (!bytes_read)
+      {
+        break;
+      }
+
+      len += static_cast<std::size_t>(bytes_read);
+    }
+
+    ::close(fd);
+
+    if (last_error)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Failed to read maps file."}
+                << ErrorCodeErrno{last_error});
+    }
+
+    return len;
+  }
+
+  std::string buf_;
+  std::string line_;
+  std::vector<LinuxMapsEntry> entries_;
+  std::vector<std::string const*> images_;
+  std::vector<MEMORY_BASIC_INFORMATION> regions_;
+};
+
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
+
+inline MEMORY_BASIC_INFORMATION
+  FindLinuxRegion(std::vector<MEMORY_BASIC_INFORMATION> const& regions,
+                  void const* address)
+{
+  auto const addr = reinterpret_cast<std::uintptr_t>(address);
+  auto const iter = std::upper_bound(
+    std::begin(regions),
+    std::end(regions),
+    addr,
+    [](std::uintptr_t a, MEMORY_BASIC_INFORMATION const& mbi)
+    {
+      return a < reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+    });
+  if (iter == std::begin(regions) ||
+      addr - reinterpret_cast<std::uintptr_t>((iter - 1)->BaseAddress) >=
+        (iter - 1)->RegionSize)
+  {
+    // Mirror VirtualQueryEx, which fails with ERROR_INVALID_PARAMETER for
+    // addresses outside of the user address space. Region walkers rely on
+    // this to detect the end of the address space.
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Address outside of user address space."}
+              << ErrorCodeWinLast{ERROR_INVALID_PARAMETER});
+  }
+
+  return *(iter - 1);
+}
+}
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// The subset of the Win32 vocabulary (types, protection and state flags, error
+// codes) used by the portable core. Providing these on Linux lets the Linux
+// backend share signatures and region metadata with the Windows backend (e.g.
+// a Region on Linux reports PAGE_EXECUTE_READ and MEM_IMAGE for the text
+// segment of a shared object) instead of forking the public interface.
+
+// TODO: Move these into a namespace once the rest of the codebase stops
+// relying on the Win32 names being global.
+
+using BYTE = std::uint8_t;
+using PBYTE = BYTE*;
+using WORD = std::uint16_t;
+using DWORD = std::uint32_t;
+using PDWORD = DWORD*;
+using DWORD32 = std::uint32_t;
+using DWORD64 = std::uint64_t;
+using BOOL = std::int32_t;
+using LONG = std::int32_t;
+using ULONG = std::uint32_t;
+using ULONG_PTR = std::uintptr_t;
+using DWORD_PTR = std::uintptr_t;
+using SIZE_T = std::size_t;
+using PVOID = void*;
+using LPVOID = void*;
+using LPCVOID = void const*;
+using HRESULT = std::int32_t;
+using NTSTATUS = std::int32_t;
+
+struct MEMORY_BASIC_INFORMATION
+{
+  PVOID BaseAddress;
+  PVOID AllocationBase;
+  DWORD AllocationProtect;
+  SIZE_T RegionSize;
+  DWORD State;
+  DWORD Protect;
+  DWORD Type;
+};
+
+#define PAGE_NOACCESS 0x01
+#define PAGE_READONLY 0x02
+#define PAGE_READWRITE 0x04
+#define PAGE_WRITECOPY 0x08
+#define PAGE_EXECUTE 0x10
+#define PAGE_EXECUTE_READ 0x20
+#define PAGE_EXECUTE_READWRITE 0x40
+#define PAGE_EXECUTE_WRITECOPY 0x80
+#define PAGE_GUARD 0x100
+#define PAGE_NOCACHE 0x200
+#define PAGE_WRITECOMBINE 0x400
+
+#define MEM_COMMIT 0x1000
+#define MEM_RESERVE 0x2000
+#define MEM_FREE 0x10000
+#define MEM_PRIVATE 0x20000
+#define MEM_MAPPED 0x40000
+#define MEM_IMAGE 0x1000000
+
+#define ERROR_ACCESS_DENIED 5L
+#define ERROR_INVALID_PARAMETER 87L
+
+#if defined(__i386__)
+#define __cdecl __attribute__((cdecl))
+#define __stdcall __attribute__((stdcall))
+#define __fastcall __attribute__((fastcall))
+#endif // #if defined(__i386__)
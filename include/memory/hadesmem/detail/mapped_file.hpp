@@ -0,0 +1,346 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <hadesmem/config.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <winioctl.h>
+
+#include <hadesmem/detail/smart_handle.hpp>
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hadesmem/detail/str_conv.hpp>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/error.hpp>
+
+namespace hadesmem
+{
+namespace detail
+{
+// A whole-file mapping. Files created through Create are sparse (explicitly
+// on Windows, implicitly on Linux), so pages which are never written don't
+// take up any space on disk.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+
+  MappedFile(MappedFile const& other) = delete;
+
+  MappedFile& operator=(MappedFile const& other) = delete;
+
+  MappedFile(MappedFile&& other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept
+  {
+    Close();
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    file_ = std::move(other.file_);
+    mapping_ = std::move(other.mapping_);
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    fd_ = other.fd_;
+    other.fd_ = -1;
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    data_ = other.data_;
+    other.data_ = nullptr;
+    size_ = other.size_;
+    other.size_ = 0;
+    writable_ = other.writable_;
+
+    return *this;
+  }
+
+  ~MappedFile()
+  {
+    Close();
+  }
+
+  // Creates (or truncates) the file, sizes it, and maps it read-write.
+  void Create(std::wstring const& path, std::uint64_t size)
+  {
+    HADESMEM_DETAIL_ASSERT(size != 0);
+
+    Close();
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    file_ = SmartFileHandle(::CreateFileW(path.c_str(),
+                                          GENERIC_READ | GENERIC_WRITE,
+                                          FILE_SHARE_READ,
+                                          nullptr,
+                                          CREATE_ALWAYS,
+                                          FILE_ATTRIBUTE_NORMAL,
+                                          nullptr));
+    if (!file_.IsValid())
+    {
+      DWORD const last_error = ::GetLastError();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"CreateFileW failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+
+    // Not all file systems support sparse files, and the snapshot is still
+    // valid without it, so don't treat failure as an error.
+    DWORD bytes_returned = 0;
+    ::DeviceIoControl(file_.GetHandle(),
+                      FSCTL_SET_SPARSE,
+                      nullptr,
+                      0,
+                      nullptr,
+                      0,
+                      &bytes_returned,
+                      nullptr);
+
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    fd_ = ::open(WideCharToMultiByte(path).c_str(),
+                 O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                 0644);
+    if (fd_ == -1)
+    {
+      int const last_error = errno;
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"open failed."}
+                                              << ErrorCodeErrno{last_error});
+    }
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+    SetFileSize(size);
+    Map(size, true);
+  }
+
+  // Grows or shrinks a file opened through Create and maps it again. Any
+  // pointers into the old mapping are invalidated.
+  void Resize(std::uint64_t size)
+  {
+    HADESMEM_DETAIL_ASSERT(writable_);
+    HADESMEM_DETAIL_ASSERT(size != 0);
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    ::UnmapViewOfFile(data_);
+    mapping_ = SmartHandle();
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    ::munmap(data_, static_cast<std::size_t>(size_));
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    data_ = nullptr;
+    size_ = 0;
+
+    SetFileSize(size);
+    Map(size, true);
+  }
+
+  // Maps an existing file read-only.
+  void Open(std::wstring const& path)
+  {
+    Close();
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    file_ = SmartFileHandle(::CreateFileW(path.c_str(),
+                                          GENERIC_READ,
+                                          FILE_SHARE_READ,
+                                          nullptr,
+                                          OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL,
+                                          nullptr));
+    if (!file_.IsValid())
+    {
+      DWORD const last_error = ::GetLastError();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"CreateFileW failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file_.GetHandle(), &file_size))
+    {
+      DWORD const last_error = ::GetLastError();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"GetFileSizeEx failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+    auto const size = static_cast<std::uint64_t>(file_size.QuadPart);
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    fd_ = ::open(WideCharToMultiByte(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ == -1)
+    {
+      int const last_error = errno;
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"open failed."}
+                                              << ErrorCodeErrno{last_error});
+    }
+
+    struct ::stat st;
+    if (::fstat(fd_, &st) == -1)
+    {
+      int const last_error = errno;
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"fstat failed."}
+                                              << ErrorCodeErrno{last_error});
+    }
+    auto const size = static_cast<std::uint64_t>(st.st_size);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+    if (!size)
+    {
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"File is empty."});
+    }
+
+    Map(size, false);
+  }
+
+  void Close() noexcept
+  {
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    if (data_)
+    {
+      ::UnmapViewOfFile(data_);
+    }
+    mapping_ = SmartHandle();
+    file_ = SmartFileHandle();
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    if (data_)
+    {
+      ::munmap(data_, static_cast<std::size_t>(size_));
+    }
+    if (fd_ != -1)
+    {
+      ::close(fd_);
+      fd_ = -1;
+    }
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+    data_ = nullptr;
+    size_ = 0;
+    writable_ = false;
+  }
+
+  std::uint8_t* GetData() const noexcept
+  {
+    return data_;
+  }
+
+  std::uint64_t GetSize() const noexcept
+  {
+    return size_;
+  }
+
+  bool IsWritable() const noexcept
+  {
+    return writable_;
+  }
+
+private:
+  void SetFileSize(std::uint64_t size)
+  {
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    LARGE_INTEGER file_size;
+    file_size.QuadPart = static_cast<LONGLONG>(size);
+    if (!::SetFilePointerEx(
+          file_.GetHandle(), file_size, nullptr, FILE_BEGIN) ||
+        !::SetEndOfFile(file_.GetHandle()))
+    {
+      DWORD const last_error = ::GetLastError();
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"SetEndOfFile failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    if (::ftruncate(fd_, static_cast<::off_t>(size)) == -1)
+    {
+      int const last_error = errno;
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"ftruncate failed."}
+                                      << ErrorCodeErrno{last_error});
+    }
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  }
+
+  void Map(std::uint64_t size, bool writable)
+  {
+    if (size > static_cast<std::uint64_t>(static_cast<std::size_t>(-1)))
+    {
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"File is too large to map."});
+    }
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    mapping_ = SmartHandle(
+      ::CreateFileMappingW(file_.GetHandle(),
+                           nullptr,
+                           writable ? PAGE_READWRITE : PAGE_READONLY,
+                           static_cast<DWORD>(size >> 32),
+                           static_cast<DWORD>(size & 0xFFFFFFFF),
+                           nullptr));
+    if (!mapping_.IsValid())
+    {
+      DWORD const last_error = ::GetLastError();
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"CreateFileMappingW failed."}
+                << ErrorCodeWinLast{last_error});
+    }
+
+    DWORD const access = writable ? FILE_MAP_WRITE : FILE_MAP_READ;
+    void* const data = ::MapViewOfFile(
+      mapping_.GetHandle(), access, 0, 0, static_cast<SIZE_T>(size));
+    if (!data)
+    {
+      DWORD const last_error = ::GetLastError();
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"MapViewOfFile failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    void* const data = ::mmap(nullptr,
+                              static_cast<std::size_t>(size),
+                              writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                              MAP_SHARED,
+                              fd_,
+                              0);
+    if (data == MAP_FAILED)
+    {
+      int const last_error = errno;
+      Close();
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"mmap failed."}
+                                              << ErrorCodeErrno{last_error});
+    }
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+    data_ = static_cast<std::uint8_t*>(data);
+    size_ = size;
+    writable_ = writable;
+  }
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  SmartFileHandle file_;
+  SmartHandle mapping_;
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+  int fd_{-1};
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  std::uint8_t* data_{nullptr};
+  std::uint64_t size_{0};
+  bool writable_{false};
+};
+}
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hadesmem
+{
+namespace detail
+{
+inline std::size_t GetDefaultThreadCount() noexcept
+{
+  return (std::max)(std::thread::hardware_concurrency(), 1U);
+}
+
+// Calls func(i) for every i in [0, count), spread across up to num_threads
+// threads (zero means one per hardware thread). The calling thread does its
+// share of the work too. Work is handed out one index at a time so uneven
+// work items balance themselves. The first exception thrown by func stops
+// any further work from being handed out and is rethrown once all threads
+// have finished.
+template <typename Func>
+void ParallelFor(std::size_t count, std::size_t num_threads, Func const& func)
+{
+  if (!num_threads)
+  {
+    num_threads = GetDefaultThreadCount();
+  }
+  num_threads = (std::min)(num_threads, count);
+
+  if (num_threads <= 1)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      func(i);
+    }
+
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto const worker = [&]()
+  {
+    for (;;)
+    {
+      std::size_t const i = next++;
+      if (i >= count)
+      {
+        return;
+      }
+
+      try
+      {
+        func(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+        next = count;
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  try
+  {
+    for (std::size_t i = 1; i < num_threads; ++i)
+    {
+      threads.emplace_back(worker);
+    }
+  }
+  catch (...)
+  {
+    next = count;
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+    throw;
+  }
+
+  worker();
+
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+}
+}
@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -14,6 +15,7 @@
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/alias_cast.hpp>
 #include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/code_slab.hpp>
 #include <hadesmem/detail/patch_detour_stub.hpp>
 #include <hadesmem/detail/scope_warden.hpp>
 #include <hadesmem/detail/trace.hpp>
@@ -33,6 +35,8 @@ struct PatchConstants
 {
   static std::size_t const kJmpSize32 = 5;
   static std::size_t const kCallSize32 = 5;
+  // Largest stub gate (see WriteStubGate), including the jump to the stub.
+  static std::size_t const kMaxStubGateSize = 192;
 #if defined(HADESMEM_DETAIL_ARCH_X64)
   static std::size_t const kJmpSize64 = 6;
   static std::size_t const kCallSize64 = 6;
@@ -47,6 +51,9 @@ struct PatchConstants
 };
 
 // Inspired by EasyHook.
+// Prefer GetLocalCodeSlab where possible, which shares pages between
+// allocations. This is for when a whole page is needed (or the process is not
+// the current one).
 inline std::unique_ptr<Allocator> AllocatePageNear(Process const& process,
                                                    void* address)
 {
@@ -55,32 +62,24 @@ inline std::unique_ptr<Allocator> AllocatePageNear(Process const& process,
   DWORD const page_size = sys_info.dwPageSize;
 
 #if defined(HADESMEM_DETAIL_ARCH_X64)
-  std::intptr_t const search_beg = (std::max)(
-    reinterpret_cast<std::intptr_t>(address) - 0x7FFFFF00LL,
-    reinterpret_cast<std::intptr_t>(sys_info.lpMinimumApplicationAddress));
-  std::intptr_t const search_end = (std::min)(
-    reinterpret_cast<std::intptr_t>(address) + 0x7FFFFF00LL,
-    reinterpret_cast<std::intptr_t>(sys_info.lpMaximumApplicationAddress));
-
-  std::unique_ptr<Allocator> trampoline;
-
-  auto const allocate_tramp = [](Process const& process,
-                                 PVOID addr,
-                                 SIZE_T size) -> std::unique_ptr<Allocator> {
-    auto const new_addr = detail::TryAlloc(process, size, addr);
-    return new_addr ? std::make_unique<Allocator>(process, size, new_addr, true)
-                    : std::unique_ptr<Allocator>();
-  };
+  auto const target = reinterpret_cast<std::uintptr_t>(address);
+  std::uintptr_t const kReach = 0x7FFFFF00;
+  std::uintptr_t const search_beg = target > kReach ? target - kReach : 0;
+  std::uintptr_t const search_end =
+    (std::numeric_limits<std::uintptr_t>::max)() - target > kReach
+      ? target + kReach
+      : (std::numeric_limits<std::uintptr_t>::max)();
 
   // NOTE: The issue described below now appears to be fixed (the mov is now a
   // movsxd), but it doesn't hurt to keep the logic this way (especially since
   // it's a fairly generic problem that other hooking libraries are likely to
   // have at some point or another).
-  // Do two separate passes when looking for trampolines, ensuring to scan
-  // forwards first. This is because there is a bug in Steam's overlay (last
-  // checked and confirmed in SteamOverlayRender64.dll v2.50.25.37) where
-  // negative displacements are not correctly sign-extended when cast to
-  // 64-bits, resulting in a crash when they attempt to resolve the jump.
+  // Prefer pages after the address when looking for trampolines (this is
+  // handled by FindCodeSlabBlock). This is because there is a bug in Steam's
+  // overlay (last checked and confirmed in SteamOverlayRender64.dll
+  // v2.50.25.37) where negative displacements are not correctly sign-extended
+  // when cast to 64-bits, resulting in a crash when they attempt to resolve
+  // the jump.
   // .text:0000000180082956                 cmp     al, 0FFh
   // .text:0000000180082958                 jnz     short loc_180082971
   // .text:000000018008295A                 cmp     byte ptr [r13+1], 25h
@@ -90,37 +89,42 @@ inline std::unique_ptr<Allocator> AllocatePageNear(Process const& process,
   // .text:0000000180082965                 lea     rcx, [rax+r13]
   // .text:0000000180082969                 mov     r13, [rcx+6]
 
-  for (std::intptr_t base = reinterpret_cast<std::intptr_t>(address), index = 0;
-       base + index < search_end && !trampoline;
-       index += page_size)
-  {
-    trampoline =
-      allocate_tramp(process, reinterpret_cast<void*>(base + index), page_size);
-  }
-
-  if (!trampoline)
+  // Find the free regions with one walk rather than probing every page in
+  // range with an allocation. Retry in case another thread takes the page
+  // between the walk and the allocation.
+  ProcessCodeSlabBackend const backend{process};
+  std::size_t const kMaxAttempts = 4;
+  for (std::size_t i = 0; i < kMaxAttempts; ++i)
   {
-    HADESMEM_DETAIL_TRACE_A(
-      "WARNING! Failed to find a viable trampoline "
-      "page in forward scan, falling back to backward scan. This may cause "
-      "incompatibilty with some other overlays.");
-  }
+    auto const page =
+      FindCodeSlabBlock(backend.GetFreeRanges(search_beg, search_end),
+                        target,
+                        search_beg,
+                        search_end,
+                        page_size,
+                        backend.GetGranularity());
+    if (!page)
+    {
+      break;
+    }
 
-  for (std::intptr_t base = reinterpret_cast<std::intptr_t>(address), index = 0;
-       base - index > search_beg && !trampoline;
-       index += page_size)
-  {
-    trampoline =
-      allocate_tramp(process, reinterpret_cast<void*>(base - index), page_size);
-  }
+    if (page < target)
+    {
+      HADESMEM_DETAIL_TRACE_A(
+        "WARNING! Failed to find a viable trampoline page after the target, "
+        "falling back to a page before it. This may cause incompatibilty with "
+        "some other overlays.");
+    }
 
-  if (!trampoline)
-  {
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"Failed to find trampoline memory block."});
+    if (auto const new_addr =
+          detail::TryAlloc(process, page_size, reinterpret_cast<void*>(page)))
+    {
+      return std::make_unique<Allocator>(process, page_size, new_addr, true);
+    }
   }
 
-  return trampoline;
+  HADESMEM_DETAIL_THROW_EXCEPTION(
+    Error{} << ErrorString{"Failed to find trampoline memory block."});
 #elif defined(HADESMEM_DETAIL_ARCH_X86)
   (void)address;
   return std::make_unique<Allocator>(process, page_size);
@@ -239,12 +243,14 @@ inline std::vector<std::uint8_t> GenPush64Ret(void* target)
   return buf;
 }
 
-inline std::size_t
-  WriteJump(Process const& process,
-            void* address,
-            void* target,
-            bool push_ret_fallback,
-            std::vector<std::unique_ptr<Allocator>>* trampolines)
+// Generates a jump from address to target, without writing it. Any
+// trampoline it needs is allocated (and written) now.
+inline std::vector<std::uint8_t>
+  GenJump(Process const& process,
+          void* address,
+          void* target,
+          bool push_ret_fallback,
+          std::vector<CodeSlot>* trampolines)
 {
   HADESMEM_DETAIL_TRACE_FORMAT_A(
     "Address = %p, Target = %p, Push Ret Fallback = %u.",
@@ -263,13 +269,13 @@ inline std::size_t
   }
   else
   {
-    std::unique_ptr<Allocator> trampoline;
+    CodeSlot trampoline;
 
     if (trampolines)
     {
       try
       {
-        trampoline = AllocatePageNear(process, address);
+        trampoline = GetLocalCodeSlab().AllocateNear(address, sizeof(void*));
       }
       catch (std::exception const& /*e*/)
       {
@@ -277,9 +283,9 @@ inline std::size_t
       }
     }
 
-    if (trampoline)
+    if (trampoline.GetBase())
     {
-      void* tramp_addr = trampoline->GetBase();
+      void* tramp_addr = trampoline.GetBase();
 
       HADESMEM_DETAIL_TRACE_FORMAT_A("Using trampoline jump. Trampoline = %p.",
                                      tramp_addr);
@@ -322,6 +328,7 @@ inline std::size_t
     }
   }
 #elif defined(HADESMEM_DETAIL_ARCH_X86)
+  (void)process;
   (void)push_ret_fallback;
   (void)trampolines;
   HADESMEM_DETAIL_TRACE_A("Using relative jump.");
@@ -331,6 +338,19 @@ inline std::size_t
 #error "[HadesMem] Unsupported architecture."
 #endif
 
+  return jump_buf;
+}
+
+inline std::size_t
+  WriteJump(Process const& process,
+            void* address,
+            void* target,
+            bool push_ret_fallback,
+            std::vector<CodeSlot>* trampolines)
+{
+  auto const jump_buf =
+    GenJump(process, address, target, push_ret_fallback, trampolines);
+
   WriteVector(process, address, jump_buf);
 
   return jump_buf.size();
@@ -340,7 +360,7 @@ inline std::size_t
   WriteCall(Process const& process,
             void* address,
             void* target,
-            std::vector<std::unique_ptr<Allocator>>& trampolines)
+            std::vector<CodeSlot>& trampolines)
 {
   HADESMEM_DETAIL_TRACE_FORMAT_A("Address = %p, Target = %p", address, target);
 
@@ -348,9 +368,10 @@ inline std::size_t
 
 // TODO: Avoid using a trampoline where possible.
 #if defined(HADESMEM_DETAIL_ARCH_X64)
-  std::unique_ptr<Allocator> trampoline = AllocatePageNear(process, address);
+  CodeSlot trampoline =
+    GetLocalCodeSlab().AllocateNear(address, sizeof(void*));
 
-  PVOID tramp_addr = trampoline->GetBase();
+  PVOID tramp_addr = trampoline.GetBase();
 
   HADESMEM_DETAIL_TRACE_FORMAT_A("Using trampoline call. Trampoline = %p.",
                                  tramp_addr);
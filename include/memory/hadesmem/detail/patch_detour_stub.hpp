@@ -18,6 +18,17 @@
 #include <hadesmem/error.hpp>
 #include <hadesmem/local/patch_detour_base.hpp>
 
+// Times every call through the stub (i.e. the detour plus anything it calls,
+// including the trampoline). Must be declared after the ref counter, so the
+// scope is closed (and the profile written to) before the hook can be
+// removed and the profile freed.
+#if defined(HADESMEM_DETOUR_PROFILE)
+#define HADESMEM_DETAIL_DETOUR_PROFILE_SCOPE(patch)                            \
+  HookProfileScope const profile_scope{(patch)->GetProfile()}
+#else // #if defined(HADESMEM_DETOUR_PROFILE)
+#define HADESMEM_DETAIL_DETOUR_PROFILE_SCOPE(patch) (void)(patch)
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
+
 namespace hadesmem
 {
 namespace detail
@@ -51,6 +62,7 @@ private:
   R StubImpl(C* this_, Args... args)
   {
     auto const ref_counter = MakeDetourRefCounter(patch_->GetRefCount());
+    HADESMEM_DETAIL_DETOUR_PROFILE_SCOPE(patch_);
     winternl::GetCurrentTeb()->NtTib.ArbitraryUserPointer =
       patch_->GetOriginalArbitraryUserPtr();
     auto const detour = static_cast<DetourFuncT const*>(patch_->GetDetour());
@@ -89,6 +101,7 @@ private:
   R StubImpl(C const* this_, Args... args)
   {
     auto const ref_counter = MakeDetourRefCounter(patch_->GetRefCount());
+    HADESMEM_DETAIL_DETOUR_PROFILE_SCOPE(patch_);
     winternl::GetCurrentTeb()->NtTib.ArbitraryUserPointer =
       patch_->GetOriginalArbitraryUserPtr();
     auto const detour = static_cast<DetourFuncT const*>(patch_->GetDetour());
@@ -126,6 +139,7 @@ private:                                                                       \
     {                                                                          \
       HADESMEM_DETAIL_STATIC_ASSERT(IsFunction<DetourFuncRawT>::value);        \
       auto const ref_counter = MakeDetourRefCounter(patch_->GetRefCount());    \
+      HADESMEM_DETAIL_DETOUR_PROFILE_SCOPE(patch_);                            \
       winternl::GetCurrentTeb()->NtTib.ArbitraryUserPointer =                  \
         patch_->GetOriginalArbitraryUserPtr();                                 \
       auto const detour =                                                      \
@@ -167,6 +181,7 @@ private:                                                                       \
     {                                                                          \
       HADESMEM_DETAIL_STATIC_ASSERT(IsFunction<DetourFuncRawT>::value);        \
       auto const ref_counter = MakeDetourRefCounter(patch_->GetRefCount());    \
+      HADESMEM_DETAIL_DETOUR_PROFILE_SCOPE(patch_);                            \
       winternl::GetCurrentTeb()->NtTib.ArbitraryUserPointer =                  \
         patch_->GetOriginalArbitraryUserPtr();                                 \
       auto const detour =                                                      \
@@ -0,0 +1,70 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+
+// Records where each instruction overwritten by a detour ended up in its
+// trampoline. Relocated instructions can change size, so this can't be done
+// with a simple offset. Used to move threads which are suspended inside the
+// patched code to the equivalent instruction in the trampoline, rather than
+// failing the hook.
+
+namespace hadesmem
+{
+namespace detail
+{
+class PatchIpMap
+{
+public:
+  // Instructions must be added in order.
+  void Add(std::size_t target_offset, std::size_t trampoline_offset)
+  {
+    HADESMEM_DETAIL_ASSERT(offsets_.empty() ||
+                           offsets_.back().first < target_offset);
+    offsets_.emplace_back(target_offset, trampoline_offset);
+  }
+
+  void Clear() noexcept
+  {
+    offsets_.clear();
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return offsets_.size();
+  }
+
+  // Returns false if target_offset is not the start of a relocated
+  // instruction.
+  bool Remap(std::size_t target_offset,
+             std::size_t& trampoline_offset) const noexcept
+  {
+    auto const iter = std::lower_bound(
+      std::begin(offsets_),
+      std::end(offsets_),
+      target_offset,
+      [](std::pair<std::size_t, std::size_t> const& lhs, std::size_t rhs) {
+        return lhs.first < rhs;
+      });
+    if (iter == std::end(offsets_) || iter->first != target_offset)
+    {
+      return false;
+    }
+
+    trampoline_offset = iter->second;
+    return true;
+  }
+
+private:
+  std::vector<std::pair<std::size_t, std::size_t>> offsets_;
+};
+}
+}
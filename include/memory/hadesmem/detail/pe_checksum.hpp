@@ -0,0 +1,217 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <emmintrin.h>
+
+#include <hadesmem/config.hpp>
+
+// The PE checksum (OptionalHeader.CheckSum), as calculated by
+// CheckSumMappedFile: the one's complement sum of the file as little endian
+// 16-bit words (with the checksum field itself treated as zero, and an odd
+// trailing byte treated as a word), folded to 16 bits, plus the file size.
+// A one's complement sum can be calculated as a plain sum which is only
+// folded at the end, so the file can be fed in any number of pieces of any
+// size, and the checksum field can be removed after the fact rather than
+// special cased in the summing loop.
+// The bulk of the sum is done 16 bytes at a time by summing the low and high
+// bytes of each word separately with PSADBW, which widens to 64 bits as it
+// goes so nothing needs to be folded inside the loop.
+
+namespace hadesmem
+{
+namespace detail
+{
+// Offset of OptionalHeader.CheckSum, which is at the same place in PE32 and
+// PE32+ files. Returns zero if the headers are too short to contain it.
+inline std::uint64_t GetPeChecksumOffset(void const* headers, std::size_t size)
+{
+  std::size_t const kLfanewOffset = 0x3C;
+  if (size < kLfanewOffset + sizeof(std::uint32_t))
+  {
+    return 0;
+  }
+
+  std::uint32_t e_lfanew = 0;
+  std::memcpy(&e_lfanew,
+              static_cast<std::uint8_t const*>(headers) + kLfanewOffset,
+              sizeof(e_lfanew));
+
+  // Signature, file header, then the checksum is at offset 64 into the
+  // optional header.
+  auto const offset = static_cast<std::uint64_t>(e_lfanew) + 4 + 20 + 64;
+  return offset + sizeof(std::uint32_t) <= size ? offset : 0;
+}
+
+// A checksum_offset of zero means there is no checksum field to skip.
+class PeChecksum
+{
+public:
+  explicit PeChecksum(std::uint64_t checksum_offset) noexcept
+    : checksum_offset_{checksum_offset}
+  {
+  }
+
+  void Update(void const* data, std::size_t len)
+  {
+    auto p = static_cast<std::uint8_t const*>(data);
+    auto const end = p + len;
+    auto const start_pos = pos_;
+
+    // Get back to a word boundary.
+    if ((pos_ & 1) && p != end)
+    {
+      sum_ += static_cast<std::uint64_t>(*p++) << 8;
+      ++pos_;
+    }
+
+    p = SumWords(p, end);
+
+    for (; p + 2 <= end; p += 2)
+    {
+      sum_ += static_cast<std::uint64_t>(p[0]) |
+              (static_cast<std::uint64_t>(p[1]) << 8);
+    }
+    pos_ = start_pos + len;
+
+    if (p != end)
+    {
+      sum_ += *p;
+    }
+
+    RemoveChecksumField(static_cast<std::uint8_t const*>(data), start_pos);
+  }
+
+  std::uint32_t Final() const noexcept
+  {
+    auto sum = sum_;
+    while (sum >> 16)
+    {
+      sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return static_cast<std::uint32_t>(sum + pos_);
+  }
+
+private:
+  // Sums as many whole 16-byte blocks as possible, which must start on a word
+  // boundary. Returns the first byte not consumed.
+  std::uint8_t const* SumWords(std::uint8_t const* p, std::uint8_t const* end)
+  {
+    std::size_t const kBlockSize = 16;
+    if (static_cast<std::size_t>(end - p) < kBlockSize * 4)
+    {
+      return p;
+    }
+
+    __m128i const low_mask = _mm_set1_epi16(0x00FF);
+    __m128i const zero = _mm_setzero_si128();
+    __m128i sum_lo = zero;
+    __m128i sum_hi = zero;
+
+    auto const sum_block = [&](std::uint8_t const* block) {
+      __m128i const v =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+      sum_lo = _mm_add_epi64(
+        sum_lo, _mm_sad_epu8(_mm_and_si128(v, low_mask), zero));
+      sum_hi =
+        _mm_add_epi64(sum_hi, _mm_sad_epu8(_mm_srli_epi16(v, 8), zero));
+    };
+
+    for (; end - p >= static_cast<std::ptrdiff_t>(kBlockSize * 4);
+         p += kBlockSize * 4)
+    {
+      sum_block(p);
+      sum_block(p + kBlockSize);
+      sum_block(p + kBlockSize * 2);
+      sum_block(p + kBlockSize * 3);
+    }
+    for (; end - p >= static_cast<std::ptrdiff_t>(kBlockSize); p += kBlockSize)
+    {
+      sum_block(p);
+    }
+
+    std::uint64_t lo[2];
+    std::uint64_t hi[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lo), sum_lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hi), sum_hi);
+    sum_ += lo[0] + lo[1] + ((hi[0] + hi[1]) << 8);
+
+    return p;
+  }
+
+  void RemoveChecksumField(std::uint8_t const* data, std::uint64_t start_pos)
+  {
+    if (!checksum_offset_)
+    {
+      return;
+    }
+
+    for (std::uint64_t i = 0; i < sizeof(std::uint32_t); ++i)
+    {
+      auto const field_pos = checksum_offset_ + i;
+      if (field_pos >= start_pos && field_pos < pos_)
+      {
+        sum_ -= static_cast<std::uint64_t>(data[field_pos - start_pos])
+                << ((field_pos & 1) * 8);
+      }
+    }
+  }
+
+  std::uint64_t checksum_offset_;
+  std::uint64_t pos_{0};
+  std::uint64_t sum_{0};
+};
+
+// Checksum of a whole file in memory.
+inline std::uint32_t GetPeChecksum(void const* data, std::size_t size)
+{
+  PeChecksum checksum(GetPeChecksumOffset(data, size));
+  checksum.Update(data, size);
+  return checksum.Final();
+}
+
+// The checksum stored in the headers, or zero if there is no checksum field.
+inline std::uint32_t GetPeStoredChecksum(void const* data, std::size_t size)
+{
+  auto const offset = GetPeChecksumOffset(data, size);
+  if (!offset)
+  {
+    return 0;
+  }
+
+  std::uint32_t stored = 0;
+  std::memcpy(&stored,
+              static_cast<std::uint8_t const*>(data) + offset,
+              sizeof(stored));
+  return stored;
+}
+
+// A stored checksum of zero means none was set, which the loader only
+// rejects for drivers, so callers will usually want to check for that first.
+inline bool IsPeChecksumValid(void const* data, std::size_t size)
+{
+  return GetPeStoredChecksum(data, size) == GetPeChecksum(data, size);
+}
+
+// Calculates the checksum and writes it to the headers. Returns false if
+// there is no checksum field.
+inline bool FixPeChecksum(void* data, std::size_t size)
+{
+  auto const offset = GetPeChecksumOffset(data, size);
+  if (!offset)
+  {
+    return false;
+  }
+
+  auto const checksum = GetPeChecksum(data, size);
+  std::memcpy(
+    static_cast<std::uint8_t*>(data) + offset, &checksum, sizeof(checksum));
+  return true;
+}
+}
+}
@@ -0,0 +1,489 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/crypto.hpp>
+#include <hadesmem/detail/mapped_file.hpp>
+#include <hadesmem/detail/pe_checksum.hpp>
+#include <hadesmem/error.hpp>
+
+// Hashes of a PE file and its sections, its imphash, its Authenticode digest
+// and its checksum, calculated in a single pass over the file so each page is
+// only brought in once regardless of how many digests are wanted.
+// Files are parsed straight from a buffer in file layout, without PeLib or
+// any Win32 PE definitions, so nothing needs a Process and everything can be
+// tested on any OS.
+
+namespace hadesmem
+{
+namespace detail
+{
+struct PeSectionDigest
+{
+  std::string name;
+  DWORD pointer_to_raw_data;
+  // Clipped to the end of the file.
+  DWORD size_of_raw_data;
+  Sha256::Digest sha256;
+  XxHash64::Digest xxhash;
+};
+
+struct PeDigest
+{
+  std::uint64_t size;
+  Sha1::Digest sha1;
+  Sha256::Digest sha256;
+  XxHash64::Digest xxhash;
+  // SHA-256 of everything but the checksum, the certificate table directory
+  // entry and the certificate table. This is the linear form used by
+  // osslsigncode and friends, which only differs from the section ordered
+  // form in the Authenticode spec for files with gaps between (or
+  // overlapping) sections, or with sections out of file order.
+  Sha256::Digest authenticode_sha256;
+  std::vector<PeSectionDigest> sections;
+  // Empty if the file has no imports, or they can't be parsed.
+  std::wstring imphash;
+  DWORD checksum;
+  DWORD header_checksum;
+};
+
+namespace pe_digest
+{
+inline void ThrowInvalid(char const* what)
+{
+  HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{what});
+}
+
+template <typename T>
+T Read(std::uint8_t const* data, std::size_t size, std::size_t offset)
+{
+  if (offset > size || size - offset < sizeof(T))
+  {
+    ThrowInvalid("Read outside of file.");
+  }
+
+  T value;
+  std::memcpy(&value, data + offset, sizeof(value));
+  return value;
+}
+
+inline std::string
+  ReadString(std::uint8_t const* data, std::size_t size, std::size_t offset)
+{
+  if (offset >= size)
+  {
+    ThrowInvalid("Read outside of file.");
+  }
+
+  auto const begin = reinterpret_cast<char const*>(data + offset);
+  auto const end = reinterpret_cast<char const*>(data + size);
+  auto const terminator = std::find(begin, end, '\0');
+  if (terminator == end)
+  {
+    ThrowInvalid("Unterminated string.");
+  }
+
+  return std::string(begin, terminator);
+}
+
+struct SectionHeader
+{
+  std::string name;
+  DWORD virtual_address;
+  DWORD virtual_size;
+  DWORD pointer_to_raw_data;
+  DWORD size_of_raw_data;
+};
+
+// The bits of the headers needed for the digests.
+struct Headers
+{
+  bool is_64;
+  // File offsets of OptionalHeader.CheckSum and of the certificate table
+  // directory entry. Zero if not present.
+  std::size_t checksum_offset;
+  std::size_t cert_dir_offset;
+  DWORD cert_table_offset;
+  DWORD cert_table_size;
+  DWORD import_dir_rva;
+  DWORD size_of_headers;
+  std::vector<SectionHeader> sections;
+};
+
+inline Headers ReadHeaders(std::uint8_t const* data, std::size_t size)
+{
+  Headers headers{};
+
+  if (Read<WORD>(data, size, 0) != 0x5A4D)
+  {
+    ThrowInvalid("Invalid DOS header.");
+  }
+
+  std::size_t const nt_offset = Read<DWORD>(data, size, 0x3C);
+  if (Read<DWORD>(data, size, nt_offset) != 0x00004550)
+  {
+    ThrowInvalid("Invalid NT headers.");
+  }
+
+  std::size_t const num_sections = Read<WORD>(data, size, nt_offset + 6);
+  std::size_t const size_of_opt = Read<WORD>(data, size, nt_offset + 20);
+  std::size_t const opt_offset = nt_offset + 24;
+  WORD const magic = Read<WORD>(data, size, opt_offset);
+  if (magic == 0x10B)
+  {
+    headers.is_64 = false;
+  }
+  else if (magic == 0x20B)
+  {
+    headers.is_64 = true;
+  }
+  else
+  {
+    ThrowInvalid("Unknown optional header magic.");
+  }
+
+  headers.checksum_offset = opt_offset + 64;
+  headers.size_of_headers = Read<DWORD>(data, size, opt_offset + 60);
+
+  std::size_t const num_dirs_offset = opt_offset + (headers.is_64 ? 108 : 92);
+  std::size_t const dirs_offset = num_dirs_offset + 4;
+  std::size_t const num_dirs = Read<DWORD>(data, size, num_dirs_offset);
+  std::size_t const kImportDirIndex = 1;
+  std::size_t const kSecurityDirIndex = 4;
+  if (num_dirs > kImportDirIndex)
+  {
+    headers.import_dir_rva =
+      Read<DWORD>(data, size, dirs_offset + kImportDirIndex * 8);
+  }
+  if (num_dirs > kSecurityDirIndex)
+  {
+    headers.cert_dir_offset = dirs_offset + kSecurityDirIndex * 8;
+    // Unlike every other directory this is a file offset, not an RVA.
+    headers.cert_table_offset =
+      Read<DWORD>(data, size, headers.cert_dir_offset);
+    headers.cert_table_size =
+      Read<DWORD>(data, size, headers.cert_dir_offset + 4);
+  }
+
+  std::size_t const kSectionHeaderSize = 40;
+  std::size_t const sections_offset = opt_offset + size_of_opt;
+  for (std::size_t i = 0; i < num_sections; ++i)
+  {
+    std::size_t const offset = sections_offset + i * kSectionHeaderSize;
+    SectionHeader section{};
+    // Last, so the whole header is bounds checked before the name is copied.
+    section.pointer_to_raw_data = Read<DWORD>(data, size, offset + 20);
+    section.size_of_raw_data = Read<DWORD>(data, size, offset + 16);
+    section.virtual_address = Read<DWORD>(data, size, offset + 12);
+    section.virtual_size = Read<DWORD>(data, size, offset + 8);
+    char name[9] = {};
+    std::memcpy(name, data + offset, 8);
+    section.name = name;
+    headers.sections.push_back(section);
+  }
+
+  return headers;
+}
+
+inline std::size_t RvaToFileOffset(Headers const& headers, DWORD rva)
+{
+  for (auto const& section : headers.sections)
+  {
+    DWORD const virtual_size =
+      (std::max)(section.virtual_size, section.size_of_raw_data);
+    if (rva >= section.virtual_address &&
+        rva - section.virtual_address < virtual_size)
+    {
+      return static_cast<std::size_t>(rva - section.virtual_address) +
+             section.pointer_to_raw_data;
+    }
+  }
+
+  if (rva < headers.size_of_headers)
+  {
+    return rva;
+  }
+
+  ThrowInvalid("RVA is not in any section.");
+  return 0;
+}
+
+inline std::string ToLower(std::string str)
+{
+  for (auto& c : str)
+  {
+    if (c >= 'A' && c <= 'Z')
+    {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  return str;
+}
+
+// The comma separated list of "module.function" which the imphash is the
+// MD5 of.
+inline std::string GetImpHashInput(std::uint8_t const* data,
+                                   std::size_t size,
+                                   Headers const& headers)
+{
+  std::string imports;
+  if (!headers.import_dir_rva)
+  {
+    return imports;
+  }
+
+  std::size_t const kDescSize = 20;
+  std::size_t const thunk_size = headers.is_64 ? 8 : 4;
+  std::uint64_t const ordinal_flag =
+    headers.is_64 ? 0x8000000000000000ULL : 0x80000000ULL;
+  for (std::size_t desc = RvaToFileOffset(headers, headers.import_dir_rva);;
+       desc += kDescSize)
+  {
+    DWORD const orig_first_thunk = Read<DWORD>(data, size, desc);
+    DWORD const name = Read<DWORD>(data, size, desc + 12);
+    DWORD const first_thunk = Read<DWORD>(data, size, desc + 16);
+    if (!name || !first_thunk)
+    {
+      break;
+    }
+
+    auto module_name =
+      ToLower(ReadString(data, size, RvaToFileOffset(headers, name)));
+    auto const ext_pos = module_name.rfind('.');
+    if (ext_pos != std::string::npos)
+    {
+      auto const ext = module_name.substr(ext_pos + 1);
+      if (ext == "dll" || ext == "ocx" || ext == "sys")
+      {
+        module_name.erase(ext_pos);
+      }
+    }
+
+    std::size_t const thunks = RvaToFileOffset(
+      headers, orig_first_thunk ? orig_first_thunk : first_thunk);
+    for (std::size_t i = 0;; ++i)
+    {
+      std::size_t const offset = thunks + i * thunk_size;
+      std::uint64_t const thunk = headers.is_64
+                                    ? Read<std::uint64_t>(data, size, offset)
+                                    : Read<DWORD>(data, size, offset);
+      if (!thunk)
+      {
+        break;
+      }
+
+      if (!imports.empty())
+      {
+        imports += ',';
+      }
+
+      imports += module_name;
+      imports += '.';
+      if (thunk & ordinal_flag)
+      {
+        imports += "ord" + std::to_string(thunk & 0xFFFF);
+      }
+      else
+      {
+        // Skip the hint.
+        auto const name_rva = static_cast<DWORD>(thunk & 0x7FFFFFFF);
+        imports += ToLower(
+          ReadString(data, size, RvaToFileOffset(headers, name_rva) + 2));
+      }
+    }
+  }
+
+  return imports;
+}
+
+// Feeds a hash everything but a set of excluded ranges, however the data is
+// split up.
+class ExcludingHasher
+{
+public:
+  void Exclude(std::uint64_t begin, std::uint64_t len)
+  {
+    if (len)
+    {
+      excluded_.push_back({begin, begin + len});
+    }
+  }
+
+  void Update(Sha256& hash,
+              std::uint8_t const* data,
+              std::uint64_t offset,
+              std::size_t len) const
+  {
+    std::uint64_t const end = offset + len;
+    while (offset < end)
+    {
+      std::uint64_t next = end;
+      bool excluded = false;
+      for (auto const& range : excluded_)
+      {
+        if (offset >= range.first && offset < range.second)
+        {
+          next = (std::min)(next, range.second);
+          excluded = true;
+        }
+        else if (range.first > offset)
+        {
+          next = (std::min)(next, range.first);
+        }
+      }
+
+      if (!excluded)
+      {
+        hash.Update(data, static_cast<std::size_t>(next - offset));
+      }
+      data += next - offset;
+      offset = next;
+    }
+  }
+
+private:
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> excluded_;
+};
+}
+
+// Compatible with the imphash used by pefile and VirusTotal, except that
+// imports by ordinal are always named "ordN" (pefile has a small table of
+// names for some ordinals in ws2_32.dll, wsock32.dll and oleaut32.dll).
+// Throws if the headers or imports are malformed.
+inline std::wstring GetImpHash(std::uint8_t const* data, std::size_t size)
+{
+  auto const headers = pe_digest::ReadHeaders(data, size);
+  auto const imports = pe_digest::GetImpHashInput(data, size, headers);
+  if (imports.empty())
+  {
+    return {};
+  }
+
+  return ByteArrayToString(GetHash<Md5>(imports.data(), imports.size()));
+}
+
+// Throws if the headers are malformed.
+inline PeDigest GetPeDigest(std::uint8_t const* data, std::size_t size)
+{
+  auto const headers = pe_digest::ReadHeaders(data, size);
+
+  PeDigest digest{};
+  digest.size = size;
+  digest.header_checksum = GetPeStoredChecksum(data, size);
+  try
+  {
+    auto const imports = pe_digest::GetImpHashInput(data, size, headers);
+    if (!imports.empty())
+    {
+      digest.imphash =
+        ByteArrayToString(GetHash<Md5>(imports.data(), imports.size()));
+    }
+  }
+  catch (Error const& /*e*/)
+  {
+    // Bad imports shouldn't stop everything else being hashed.
+  }
+
+  pe_digest::ExcludingHasher authenticode;
+  authenticode.Exclude(headers.checksum_offset, sizeof(DWORD));
+  if (headers.cert_dir_offset)
+  {
+    authenticode.Exclude(headers.cert_dir_offset, 8);
+    authenticode.Exclude(headers.cert_table_offset, headers.cert_table_size);
+  }
+
+  struct SectionHasher
+  {
+    std::size_t begin;
+    std::size_t end;
+    Sha256 sha256;
+    XxHash64 xxhash;
+  };
+  std::vector<SectionHasher> section_hashers;
+  for (auto const& section : headers.sections)
+  {
+    std::size_t const begin =
+      (std::min<std::size_t>)(section.pointer_to_raw_data, size);
+    auto const end = static_cast<std::size_t>((std::min<std::uint64_t>)(
+      static_cast<std::uint64_t>(begin) + section.size_of_raw_data, size));
+    digest.sections.emplace_back(PeSectionDigest{
+      section.name,
+      section.pointer_to_raw_data,
+      static_cast<DWORD>(end - begin),
+      {},
+      {}});
+    section_hashers.emplace_back(
+      SectionHasher{begin, end, Sha256(), XxHash64()});
+  }
+
+  Sha1 sha1;
+  Sha256 sha256;
+  Sha256 authenticode_sha256;
+  XxHash64 xxhash;
+  PeChecksum checksum(GetPeChecksumOffset(data, size));
+
+  // Small enough to stay in cache while every hash consumes it.
+  std::size_t const kChunkSize = 0x40000;
+  for (std::size_t chunk_beg = 0; chunk_beg < size; chunk_beg += kChunkSize)
+  {
+    auto const chunk_end = (std::min)(chunk_beg + kChunkSize, size);
+    auto const p = data + chunk_beg;
+    auto const len = chunk_end - chunk_beg;
+
+    sha1.Update(p, len);
+    sha256.Update(p, len);
+    authenticode.Update(authenticode_sha256, p, chunk_beg, len);
+    xxhash.Update(p, len);
+    checksum.Update(p, len);
+
+    for (auto& s : section_hashers)
+    {
+      auto const beg = (std::max)(s.begin, chunk_beg);
+      auto const end = (std::min)(s.end, chunk_end);
+      if (beg < end)
+      {
+        s.sha256.Update(data + beg, end - beg);
+        s.xxhash.Update(data + beg, end - beg);
+      }
+    }
+  }
+
+  digest.sha1 = sha1.Final();
+  digest.sha256 = sha256.Final();
+  digest.authenticode_sha256 = authenticode_sha256.Final();
+  digest.xxhash = xxhash.Final();
+  digest.checksum = checksum.Final();
+  for (std::size_t i = 0; i < section_hashers.size(); ++i)
+  {
+    digest.sections[i].sha256 = section_hashers[i].sha256.Final();
+    digest.sections[i].xxhash = section_hashers[i].xxhash.Final();
+  }
+
+  return digest;
+}
+
+inline PeDigest GetPeDigest(std::wstring const& path)
+{
+  MappedFile file;
+  file.Open(path);
+  if (file.GetSize() > (std::numeric_limits<std::size_t>::max)())
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"File is too large."});
+  }
+
+  return GetPeDigest(file.GetData(), static_cast<std::size_t>(file.GetSize()));
+}
+}
+}
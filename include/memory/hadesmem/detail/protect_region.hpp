@@ -1,36 +1,92 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <windows.h>
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/process.hpp>
-
-namespace hadesmem
-{
-namespace detail
-{
-inline DWORD Protect(Process const& process,
-                     MEMORY_BASIC_INFORMATION const& mbi,
-                     DWORD protect)
-{
-  DWORD old_protect = 0;
-  if (!::VirtualProtectEx(process.GetHandle(),
-                          mbi.BaseAddress,
-                          mbi.RegionSize,
-                          protect,
-                          &old_protect))
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
-                                    << ErrorString{"VirtualProtectEx failed."}
-                                    << ErrorCodeWinLast{last_error});
-  }
-
-  return old_protect;
-}
-}
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
+
+namespace hadesmem
+{
+namespace detail
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline DWORD Protect(Process const& process,
+                     MEMORY_BASIC_INFORMATION const& mbi,
+                     DWORD protect)
+{
+  DWORD old_protect = 0;
+  if (!::VirtualProtectEx(process.GetHandle(),
+                          mbi.BaseAddress,
+                          mbi.RegionSize,
+                          protect,
+                          &old_protect))
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"VirtualProtectEx failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+
+  return old_protect;
+}
+
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+inline int ProtectToLinuxProt(DWORD protect) noexcept
+{
+  switch (protect & 0xFF)
+  {
+  case PAGE_READONLY:
+    return PROT_READ;
+  case PAGE_READWRITE:
+  case PAGE_WRITECOPY:
+    return PROT_READ | PROT_WRITE;
+  case PAGE_EXECUTE:
+    return PROT_EXEC;
+  case PAGE_EXECUTE_READ:
+    return PROT_READ | PROT_EXEC;
+  case PAGE_EXECUTE_READWRITE:
+  case PAGE_EXECUTE_WRITECOPY:
+    return PROT_READ | PROT_WRITE | PROT_EXEC;
+  default:
+    return PROT_NONE;
+  }
+}
+
+// Linux has no equivalent of VirtualProtectEx, so only the current process can
+// be modified.
+inline DWORD Protect(Process const& process,
+                     MEMORY_BASIC_INFORMATION const& mbi,
+                     DWORD protect)
+{
+  if (process.GetId() != static_cast<DWORD>(::getpid()))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{
+        "Changing the protection of a remote process is unsupported."});
+  }
+
+  if (::mprotect(mbi.BaseAddress, mbi.RegionSize, ProtectToLinuxProt(protect)))
+  {
+    int const last_error = errno;
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"mprotect failed."}
+                                            << ErrorCodeErrno{last_error});
+  }
+
+  return mbi.Protect;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+// #elif defined(HADESMEM_DETAIL_OS_LINUX)
+}
+}
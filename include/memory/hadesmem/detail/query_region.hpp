@@ -1,80 +1,140 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <windows.h>
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/process.hpp>
-
-namespace hadesmem
-{
-namespace detail
-{
-inline MEMORY_BASIC_INFORMATION Query(Process const& process, LPCVOID address)
-{
-  MEMORY_BASIC_INFORMATION mbi{};
-  if (::VirtualQueryEx(process.GetHandle(), address, &mbi, sizeof(mbi)) !=
-      sizeof(mbi))
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
-                                    << ErrorString{"VirtualQueryEx failed."}
-                                    << ErrorCodeWinLast{last_error});
-  }
-
-  return mbi;
-}
-
-inline bool
-  CanRead(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  DWORD const read_prot = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
-                          PAGE_EXECUTE | PAGE_EXECUTE_READ |
-                          PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
-  return (mbi.State == MEM_COMMIT) && !!(mbi.Protect & read_prot);
-}
-
-inline bool
-  CanWrite(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  DWORD const write_prot = PAGE_READWRITE | PAGE_WRITECOPY |
-                           PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
-  return (mbi.State == MEM_COMMIT) && !!(mbi.Protect & write_prot);
-}
-
-inline bool
-  CanExecute(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  DWORD const exec_prot = PAGE_EXECUTE | PAGE_EXECUTE_READ |
-                          PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
-  return (mbi.State == MEM_COMMIT) && !!(mbi.Protect & exec_prot);
-}
-
-inline bool
-  IsBadProtect(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  return !!(mbi.Protect & (PAGE_GUARD | PAGE_NOCACHE | PAGE_WRITECOMBINE));
-}
-
-inline bool
-  IsGuard(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  return !!(mbi.Protect & PAGE_GUARD);
-}
-
-inline bool
-  IsNoCache(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  return !!(mbi.Protect & PAGE_NOCACHE);
-}
-
-inline bool
-  IsWriteCombine(MEMORY_BASIC_INFORMATION const& mbi) noexcept
-{
-  return !!(mbi.Protect & PAGE_WRITECOMBINE);
-}
-}
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstdint>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+#include <hadesmem/detail/linux_maps.hpp>
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
+
+namespace hadesmem
+{
+namespace detail
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline MEMORY_BASIC_INFORMATION Query(Process const& process, LPCVOID address)
+{
+  MEMORY_BASIC_INFORMATION mbi{};
+  if (::VirtualQueryEx(process.GetHandle(), address, &mbi, sizeof(mbi)) !=
+      sizeof(mbi))
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"VirtualQueryEx failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+
+  return mbi;
+}
+
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+// WARNING: This re-reads the maps file on every call. Avoid calling it in a
+// loop (e.g. use RegionList instead to walk the address space).
+inline MEMORY_BASIC_INFORMATION Query(Process const& process, LPCVOID address)
+{
+  return FindLinuxRegion(QueryLinuxMaps(process.GetId()), address);
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+// #elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+// Calls 'func' with every region in the address space (including free
+// regions) in ascending order. Unlike RegionList this doesn't use exceptions to
+// detect the end of the address space and doesn't allocate per region, so it
+// is suitable for code that enumerates frequently. It does still throw if the
+// address space can't be queried at all (or if 'func' throws).
+template <typename Func> void ForEachRegion(Process const& process, Func func)
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  auto address = static_cast<std::uint8_t const*>(nullptr);
+  for (;;)
+  {
+    MEMORY_BASIC_INFORMATION mbi{};
+    if (::VirtualQueryEx(process.GetHandle(), address, &mbi, sizeof(mbi)) !=
+        sizeof(mbi))
+    {
+      DWORD const last_error = ::GetLastError();
+      // End of the address space, or a 'zombie' process.
+      if (last_error == ERROR_INVALID_PARAMETER ||
+          (last_error == ERROR_ACCESS_DENIED && address == nullptr))
+      {
+        return;
+      }
+
+      HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                      << ErrorString{"VirtualQueryEx failed."}
+                                      << ErrorCodeWinLast{last_error});
+    }
+
+    func(mbi);
+
+    address = static_cast<std::uint8_t const*>(mbi.BaseAddress) +
+              mbi.RegionSize;
+  }
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+  for (auto const& mbi : QueryLinuxMaps(process.GetId()))
+  {
+    func(mbi);
+  }
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  // #elif defined(HADESMEM_DETAIL_OS_LINUX)
+}
+
+inline bool
+  CanRead(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  DWORD const read_prot = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+                          PAGE_EXECUTE | PAGE_EXECUTE_READ |
+                          PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+  return (mbi.State == MEM_COMMIT) && !!(mbi.Protect & read_prot);
+}
+
+inline bool
+  CanWrite(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  DWORD const write_prot = PAGE_READWRITE | PAGE_WRITECOPY |
+                           PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+  return (mbi.State == MEM_COMMIT) && !!(mbi.Protect & write_prot);
+}
+
+inline bool
+  CanExecute(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  DWORD const exec_prot = PAGE_EXECUTE | PAGE_EXECUTE_READ |
+                          PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+  return (mbi.State == MEM_COMMIT) && !!(mbi.Protect & exec_prot);
+}
+
+inline bool
+  IsBadProtect(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  return !!(mbi.Protect & (PAGE_GUARD | PAGE_NOCACHE | PAGE_WRITECOMBINE));
+}
+
+inline bool
+  IsGuard(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  return !!(mbi.Protect & PAGE_GUARD);
+}
+
+inline bool
+  IsNoCache(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  return !!(mbi.Protect & PAGE_NOCACHE);
+}
+
+inline bool
+  IsWriteCombine(MEMORY_BASIC_INFORMATION const& mbi) noexcept
+{
+  return !!(mbi.Protect & PAGE_WRITECOMBINE);
+}
+}
+}
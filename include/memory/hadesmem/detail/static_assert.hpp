@@ -1,7 +1,7 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#define HADESMEM_DETAIL_STATIC_ASSERT(...)                                     \
-  static_assert((__VA_ARGS__), #__VA_ARGS__)
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#define HADESMEM_DETAIL_STATIC_ASSERT(...)                                     \
+  static_assert((__VA_ARGS__), #__VA_ARGS__)
@@ -1,18 +1,18 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/detail/static_assert.hpp>
-
-#pragma once
-
-#if defined(HADESMEM_DETAIL_ARCH_X86)
-
-#define HADESMEM_DETAIL_STATIC_ASSERT_X86(...)                                 \
-  HADESMEM_DETAIL_STATIC_ASSERT(__VA_ARGS__)
-
-#else
-
-#define HADESMEM_DETAIL_STATIC_ASSERT_X86(...) static_assert(true, "")
-
-#endif // #if defined(HADESMEM_DETAIL_ARCH_X86)
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+
+#pragma once
+
+#if defined(HADESMEM_DETAIL_ARCH_X86)
+
+#define HADESMEM_DETAIL_STATIC_ASSERT_X86(...)                                 \
+  HADESMEM_DETAIL_STATIC_ASSERT(__VA_ARGS__)
+
+#else
+
+#define HADESMEM_DETAIL_STATIC_ASSERT_X86(...) static_assert(true, "")
+
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X86)
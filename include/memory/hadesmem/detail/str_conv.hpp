@@ -1,176 +1,289 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <cstdint>
-#include <limits>
-#include <locale>
-#include <sstream>
-#include <string>
-#include <vector>
-
-#include <windows.h>
-
-#include <hadesmem/error.hpp>
-#include <hadesmem/detail/assert.hpp>
-#include <hadesmem/detail/static_assert.hpp>
-
-namespace hadesmem
-{
-namespace detail
-{
-template <typename CharT>
-inline std::uintptr_t HexStrToPtrT(std::basic_string<CharT> const& str)
-{
-  std::basic_stringstream<CharT> ss{str};
-  ss.imbue(std::locale::classic());
-  std::uintptr_t ptr = 0;
-  if (!(ss >> std::hex >> ptr))
-  {
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"String to pointer conversion failed."});
-  }
-  return ptr;
-}
-
-inline std::uintptr_t HexStrToPtr(std::string const& str)
-{
-  return HexStrToPtrT<char>(str);
-}
-
-inline std::uintptr_t HexStrToPtr(std::wstring const& str)
-{
-  return HexStrToPtrT<wchar_t>(str);
-}
-
-template <typename CharT = wchar_t>
-inline std::basic_string<CharT> PtrToHexString(void const* const ptr)
-{
-  std::basic_ostringstream<CharT> ss;
-  ss.imbue(std::locale::classic());
-  if (!(ss << std::hex << reinterpret_cast<std::uintptr_t>(ptr)))
-  {
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"Pointer to string conversion failed."});
-  }
-  return ss.str();
-}
-
-template <typename T, typename CharT>
-T StrToNum(std::basic_string<CharT> const& str, bool hex = false)
-{
-  HADESMEM_DETAIL_STATIC_ASSERT(std::is_integral<T>::value);
-  std::basic_istringstream<CharT> converter{str};
-  converter.imbue(std::locale::classic());
-  T out;
-  if (!converter || !(converter >> (hex ? std::hex : std::dec) >> out))
-  {
-    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
-                                    << ErrorString{"Conversion failed."});
-  }
-  return out;
-}
-
-template <typename CharT, typename T>
-std::basic_string<CharT> NumToStr(T num, bool hex = false)
-{
-  HADESMEM_DETAIL_STATIC_ASSERT(std::is_integral<T>::value);
-  std::basic_ostringstream<CharT> converter;
-  converter.imbue(std::locale::classic());
-  if (!converter || !(converter << (hex ? std::hex : std::dec) << num))
-  {
-    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
-                                    << ErrorString{"Conversion failed."});
-  }
-  return converter.str();
-}
-
-inline std::string WideCharToMultiByte(std::string const& in,
-                                       bool* lossy = nullptr)
-{
-  if (lossy)
-  {
-    *lossy = false;
-  }
-
-  return in;
-}
-
-inline std::string WideCharToMultiByte(std::wstring const& in,
-                                       bool* lossy = nullptr)
-{
-  std::int32_t const buf_len = ::WideCharToMultiByte(CP_OEMCP,
-                                                     WC_NO_BEST_FIT_CHARS,
-                                                     in.c_str(),
-                                                     -1,
-                                                     nullptr,
-                                                     0,
-                                                     nullptr,
-                                                     nullptr);
-  if (!buf_len)
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"WideCharToMultiByte failed."}
-              << ErrorCodeWinLast{last_error});
-  }
-  HADESMEM_DETAIL_ASSERT(buf_len > 0);
-
-  std::vector<char> buf(static_cast<std::size_t>(buf_len));
-  BOOL lossy_tmp = FALSE;
-  if (!::WideCharToMultiByte(CP_OEMCP,
-                             WC_NO_BEST_FIT_CHARS,
-                             in.c_str(),
-                             -1,
-                             buf.data(),
-                             buf_len,
-                             nullptr,
-                             &lossy_tmp))
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"WideCharToMultiByte failed."}
-              << ErrorCodeWinLast{last_error});
-  }
-
-  if (lossy)
-  {
-    *lossy = !!lossy_tmp;
-  }
-
-  return buf.data();
-}
-
-inline std::wstring MultiByteToWideChar(std::wstring const& in)
-{
-  return in;
-}
-
-inline std::wstring MultiByteToWideChar(std::string const& in)
-{
-  std::int32_t const buf_len = ::MultiByteToWideChar(
-    CP_OEMCP, MB_ERR_INVALID_CHARS, in.c_str(), -1, nullptr, 0);
-  if (!buf_len)
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"MultiByteToWideChar failed."}
-              << ErrorCodeWinLast{last_error});
-  }
-  HADESMEM_DETAIL_ASSERT(buf_len > 0);
-
-  std::vector<wchar_t> buf(static_cast<std::size_t>(buf_len));
-  if (!::MultiByteToWideChar(
-        CP_OEMCP, MB_ERR_INVALID_CHARS, in.c_str(), -1, buf.data(), buf_len))
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(
-      Error{} << ErrorString{"MultiByteToWideChar failed."}
-              << ErrorCodeWinLast{last_error});
-  }
-
-  return buf.data();
-}
-}
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+
+namespace hadesmem
+{
+namespace detail
+{
+template <typename CharT>
+inline std::uintptr_t HexStrToPtrT(std::basic_string<CharT> const& str)
+{
+  std::basic_stringstream<CharT> ss{str};
+  ss.imbue(std::locale::classic());
+  std::uintptr_t ptr = 0;
+  if (!(ss >> std::hex >> ptr))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"String to pointer conversion failed."});
+  }
+  return ptr;
+}
+
+inline std::uintptr_t HexStrToPtr(std::string const& str)
+{
+  return HexStrToPtrT<char>(str);
+}
+
+inline std::uintptr_t HexStrToPtr(std::wstring const& str)
+{
+  return HexStrToPtrT<wchar_t>(str);
+}
+
+template <typename CharT = wchar_t>
+inline std::basic_string<CharT> PtrToHexString(void const* const ptr)
+{
+  std::basic_ostringstream<CharT> ss;
+  ss.imbue(std::locale::classic());
+  if (!(ss << std::hex << reinterpret_cast<std::uintptr_t>(ptr)))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Pointer to string conversion failed."});
+  }
+  return ss.str();
+}
+
+template <typename T, typename CharT>
+T StrToNum(std::basic_string<CharT> const& str, bool hex = false)
+{
+  HADESMEM_DETAIL_STATIC_ASSERT(std::is_integral<T>::value);
+  std::basic_istringstream<CharT> converter{str};
+  converter.imbue(std::locale::classic());
+  T out;
+  if (!converter || !(converter >> (hex ? std::hex : std::dec) >> out))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"Conversion failed."});
+  }
+  return out;
+}
+
+template <typename CharT, typename T>
+std::basic_string<CharT> NumToStr(T num, bool hex = false)
+{
+  HADESMEM_DETAIL_STATIC_ASSERT(std::is_integral<T>::value);
+  std::basic_ostringstream<CharT> converter;
+  converter.imbue(std::locale::classic());
+  if (!converter || !(converter << (hex ? std::hex : std::dec) << num))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"Conversion failed."});
+  }
+  return converter.str();
+}
+
+inline std::string WideCharToMultiByte(std::string const& in,
+                                       bool* lossy = nullptr)
+{
+  if (lossy)
+  {
+    *lossy = false;
+  }
+
+  return in;
+}
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline std::string WideCharToMultiByte(std::wstring const& in,
+                                       bool* lossy = nullptr)
+{
+  std::int32_t const buf_len = ::WideCharToMultiByte(CP_OEMCP,
+                                                     WC_NO_BEST_FIT_CHARS,
+                                                     in.c_str(),
+                                                     -1,
+                                                     nullptr,
+                                                     0,
+                                                     nullptr,
+                                                     nullptr);
+  if (!buf_len)
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"WideCharToMultiByte failed."}
+              << ErrorCodeWinLast{last_error});
+  }
+  HADESMEM_DETAIL_ASSERT(buf_len > 0);
+
+  std::vector<char> buf(static_cast<std::size_t>(buf_len));
+  BOOL lossy_tmp = FALSE;
+  if (!::WideCharToMultiByte(CP_OEMCP,
+                             WC_NO_BEST_FIT_CHARS,
+                             in.c_str(),
+                             -1,
+                             buf.data(),
+                             buf_len,
+                             nullptr,
+                             &lossy_tmp))
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"WideCharToMultiByte failed."}
+              << ErrorCodeWinLast{last_error});
+  }
+
+  if (lossy)
+  {
+    *lossy = !!lossy_tmp;
+  }
+
+  return buf.data();
+}
+
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+// wchar_t is UTF-32 on Linux, and UTF-8 is the only multi-byte encoding worth
+// caring about, so do the conversion by hand rather than depending on the
+// global C locale.
+inline std::string WideCharToMultiByte(std::wstring const& in,
+                                       bool* lossy = nullptr)
+{
+  bool lossy_tmp = false;
+  std::string out;
+  out.reserve(in.size());
+  for (auto const c : in)
+  {
+    auto cp = static_cast<std::uint32_t>(c);
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+    {
+      cp = '?';
+      lossy_tmp = true;
+    }
+
+    if (cp < 0x80)
+    {
+      out.push_back(static_cast<char>(cp));
+    }
+    else if (cp < 0x800)
+    {
+      out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    else if (cp < 0x10000)
+    {
+      out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    else
+    {
+      out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+  }
+
+  if (lossy)
+  {
+    *lossy = lossy_tmp;
+  }
+
+  return out;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+// #elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+inline std::wstring MultiByteToWideChar(std::wstring const& in)
+{
+  return in;
+}
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline std::wstring MultiByteToWideChar(std::string const& in)
+{
+  std::int32_t const buf_len = ::MultiByteToWideChar(
+    CP_OEMCP, MB_ERR_INVALID_CHARS, in.c_str(), -1, nullptr, 0);
+  if (!buf_len)
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"MultiByteToWideChar failed."}
+              << ErrorCodeWinLast{last_error});
+  }
+  HADESMEM_DETAIL_ASSERT(buf_len > 0);
+
+  std::vector<wchar_t> buf(static_cast<std::size_t>(buf_len));
+  if (!::MultiByteToWideChar(
+        CP_OEMCP, MB_ERR_INVALID_CHARS, in.c_str(), -1, buf.data(), buf_len))
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"MultiByteToWideChar failed."}
+              << ErrorCodeWinLast{last_error});
+  }
+
+  return buf.data();
+}
+
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+inline std::wstring MultiByteToWideChar(std::string const& in)
+{
+  std::wstring out;
+  out.reserve(in.size());
+  for (std::size_t i = 0; i < in.size();)
+  {
+    auto const lead = static_cast<std::uint8_t>(in[i]);
+    std::size_t len = 0;
+    if (lead < 0x80)
+    {
+      len = 1;
+    }
+    else if ((lead >> 5) == 0x6)
+    {
+      len = 2;
+    }
+    else if ((lead >> 4) == 0xE)
+    {
+      len = 3;
+    }
+    else if ((lead >> 3) == 0x1E)
+    {
+      len = 4;
+    }
+
+    if (!len || i + len > in.size())
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Invalid UTF-8 sequence."});
+    }
+
+    std::uint32_t cp = len == 1 ? lead : lead & (0x7F >> len);
+    for (std::size_t j = 1; j < len; ++j)
+    {
+      auto const cont = static_cast<std::uint8_t>(in[i + j]);
+      if ((cont & 0xC0) != 0x80)
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"Invalid UTF-8 sequence."});
+      }
+      cp = (cp << 6) | (cont & 0x3F);
+    }
+
+    out.push_back(static_cast<wchar_t>(cp));
+    i += len;
+  }
+
+  return out;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+// #elif defined(HADESMEM_DETAIL_OS_LINUX)
+}
+}
@@ -42,8 +42,8 @@ struct x64LeaInstruction
 };
 #pragma pack(pop)
 
-inline winternl::PVECTORED_HANDLER_ENTRY
-  GetVectoredEhPointer(hadesmem::Process const& process)
+inline winternl::PVECTORED_HANDLER_LIST
+  GetVectoredHandlerList(hadesmem::Process const& process)
 {
 #if defined(HADESMEM_DETAIL_ARCH_X86)
   using InstructionPtrT = x86AddInstruction;
@@ -87,7 +87,13 @@ inline winternl::PVECTORED_HANDLER_ENTRY
 #error "[HadesMem] Unsupported architecture."
 #endif
 
-  return vectored_handler_list->First;
+  return vectored_handler_list;
+}
+
+inline winternl::PVECTORED_HANDLER_ENTRY
+  GetVectoredEhPointer(hadesmem::Process const& process)
+{
+  return GetVectoredHandlerList(process)->First;
 }
 }
 }
\ No newline at end of file
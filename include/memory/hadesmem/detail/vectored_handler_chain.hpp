@@ -0,0 +1,486 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/scanner.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <windows.h>
+
+#include <hadesmem/alloc.hpp>
+#include <hadesmem/call.hpp>
+#include <hadesmem/detail/vectored_handler.hpp>
+#include <hadesmem/detail/winternl.hpp>
+#include <hadesmem/module.hpp>
+#include <hadesmem/module_list.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/process_helpers.hpp>
+#include <hadesmem/read.hpp>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// Reads a VEH chain out of any ScanSource (a live process, a MemorySnapshot,
+// or buffers captured elsewhere) rather than by dereferencing the list in the
+// current process like VectoredHandlerList does. Each page the walk touches
+// is read once, entries are parsed straight out of the cached pages, the
+// encoded handler pointers are decoded together at the end, and handlers are
+// resolved to their owning module with a binary search over a sorted module
+// table. Everything except finding the list and the cookie in a live process
+// is OS independent, so it can be tested against captured memory on Linux.
+
+namespace hadesmem
+{
+namespace detail
+{
+// Shape of a VEH list entry. The entry starts with a LIST_ENTRY on every
+// version, but the handler moved when the ref count became a pointer to a
+// separately allocated ref count (Windows 8).
+struct VectoredHandlerLayout
+{
+  bool is_64;
+  std::size_t handler_offset;
+};
+
+inline VectoredHandlerLayout GetVectoredHandlerLayout(bool is_64,
+                                                      bool is_win8_or_later)
+{
+  std::size_t const ptr_size = is_64 ? 8 : 4;
+  return VectoredHandlerLayout{is_64,
+                               ptr_size * (is_win8_or_later ? 4 : 3)};
+}
+
+// Same as RtlEncodePointer/RtlDecodePointer given the process cookie.
+inline std::uint64_t EncodeVectoredHandlerPointer(std::uint64_t ptr,
+                                                  std::uint32_t cookie,
+                                                  bool is_64) noexcept
+{
+  if (is_64)
+  {
+    std::uint64_t const value = ptr ^ cookie;
+    unsigned const shift = cookie & 0x3F;
+    return shift ? (value >> shift) | (value << (64 - shift)) : value;
+  }
+
+  std::uint32_t const value = static_cast<std::uint32_t>(ptr) ^ cookie;
+  unsigned const shift = cookie & 0x1F;
+  return shift ? (value >> shift) | (value << (32 - shift)) : value;
+}
+
+// Decodes in place. Kept as a tight loop over a flat array (rather than
+// decoding while walking the list) so it vectorizes.
+inline void DecodeVectoredHandlerPointers(std::uint64_t* ptrs,
+                                          std::size_t count,
+                                          std::uint32_t cookie,
+                                          bool is_64) noexcept
+{
+  if (is_64)
+  {
+    unsigned const shift = cookie & 0x3F;
+    unsigned const back = (64 - shift) & 0x3F;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      ptrs[i] = ((ptrs[i] << shift) | (ptrs[i] >> back)) ^ cookie;
+    }
+  }
+  else
+  {
+    unsigned const shift = cookie & 0x1F;
+    unsigned const back = (32 - shift) & 0x1F;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      std::uint32_t const value = static_cast<std::uint32_t>(ptrs[i]);
+      ptrs[i] = ((value << shift) | (value >> back)) ^ cookie;
+    }
+  }
+}
+
+std::size_t const kNoModuleIndex = static_cast<std::size_t>(-1);
+
+// Non-overlapping [base, base + size) intervals, each with a name, searched
+// with a binary search.
+class ModuleIntervalTable
+{
+public:
+  void Add(std::uintptr_t base, std::size_t size, std::wstring name)
+  {
+    modules_.push_back(Entry{base, base + size, std::move(name)});
+  }
+
+  // Must be called after adding modules and before querying.
+  void Finalize()
+  {
+    std::sort(std::begin(modules_),
+              std::end(modules_),
+              [](Entry const& lhs, Entry const& rhs) {
+                return lhs.base < rhs.base;
+              });
+  }
+
+  // Index of the module containing address, or kNoModuleIndex.
+  std::size_t Find(std::uintptr_t address) const noexcept
+  {
+    auto const iter = std::upper_bound(
+      std::begin(modules_),
+      std::end(modules_),
+      address,
+      [](std::uintptr_t a, Entry const& e) { return a < e.base; });
+    if (iter == std::begin(modules_) || address >= (iter - 1)->end)
+    {
+      return kNoModuleIndex;
+    }
+
+    return static_cast<std::size_t>(iter - 1 - std::begin(modules_));
+  }
+
+  // Only valid for indices returned by Find.
+  std::wstring const& GetName(std::size_t index) const
+  {
+    return modules_[index].name;
+  }
+
+  std::uintptr_t GetBase(std::size_t index) const
+  {
+    return modules_[index].base;
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return modules_.size();
+  }
+
+private:
+  struct Entry
+  {
+    std::uintptr_t base;
+    std::uintptr_t end;
+    std::wstring name;
+  };
+
+  std::vector<Entry> modules_;
+};
+
+std::size_t const kScanSourcePageSize = 0x1000;
+
+// Reads whole pages from a ScanSource the first time they're touched, so a
+// walk which visits several entries in the same heap page only pays for one
+// read (i.e. one ReadProcessMemory for a live process).
+class ScanSourcePageCache
+{
+public:
+  explicit ScanSourcePageCache(ScanSource const& source) : source_{&source}
+  {
+  }
+
+  explicit ScanSourcePageCache(ScanSource&& source) = delete;
+
+  void Read(std::uintptr_t address, void* data, std::size_t len)
+  {
+    auto out = static_cast<std::uint8_t*>(data);
+    while (len)
+    {
+      std::uintptr_t const page = address & ~(kScanSourcePageSize - 1);
+      std::size_t const offset = address - page;
+      std::size_t const chunk = (std::min)(len, kScanSourcePageSize - offset);
+      auto const cached = GetPage(page);
+      if (cached)
+      {
+        std::memcpy(out, cached + offset, chunk);
+      }
+      else if (!source_->Read(address, out, chunk))
+      {
+        HADESMEM_DETAIL_THROW_EXCEPTION(
+          Error{} << ErrorString{"Failed to read VEH chain memory."});
+      }
+
+      address += chunk;
+      out += chunk;
+      len -= chunk;
+    }
+  }
+
+  std::uint64_t ReadPointer(std::uintptr_t address, bool is_64)
+  {
+    if (is_64)
+    {
+      std::uint64_t value;
+      Read(address, &value, sizeof(value));
+      return value;
+    }
+
+    std::uint32_t value;
+    Read(address, &value, sizeof(value));
+    return value;
+  }
+
+  std::size_t GetNumPages() const noexcept
+  {
+    return pages_.size();
+  }
+
+private:
+  // Null if the page isn't fully readable (e.g. a captured buffer which
+  // doesn't cover the whole page), in which case the caller reads directly.
+  std::uint8_t const* GetPage(std::uintptr_t page)
+  {
+    auto iter = pages_.find(page);
+    if (iter == std::end(pages_))
+    {
+      std::vector<std::uint8_t> data(kScanSourcePageSize);
+      if (!source_->Read(page, data.data(), data.size()))
+      {
+        data.clear();
+      }
+      iter = pages_.emplace(page, std::move(data)).first;
+    }
+
+    return iter->second.empty() ? nullptr : iter->second.data();
+  }
+
+  ScanSource const* source_;
+  std::map<std::uintptr_t, std::vector<std::uint8_t>> pages_;
+};
+
+struct VectoredHandlerInfo
+{
+  std::uintptr_t entry;
+  std::uintptr_t handler;
+  // Index into the module table, or kNoModuleIndex.
+  std::size_t module;
+};
+
+// Upper bound on the chain length, so a corrupt (e.g. cyclic) list can't
+// hang the walk.
+std::size_t const kMaxVectoredHandlers = 0x10000;
+
+// list is the address of the list head, i.e. the SRW lock followed by the
+// LIST_ENTRY the chain hangs off.
+inline std::vector<VectoredHandlerInfo>
+  ReadVectoredHandlerChain(ScanSource const& source,
+                           std::uintptr_t list,
+                           std::uint32_t cookie,
+                           VectoredHandlerLayout const& layout,
+                           ModuleIntervalTable const* modules = nullptr)
+{
+  ScanSourcePageCache cache{source};
+  std::size_t const ptr_size = layout.is_64 ? 8 : 4;
+  std::uint64_t const head = list + ptr_size;
+
+  std::vector<std::uintptr_t> entries;
+  std::vector<std::uint64_t> handlers;
+  for (std::uint64_t entry = cache.ReadPointer(head, layout.is_64);
+       entry != head;
+       entry = cache.ReadPointer(static_cast<std::uintptr_t>(entry),
+                                 layout.is_64))
+  {
+    if (!entry)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Null link in VEH chain."});
+    }
+
+    if (entries.size() == kMaxVectoredHandlers)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"VEH chain is too long or cyclic."});
+    }
+
+    auto const entry_addr = static_cast<std::uintptr_t>(entry);
+    entries.push_back(entry_addr);
+    handlers.push_back(
+      cache.ReadPointer(entry_addr + layout.handler_offset, layout.is_64));
+  }
+
+  DecodeVectoredHandlerPointers(
+    handlers.data(), handlers.size(), cookie, layout.is_64);
+
+  std::vector<VectoredHandlerInfo> chain;
+  chain.reserve(entries.size());
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    auto const handler = static_cast<std::uintptr_t>(handlers[i]);
+    chain.push_back(VectoredHandlerInfo{
+      entries[i],
+      handler,
+      modules ? modules->Find(handler) : kNoModuleIndex});
+  }
+
+  return chain;
+}
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline FARPROC GetNtdllProc(char const* name)
+{
+  HMODULE const ntdll = ::GetModuleHandleW(L"ntdll.dll");
+  if (!ntdll)
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"GetModuleHandleW failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+
+  FARPROC const proc = ::GetProcAddress(ntdll, name);
+  if (!proc)
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"GetProcAddress failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+
+  return proc;
+}
+
+// RtlGetVersion rather than GetVersionEx, which lies to unmanifested
+// processes about anything newer than Windows 8.
+inline bool IsWindows8OrLater()
+{
+  using FnRtlGetVersion = NTSTATUS(NTAPI*)(PRTL_OSVERSIONINFOW info);
+  auto const rtl_get_version =
+    reinterpret_cast<FnRtlGetVersion>(GetNtdllProc("RtlGetVersion"));
+  RTL_OSVERSIONINFOW info{};
+  info.dwOSVersionInfoSize = sizeof(info);
+  NTSTATUS const get_version_result = rtl_get_version(&info);
+  if (!NT_SUCCESS(get_version_result))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"RtlGetVersion failed."}
+              << ErrorCodeWinStatus{get_version_result});
+  }
+
+  return info.dwMajorVersion > 6 ||
+         (info.dwMajorVersion == 6 && info.dwMinorVersion >= 2);
+}
+
+// The cookie can only be queried for the calling process (any other handle
+// gets STATUS_INVALID_PARAMETER), so for a remote process the query is run
+// in the target via Call. ntdll is at the same address in every process of
+// the same bitness, so our pointer to NtQueryInformationProcess is valid
+// there too.
+inline std::uint32_t GetProcessCookie(Process const& process)
+{
+  // Takes the info class as a ULONG rather than PROCESSINFOCLASS, because
+  // Call doesn't support enum parameters.
+  using FnNtQueryInformationProcess = NTSTATUS(NTAPI*)(HANDLE process,
+                                                       ULONG info_class,
+                                                       PVOID info,
+                                                       ULONG info_length,
+                                                       PULONG return_length);
+  auto const nt_query_information_process =
+    reinterpret_cast<FnNtQueryInformationProcess>(
+      GetNtdllProc("NtQueryInformationProcess"));
+
+  ULONG const kProcessCookie = 36;
+  // NtCurrentProcess()
+  auto const current_process = reinterpret_cast<HANDLE>(-1);
+
+  ULONG cookie = 0;
+  NTSTATUS query_cookie_result = 0;
+  if (process.GetId() == ::GetCurrentProcessId())
+  {
+    query_cookie_result =
+      nt_query_information_process(current_process,
+                                   kProcessCookie,
+                                   &cookie,
+                                   static_cast<ULONG>(sizeof(cookie)),
+                                   nullptr);
+  }
+  else
+  {
+    Allocator const remote_cookie{process, sizeof(cookie)};
+    query_cookie_result =
+      Call(process,
+           nt_query_information_process,
+           CallConv::kStdCall,
+           current_process,
+           kProcessCookie,
+           remote_cookie.GetBase(),
+           static_cast<ULONG>(sizeof(cookie)),
+           static_cast<PULONG>(nullptr))
+        .GetReturnValue();
+    if (NT_SUCCESS(query_cookie_result))
+    {
+      cookie = Read<ULONG>(process, remote_cookie.GetBase());
+    }
+  }
+
+  if (!NT_SUCCESS(query_cookie_result))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"NtQueryInformationProcess failed."}
+              << ErrorCodeWinStatus{query_cookie_result});
+  }
+
+  return cookie;
+}
+
+// Offset of the list from the base of ntdll. The pattern scan is only done
+// once, as it's the same for every process of the same bitness.
+inline std::uintptr_t GetVectoredHandlerListRva()
+{
+  static std::uintptr_t const rva = []() {
+    Process const local_process{::GetCurrentProcessId()};
+    auto const list =
+      reinterpret_cast<std::uintptr_t>(GetVectoredHandlerList(local_process));
+    Module const ntdll{local_process, L"ntdll.dll"};
+    return list - reinterpret_cast<std::uintptr_t>(ntdll.GetHandle());
+  }();
+  return rva;
+}
+
+struct VectoredHandlerChain
+{
+  std::vector<VectoredHandlerInfo> handlers;
+  ModuleIntervalTable modules;
+};
+
+// Works for any process with the same bitness as ours. For a remote process
+// this runs code in the target (see GetProcessCookie).
+inline VectoredHandlerChain ReadVectoredHandlerChain(Process const& process)
+{
+  if (IsWoW64(process) != IsWoW64(Process{::GetCurrentProcessId()}))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Cross-architecture VEH chains are not "
+                             "supported."});
+  }
+
+  Module const ntdll{process, L"ntdll.dll"};
+  std::uintptr_t const list =
+    reinterpret_cast<std::uintptr_t>(ntdll.GetHandle()) +
+    GetVectoredHandlerListRva();
+
+  VectoredHandlerChain chain;
+  ModuleList const module_list{process};
+  for (auto const& module : module_list)
+  {
+    chain.modules.Add(reinterpret_cast<std::uintptr_t>(module.GetHandle()),
+                      module.GetSize(),
+                      module.GetName());
+  }
+  chain.modules.Finalize();
+
+  auto const layout =
+    GetVectoredHandlerLayout(sizeof(void*) == 8, IsWindows8OrLater());
+  ProcessScanSource const source{process};
+  chain.handlers = ReadVectoredHandlerChain(
+    source, list, GetProcessCookie(process), layout, &chain.modules);
+  return chain;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+}
@@ -1,96 +1,209 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <cstddef>
-
-#include <windows.h>
-
-#include <hadesmem/detail/assert.hpp>
-#include <hadesmem/detail/protect_guard.hpp>
-#include <hadesmem/detail/query_region.hpp>
-#include <hadesmem/detail/type_traits.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/process.hpp>
-#include <hadesmem/protect.hpp>
-
-namespace hadesmem
-{
-namespace detail
-{
-inline void WriteUnchecked(Process const& process,
-                           PVOID address,
-                           LPCVOID data,
-                           std::size_t len)
-{
-  HADESMEM_DETAIL_ASSERT(address != nullptr);
-  HADESMEM_DETAIL_ASSERT(data != nullptr);
-  HADESMEM_DETAIL_ASSERT(len != 0);
-
-  SIZE_T bytes_written = 0;
-  if (!::WriteProcessMemory(
-        process.GetHandle(), address, data, len, &bytes_written) ||
-      bytes_written != len)
-  {
-    DWORD const last_error = ::GetLastError();
-    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
-                                    << ErrorString{"WriteProcessMemory failed."}
-                                    << ErrorCodeWinLast{last_error});
-  }
-}
-
-inline void WriteImpl(Process const& process,
-                      PVOID address,
-                      LPCVOID data,
-                      std::size_t len)
-{
-  HADESMEM_DETAIL_ASSERT(address != nullptr);
-  HADESMEM_DETAIL_ASSERT(data != nullptr);
-  HADESMEM_DETAIL_ASSERT(len != 0);
-
-  for (;;)
-  {
-    ProtectGuard protect_guard{process, address, ProtectGuardType::kWrite};
-
-    MEMORY_BASIC_INFORMATION const mbi = detail::Query(process, address);
-    void* const region_next =
-      static_cast<std::uint8_t*>(mbi.BaseAddress) + mbi.RegionSize;
-
-    void* const address_end = static_cast<std::uint8_t*>(address) + len;
-    if (address_end <= region_next)
-    {
-      WriteUnchecked(process, address, data, len);
-
-      protect_guard.Restore();
-
-      return;
-    }
-    else
-    {
-      std::size_t const len_new =
-        reinterpret_cast<std::uintptr_t>(region_next) -
-        reinterpret_cast<std::uintptr_t>(address);
-
-      WriteUnchecked(process, address, data, len_new);
-
-      protect_guard.Restore();
-
-      address = static_cast<std::uint8_t*>(address) + len_new;
-      data = static_cast<std::uint8_t const*>(data) + len_new;
-      len -= len_new;
-    }
-  }
-}
-
-template <typename T>
-void WriteImpl(Process const& process, PVOID address, T const& data)
-{
-  HADESMEM_DETAIL_STATIC_ASSERT(detail::IsTriviallyCopyable<T>::value);
-
-  HADESMEM_DETAIL_ASSERT(address != nullptr);
-
-  WriteImpl(process, address, std::addressof(data), sizeof(data));
-}
-}
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+
+#include <hadesmem/config.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+#include <cerrno>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
+
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/protect_guard.hpp>
+#include <hadesmem/detail/query_region.hpp>
+#include <hadesmem/detail/type_traits.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/protect.hpp>
+
+namespace hadesmem
+{
+namespace detail
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline void WriteUnchecked(Process const& process,
+                           PVOID address,
+                           LPCVOID data,
+                           std::size_t len)
+{
+  HADESMEM_DETAIL_ASSERT(address != nullptr);
+  HADESMEM_DETAIL_ASSERT(data != nullptr);
+  HADESMEM_DETAIL_ASSERT(len != 0);
+
+  SIZE_T bytes_written = 0;
+  if (!::WriteProcessMemory(
+        process.GetHandle(), address, data, len, &bytes_written) ||
+      bytes_written != len)
+  {
+    DWORD const last_error = ::GetLastError();
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"WriteProcessMemory failed."}
+                                    << ErrorCodeWinLast{last_error});
+  }
+}
+
+inline void WriteImpl(Process const& process,
+                      PVOID address,
+                      LPCVOID data,
+                      std::size_t len)
+{
+  HADESMEM_DETAIL_ASSERT(address != nullptr);
+  HADESMEM_DETAIL_ASSERT(data != nullptr);
+  HADESMEM_DETAIL_ASSERT(len != 0);
+
+  for (;;)
+  {
+    ProtectGuard protect_guard{process, address, ProtectGuardType::kWrite};
+
+    MEMORY_BASIC_INFORMATION const mbi = detail::Query(process, address);
+    void* const region_next =
+      static_cast<std::uint8_t*>(mbi.BaseAddress) + mbi.RegionSize;
+
+    void* const address_end = static_cast<std::uint8_t*>(address) + len;
+    if (address_end <= region_next)
+    {
+      WriteUnchecked(process, address, data, len);
+
+      protect_guard.Restore();
+
+      return;
+    }
+    else
+    {
+      std::size_t const len_new =
+        reinterpret_cast<std::uintptr_t>(region_next) -
+        reinterpret_cast<std::uintptr_t>(address);
+
+      WriteUnchecked(process, address, data, len_new);
+
+      protect_guard.Restore();
+
+      address = static_cast<std::uint8_t*>(address) + len_new;
+      data = static_cast<std::uint8_t const*>(data) + len_new;
+      len -= len_new;
+    }
+  }
+}
+
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+inline void WriteUnchecked(Process const& process,
+                           PVOID address,
+                           LPCVOID data,
+                           std::size_t len)
+{
+  HADESMEM_DETAIL_ASSERT(address != nullptr);
+  HADESMEM_DETAIL_ASSERT(data != nullptr);
+  HADESMEM_DETAIL_ASSERT(len != 0);
+
+  auto const pid = static_cast<::pid_t>(process.GetId());
+
+  std::size_t done = 0;
+  while (done < len)
+  {
+    ::iovec local{
+      const_cast<std::uint8_t*>(static_cast<std::uint8_t const*>(data)) + done,
+      len - done};
+    ::iovec remote{static_cast<std::uint8_t*>(address) + done, len - done};
+    ::ssize_t const bytes_written =
+      ::process_vm_writev(pid, &local, 1, &remote, 1, 0);
+    if (bytes_written <= 0)
+    {
+      break;
+    }
+
+    done += static_cast<std::size_t>(bytes_written);
+  }
+
+  if (done == len)
+  {
+    return;
+  }
+
+  // process_vm_writev honors page protections, whereas writes through the mem
+  // file are forced (like a debugger setting a breakpoint), which matches what
+  // the Windows backend does by temporarily changing the protection.
+  std::string const mem_path = "/proc/" + std::to_string(pid) + "/mem";
+  int const fd = ::open(mem_path.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd == -1)
+  {
+    int const last_error = errno;
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"Failed to open mem file."}
+                                    << ErrorCodeErrno{last_error});
+  }
+
+  int last_error = 0;
+  while (done < len)
+  {
+    auto const offset = reinterpret_cast<std::uintptr_t>(address) + done;
+#if defined(HADESMEM_DETAIL_ARCH_X86)
+    ::ssize_t const bytes_written =
+      ::pwrite64(fd,
+                 static_cast<std::uint8_t const*>(data) + done,
+                 len - done,
+                 static_cast<::off64_t>(offset));
+#else
+    ::ssize_t const bytes_written =
+      ::pwrite(fd,
+               static_cast<std::uint8_t const*>(data) + done,
+               len - done,
+               static_cast<::off_t>(offset));
+#endif
+    if (bytes_written <= 0)
+    {
+      last_error = bytes_written ? errno : EFAULT;
+      break;
+    }
+
+    done += static_cast<std::size_t>(bytes_written);
+  }
+
+  ::close(fd);
+
+  if (last_error)
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
+                                    << ErrorString{"Failed to write mem file."}
+                                    << ErrorCodeErrno{last_error});
+  }
+}
+
+// Protection is ignored by WriteUnchecked, and region queries are expensive,
+// so there is no reason to walk the regions like the Windows backend does.
+inline void WriteImpl(Process const& process,
+                      PVOID address,
+                      LPCVOID data,
+                      std::size_t len)
+{
+  HADESMEM_DETAIL_ASSERT(address != nullptr);
+  HADESMEM_DETAIL_ASSERT(data != nullptr);
+  HADESMEM_DETAIL_ASSERT(len != 0);
+
+  WriteUnchecked(process, address, data, len);
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+// #elif defined(HADESMEM_DETAIL_OS_LINUX)
+
+template <typename T>
+void WriteImpl(Process const& process, PVOID address, T const& data)
+{
+  HADESMEM_DETAIL_STATIC_ASSERT(detail::IsTriviallyCopyable<T>::value);
+
+  HADESMEM_DETAIL_ASSERT(address != nullptr);
+
+  WriteImpl(process, address, std::addressof(data), sizeof(data));
+}
+}
+}
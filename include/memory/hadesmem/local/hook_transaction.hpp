@@ -0,0 +1,305 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/thread_aux.hpp>
+#include <hadesmem/detail/trace.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/flush.hpp>
+#include <hadesmem/local/patch_detour_base.hpp>
+#include <hadesmem/local/patch_iat.hpp>
+#include <hadesmem/local/patch_vmt.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/thread.hpp>
+#include <hadesmem/thread_helpers.hpp>
+#include <hadesmem/thread_list.hpp>
+
+// Applies a batch of patches as a single operation. Everything which doesn't
+// touch live code (trampolines, stub gates, the bytes to write, lookup table
+// entries for exception based hooks, etc.) is prepared up front while the
+// process is still running. The process is then suspended once, threads
+// which are executing code about to be overwritten are moved to the
+// equivalent instruction in its trampoline, every patch is written, and the
+// instruction cache is flushed once. If anything fails, every patch (and
+// thread) is restored to its original state before the process is resumed.
+// A suspended thread may hold the heap lock, so the successful path doesn't
+// allocate between suspending and resuming (tracing included), unless more
+// threads need moving than were reserved for. Failing (i.e. throwing and
+// rolling back) may allocate. No bound is placed on how long the process
+// stays suspended; it grows with the number of patches and threads.
+
+// TODO: SuspendedProcess allocates as it builds its list of threads, after it
+// has suspended some of them.
+
+// TODO: Support removal as a transaction too. Currently every Remove suspends
+// the process separately.
+
+// TODO: Handle threads which are inside a function called from the patched
+// code (i.e. the return address is in the patched code).
+
+namespace hadesmem
+{
+class HookTransaction
+{
+public:
+  explicit HookTransaction(Process const& process) : process_{&process}
+  {
+    if (process.GetId() != ::GetCurrentProcessId())
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{
+          "HookTransaction only supported on local process."});
+    }
+  }
+
+  explicit HookTransaction(Process const&& process) = delete;
+
+  HookTransaction(HookTransaction const& other) = delete;
+
+  HookTransaction& operator=(HookTransaction const& other) = delete;
+
+  // Patches must outlive the call to Commit. Patches which are already
+  // applied when Commit is called are skipped.
+  void Add(PatchDetourBase& patch)
+  {
+    patches_.push_back(&patch);
+  }
+
+  template <typename TargetFuncT, typename ContextT>
+  void Add(PatchIat<TargetFuncT, ContextT>& patch)
+  {
+    for (auto const p : patch.GetPatches())
+    {
+      Add(*p);
+    }
+  }
+
+  void Add(PatchVmt& patch)
+  {
+    vmts_.push_back(&patch);
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return patches_.size() + vmts_.size();
+  }
+
+  void Commit()
+  {
+    std::vector<PatchDetourBase*> patches;
+    patches.reserve(patches_.size());
+    for (auto const p : patches_)
+    {
+      if (!p->IsApplied())
+      {
+        patches.push_back(p);
+      }
+    }
+
+    std::vector<PatchedRange> ranges;
+    ranges.reserve(patches.size());
+    std::size_t num_prepared = 0;
+    try
+    {
+      for (; num_prepared < patches.size(); ++num_prepared)
+      {
+        auto const p = patches[num_prepared];
+        p->PrepareApply();
+
+        auto const beg = reinterpret_cast<std::uintptr_t>(p->GetPatchedCode());
+        if (beg)
+        {
+          ranges.push_back(
+            PatchedRange{p, beg, beg + p->GetPatchedCodeSize()});
+        }
+      }
+    }
+    catch (...)
+    {
+      // The one which failed cleans up after itself.
+      while (num_prepared)
+      {
+        auto const p = patches[--num_prepared];
+        RollbackUnchecked([&]() { p->CancelApply(); });
+      }
+
+      throw;
+    }
+
+    // At most one fixup per thread. Threads created between counting and
+    // suspending are covered by the slack, otherwise push_back allocates.
+    std::vector<IpFixup> ip_fixups;
+    ip_fixups.reserve(CountThreads() + kThreadSlack);
+
+    {
+      SuspendedProcess const suspended_process{process_->GetId()};
+
+      std::size_t num_patches = 0;
+      std::size_t num_vmts = 0;
+      std::size_t num_ip_fixups = 0;
+      try
+      {
+        GetIpFixups(suspended_process, ranges, ip_fixups);
+
+        for (; num_patches < patches.size(); ++num_patches)
+        {
+          patches[num_patches]->CommitApply();
+        }
+
+        for (; num_vmts < vmts_.size(); ++num_vmts)
+        {
+          vmts_[num_vmts]->Apply();
+        }
+
+        for (; num_ip_fixups < ip_fixups.size(); ++num_ip_fixups)
+        {
+          auto& ip_fixup = ip_fixups[num_ip_fixups];
+          CONTEXT context = ip_fixup.context;
+          detail::SetThreadContextIp(context, ip_fixup.new_ip);
+          SetThreadContext(*ip_fixup.thread, context);
+        }
+
+        FlushInstructionCache(*process_, nullptr, 0);
+      }
+      catch (...)
+      {
+        HADESMEM_DETAIL_TRACE_A("Commit failed. Rolling back.");
+
+        while (num_ip_fixups)
+        {
+          auto const& ip_fixup = ip_fixups[--num_ip_fixups];
+          RollbackUnchecked(
+            [&]() { SetThreadContext(*ip_fixup.thread, ip_fixup.context); });
+        }
+
+        while (num_vmts)
+        {
+          auto const vmt = vmts_[--num_vmts];
+          RollbackUnchecked([&]() { vmt->Remove(); });
+        }
+
+        for (std::size_t i = num_patches; i < patches.size(); ++i)
+        {
+          auto const p = patches[i];
+          RollbackUnchecked([&]() { p->CancelApply(); });
+        }
+
+        while (num_patches)
+        {
+          auto const p = patches[--num_patches];
+          RollbackUnchecked([&]() { p->RollbackApply(); });
+        }
+
+        RollbackUnchecked(
+          [&]() { FlushInstructionCache(*process_, nullptr, 0); });
+
+        throw;
+      }
+    }
+
+    for (auto const& ip_fixup : ip_fixups)
+    {
+      (void)ip_fixup;
+      HADESMEM_DETAIL_TRACE_FORMAT_A(
+        "Moved thread 0n%lu from %p to %p.",
+        ip_fixup.thread_id,
+        reinterpret_cast<void*>(detail::GetThreadContextIp(ip_fixup.context)),
+        reinterpret_cast<void*>(ip_fixup.new_ip));
+    }
+
+    patches_.clear();
+    vmts_.clear();
+  }
+
+private:
+  struct IpFixup
+  {
+    // Only valid while the process is suspended.
+    Thread const* thread;
+    DWORD thread_id;
+    CONTEXT context;
+    std::uintptr_t new_ip;
+  };
+
+  struct PatchedRange
+  {
+    PatchDetourBase* patch;
+    std::uintptr_t beg;
+    std::uintptr_t end;
+  };
+
+  static std::size_t const kThreadSlack = 16;
+
+  std::size_t CountThreads() const
+  {
+    ThreadList const threads{process_->GetId()};
+    return static_cast<std::size_t>(
+      std::distance(std::begin(threads), std::end(threads)));
+  }
+
+  // Only allocates if there are more fixups than were reserved.
+  void GetIpFixups(SuspendedProcess const& suspended_process,
+                   std::vector<PatchedRange> const& ranges,
+                   std::vector<IpFixup>& ip_fixups) const
+  {
+    for (auto const& suspended_thread : suspended_process.GetThreads())
+    {
+      auto const& thread = suspended_thread.GetThread();
+      auto const context = GetThreadContext(thread, CONTEXT_CONTROL);
+      auto const ip = detail::GetThreadContextIp(context);
+
+      for (auto const& range : ranges)
+      {
+        if (ip < range.beg || ip >= range.end)
+        {
+          continue;
+        }
+
+        void* const new_ip =
+          range.patch->RemapPatchedIp(reinterpret_cast<void*>(ip));
+        if (!new_ip)
+        {
+          HADESMEM_DETAIL_THROW_EXCEPTION(
+            Error{} << ErrorString{
+              "Thread is currently executing patch target."});
+        }
+
+        ip_fixups.push_back(IpFixup{&thread,
+                                    thread.GetId(),
+                                    context,
+                                    reinterpret_cast<std::uintptr_t>(new_ip)});
+        break;
+      }
+    }
+  }
+
+  template <typename Func> static void RollbackUnchecked(Func func) noexcept
+  {
+    try
+    {
+      func();
+    }
+    catch (...)
+    {
+      // WARNING: Patch (or thread) may be left modified if this fails.
+      HADESMEM_DETAIL_TRACE_A(
+        boost::current_exception_diagnostic_information().c_str());
+      HADESMEM_DETAIL_ASSERT(false);
+    }
+  }
+
+  Process const* process_;
+  std::vector<PatchDetourBase*> patches_;
+  std::vector<PatchVmt*> vmts_;
+};
+}
@@ -4,7 +4,6 @@
 #pragma once
 
 #include <atomic>
-#include <climits>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -14,17 +13,17 @@
 #include <utility>
 #include <vector>
 
-#include <hadesmem/detail/warning_disable_prefix.hpp>
-#include <udis86.h>
-#include <hadesmem/detail/warning_disable_suffix.hpp>
-
 #include <windows.h>
 
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/alias_cast.hpp>
 #include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/code_slab.hpp>
+#include <hadesmem/detail/disassembly_cache.hpp>
+#include <hadesmem/detail/insn_relocator.hpp>
 #include <hadesmem/detail/patch_code_gen.hpp>
 #include <hadesmem/detail/patch_detour_stub.hpp>
+#include <hadesmem/detail/patch_ip_map.hpp>
 #include <hadesmem/detail/patcher_aux.hpp>
 #include <hadesmem/detail/scope_warden.hpp>
 #include <hadesmem/detail/srw_lock.hpp>
@@ -42,14 +41,6 @@
 #include <hadesmem/thread_helpers.hpp>
 #include <hadesmem/write.hpp>
 
-// TODO: Make hooking a transactional operation (i.e. fix exception guarantees
-// etc.).
-
-// TODO: Consolidate all memory allocations where possible. Using a minimum of
-// one page (and potentially multiple pages) for each detour is extremely
-// wasteful and could be causing memory pressure in some applications. Perhaps
-// some sort of remote heap that we can share across all detour types.
-
 // TODO: Add new Symbol class (or something along those lines) for looking up
 // function addresses in system DLLs that we want to hook.
 
@@ -109,6 +100,8 @@ public:
       HADESMEM_DETAIL_THROW_EXCEPTION(
         Error{} << ErrorString{"PatchDetour only supported on local process."});
     }
+
+    InitProfile(target_);
   }
 
   explicit PatchDetour(Process const&& process,
@@ -128,7 +121,9 @@ public:
       trampoline_{std::move(other.trampoline_)},
       stub_gate_{std::move(other.stub_gate_)},
       orig_(std::move(other.orig_)),
+      patch_code_(std::move(other.patch_code_)),
       trampolines_(std::move(other.trampolines_)),
+      ip_map_(std::move(other.ip_map_)),
       ref_count_{other.ref_count_.load()},
       stub_{other.stub_},
       context_(std::move(other.context_))
@@ -137,6 +132,8 @@ public:
     other.applied_ = false;
     other.target_ = nullptr;
     other.stub_ = nullptr;
+
+    MoveProfile(other);
   }
 
   PatchDetour& operator=(PatchDetour&& other)
@@ -159,8 +156,12 @@ public:
 
     orig_ = std::move(other.orig_);
 
+    patch_code_ = std::move(other.patch_code_);
+
     trampolines_ = std::move(other.trampolines_);
 
+    ip_map_ = std::move(other.ip_map_);
+
     ref_count_ = other.ref_count_.load();
 
     stub_ = other.stub_;
@@ -168,6 +169,8 @@ public:
 
     context_ = std::move(other.context_);
 
+    MoveProfile(other);
+
     return *this;
   }
 
@@ -189,14 +192,13 @@ public:
       return;
     }
 
-    // Reset the trampolines here because we don't do it in remove, otherwise
-    // there's a potential race condition where we want to unhook and unload
-    // safely, so we unhook the function, then try waiting on our ref count to
-    // become zero, but we haven't actually called the trampoline yet, so we end
-    // up jumping to the memory we just free'd!
-    trampoline_ = nullptr;
-    trampolines_.clear();
-    stub_gate_ = nullptr;
+    PrepareApply();
+
+    auto const cancel_apply = [&]() { CancelApply(); };
+    auto scope_cancel_apply = detail::MakeScopeWarden(cancel_apply);
+
+    FlushInstructionCache(
+      process_, trampoline_->GetBase(), trampoline_->GetSize());
 
     // TODO: Narrow the scope of the suspension to only the point where we
     // actually do the hook, because a thread might hold a lock we need (e.g.
@@ -204,14 +206,47 @@ public:
     // TODO: Make suspension optional, as in some cases we know that all the
     // threads are suspended already (e.g. creation-time injection).
     // Need to fix the potential deadlock problem, as well as the perf
-    // problem, before re-enabling this.
+    // problem, before re-enabling this. Use HookTransaction in the meantime,
+    // which suspends once for any number of hooks and moves threads out of
+    // the patched code.
     // SuspendedProcess const suspended_process{process_.GetId()};
 
-    std::uint32_t const kMaxInstructionLen = 15;
-    std::uint32_t const kTrampSize = kMaxInstructionLen * 3;
+    detail::VerifyPatchThreads(process_.GetId(), target_, orig_.size());
+
+    CommitApply();
 
-    trampoline_ = std::make_unique<Allocator>(process_, kTrampSize);
-    auto tramp_cur = static_cast<std::uint8_t*>(trampoline_->GetBase());
+    scope_cancel_apply.Dismiss();
+
+    FlushInstructionCache(process_, target_, orig_.size());
+  }
+
+  virtual void PrepareApply() override
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+    HADESMEM_DETAIL_ASSERT(!detached_);
+
+    // Reset the trampolines here because we don't do it in remove, otherwise
+    // there's a potential race condition where we want to unhook and unload
+    // safely, so we unhook the function, then try waiting on our ref count to
+    // become zero, but we haven't actually called the trampoline yet, so we end
+    // up jumping to the memory we just free'd!
+    trampoline_ = nullptr;
+    trampolines_.clear();
+    stub_gate_ = nullptr;
+    ip_map_.Clear();
+    patch_code_.clear();
+
+    std::uint32_t const kReadSize = detail::kMaxInsnLength * 3;
+    // Relocated branches can be larger than the originals (e.g. a 2 byte short
+    // jump becomes a 14 byte absolute jump), so leave room for every
+    // instruction in the patch to grow.
+    std::size_t const kTrampSize = 256;
+
+    // Allocate near the target where possible so relocated branches and
+    // RIP-relative operands can stay relative.
+    auto& code_slab = detail::GetLocalCodeSlab();
+    trampoline_ = std::make_unique<detail::CodeSlot>(
+      code_slab.AllocateNear(target_, kTrampSize));
 
     auto const detour_raw = detour_.target<DetourFuncRawT>();
     (void)detour_raw;
@@ -222,130 +257,60 @@ public:
       detour_raw,
       trampoline_->GetBase());
 
-    auto const buffer = ReadVector<std::uint8_t>(process_, target_, kTrampSize);
-
-    // TODO: Port to use Capstone instead.
-    // TODO: Add a disassembler module to abstract away the actual disassembly
-    // library being used (so later it can be replaced with a custom one, or
-    // support multiple backends, etc). Also useful when writing other tools
-    // like a standalone debugger/disassembler, memory editor, etc.
-    ud_t ud_obj;
-    ud_init(&ud_obj);
-    ud_set_input_buffer(&ud_obj, buffer.data(), buffer.size());
-    ud_set_syntax(&ud_obj, UD_SYN_INTEL);
-    ud_set_pc(&ud_obj, reinterpret_cast<std::uint64_t>(target_));
-#if defined(HADESMEM_DETAIL_ARCH_X64)
-    ud_set_mode(&ud_obj, 64);
-#elif defined(HADESMEM_DETAIL_ARCH_X86)
-    ud_set_mode(&ud_obj, 32);
-#else
-#error "[HadesMem] Unsupported architecture."
-#endif
+    auto const buffer = ReadVector<std::uint8_t>(process_, target_, kReadSize);
 
-    stub_gate_ = detail::AllocatePageNear(process_, target_);
+    stub_gate_ = std::make_unique<detail::CodeSlot>(
+      code_slab.AllocateNear(target_,
+                             detail::PatchConstants::kMaxStubGateSize));
 
     std::size_t const patch_size = GetPatchSize();
 
     // TODO: Detect backward jumps into the detour and fail/notify/etc.
-    std::uint32_t instr_size = 0;
-    do
-    {
-      std::uint32_t const len = ud_disassemble(&ud_obj);
-      if (len == 0)
-      {
-        HADESMEM_DETAIL_THROW_EXCEPTION(Error{}
-                                        << ErrorString{"Disassembly failed."});
-      }
-
-#if !defined(HADESMEM_NO_TRACE)
-      char const* const asm_str = ud_insn_asm(&ud_obj);
-      char const* const asm_bytes_str = ud_insn_hex(&ud_obj);
-      HADESMEM_DETAIL_TRACE_FORMAT_A(
-        "%s. [%s].",
-        (asm_str ? asm_str : "Invalid."),
-        (asm_bytes_str ? asm_bytes_str : "Invalid."));
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+    detail::InsnMode const mode = detail::InsnMode::kX64;
+#elif defined(HADESMEM_DETAIL_ARCH_X86)
+    detail::InsnMode const mode = detail::InsnMode::kX86;
+#else
+#error "[HadesMem] Unsupported architecture."
 #endif
+    // Re-applying a hook (or hooking something in a chain again) decodes the
+    // same prologue, so go through the cache.
+    // The built-in decoder rather than udis86, as relocation only needs
+    // lengths and relative operands, which it has test coverage for (and which
+    // has been cross-checked against objdump). It also keeps udis86 out of
+    // everything which hooks. See insn_decoder.hpp for what it doesn't cover;
+    // anything it rejects fails the hook rather than being copied blindly.
+    detail::InsnDecoderDisassembler const disassembler{mode};
+    auto const insns = detail::GetLocalDisassemblyCache().DecodeUntil(
+      disassembler,
+      buffer.data(),
+      buffer.size(),
+      reinterpret_cast<std::uintptr_t>(target_),
+      patch_size);
+    auto relocated = detail::RelocateCode(
+      buffer.data(),
+      insns,
+      reinterpret_cast<std::uintptr_t>(target_),
+      reinterpret_cast<std::uintptr_t>(trampoline_->GetBase()),
+      mode,
+      [&](std::uint64_t address) -> std::uint64_t {
+        return reinterpret_cast<std::uintptr_t>(Read<void*>(
+          process_, reinterpret_cast<void*>(static_cast<std::uintptr_t>(
+                      address))));
+      });
+    if (relocated.code.size() > kTrampSize)
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Relocated code is too large for trampoline."});
+    }
 
-      // TODO: Improve support for rebuilding relative instructions, especially
-      // on x64.
-      ud_operand_t const* const op = ud_insn_opr(&ud_obj, 0);
-      bool is_jimm = op && op->type == UD_OP_JIMM;
-      // Handle JMP QWORD PTR [RIP+Rel32]. Necessary for hook chain support.
-      bool is_jmem = op && op->type == UD_OP_MEM && op->base == UD_R_RIP &&
-                     op->index == UD_NONE && op->scale == 0 && op->size == 0x40;
-      if ((ud_obj.mnemonic == UD_Ijmp || ud_obj.mnemonic == UD_Icall) && op &&
-          (is_jimm || is_jmem))
-      {
-        std::uint16_t const size = is_jimm ? op->size : op->offset;
-        HADESMEM_DETAIL_TRACE_FORMAT_A("Operand/offset size is %hu.", size);
-        std::int64_t const insn_target = [&]() -> std::int64_t {
-          switch (size)
-          {
-          case sizeof(std::int8_t) * CHAR_BIT:
-            return op->lval.sbyte;
-          case sizeof(std::int16_t) * CHAR_BIT:
-            return op->lval.sword;
-          case sizeof(std::int32_t) * CHAR_BIT:
-            return op->lval.sdword;
-          case sizeof(std::int64_t) * CHAR_BIT:
-            return op->lval.sqword;
-          default:
-            HADESMEM_DETAIL_ASSERT(false);
-            HADESMEM_DETAIL_THROW_EXCEPTION(
-              Error{} << ErrorString{"Unknown instruction size."});
-          }
-        }();
-
-        auto const resolve_rel =
-          [](std::uint64_t base, std::int64_t target, std::uint32_t insn_len) {
-            return reinterpret_cast<std::uint8_t*>(
-                     static_cast<std::uintptr_t>(base)) +
-                   target + insn_len;
-          };
-
-        std::uint64_t const insn_base = ud_insn_off(&ud_obj);
-        std::uint32_t const insn_len = ud_insn_len(&ud_obj);
-
-        auto const resolved_target =
-          resolve_rel(insn_base, insn_target, insn_len);
-        void* const jump_target =
-          is_jimm ? resolved_target : Read<void*>(process_, resolved_target);
-        HADESMEM_DETAIL_TRACE_FORMAT_A("Jump/call target = %p.", jump_target);
-        if (ud_obj.mnemonic == UD_Ijmp)
-        {
-          HADESMEM_DETAIL_TRACE_A("Writing resolved jump.");
-          tramp_cur += detail::WriteJump(
-            process_, tramp_cur, jump_target, true, &trampolines_);
-        }
-        else
-        {
-          HADESMEM_DETAIL_ASSERT(ud_obj.mnemonic == UD_Icall);
-          HADESMEM_DETAIL_TRACE_A("Writing resolved call.");
-          tramp_cur +=
-            detail::WriteCall(process_, tramp_cur, jump_target, trampolines_);
-        }
-      }
-      else
-      {
-        std::uint8_t const* const raw = ud_insn_ptr(&ud_obj);
-        Write(process_, tramp_cur, raw, raw + len);
-        tramp_cur += len;
-      }
-
-      instr_size += len;
-    } while (instr_size < patch_size);
-
-    HADESMEM_DETAIL_TRACE_A("Writing jump back to original code.");
-
-    tramp_cur +=
-      detail::WriteJump(process_,
-                        tramp_cur,
-                        reinterpret_cast<std::uint8_t*>(target_) + instr_size,
-                        true,
-                        &trampolines_);
+    HADESMEM_DETAIL_TRACE_FORMAT_A(
+      "Relocated %Iu bytes of code to %Iu bytes in trampoline.",
+      relocated.source_size,
+      relocated.code.size());
 
-    FlushInstructionCache(
-      process_, trampoline_->GetBase(), trampoline_->GetSize());
+    WriteVector(process_, trampoline_->GetBase(), relocated.code);
+    ip_map_ = std::move(relocated.ip_map);
 
     detail::WriteStubGate<TargetFuncT>(process_,
                                        stub_gate_->GetBase(),
@@ -355,15 +320,69 @@ public:
 
     orig_ = ReadVector<std::uint8_t>(process_, target_, patch_size);
 
-    detail::VerifyPatchThreads(process_.GetId(), target_, orig_.size());
+    PreparePatch();
+  }
 
-    WritePatch();
+  virtual void CommitApply() override
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+    HADESMEM_DETAIL_ASSERT(trampoline_);
 
-    FlushInstructionCache(process_, target_, instr_size);
+    WritePatch();
 
     applied_ = true;
   }
 
+  virtual void RollbackApply() override
+  {
+    if (!applied_)
+    {
+      return;
+    }
+
+    RemovePatch();
+
+    applied_ = false;
+  }
+
+  virtual void CancelApply() override
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+
+    CancelPatch();
+  }
+
+  virtual void* GetPatchedCode() const noexcept override
+  {
+    return target_;
+  }
+
+  virtual std::size_t GetPatchedCodeSize() const noexcept override
+  {
+    return orig_.size();
+  }
+
+  virtual void* RemapPatchedIp(void* ip) const noexcept override
+  {
+    auto const target_beg = static_cast<std::uint8_t*>(target_);
+    auto const ip_beg = static_cast<std::uint8_t*>(ip);
+    if (!trampoline_ || ip_beg < target_beg ||
+        ip_beg >= target_beg + orig_.size())
+    {
+      return nullptr;
+    }
+
+    std::size_t trampoline_offset = 0;
+    if (!ip_map_.Remap(static_cast<std::size_t>(ip_beg - target_beg),
+                       trampoline_offset))
+    {
+      return nullptr;
+    }
+
+    return static_cast<std::uint8_t*>(trampoline_->GetBase()) +
+           trampoline_offset;
+  }
+
   virtual void Remove() override
   {
     if (!applied_)
@@ -470,12 +489,27 @@ protected:
                      : detail::PatchConstants::kJmpSize64;
   }
 
-  virtual void WritePatch()
+  // Called at the end of PrepareApply. Generates everything WritePatch needs
+  // (including any trampoline for a far jump), so WritePatch doesn't allocate.
+  virtual void PreparePatch()
   {
-    HADESMEM_DETAIL_TRACE_A("Writing jump to stub.");
+    HADESMEM_DETAIL_TRACE_A("Generating jump to stub.");
 
-    detail::WriteJump(
+    patch_code_ = detail::GenJump(
       process_, target_, stub_gate_->GetBase(), false, &trampolines_);
+    HADESMEM_DETAIL_ASSERT(patch_code_.size() <= orig_.size());
+  }
+
+  virtual void WritePatch()
+  {
+    HADESMEM_DETAIL_ASSERT(!patch_code_.empty());
+
+    WriteVector(process_, target_, patch_code_);
+  }
+
+  // Undoes anything PreparePatch did outside of this object.
+  virtual void CancelPatch()
+  {
   }
 
   virtual void RemovePatch()
@@ -495,10 +529,12 @@ protected:
   bool detached_{false};
   void* target_{};
   DetourFuncT detour_{};
-  std::unique_ptr<Allocator> trampoline_{};
-  std::unique_ptr<Allocator> stub_gate_{};
+  std::unique_ptr<detail::CodeSlot> trampoline_{};
+  std::unique_ptr<detail::CodeSlot> stub_gate_{};
   std::vector<BYTE> orig_{};
-  std::vector<std::unique_ptr<Allocator>> trampolines_{};
+  std::vector<std::uint8_t> patch_code_{};
+  std::vector<detail::CodeSlot> trampolines_{};
+  detail::PatchIpMap ip_map_{};
   std::atomic<std::uint32_t> ref_count_{};
   std::unique_ptr<StubT> stub_{};
   ContextT context_;
@@ -4,12 +4,18 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/alias_cast.hpp>
 #include <hadesmem/detail/assert.hpp>
+#if defined(HADESMEM_DETOUR_PROFILE)
+#include <hadesmem/detail/hook_profile.hpp>
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
 #include <hadesmem/detail/thread_aux.hpp>
 #include <hadesmem/detail/type_traits.hpp>
 #include <hadesmem/error.hpp>
@@ -19,6 +25,11 @@
 
 namespace hadesmem
 {
+namespace detail
+{
+class HookProfile;
+}
+
 class PatchDetourBase
 {
 public:
@@ -48,6 +59,53 @@ public:
 
   virtual void const* GetContext() const noexcept = 0;
 
+  // Staged application, used by HookTransaction to apply many patches with
+  // the process only suspended once. PrepareApply does everything which
+  // doesn't touch live code (trampolines, stub gates, the bytes to write,
+  // etc.), then CommitApply writes the patch itself without allocating, as
+  // other threads may be suspended while holding the heap lock. Neither checks
+  // or suspends threads, or flushes the instruction cache. That's up to the
+  // caller.
+  virtual void PrepareApply()
+  {
+  }
+
+  virtual void CommitApply()
+  {
+    Apply();
+  }
+
+  // Undoes CommitApply. Only safe under the same conditions.
+  virtual void RollbackApply()
+  {
+    Remove();
+  }
+
+  // Undoes PrepareApply, for a patch whose CommitApply was never called (or
+  // failed).
+  virtual void CancelApply()
+  {
+  }
+
+  // Code overwritten by CommitApply (if any).
+  virtual void* GetPatchedCode() const noexcept
+  {
+    return nullptr;
+  }
+
+  virtual std::size_t GetPatchedCodeSize() const noexcept
+  {
+    return 0;
+  }
+
+  // Returns the equivalent location in the trampoline for an instruction in
+  // the patched code, or nullptr if there isn't one.
+  virtual void* RemapPatchedIp(void* ip) const noexcept
+  {
+    (void)ip;
+    return nullptr;
+  }
+
   virtual void* GetOriginalArbitraryUserPtr() const noexcept
   {
     return *GetOriginalArbitraryUserPtrPtr();
@@ -58,6 +116,17 @@ public:
     return *GetReturnAddressPtrPtr();
   }
 
+  // Call counts and timings for this hook. Always null unless built with
+  // HADESMEM_DETOUR_PROFILE.
+  detail::HookProfile* GetProfile() const noexcept
+  {
+#if defined(HADESMEM_DETOUR_PROFILE)
+    return profile_.get();
+#else  // #if defined(HADESMEM_DETOUR_PROFILE)
+    return nullptr;
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
+  }
+
   template <typename FuncT> FuncT GetTrampolineT() const noexcept
   {
     HADESMEM_DETAIL_STATIC_ASSERT(detail::IsFunction<FuncT>::value ||
@@ -66,6 +135,27 @@ public:
   }
 
 protected:
+  void InitProfile(void const* target)
+  {
+#if defined(HADESMEM_DETOUR_PROFILE)
+    profile_ = std::make_unique<detail::HookProfile>(target);
+#else  // #if defined(HADESMEM_DETOUR_PROFILE)
+    (void)target;
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
+  }
+
+  // For the move operations of derived types, which don't otherwise touch the
+  // base. The stub profiles through GetProfile, so the profile has to follow
+  // the hook rather than being left behind in the moved-from object.
+  void MoveProfile(PatchDetourBase& other) noexcept
+  {
+#if defined(HADESMEM_DETOUR_PROFILE)
+    profile_ = std::move(other.profile_);
+#else  // #if defined(HADESMEM_DETOUR_PROFILE)
+    (void)other;
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
+  }
+
   // WARNING! This will not work if TLS has not yet been initialized for the
   // thread.
   // TODO: Find a better way to implement this without the dependency on TLS.
@@ -82,5 +172,10 @@ protected:
     thread_local static void* ret_address_ptr = 0;
     return &ret_address_ptr;
   }
+
+private:
+#if defined(HADESMEM_DETOUR_PROFILE)
+  std::unique_ptr<detail::HookProfile> profile_;
+#endif // #if defined(HADESMEM_DETOUR_PROFILE)
 };
 }
\ No newline at end of file
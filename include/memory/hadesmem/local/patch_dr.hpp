@@ -14,10 +14,6 @@
 #include <utility>
 #include <vector>
 
-#include <hadesmem/detail/warning_disable_prefix.hpp>
-#include <udis86.h>
-#include <hadesmem/detail/warning_disable_suffix.hpp>
-
 #include <windows.h>
 
 #include <hadesmem/alloc.hpp>
@@ -26,7 +22,6 @@
 #include <hadesmem/detail/patch_detour_stub.hpp>
 #include <hadesmem/detail/patcher_aux.hpp>
 #include <hadesmem/detail/scope_warden.hpp>
-#include <hadesmem/detail/srw_lock.hpp>
 #include <hadesmem/detail/thread_aux.hpp>
 #include <hadesmem/detail/trace.hpp>
 #include <hadesmem/detail/type_traits.hpp>
@@ -84,13 +79,15 @@ public:
 
   PatchDr& operator=(PatchDr const& other) = delete;
 
-  PatchDr(PatchDr&& other) : PatchVeh{std::move(other)}
+  PatchDr(PatchDr&& other)
+    : PatchVeh{std::move(other)}, dr_index_{other.dr_index_}
   {
   }
 
   PatchDr& operator=(PatchDr&& other)
   {
     PatchVeh::operator=(std::move(other));
+    dr_index_ = other.dr_index_;
     return *this;
   }
 
@@ -102,32 +99,17 @@ protected:
     return 1;
   }
 
-  virtual void WritePatch() override
+  // The lookup table entries are added (and the debug register picked) up
+  // front, as they're inert until the debug register is set and adding them
+  // allocates.
+  virtual void PreparePatch() override
   {
-    hadesmem::detail::AcquireSRWLock const lock(
-      &GetSrwLock(), hadesmem::detail::SRWLockType::Exclusive);
-
-    auto& veh_hooks = GetVehHooks();
-
-    HADESMEM_DETAIL_ASSERT(veh_hooks.find(target_) == std::end(veh_hooks));
-    veh_hooks[target_] = this;
-
-    auto const veh_cleanup_hook = [&]() {
-      auto const veh_hooks_removed = veh_hooks.erase(target_);
-      (void)veh_hooks_removed;
-      HADESMEM_DETAIL_ASSERT(veh_hooks_removed);
-    };
-    auto scope_veh_cleanup_hook =
-      hadesmem::detail::MakeScopeWarden(veh_cleanup_hook);
-
-    HADESMEM_DETAIL_TRACE_A("Setting DR hook.");
-
     auto& dr_hooks = GetDrHooks();
     auto const thread_id = ::GetCurrentThreadId();
-    HADESMEM_DETAIL_ASSERT(dr_hooks.find(thread_id) == std::end(dr_hooks));
+    HADESMEM_DETAIL_ASSERT(!dr_hooks.Contains(thread_id));
 
     Thread const thread(thread_id);
-    auto context = GetThreadContext(thread, CONTEXT_DEBUG_REGISTERS);
+    auto const context = GetThreadContext(thread, CONTEXT_DEBUG_REGISTERS);
 
     std::uint32_t dr_index = static_cast<std::uint32_t>(-1);
     for (std::uint32_t i = 0; i < 4; ++i)
@@ -152,47 +134,76 @@ protected:
         Error{} << ErrorString{"No free debug registers."});
     }
 
-    dr_hooks[::GetCurrentThreadId()] = dr_index;
+    auto& veh_hooks = GetVehHooks();
+    auto const target = reinterpret_cast<std::uintptr_t>(target_);
+
+    bool const veh_hook_inserted =
+      veh_hooks.Insert(target, stub_gate_->GetBase());
+    (void)veh_hook_inserted;
+    HADESMEM_DETAIL_ASSERT(veh_hook_inserted);
 
-    auto const dr_cleanup_hook = [&]() {
-      auto const dr_hooks_removed = dr_hooks.erase(::GetCurrentThreadId());
-      (void)dr_hooks_removed;
-      HADESMEM_DETAIL_ASSERT(dr_hooks_removed);
+    auto const veh_cleanup_hook = [&]() {
+      auto const veh_hooks_removed = veh_hooks.Erase(target);
+      (void)veh_hooks_removed;
+      HADESMEM_DETAIL_ASSERT(veh_hooks_removed);
     };
-    auto scope_dr_cleanup_hook =
-      hadesmem::detail::MakeScopeWarden(dr_cleanup_hook);
+    auto scope_veh_cleanup_hook =
+      hadesmem::detail::MakeScopeWarden(veh_cleanup_hook);
+
+    bool const dr_hook_inserted = dr_hooks.Insert(thread_id, dr_index);
+    (void)dr_hook_inserted;
+    HADESMEM_DETAIL_ASSERT(dr_hook_inserted);
+
+    scope_veh_cleanup_hook.Dismiss();
+
+    dr_index_ = dr_index;
+
+    HADESMEM_DETAIL_TRACE_FORMAT_A("Using DR%u.", dr_index);
+  }
+
+  virtual void WritePatch() override
+  {
+    Thread const thread(::GetCurrentThreadId());
+    auto context = GetThreadContext(thread, CONTEXT_DEBUG_REGISTERS);
 
-    (&context.Dr0)[dr_index] = reinterpret_cast<std::uintptr_t>(target_);
+    (&context.Dr0)[dr_index_] = reinterpret_cast<std::uintptr_t>(target_);
     // Set appropriate L0-L3 flag
-    context.Dr7 |= static_cast<std::uintptr_t>(1ULL << (dr_index * 2));
+    context.Dr7 |= static_cast<std::uintptr_t>(1ULL << (dr_index_ * 2));
     // Set appropriate RW0-RW3 field (Execution)
     std::uintptr_t break_type = 0;
-    context.Dr7 |= (break_type << (16 + 4 * dr_index));
+    context.Dr7 |= (break_type << (16 + 4 * dr_index_));
     // Set appropriate LEN0-LEN3 field (1 byte)
     std::uintptr_t break_len = 0;
-    context.Dr7 |= (break_len << (18 + 4 * dr_index));
+    context.Dr7 |= (break_len << (18 + 4 * dr_index_));
     // Set LE flag
     std::uintptr_t local_enable = 1 << 8;
     context.Dr7 |= local_enable;
 
     SetThreadContext(thread, context);
+  }
 
-    scope_veh_cleanup_hook.Dismiss();
-    scope_dr_cleanup_hook.Dismiss();
+  virtual void CancelPatch() override
+  {
+    auto const dr_hooks_removed = GetDrHooks().Erase(::GetCurrentThreadId());
+    (void)dr_hooks_removed;
+    HADESMEM_DETAIL_ASSERT(dr_hooks_removed);
+
+    auto const veh_hooks_removed =
+      GetVehHooks().Erase(reinterpret_cast<std::uintptr_t>(target_));
+    (void)veh_hooks_removed;
+    HADESMEM_DETAIL_ASSERT(veh_hooks_removed);
   }
 
   virtual void RemovePatch() override
   {
-    hadesmem::detail::AcquireSRWLock const lock(
-      &GetSrwLock(), hadesmem::detail::SRWLockType::Exclusive);
-
     HADESMEM_DETAIL_TRACE_A("Unsetting DR hook.");
 
     auto& dr_hooks = GetDrHooks();
     auto const thread_id = ::GetCurrentThreadId();
-    auto const iter = dr_hooks.find(thread_id);
-    HADESMEM_DETAIL_ASSERT(iter != std::end(dr_hooks));
-    auto const dr_index = iter->second;
+    std::uintptr_t dr_index = 0;
+    bool const dr_hook_found = dr_hooks.Find(thread_id, dr_index);
+    (void)dr_hook_found;
+    HADESMEM_DETAIL_ASSERT(dr_hook_found);
 
     Thread const thread(thread_id);
     auto context = GetThreadContext(thread, CONTEXT_DEBUG_REGISTERS);
@@ -204,12 +215,13 @@ protected:
 
     SetThreadContext(thread, context);
 
-    auto const dr_hooks_removed = dr_hooks.erase(thread_id);
+    auto const dr_hooks_removed = dr_hooks.Erase(thread_id);
     (void)dr_hooks_removed;
     HADESMEM_DETAIL_ASSERT(dr_hooks_removed);
 
     auto& veh_hooks = GetVehHooks();
-    auto const veh_hooks_removed = veh_hooks.erase(target_);
+    auto const veh_hooks_removed =
+      veh_hooks.Erase(reinterpret_cast<std::uintptr_t>(target_));
     (void)veh_hooks_removed;
     HADESMEM_DETAIL_ASSERT(veh_hooks_removed);
   }
@@ -218,5 +230,8 @@ protected:
   {
     return false;
   }
+
+private:
+  std::uint32_t dr_index_{};
 };
 }
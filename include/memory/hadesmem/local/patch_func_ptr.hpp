@@ -4,15 +4,20 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #include <windows.h>
 
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/code_slab.hpp>
 #include <hadesmem/detail/patch_code_gen.hpp>
 #include <hadesmem/detail/patch_detour_stub.hpp>
+#include <hadesmem/detail/read_impl.hpp>
 #include <hadesmem/detail/trace.hpp>
+#include <hadesmem/detail/write_impl.hpp>
 #include <hadesmem/error.hpp>
 #include <hadesmem/flush.hpp>
 #include <hadesmem/local/patch_detour_base.hpp>
@@ -57,6 +62,8 @@ public:
         Error{} << ErrorString{
           "PatchFuncPtr only supported on local process."});
     }
+
+    InitProfile(target_);
   }
 
   explicit PatchFuncPtr(Process const&& process,
@@ -84,6 +91,8 @@ public:
     other.target_ = nullptr;
     other.stub_ = nullptr;
     other.orig_ = nullptr;
+
+    MoveProfile(other);
   }
 
   PatchFuncPtr& operator=(PatchFuncPtr&& other)
@@ -113,6 +122,8 @@ public:
 
     context_ = std::move(other.context_);
 
+    MoveProfile(other);
+
     return *this;
   }
 
@@ -134,28 +145,65 @@ public:
       return;
     }
 
-    stub_gate_ = nullptr;
+    PrepareApply();
 
-    auto const detour_raw = detour_.target<DetourFuncRawT>();
-    if (detour_raw || detour_)
+    CommitApply();
+  }
+
+  // Same as Apply and Remove, except the pointer is read and written without
+  // querying or changing the protection of its page. For callers which patch
+  // a batch of pointers and have already made their region writable (e.g.
+  // PatchIat).
+  void ApplyUnprotected()
+  {
+    if (applied_)
     {
-      HADESMEM_DETAIL_TRACE_FORMAT_A(
-        "Target = %p, Detour = %p.", target_, detour_raw);
+      return;
     }
-    else
+
+    if (detached_)
     {
-      HADESMEM_DETAIL_TRACE_FORMAT_A("Target = %p, Detour = INVALID.", target_);
+      HADESMEM_DETAIL_ASSERT(false);
+      return;
     }
 
-    stub_gate_ = std::make_unique<Allocator>(*process_, sizeof(void*));
+    PrepareStubGate();
 
-    detail::WriteStubGate<TargetFuncT>(*process_,
-                                       stub_gate_->GetBase(),
-                                       &*stub_,
-                                       &GetOriginalArbitraryUserPtrPtr,
-                                       &GetReturnAddressPtrPtr);
+    detail::ReadUnchecked(*process_, target_, &orig_, sizeof(orig_));
+
+    HADESMEM_DETAIL_TRACE_A("Writing pointer to stub.");
+
+    void* const stub_gate = stub_gate_->GetBase();
+    detail::WriteUnchecked(*process_, target_, &stub_gate, sizeof(stub_gate));
+
+    applied_ = true;
+  }
+
+  void RemoveUnprotected()
+  {
+    if (!applied_)
+    {
+      return;
+    }
+
+    HADESMEM_DETAIL_TRACE_A("Restoring original pointer.");
+
+    detail::WriteUnchecked(*process_, target_, &orig_, sizeof(orig_));
+
+    applied_ = false;
+  }
+
+  virtual void PrepareApply() override
+  {
+    PrepareStubGate();
 
     orig_ = Read<void*>(*process_, target_);
+  }
+
+  virtual void CommitApply() override
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+    HADESMEM_DETAIL_ASSERT(stub_gate_);
 
     WritePatch();
 
@@ -259,8 +307,6 @@ protected:
 
   virtual void WritePatch()
   {
-    HADESMEM_DETAIL_TRACE_A("Writing pointer to stub.");
-
     Write(*process_, target_, stub_gate_->GetBase());
   }
 
@@ -277,12 +323,45 @@ protected:
   }
 
 private:
+  void PrepareStubGate()
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+    HADESMEM_DETAIL_ASSERT(!detached_);
+
+    stub_gate_ = nullptr;
+
+    auto const detour_raw = detour_.target<DetourFuncRawT>();
+    if (detour_raw || detour_)
+    {
+      HADESMEM_DETAIL_TRACE_FORMAT_A(
+        "Target = %p, Detour = %p.", target_, detour_raw);
+    }
+    else
+    {
+      HADESMEM_DETAIL_TRACE_FORMAT_A("Target = %p, Detour = INVALID.", target_);
+    }
+
+    // Only the pointer needs to reach the stub gate, so it can go anywhere.
+    stub_gate_ = std::make_unique<detail::CodeSlot>(
+      detail::GetLocalCodeSlab().Allocate(
+        detail::PatchConstants::kMaxStubGateSize,
+        0,
+        (std::numeric_limits<std::uintptr_t>::max)(),
+        reinterpret_cast<std::uintptr_t>(target_)));
+
+    detail::WriteStubGate<TargetFuncT>(*process_,
+                                       stub_gate_->GetBase(),
+                                       &*stub_,
+                                       &GetOriginalArbitraryUserPtrPtr,
+                                       &GetReturnAddressPtrPtr);
+  }
+
   Process const* process_{};
   bool applied_{false};
   bool detached_{false};
   TargetFuncRawT* target_{};
   DetourFuncT detour_{};
-  std::unique_ptr<Allocator> stub_gate_{};
+  std::unique_ptr<detail::CodeSlot> stub_gate_{};
   void* orig_{};
   std::atomic<std::uint32_t> ref_count_{};
   std::unique_ptr<StubT> stub_{};
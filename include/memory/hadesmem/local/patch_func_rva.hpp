@@ -10,6 +10,7 @@
 
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/code_slab.hpp>
 #include <hadesmem/detail/patch_code_gen.hpp>
 #include <hadesmem/detail/patch_detour_stub.hpp>
 #include <hadesmem/detail/trace.hpp>
@@ -51,6 +52,8 @@ public:
         Error{} << ErrorString{
           "PatchFuncRva only supported on local process."});
     }
+
+    InitProfile(target_);
   }
 
   explicit PatchFuncRva(Process const&& process,
@@ -81,6 +84,8 @@ public:
     other.target_ = nullptr;
     other.orig_ = 0;
     other.stub_ = nullptr;
+
+    MoveProfile(other);
   }
 
   PatchFuncRva& operator=(PatchFuncRva&& other)
@@ -113,6 +118,8 @@ public:
 
     context_ = std::move(other.context_);
 
+    MoveProfile(other);
+
     return *this;
   }
 
@@ -134,6 +141,16 @@ public:
       return;
     }
 
+    PrepareApply();
+
+    CommitApply();
+  }
+
+  virtual void PrepareApply() override
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+    HADESMEM_DETAIL_ASSERT(!detached_);
+
     stub_gate_ = nullptr;
 
     auto const detour_raw = detour_.target<DetourFuncRawT>();
@@ -147,7 +164,9 @@ public:
       HADESMEM_DETAIL_TRACE_FORMAT_A("Target = %p, Detour = INVALID.", target_);
     }
 
-    stub_gate_ = detail::AllocatePageNear(*process_, base_);
+    stub_gate_ = std::make_unique<detail::CodeSlot>(
+      detail::GetLocalCodeSlab().AllocateNear(
+        base_, detail::PatchConstants::kMaxStubGateSize));
 
     detail::WriteStubGate<TargetFuncT>(*process_,
                                        stub_gate_->GetBase(),
@@ -156,6 +175,12 @@ public:
                                        &GetReturnAddressPtrPtr);
 
     orig_ = Read<DWORD>(*process_, target_);
+  }
+
+  virtual void CommitApply() override
+  {
+    HADESMEM_DETAIL_ASSERT(!applied_);
+    HADESMEM_DETAIL_ASSERT(stub_gate_);
 
     WritePatch();
 
@@ -259,8 +284,6 @@ protected:
 
   virtual void WritePatch()
   {
-    HADESMEM_DETAIL_TRACE_A("Writing pointer to stub.");
-
     auto const stub_gate_rva =
       reinterpret_cast<std::uintptr_t>(base_) -
       reinterpret_cast<std::uintptr_t>(stub_gate_->GetBase());
@@ -289,7 +312,7 @@ private:
   void* base_{};
   DWORD* target_{};
   DetourFuncT detour_{};
-  std::unique_ptr<Allocator> stub_gate_{};
+  std::unique_ptr<detail::CodeSlot> stub_gate_{};
   DWORD orig_{};
   std::atomic<std::uint32_t> ref_count_{};
   std::unique_ptr<StubT> stub_{};
@@ -3,13 +3,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <windows.h>
 
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/import_index.hpp>
+#include <hadesmem/detail/protect_guard.hpp>
+#include <hadesmem/detail/query_region.hpp>
 #include <hadesmem/detail/str_conv.hpp>
 #include <hadesmem/detail/to_upper_ordinal.hpp>
 #include <hadesmem/detail/trace.hpp>
@@ -18,13 +23,7 @@
 #include <hadesmem/local/patch_detour_base.hpp>
 #include <hadesmem/local/patch_func_ptr.hpp>
 #include <hadesmem/local/patch_func_rva.hpp>
-#include <hadesmem/module.hpp>
-#include <hadesmem/module_list.hpp>
 #include <hadesmem/pelib/pe_file.hpp>
-#include <hadesmem/pelib/import_dir.hpp>
-#include <hadesmem/pelib/import_dir_list.hpp>
-#include <hadesmem/pelib/import_thunk.hpp>
-#include <hadesmem/pelib/import_thunk_list.hpp>
 #include <hadesmem/pelib/export.hpp>
 #include <hadesmem/pelib/export_list.hpp>
 #include <hadesmem/process.hpp>
@@ -32,7 +31,7 @@
 #include <hadesmem/write.hpp>
 
 // TODO: Add some sort of 'Update' or 'Rehook' function for use on module
-// load/unload.
+// load/unload. The import index already handles the incremental part.
 
 // TODO: Support 'stealth' IAT hooking where we redirect to code inside the
 // module which will raise an exception.
@@ -79,11 +78,8 @@ public:
         Error{} << ErrorString{"PatchIat only supported on local process."});
     }
 
-    hadesmem::ModuleList const modules{process};
-    for (auto const& m : modules)
-    {
-      HookModule(m);
-    }
+    HookExports();
+    HookImports();
   }
 
   explicit PatchIat(Process const&& process,
@@ -103,7 +99,7 @@ public:
       detour_{std::move(other.detour_)},
       context_(std::move(other.context_)),
       eat_hook_{std::move(other.eat_hook_)},
-      iat_hooks_{std::move(other.iat_hooks_)},
+      iat_hooks_{std::move(other.iat_hooks_)}
   {
   }
 
@@ -134,13 +130,8 @@ public:
       eat_hook_->Apply();
     }
 
-    for (auto& iat_hook : iat_hooks_)
-    {
-      if (iat_hook.second)
-      {
-        iat_hook.second->Apply();
-      }
-    }
+    ForEachIatHookWritable(
+      [](IatHookT& iat_hook) { iat_hook.ApplyUnprotected(); });
   }
 
   void Remove()
@@ -150,45 +141,54 @@ public:
       eat_hook_->Remove();
     }
 
-    for (auto& iat_hook : iat_hooks_)
-    {
-      if (iat_hook.second)
-      {
-        iat_hook.second->Remove();
-      }
-    }
+    ForEachIatHookWritable(
+      [](IatHookT& iat_hook) { iat_hook.RemoveUnprotected(); });
   }
 
   void RemoveUnchecked() noexcept
   {
-    eat_hook_->RemoveUnchecked();
+    if (eat_hook_)
+    {
+      eat_hook_->RemoveUnchecked();
+    }
 
     for (auto& iat_hook : iat_hooks_)
     {
-      if (iat_hook.second)
-      {
-        iat_hook.second->RemoveUnchecked();
-      }
+      iat_hook->RemoveUnchecked();
     }
   }
 
-private:
-  void HookModule(Module const& m)
+  // The underlying EAT and IAT patches, for staging in a HookTransaction.
+  std::vector<PatchDetourBase*> GetPatches() const
   {
-    hadesmem::PeFile const pe_file{
-      process_, m.GetHandle(), hadesmem::PeFileType::kImage, 0};
+    std::vector<PatchDetourBase*> patches;
 
-    auto const cur_mod_name = detail::ToUpperOrdinal(m.GetName());
-    if (cur_mod_name == module_)
+    if (eat_hook_)
     {
-      HookModuleExports(pe_file);
+      patches.push_back(eat_hook_.get());
     }
 
-    HookModuleImports(pe_file);
+    for (auto& iat_hook : iat_hooks_)
+    {
+      patches.push_back(iat_hook.get());
+    }
+
+    return patches;
   }
 
-  void HookModuleExports(PeFile const& pe_file)
+private:
+  using IatHookT = PatchFuncPtr<TargetFuncT, ContextT>;
+
+  void HookExports()
   {
+    auto const handle = ::GetModuleHandleW(module_.c_str());
+    if (!handle)
+    {
+      return;
+    }
+
+    hadesmem::PeFile const pe_file{
+      process_, handle, hadesmem::PeFileType::kImage, 0};
     hadesmem::ExportList exports{process_, pe_file};
     for (auto& e : exports)
     {
@@ -216,52 +216,57 @@ private:
     }
   }
 
-  void HookModuleImports(PeFile const& pe_file)
+  void HookImports()
   {
-    hadesmem::ImportDirList const import_dirs{process_, pe_file};
-    for (auto const& id : import_dirs)
-    {
-      // TODO: Handle forwarded exports here also? i.e. Hook both things that
-      // import via the forwarder and also hook the real implementation.
+    // TODO: Handle forwarded exports here also? i.e. Hook both things that
+    // import via the forwarder and also hook the real implementation.
 
-      auto const imp_mod_name =
-        detail::ToUpperOrdinal(detail::MultiByteToWideChar(id.GetName()));
-      if (imp_mod_name != module_)
-      {
-        continue;
-      }
+    auto& index = detail::GetLocalImportIndex();
+    index.Refresh(process_);
 
-      HookModuleImportDir(pe_file, id);
+    // Sorted, so hooks in the same page end up next to each other.
+    auto slots = index.Find(detail::WideCharToMultiByte(module_), function_);
+    std::sort(std::begin(slots), std::end(slots));
+    for (auto const slot : slots)
+    {
+      HADESMEM_DETAIL_TRACE_FORMAT_A(
+        "Got import thunk at [%p] with value [%p].",
+        reinterpret_cast<void const*>(slot),
+        *reinterpret_cast<void* const*>(slot));
+
+      auto const func_ptr = reinterpret_cast<TargetFuncRawT*>(slot);
+      iat_hooks_.emplace_back(
+        std::make_unique<IatHookT>(process_, func_ptr, detour_, context_));
     }
   }
 
-  void HookModuleImportDir(PeFile const& pe_file, hadesmem::ImportDir const& id)
+  // IATs are usually contiguous, so make each region writable once for the
+  // whole batch rather than once (and back again) per slot. The hooks
+  // themselves then write their slots without touching protection at all.
+  template <typename Func> void ForEachIatHookWritable(Func func)
   {
-    hadesmem::ImportThunkList import_thunks{
-      process_, pe_file, id.GetFirstThunk()};
-    hadesmem::ImportThunkList orig_import_thunks{
-      process_, pe_file, id.GetOriginalFirstThunk()};
-    for (auto it = std::begin(import_thunks),
-              oit = std::begin(orig_import_thunks);
-         it != std::end(import_thunks) && oit != std::end(orig_import_thunks);
-         ++it, ++oit)
+    std::unique_ptr<detail::ProtectGuard> guard;
+    std::uintptr_t region_beg = 0;
+    std::uintptr_t region_end = 0;
+    for (auto& iat_hook : iat_hooks_)
     {
-      if (function_ != oit->GetName())
+      auto const slot = reinterpret_cast<std::uintptr_t>(iat_hook->GetTarget());
+      if (slot < region_beg || slot >= region_end)
       {
-        continue;
+        guard.reset();
+        auto const mbi = detail::Query(process_, iat_hook->GetTarget());
+        region_beg = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+        region_end = region_beg + mbi.RegionSize;
+        guard = std::make_unique<detail::ProtectGuard>(
+          process_, mbi, detail::ProtectGuardType::kWrite);
       }
 
-      HADESMEM_DETAIL_TRACE_FORMAT_A(
-        "Got import thunk at [%p] with value [%p].",
-        it->GetFunctionPtr(),
-        reinterpret_cast<void const*>(it->GetFunction()));
-
-      auto& iat_hook = iat_hooks_[pe_file.GetBase()];
-      HADESMEM_DETAIL_ASSERT(!iat_hook);
-      auto const func_ptr =
-        reinterpret_cast<TargetFuncRawT*>(it->GetFunctionPtr());
-      iat_hook = std::make_unique<PatchFuncPtr<TargetFuncT, ContextT>>(
-        process_, func_ptr, detour_, context_);
+      func(*iat_hook);
+    }
+
+    if (guard)
+    {
+      guard->Restore();
     }
   }
 
@@ -271,6 +276,6 @@ private:
   DetourFuncT detour_{};
   ContextT context_;
   std::unique_ptr<PatchDetourBase> eat_hook_;
-  std::map<void*, std::unique_ptr<PatchDetourBase>> iat_hooks_{};
+  std::vector<std::unique_ptr<IatHookT>> iat_hooks_{};
 };
 }
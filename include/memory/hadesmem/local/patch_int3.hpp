@@ -14,10 +14,6 @@
 #include <utility>
 #include <vector>
 
-#include <hadesmem/detail/warning_disable_prefix.hpp>
-#include <udis86.h>
-#include <hadesmem/detail/warning_disable_suffix.hpp>
-
 #include <windows.h>
 
 #include <hadesmem/alloc.hpp>
@@ -26,7 +22,6 @@
 #include <hadesmem/detail/patch_detour_stub.hpp>
 #include <hadesmem/detail/patcher_aux.hpp>
 #include <hadesmem/detail/scope_warden.hpp>
-#include <hadesmem/detail/srw_lock.hpp>
 #include <hadesmem/detail/thread_aux.hpp>
 #include <hadesmem/detail/trace.hpp>
 #include <hadesmem/detail/type_traits.hpp>
@@ -84,27 +79,25 @@ protected:
     return 1;
   }
 
-  virtual void WritePatch() override
+  // The lookup table entry is added up front, as it's inert until the
+  // breakpoint is written and adding it allocates.
+  virtual void PreparePatch() override
   {
-    auto& veh_hooks = GetVehHooks();
-
-    {
-      hadesmem::detail::AcquireSRWLock const lock(
-        &GetSrwLock(), hadesmem::detail::SRWLockType::Exclusive);
-
-      HADESMEM_DETAIL_ASSERT(veh_hooks.find(target_) == std::end(veh_hooks));
-      veh_hooks[target_] = this;
-    }
-
-    auto const cleanup_hook = [&]() { veh_hooks.erase(target_); };
-    auto scope_cleanup_hook = hadesmem::detail::MakeScopeWarden(cleanup_hook);
-
-    HADESMEM_DETAIL_TRACE_A("Writing breakpoint.");
+    bool const veh_hook_inserted = GetVehHooks().Insert(
+      reinterpret_cast<std::uintptr_t>(target_), stub_gate_->GetBase());
+    (void)veh_hook_inserted;
+    HADESMEM_DETAIL_ASSERT(veh_hook_inserted);
+  }
 
-    std::vector<std::uint8_t> const buf = {0xCC};
-    WriteVector(process_, target_, buf);
+  virtual void WritePatch() override
+  {
+    std::uint8_t const int3 = 0xCC;
+    Write(process_, target_, int3);
+  }
 
-    scope_cleanup_hook.Dismiss();
+  virtual void CancelPatch() override
+  {
+    GetVehHooks().Erase(reinterpret_cast<std::uintptr_t>(target_));
   }
 
   virtual void RemovePatch() override
@@ -113,13 +106,7 @@ protected:
 
     WriteVector(process_, target_, orig_);
 
-    {
-      hadesmem::detail::AcquireSRWLock const lock(
-        &GetSrwLock(), hadesmem::detail::SRWLockType::Exclusive);
-
-      auto& veh_hooks = GetVehHooks();
-      veh_hooks.erase(target_);
-    }
+    GetVehHooks().Erase(reinterpret_cast<std::uintptr_t>(target_));
   }
 
   virtual bool CanHookChainImpl() const noexcept override
@@ -14,19 +14,15 @@
 #include <utility>
 #include <vector>
 
-#include <hadesmem/detail/warning_disable_prefix.hpp>
-#include <udis86.h>
-#include <hadesmem/detail/warning_disable_suffix.hpp>
-
 #include <windows.h>
 
 #include <hadesmem/alloc.hpp>
 #include <hadesmem/detail/alias_cast.hpp>
 #include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/hook_dispatch_table.hpp>
 #include <hadesmem/detail/patch_detour_stub.hpp>
 #include <hadesmem/detail/patcher_aux.hpp>
 #include <hadesmem/detail/scope_warden.hpp>
-#include <hadesmem/detail/srw_lock.hpp>
 #include <hadesmem/detail/thread_aux.hpp>
 #include <hadesmem/detail/trace.hpp>
 #include <hadesmem/detail/type_traits.hpp>
@@ -83,7 +79,6 @@ public:
   static void InitializeStatics()
   {
     GetInitialized();
-    GetSrwLock();
     GetVehHooks();
     GetDrHooks();
   }
@@ -94,6 +89,11 @@ protected:
     HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"Unimplemented."});
   }
 
+  virtual void PreparePatch() override
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"Unimplemented."});
+  }
+
   virtual void WritePatch() override
   {
     HADESMEM_DETAIL_THROW_EXCEPTION(Error{} << ErrorString{"Unimplemented."});
@@ -146,54 +146,42 @@ protected:
     }
   }
 
+  // Hit on every call to a hooked function, so these must not take any
+  // locks. See HookDispatchTable.
   static LONG CALLBACK HandleBreakpoint(PEXCEPTION_POINTERS exception_pointers)
   {
-    hadesmem::detail::AcquireSRWLock const lock(
-      &GetSrwLock(), hadesmem::detail::SRWLockType::Shared);
-
-    auto& veh_hooks = GetVehHooks();
-    auto const iter =
-      veh_hooks.find(exception_pointers->ExceptionRecord->ExceptionAddress);
-    if (iter == std::end(veh_hooks))
+    void* stub_gate = nullptr;
+    if (!GetVehHooks().Find(
+          reinterpret_cast<std::uintptr_t>(
+            exception_pointers->ExceptionRecord->ExceptionAddress),
+          stub_gate))
     {
       return EXCEPTION_CONTINUE_SEARCH;
     }
 
-    PatchVeh* patch = iter->second;
-#if defined(HADESMEM_DETAIL_ARCH_X64)
-    exception_pointers->ContextRecord->Rip =
-      reinterpret_cast<std::uintptr_t>(patch->stub_gate_->GetBase());
-#elif defined(HADESMEM_DETAIL_ARCH_X86)
-    exception_pointers->ContextRecord->Eip =
-      reinterpret_cast<std::uintptr_t>(patch->stub_gate_->GetBase());
-#else
-#error "[HadesMem] Unsupported architecture."
-#endif
+    detail::SetThreadContextIp(*exception_pointers->ContextRecord,
+                               reinterpret_cast<std::uintptr_t>(stub_gate));
 
     return EXCEPTION_CONTINUE_EXECUTION;
   }
 
   static LONG CALLBACK HandleSingleStep(PEXCEPTION_POINTERS exception_pointers)
   {
-    hadesmem::detail::AcquireSRWLock const lock(
-      &GetSrwLock(), hadesmem::detail::SRWLockType::Shared);
-
-    auto& veh_hooks = GetVehHooks();
-    auto const iter =
-      veh_hooks.find(exception_pointers->ExceptionRecord->ExceptionAddress);
-    if (iter == std::end(veh_hooks))
+    void* stub_gate = nullptr;
+    if (!GetVehHooks().Find(
+          reinterpret_cast<std::uintptr_t>(
+            exception_pointers->ExceptionRecord->ExceptionAddress),
+          stub_gate))
     {
       return EXCEPTION_CONTINUE_SEARCH;
     }
 
-    auto& dr_hooks = GetDrHooks();
-    auto const dr_hook_iter = dr_hooks.find(::GetCurrentThreadId());
-    if (dr_hook_iter == std::end(dr_hooks))
+    std::uintptr_t dr_index = 0;
+    if (!GetDrHooks().Find(::GetCurrentThreadId(), dr_index))
     {
       return EXCEPTION_CONTINUE_SEARCH;
     }
 
-    std::uintptr_t const dr_index = dr_hook_iter->second;
     if (!(exception_pointers->ContextRecord->Dr6 & (1ULL << dr_index)))
     {
       return EXCEPTION_CONTINUE_SEARCH;
@@ -204,16 +192,8 @@ protected:
     // Set resume flag
     exception_pointers->ContextRecord->EFlags |= (1ULL << 16);
 
-    PatchVeh* patch = iter->second;
-#if defined(HADESMEM_DETAIL_ARCH_X64)
-    exception_pointers->ContextRecord->Rip =
-      reinterpret_cast<std::uintptr_t>(patch->stub_gate_->GetBase());
-#elif defined(HADESMEM_DETAIL_ARCH_X86)
-    exception_pointers->ContextRecord->Eip =
-      reinterpret_cast<std::uintptr_t>(patch->stub_gate_->GetBase());
-#else
-#error "[HadesMem] Unsupported architecture."
-#endif
+    detail::SetThreadContextIp(*exception_pointers->ContextRecord,
+                               reinterpret_cast<std::uintptr_t>(stub_gate));
 
     return EXCEPTION_CONTINUE_EXECUTION;
   }
@@ -224,22 +204,18 @@ protected:
     return initialized;
   }
 
-  static std::map<void*, PatchVeh*>& GetVehHooks()
+  // Target to stub gate.
+  static detail::HookDispatchTable<void*>& GetVehHooks()
   {
-    static std::map<void*, PatchVeh*> veh_hooks;
+    static detail::HookDispatchTable<void*> veh_hooks;
     return veh_hooks;
   }
 
-  static std::map<DWORD, std::uintptr_t>& GetDrHooks()
+  // Thread ID to debug register index.
+  static detail::HookDispatchTable<std::uintptr_t>& GetDrHooks()
   {
-    static std::map<DWORD, std::uintptr_t> dr_hooks;
+    static detail::HookDispatchTable<std::uintptr_t> dr_hooks;
     return dr_hooks;
   }
-
-  static SRWLOCK& GetSrwLock()
-  {
-    static SRWLOCK srw_lock = SRWLOCK_INIT;
-    return srw_lock;
-  }
 };
 }
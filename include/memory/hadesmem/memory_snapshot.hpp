@@ -0,0 +1,545 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/mapped_file.hpp>
+#include <hadesmem/detail/parallel_for.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/region_snapshot.hpp>
+#include <hadesmem/scanner.hpp>
+
+// A MemorySnapshot is a frozen copy of (a subset of) a target's memory, kept
+// in a memory mapped file rather than in RAM. It is itself a ScanSource, so
+// anything which works on a ScanSource (Scanner, PointerIndex, etc.) can be
+// run against it with consistent data and without any calls into the target,
+// and GetData gives direct access for everything else (e.g. parsing a module
+// with PeFile and PeFileType::kData).
+//
+// File format (little endian, as only x86 and x64 are supported):
+// - MemorySnapshotHeader.
+// - MemorySnapshotRegion[region_count], sorted by base.
+// - Region data, each region starting on a page boundary.
+// Pages which are all zero are never written, and the file is sparse, so they
+// don't take up any space on disk.
+
+namespace hadesmem
+{
+struct MemorySnapshotHeader
+{
+  std::uint8_t magic[8];
+  std::uint32_t version;
+  std::uint32_t reserved;
+  std::uint64_t region_count;
+  std::uint64_t file_size;
+};
+
+struct MemorySnapshotRegion
+{
+  std::uint64_t base;
+  std::uint64_t alloc_base;
+  std::uint64_t size;
+  std::uint64_t file_offset;
+  std::uint32_t state;
+  std::uint32_t protect;
+  std::uint32_t type;
+  std::uint32_t reserved;
+};
+
+HADESMEM_DETAIL_STATIC_ASSERT(sizeof(MemorySnapshotHeader) == 32);
+HADESMEM_DETAIL_STATIC_ASSERT(sizeof(MemorySnapshotRegion) == 48);
+
+struct MemorySnapshotOptions
+{
+  std::uint32_t protection = ScanProtection::kRead;
+  std::uint32_t types = ScanRegionType::kAll;
+  std::uintptr_t start = 0;
+  std::uintptr_t end = (std::numeric_limits<std::uintptr_t>::max)();
+  std::size_t buffer_size = 0x100000;
+  // Zero means one thread per hardware thread.
+  std::size_t num_threads = 0;
+};
+
+namespace detail
+{
+std::uint8_t const kMemorySnapshotMagic[8] = {
+  'H', 'M', 'S', 'N', 'A', 'P', 0, 0};
+std::uint32_t const kMemorySnapshotVersion = 1;
+std::size_t const kMemorySnapshotPageSize = 0x1000;
+
+inline bool IsZeroPage(std::uint8_t const* data, std::size_t len) noexcept
+{
+  return !data[0] && !std::memcmp(data, data + 1, len - 1);
+}
+}
+
+class MemorySnapshot : public ScanSource
+{
+public:
+  // Captures the regions of source which match the options into a new file
+  // (overwriting any existing file).
+  MemorySnapshot(ScanSource const& source,
+                 std::wstring const& path,
+                 MemorySnapshotOptions const& options = MemorySnapshotOptions())
+    : options_(options)
+  {
+    Capture(source, path);
+  }
+
+  MemorySnapshot(ScanSource&& source,
+                 std::wstring const& path,
+                 MemorySnapshotOptions const& options =
+                   MemorySnapshotOptions()) = delete;
+
+  // Opens a previously captured snapshot (read-only).
+  explicit MemorySnapshot(std::wstring const& path)
+  {
+    Load(path);
+  }
+
+  // Re-captures source into the same file and returns the number of pages
+  // written. Only pages whose contents differ from the previous capture are
+  // written, so unchanged pages are never dirtied. If the layout has changed
+  // the data of each region which is still present (matched by base address)
+  // is moved to its new place in the file first, so it is diffed rather than
+  // written again.
+  std::size_t Update(ScanSource const& source)
+  {
+    if (!file_.IsWritable())
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Snapshot was opened read-only."});
+    }
+
+    std::vector<MemorySnapshotRegion> regions;
+    GetLayout(source, regions);
+    if (regions.size() == regions_.size() &&
+        std::equal(std::begin(regions),
+                   std::end(regions),
+                   std::begin(regions_),
+                   [](MemorySnapshotRegion const& lhs,
+                      MemorySnapshotRegion const& rhs)
+                   {
+                     return lhs.base == rhs.base && lhs.size == rhs.size &&
+                            lhs.alloc_base == rhs.alloc_base &&
+                            lhs.state == rhs.state &&
+                            lhs.protect == rhs.protect &&
+                            lhs.type == rhs.type;
+                   }))
+    {
+      return CopyRegions(source, true);
+    }
+
+    Relayout(regions);
+    std::size_t const pages_written = CopyRegions(source, true);
+    WriteHeader();
+    return pages_written;
+  }
+
+  virtual void GetRegions(RegionSnapshot& snapshot) const override
+  {
+    std::vector<MEMORY_BASIC_INFORMATION> regions;
+    regions.reserve(regions_.size());
+    for (auto const& region : regions_)
+    {
+      MEMORY_BASIC_INFORMATION mbi{};
+      mbi.BaseAddress = reinterpret_cast<PVOID>(region.base);
+      mbi.AllocationBase = reinterpret_cast<PVOID>(region.alloc_base);
+      mbi.RegionSize = static_cast<SIZE_T>(region.size);
+      mbi.State = region.state;
+      mbi.Protect = region.protect;
+      mbi.Type = region.type;
+      regions.push_back(mbi);
+    }
+    snapshot.Assign(std::begin(regions), std::end(regions));
+  }
+
+  virtual bool
+    Read(std::uintptr_t address, void* data, std::size_t len) const override
+  {
+    void const* const src = GetData(address, len);
+    if (!src)
+    {
+      return false;
+    }
+
+    std::memcpy(data, src, len);
+    return true;
+  }
+
+  // Returns the captured copy of [address, address + len), or nullptr if the
+  // range isn't entirely within a single captured region.
+  void const* GetData(std::uintptr_t address, std::size_t len) const noexcept
+  {
+    auto const iter = std::upper_bound(
+      std::begin(regions_),
+      std::end(regions_),
+      address,
+      [](std::uintptr_t a, MemorySnapshotRegion const& region)
+      {
+        return a < region.base;
+      });
+    if (iter == std::begin(regions_))
+    {
+      return nullptr;
+    }
+
+    auto const& region = *(iter - 1);
+    std::uint64_t const offset = address - region.base;
+    if (offset > region.size || len > region.size - offset)
+    {
+      return nullptr;
+    }
+
+    return file_.GetData() + region.file_offset + offset;
+  }
+
+  std::vector<MemorySnapshotRegion> const& GetRegionTable() const noexcept
+  {
+    return regions_;
+  }
+
+  std::wstring GetPath() const
+  {
+    return path_;
+  }
+
+private:
+  void GetLayout(ScanSource const& source,
+                 std::vector<MemorySnapshotRegion>& regions) const
+  {
+    RegionSnapshot snapshot;
+    source.GetRegions(snapshot);
+
+    for (auto const& record : snapshot)
+    {
+      if (record.state != MEM_COMMIT ||
+          !detail::ScanProtectionMatches(record.protect,
+                                         options_.protection) ||
+          !detail::ScanRegionTypeMatches(record.type, options_.types))
+      {
+        continue;
+      }
+
+      std::uintptr_t const begin = (std::max)(record.base, options_.start);
+      std::uintptr_t const end =
+        (std::min)(record.base + record.size, options_.end);
+      if (begin >= end)
+      {
+        continue;
+      }
+
+      MemorySnapshotRegion region{};
+      region.base = begin;
+      region.alloc_base = record.alloc_base;
+      region.size = end - begin;
+      region.state = record.state;
+      region.protect = record.protect;
+      region.type = record.type;
+      regions.push_back(region);
+    }
+
+    std::uint64_t offset = sizeof(MemorySnapshotHeader) +
+                           regions.size() * sizeof(MemorySnapshotRegion);
+    for (auto& region : regions)
+    {
+      offset = AlignPage(offset);
+      region.file_offset = offset;
+      offset += region.size;
+    }
+  }
+
+  static std::uint64_t
+    GetFileSize(std::vector<MemorySnapshotRegion> const& regions) noexcept
+  {
+    if (regions.empty())
+    {
+      return AlignPage(sizeof(MemorySnapshotHeader));
+    }
+
+    return AlignPage(regions.back().file_offset + regions.back().size);
+  }
+
+  std::size_t Capture(ScanSource const& source, std::wstring const& path)
+  {
+    std::vector<MemorySnapshotRegion> regions;
+    GetLayout(source, regions);
+
+    regions_.clear();
+    file_.Create(path, GetFileSize(regions));
+    path_ = path;
+    regions_.swap(regions);
+
+    WriteRegionTable();
+    std::size_t const pages_written = CopyRegions(source, false);
+    WriteHeader();
+
+    return pages_written;
+  }
+
+  // Switches the file over to a new layout in place. The header is cleared
+  // first and only written again (by the caller) once the region data is
+  // up to date, so an interrupted update never leaves a file which looks
+  // valid.
+  void Relayout(std::vector<MemorySnapshotRegion>& regions)
+  {
+    std::memset(file_.GetData(), 0, sizeof(MemorySnapshotHeader));
+
+    std::uint64_t const file_size = GetFileSize(regions);
+    if (file_size > file_.GetSize())
+    {
+      file_.Resize(file_size);
+    }
+
+    struct Move
+    {
+      std::uint64_t from;
+      std::uint64_t to;
+      std::uint64_t size;
+    };
+
+    // Both tables are sorted by base, so regions keep their relative order in
+    // the file.
+    std::vector<Move> moves;
+    auto old_iter = std::begin(regions_);
+    for (auto const& region : regions)
+    {
+      while (old_iter != std::end(regions_) && old_iter->base < region.base)
+      {
+        ++old_iter;
+      }
+
+      if (old_iter != std::end(regions_) && old_iter->base == region.base)
+      {
+        moves.push_back(Move{old_iter->file_offset,
+                             region.file_offset,
+                             (std::min)(old_iter->size, region.size)});
+      }
+    }
+
+    // Regions moving towards the start of the file are moved front to back,
+    // then those moving towards the end back to front, so no region is
+    // overwritten before its own data has been moved.
+    for (auto const& move : moves)
+    {
+      if (move.to < move.from)
+      {
+        MoveRegionData(move.from, move.to, move.size);
+      }
+    }
+    for (auto iter = moves.rbegin(); iter != moves.rend(); ++iter)
+    {
+      if (iter->to > iter->from)
+      {
+        MoveRegionData(iter->from, iter->to, iter->size);
+      }
+    }
+
+    if (file_size < file_.GetSize())
+    {
+      file_.Resize(file_size);
+    }
+
+    regions_.swap(regions);
+    WriteRegionTable();
+  }
+
+  void MoveRegionData(std::uint64_t from, std::uint64_t to, std::uint64_t size)
+  {
+    std::uint8_t* const data = file_.GetData();
+    std::uint64_t const num_pages =
+      (size + detail::kMemorySnapshotPageSize - 1) /
+      detail::kMemorySnapshotPageSize;
+    for (std::uint64_t i = 0; i < num_pages; ++i)
+    {
+      std::uint64_t const page = to < from ? i : num_pages - i - 1;
+      std::uint64_t const offset = page * detail::kMemorySnapshotPageSize;
+      std::size_t const len = static_cast<std::size_t>((std::min)(
+        static_cast<std::uint64_t>(detail::kMemorySnapshotPageSize),
+        size - offset));
+      std::uint8_t const* const src = data + from + offset;
+      std::uint8_t* const dst = data + to + offset;
+      // Pages which are zero at both ends are left alone, so sparse files
+      // stay sparse.
+      if (!detail::IsZeroPage(src, len) || !detail::IsZeroPage(dst, len))
+      {
+        std::memmove(dst, src, len);
+      }
+    }
+  }
+
+  void WriteRegionTable()
+  {
+    if (!regions_.empty())
+    {
+      std::memcpy(file_.GetData() + sizeof(MemorySnapshotHeader),
+                  regions_.data(),
+                  regions_.size() * sizeof(MemorySnapshotRegion));
+    }
+  }
+
+  // Written last, so a partially written file is never valid.
+  void WriteHeader()
+  {
+    MemorySnapshotHeader header{};
+    std::memcpy(header.magic,
+                detail::kMemorySnapshotMagic,
+                sizeof(detail::kMemorySnapshotMagic));
+    header.version = detail::kMemorySnapshotVersion;
+    header.region_count = regions_.size();
+    header.file_size = file_.GetSize();
+    std::memcpy(file_.GetData(), &header, sizeof(header));
+  }
+
+  // Reads every captured region back from source and writes each page which
+  // differs from what is already in the file (which is zero for a new file).
+  std::size_t CopyRegions(ScanSource const& source, bool update)
+  {
+    struct Chunk
+    {
+      std::uint64_t address;
+      std::uint64_t file_offset;
+      std::size_t len;
+    };
+
+    std::size_t const buffer_size =
+      (std::max)(options_.buffer_size / detail::kMemorySnapshotPageSize *
+                   detail::kMemorySnapshotPageSize,
+                 detail::kMemorySnapshotPageSize);
+    std::vector<Chunk> chunks;
+    for (auto const& region : regions_)
+    {
+      for (std::uint64_t offset = 0; offset < region.size;
+           offset += buffer_size)
+      {
+        chunks.push_back(Chunk{
+          region.base + offset,
+          region.file_offset + offset,
+          static_cast<std::size_t>((std::min)(
+            static_cast<std::uint64_t>(buffer_size), region.size - offset))});
+      }
+    }
+
+    std::atomic<std::size_t> pages_written(0);
+    std::uint8_t* const data = file_.GetData();
+    detail::ParallelFor(
+      chunks.size(),
+      options_.num_threads,
+      [&](std::size_t i)
+      {
+        auto const& chunk = chunks[i];
+        std::vector<std::uint8_t> buf(chunk.len);
+        bool const read_all = source.Read(
+          static_cast<std::uintptr_t>(chunk.address), buf.data(), buf.size());
+
+        std::size_t written = 0;
+        for (std::size_t offset = 0; offset < chunk.len;
+             offset += detail::kMemorySnapshotPageSize)
+        {
+          std::size_t const len = (std::min)(detail::kMemorySnapshotPageSize,
+                                             chunk.len - offset);
+          // Fall back to reading page by page if the chunk as a whole
+          // couldn't be read. Pages which still can't be read are left zero
+          // filled.
+          if (!read_all &&
+              !source.Read(static_cast<std::uintptr_t>(chunk.address + offset),
+                           &buf[offset],
+                           len))
+          {
+            std::fill(&buf[offset], &buf[offset] + len, std::uint8_t(0));
+          }
+
+          std::uint8_t* const dst = data + chunk.file_offset + offset;
+          bool const changed = update
+                                 ? !!std::memcmp(dst, &buf[offset], len)
+                                 : !detail::IsZeroPage(&buf[offset], len);
+          if (changed)
+          {
+            std::memcpy(dst, &buf[offset], len);
+            ++written;
+          }
+        }
+
+        pages_written += written;
+      });
+
+    return pages_written;
+  }
+
+  void Load(std::wstring const& path)
+  {
+    file_.Open(path);
+    path_ = path;
+
+    auto const throw_invalid = []()
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Invalid memory snapshot."});
+    };
+
+    std::uint64_t const file_size = file_.GetSize();
+    if (file_size < sizeof(MemorySnapshotHeader))
+    {
+      throw_invalid();
+    }
+
+    MemorySnapshotHeader header;
+    std::memcpy(&header, file_.GetData(), sizeof(header));
+    if (std::memcmp(header.magic,
+                    detail::kMemorySnapshotMagic,
+                    sizeof(detail::kMemorySnapshotMagic)) ||
+        header.version != detail::kMemorySnapshotVersion ||
+        header.file_size != file_size ||
+        header.region_count >
+          (file_size - sizeof(header)) / sizeof(MemorySnapshotRegion))
+    {
+      throw_invalid();
+    }
+
+    regions_.resize(static_cast<std::size_t>(header.region_count));
+    if (!regions_.empty())
+    {
+      std::memcpy(regions_.data(),
+                  file_.GetData() + sizeof(header),
+                  regions_.size() * sizeof(MemorySnapshotRegion));
+    }
+
+    std::uint64_t prev_end = 0;
+    for (auto const& region : regions_)
+    {
+      if (region.base < prev_end || region.file_offset > file_size ||
+          region.size > file_size - region.file_offset ||
+          region.base + region.size < region.base ||
+          region.base + region.size >
+            (std::numeric_limits<std::uintptr_t>::max)())
+      {
+        throw_invalid();
+      }
+      prev_end = region.base + region.size;
+    }
+  }
+
+  static std::uint64_t AlignPage(std::uint64_t n) noexcept
+  {
+    return (n + detail::kMemorySnapshotPageSize - 1) &
+           ~static_cast<std::uint64_t>(detail::kMemorySnapshotPageSize - 1);
+  }
+
+  MemorySnapshotOptions options_;
+  std::wstring path_;
+  detail::MappedFile file_;
+  std::vector<MemorySnapshotRegion> regions_;
+};
+}
@@ -1,14 +1,15 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <hadesmem/local/patch_detour.hpp>
-#include <hadesmem/local/patch_detour_base.hpp>
-#include <hadesmem/local/patch_dr.hpp>
-#include <hadesmem/local/patch_func_ptr.hpp>
-#include <hadesmem/local/patch_iat.hpp>
-#include <hadesmem/local/patch_int3.hpp>
-#include <hadesmem/local/patch_veh.hpp>
-#include <hadesmem/local/patch_vmt.hpp>
-#include <hadesmem/patch_raw.hpp>
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <hadesmem/local/hook_transaction.hpp>
+#include <hadesmem/local/patch_detour.hpp>
+#include <hadesmem/local/patch_detour_base.hpp>
+#include <hadesmem/local/patch_dr.hpp>
+#include <hadesmem/local/patch_func_ptr.hpp>
+#include <hadesmem/local/patch_iat.hpp>
+#include <hadesmem/local/patch_int3.hpp>
+#include <hadesmem/local/patch_veh.hpp>
+#include <hadesmem/local/patch_vmt.hpp>
+#include <hadesmem/patch_raw.hpp>
@@ -1,217 +1,283 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <iterator>
-#include <memory>
-#include <utility>
-
-#include <windows.h>
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/detail/assert.hpp>
-#include <hadesmem/detail/optional.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/pelib/bound_import_desc.hpp>
-#include <hadesmem/pelib/pe_file.hpp>
-#include <hadesmem/process.hpp>
-#include <hadesmem/read.hpp>
-
-// TODO: Add tests.
-
-namespace hadesmem
-{
-// BoundImportDescriptorIterator satisfies the requirements of an input iterator
-// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
-template <typename BoundImportDescriptorT>
-class BoundImportDescriptorIterator
-  : public std::iterator<std::input_iterator_tag, BoundImportDescriptorT>
-{
-public:
-  using BaseIteratorT =
-    std::iterator<std::input_iterator_tag, BoundImportDescriptorT>;
-  using value_type = typename BaseIteratorT::value_type;
-  using difference_type = typename BaseIteratorT::difference_type;
-  using pointer = typename BaseIteratorT::pointer;
-  using reference = typename BaseIteratorT::reference;
-  using iterator_category = typename BaseIteratorT::iterator_category;
-
-  constexpr BoundImportDescriptorIterator() noexcept
-  {
-  }
-
-  explicit BoundImportDescriptorIterator(Process const& process,
-                                         PeFile const& pe_file)
-  {
-    try
-    {
-      BoundImportDescriptor const bound_import_desc{
-        process, pe_file, nullptr, nullptr};
-      if (!IsTerminator(bound_import_desc))
-      {
-        impl_ = std::make_shared<Impl>(process, pe_file, bound_import_desc);
-      }
-    }
-    catch (std::exception const& /*e*/)
-    {
-      // Nothing to do here.
-    }
-  }
-
-  explicit BoundImportDescriptorIterator(Process const&& process,
-                                         PeFile const& pe_file) = delete;
-
-  explicit BoundImportDescriptorIterator(Process const& process,
-                                         PeFile&& pe_file) = delete;
-
-  explicit BoundImportDescriptorIterator(Process const&& process,
-                                         PeFile&& pe_file) = delete;
-
-  reference operator*() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return *impl_->bound_import_desc_;
-  }
-
-  pointer operator->() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return &*impl_->bound_import_desc_;
-  }
-
-  BoundImportDescriptorIterator& operator++()
-  {
-    try
-    {
-      HADESMEM_DETAIL_ASSERT(impl_.get());
-
-      auto const cur_base = static_cast<PIMAGE_BOUND_IMPORT_DESCRIPTOR>(
-        impl_->bound_import_desc_->GetBase());
-      auto const new_base = reinterpret_cast<PIMAGE_BOUND_IMPORT_DESCRIPTOR>(
-        reinterpret_cast<IMAGE_BOUND_FORWARDER_REF*>(cur_base + 1) +
-        impl_->bound_import_desc_->GetNumberOfModuleForwarderRefs());
-      auto const start_base = static_cast<PIMAGE_BOUND_IMPORT_DESCRIPTOR>(
-        impl_->bound_import_desc_->GetStart());
-      impl_->bound_import_desc_ = BoundImportDescriptor{
-        *impl_->process_, *impl_->pe_file_, start_base, new_base};
-
-      if (IsTerminator(*impl_->bound_import_desc_))
-      {
-        impl_.reset();
-        return *this;
-      }
-    }
-    catch (std::exception const& /*e*/)
-    {
-      impl_.reset();
-    }
-
-    return *this;
-  }
-
-  BoundImportDescriptorIterator operator++(int)
-  {
-    BoundImportDescriptorIterator const iter{*this};
-    ++*this;
-    return iter;
-  }
-
-  bool operator==(BoundImportDescriptorIterator const& other) const noexcept
-  {
-    return impl_ == other.impl_;
-  }
-
-  bool operator!=(BoundImportDescriptorIterator const& other) const noexcept
-  {
-    return !(*this == other);
-  }
-
-private:
-  // TODO: Verify this.
-  bool IsTerminator(BoundImportDescriptor const& bound_import_desc) const
-  {
-    // Apparently all three fields are supposed to be zero, but it seems that
-    // may not be the case when it comes to the actual loader implementation?
-    return !bound_import_desc.GetTimeDateStamp() ||
-           !bound_import_desc.GetOffsetModuleName();
-  }
-
-  struct Impl
-  {
-    explicit Impl(Process const& process,
-                  PeFile const& pe_file,
-                  BoundImportDescriptor const& bound_import_desc) noexcept
-      : process_{&process},
-        pe_file_{&pe_file},
-        bound_import_desc_{bound_import_desc}
-    {
-    }
-
-    Process const* process_;
-    PeFile const* pe_file_;
-    hadesmem::detail::Optional<BoundImportDescriptor> bound_import_desc_;
-  };
-
-  // Shallow copy semantics, as required by InputIterator.
-  std::shared_ptr<Impl> impl_;
-};
-
-class BoundImportDescriptorList
-{
-public:
-  using value_type = BoundImportDescriptor;
-  using iterator = BoundImportDescriptorIterator<BoundImportDescriptor>;
-  using const_iterator =
-    BoundImportDescriptorIterator<BoundImportDescriptor const>;
-
-  explicit BoundImportDescriptorList(Process const& process,
-                                     PeFile const& pe_file)
-    : process_{&process}, pe_file_{&pe_file}
-  {
-  }
-
-  explicit BoundImportDescriptorList(Process const&& process,
-                                     PeFile const& pe_file) = delete;
-
-  explicit BoundImportDescriptorList(Process const& process,
-                                     PeFile&& pe_file) = delete;
-
-  explicit BoundImportDescriptorList(Process const&& process,
-                                     PeFile&& pe_file) = delete;
-
-  iterator begin()
-  {
-    return iterator{*process_, *pe_file_};
-  }
-
-  const_iterator begin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  const_iterator cbegin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  iterator end() noexcept
-  {
-    return iterator{};
-  }
-
-  const_iterator end() const noexcept
-  {
-    return const_iterator{};
-  }
-
-  const_iterator cend() const noexcept
-  {
-    return const_iterator{};
-  }
-
-private:
-  Process const* process_;
-  PeFile const* pe_file_;
-};
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/optional.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/pelib/bound_import_desc.hpp>
+#include <hadesmem/pelib/nt_headers.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/read.hpp>
+
+// TODO: Add tests.
+
+namespace hadesmem
+{
+// BoundImportDescriptorIterator satisfies the requirements of an input iterator
+// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
+template <typename BoundImportDescriptorT>
+class BoundImportDescriptorIterator
+  : public std::iterator<std::input_iterator_tag, BoundImportDescriptorT>
+{
+public:
+  using BaseIteratorT =
+    std::iterator<std::input_iterator_tag, BoundImportDescriptorT>;
+  using value_type = typename BaseIteratorT::value_type;
+  using difference_type = typename BaseIteratorT::difference_type;
+  using pointer = typename BaseIteratorT::pointer;
+  using reference = typename BaseIteratorT::reference;
+  using iterator_category = typename BaseIteratorT::iterator_category;
+
+  constexpr BoundImportDescriptorIterator() noexcept
+  {
+  }
+
+  explicit BoundImportDescriptorIterator(Process const& process,
+                                         PeFile const& pe_file)
+  {
+    // Descriptors are bounds checked before being read, so the handler is
+    // only reached if memory which is in bounds can't be read (e.g. a remote
+    // image being unloaded).
+    DWORD bound_import_dir_rva = 0;
+    try
+    {
+      NtHeaders const nt_headers{process, pe_file};
+      if (!nt_headers.HasDataDirectory(PeDataDir::BoundImport))
+      {
+        return;
+      }
+      bound_import_dir_rva =
+        nt_headers.GetDataDirectoryVirtualAddress(PeDataDir::BoundImport);
+
+      void* const bound_import_dir_va =
+        RvaToVa(process, pe_file, bound_import_dir_rva);
+      if (!bound_import_dir_va)
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kDirInvalid,
+                                PeComponent::kBoundImports,
+                                bound_import_dir_rva);
+        return;
+      }
+
+      if (!detail::IsInPeFile(pe_file,
+                              bound_import_dir_va,
+                              sizeof(IMAGE_BOUND_IMPORT_DESCRIPTOR)))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kEntryOutOfBounds,
+                                PeComponent::kBoundImports,
+                                bound_import_dir_rva);
+        return;
+      }
+
+      BoundImportDescriptor const bound_import_desc{
+        process, pe_file, nullptr, nullptr};
+      if (!IsTerminator(bound_import_desc))
+      {
+        impl_ = std::make_shared<Impl>(
+          process, pe_file, bound_import_desc, bound_import_dir_rva);
+      }
+    }
+    catch (std::exception const& /*e*/)
+    {
+      detail::AddPeDiagnostic(pe_file,
+                              PeDiagnosticCode::kDirInvalid,
+                              PeComponent::kBoundImports,
+                              bound_import_dir_rva);
+    }
+  }
+
+  explicit BoundImportDescriptorIterator(Process const&& process,
+                                         PeFile const& pe_file) = delete;
+
+  explicit BoundImportDescriptorIterator(Process const& process,
+                                         PeFile&& pe_file) = delete;
+
+  explicit BoundImportDescriptorIterator(Process const&& process,
+                                         PeFile&& pe_file) = delete;
+
+  reference operator*() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return *impl_->bound_import_desc_;
+  }
+
+  pointer operator->() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return &*impl_->bound_import_desc_;
+  }
+
+  BoundImportDescriptorIterator& operator++()
+  {
+    PIMAGE_BOUND_IMPORT_DESCRIPTOR new_base = nullptr;
+    PIMAGE_BOUND_IMPORT_DESCRIPTOR start_base = nullptr;
+    try
+    {
+      HADESMEM_DETAIL_ASSERT(impl_.get());
+
+      auto const cur_base = static_cast<PIMAGE_BOUND_IMPORT_DESCRIPTOR>(
+        impl_->bound_import_desc_->GetBase());
+      new_base = reinterpret_cast<PIMAGE_BOUND_IMPORT_DESCRIPTOR>(
+        reinterpret_cast<IMAGE_BOUND_FORWARDER_REF*>(cur_base + 1) +
+        impl_->bound_import_desc_->GetNumberOfModuleForwarderRefs());
+      start_base = static_cast<PIMAGE_BOUND_IMPORT_DESCRIPTOR>(
+        impl_->bound_import_desc_->GetStart());
+      if (!detail::IsInPeFile(*impl_->pe_file_,
+                              new_base,
+                              sizeof(IMAGE_BOUND_IMPORT_DESCRIPTOR)))
+      {
+        detail::AddPeDiagnostic(*impl_->pe_file_,
+                                PeDiagnosticCode::kEntryOutOfBounds,
+                                PeComponent::kBoundImports,
+                                impl_->dir_rva_,
+                                start_base,
+                                new_base);
+        impl_.reset();
+        return *this;
+      }
+
+      impl_->bound_import_desc_ = BoundImportDescriptor{
+        *impl_->process_, *impl_->pe_file_, start_base, new_base};
+
+      if (IsTerminator(*impl_->bound_import_desc_))
+      {
+        impl_.reset();
+        return *this;
+      }
+    }
+    catch (std::exception const& /*e*/)
+    {
+      // See the constructor. Only reached if in bounds memory can't be read.
+      detail::AddPeDiagnostic(*impl_->pe_file_,
+                              PeDiagnosticCode::kEntryInvalid,
+                              PeComponent::kBoundImports,
+                              impl_->dir_rva_,
+                              start_base,
+                              new_base);
+      impl_.reset();
+    }
+
+    return *this;
+  }
+
+  BoundImportDescriptorIterator operator++(int)
+  {
+    BoundImportDescriptorIterator const iter{*this};
+    ++*this;
+    return iter;
+  }
+
+  bool operator==(BoundImportDescriptorIterator const& other) const noexcept
+  {
+    return impl_ == other.impl_;
+  }
+
+  bool operator!=(BoundImportDescriptorIterator const& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+private:
+  // TODO: Verify this.
+  bool IsTerminator(BoundImportDescriptor const& bound_import_desc) const
+  {
+    // Apparently all three fields are supposed to be zero, but it seems that
+    // may not be the case when it comes to the actual loader implementation?
+    return !bound_import_desc.GetTimeDateStamp() ||
+           !bound_import_desc.GetOffsetModuleName();
+  }
+
+  struct Impl
+  {
+    explicit Impl(Process const& process,
+                  PeFile const& pe_file,
+                  BoundImportDescriptor const& bound_import_desc,
+                  DWORD dir_rva) noexcept
+      : process_{&process},
+        pe_file_{&pe_file},
+        bound_import_desc_{bound_import_desc},
+        dir_rva_{dir_rva}
+    {
+    }
+
+    Process const* process_;
+    PeFile const* pe_file_;
+    hadesmem::detail::Optional<BoundImportDescriptor> bound_import_desc_;
+    DWORD dir_rva_;
+  };
+
+  // Shallow copy semantics, as required by InputIterator.
+  std::shared_ptr<Impl> impl_;
+};
+
+class BoundImportDescriptorList
+{
+public:
+  using value_type = BoundImportDescriptor;
+  using iterator = BoundImportDescriptorIterator<BoundImportDescriptor>;
+  using const_iterator =
+    BoundImportDescriptorIterator<BoundImportDescriptor const>;
+
+  explicit BoundImportDescriptorList(Process const& process,
+                                     PeFile const& pe_file)
+    : process_{&process}, pe_file_{&pe_file}
+  {
+  }
+
+  explicit BoundImportDescriptorList(Process const&& process,
+                                     PeFile const& pe_file) = delete;
+
+  explicit BoundImportDescriptorList(Process const& process,
+                                     PeFile&& pe_file) = delete;
+
+  explicit BoundImportDescriptorList(Process const&& process,
+                                     PeFile&& pe_file) = delete;
+
+  iterator begin()
+  {
+    return iterator{*process_, *pe_file_};
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  const_iterator cbegin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  iterator end() noexcept
+  {
+    return iterator{};
+  }
+
+  const_iterator end() const noexcept
+  {
+    return const_iterator{};
+  }
+
+  const_iterator cend() const noexcept
+  {
+    return const_iterator{};
+  }
+
+private:
+  Process const* process_;
+  PeFile const* pe_file_;
+};
+}
@@ -1,226 +1,448 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <iterator>
-#include <memory>
-#include <utility>
-
-#include <windows.h>
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/detail/assert.hpp>
-#include <hadesmem/detail/optional.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/pelib/export.hpp>
-#include <hadesmem/pelib/export_dir.hpp>
-#include <hadesmem/pelib/pe_file.hpp>
-#include <hadesmem/process.hpp>
-#include <hadesmem/read.hpp>
-
-// TODO: Support using forward iterators via binary search.
-
-namespace hadesmem
-{
-// ExportIterator satisfies the requirements of an input iterator
-// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
-template <typename ExportT>
-class ExportIterator : public std::iterator<std::input_iterator_tag, ExportT>
-{
-public:
-  using BaseIteratorT = std::iterator<std::input_iterator_tag, ExportT>;
-  using value_type = typename BaseIteratorT::value_type;
-  using difference_type = typename BaseIteratorT::difference_type;
-  using pointer = typename BaseIteratorT::pointer;
-  using reference = typename BaseIteratorT::reference;
-  using iterator_category = typename BaseIteratorT::iterator_category;
-
-  constexpr ExportIterator() noexcept : impl_()
-  {
-  }
-
-  explicit ExportIterator(Process const& process, PeFile const& pe_file)
-  {
-    try
-    {
-      ExportDir const export_dir{process, pe_file};
-      Export const exp{
-        process, pe_file, static_cast<WORD>(export_dir.GetOrdinalBase())};
-      impl_ = std::make_shared<Impl>(process, pe_file, exp);
-    }
-    catch (std::exception const& /*e*/)
-    {
-      // Nothing to do here.
-    }
-  }
-
-  explicit ExportIterator(Process const&& process, PeFile const& pe_file) = delete;
-
-  explicit ExportIterator(Process const& process, PeFile&& pe_file) = delete;
-
-  explicit ExportIterator(Process const&& process, PeFile&& pe_file) = delete;
-
-  reference operator*() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return *impl_->export_;
-  }
-
-  pointer operator->() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return &*impl_->export_;
-  }
-
-  ExportIterator& operator++()
-  {
-    try
-    {
-      HADESMEM_DETAIL_ASSERT(impl_.get());
-
-      ExportDir const export_dir{*impl_->process_, *impl_->pe_file_};
-
-      DWORD* ptr_functions =
-        static_cast<DWORD*>(RvaToVa(*impl_->process_,
-                                    *impl_->pe_file_,
-                                    export_dir.GetAddressOfFunctions()));
-
-      DWORD const ordinal_base = export_dir.GetOrdinalBase();
-
-      WORD const procedure_number = impl_->export_->GetProcedureNumber();
-
-      WORD ordinal_number =
-        static_cast<WORD>((procedure_number - ordinal_base) + 1);
-
-      DWORD const num_funcs = export_dir.GetNumberOfFunctions();
-
-      for (; ((ordinal_number + ordinal_base) >= ordinal_base) &&
-             !Read<DWORD>(*impl_->process_, ptr_functions + ordinal_number) &&
-             ordinal_number < num_funcs;
-           ++ordinal_number)
-      {
-      }
-
-      WORD const new_procedure_number =
-        static_cast<WORD>(ordinal_number + ordinal_base);
-
-      // TODO: Investigate whether it's entirely correct to error out here. In
-      // some cases I think it's possible to craft a file which will cause an
-      // overflow within the Windows PE loader but still be loaded and run
-      // correctly...
-      // TODO: Dump should warn for this.
-      if (new_procedure_number < ordinal_base)
-      {
-        HADESMEM_DETAIL_THROW_EXCEPTION(
-          Error{} << ErrorString{"Ordinal number overflow."});
-      }
-
-      if (ordinal_number >= num_funcs)
-      {
-        HADESMEM_DETAIL_THROW_EXCEPTION(
-          Error{} << ErrorString{"Invalid export number."});
-      }
-
-      impl_->export_ =
-        Export{*impl_->process_, *impl_->pe_file_, new_procedure_number};
-    }
-    catch (std::exception const& /*e*/)
-    {
-      impl_.reset();
-    }
-
-    return *this;
-  }
-
-  ExportIterator operator++(int)
-  {
-    ExportIterator const iter{*this};
-    ++*this;
-    return iter;
-  }
-
-  bool operator==(ExportIterator const& other) const noexcept
-  {
-    return impl_ == other.impl_;
-  }
-
-  bool operator!=(ExportIterator const& other) const noexcept
-  {
-    return !(*this == other);
-  }
-
-private:
-  struct Impl
-  {
-    explicit Impl(Process const& process,
-                  PeFile const& pe_file,
-                  Export const& exp) noexcept
-      : process_{&process},
-        pe_file_{&pe_file},
-        export_(exp)
-    {
-    }
-
-    Process const* process_;
-    PeFile const* pe_file_;
-    hadesmem::detail::Optional<Export> export_;
-  };
-
-  // Shallow copy semantics, as required by InputIterator.
-  std::shared_ptr<Impl> impl_;
-};
-
-class ExportList
-{
-public:
-  using value_type = Export;
-  using iterator = ExportIterator<Export>;
-  using const_iterator = ExportIterator<Export const>;
-
-  explicit ExportList(Process const& process, PeFile const& pe_file)
-    : process_{&process}, pe_file_{&pe_file}
-  {
-  }
-
-  explicit ExportList(Process const&& process, PeFile const& pe_file) = delete;
-
-  explicit ExportList(Process const& process, PeFile&& pe_file) = delete;
-
-  explicit ExportList(Process const&& process, PeFile&& pe_file) = delete;
-
-  iterator begin()
-  {
-    return iterator{*process_, *pe_file_};
-  }
-
-  const_iterator begin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  const_iterator cbegin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  iterator end() noexcept
-  {
-    return iterator{};
-  }
-
-  const_iterator end() const noexcept
-  {
-    return const_iterator{};
-  }
-
-  const_iterator cend() const noexcept
-  {
-    return const_iterator{};
-  }
-
-private:
-  Process const* process_;
-  PeFile const* pe_file_;
-};
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/optional.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/pelib/export.hpp>
+#include <hadesmem/pelib/export_dir.hpp>
+#include <hadesmem/pelib/nt_headers.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/read.hpp>
+
+// TODO: Support using forward iterators via binary search.
+
+namespace hadesmem
+{
+// ExportIterator satisfies the requirements of an input iterator
+// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
+template <typename ExportT>
+class ExportIterator : public std::iterator<std::input_iterator_tag, ExportT>
+{
+public:
+  using BaseIteratorT = std::iterator<std::input_iterator_tag, ExportT>;
+  using value_type = typename BaseIteratorT::value_type;
+  using difference_type = typename BaseIteratorT::difference_type;
+  using pointer = typename BaseIteratorT::pointer;
+  using reference = typename BaseIteratorT::reference;
+  using iterator_category = typename BaseIteratorT::iterator_category;
+
+  constexpr ExportIterator() noexcept : impl_()
+  {
+  }
+
+  explicit ExportIterator(Process const& process, PeFile const& pe_file)
+  {
+    // Malformed directories and entries are caught by the bounds checks
+    // below rather than by letting ExportDir or Export throw, so the handler
+    // is only reached if memory which is in bounds can't be read (e.g. a
+    // remote image being unloaded).
+    DWORD export_dir_rva = 0;
+    try
+    {
+      // Most files have no exports, so check for that up front rather than
+      // letting ExportDir throw.
+      NtHeaders const nt_headers{process, pe_file};
+      if (!nt_headers.HasDataDirectory(PeDataDir::Export))
+      {
+        return;
+      }
+      export_dir_rva =
+        nt_headers.GetDataDirectoryVirtualAddress(PeDataDir::Export);
+      DWORD const export_dir_size =
+        nt_headers.GetDataDirectorySize(PeDataDir::Export);
+
+      void* const export_dir_va = RvaToVa(process, pe_file, export_dir_rva);
+      if (!export_dir_va)
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kDirInvalid,
+                                PeComponent::kExports,
+                                export_dir_rva);
+        return;
+      }
+
+      if (!detail::IsInPeFile(
+            pe_file, export_dir_va, sizeof(IMAGE_EXPORT_DIRECTORY)))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kDirOutOfBounds,
+                                PeComponent::kExports,
+                                export_dir_rva);
+        return;
+      }
+
+      ExportDir const export_dir{process, pe_file};
+      DWORD const num_funcs = export_dir.GetNumberOfFunctions();
+      if (!num_funcs)
+      {
+        return;
+      }
+
+      DWORD const functions_rva = export_dir.GetAddressOfFunctions();
+      auto const ptr_functions =
+        static_cast<DWORD*>(RvaToVa(process, pe_file, functions_rva));
+      if (!detail::IsArrayInPeFile(pe_file, ptr_functions, num_funcs))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kEntryOutOfBounds,
+                                PeComponent::kExports,
+                                functions_rva);
+        return;
+      }
+
+      auto const impl = std::make_shared<Impl>(process,
+                                               pe_file,
+                                               export_dir_rva,
+                                               export_dir_size,
+                                               functions_rva,
+                                               ptr_functions,
+                                               export_dir.GetOrdinalBase(),
+                                               num_funcs);
+      if (!ReadNames(*impl, export_dir) || !CheckExport(*impl, 0))
+      {
+        return;
+      }
+
+      impl->export_ = Export{
+        process, pe_file, static_cast<WORD>(export_dir.GetOrdinalBase())};
+      impl_ = impl;
+    }
+    catch (std::exception const& /*e*/)
+    {
+      detail::AddPeDiagnostic(pe_file,
+                              PeDiagnosticCode::kDirInvalid,
+                              PeComponent::kExports,
+                              export_dir_rva);
+    }
+  }
+
+  explicit ExportIterator(Process const&& process, PeFile const& pe_file) = delete;
+
+  explicit ExportIterator(Process const& process, PeFile&& pe_file) = delete;
+
+  explicit ExportIterator(Process const&& process, PeFile&& pe_file) = delete;
+
+  reference operator*() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return *impl_->export_;
+  }
+
+  pointer operator->() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return &*impl_->export_;
+  }
+
+  ExportIterator& operator++()
+  {
+    try
+    {
+      HADESMEM_DETAIL_ASSERT(impl_.get());
+
+      // The export directory is cached from construction, and reaching the
+      // end of the list is not an error, so walking a well formed list
+      // doesn't throw.
+      DWORD const ordinal_base = impl_->ordinal_base_;
+      DWORD const num_funcs = impl_->num_funcs_;
+
+      WORD const procedure_number = impl_->export_->GetProcedureNumber();
+
+      DWORD ordinal_number =
+        static_cast<WORD>((procedure_number - ordinal_base) + 1);
+
+      // Skip unused entries.
+      for (; ordinal_number < num_funcs &&
+             (ordinal_number + ordinal_base) >= ordinal_base &&
+             !Read<DWORD>(*impl_->process_,
+                          impl_->ptr_functions_ + ordinal_number);
+           ++ordinal_number)
+      {
+      }
+
+      if (ordinal_number >= num_funcs)
+      {
+        impl_.reset();
+        return *this;
+      }
+
+      // Procedure numbers are 16-bit, so anything past that would wrap around
+      // to an earlier export (and loop forever).
+      // TODO: Investigate whether it's entirely correct to error out here. In
+      // some cases I think it's possible to craft a file which will cause an
+      // overflow within the Windows PE loader but still be loaded and run
+      // correctly...
+      DWORD const new_procedure_number = ordinal_number + ordinal_base;
+      if (new_procedure_number < ordinal_base ||
+          new_procedure_number > (std::numeric_limits<WORD>::max)())
+      {
+        detail::AddPeDiagnostic(*impl_->pe_file_,
+                                PeDiagnosticCode::kOrdinalOverflow,
+                                PeComponent::kExports,
+                                impl_->export_dir_rva_);
+        impl_.reset();
+        return *this;
+      }
+
+      if (!CheckExport(*impl_, ordinal_number))
+      {
+        impl_.reset();
+        return *this;
+      }
+
+      impl_->export_ = Export{*impl_->process_,
+                              *impl_->pe_file_,
+                              static_cast<WORD>(new_procedure_number)};
+    }
+    catch (std::exception const& /*e*/)
+    {
+      // See the constructor. Only reached if in bounds memory can't be read.
+      detail::AddPeDiagnostic(*impl_->pe_file_,
+                              PeDiagnosticCode::kEntryInvalid,
+                              PeComponent::kExports,
+                              impl_->export_dir_rva_);
+      impl_.reset();
+    }
+
+    return *this;
+  }
+
+  ExportIterator operator++(int)
+  {
+    ExportIterator const iter{*this};
+    ++*this;
+    return iter;
+  }
+
+  bool operator==(ExportIterator const& other) const noexcept
+  {
+    return impl_ == other.impl_;
+  }
+
+  bool operator!=(ExportIterator const& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+private:
+  struct Impl
+  {
+    explicit Impl(Process const& process,
+                  PeFile const& pe_file,
+                  DWORD export_dir_rva,
+                  DWORD export_dir_size,
+                  DWORD functions_rva,
+                  DWORD* ptr_functions,
+                  DWORD ordinal_base,
+                  DWORD num_funcs) noexcept
+      : process_{&process},
+        pe_file_{&pe_file},
+        export_dir_rva_{export_dir_rva},
+        export_dir_end_{export_dir_rva + export_dir_size},
+        functions_rva_{functions_rva},
+        ptr_functions_{ptr_functions},
+        ordinal_base_{ordinal_base},
+        num_funcs_{num_funcs}
+    {
+    }
+
+    Process const* process_;
+    PeFile const* pe_file_;
+    hadesmem::detail::Optional<Export> export_;
+    DWORD export_dir_rva_;
+    DWORD export_dir_end_;
+    DWORD functions_rva_;
+    DWORD* ptr_functions_;
+    DWORD ordinal_base_;
+    DWORD num_funcs_;
+    DWORD names_rva_{};
+    DWORD* ptr_names_{};
+    std::vector<WORD> name_ordinals_;
+  };
+
+  // Reads the name ordinal table once up front, checking it and the name
+  // table are in bounds. Export ignores the names if either table doesn't map
+  // at all, so that's not an error.
+  static bool ReadNames(Impl& impl, ExportDir const& export_dir)
+  {
+    DWORD const num_names = export_dir.GetNumberOfNames();
+    if (!num_names)
+    {
+      return true;
+    }
+
+    Process const& process = *impl.process_;
+    PeFile const& pe_file = *impl.pe_file_;
+    DWORD const ordinals_rva = export_dir.GetAddressOfNameOrdinals();
+    DWORD const names_rva = export_dir.GetAddressOfNames();
+    auto const ptr_ordinals =
+      static_cast<WORD*>(RvaToVa(process, pe_file, ordinals_rva));
+    auto const ptr_names =
+      static_cast<DWORD*>(RvaToVa(process, pe_file, names_rva));
+    if (!ptr_ordinals || !ptr_names)
+    {
+      return true;
+    }
+
+    if (!detail::IsArrayInPeFile(pe_file, ptr_ordinals, num_names))
+    {
+      detail::AddPeDiagnostic(pe_file,
+                              PeDiagnosticCode::kEntryOutOfBounds,
+                              PeComponent::kExports,
+                              ordinals_rva);
+      return false;
+    }
+
+    if (!detail::IsArrayInPeFile(pe_file, ptr_names, num_names))
+    {
+      detail::AddPeDiagnostic(pe_file,
+                              PeDiagnosticCode::kEntryOutOfBounds,
+                              PeComponent::kExports,
+                              names_rva);
+      return false;
+    }
+
+    impl.names_rva_ = names_rva;
+    impl.ptr_names_ = ptr_names;
+    impl.name_ordinals_ = ReadVector<WORD>(process, ptr_ordinals, num_names);
+
+    // Not fatal, the name is just never used.
+    for (std::size_t i = 0; i < impl.name_ordinals_.size(); ++i)
+    {
+      if (impl.name_ordinals_[i] >= impl.num_funcs_)
+      {
+        detail::AddPeDiagnostic(
+          pe_file,
+          PeDiagnosticCode::kOrdinalOutOfBounds,
+          PeComponent::kExports,
+          static_cast<DWORD>(ordinals_rva + i * sizeof(WORD)));
+      }
+    }
+
+    return true;
+  }
+
+  // Checks everything Export would otherwise throw on (other than failing to
+  // read memory which is in bounds) for the given entry.
+  static bool CheckExport(Impl const& impl, DWORD ordinal_number)
+  {
+    Process const& process = *impl.process_;
+    PeFile const& pe_file = *impl.pe_file_;
+
+    DWORD const func_rva =
+      Read<DWORD>(process, impl.ptr_functions_ + ordinal_number);
+    // Same test Export uses to detect forwarders.
+    if (func_rva >= impl.export_dir_rva_ && func_rva + 4 < impl.export_dir_end_)
+    {
+      void* const forwarder = RvaToVa(process, pe_file, func_rva);
+      if (!detail::IsInPeFile(pe_file, forwarder, 1) ||
+          detail::CheckedReadString<char>(process, pe_file, forwarder)
+              .find('.') == std::string::npos)
+      {
+        detail::AddPeDiagnostic(
+          pe_file,
+          PeDiagnosticCode::kEntryInvalid,
+          PeComponent::kExports,
+          static_cast<DWORD>(impl.functions_rva_ +
+                             ordinal_number * sizeof(DWORD)));
+        return false;
+      }
+    }
+
+    auto const& name_ordinals = impl.name_ordinals_;
+    auto const name_ord_iter = std::find(std::begin(name_ordinals),
+                                         std::end(name_ordinals),
+                                         static_cast<WORD>(ordinal_number));
+    if (name_ord_iter != std::end(name_ordinals))
+    {
+      auto const index = static_cast<std::size_t>(
+        std::distance(std::begin(name_ordinals), name_ord_iter));
+      DWORD const name_rva = Read<DWORD>(process, impl.ptr_names_ + index);
+      if (!detail::IsInPeFile(pe_file, RvaToVa(process, pe_file, name_rva), 1))
+      {
+        detail::AddPeDiagnostic(
+          pe_file,
+          PeDiagnosticCode::kEntryInvalid,
+          PeComponent::kExports,
+          static_cast<DWORD>(impl.names_rva_ + index * sizeof(DWORD)));
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // Shallow copy semantics, as required by InputIterator.
+  std::shared_ptr<Impl> impl_;
+};
+
+class ExportList
+{
+public:
+  using value_type = Export;
+  using iterator = ExportIterator<Export>;
+  using const_iterator = ExportIterator<Export const>;
+
+  explicit ExportList(Process const& process, PeFile const& pe_file)
+    : process_{&process}, pe_file_{&pe_file}
+  {
+  }
+
+  explicit ExportList(Process const&& process, PeFile const& pe_file) = delete;
+
+  explicit ExportList(Process const& process, PeFile&& pe_file) = delete;
+
+  explicit ExportList(Process const&& process, PeFile&& pe_file) = delete;
+
+  iterator begin()
+  {
+    return iterator{*process_, *pe_file_};
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  const_iterator cbegin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  iterator end() noexcept
+  {
+    return iterator{};
+  }
+
+  const_iterator end() const noexcept
+  {
+    return const_iterator{};
+  }
+
+  const_iterator cend() const noexcept
+  {
+    return const_iterator{};
+  }
+
+private:
+  Process const* process_;
+  PeFile const* pe_file_;
+};
+}
@@ -1,200 +1,280 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <iterator>
-#include <memory>
-#include <utility>
-
-#include <windows.h>
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/detail/assert.hpp>
-#include <hadesmem/detail/optional.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/pelib/import_dir.hpp>
-#include <hadesmem/pelib/pe_file.hpp>
-#include <hadesmem/process.hpp>
-#include <hadesmem/read.hpp>
-
-namespace hadesmem
-{
-// ImportDirIterator satisfies the requirements of an input iterator
-// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
-template <typename ImportDirT>
-class ImportDirIterator
-  : public std::iterator<std::input_iterator_tag, ImportDirT>
-{
-public:
-  using BaseIteratorT = std::iterator<std::input_iterator_tag, ImportDirT>;
-  using value_type = typename BaseIteratorT::value_type;
-  using difference_type = typename BaseIteratorT::difference_type;
-  using pointer = typename BaseIteratorT::pointer;
-  using reference = typename BaseIteratorT::reference;
-  using iterator_category = typename BaseIteratorT::iterator_category;
-
-  constexpr ImportDirIterator() noexcept
-  {
-  }
-
-  explicit ImportDirIterator(Process const& process, PeFile const& pe_file)
-  {
-    try
-    {
-      ImportDir const import_dir{process, pe_file, nullptr};
-      if (!IsTerminator(import_dir))
-      {
-        impl_ = std::make_shared<Impl>(process, pe_file, import_dir);
-      }
-    }
-    catch (std::exception const& /*e*/)
-    {
-      // Nothing to do here.
-    }
-  }
-
-  explicit ImportDirIterator(Process const&& process, PeFile const& pe_file) = delete;
-
-  explicit ImportDirIterator(Process const& process, PeFile&& pe_file) = delete;
-
-  explicit ImportDirIterator(Process const&& process, PeFile&& pe_file) = delete;
-
-  reference operator*() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return *impl_->import_dir_;
-  }
-
-  pointer operator->() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return &*impl_->import_dir_;
-  }
-
-  ImportDirIterator& operator++()
-  {
-    try
-    {
-      HADESMEM_DETAIL_ASSERT(impl_.get());
-
-      auto const cur_base = reinterpret_cast<PIMAGE_IMPORT_DESCRIPTOR>(
-        impl_->import_dir_->GetBase());
-      impl_->import_dir_ =
-        ImportDir{*impl_->process_, *impl_->pe_file_, cur_base + 1};
-
-      if (IsTerminator(*impl_->import_dir_))
-      {
-        impl_.reset();
-        return *this;
-      }
-    }
-    catch (std::exception const& /*e*/)
-    {
-      impl_.reset();
-    }
-
-    return *this;
-  }
-
-  ImportDirIterator operator++(int)
-  {
-    ImportDirIterator const iter{*this};
-    ++*this;
-    return iter;
-  }
-
-  bool operator==(ImportDirIterator const& other) const noexcept
-  {
-    return impl_ == other.impl_;
-  }
-
-  bool operator!=(ImportDirIterator const& other) const noexcept
-  {
-    return !(*this == other);
-  }
-
-private:
-  bool IsTerminator(ImportDir const& import_dir) const
-  {
-    // If the Name is NULL then the other fields can be non-NULL
-    // but the entire entry will still be skipped by the Windows
-    // loader.
-    bool const has_name = !!import_dir.GetNameRaw();
-    bool const has_iat = !!import_dir.GetFirstThunk();
-    return (!has_name || !has_iat);
-  }
-
-  struct Impl
-  {
-    explicit Impl(Process const& process,
-                  PeFile const& pe_file,
-                  ImportDir const& import_dir) noexcept
-      : process_{&process},
-        pe_file_{&pe_file},
-        import_dir_{import_dir}
-    {
-    }
-
-    Process const* process_;
-    PeFile const* pe_file_;
-    hadesmem::detail::Optional<ImportDir> import_dir_;
-  };
-
-  // Shallow copy semantics, as required by InputIterator.
-  std::shared_ptr<Impl> impl_;
-};
-
-class ImportDirList
-{
-public:
-  using value_type = ImportDir;
-  using iterator = ImportDirIterator<ImportDir>;
-  using const_iterator = ImportDirIterator<ImportDir const>;
-
-  explicit ImportDirList(Process const& process, PeFile const& pe_file)
-    : process_{&process}, pe_file_{&pe_file}
-  {
-  }
-
-  explicit ImportDirList(Process const&& process, PeFile const& pe_file) = delete;
-
-  explicit ImportDirList(Process const& process, PeFile&& pe_file) = delete;
-
-  explicit ImportDirList(Process const&& process, PeFile&& pe_file) = delete;
-
-  iterator begin()
-  {
-    return iterator{*process_, *pe_file_};
-  }
-
-  const_iterator begin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  const_iterator cbegin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  iterator end() noexcept
-  {
-    return iterator{};
-  }
-
-  const_iterator end() const noexcept
-  {
-    return const_iterator{};
-  }
-
-  const_iterator cend() const noexcept
-  {
-    return const_iterator{};
-  }
-
-private:
-  Process const* process_;
-  PeFile const* pe_file_;
-};
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/optional.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/pelib/import_dir.hpp>
+#include <hadesmem/pelib/nt_headers.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/read.hpp>
+
+namespace hadesmem
+{
+// ImportDirIterator satisfies the requirements of an input iterator
+// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
+template <typename ImportDirT>
+class ImportDirIterator
+  : public std::iterator<std::input_iterator_tag, ImportDirT>
+{
+public:
+  using BaseIteratorT = std::iterator<std::input_iterator_tag, ImportDirT>;
+  using value_type = typename BaseIteratorT::value_type;
+  using difference_type = typename BaseIteratorT::difference_type;
+  using pointer = typename BaseIteratorT::pointer;
+  using reference = typename BaseIteratorT::reference;
+  using iterator_category = typename BaseIteratorT::iterator_category;
+
+  constexpr ImportDirIterator() noexcept
+  {
+  }
+
+  explicit ImportDirIterator(Process const& process, PeFile const& pe_file)
+  {
+    // Malformed directories and descriptors are caught by the bounds checks
+    // below rather than by letting ImportDir throw, so the handler is only
+    // reached if memory which is in bounds can't be read (e.g. a remote image
+    // being unloaded).
+    DWORD import_dir_rva = 0;
+    try
+    {
+      // Most files (unlike most modules) will reach here, so check for the
+      // common case of there being no imports up front rather than letting
+      // ImportDir throw.
+      NtHeaders const nt_headers{process, pe_file};
+      if (!nt_headers.HasDataDirectory(PeDataDir::Import))
+      {
+        return;
+      }
+      import_dir_rva =
+        nt_headers.GetDataDirectoryVirtualAddress(PeDataDir::Import);
+
+      // ImportDir also accepts a descriptor which only starts being backed by
+      // the file part way through (see ImportDir::IsVirtualBegin), in which
+      // case the last DWORD is always in the file.
+      void* const import_dir_va = RvaToVa(process, pe_file, import_dir_rva);
+      if (!import_dir_va &&
+          !RvaToVa(process,
+                   pe_file,
+                   static_cast<DWORD>(import_dir_rva + sizeof(DWORD) * 3)))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kDirInvalid,
+                                PeComponent::kImports,
+                                import_dir_rva);
+        return;
+      }
+
+      if (import_dir_va &&
+          !detail::IsInPeFile(
+            pe_file, import_dir_va, sizeof(IMAGE_IMPORT_DESCRIPTOR)))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kEntryOutOfBounds,
+                                PeComponent::kImports,
+                                import_dir_rva);
+        return;
+      }
+
+      ImportDir const import_dir{process, pe_file, nullptr};
+      if (!IsTerminator(import_dir))
+      {
+        impl_ =
+          std::make_shared<Impl>(process, pe_file, import_dir, import_dir_rva);
+      }
+    }
+    catch (std::exception const& /*e*/)
+    {
+      detail::AddPeDiagnostic(pe_file,
+                              PeDiagnosticCode::kDirInvalid,
+                              PeComponent::kImports,
+                              import_dir_rva);
+    }
+  }
+
+  explicit ImportDirIterator(Process const&& process, PeFile const& pe_file) = delete;
+
+  explicit ImportDirIterator(Process const& process, PeFile&& pe_file) = delete;
+
+  explicit ImportDirIterator(Process const&& process, PeFile&& pe_file) = delete;
+
+  reference operator*() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return *impl_->import_dir_;
+  }
+
+  pointer operator->() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return &*impl_->import_dir_;
+  }
+
+  ImportDirIterator& operator++()
+  {
+    try
+    {
+      HADESMEM_DETAIL_ASSERT(impl_.get());
+
+      auto const cur_base = reinterpret_cast<PIMAGE_IMPORT_DESCRIPTOR>(
+        impl_->import_dir_->GetBase());
+      auto const next_base = cur_base + 1;
+      impl_->rva_ += sizeof(IMAGE_IMPORT_DESCRIPTOR);
+
+      PeFile const& pe_file = *impl_->pe_file_;
+      if (!detail::IsInPeFile(
+            pe_file, next_base, sizeof(IMAGE_IMPORT_DESCRIPTOR)))
+      {
+        // A descriptor which lies entirely past the end of a data file is in
+        // the zero fill of its section once mapped, which terminates the
+        // list, so only one which is cut off part way through is an error.
+        // Sample: imports_vterm.exe (Corkami PE Corpus)
+        if (pe_file.GetType() != PeFileType::kData ||
+            detail::IsInPeFile(pe_file, next_base, 1))
+        {
+          detail::AddPeDiagnostic(pe_file,
+                                  PeDiagnosticCode::kEntryOutOfBounds,
+                                  PeComponent::kImports,
+                                  impl_->rva_);
+        }
+        impl_.reset();
+        return *this;
+      }
+
+      impl_->import_dir_ =
+        ImportDir{*impl_->process_, *impl_->pe_file_, next_base};
+
+      if (IsTerminator(*impl_->import_dir_))
+      {
+        impl_.reset();
+        return *this;
+      }
+    }
+    catch (std::exception const& /*e*/)
+    {
+      // See the constructor. Only reached if in bounds memory can't be read.
+      detail::AddPeDiagnostic(*impl_->pe_file_,
+                              PeDiagnosticCode::kEntryInvalid,
+                              PeComponent::kImports,
+                              impl_->rva_);
+      impl_.reset();
+    }
+
+    return *this;
+  }
+
+  ImportDirIterator operator++(int)
+  {
+    ImportDirIterator const iter{*this};
+    ++*this;
+    return iter;
+  }
+
+  bool operator==(ImportDirIterator const& other) const noexcept
+  {
+    return impl_ == other.impl_;
+  }
+
+  bool operator!=(ImportDirIterator const& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+private:
+  bool IsTerminator(ImportDir const& import_dir) const
+  {
+    // If the Name is NULL then the other fields can be non-NULL
+    // but the entire entry will still be skipped by the Windows
+    // loader.
+    bool const has_name = !!import_dir.GetNameRaw();
+    bool const has_iat = !!import_dir.GetFirstThunk();
+    return (!has_name || !has_iat);
+  }
+
+  struct Impl
+  {
+    explicit Impl(Process const& process,
+                  PeFile const& pe_file,
+                  ImportDir const& import_dir,
+                  DWORD rva) noexcept
+      : process_{&process},
+        pe_file_{&pe_file},
+        import_dir_{import_dir},
+        rva_{rva}
+    {
+    }
+
+    Process const* process_;
+    PeFile const* pe_file_;
+    hadesmem::detail::Optional<ImportDir> import_dir_;
+    DWORD rva_;
+  };
+
+  // Shallow copy semantics, as required by InputIterator.
+  std::shared_ptr<Impl> impl_;
+};
+
+class ImportDirList
+{
+public:
+  using value_type = ImportDir;
+  using iterator = ImportDirIterator<ImportDir>;
+  using const_iterator = ImportDirIterator<ImportDir const>;
+
+  explicit ImportDirList(Process const& process, PeFile const& pe_file)
+    : process_{&process}, pe_file_{&pe_file}
+  {
+  }
+
+  explicit ImportDirList(Process const&& process, PeFile const& pe_file) = delete;
+
+  explicit ImportDirList(Process const& process, PeFile&& pe_file) = delete;
+
+  explicit ImportDirList(Process const&& process, PeFile&& pe_file) = delete;
+
+  iterator begin()
+  {
+    return iterator{*process_, *pe_file_};
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  const_iterator cbegin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  iterator end() noexcept
+  {
+    return iterator{};
+  }
+
+  const_iterator end() const noexcept
+  {
+    return const_iterator{};
+  }
+
+  const_iterator cend() const noexcept
+  {
+    return const_iterator{};
+  }
+
+private:
+  Process const* process_;
+  PeFile const* pe_file_;
+};
+}
@@ -0,0 +1,289 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/process.hpp>
+
+// Malformed or suspicious structures found while parsing a PE file. PeLib
+// types which can't represent a malformed structure (e.g. list iterators,
+// which simply end early) record why here instead of silently swallowing the
+// error, so tools can warn without having to catch exceptions and re-derive
+// the reason themselves.
+// Recording is opt-in, by passing a PeDiagnostics to the PeFile constructor.
+
+namespace hadesmem
+{
+enum class PeComponent
+{
+  kExports,
+  kImports,
+  kBoundImports,
+  kRelocations
+};
+
+enum class PeDiagnosticCode
+{
+  // Data directory RVA doesn't map to the file.
+  kDirInvalid,
+  // Data directory extends past the end of the file.
+  kDirOutOfBounds,
+  // An entry is malformed or unreadable, so the rest of the list is ignored.
+  kEntryInvalid,
+  // An entry's size would take it outside of its directory.
+  kEntryOverflow,
+  // Export ordinals wrap around.
+  kOrdinalOverflow,
+  // An entry (or a table it refers to) extends past the end of the file.
+  kEntryOutOfBounds,
+  // A named export's ordinal is past the end of the export address table, so
+  // the name is never used.
+  kOrdinalOutOfBounds
+};
+
+struct PeDiagnostic
+{
+  PeDiagnosticCode code;
+  PeComponent component;
+  // RVA of the offending structure, or zero if it has no RVA.
+  DWORD rva;
+};
+
+inline char const* GetPeComponentName(PeComponent component) noexcept
+{
+  switch (component)
+  {
+  case PeComponent::kExports:
+    return "Exports";
+  case PeComponent::kImports:
+    return "Imports";
+  case PeComponent::kBoundImports:
+    return "BoundImports";
+  case PeComponent::kRelocations:
+    return "Relocations";
+  }
+
+  HADESMEM_DETAIL_ASSERT(false);
+  return "Unknown";
+}
+
+inline char const* GetPeDiagnosticDescription(PeDiagnosticCode code) noexcept
+{
+  switch (code)
+  {
+  case PeDiagnosticCode::kDirInvalid:
+    return "Directory is invalid.";
+  case PeDiagnosticCode::kDirOutOfBounds:
+    return "Directory extends past the end of the file.";
+  case PeDiagnosticCode::kEntryInvalid:
+    return "Entry is invalid.";
+  case PeDiagnosticCode::kEntryOverflow:
+    return "Entry extends past the end of the directory.";
+  case PeDiagnosticCode::kOrdinalOverflow:
+    return "Ordinal number overflow.";
+  case PeDiagnosticCode::kEntryOutOfBounds:
+    return "Entry extends past the end of the file.";
+  case PeDiagnosticCode::kOrdinalOutOfBounds:
+    return "Name ordinal is out of bounds.";
+  }
+
+  HADESMEM_DETAIL_ASSERT(false);
+  return "Unknown.";
+}
+
+// The first few entries are stored inline (most files have none, and the rest
+// rarely have more than a handful), with the remainder in fixed size chunks
+// which are kept when the list is cleared, so a single instance can be reused
+// for each file in a scan without allocating.
+class PeDiagnostics
+{
+public:
+  PeDiagnostics() = default;
+
+  PeDiagnostics(PeDiagnostics const&) = delete;
+
+  PeDiagnostics& operator=(PeDiagnostics const&) = delete;
+
+  // Duplicates are ignored, as lists are typically iterated more than once.
+  // Entries past the limit (or which can't be allocated) are dropped and the
+  // list is marked as truncated rather than throwing.
+  void Add(PeDiagnosticCode code, PeComponent component, DWORD rva) noexcept
+  {
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      auto const& d = (*this)[i];
+      if (d.code == code && d.component == component && d.rva == rva)
+      {
+        return;
+      }
+    }
+
+    if (size_ >= kMaxSize)
+    {
+      truncated_ = true;
+      return;
+    }
+
+    PeDiagnostic* slot = nullptr;
+    if (size_ < kInlineSize)
+    {
+      slot = &inline_[size_];
+    }
+    else
+    {
+      auto const index = size_ - kInlineSize;
+      auto const chunk = index / kChunkSize;
+      if (chunk == chunks_.size())
+      {
+        try
+        {
+          std::unique_ptr<PeDiagnostic[]> new_chunk{
+            new PeDiagnostic[kChunkSize]};
+          chunks_.push_back(std::move(new_chunk));
+        }
+        catch (std::bad_alloc const& /*e*/)
+        {
+          truncated_ = true;
+          return;
+        }
+      }
+      slot = &chunks_[chunk][index % kChunkSize];
+    }
+
+    *slot = PeDiagnostic{code, component, rva};
+    ++size_;
+  }
+
+  void Clear() noexcept
+  {
+    size_ = 0;
+    truncated_ = false;
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return size_;
+  }
+
+  bool IsEmpty() const noexcept
+  {
+    return !size_;
+  }
+
+  bool IsTruncated() const noexcept
+  {
+    return truncated_;
+  }
+
+  PeDiagnostic const& operator[](std::size_t index) const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(index < size_);
+    if (index < kInlineSize)
+    {
+      return inline_[index];
+    }
+
+    index -= kInlineSize;
+    return chunks_[index / kChunkSize][index % kChunkSize];
+  }
+
+  bool Has(PeDiagnosticCode code) const noexcept
+  {
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      if ((*this)[i].code == code)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool Has(PeComponent component) const noexcept
+  {
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      if ((*this)[i].component == component)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  static std::size_t const kInlineSize = 8;
+  static std::size_t const kChunkSize = 64;
+  static std::size_t const kMaxSize = 1024;
+
+private:
+  std::array<PeDiagnostic, kInlineSize> inline_;
+  std::vector<std::unique_ptr<PeDiagnostic[]>> chunks_;
+  std::size_t size_{0};
+  bool truncated_{false};
+};
+
+namespace detail
+{
+inline void AddPeDiagnostic(PeFile const& pe_file,
+                            PeDiagnosticCode code,
+                            PeComponent component,
+                            DWORD rva) noexcept
+{
+  if (auto const diagnostics = pe_file.GetDiagnostics())
+  {
+    diagnostics->Add(code, component, rva);
+  }
+}
+
+// For structures inside a directory (or table) whose RVA is known, so the
+// structure's own RVA can be derived without walking the section table.
+inline void AddPeDiagnostic(PeFile const& pe_file,
+                            PeDiagnosticCode code,
+                            PeComponent component,
+                            DWORD dir_rva,
+                            void const* dir_va,
+                            void const* va) noexcept
+{
+  auto const offset = reinterpret_cast<std::uintptr_t>(va) -
+                      reinterpret_cast<std::uintptr_t>(dir_va);
+  AddPeDiagnostic(
+    pe_file, code, component, static_cast<DWORD>(dir_rva + offset));
+}
+
+// For structures we only have a pointer to. In an image that's just the
+// offset from the base, but in a data file mapping it back to an RVA means
+// walking the section table (which may be what's malformed), so the RVA is
+// left as zero there.
+inline void AddPeDiagnostic(PeFile const& pe_file,
+                            PeDiagnosticCode code,
+                            PeComponent component,
+                            void const* va) noexcept
+{
+  DWORD rva = 0;
+  if (pe_file.GetType() == PeFileType::kImage && IsInPeFile(pe_file, va, 0))
+  {
+    rva = static_cast<DWORD>(reinterpret_cast<std::uintptr_t>(va) -
+                             reinterpret_cast<std::uintptr_t>(
+                               pe_file.GetBase()));
+  }
+
+  AddPeDiagnostic(pe_file, code, component, rva);
+}
+}
+}
@@ -46,10 +46,6 @@
 // general should be removed, as ideally we could make the PeFile code
 // OS-independent as all we're doing is parsing files.
 
-// TODO: Move to an attribute based system for warning on malformed or
-// suspicious files. Also important for testing, so we can ensure certain
-// branches are hit.
-
 // TODO: Return correctly typed pointers from GetBase, GetStart, etc. (Adjust
 // ostream overloads to cast to void*).
 
@@ -95,12 +91,13 @@
 // TODO: Write and use synthetic files similar to Corkami as part of unit tests.
 // One sample per trick/feature/etc.
 
-// TODO: Stop hard-swallowing warnings/errors in PeLib types, they should be
-// exposed to the tools (e.g. so Dump can warn). This should probably be fixed
-// with the aformentioned attributes suggestion.
+// TODO: Record diagnostics (see pe_diagnostics.hpp) for suspicious (rather
+// than just malformed) structures, and from the non-list types (e.g. TlsDir).
 
 namespace hadesmem
 {
+class PeDiagnostics;
+
 // TODO: Investigate if there is a better way to implement PeLib rather than
 // branching on PeFileType everywhere.
 enum class PeFileType
@@ -112,14 +109,18 @@ enum class PeFileType
 class PeFile
 {
 public:
+  // If diagnostics is not null, problems found while parsing the file are
+  // recorded there rather than being discarded.
   explicit PeFile(Process const& process,
                   void* address,
                   PeFileType type,
-                  DWORD size)
+                  DWORD size,
+                  PeDiagnostics* diagnostics = nullptr)
     : process_{&process},
       base_{static_cast<std::uint8_t*>(address)},
       type_{type},
-      size_{size}
+      size_{size},
+      diagnostics_{diagnostics}
   {
     HADESMEM_DETAIL_ASSERT(base_ != 0);
     if (type == PeFileType::kData && !size)
@@ -173,7 +174,8 @@ public:
   explicit PeFile(Process const&& process,
                   void* address,
                   PeFileType type,
-                  DWORD size) = delete;
+                  DWORD size,
+                  PeDiagnostics* diagnostics = nullptr) = delete;
 
   PVOID GetBase() const noexcept
   {
@@ -195,11 +197,17 @@ public:
     return is_64_;
   }
 
+  PeDiagnostics* GetDiagnostics() const noexcept
+  {
+    return diagnostics_;
+  }
+
 private:
   Process const* process_;
   PBYTE base_;
   PeFileType type_;
   DWORD size_;
+  PeDiagnostics* diagnostics_;
   bool is_64_{false};
 };
 
@@ -559,6 +567,28 @@ inline DWORD FileOffsetToRva(Process const& process,
 
 namespace detail
 {
+// Whether [ptr, ptr + len) lies entirely inside the file (or image), so
+// reading it can't run off the end of the buffer.
+inline bool
+  IsInPeFile(PeFile const& pe_file, void const* ptr, std::size_t len) noexcept
+{
+  auto const base = reinterpret_cast<std::uintptr_t>(pe_file.GetBase());
+  auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+  std::size_t const size = pe_file.GetSize();
+  return address >= base && address - base <= size &&
+         size - (address - base) >= len;
+}
+
+// As above, for an array of count Ts (checking the size for overflow).
+template <typename T>
+bool IsArrayInPeFile(PeFile const& pe_file,
+                     T const* ptr,
+                     std::size_t count) noexcept
+{
+  return count <= pe_file.GetSize() / sizeof(T) &&
+         IsInPeFile(pe_file, ptr, count * sizeof(T));
+}
+
 // TODO: Handle virtual termination.
 // TODO: Warn in tools when EOF/Virtual/etc. termination is detected.
 // TODO: Move this somewhere more appropriate.
@@ -1,252 +1,316 @@
-// Copyright (C) 2010-2015 Joshua Boyce
-// See the file COPYING for copying permission.
-
-#pragma once
-
-#include <iterator>
-#include <memory>
-#include <utility>
-
-#include <windows.h>
-
-#include <hadesmem/config.hpp>
-#include <hadesmem/detail/assert.hpp>
-#include <hadesmem/detail/optional.hpp>
-#include <hadesmem/error.hpp>
-#include <hadesmem/pelib/nt_headers.hpp>
-#include <hadesmem/pelib/relocation_block.hpp>
-#include <hadesmem/pelib/pe_file.hpp>
-#include <hadesmem/process.hpp>
-#include <hadesmem/read.hpp>
-
-// TODO: Add tests.
-
-namespace hadesmem
-{
-// RelocationBlockIterator satisfies the requirements of an input iterator
-// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
-template <typename RelocationBlockT>
-class RelocationBlockIterator
-  : public std::iterator<std::input_iterator_tag, RelocationBlockT>
-{
-public:
-  using BaseIteratorT =
-    std::iterator<std::input_iterator_tag, RelocationBlockT>;
-  using value_type = typename BaseIteratorT::value_type;
-  using difference_type = typename BaseIteratorT::difference_type;
-  using pointer = typename BaseIteratorT::pointer;
-  using reference = typename BaseIteratorT::reference;
-  using iterator_category = typename BaseIteratorT::iterator_category;
-
-  constexpr RelocationBlockIterator() noexcept
-  {
-  }
-
-  explicit RelocationBlockIterator(Process const& process,
-                                   PeFile const& pe_file)
-  {
-    try
-    {
-      NtHeaders const nt_headers{process, pe_file};
-
-      DWORD const data_dir_va =
-        nt_headers.GetDataDirectoryVirtualAddress(PeDataDir::BaseReloc);
-      DWORD const size = nt_headers.GetDataDirectorySize(PeDataDir::BaseReloc);
-      if (!data_dir_va || !size)
-      {
-        return;
-      }
-
-      auto base =
-        static_cast<std::uint8_t*>(RvaToVa(process, pe_file, data_dir_va));
-      if (!base)
-      {
-        return;
-      }
-
-      // Cast to integer and back to avoid pointer overflow UB.
-      auto const reloc_dir_end = reinterpret_cast<void const*>(
-        reinterpret_cast<std::uintptr_t>(base) + size);
-      auto const file_end =
-        static_cast<std::uint8_t*>(pe_file.GetBase()) + pe_file.GetSize();
-      // Sample: virtrelocXP.exe
-      if (pe_file.GetType() == PeFileType::kData &&
-          (reloc_dir_end < base || reloc_dir_end > file_end))
-      {
-        return;
-      }
-
-      // TODO: Dump should warn for this.
-      RelocationBlock const relocation_block{
-        process,
-        pe_file,
-        reinterpret_cast<IMAGE_BASE_RELOCATION*>(base),
-        reloc_dir_end};
-      if (relocation_block.IsInvalid())
-      {
-        return;
-      }
-
-      impl_ = std::make_shared<Impl>(
-        process, pe_file, relocation_block, reloc_dir_end);
-    }
-    catch (std::exception const& /*e*/)
-    {
-      // Nothing to do here.
-    }
-  }
-
-  explicit RelocationBlockIterator(Process const&& process,
-                                   PeFile const& pe_file) = delete;
-
-  explicit RelocationBlockIterator(Process const& process,
-                                   PeFile&& pe_file) = delete;
-
-  explicit RelocationBlockIterator(Process const&& process,
-                                   PeFile&& pe_file) = delete;
-
-  reference operator*() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return *impl_->relocation_block_;
-  }
-
-  pointer operator->() const noexcept
-  {
-    HADESMEM_DETAIL_ASSERT(impl_.get());
-    return &*impl_->relocation_block_;
-  }
-
-  RelocationBlockIterator& operator++()
-  {
-    try
-    {
-      HADESMEM_DETAIL_ASSERT(impl_.get());
-
-      auto const next_base = reinterpret_cast<PIMAGE_BASE_RELOCATION>(
-        reinterpret_cast<std::uintptr_t>(
-          impl_->relocation_block_->GetRelocationDataStart()) +
-        (impl_->relocation_block_->GetNumberOfRelocations() * sizeof(WORD)));
-      // TODO: Dump should warn for integer overflow or mis-aligned off-the-end
-      // data.
-      if (next_base < impl_->relocation_block_->GetBase() ||
-          next_base >= impl_->reloc_dir_end_)
-      {
-        impl_.reset();
-        return *this;
-      }
-
-      impl_->relocation_block_ = RelocationBlock{
-        *impl_->process_, *impl_->pe_file_, next_base, impl_->reloc_dir_end_};
-      // TODO: Dump should warn for this.
-      if (impl_->relocation_block_->IsInvalid())
-      {
-        impl_.reset();
-        return *this;
-      }
-    }
-    catch (std::exception const& /*e*/)
-    {
-      impl_.reset();
-    }
-
-    return *this;
-  }
-
-  RelocationBlockIterator operator++(int)
-  {
-    RelocationBlockIterator const iter{*this};
-    ++*this;
-    return iter;
-  }
-
-  bool operator==(RelocationBlockIterator const& other) const noexcept
-  {
-    return impl_ == other.impl_;
-  }
-
-  bool operator!=(RelocationBlockIterator const& other) const noexcept
-  {
-    return !(*this == other);
-  }
-
-private:
-  struct Impl
-  {
-    explicit Impl(Process const& process,
-                  PeFile const& pe_file,
-                  RelocationBlock const& relocation_block,
-                  void const* reloc_dir_end) noexcept
-      : process_(&process),
-        pe_file_(&pe_file),
-        relocation_block_(relocation_block),
-        reloc_dir_end_(reloc_dir_end)
-    {
-    }
-
-    Process const* process_;
-    PeFile const* pe_file_;
-    hadesmem::detail::Optional<RelocationBlock> relocation_block_;
-    void const* reloc_dir_end_;
-  };
-
-  // Shallow copy semantics, as required by InputIterator.
-  std::shared_ptr<Impl> impl_;
-};
-
-class RelocationBlockList
-{
-public:
-  using value_type = RelocationBlock;
-  using iterator = RelocationBlockIterator<RelocationBlock>;
-  using const_iterator = RelocationBlockIterator<RelocationBlock const>;
-
-  explicit RelocationBlockList(Process const& process, PeFile const& pe_file)
-    : process_{&process}, pe_file_{&pe_file}
-  {
-  }
-
-  explicit RelocationBlockList(Process const&& process,
-                               PeFile const& pe_file) = delete;
-
-  explicit RelocationBlockList(Process const& process,
-                               PeFile&& pe_file) = delete;
-
-  explicit RelocationBlockList(Process const&& process,
-                               PeFile&& pe_file) = delete;
-
-  iterator begin()
-  {
-    return iterator{*process_, *pe_file_};
-  }
-
-  const_iterator begin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  const_iterator cbegin() const
-  {
-    return const_iterator{*process_, *pe_file_};
-  }
-
-  iterator end() noexcept
-  {
-    return iterator{};
-  }
-
-  const_iterator end() const noexcept
-  {
-    return const_iterator{};
-  }
-
-  const_iterator cend() const noexcept
-  {
-    return const_iterator{};
-  }
-
-private:
-  Process const* process_;
-  PeFile const* pe_file_;
-};
-}
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <windows.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/optional.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/pelib/nt_headers.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/pelib/relocation_block.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/read.hpp>
+
+// TODO: Add tests.
+
+namespace hadesmem
+{
+// RelocationBlockIterator satisfies the requirements of an input iterator
+// (C++ Standard, 24.2.1, Input Iterators [input.iterators]).
+template <typename RelocationBlockT>
+class RelocationBlockIterator
+  : public std::iterator<std::input_iterator_tag, RelocationBlockT>
+{
+public:
+  using BaseIteratorT =
+    std::iterator<std::input_iterator_tag, RelocationBlockT>;
+  using value_type = typename BaseIteratorT::value_type;
+  using difference_type = typename BaseIteratorT::difference_type;
+  using pointer = typename BaseIteratorT::pointer;
+  using reference = typename BaseIteratorT::reference;
+  using iterator_category = typename BaseIteratorT::iterator_category;
+
+  constexpr RelocationBlockIterator() noexcept
+  {
+  }
+
+  explicit RelocationBlockIterator(Process const& process,
+                                   PeFile const& pe_file)
+  {
+    // Blocks are bounds checked before being read, so the handler is only
+    // reached if memory which is in bounds can't be read (e.g. a remote image
+    // being unloaded).
+    DWORD data_dir_va = 0;
+    try
+    {
+      NtHeaders const nt_headers{process, pe_file};
+      if (!nt_headers.HasDataDirectory(PeDataDir::BaseReloc))
+      {
+        return;
+      }
+
+      data_dir_va =
+        nt_headers.GetDataDirectoryVirtualAddress(PeDataDir::BaseReloc);
+      DWORD const size = nt_headers.GetDataDirectorySize(PeDataDir::BaseReloc);
+      if (!data_dir_va || !size)
+      {
+        return;
+      }
+
+      auto base =
+        static_cast<std::uint8_t*>(RvaToVa(process, pe_file, data_dir_va));
+      if (!base)
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kDirInvalid,
+                                PeComponent::kRelocations,
+                                data_dir_va);
+        return;
+      }
+
+      // Cast to integer and back to avoid pointer overflow UB.
+      auto const reloc_dir_end = reinterpret_cast<void const*>(
+        reinterpret_cast<std::uintptr_t>(base) + size);
+      // Sample: virtrelocXP.exe
+      if (!detail::IsInPeFile(pe_file, base, size))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kDirOutOfBounds,
+                                PeComponent::kRelocations,
+                                data_dir_va);
+        return;
+      }
+
+      if (size < sizeof(IMAGE_BASE_RELOCATION))
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kEntryOverflow,
+                                PeComponent::kRelocations,
+                                data_dir_va);
+        return;
+      }
+
+      RelocationBlock const relocation_block{
+        process,
+        pe_file,
+        reinterpret_cast<IMAGE_BASE_RELOCATION*>(base),
+        reloc_dir_end};
+      if (relocation_block.IsInvalid())
+      {
+        detail::AddPeDiagnostic(pe_file,
+                                PeDiagnosticCode::kEntryInvalid,
+                                PeComponent::kRelocations,
+                                data_dir_va);
+        return;
+      }
+
+      impl_ = std::make_shared<Impl>(
+        process, pe_file, relocation_block, data_dir_va, base, reloc_dir_end);
+    }
+    catch (std::exception const& /*e*/)
+    {
+      detail::AddPeDiagnostic(pe_file,
+                              PeDiagnosticCode::kDirInvalid,
+                              PeComponent::kRelocations,
+                              data_dir_va);
+    }
+  }
+
+  explicit RelocationBlockIterator(Process const&& process,
+                                   PeFile const& pe_file) = delete;
+
+  explicit RelocationBlockIterator(Process const& process,
+                                   PeFile&& pe_file) = delete;
+
+  explicit RelocationBlockIterator(Process const&& process,
+                                   PeFile&& pe_file) = delete;
+
+  reference operator*() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return *impl_->relocation_block_;
+  }
+
+  pointer operator->() const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(impl_.get());
+    return &*impl_->relocation_block_;
+  }
+
+  RelocationBlockIterator& operator++()
+  {
+    PIMAGE_BASE_RELOCATION next_base = nullptr;
+    try
+    {
+      HADESMEM_DETAIL_ASSERT(impl_.get());
+
+      next_base = reinterpret_cast<PIMAGE_BASE_RELOCATION>(
+        reinterpret_cast<std::uintptr_t>(
+          impl_->relocation_block_->GetRelocationDataStart()) +
+        (impl_->relocation_block_->GetNumberOfRelocations() * sizeof(WORD)));
+      if (next_base < impl_->relocation_block_->GetBase() ||
+          next_base > impl_->reloc_dir_end_)
+      {
+        AddDiagnostic(PeDiagnosticCode::kEntryOverflow,
+                      impl_->relocation_block_->GetBase());
+        impl_.reset();
+        return *this;
+      }
+
+      if (next_base == impl_->reloc_dir_end_)
+      {
+        impl_.reset();
+        return *this;
+      }
+
+      // The header of the next block has to fit in the directory too.
+      if (reinterpret_cast<std::uintptr_t>(impl_->reloc_dir_end_) -
+            reinterpret_cast<std::uintptr_t>(next_base) <
+          sizeof(IMAGE_BASE_RELOCATION))
+      {
+        AddDiagnostic(PeDiagnosticCode::kEntryOverflow, next_base);
+        impl_.reset();
+        return *this;
+      }
+
+      impl_->relocation_block_ = RelocationBlock{
+        *impl_->process_, *impl_->pe_file_, next_base, impl_->reloc_dir_end_};
+      if (impl_->relocation_block_->IsInvalid())
+      {
+        AddDiagnostic(PeDiagnosticCode::kEntryInvalid, next_base);
+        impl_.reset();
+        return *this;
+      }
+    }
+    catch (std::exception const& /*e*/)
+    {
+      // See the constructor. Only reached if in bounds memory can't be read.
+      AddDiagnostic(PeDiagnosticCode::kEntryInvalid, next_base);
+      impl_.reset();
+    }
+
+    return *this;
+  }
+
+  RelocationBlockIterator operator++(int)
+  {
+    RelocationBlockIterator const iter{*this};
+    ++*this;
+    return iter;
+  }
+
+  bool operator==(RelocationBlockIterator const& other) const noexcept
+  {
+    return impl_ == other.impl_;
+  }
+
+  bool operator!=(RelocationBlockIterator const& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+private:
+  void AddDiagnostic(PeDiagnosticCode code, void const* block) const noexcept
+  {
+    detail::AddPeDiagnostic(*impl_->pe_file_,
+                            code,
+                            PeComponent::kRelocations,
+                            impl_->reloc_dir_rva_,
+                            impl_->reloc_dir_,
+                            block);
+  }
+
+  struct Impl
+  {
+    explicit Impl(Process const& process,
+                  PeFile const& pe_file,
+                  RelocationBlock const& relocation_block,
+                  DWORD reloc_dir_rva,
+                  void const* reloc_dir,
+                  void const* reloc_dir_end) noexcept
+      : process_(&process),
+        pe_file_(&pe_file),
+        relocation_block_(relocation_block),
+        reloc_dir_rva_(reloc_dir_rva),
+        reloc_dir_(reloc_dir),
+        reloc_dir_end_(reloc_dir_end)
+    {
+    }
+
+    Process const* process_;
+    PeFile const* pe_file_;
+    hadesmem::detail::Optional<RelocationBlock> relocation_block_;
+    DWORD reloc_dir_rva_;
+    void const* reloc_dir_;
+    void const* reloc_dir_end_;
+  };
+
+  // Shallow copy semantics, as required by InputIterator.
+  std::shared_ptr<Impl> impl_;
+};
+
+class RelocationBlockList
+{
+public:
+  using value_type = RelocationBlock;
+  using iterator = RelocationBlockIterator<RelocationBlock>;
+  using const_iterator = RelocationBlockIterator<RelocationBlock const>;
+
+  explicit RelocationBlockList(Process const& process, PeFile const& pe_file)
+    : process_{&process}, pe_file_{&pe_file}
+  {
+  }
+
+  explicit RelocationBlockList(Process const&& process,
+                               PeFile const& pe_file) = delete;
+
+  explicit RelocationBlockList(Process const& process,
+                               PeFile&& pe_file) = delete;
+
+  explicit RelocationBlockList(Process const&& process,
+                               PeFile&& pe_file) = delete;
+
+  iterator begin()
+  {
+    return iterator{*process_, *pe_file_};
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  const_iterator cbegin() const
+  {
+    return const_iterator{*process_, *pe_file_};
+  }
+
+  iterator end() noexcept
+  {
+    return iterator{};
+  }
+
+  const_iterator end() const noexcept
+  {
+    return const_iterator{};
+  }
+
+  const_iterator cend() const noexcept
+  {
+    return const_iterator{};
+  }
+
+private:
+  Process const* process_;
+  PeFile const* pe_file_;
+};
+}
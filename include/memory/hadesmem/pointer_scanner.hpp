@@ -0,0 +1,494 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/parallel_for.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/region_snapshot.hpp>
+#include <hadesmem/scanner.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <hadesmem/module.hpp>
+#include <hadesmem/module_list.hpp>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// Finds multi-level pointer paths from static (module relative) bases to a
+// target address.
+// A PointerIndex is built in one parallel pass over the target's memory and
+// holds every aligned pointer sized value which points into a committed
+// region, sorted by value. Finding paths is then a BFS backwards from the
+// target: at each level, every pointer whose value lies in
+// [address - max_offset, address] is looked up in the index with a binary
+// search, and pointers which live inside a module become results.
+// Each pointer location is only expanded once (at its shallowest depth), so
+// the search is bounded by the size of the index rather than exploding
+// combinatorially, at the cost of only reporting the shortest path through
+// any given pointer.
+
+namespace hadesmem
+{
+struct PointerScanOptions
+{
+  std::size_t max_depth = 5;
+  // Largest offset added to a dereferenced pointer at any level.
+  std::size_t max_offset = 0x1000;
+  std::size_t max_results = 0x10000;
+  // Size (and alignment) of pointers in the target.
+  std::size_t pointer_size = sizeof(void*);
+  std::size_t buffer_size = 0x100000;
+  // Zero means one thread per hardware thread.
+  std::size_t num_threads = 0;
+};
+
+struct PointerScanModule
+{
+  std::wstring name;
+  std::uintptr_t base;
+  std::size_t size;
+};
+
+// Evaluated as: address = module base + module_offset, then for each offset,
+// address = *address + offset. This is stable across restarts of the target
+// (as long as its data structures don't change), unlike the target address.
+struct PointerPath
+{
+  std::wstring module;
+  std::uintptr_t module_offset;
+  std::vector<std::uintptr_t> offsets;
+};
+
+inline bool operator==(PointerPath const& lhs, PointerPath const& rhs)
+{
+  return lhs.module == rhs.module && lhs.module_offset == rhs.module_offset &&
+         lhs.offsets == rhs.offsets;
+}
+
+inline bool operator!=(PointerPath const& lhs, PointerPath const& rhs)
+{
+  return !(lhs == rhs);
+}
+
+namespace detail
+{
+inline std::uintptr_t LoadPointer(std::uint8_t const* p,
+                                  std::size_t pointer_size) noexcept
+{
+  if (pointer_size == sizeof(std::uint32_t))
+  {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  std::uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return static_cast<std::uintptr_t>(value);
+}
+
+inline void ValidatePointerSize(std::size_t pointer_size)
+{
+  if (pointer_size != sizeof(std::uint32_t) &&
+      pointer_size != sizeof(std::uint64_t))
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Invalid pointer size."});
+  }
+}
+}
+
+// Reverse index of the pointers in a target, stored as two parallel arrays
+// (values and the addresses they were found at) sorted by value.
+class PointerIndex
+{
+public:
+  PointerIndex() = default;
+
+  explicit PointerIndex(ScanSource const& source,
+                        PointerScanOptions const& options =
+                          PointerScanOptions())
+  {
+    Build(source, options);
+  }
+
+  explicit PointerIndex(ScanSource&& source,
+                        PointerScanOptions const& options =
+                          PointerScanOptions()) = delete;
+
+  void Build(ScanSource const& source,
+             PointerScanOptions const& options = PointerScanOptions())
+  {
+    detail::ValidatePointerSize(options.pointer_size);
+
+    values_.clear();
+    addresses_.clear();
+
+    RegionSnapshot snapshot;
+    source.GetRegions(snapshot);
+
+    struct Chunk
+    {
+      std::uintptr_t base;
+      std::size_t len;
+      std::vector<std::pair<std::uintptr_t, std::uintptr_t>> pointers;
+    };
+
+    std::size_t const pointer_size = options.pointer_size;
+    std::size_t const buffer_size =
+      (std::max)(options.buffer_size / pointer_size * pointer_size,
+                 pointer_size);
+    std::vector<Chunk> chunks;
+    std::uintptr_t min_valid = (std::numeric_limits<std::uintptr_t>::max)();
+    std::uintptr_t max_valid = 0;
+    for (auto const& region : snapshot)
+    {
+      if (region.state != MEM_COMMIT ||
+          !detail::ScanProtectionMatches(region.protect,
+                                         ScanProtection::kRead))
+      {
+        continue;
+      }
+
+      min_valid = (std::min)(min_valid, region.base);
+      max_valid = (std::max)(max_valid, region.base + region.size);
+
+      std::uintptr_t const begin =
+        (region.base + pointer_size - 1) & ~(pointer_size - 1);
+      std::uintptr_t const end = region.base + region.size;
+      for (std::uintptr_t base = begin;
+           base < end && end - base >= pointer_size;
+           base += buffer_size)
+      {
+        std::size_t const len = static_cast<std::size_t>(
+          (std::min)(static_cast<std::uintptr_t>(buffer_size), end - base));
+        chunks.push_back(Chunk{base, len / pointer_size * pointer_size, {}});
+        if (end - base <= buffer_size)
+        {
+          break;
+        }
+      }
+    }
+
+    detail::ParallelFor(
+      chunks.size(),
+      options.num_threads,
+      [&](std::size_t i)
+      {
+        auto& chunk = chunks[i];
+        std::vector<std::uint8_t> buf(chunk.len);
+        if (!source.Read(chunk.base, buf.data(), buf.size()))
+        {
+          return;
+        }
+
+        for (std::size_t offset = 0; offset < buf.size();
+             offset += pointer_size)
+        {
+          std::uintptr_t const value =
+            detail::LoadPointer(&buf[offset], pointer_size);
+          // Cheap range check first, as the vast majority of values aren't
+          // pointers at all.
+          if (value >= min_valid && value < max_valid &&
+              snapshot.Find(reinterpret_cast<void const*>(value)))
+          {
+            chunk.pointers.emplace_back(value, chunk.base + offset);
+          }
+        }
+      });
+
+    std::size_t count = 0;
+    for (auto const& chunk : chunks)
+    {
+      count += chunk.pointers.size();
+    }
+
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> pointers;
+    pointers.reserve(count);
+    for (auto& chunk : chunks)
+    {
+      pointers.insert(
+        pointers.end(), chunk.pointers.begin(), chunk.pointers.end());
+      decltype(chunk.pointers)().swap(chunk.pointers);
+    }
+    std::sort(std::begin(pointers), std::end(pointers));
+
+    values_.reserve(count);
+    addresses_.reserve(count);
+    for (auto const& pointer : pointers)
+    {
+      values_.push_back(pointer.first);
+      addresses_.push_back(pointer.second);
+    }
+  }
+
+  // Calls func(address, value) for every pointer with a value in [low, high].
+  template <typename Func>
+  void ForEachPointerTo(std::uintptr_t low,
+                        std::uintptr_t high,
+                        Func const& func) const
+  {
+    auto const first =
+      std::lower_bound(std::begin(values_), std::end(values_), low);
+    for (auto iter = first; iter != std::end(values_) && *iter <= high; ++iter)
+    {
+      func(addresses_[iter - std::begin(values_)], *iter);
+    }
+  }
+
+  std::size_t size() const noexcept
+  {
+    return values_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return values_.empty();
+  }
+
+private:
+  std::vector<std::uintptr_t> values_;
+  std::vector<std::uintptr_t> addresses_;
+};
+
+// Results are in BFS order, i.e. shortest paths first.
+inline std::vector<PointerPath>
+  FindPointerPaths(PointerIndex const& index,
+                   std::vector<PointerScanModule> const& modules,
+                   std::uintptr_t target,
+                   PointerScanOptions const& options = PointerScanOptions())
+{
+  std::vector<PointerScanModule> sorted_modules(modules);
+  std::sort(std::begin(sorted_modules),
+            std::end(sorted_modules),
+            [](PointerScanModule const& lhs, PointerScanModule const& rhs)
+            {
+              return lhs.base < rhs.base;
+            });
+  auto const find_module = [&](std::uintptr_t address)
+                             -> PointerScanModule const *
+  {
+    auto const iter = std::upper_bound(
+      std::begin(sorted_modules),
+      std::end(sorted_modules),
+      address,
+      [](std::uintptr_t a, PointerScanModule const& module)
+      {
+        return a < module.base;
+      });
+    if (iter == std::begin(sorted_modules) ||
+        address - (iter - 1)->base >= (iter - 1)->size)
+    {
+      return nullptr;
+    }
+    return &*(iter - 1);
+  };
+
+  // Each node is a pointer location, plus the offset to apply after
+  // dereferencing it and the node (closer to the target) it leads to.
+  struct Node
+  {
+    std::uintptr_t address;
+    std::uintptr_t offset;
+    std::size_t next;
+  };
+
+  std::size_t const kNone = static_cast<std::size_t>(-1);
+  std::vector<Node> nodes;
+  nodes.push_back(Node{target, 0, kNone});
+  std::unordered_set<std::uintptr_t> visited;
+  visited.insert(target);
+
+  std::vector<PointerPath> paths;
+  std::size_t level_begin = 0;
+  for (std::size_t depth = 0; depth < options.max_depth &&
+                              level_begin < nodes.size() &&
+                              paths.size() < options.max_results;
+       ++depth)
+  {
+    std::size_t const level_end = nodes.size();
+    for (std::size_t i = level_begin;
+         i < level_end && paths.size() < options.max_results;
+         ++i)
+    {
+      std::uintptr_t const address = nodes[i].address;
+      std::uintptr_t const low =
+        address > options.max_offset ? address - options.max_offset : 0;
+      index.ForEachPointerTo(
+        low,
+        address,
+        [&](std::uintptr_t pointer, std::uintptr_t value)
+        {
+          if (paths.size() >= options.max_results ||
+              !visited.insert(pointer).second)
+          {
+            return;
+          }
+
+          nodes.push_back(Node{pointer, address - value, i});
+
+          if (auto const module = find_module(pointer))
+          {
+            PointerPath path;
+            path.module = module->name;
+            path.module_offset = pointer - module->base;
+            for (std::size_t n = nodes.size() - 1; nodes[n].next != kNone;
+                 n = nodes[n].next)
+            {
+              path.offsets.push_back(nodes[n].offset);
+            }
+            paths.emplace_back(std::move(path));
+          }
+        });
+    }
+
+    level_begin = level_end;
+  }
+
+  return paths;
+}
+
+inline bool ResolvePointerPath(ScanSource const& source,
+                               std::vector<PointerScanModule> const& modules,
+                               PointerPath const& path,
+                               std::uintptr_t& address,
+                               std::size_t pointer_size = sizeof(void*))
+{
+  detail::ValidatePointerSize(pointer_size);
+
+  auto const module = std::find_if(std::begin(modules),
+                                   std::end(modules),
+                                   [&](PointerScanModule const& m)
+                                   {
+                                     return m.name == path.module;
+                                   });
+  if (module == std::end(modules))
+  {
+    return false;
+  }
+
+  address = module->base + path.module_offset;
+  for (auto const offset : path.offsets)
+  {
+    std::uint8_t buf[sizeof(std::uint64_t)];
+    if (!source.Read(address, buf, pointer_size))
+    {
+      return false;
+    }
+    address = detail::LoadPointer(buf, pointer_size) + offset;
+  }
+
+  return true;
+}
+
+// Uses the usual "[[module+0x10]+0x20]+0x30" notation.
+inline std::wstring FormatPointerPath(PointerPath const& path)
+{
+  std::wostringstream str;
+  str.imbue(std::locale::classic());
+  str << std::wstring(path.offsets.size(), L'[') << path.module << L"+0x"
+      << std::hex << std::uppercase << path.module_offset;
+  for (auto const offset : path.offsets)
+  {
+    str << L"]+0x" << offset;
+  }
+  return str.str();
+}
+
+inline PointerPath ParsePointerPath(std::wstring const& str)
+{
+  auto const throw_invalid = []()
+  {
+    HADESMEM_DETAIL_THROW_EXCEPTION(
+      Error{} << ErrorString{"Invalid pointer path."});
+  };
+
+  auto const parse_hex = [&](std::wstring const& s) -> std::uintptr_t
+  {
+    if (s.size() < 3 || s[0] != L'0' || (s[1] != L'x' && s[1] != L'X'))
+    {
+      throw_invalid();
+    }
+    wchar_t* end = nullptr;
+    auto const value =
+      static_cast<std::uintptr_t>(std::wcstoull(s.c_str() + 2, &end, 16));
+    if (end != s.c_str() + s.size())
+    {
+      throw_invalid();
+    }
+    return value;
+  };
+
+  std::size_t const depth = str.find_first_not_of(L'[');
+  if (depth == std::wstring::npos)
+  {
+    throw_invalid();
+  }
+
+  std::size_t const base_end = (std::min)(str.find(L']', depth), str.size());
+  std::wstring const base = str.substr(depth, base_end - depth);
+  std::size_t const plus = base.rfind(L'+');
+  if (plus == std::wstring::npos || !plus)
+  {
+    throw_invalid();
+  }
+
+  PointerPath path;
+  path.module = base.substr(0, plus);
+  path.module_offset = parse_hex(base.substr(plus + 1));
+
+  std::size_t pos = base_end;
+  for (std::size_t i = 0; i < depth; ++i)
+  {
+    if (str.compare(pos, 2, L"]+") != 0)
+    {
+      throw_invalid();
+    }
+    pos += 2;
+    std::size_t const next = (std::min)(str.find(L']', pos), str.size());
+    path.offsets.push_back(parse_hex(str.substr(pos, next - pos)));
+    pos = next;
+  }
+
+  if (pos != str.size())
+  {
+    throw_invalid();
+  }
+
+  return path;
+}
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+inline std::vector<PointerScanModule>
+  GetPointerScanModules(Process const& process)
+{
+  std::vector<PointerScanModule> modules;
+  for (auto const& module : ModuleList(process))
+  {
+    modules.push_back(PointerScanModule{
+      module.GetName(),
+      reinterpret_cast<std::uintptr_t>(module.GetHandle()),
+      module.GetSize()});
+  }
+  return modules;
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
@@ -0,0 +1,326 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/query_region.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+
+// RegionSnapshot is a cheaper alternative to RegionList for code which needs to
+// look at the address space repeatedly (e.g. a scanner polling every frame).
+// Free regions are dropped, the remaining regions are stored in a flat sorted
+// vector which is reused across refreshes, and two snapshots can be diffed so
+// that only the ranges which actually changed need to be looked at again.
+
+namespace hadesmem
+{
+struct RegionRecord
+{
+  std::uintptr_t base;
+  std::uintptr_t alloc_base;
+  std::size_t size;
+  DWORD state;
+  DWORD protect;
+  DWORD type;
+};
+
+struct RegionRange
+{
+  std::uintptr_t base;
+  std::size_t size;
+};
+
+inline bool operator==(RegionRange const& lhs, RegionRange const& rhs) noexcept
+{
+  return lhs.base == rhs.base && lhs.size == rhs.size;
+}
+
+inline bool operator!=(RegionRange const& lhs, RegionRange const& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+struct RegionDiff
+{
+  void Clear() noexcept
+  {
+    added.clear();
+    removed.clear();
+    protect_changed.clear();
+  }
+
+  bool Empty() const noexcept
+  {
+    return added.empty() && removed.empty() && protect_changed.empty();
+  }
+
+  // Ranges which are only present in the new snapshot. Ranges which were
+  // re-allocated (i.e. whose allocation base, state or type changed) are
+  // reported as both removed and added.
+  std::vector<RegionRange> added;
+  // Ranges which are only present in the old snapshot.
+  std::vector<RegionRange> removed;
+  // Ranges which are present in both snapshots but with a different
+  // protection.
+  std::vector<RegionRange> protect_changed;
+};
+
+class RegionSnapshot
+{
+public:
+  using value_type = RegionRecord;
+  using const_iterator = std::vector<RegionRecord>::const_iterator;
+  using iterator = const_iterator;
+
+  RegionSnapshot() = default;
+
+  explicit RegionSnapshot(Process const& process)
+  {
+    Refresh(process);
+  }
+
+  explicit RegionSnapshot(Process&& process) = delete;
+
+  template <typename InputIterator>
+  RegionSnapshot(InputIterator first, InputIterator last)
+  {
+    Assign(first, last);
+  }
+
+  // Storage is reused (including the buffers used to read the maps file on
+  // Linux), so once the snapshot has grown to fit the target's address
+  // space, refreshing doesn't allocate.
+  void Refresh(Process const& process)
+  {
+    records_.clear();
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    detail::ForEachRegion(process,
+                          [this](MEMORY_BASIC_INFORMATION const& mbi)
+                          {
+                            Add(mbi);
+                          });
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    for (auto const& mbi : maps_reader_.Read(process.GetId()))
+    {
+      Add(mbi);
+    }
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    HADESMEM_DETAIL_ASSERT(IsSorted());
+  }
+
+  // Build from an arbitrary sequence of MEMORY_BASIC_INFORMATION (e.g. a
+  // captured or parsed maps file, or a mock for testing). Regions must not
+  // overlap, but don't need to be sorted.
+  template <typename InputIterator>
+  void Assign(InputIterator first, InputIterator last)
+  {
+    records_.clear();
+    for (; first != last; ++first)
+    {
+      Add(*first);
+    }
+
+    if (!IsSorted())
+    {
+      std::sort(std::begin(records_),
+                std::end(records_),
+                [](RegionRecord const& lhs, RegionRecord const& rhs)
+                {
+                  return lhs.base < rhs.base;
+                });
+    }
+  }
+
+  RegionRecord const* Find(void const* address) const noexcept
+  {
+    auto const addr = reinterpret_cast<std::uintptr_t>(address);
+    auto const iter = std::upper_bound(
+      std::begin(records_),
+      std::end(records_),
+      addr,
+      [](std::uintptr_t a, RegionRecord const& record)
+      {
+        return a < record.base;
+      });
+    if (iter == std::begin(records_))
+    {
+      return nullptr;
+    }
+
+    auto const& record = *(iter - 1);
+    return addr - record.base < record.size ? &record : nullptr;
+  }
+
+  const_iterator begin() const noexcept
+  {
+    return records_.begin();
+  }
+
+  const_iterator end() const noexcept
+  {
+    return records_.end();
+  }
+
+  const_iterator cbegin() const noexcept
+  {
+    return records_.cbegin();
+  }
+
+  const_iterator cend() const noexcept
+  {
+    return records_.cend();
+  }
+
+  std::size_t size() const noexcept
+  {
+    return records_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return records_.empty();
+  }
+
+  RegionRecord const& operator[](std::size_t n) const noexcept
+  {
+    HADESMEM_DETAIL_ASSERT(n < records_.size());
+    return records_[n];
+  }
+
+private:
+  void Add(MEMORY_BASIC_INFORMATION const& mbi)
+  {
+    if (mbi.State == MEM_FREE || !mbi.RegionSize)
+    {
+      return;
+    }
+
+    RegionRecord record;
+    record.base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+    record.alloc_base = reinterpret_cast<std::uintptr_t>(mbi.AllocationBase);
+    record.size = mbi.RegionSize;
+    record.state = mbi.State;
+    record.protect = mbi.Protect;
+    record.type = mbi.Type;
+    records_.push_back(record);
+  }
+
+  bool IsSorted() const noexcept
+  {
+    return std::is_sorted(std::begin(records_),
+                          std::end(records_),
+                          [](RegionRecord const& lhs, RegionRecord const& rhs)
+                          {
+                            return lhs.base < rhs.base;
+                          });
+  }
+
+  std::vector<RegionRecord> records_;
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+  detail::LinuxMapsReader maps_reader_;
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
+};
+
+namespace detail
+{
+inline void AppendRegionRange(std::vector<RegionRange>& ranges,
+                              std::uintptr_t base,
+                              std::uintptr_t end)
+{
+  HADESMEM_DETAIL_ASSERT(end > base);
+
+  if (!ranges.empty() && ranges.back().base + ranges.back().size == base)
+  {
+    ranges.back().size += end - base;
+  }
+  else
+  {
+    ranges.push_back(RegionRange{base, end - base});
+  }
+}
+}
+
+// Sweeps both snapshots in address order, so this is linear in the number of
+// regions. Adjacent ranges of the same kind are coalesced.
+inline void Diff(RegionSnapshot const& old_snapshot,
+                 RegionSnapshot const& new_snapshot,
+                 RegionDiff& diff)
+{
+  diff.Clear();
+
+  std::uintptr_t const kNone = (std::numeric_limits<std::uintptr_t>::max)();
+
+  std::size_t i = 0;
+  std::size_t j = 0;
+  std::uintptr_t pos = 0;
+  while (i < old_snapshot.size() || j < new_snapshot.size())
+  {
+    RegionRecord const* const a =
+      i < old_snapshot.size() ? &old_snapshot[i] : nullptr;
+    RegionRecord const* const b =
+      j < new_snapshot.size() ? &new_snapshot[j] : nullptr;
+    std::uintptr_t const a_beg = a ? a->base : kNone;
+    std::uintptr_t const a_end = a ? a->base + a->size : kNone;
+    std::uintptr_t const b_beg = b ? b->base : kNone;
+    std::uintptr_t const b_end = b ? b->base + b->size : kNone;
+
+    pos = (std::max)(pos, (std::min)(a_beg, b_beg));
+
+    bool const in_a = pos >= a_beg;
+    bool const in_b = pos >= b_beg;
+    std::uintptr_t const seg_end =
+      (std::min)(in_a ? a_end : a_beg, in_b ? b_end : b_beg);
+
+    if (in_a && in_b)
+    {
+      if (a->alloc_base != b->alloc_base || a->state != b->state ||
+          a->type != b->type)
+      {
+        detail::AppendRegionRange(diff.removed, pos, seg_end);
+        detail::AppendRegionRange(diff.added, pos, seg_end);
+      }
+      else if (a->protect != b->protect)
+      {
+        detail::AppendRegionRange(diff.protect_changed, pos, seg_end);
+      }
+    }
+    else if (in_a)
+    {
+      detail::AppendRegionRange(diff.removed, pos, seg_end);
+    }
+    else
+    {
+      HADESMEM_DETAIL_ASSERT(in_b);
+      detail::AppendRegionRange(diff.added, pos, seg_end);
+    }
+
+    pos = seg_end;
+    if (in_a && pos == a_end)
+    {
+      ++i;
+    }
+    if (in_b && pos == b_end)
+    {
+      ++j;
+    }
+  }
+}
+
+inline RegionDiff Diff(RegionSnapshot const& old_snapshot,
+                       RegionSnapshot const& new_snapshot)
+{
+  RegionDiff diff;
+  Diff(old_snapshot, new_snapshot, diff);
+  return diff;
+}
+}
@@ -3,26 +3,913 @@
 
 #pragma once
 
-// TODO: Implement this.
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <emmintrin.h>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/assert.hpp>
+#include <hadesmem/detail/parallel_for.hpp>
+#include <hadesmem/detail/read_impl.hpp>
+#include <hadesmem/detail/static_assert.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/region_snapshot.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // #if defined(_MSC_VER)
+
 // TODO: Use process reflection on Windows 7 + for scanning while process is suspended. (RtlCreateProcessReflection)
 //  Requires extra privileges though Make it optional?
 //  There's newer and better APIs available on W8+. PSS? ProcDump supports them all I think...
 //  PSS doesn't support large pages, so can't be used against e.g.SQL.
-// TODO: Use a file view with a small memory cache rather than consuming large amounts of RAM.
-// TODO: Multi-threaded scanning options.
 // TODO: Wildcard support for vector/string scanning.
 // TODO: Regex support for string scanning.
-// TODO: Memory protection filters(read, write, exec).
-// TODO: Memory type filters(private, mapped, image).
 // TODO: Support pausing target while scanning.
 // TODO: Support injected scanning.
-// TODO: Configurable scan buffer size.
-// TODO: Pointer scanner.
-// TODO: Unknown value scan.
-// TODO: Progressive scan filtering based on either value or criteria.
 // TODO: Scan history and undo.
 // TODO: Support case insensitive string scanning.
 // TODO: Binary scanning.
 // TODO: Custom scanning via user supplied predicate.
 // TODO: Improved floating point support (configurable or 'smart' epsilon).
 // TODO: Group search support.
+
+// Scanning is done in two phases. A first scan splits the matching regions
+// into chunks of ScanOptions::buffer_size bytes, reads each chunk in a single
+// call and compares it against the filter (with SSE2 kernels for equality
+// filters on naturally aligned values). Each chunk then keeps its surviving
+// candidates either as a bitmap plus a copy of the chunk (dense results, e.g.
+// after an unknown value scan) or as delta encoded slot indices plus the
+// packed values (sparse results), whichever is smaller. Next scans re-read
+// only the chunks (or, for sparse chunks, the span of the chunk) which still
+// have candidates and filter them again. Chunks are independent, so both
+// phases run in parallel across chunks.
+
+namespace hadesmem
+{
+enum class ScanFilter
+{
+  // Matches everything. Used for the first scan of an unknown value, or to
+  // refresh the stored values on a next scan.
+  kUnknown,
+  kEqual,
+  kNotEqual,
+  kGreater,
+  kLess,
+  // The following compare against the value from the previous scan, so can
+  // only be used for next scans.
+  kChanged,
+  kUnchanged,
+  kIncreased,
+  kDecreased
+};
+
+struct ScanProtection
+{
+  enum : std::uint32_t
+  {
+    kNone = 0,
+    kRead = 1 << 0,
+    kWrite = 1 << 1,
+    kExecute = 1 << 2
+  };
+};
+
+struct ScanRegionType
+{
+  enum : std::uint32_t
+  {
+    kPrivate = 1 << 0,
+    kMapped = 1 << 1,
+    kImage = 1 << 2,
+    kAll = kPrivate | kMapped | kImage
+  };
+};
+
+struct ScanOptions
+{
+  // Rounded up to a multiple of the page size.
+  std::size_t buffer_size = 0x100000;
+  // Alignment of the scanned addresses. Zero means the natural alignment of
+  // the scanned type. Must be a power of two no larger than a page.
+  std::size_t alignment = 0;
+  // Zero means one thread per hardware thread.
+  std::size_t num_threads = 0;
+  // Protection a region must have to be scanned. Regions which aren't
+  // readable (or are guard pages) are always skipped.
+  std::uint32_t protection = ScanProtection::kRead | ScanProtection::kWrite;
+  std::uint32_t types = ScanRegionType::kAll;
+  std::uintptr_t start = 0;
+  std::uintptr_t end = (std::numeric_limits<std::uintptr_t>::max)();
+};
+
+template <typename T> struct ScanResult
+{
+  void* address;
+  T value;
+};
+
+// Where a scanner gets its regions and memory from. Reads are expected to
+// fail during a scan (e.g. when the target frees memory between taking the
+// snapshot and reading it), so failures are reported rather than thrown.
+class ScanSource
+{
+public:
+  virtual ~ScanSource()
+  {
+  }
+
+  virtual void GetRegions(RegionSnapshot& snapshot) const = 0;
+
+  virtual bool
+    Read(std::uintptr_t address, void* data, std::size_t len) const = 0;
+};
+
+class ProcessScanSource : public ScanSource
+{
+public:
+  explicit ProcessScanSource(Process const& process) : process_{&process}
+  {
+  }
+
+  explicit ProcessScanSource(Process&& process) = delete;
+
+  virtual void GetRegions(RegionSnapshot& snapshot) const override
+  {
+    snapshot.Refresh(*process_);
+  }
+
+  virtual bool
+    Read(std::uintptr_t address, void* data, std::size_t len) const override
+  {
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    SIZE_T bytes_read = 0;
+    return ::ReadProcessMemory(process_->GetHandle(),
+                               reinterpret_cast<LPCVOID>(address),
+                               data,
+                               len,
+                               &bytes_read) &&
+           bytes_read == len;
+#elif defined(HADESMEM_DETAIL_OS_LINUX)
+    return !detail::ReadUncheckedNoThrow(
+      *process_, reinterpret_cast<void*>(address), data, len);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    // #elif defined(HADESMEM_DETAIL_OS_LINUX)
+  }
+
+private:
+  Process const* process_;
+};
+
+// Scans caller owned buffers, presented as private regions at the given
+// addresses. Mainly useful for testing, and for scanning memory which has
+// already been captured.
+class BufferScanSource : public ScanSource
+{
+public:
+  void AddBuffer(std::uintptr_t base,
+                 void const* data,
+                 std::size_t size,
+                 DWORD protect = PAGE_READWRITE)
+  {
+    HADESMEM_DETAIL_ASSERT(data != nullptr || !size);
+    buffers_.push_back(
+      Buffer{base, static_cast<std::uint8_t const*>(data), size, protect});
+  }
+
+  virtual void GetRegions(RegionSnapshot& snapshot) const override
+  {
+    std::vector<MEMORY_BASIC_INFORMATION> regions;
+    regions.reserve(buffers_.size());
+    for (auto const& buffer : buffers_)
+    {
+      MEMORY_BASIC_INFORMATION mbi{};
+      mbi.BaseAddress = reinterpret_cast<PVOID>(buffer.base);
+      mbi.AllocationBase = mbi.BaseAddress;
+      mbi.AllocationProtect = buffer.protect;
+      mbi.RegionSize = buffer.size;
+      mbi.State = MEM_COMMIT;
+      mbi.Protect = buffer.protect;
+      mbi.Type = MEM_PRIVATE;
+      regions.push_back(mbi);
+    }
+    snapshot.Assign(std::begin(regions), std::end(regions));
+  }
+
+  virtual bool
+    Read(std::uintptr_t address, void* data, std::size_t len) const override
+  {
+    for (auto const& buffer : buffers_)
+    {
+      if (address >= buffer.base && address - buffer.base <= buffer.size &&
+          len <= buffer.size - (address - buffer.base))
+      {
+        std::memcpy(data, buffer.data + (address - buffer.base), len);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+private:
+  struct Buffer
+  {
+    std::uintptr_t base;
+    std::uint8_t const* data;
+    std::size_t size;
+    DWORD protect;
+  };
+
+  std::vector<Buffer> buffers_;
+};
+
+namespace detail
+{
+struct ScanChunk
+{
+  std::uintptr_t base;
+  std::size_t len;
+  std::size_t num_slots;
+  std::size_t count;
+  bool dense;
+  // Dense chunks keep a bit per slot plus a copy of the whole chunk.
+  std::vector<std::uint64_t> bitmap;
+  std::vector<std::uint8_t> data;
+  // Sparse chunks keep the LEB128 encoded deltas between the slot indices of
+  // the candidates, plus the candidates' values packed back to back.
+  std::vector<std::uint8_t> deltas;
+  std::vector<std::uint8_t> values;
+};
+
+inline bool ScanProtectionMatches(DWORD protect, std::uint32_t required)
+{
+  if (protect & (PAGE_GUARD | PAGE_NOACCESS))
+  {
+    return false;
+  }
+
+  DWORD const base_protect = protect & 0xFF;
+  bool const read = base_protect == PAGE_READONLY ||
+                    base_protect == PAGE_READWRITE ||
+                    base_protect == PAGE_WRITECOPY ||
+                    base_protect == PAGE_EXECUTE_READ ||
+                    base_protect == PAGE_EXECUTE_READWRITE ||
+                    base_protect == PAGE_EXECUTE_WRITECOPY;
+  bool const write = base_protect == PAGE_READWRITE ||
+                     base_protect == PAGE_WRITECOPY ||
+                     base_protect == PAGE_EXECUTE_READWRITE ||
+                     base_protect == PAGE_EXECUTE_WRITECOPY;
+  bool const execute = base_protect == PAGE_EXECUTE_READ ||
+                       base_protect == PAGE_EXECUTE_READWRITE ||
+                       base_protect == PAGE_EXECUTE_WRITECOPY;
+
+  return read && (!(required & ScanProtection::kWrite) || write) &&
+         (!(required & ScanProtection::kExecute) || execute);
+}
+
+inline bool ScanRegionTypeMatches(DWORD type, std::uint32_t types)
+{
+  switch (type)
+  {
+  case MEM_PRIVATE:
+    return (types & ScanRegionType::kPrivate) != 0;
+  case MEM_MAPPED:
+    return (types & ScanRegionType::kMapped) != 0;
+  case MEM_IMAGE:
+    return (types & ScanRegionType::kImage) != 0;
+  default:
+    return false;
+  }
+}
+
+inline bool IsRelativeScanFilter(ScanFilter filter) noexcept
+{
+  return filter == ScanFilter::kChanged || filter == ScanFilter::kUnchanged ||
+         filter == ScanFilter::kIncreased || filter == ScanFilter::kDecreased;
+}
+
+template <typename T> T LoadScanValue(std::uint8_t const* p) noexcept
+{
+  T value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+template <typename T>
+bool ScanMatches(ScanFilter filter, T cur, T prev, T value) noexcept
+{
+  switch (filter)
+  {
+  case ScanFilter::kUnknown:
+    return true;
+  case ScanFilter::kEqual:
+    return cur == value;
+  case ScanFilter::kNotEqual:
+    return cur != value;
+  case ScanFilter::kGreater:
+    return cur > value;
+  case ScanFilter::kLess:
+    return cur < value;
+  case ScanFilter::kChanged:
+    return cur != prev;
+  case ScanFilter::kUnchanged:
+    return cur == prev;
+  case ScanFilter::kIncreased:
+    return cur > prev;
+  case ScanFilter::kDecreased:
+    return cur < prev;
+  }
+
+  HADESMEM_DETAIL_ASSERT(false);
+  return false;
+}
+
+inline std::size_t PopCount(std::uint64_t x) noexcept
+{
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<std::size_t>((x * 0x0101010101010101ULL) >> 56);
+}
+
+inline std::size_t CountTrailingZeros(std::uint64_t x) noexcept
+{
+  HADESMEM_DETAIL_ASSERT(x != 0);
+
+#if defined(_MSC_VER) && defined(HADESMEM_DETAIL_ARCH_X64)
+  unsigned long index = 0;
+  _BitScanForward64(&index, x);
+  return index;
+#elif defined(_MSC_VER)
+  unsigned long index = 0;
+  if (_BitScanForward(&index, static_cast<unsigned long>(x)))
+  {
+    return index;
+  }
+  _BitScanForward(&index, static_cast<unsigned long>(x >> 32));
+  return index + 32;
+#else
+  return static_cast<std::size_t>(__builtin_ctzll(x));
+#endif
+}
+
+template <typename Func>
+void ForEachSetBit(std::vector<std::uint64_t> const& bitmap, Func const& func)
+{
+  for (std::size_t i = 0; i < bitmap.size(); ++i)
+  {
+    for (std::uint64_t word = bitmap[i]; word; word &= word - 1)
+    {
+      func(i * 64 + CountTrailingZeros(word));
+    }
+  }
+}
+
+inline void AppendVarint(std::vector<std::uint8_t>& out, std::size_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline std::size_t ReadVarint(std::uint8_t const*& p) noexcept
+{
+  std::size_t value = 0;
+  for (unsigned int shift = 0;; shift += 7)
+  {
+    std::uint8_t const byte = *p++;
+    value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+    {
+      return value;
+    }
+  }
+}
+
+template <typename Func>
+void ForEachSparseSlot(ScanChunk const& chunk, Func const& func)
+{
+  std::uint8_t const* p = chunk.deltas.data();
+  std::size_t slot = 0;
+  for (std::size_t i = 0; i < chunk.count; ++i)
+  {
+    slot += ReadVarint(p);
+    func(i, slot);
+  }
+}
+
+// Returns a bit per element of the comparison of two vectors of elements of
+// the given size.
+template <std::size_t Width, bool IsFloat> struct SimdEqual;
+
+template <> struct SimdEqual<1, false>
+{
+  static std::uint32_t Mask(__m128i a, __m128i b) noexcept
+  {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+  }
+};
+
+template <> struct SimdEqual<2, false>
+{
+  static std::uint32_t Mask(__m128i a, __m128i b) noexcept
+  {
+    __m128i const cmp = _mm_cmpeq_epi16(a, b);
+    return static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_packs_epi16(cmp, _mm_setzero_si128())));
+  }
+};
+
+template <> struct SimdEqual<4, false>
+{
+  static std::uint32_t Mask(__m128i a, __m128i b) noexcept
+  {
+    return static_cast<std::uint32_t>(
+      _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+  }
+};
+
+template <> struct SimdEqual<8, false>
+{
+  static std::uint32_t Mask(__m128i a, __m128i b) noexcept
+  {
+    // No 64-bit compare in SSE2, so both 32-bit halves have to match.
+    __m128i cmp = _mm_cmpeq_epi32(a, b);
+    cmp = _mm_and_si128(cmp, _mm_shuffle_epi32(cmp, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<std::uint32_t>(
+      _mm_movemask_pd(_mm_castsi128_pd(cmp)));
+  }
+};
+
+template <> struct SimdEqual<4, true>
+{
+  static std::uint32_t Mask(__m128i a, __m128i b) noexcept
+  {
+    return static_cast<std::uint32_t>(_mm_movemask_ps(
+      _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))));
+  }
+};
+
+template <> struct SimdEqual<8, true>
+{
+  static std::uint32_t Mask(__m128i a, __m128i b) noexcept
+  {
+    return static_cast<std::uint32_t>(_mm_movemask_pd(
+      _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))));
+  }
+};
+
+// Sets bit i of mask for every i in [0, n) where lhs[i] == rhs[i] (or
+// lhs[i] == rhs[0] if splat is set), where lhs and rhs are packed arrays of
+// T. All other bits of the (n + 63) / 64 words of mask are cleared.
+template <typename T>
+void CompareEqual(std::uint8_t const* lhs,
+                  std::uint8_t const* rhs,
+                  bool splat,
+                  std::size_t n,
+                  std::uint64_t* mask) noexcept
+{
+  using Kernel = SimdEqual<sizeof(T), std::is_floating_point<T>::value>;
+  std::size_t const kPerVector = 16 / sizeof(T);
+
+  std::fill(mask, mask + (n + 63) / 64, 0ULL);
+
+  __m128i splat_vector = _mm_setzero_si128();
+  if (splat)
+  {
+    alignas(16) std::uint8_t splat_bytes[16];
+    for (std::size_t i = 0; i < 16; i += sizeof(T))
+    {
+      std::memcpy(&splat_bytes[i], rhs, sizeof(T));
+    }
+    splat_vector =
+      _mm_load_si128(reinterpret_cast<__m128i const*>(splat_bytes));
+  }
+
+  std::size_t i = 0;
+  for (; i + kPerVector <= n; i += kPerVector)
+  {
+    __m128i const a =
+      _mm_loadu_si128(reinterpret_cast<__m128i const*>(lhs + i * sizeof(T)));
+    __m128i const b = splat ? splat_vector
+                            : _mm_loadu_si128(reinterpret_cast<__m128i const*>(
+                                rhs + i * sizeof(T)));
+    mask[i / 64] |= static_cast<std::uint64_t>(Kernel::Mask(a, b)) << (i % 64);
+  }
+
+  for (; i < n; ++i)
+  {
+    T const a = LoadScanValue<T>(lhs + i * sizeof(T));
+    T const b = LoadScanValue<T>(splat ? rhs : rhs + i * sizeof(T));
+    if (a == b)
+    {
+      mask[i / 64] |= 1ULL << (i % 64);
+    }
+  }
+}
+
+inline void InvertBits(std::vector<std::uint64_t>& bitmap, std::size_t n)
+{
+  for (auto& word : bitmap)
+  {
+    word = ~word;
+  }
+  if (n % 64)
+  {
+    bitmap.back() &= (1ULL << (n % 64)) - 1;
+  }
+}
+
+inline void ClearScanChunk(ScanChunk& chunk)
+{
+  chunk.count = 0;
+  std::vector<std::uint64_t>().swap(chunk.bitmap);
+  std::vector<std::uint8_t>().swap(chunk.data);
+  std::vector<std::uint8_t>().swap(chunk.deltas);
+  std::vector<std::uint8_t>().swap(chunk.values);
+}
+
+template <typename T>
+void EncodeScanChunk(ScanChunk& chunk,
+                     std::size_t alignment,
+                     std::vector<std::uint64_t>& keep,
+                     std::vector<std::uint8_t>& cur)
+{
+  std::size_t count = 0;
+  for (auto const word : keep)
+  {
+    count += PopCount(word);
+  }
+
+  if (!count)
+  {
+    ClearScanChunk(chunk);
+    return;
+  }
+
+  // Assume two bytes per delta, which covers gaps of up to 16K slots.
+  std::size_t const sparse_cost = count * (sizeof(T) + 2);
+  std::size_t const dense_cost = chunk.len + keep.size() * sizeof(keep[0]);
+  if (sparse_cost < dense_cost)
+  {
+    std::vector<std::uint8_t> deltas;
+    std::vector<std::uint8_t> values;
+    deltas.reserve(count * 2);
+    values.reserve(count * sizeof(T));
+    std::size_t prev_slot = 0;
+    ForEachSetBit(keep,
+                  [&](std::size_t slot)
+                  {
+                    AppendVarint(deltas, slot - prev_slot);
+                    prev_slot = slot;
+                    std::uint8_t const* const value = &cur[slot * alignment];
+                    values.insert(values.end(), value, value + sizeof(T));
+                  });
+
+    ClearScanChunk(chunk);
+    chunk.dense = false;
+    chunk.deltas.swap(deltas);
+    chunk.values.swap(values);
+  }
+  else
+  {
+    chunk.dense = true;
+    chunk.bitmap.swap(keep);
+    chunk.data.swap(cur);
+    std::vector<std::uint8_t>().swap(chunk.deltas);
+    std::vector<std::uint8_t>().swap(chunk.values);
+  }
+
+  chunk.count = count;
+}
+
+template <typename T>
+void FilterSparseScanChunk(ScanSource const& source,
+                           ScanChunk& chunk,
+                           std::size_t alignment,
+                           ScanFilter filter,
+                           T value)
+{
+  std::vector<std::size_t> slots;
+  slots.reserve(chunk.count);
+  ForEachSparseSlot(chunk,
+                    [&](std::size_t /*i*/, std::size_t slot)
+                    {
+                      slots.push_back(slot);
+                    });
+
+  // Only read the span of the chunk which still has candidates.
+  std::size_t const span_begin = slots.front() * alignment;
+  std::size_t const span_end = slots.back() * alignment + sizeof(T);
+  std::vector<std::uint8_t> cur(span_end - span_begin);
+  if (!source.Read(chunk.base + span_begin, cur.data(), cur.size()))
+  {
+    ClearScanChunk(chunk);
+    return;
+  }
+
+  std::vector<std::uint8_t> deltas;
+  std::vector<std::uint8_t> values;
+  std::size_t prev_slot = 0;
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < slots.size(); ++i)
+  {
+    std::uint8_t const* const cur_ptr =
+      &cur[slots[i] * alignment - span_begin];
+    T const cur_value = LoadScanValue<T>(cur_ptr);
+    T const prev_value = LoadScanValue<T>(&chunk.values[i * sizeof(T)]);
+    if (ScanMatches(filter, cur_value, prev_value, value))
+    {
+      AppendVarint(deltas, slots[i] - prev_slot);
+      prev_slot = slots[i];
+      values.insert(values.end(), cur_ptr, cur_ptr + sizeof(T));
+      ++count;
+    }
+  }
+
+  chunk.deltas.swap(deltas);
+  chunk.values.swap(values);
+  chunk.count = count;
+  if (!count)
+  {
+    ClearScanChunk(chunk);
+  }
+}
+
+template <typename T>
+void FilterScanChunk(ScanSource const& source,
+                     ScanChunk& chunk,
+                     std::size_t alignment,
+                     ScanFilter filter,
+                     T value,
+                     bool first)
+{
+  if (!first && !chunk.dense)
+  {
+    FilterSparseScanChunk(source, chunk, alignment, filter, value);
+    return;
+  }
+
+  std::vector<std::uint8_t> cur(chunk.len);
+  if (!source.Read(chunk.base, cur.data(), cur.size()))
+  {
+    ClearScanChunk(chunk);
+    return;
+  }
+
+  std::vector<std::uint64_t> keep((chunk.num_slots + 63) / 64);
+  bool const is_value_filter =
+    filter == ScanFilter::kEqual || filter == ScanFilter::kNotEqual;
+  bool const is_prev_filter =
+    filter == ScanFilter::kChanged || filter == ScanFilter::kUnchanged;
+
+  if (first && filter == ScanFilter::kUnknown)
+  {
+    InvertBits(keep, chunk.num_slots);
+  }
+  else if (alignment == sizeof(T) && (is_value_filter || is_prev_filter))
+  {
+    std::uint8_t value_bytes[sizeof(T)];
+    std::memcpy(value_bytes, &value, sizeof(T));
+    CompareEqual<T>(cur.data(),
+                    is_value_filter ? value_bytes : chunk.data.data(),
+                    is_value_filter,
+                    chunk.num_slots,
+                    keep.data());
+    if (filter == ScanFilter::kNotEqual || filter == ScanFilter::kChanged)
+    {
+      InvertBits(keep, chunk.num_slots);
+    }
+
+    if (!first)
+    {
+      for (std::size_t i = 0; i < keep.size(); ++i)
+      {
+        keep[i] &= chunk.bitmap[i];
+      }
+    }
+  }
+  else
+  {
+    auto const test = [&](std::size_t slot)
+    {
+      T const cur_value = LoadScanValue<T>(&cur[slot * alignment]);
+      T const prev_value =
+        first ? cur_value : LoadScanValue<T>(&chunk.data[slot * alignment]);
+      if (ScanMatches(filter, cur_value, prev_value, value))
+      {
+        keep[slot / 64] |= 1ULL << (slot % 64);
+      }
+    };
+
+    if (first)
+    {
+      for (std::size_t slot = 0; slot < chunk.num_slots; ++slot)
+      {
+        test(slot);
+      }
+    }
+    else
+    {
+      ForEachSetBit(chunk.bitmap, test);
+    }
+  }
+
+  EncodeScanChunk<T>(chunk, alignment, keep, cur);
+}
+}
+
+template <typename T> class Scanner
+{
+public:
+  HADESMEM_DETAIL_STATIC_ASSERT(std::is_arithmetic<T>::value &&
+                                sizeof(T) <= 8);
+
+  explicit Scanner(ScanSource const& source,
+                   ScanOptions const& options = ScanOptions())
+    : source_{&source}, options_(options)
+  {
+    if (!options_.alignment)
+    {
+      options_.alignment = sizeof(T);
+    }
+
+    if (options_.alignment > 0x1000 ||
+        (options_.alignment & (options_.alignment - 1)))
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Invalid scan alignment."});
+    }
+
+    std::size_t const kPageSize = 0x1000;
+    options_.buffer_size = (std::max)(options_.buffer_size, kPageSize);
+    options_.buffer_size =
+      (options_.buffer_size + kPageSize - 1) & ~(kPageSize - 1);
+  }
+
+  explicit Scanner(ScanSource&& source,
+                   ScanOptions const& options = ScanOptions()) = delete;
+
+  // Discards any previous results and scans all matching regions.
+  void First(ScanFilter filter, T value = T())
+  {
+    if (detail::IsRelativeScanFilter(filter))
+    {
+      HADESMEM_DETAIL_THROW_EXCEPTION(
+        Error{} << ErrorString{"Filter requires a previous scan."});
+    }
+
+    BuildChunks();
+    Filter(filter, value, true);
+  }
+
+  // Filters the results of the previous scan.
+  void Next(ScanFilter filter, T value = T())
+  {
+    Filter(filter, value, false);
+  }
+
+  void Reset()
+  {
+    chunks_.clear();
+  }
+
+  std::size_t GetCount() const noexcept
+  {
+    std::size_t count = 0;
+    for (auto const& chunk : chunks_)
+    {
+      count += chunk.count;
+    }
+    return count;
+  }
+
+  // Calls func(address, value) for every result, in address order. The value
+  // is the one read by the most recent scan.
+  template <typename Func> void ForEach(Func const& func) const
+  {
+    std::size_t const alignment = options_.alignment;
+    for (auto const& chunk : chunks_)
+    {
+      if (chunk.dense)
+      {
+        detail::ForEachSetBit(
+          chunk.bitmap,
+          [&](std::size_t slot)
+          {
+            func(reinterpret_cast<void*>(chunk.base + slot * alignment),
+                 detail::LoadScanValue<T>(&chunk.data[slot * alignment]));
+          });
+      }
+      else
+      {
+        detail::ForEachSparseSlot(
+          chunk,
+          [&](std::size_t i, std::size_t slot)
+          {
+            func(reinterpret_cast<void*>(chunk.base + slot * alignment),
+                 detail::LoadScanValue<T>(&chunk.values[i * sizeof(T)]));
+          });
+      }
+    }
+  }
+
+  std::vector<ScanResult<T>> GetResults(
+    std::size_t max_results = (std::numeric_limits<std::size_t>::max)()) const
+  {
+    std::vector<ScanResult<T>> results;
+    results.reserve((std::min)(GetCount(), max_results));
+    ForEach([&](void* address, T value)
+            {
+              if (results.size() < max_results)
+              {
+                results.push_back(ScanResult<T>{address, value});
+              }
+            });
+    return results;
+  }
+
+private:
+  void BuildChunks()
+  {
+    chunks_.clear();
+    source_->GetRegions(snapshot_);
+
+    std::size_t const alignment = options_.alignment;
+    std::size_t const buffer_size = options_.buffer_size;
+    for (auto const& region : snapshot_)
+    {
+      if (region.state != MEM_COMMIT ||
+          !detail::ScanProtectionMatches(region.protect,
+                                         options_.protection) ||
+          !detail::ScanRegionTypeMatches(region.type, options_.types))
+      {
+        continue;
+      }
+
+      std::uintptr_t begin = (std::max)(region.base, options_.start);
+      std::uintptr_t const end =
+        (std::min)(region.base + region.size, options_.end);
+      begin = (begin + alignment - 1) & ~(alignment - 1);
+      for (std::uintptr_t chunk_base = begin;
+           chunk_base < end && end - chunk_base >= sizeof(T);
+           chunk_base += buffer_size)
+      {
+        detail::ScanChunk chunk{};
+        // Read enough past the end of the chunk to cover values which start
+        // in this chunk but end in the next one.
+        chunk.base = chunk_base;
+        chunk.len = (std::min)(buffer_size + sizeof(T) - 1,
+                               static_cast<std::size_t>(end - chunk_base));
+        chunk.num_slots = (std::min)((chunk.len - sizeof(T)) / alignment + 1,
+                                     buffer_size / alignment);
+        chunks_.emplace_back(std::move(chunk));
+
+        if (end - chunk_base <= buffer_size)
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  void Filter(ScanFilter filter, T value, bool first)
+  {
+    detail::ParallelFor(chunks_.size(),
+                        options_.num_threads,
+                        [&](std::size_t i)
+                        {
+                          detail::FilterScanChunk<T>(*source_,
+                                                     chunks_[i],
+                                                     options_.alignment,
+                                                     filter,
+                                                     value,
+                                                     first);
+                        });
+
+    chunks_.erase(std::remove_if(std::begin(chunks_),
+                                 std::end(chunks_),
+                                 [](detail::ScanChunk const& chunk)
+                                 {
+                                   return !chunk.count;
+                                 }),
+                  std::end(chunks_));
+  }
+
+  ScanSource const* source_;
+  ScanOptions options_;
+  RegionSnapshot snapshot_;
+  std::vector<detail::ScanChunk> chunks_;
+};
+}
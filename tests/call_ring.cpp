@@ -0,0 +1,465 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/call_ring.hpp>
+#include <hadesmem/detail/call_ring.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+
+namespace
+{
+hadesmem::detail::CallDescriptorArg MakeInt32(std::uint32_t value)
+{
+  return {hadesmem::detail::CallArgKind::kInt32, value};
+}
+
+hadesmem::detail::CallDescriptorArg MakeInt64(std::uint64_t value)
+{
+  return {hadesmem::detail::CallArgKind::kInt64, value};
+}
+
+hadesmem::detail::CallDescriptorArg MakeFloat(float value)
+{
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return {hadesmem::detail::CallArgKind::kFloat32, bits};
+}
+
+hadesmem::detail::CallDescriptorArg MakeDouble(double value)
+{
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return {hadesmem::detail::CallArgKind::kFloat64, bits};
+}
+
+hadesmem::detail::CallDescriptor
+  Encode(hadesmem::detail::CallAbi abi,
+         std::size_t num_reg_args,
+         std::vector<hadesmem::detail::CallDescriptorArg> const& args,
+         std::uint64_t address = 0x12345678)
+{
+  hadesmem::detail::CallDescriptor descriptor;
+  hadesmem::detail::EncodeCallDescriptor(abi,
+                                         num_reg_args,
+                                         address,
+                                         std::begin(args),
+                                         std::end(args),
+                                         descriptor);
+  return descriptor;
+}
+
+// Addresses of the functions known to TestExecutor.
+enum : std::uint64_t
+{
+  // x86 cdecl (uint32_t a, uint32_t b, uint32_t c), returns a + b + c and
+  // sets the last error to a.
+  kSumX86 = 0x1000,
+  // x86 fastcall (uint64_t a, uint32_t b, double c, uint32_t d, uint32_t e),
+  // returns a + b + d + e and c * 2.
+  kMixedX86,
+  // x64 (double a, uint32_t b, float c, uint64_t d, uint32_t e, double f),
+  // returns b + d + e, a + f and c * 2.
+  kMixedX64,
+  // Either ABI, returns the last error.
+  kGetLastError
+};
+
+double BitsToDouble(std::uint64_t bits)
+{
+  double value = 0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+float BitsToFloat(std::uint32_t bits)
+{
+  float value = 0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+std::uint64_t GetStackQword(hadesmem::detail::CallDescriptor const& d,
+                            std::size_t word)
+{
+  return d.stack[word] | (static_cast<std::uint64_t>(d.stack[word + 1]) << 32);
+}
+
+// Stands in for the server code, in process and without any threads. Consumes
+// everything between 'completed' and 'submitted', unpacking the arguments
+// from the registers and stack the way the callee would see them.
+class TestExecutor
+{
+public:
+  explicit TestExecutor(std::uint8_t* ring) : ring_{ring}
+  {
+  }
+
+  void Run()
+  {
+    auto header = GetHeader();
+    for (; header.completed != header.submitted; ++header.completed)
+    {
+      std::size_t const offset =
+        hadesmem::detail::GetCallRingSlotOffset(header.completed, header.mask);
+      hadesmem::detail::CallDescriptor d;
+      std::memcpy(&d, ring_ + offset, sizeof(d));
+
+      if (d.flags & hadesmem::detail::kCallBatchStart)
+      {
+        last_error_ = 0;
+      }
+
+      Execute(d);
+      d.last_error = last_error_;
+
+      std::memcpy(ring_ + offset, &d, sizeof(d));
+      ++num_executed_;
+    }
+
+    std::memcpy(ring_ + offsetof(hadesmem::detail::CallRingHeader, completed),
+                &header.completed,
+                sizeof(header.completed));
+  }
+
+  std::size_t GetNumExecuted() const noexcept
+  {
+    return num_executed_;
+  }
+
+private:
+  hadesmem::detail::CallRingHeader GetHeader() const
+  {
+    hadesmem::detail::CallRingHeader header;
+    std::memcpy(&header, ring_, sizeof(header));
+    return header;
+  }
+
+  void Execute(hadesmem::detail::CallDescriptor& d)
+  {
+    switch (d.address)
+    {
+    case kSumX86:
+      BOOST_TEST_EQ(d.num_stack_words, 3U);
+      d.return_i64 = static_cast<std::uint64_t>(d.stack[0]) + d.stack[1] +
+                     d.stack[2];
+      last_error_ = d.stack[0];
+      break;
+
+    case kMixedX86:
+      BOOST_TEST_EQ(d.num_stack_words, 5U);
+      d.return_i64 = GetStackQword(d, 0) + d.regs[0] + d.regs[1] + d.stack[4];
+      d.return_double = BitsToDouble(GetStackQword(d, 2)) * 2;
+      break;
+
+    case kMixedX64:
+      BOOST_TEST_EQ(d.num_stack_words, 4U);
+      d.return_i64 = (d.regs[1] & 0xFFFFFFFFUL) + d.regs[3] +
+                     (GetStackQword(d, 0) & 0xFFFFFFFFUL);
+      d.return_double =
+        BitsToDouble(d.regs[0]) + BitsToDouble(GetStackQword(d, 2));
+      d.return_float =
+        BitsToFloat(static_cast<std::uint32_t>(d.regs[2])) * 2;
+      break;
+
+    case kGetLastError:
+      d.return_i64 = last_error_;
+      break;
+
+    default:
+      BOOST_ERROR("Unknown call address.");
+      break;
+    }
+  }
+
+  std::uint8_t* ring_;
+  std::uint32_t last_error_{};
+  std::size_t num_executed_{};
+};
+
+// The host side of the ring, as CallServer drives it but with a local buffer
+// instead of memory in a remote process.
+class TestHost
+{
+public:
+  explicit TestHost(std::uint32_t capacity)
+    : ring_(hadesmem::detail::GetCallRingSize(capacity)),
+      executor_{ring_.data()}
+  {
+    hadesmem::detail::CallRingHeader header{};
+    header.mask = capacity - 1;
+    std::memcpy(ring_.data(), &header, sizeof(header));
+  }
+
+  void Execute(std::vector<hadesmem::detail::CallDescriptor>& descriptors)
+  {
+    std::uint32_t const capacity = GetHeader().mask + 1;
+    for (std::size_t i = 0; i < descriptors.size(); i += capacity)
+    {
+      auto const count = static_cast<std::uint32_t>(
+        (std::min)(static_cast<std::size_t>(capacity), descriptors.size() - i));
+      ExecuteBatch(&descriptors[i], count);
+    }
+  }
+
+  std::size_t GetNumExecuted() const noexcept
+  {
+    return executor_.GetNumExecuted();
+  }
+
+private:
+  void ExecuteBatch(hadesmem::detail::CallDescriptor* descriptors,
+                    std::uint32_t count)
+  {
+    auto header = GetHeader();
+    BOOST_TEST_EQ(header.completed, header.submitted);
+
+    descriptors[0].flags |= hadesmem::detail::kCallBatchStart;
+    CopySlots(header.submitted, header.mask, descriptors, count, true);
+
+    header.submitted += count;
+    std::memcpy(ring_.data(), &header, sizeof(header));
+
+    executor_.Run();
+
+    BOOST_TEST_EQ(GetHeader().completed, header.submitted);
+    CopySlots(header.submitted - count, header.mask, descriptors, count, false);
+  }
+
+  void CopySlots(std::uint32_t index,
+                 std::uint32_t mask,
+                 hadesmem::detail::CallDescriptor* descriptors,
+                 std::uint32_t n,
+                 bool to_ring)
+  {
+    auto const first_run =
+      hadesmem::detail::GetCallRingFirstRun(index, mask, n);
+    Copy(hadesmem::detail::GetCallRingSlotOffset(index, mask),
+         descriptors,
+         first_run,
+         to_ring);
+    Copy(hadesmem::detail::GetCallRingSlotOffset(0, mask),
+         descriptors + first_run,
+         n - first_run,
+         to_ring);
+  }
+
+  void Copy(std::size_t offset,
+            hadesmem::detail::CallDescriptor* descriptors,
+            std::uint32_t n,
+            bool to_ring)
+  {
+    std::size_t const size = n * sizeof(hadesmem::detail::CallDescriptor);
+    BOOST_TEST(offset + size <= ring_.size());
+    if (to_ring)
+    {
+      std::memcpy(&ring_[offset], descriptors, size);
+    }
+    else
+    {
+      std::memcpy(descriptors, &ring_[offset], size);
+    }
+  }
+
+  hadesmem::detail::CallRingHeader GetHeader() const
+  {
+    hadesmem::detail::CallRingHeader header;
+    std::memcpy(&header, ring_.data(), sizeof(header));
+    return header;
+  }
+
+  std::vector<std::uint8_t> ring_;
+  TestExecutor executor_;
+};
+}
+
+void TestEncodeX86()
+{
+  auto const abi = hadesmem::detail::CallAbi::kX86;
+  std::vector<hadesmem::detail::CallDescriptorArg> const args = {
+    MakeInt64(0xAAAAAAAABBBBBBBBULL),
+    MakeInt32(0xCCCCCCCC),
+    MakeDouble(1.5),
+    MakeFloat(2.5f),
+    MakeInt32(0xDDDDDDDD),
+    MakeInt32(0xEEEEEEEE)};
+
+  // Everything on the stack, in order, with 64-bit values split low/high.
+  auto const cdecl_desc = Encode(abi, 0, args);
+  BOOST_TEST_EQ(cdecl_desc.address, 0x12345678ULL);
+  BOOST_TEST_EQ(cdecl_desc.regs[0], 0ULL);
+  BOOST_TEST_EQ(cdecl_desc.num_stack_words, 8U);
+  BOOST_TEST_EQ(cdecl_desc.stack[0], 0xBBBBBBBBU);
+  BOOST_TEST_EQ(cdecl_desc.stack[1], 0xAAAAAAAAU);
+  BOOST_TEST_EQ(cdecl_desc.stack[2], 0xCCCCCCCCU);
+  BOOST_TEST_EQ(cdecl_desc.stack[3], 0x00000000U);
+  BOOST_TEST_EQ(cdecl_desc.stack[4], 0x3FF80000U);
+  BOOST_TEST_EQ(cdecl_desc.stack[5], 0x40200000U);
+  BOOST_TEST_EQ(cdecl_desc.stack[6], 0xDDDDDDDDU);
+  BOOST_TEST_EQ(cdecl_desc.stack[7], 0xEEEEEEEEU);
+  BOOST_TEST_EQ(cdecl_desc.flags, 0U);
+
+  // Thiscall takes the first 32-bit integer, skipping over the 64-bit one.
+  auto const thiscall_desc = Encode(abi, 1, args);
+  BOOST_TEST_EQ(thiscall_desc.regs[0], 0xCCCCCCCCULL);
+  BOOST_TEST_EQ(thiscall_desc.regs[1], 0ULL);
+  BOOST_TEST_EQ(thiscall_desc.num_stack_words, 7U);
+  BOOST_TEST_EQ(thiscall_desc.stack[1], 0xAAAAAAAAU);
+  BOOST_TEST_EQ(thiscall_desc.stack[2], 0x00000000U);
+  BOOST_TEST_EQ(thiscall_desc.stack[6], 0xEEEEEEEEU);
+
+  // Fastcall takes the first two, and floating point values are never passed
+  // in registers.
+  auto const fastcall_desc = Encode(abi, 2, args);
+  BOOST_TEST_EQ(fastcall_desc.regs[0], 0xCCCCCCCCULL);
+  BOOST_TEST_EQ(fastcall_desc.regs[1], 0xDDDDDDDDULL);
+  BOOST_TEST_EQ(fastcall_desc.num_stack_words, 6U);
+  BOOST_TEST_EQ(fastcall_desc.stack[4], 0x40200000U);
+  BOOST_TEST_EQ(fastcall_desc.stack[5], 0xEEEEEEEEU);
+}
+
+void TestEncodeX64()
+{
+  auto const abi = hadesmem::detail::CallAbi::kX64;
+  std::vector<hadesmem::detail::CallDescriptorArg> const args = {
+    MakeDouble(1.5),
+    MakeInt32(0xCCCCCCCC),
+    MakeFloat(2.5f),
+    MakeInt64(0xAAAAAAAABBBBBBBBULL),
+    MakeInt32(0xDDDDDDDD),
+    MakeDouble(-2.0)};
+
+  // The first four go in registers whatever their type (the server loads
+  // them into both the integer and XMM registers). The rest get a qword
+  // each, zero extended.
+  auto const desc = Encode(abi, 2, args);
+  BOOST_TEST_EQ(desc.regs[0], 0x3FF8000000000000ULL);
+  BOOST_TEST_EQ(desc.regs[1], 0xCCCCCCCCULL);
+  BOOST_TEST_EQ(desc.regs[2], 0x40200000ULL);
+  BOOST_TEST_EQ(desc.regs[3], 0xAAAAAAAABBBBBBBBULL);
+  BOOST_TEST_EQ(desc.num_stack_words, 4U);
+  BOOST_TEST_EQ(desc.stack[0], 0xDDDDDDDDU);
+  BOOST_TEST_EQ(desc.stack[1], 0U);
+  BOOST_TEST_EQ(desc.stack[2], 0U);
+  BOOST_TEST_EQ(desc.stack[3], 0xC0000000U);
+}
+
+void TestEncodeLimits()
+{
+  std::size_t const max_words = hadesmem::detail::kCallMaxStackWords;
+
+  std::vector<hadesmem::detail::CallDescriptorArg> args_x86(
+    max_words, MakeInt32(1));
+  auto const desc = Encode(hadesmem::detail::CallAbi::kX86, 0, args_x86);
+  BOOST_TEST_EQ(desc.num_stack_words, static_cast<std::uint32_t>(max_words));
+  args_x86.push_back(MakeInt32(1));
+  BOOST_TEST_THROWS(Encode(hadesmem::detail::CallAbi::kX86, 0, args_x86),
+                    hadesmem::Error);
+
+  std::vector<hadesmem::detail::CallDescriptorArg> const args_x64(
+    4 + max_words / 2 + 1, MakeInt64(1));
+  BOOST_TEST_THROWS(Encode(hadesmem::detail::CallAbi::kX64, 0, args_x64),
+                    hadesmem::Error);
+
+  std::size_t const capacity = 64;
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingSize(capacity),
+                sizeof(hadesmem::detail::CallRingHeader) +
+                  capacity * sizeof(hadesmem::detail::CallDescriptor));
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingSlotOffset(65, 63),
+                hadesmem::detail::GetCallRingSlotOffset(1, 63));
+}
+
+void TestRingFirstRun()
+{
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingFirstRun(0, 3, 4), 4U);
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingFirstRun(1, 3, 4), 3U);
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingFirstRun(6, 3, 1), 1U);
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingFirstRun(7, 3, 3), 1U);
+  BOOST_TEST_EQ(hadesmem::detail::GetCallRingFirstRun(0xFFFFFFFF, 3, 2), 1U);
+}
+
+void TestRingExecute()
+{
+  using hadesmem::detail::CallAbi;
+  using hadesmem::detail::CallDescriptor;
+
+  // Small enough that the calls wrap around the ring and get split into
+  // several batches.
+  TestHost host{4};
+
+  std::vector<CallDescriptor> descriptors;
+  for (std::uint32_t i = 0; i < 3; ++i)
+  {
+    descriptors.push_back(
+      Encode(CallAbi::kX86,
+             0,
+             {MakeInt32(0x1337 + i), MakeInt32(2), MakeInt32(3)},
+             kSumX86));
+    descriptors.push_back(Encode(CallAbi::kX86, 0, {}, kGetLastError));
+  }
+  descriptors.push_back(Encode(CallAbi::kX86,
+                               2,
+                               {MakeInt64(0xAAAAAAAABBBBBBBBULL),
+                                MakeInt32(0x10),
+                                MakeDouble(1.5),
+                                MakeInt32(0x20),
+                                MakeInt32(0x30)},
+                               kMixedX86));
+  descriptors.push_back(Encode(CallAbi::kX64,
+                               0,
+                               {MakeDouble(1.25),
+                                MakeInt32(0xFFFFFFFF),
+                                MakeFloat(2.5f),
+                                MakeInt64(0x100000000ULL),
+                                MakeInt32(0x40),
+                                MakeDouble(-4.0)},
+                               kMixedX64));
+  descriptors.push_back(Encode(CallAbi::kX64, 0, {}, kGetLastError));
+
+  host.Execute(descriptors);
+  BOOST_TEST_EQ(host.GetNumExecuted(), descriptors.size());
+
+  // Only the first descriptor of each batch is flagged.
+  for (std::size_t i = 0; i < descriptors.size(); ++i)
+  {
+    BOOST_TEST_EQ(descriptors[i].flags & hadesmem::detail::kCallBatchStart,
+                  i % 4 ? 0U : hadesmem::detail::kCallBatchStart);
+  }
+
+  for (std::uint32_t i = 0; i < 3; ++i)
+  {
+    BOOST_TEST_EQ(descriptors[i * 2].return_i64, 0x1337ULL + i + 5);
+    BOOST_TEST_EQ(descriptors[i * 2].last_error, 0x1337U + i);
+    // The last error carries over to the next call in the same batch...
+    BOOST_TEST_EQ(descriptors[i * 2 + 1].return_i64, 0x1337ULL + i);
+  }
+
+  BOOST_TEST_EQ(descriptors[6].return_i64, 0xAAAAAAAABBBBBBBBULL + 0x60);
+  BOOST_TEST_EQ(descriptors[6].return_double, 3.0);
+  BOOST_TEST_EQ(descriptors[7].return_i64, 0x200000000ULL + 0x3F);
+  BOOST_TEST_EQ(descriptors[7].return_double, -2.75);
+  BOOST_TEST_EQ(descriptors[7].return_float, 5.0f);
+  // ...but not into the next batch.
+  BOOST_TEST_EQ(descriptors[8].return_i64, 0ULL);
+}
+
+int main()
+{
+  TestEncodeX86();
+  TestEncodeX64();
+  TestEncodeLimits();
+  TestRingFirstRun();
+  TestRingExecute();
+  return boost::report_errors();
+}
@@ -0,0 +1,226 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/call_server.hpp>
+#include <hadesmem/call_server.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/call.hpp>
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+
+DWORD_PTR TestInteger(std::uint32_t a,
+                      std::uint32_t b,
+                      std::uint32_t c,
+                      std::uint32_t d,
+                      std::uint32_t e,
+                      std::uint32_t f)
+{
+  BOOST_TEST_EQ(a, 0xAAAAAAAAU);
+  BOOST_TEST_EQ(b, 0xBBBBBBBBU);
+  BOOST_TEST_EQ(c, 0xCCCCCCCCU);
+  BOOST_TEST_EQ(d, 0xDDDDDDDDU);
+  BOOST_TEST_EQ(e, 0xEEEEEEEEU);
+  BOOST_TEST_EQ(f, 0xFFFFFFFFU);
+
+  SetLastError(0x87654321);
+
+  return 0x12345678;
+}
+
+float TestFloat(float a, float b, float c, float d, float e, float f)
+{
+  BOOST_TEST_EQ(a, 1.11111f);
+  BOOST_TEST_EQ(b, 2.22222f);
+  BOOST_TEST_EQ(c, 3.33333f);
+  BOOST_TEST_EQ(d, 4.44444f);
+  BOOST_TEST_EQ(e, 5.55555f);
+  BOOST_TEST_EQ(f, 6.66666f);
+
+  return 1.23456f;
+}
+
+double TestDouble(double a, double b, double c, double d, double e, double f)
+{
+  BOOST_TEST_EQ(a, 1.11111);
+  BOOST_TEST_EQ(b, 2.22222);
+  BOOST_TEST_EQ(c, 3.33333);
+  BOOST_TEST_EQ(d, 4.44444);
+  BOOST_TEST_EQ(e, 5.55555);
+  BOOST_TEST_EQ(f, 6.66666);
+
+  return 1.23456;
+}
+
+DWORD_PTR TestMixed(double a,
+                    char b,
+                    float c,
+                    std::int32_t d,
+                    std::uint64_t e,
+                    float f,
+                    double g)
+{
+  BOOST_TEST_EQ(a, 1337.6666);
+  BOOST_TEST_EQ(b, 'c');
+  BOOST_TEST_EQ(c, 9081.736455f);
+  BOOST_TEST_EQ(d, -1234);
+  BOOST_TEST_EQ(e, 0xAAAAAAAABBBBBBBBULL);
+  BOOST_TEST_EQ(f, 1234.56f);
+  BOOST_TEST_EQ(g, 9876.54);
+
+  SetLastError(5678);
+  return 1234;
+}
+
+std::uint64_t TestCall64Ret()
+{
+  return 0x123456787654321LL;
+}
+
+DWORD_PTR __fastcall TestFastcall(std::uint64_t a,
+                                  std::uint32_t b,
+                                  double c,
+                                  std::uint32_t d,
+                                  std::uint32_t e)
+{
+  BOOST_TEST_EQ(a, 0xAAAAAAAABBBBBBBBULL);
+  BOOST_TEST_EQ(b, 0xCCCCCCCCU);
+  BOOST_TEST_EQ(c, 1.5);
+  BOOST_TEST_EQ(d, 0xDDDDDDDDU);
+  BOOST_TEST_EQ(e, 0xEEEEEEEEU);
+
+  return 0x12345678;
+}
+
+void MultiThreadSet(DWORD last_error)
+{
+  SetLastError(last_error);
+}
+
+DWORD MultiThreadGet()
+{
+  return GetLastError();
+}
+
+void TestCallServer()
+{
+  hadesmem::Process const process(::GetCurrentProcessId());
+  // Small enough that the multi-call test has to wrap around the ring and
+  // split into several batches.
+  hadesmem::CallServer server(process, 4);
+
+  auto const call_int_ret = hadesmem::Call(server,
+                                           &TestInteger,
+                                           hadesmem::CallConv::kDefault,
+                                           0xAAAAAAAA,
+                                           0xBBBBBBBB,
+                                           0xCCCCCCCC,
+                                           0xDDDDDDDD,
+                                           0xEEEEEEEE,
+                                           0xFFFFFFFF);
+  BOOST_TEST_EQ(call_int_ret.GetReturnValue(), 0x12345678UL);
+  BOOST_TEST_EQ(call_int_ret.GetLastError(), 0x87654321UL);
+
+  auto const call_float_ret = hadesmem::Call(server,
+                                             &TestFloat,
+                                             hadesmem::CallConv::kDefault,
+                                             1.11111f,
+                                             2.22222f,
+                                             3.33333f,
+                                             4.44444f,
+                                             5.55555f,
+                                             6.66666f);
+  BOOST_TEST_EQ(call_float_ret.GetReturnValue(), 1.23456f);
+
+  auto const call_double_ret = hadesmem::Call(server,
+                                              &TestDouble,
+                                              hadesmem::CallConv::kDefault,
+                                              1.11111,
+                                              2.22222,
+                                              3.33333,
+                                              4.44444,
+                                              5.55555,
+                                              6.66666);
+  BOOST_TEST_EQ(call_double_ret.GetReturnValue(), 1.23456);
+
+  auto const call_mixed_ret = hadesmem::Call(server,
+                                             &TestMixed,
+                                             hadesmem::CallConv::kDefault,
+                                             1337.6666,
+                                             'c',
+                                             9081.736455f,
+                                             -1234,
+                                             0xAAAAAAAABBBBBBBBULL,
+                                             1234.56f,
+                                             9876.54);
+  BOOST_TEST_EQ(call_mixed_ret.GetReturnValue(), 1234UL);
+  BOOST_TEST_EQ(call_mixed_ret.GetLastError(), 5678UL);
+
+  auto const call_64_ret = hadesmem::Call(
+    server, &TestCall64Ret, hadesmem::CallConv::kDefault);
+  BOOST_TEST_EQ(call_64_ret.GetReturnValue(), 0x123456787654321ULL);
+
+  auto const call_fastcall_ret = hadesmem::Call(server,
+                                                &TestFastcall,
+                                                hadesmem::CallConv::kFastCall,
+                                                0xAAAAAAAABBBBBBBBULL,
+                                                0xCCCCCCCC,
+                                                1.5,
+                                                0xDDDDDDDD,
+                                                0xEEEEEEEE);
+  BOOST_TEST_EQ(call_fastcall_ret.GetReturnValue(), 0x12345678UL);
+
+  // The last error carries over between calls in the same CallMulti, but
+  // not between different ones.
+  std::vector<void*> addresses;
+  std::vector<hadesmem::CallConv> call_convs;
+  std::vector<std::vector<hadesmem::CallArg>> args;
+  for (std::uint32_t i = 0; i < 3; ++i)
+  {
+    addresses.push_back(hadesmem::detail::FuncToPointer(&MultiThreadSet));
+    call_convs.push_back(hadesmem::CallConv::kDefault);
+    args.push_back({hadesmem::CallArg(static_cast<DWORD>(0x1337 + i))});
+    addresses.push_back(hadesmem::detail::FuncToPointer(&MultiThreadGet));
+    call_convs.push_back(hadesmem::CallConv::kDefault);
+    args.push_back({});
+  }
+
+  std::vector<hadesmem::CallResultRaw> results;
+  hadesmem::CallMulti(server,
+                      std::begin(addresses),
+                      std::end(addresses),
+                      std::begin(call_convs),
+                      std::begin(args),
+                      std::back_inserter(results));
+  BOOST_TEST_EQ(results.size(), 6UL);
+  for (std::uint32_t i = 0; i < 3; ++i)
+  {
+    BOOST_TEST_EQ(results[i * 2 + 1].GetReturnValue<DWORD>(), 0x1337UL + i);
+  }
+
+  auto const call_get_ret = hadesmem::Call(
+    server, &MultiThreadGet, hadesmem::CallConv::kDefault);
+  BOOST_TEST_EQ(call_get_ret.GetReturnValue(), 0UL);
+}
+
+void TestCallServerInvalid()
+{
+  hadesmem::Process const process(::GetCurrentProcessId());
+  BOOST_TEST_THROWS(hadesmem::CallServer(process, 3), hadesmem::Error);
+  BOOST_TEST_THROWS(hadesmem::CallServer(process, 0), hadesmem::Error);
+}
+
+int main()
+{
+  TestCallServer();
+  TestCallServerInvalid();
+  return boost::report_errors();
+}
@@ -0,0 +1,528 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/call_thunk.hpp>
+#include <hadesmem/detail/call_thunk.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/call_ring.hpp>
+#include <hadesmem/error.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <intrin.h>
+#include <windows.h>
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <sys/mman.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+// The thunks always use the Windows calling conventions, so on other OSes the
+// test functions have to opt in to them (x64 only).
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#define HADESMEM_TEST_CC
+#define HADESMEM_TEST_STDCALL WINAPI
+#define HADESMEM_TEST_RETURN_ADDRESS() _AddressOfReturnAddress()
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#define HADESMEM_TEST_CC __attribute__((ms_abi))
+#define HADESMEM_TEST_STDCALL __attribute__((ms_abi))
+#define HADESMEM_TEST_RETURN_ADDRESS()                                         \
+  (static_cast<char*>(__builtin_frame_address(0)) + sizeof(void*))
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+namespace
+{
+// Writes code into executable memory in the current process.
+class LocalBackend
+{
+public:
+  explicit LocalBackend(std::size_t* num_writes) : num_writes_(num_writes)
+  {
+  }
+
+  LocalBackend(LocalBackend&& other) noexcept
+    : num_writes_(other.num_writes_), pages_(std::move(other.pages_))
+  {
+    other.pages_.clear();
+  }
+
+  ~LocalBackend()
+  {
+    for (auto const page : pages_)
+    {
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+      ::VirtualFree(page, 0, MEM_RELEASE);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+      ::munmap(page, kPageSize);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    }
+  }
+
+  std::uint64_t WriteCode(std::vector<std::uint8_t> const& code)
+  {
+    ++*num_writes_;
+    BOOST_TEST(code.size() <= kPageSize);
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    void* const page = ::VirtualAlloc(nullptr,
+                                      kPageSize,
+                                      MEM_COMMIT | MEM_RESERVE,
+                                      PAGE_EXECUTE_READWRITE);
+    BOOST_TEST(page != nullptr);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    void* const page = ::mmap(nullptr,
+                              kPageSize,
+                              PROT_READ | PROT_WRITE | PROT_EXEC,
+                              MAP_PRIVATE | MAP_ANONYMOUS,
+                              -1,
+                              0);
+    BOOST_TEST(page != MAP_FAILED);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+    pages_.push_back(page);
+    std::memcpy(page, code.data(), code.size());
+    return reinterpret_cast<std::uintptr_t>(page);
+  }
+
+private:
+  static std::size_t const kPageSize = 0x1000;
+
+  std::size_t* num_writes_;
+  std::vector<void*> pages_;
+};
+
+using LocalCache = hadesmem::detail::BasicCallThunkCache<LocalBackend>;
+
+DWORD g_last_error = 0;
+
+DWORD HADESMEM_TEST_STDCALL TestGetLastError()
+{
+  return g_last_error;
+}
+
+void HADESMEM_TEST_STDCALL TestSetLastError(DWORD last_error)
+{
+  g_last_error = last_error;
+}
+
+void CheckStackAlignment(void* return_address)
+{
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+  // RSP is 16-byte aligned before the call, so the return address is at 8
+  // mod 16.
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(return_address) % 16, 8U);
+#else // #if defined(HADESMEM_DETAIL_ARCH_X64)
+  (void)return_address;
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X64)
+}
+
+std::uintptr_t HADESMEM_TEST_CC TestInteger(std::uint32_t a,
+                                            std::uint32_t b,
+                                            std::uint32_t c,
+                                            std::uint32_t d,
+                                            std::uint32_t e,
+                                            std::uint32_t f)
+{
+  CheckStackAlignment(HADESMEM_TEST_RETURN_ADDRESS());
+  BOOST_TEST_EQ(a, 0xAAAAAAAAU);
+  BOOST_TEST_EQ(b, 0xBBBBBBBBU);
+  BOOST_TEST_EQ(c, 0xCCCCCCCCU);
+  BOOST_TEST_EQ(d, 0xDDDDDDDDU);
+  BOOST_TEST_EQ(e, 0xEEEEEEEEU);
+  BOOST_TEST_EQ(f, 0xFFFFFFFFU);
+
+  g_last_error = 0x87654321;
+
+  return 0x12345678;
+}
+
+float HADESMEM_TEST_CC
+  TestFloat(float a, float b, float c, float d, float e, float f)
+{
+  CheckStackAlignment(HADESMEM_TEST_RETURN_ADDRESS());
+  BOOST_TEST_EQ(a, 1.11111f);
+  BOOST_TEST_EQ(b, 2.22222f);
+  BOOST_TEST_EQ(c, 3.33333f);
+  BOOST_TEST_EQ(d, 4.44444f);
+  BOOST_TEST_EQ(e, 5.55555f);
+  BOOST_TEST_EQ(f, 6.66666f);
+
+  return 1.23456f;
+}
+
+double HADESMEM_TEST_CC
+  TestDouble(double a, double b, double c, double d, double e, double f)
+{
+  CheckStackAlignment(HADESMEM_TEST_RETURN_ADDRESS());
+  BOOST_TEST_EQ(a, 1.11111);
+  BOOST_TEST_EQ(b, 2.22222);
+  BOOST_TEST_EQ(c, 3.33333);
+  BOOST_TEST_EQ(d, 4.44444);
+  BOOST_TEST_EQ(e, 5.55555);
+  BOOST_TEST_EQ(f, 6.66666);
+
+  return 1.23456;
+}
+
+std::uint64_t HADESMEM_TEST_CC TestMixed(double a,
+                                         std::uint32_t b,
+                                         float c,
+                                         std::uint64_t d,
+                                         float e,
+                                         std::int32_t f,
+                                         double g,
+                                         void const* h)
+{
+  CheckStackAlignment(HADESMEM_TEST_RETURN_ADDRESS());
+  BOOST_TEST_EQ(a, 1337.6666);
+  BOOST_TEST_EQ(b, static_cast<std::uint32_t>('c'));
+  BOOST_TEST_EQ(c, 9081.736455f);
+  BOOST_TEST_EQ(d, 0xAAAAAAAABBBBBBBBULL);
+  BOOST_TEST_EQ(e, 1234.56f);
+  BOOST_TEST_EQ(f, -1234);
+  BOOST_TEST_EQ(g, 9876.54);
+  BOOST_TEST(h == &g_last_error);
+
+  g_last_error = 5678;
+  return 0x123456787654321ULL;
+}
+
+#if defined(HADESMEM_DETAIL_ARCH_X86)
+std::uint32_t __fastcall TestFastcall(std::uint64_t a,
+                                      std::uint32_t b,
+                                      double c,
+                                      std::uint32_t d,
+                                      std::uint32_t e)
+{
+  BOOST_TEST_EQ(a, 0xAAAAAAAABBBBBBBBULL);
+  BOOST_TEST_EQ(b, 0xCCCCCCCCU);
+  BOOST_TEST_EQ(c, 1.5);
+  BOOST_TEST_EQ(d, 0xDDDDDDDDU);
+  BOOST_TEST_EQ(e, 0xEEEEEEEEU);
+
+  return 0x12345678;
+}
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X86)
+
+hadesmem::detail::CallDescriptorArg MakeInt32(std::uint32_t value)
+{
+  return {hadesmem::detail::CallArgKind::kInt32, value};
+}
+
+hadesmem::detail::CallDescriptorArg MakeInt64(std::uint64_t value)
+{
+  return {hadesmem::detail::CallArgKind::kInt64, value};
+}
+
+hadesmem::detail::CallDescriptorArg MakePtr(void const* value)
+{
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+  return MakeInt64(reinterpret_cast<std::uintptr_t>(value));
+#else // #if defined(HADESMEM_DETAIL_ARCH_X64)
+  return MakeInt32(reinterpret_cast<std::uintptr_t>(value));
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X64)
+}
+
+hadesmem::detail::CallDescriptorArg MakeFloat(float value)
+{
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return {hadesmem::detail::CallArgKind::kFloat32, bits};
+}
+
+hadesmem::detail::CallDescriptorArg MakeDouble(double value)
+{
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return {hadesmem::detail::CallArgKind::kFloat64, bits};
+}
+
+template <typename FuncT> std::uint64_t FuncAddress(FuncT func)
+{
+  return reinterpret_cast<std::uintptr_t>(reinterpret_cast<void*>(func));
+}
+
+struct TestCall
+{
+  std::uint64_t address;
+  std::size_t num_reg_args;
+  std::vector<hadesmem::detail::CallDescriptorArg> args;
+};
+
+// Lays out and runs a batch in the current process, the same way CallMulti
+// does in the target.
+DWORD RunBatch(LocalCache& cache,
+               hadesmem::detail::CallThunkBatch const& header,
+               std::uint64_t get_last_error,
+               std::vector<hadesmem::detail::CallThunkRequest> const& requests,
+               std::vector<std::uint8_t>& storage,
+               std::vector<std::size_t>& block_offsets)
+{
+  storage.resize(hadesmem::detail::GetCallThunkBatchSize(requests));
+  auto const buffer = hadesmem::detail::BuildCallThunkBatch(
+    reinterpret_cast<std::uintptr_t>(storage.data()),
+    header,
+    get_last_error,
+    requests,
+    block_offsets);
+  std::memcpy(storage.data(), buffer.data(), buffer.size());
+
+  using RunnerT = DWORD(HADESMEM_TEST_STDCALL*)(void*);
+  auto const runner = reinterpret_cast<RunnerT>(static_cast<std::uintptr_t>(
+    cache.GetRunner(hadesmem::detail::GetNativeCallAbi())));
+  return runner(storage.data());
+}
+
+std::vector<hadesmem::detail::CallThunkBlock>
+  RunCalls(LocalCache& cache, std::vector<TestCall> const& calls)
+{
+  std::vector<hadesmem::detail::CallThunkRequest> requests;
+  for (auto const& call : calls)
+  {
+    auto const key =
+      hadesmem::detail::MakeCallThunkKey(hadesmem::detail::GetNativeCallAbi(),
+                                         call.num_reg_args,
+                                         std::begin(call.args),
+                                         std::end(call.args));
+    requests.push_back(hadesmem::detail::CallThunkRequest{
+      cache.GetThunk(key), call.address, call.args});
+  }
+
+  hadesmem::detail::CallThunkBatch header{};
+  header.set_last_error = FuncAddress(&TestSetLastError);
+
+  std::vector<std::uint8_t> storage;
+  std::vector<std::size_t> block_offsets;
+  g_last_error = 0xDEADBEEF;
+  BOOST_TEST_EQ(RunBatch(cache,
+                         header,
+                         FuncAddress(&TestGetLastError),
+                         requests,
+                         storage,
+                         block_offsets),
+                0UL);
+
+  std::vector<hadesmem::detail::CallThunkBlock> results;
+  for (auto const offset : block_offsets)
+  {
+    hadesmem::detail::CallThunkBlock block;
+    std::memcpy(&block, storage.data() + offset, sizeof(block));
+    results.push_back(block);
+  }
+  return results;
+}
+}
+
+void TestCallThunkKey()
+{
+  std::vector<hadesmem::detail::CallDescriptorArg> const args = {
+    MakeInt32(1), MakeDouble(2.0)};
+  auto const x86_this = hadesmem::detail::MakeCallThunkKey(
+    hadesmem::detail::CallAbi::kX86, 1, std::begin(args), std::end(args));
+  auto const x86_cdecl = hadesmem::detail::MakeCallThunkKey(
+    hadesmem::detail::CallAbi::kX86, 0, std::begin(args), std::end(args));
+  auto const x64_this = hadesmem::detail::MakeCallThunkKey(
+    hadesmem::detail::CallAbi::kX64, 1, std::begin(args), std::end(args));
+  auto const x64_cdecl = hadesmem::detail::MakeCallThunkKey(
+    hadesmem::detail::CallAbi::kX64, 0, std::begin(args), std::end(args));
+
+  // Only the x86 thunks depend on the calling convention.
+  BOOST_TEST(x86_this < x86_cdecl || x86_cdecl < x86_this);
+  BOOST_TEST(!(x64_this < x64_cdecl) && !(x64_cdecl < x64_this));
+  BOOST_TEST_EQ(x64_this.kinds.size(), 2UL);
+
+  // Both architectures can be generated whatever the host is.
+  BOOST_TEST(!hadesmem::detail::GenerateCallThunk(x86_this).empty());
+  BOOST_TEST(!hadesmem::detail::GenerateCallThunk(x64_this).empty());
+  BOOST_TEST(!hadesmem::detail::GenerateCallThunkRunner(
+                hadesmem::detail::CallAbi::kX86).empty());
+
+  hadesmem::detail::CallThunkKey too_many{
+    hadesmem::detail::CallAbi::kX64,
+    0,
+    std::vector<hadesmem::detail::CallArgKind>(
+      hadesmem::detail::kCallThunkMaxArgs + 1,
+      hadesmem::detail::CallArgKind::kInt64)};
+  BOOST_TEST_THROWS(hadesmem::detail::GenerateCallThunk(too_many),
+                    hadesmem::Error);
+  too_many.kinds.pop_back();
+  too_many.abi = hadesmem::detail::CallAbi::kX86;
+  BOOST_TEST(!hadesmem::detail::GenerateCallThunk(too_many).empty());
+}
+
+void TestCallThunkBatchLayout()
+{
+  std::vector<hadesmem::detail::CallThunkRequest> const requests = {
+    {0x1000, 0x2000, {MakeInt32(0xFFFFFFFF), MakeFloat(1.0f)}},
+    {0x3000, 0x4000, {}}};
+  hadesmem::detail::CallThunkBatch header{};
+  header.debug_break = 0x5000;
+  std::vector<std::size_t> block_offsets;
+  auto const buffer = hadesmem::detail::BuildCallThunkBatch(
+    0x10000, header, 0x6000, requests, block_offsets);
+
+  std::size_t const entries_size = 2 * sizeof(hadesmem::detail::CallThunkEntry);
+  BOOST_TEST_EQ(block_offsets.size(), 2UL);
+  BOOST_TEST_EQ(block_offsets[0],
+                sizeof(hadesmem::detail::CallThunkBatch) + entries_size);
+  BOOST_TEST_EQ(block_offsets[1],
+                block_offsets[0] + hadesmem::detail::GetCallThunkBlockSize(2));
+  BOOST_TEST_EQ(buffer.size(),
+                block_offsets[1] + hadesmem::detail::GetCallThunkBlockSize(0));
+  BOOST_TEST_EQ(buffer.size(),
+                hadesmem::detail::GetCallThunkBatchSize(requests));
+
+  hadesmem::detail::CallThunkBatch batch;
+  std::memcpy(&batch, buffer.data(), sizeof(batch));
+  BOOST_TEST_EQ(batch.num_calls, 2ULL);
+  BOOST_TEST_EQ(batch.debug_break, 0x5000ULL);
+
+  hadesmem::detail::CallThunkEntry entry;
+  std::memcpy(&entry,
+              buffer.data() + sizeof(hadesmem::detail::CallThunkBatch) +
+                sizeof(hadesmem::detail::CallThunkEntry),
+              sizeof(entry));
+  BOOST_TEST_EQ(entry.thunk, 0x3000ULL);
+  BOOST_TEST_EQ(entry.block, 0x10000ULL + block_offsets[1]);
+
+  hadesmem::detail::CallThunkBlock block;
+  std::memcpy(&block, buffer.data() + block_offsets[0], sizeof(block));
+  BOOST_TEST_EQ(block.address, 0x2000ULL);
+  BOOST_TEST_EQ(block.get_last_error, 0x6000ULL);
+  std::uint64_t args[2];
+  std::memcpy(args,
+              buffer.data() + block_offsets[0] +
+                hadesmem::detail::GetCallThunkArgOffset(0),
+              sizeof(args));
+  BOOST_TEST_EQ(args[0], 0xFFFFFFFFULL);
+  BOOST_TEST_EQ(args[1], 0x3F800000ULL);
+}
+
+void TestCallThunkExecute()
+{
+  std::size_t num_writes = 0;
+  LocalCache cache{LocalBackend{&num_writes}};
+
+  std::vector<TestCall> calls;
+  calls.push_back(TestCall{FuncAddress(&TestInteger),
+                           0,
+                           {MakeInt32(0xAAAAAAAA),
+                            MakeInt32(0xBBBBBBBB),
+                            MakeInt32(0xCCCCCCCC),
+                            MakeInt32(0xDDDDDDDD),
+                            MakeInt32(0xEEEEEEEE),
+                            MakeInt32(0xFFFFFFFF)}});
+  calls.push_back(TestCall{FuncAddress(&TestFloat),
+                           0,
+                           {MakeFloat(1.11111f),
+                            MakeFloat(2.22222f),
+                            MakeFloat(3.33333f),
+                            MakeFloat(4.44444f),
+                            MakeFloat(5.55555f),
+                            MakeFloat(6.66666f)}});
+  calls.push_back(TestCall{FuncAddress(&TestDouble),
+                           0,
+                           {MakeDouble(1.11111),
+                            MakeDouble(2.22222),
+                            MakeDouble(3.33333),
+                            MakeDouble(4.44444),
+                            MakeDouble(5.55555),
+                            MakeDouble(6.66666)}});
+  calls.push_back(TestCall{FuncAddress(&TestMixed),
+                           0,
+                           {MakeDouble(1337.6666),
+                            MakeInt32('c'),
+                            MakeFloat(9081.736455f),
+                            MakeInt64(0xAAAAAAAABBBBBBBBULL),
+                            MakeFloat(1234.56f),
+                            MakeInt32(static_cast<std::uint32_t>(-1234)),
+                            MakeDouble(9876.54),
+                            MakePtr(&g_last_error)}});
+  // Same shape as the first call.
+  calls.push_back(calls.front());
+#if defined(HADESMEM_DETAIL_ARCH_X86)
+  calls.push_back(TestCall{FuncAddress(&TestFastcall),
+                           2,
+                           {MakeInt64(0xAAAAAAAABBBBBBBBULL),
+                            MakeInt32(0xCCCCCCCC),
+                            MakeDouble(1.5),
+                            MakeInt32(0xDDDDDDDD),
+                            MakeInt32(0xEEEEEEEE)}});
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X86)
+
+  auto const results = RunCalls(cache, calls);
+  BOOST_TEST_EQ(results.size(), calls.size());
+
+  BOOST_TEST_EQ(static_cast<std::uintptr_t>(results[0].return_i64),
+                0x12345678U);
+  BOOST_TEST_EQ(results[0].last_error, 0x87654321UL);
+  BOOST_TEST_EQ(results[1].return_float, 1.23456f);
+  // The last error carries over between calls in a batch.
+  BOOST_TEST_EQ(results[1].last_error, 0x87654321UL);
+  BOOST_TEST_EQ(results[2].return_double, 1.23456);
+  BOOST_TEST_EQ(results[3].return_i64, 0x123456787654321ULL);
+  BOOST_TEST_EQ(results[3].last_error, 5678UL);
+  BOOST_TEST_EQ(results[4].last_error, 0x87654321UL);
+#if defined(HADESMEM_DETAIL_ARCH_X86)
+  BOOST_TEST_EQ(static_cast<std::uint32_t>(results[5].return_i64),
+                0x12345678U);
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X86)
+
+  // One thunk per shape, plus the runner.
+  std::size_t const num_shapes = calls.size() - 1;
+  BOOST_TEST_EQ(cache.GetNumThunks(), num_shapes);
+  BOOST_TEST_EQ(num_writes, num_shapes + 1);
+
+  // Running the same shapes again only ships data.
+  auto const rerun = RunCalls(cache, calls);
+  BOOST_TEST_EQ(rerun[3].return_i64, 0x123456787654321ULL);
+  BOOST_TEST_EQ(num_writes, num_shapes + 1);
+}
+
+void TestCallThunkNoLastError()
+{
+  std::size_t num_writes = 0;
+  LocalCache cache{LocalBackend{&num_writes}};
+
+  std::vector<hadesmem::detail::CallDescriptorArg> const args;
+  std::vector<hadesmem::detail::CallThunkRequest> const requests = {
+    {cache.GetThunk(hadesmem::detail::MakeCallThunkKey(
+       hadesmem::detail::GetNativeCallAbi(),
+       0,
+       std::begin(args),
+       std::end(args))),
+     FuncAddress(&TestGetLastError),
+     args}};
+
+  // Neither SetLastError nor GetLastError, so the last error is untouched and
+  // not reported.
+  std::vector<std::uint8_t> storage;
+  std::vector<std::size_t> block_offsets;
+  g_last_error = 42;
+  RunBatch(cache,
+           hadesmem::detail::CallThunkBatch{},
+           0,
+           requests,
+           storage,
+           block_offsets);
+
+  hadesmem::detail::CallThunkBlock block;
+  std::memcpy(&block, storage.data() + block_offsets[0], sizeof(block));
+  BOOST_TEST_EQ(block.return_i64 & 0xFFFFFFFFULL, 42ULL);
+  BOOST_TEST_EQ(block.last_error, 0UL);
+  BOOST_TEST_EQ(g_last_error, 42UL);
+}
+
+int main()
+{
+  TestCallThunkKey();
+  TestCallThunkBatchLayout();
+  TestCallThunkExecute();
+  TestCallThunkNoLastError();
+  return boost::report_errors();
+}
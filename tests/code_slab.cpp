@@ -0,0 +1,311 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/code_slab.hpp>
+#include <hadesmem/detail/code_slab.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+std::uintptr_t const kGranularity = 0x10000;
+
+// Simulated address space. Addresses are never dereferenced.
+struct SimulatedMap
+{
+  std::uintptr_t min_address{kGranularity};
+  std::uintptr_t max_address{0x7FFFFFFF0000ULL};
+  // Base to size.
+  std::map<std::uintptr_t, std::uintptr_t> allocated;
+  // Number of Reserve calls which should fail as if another thread took the
+  // address first.
+  std::size_t num_races{};
+  std::size_t num_walks{};
+  std::size_t num_reserves{};
+  // Milliseconds.
+  std::uint64_t time{};
+
+  bool IsFree(std::uintptr_t base, std::uintptr_t size) const
+  {
+    for (auto const& a : allocated)
+    {
+      if (base < a.first + a.second && a.first < base + size)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+class SimulatedBackend
+{
+public:
+  explicit SimulatedBackend(SimulatedMap& map) : map_(&map)
+  {
+  }
+
+  std::uintptr_t GetGranularity() const
+  {
+    return kGranularity;
+  }
+
+  std::vector<hadesmem::detail::CodeSlabRange>
+    GetFreeRanges(std::uintptr_t beg, std::uintptr_t end) const
+  {
+    ++map_->num_walks;
+    std::vector<hadesmem::detail::CodeSlabRange> free_ranges;
+    auto cur = map_->min_address;
+    auto const add = [&](std::uintptr_t range_end) {
+      if (range_end > cur && cur < end && range_end > beg)
+      {
+        free_ranges.push_back(
+          hadesmem::detail::CodeSlabRange{cur, range_end - cur});
+      }
+    };
+    for (auto const& a : map_->allocated)
+    {
+      add(a.first);
+      cur = a.first + a.second;
+    }
+    add(map_->max_address);
+    return free_ranges;
+  }
+
+  void* Reserve(std::uintptr_t address, std::size_t size)
+  {
+    ++map_->num_reserves;
+    BOOST_TEST_EQ(address % kGranularity, 0U);
+    if (!map_->IsFree(address, size))
+    {
+      return nullptr;
+    }
+
+    if (map_->num_races)
+    {
+      --map_->num_races;
+      map_->allocated[address] = size;
+      return nullptr;
+    }
+
+    map_->allocated[address] = size;
+    return reinterpret_cast<void*>(address);
+  }
+
+  void Release(void* address, std::size_t /*size*/) noexcept
+  {
+    map_->allocated.erase(reinterpret_cast<std::uintptr_t>(address));
+  }
+
+  std::uint64_t GetTime() const noexcept
+  {
+    return map_->time;
+  }
+
+private:
+  SimulatedMap* map_;
+};
+
+using SimulatedSlab = hadesmem::detail::BasicCodeSlab<SimulatedBackend>;
+
+std::uintptr_t GetAddress(SimulatedSlab::SlotT const& slot)
+{
+  return reinterpret_cast<std::uintptr_t>(slot.GetBase());
+}
+}
+
+void TestFindCodeSlabBlock()
+{
+  using hadesmem::detail::CodeSlabRange;
+  using hadesmem::detail::FindCodeSlabBlock;
+
+  std::vector<CodeSlabRange> const free_ranges = {
+    {0x10000, 0x30000}, {0x100000, 0x8000}, {0x200000, 0x100000}};
+
+  // Inside a free range, so the next aligned address.
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x218000, 0, 0x1000000, 0x10000, kGranularity),
+                0x220000U);
+  // Above is preferred to below, even when further away.
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x1F0000, 0, 0x1000000, 0x10000, kGranularity),
+                0x200000U);
+  // Unaligned and too small ranges are skipped.
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x50000, 0, 0x1000000, 0x10000, kGranularity),
+                0x200000U);
+  // Closest below if there's nothing above.
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x500000, 0, 0x1000000, 0x10000, kGranularity),
+                0x2F0000U);
+  // Limits are respected, including for the end of the block.
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x500000, 0, 0x2F8000, 0x10000, kGranularity),
+                0x2E0000U);
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x500000, 0x300000, 0x1000000, 0x10000,
+                  kGranularity),
+                0U);
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x10000, 0x20000, 0x1000000, 0x20000,
+                  kGranularity),
+                0x20000U);
+  // Blocks larger than the granularity.
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0x10000, 0, 0x1000000, 0x40000, kGranularity),
+                0x200000U);
+  BOOST_TEST_EQ(FindCodeSlabBlock(
+                  free_ranges, 0, 0, 0x1000000, 0x200000, kGranularity),
+                0U);
+
+  // Ranges at the very top of the address space.
+  auto const max_address = ~static_cast<std::uintptr_t>(0);
+  std::vector<CodeSlabRange> const top_ranges = {
+    {max_address - 0x3FFFF, 0x40000}};
+  BOOST_TEST_EQ(FindCodeSlabBlock(top_ranges,
+                                  max_address - 0x100000,
+                                  0,
+                                  max_address,
+                                  0x10000,
+                                  kGranularity),
+                max_address - 0x3FFFF);
+}
+
+void TestCodeSlabPlacement()
+{
+  SimulatedMap map;
+  // Pretend there's an image mapped at 0x140000000.
+  std::uintptr_t const image = 0x140000000ULL;
+  map.allocated[image] = 0x100000;
+  SimulatedSlab slab{SimulatedBackend{map}};
+
+  auto const target = image + 0x1234;
+  std::vector<SimulatedSlab::SlotT> slots;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    slots.emplace_back(slab.AllocateNear(reinterpret_cast<void*>(target), 24));
+  }
+
+  // One block, directly after the image, with aligned slots handed out in
+  // order.
+  BOOST_TEST_EQ(slab.GetNumBlocks(), 1U);
+  BOOST_TEST_EQ(map.num_walks, 1U);
+  for (std::size_t i = 0; i < slots.size(); ++i)
+  {
+    BOOST_TEST_EQ(GetAddress(slots[i]), image + 0x100000 + i * 32);
+    BOOST_TEST_EQ(slots[i].GetSize(), 32U);
+  }
+
+  // Freed slots are quarantined, then reused before anything new is
+  // allocated.
+  auto const freed = GetAddress(slots[3]);
+  slots[3].Free();
+  BOOST_TEST(slots[3].GetBase() == nullptr);
+  map.time += SimulatedSlab::kQuarantineTime - 1;
+  auto quarantined = slab.AllocateNear(reinterpret_cast<void*>(target), 20);
+  BOOST_TEST_EQ(GetAddress(quarantined), image + 0x100000 + 8 * 32);
+  map.time += 1;
+  auto reused = slab.AllocateNear(reinterpret_cast<void*>(target), 20);
+  BOOST_TEST_EQ(GetAddress(reused), freed);
+  quarantined.Free();
+
+  // Different size classes don't share free slots.
+  reused.Free();
+  map.time += SimulatedSlab::kQuarantineTime;
+  auto const bigger = slab.AllocateNear(reinterpret_cast<void*>(target), 64);
+  BOOST_TEST(GetAddress(bigger) != freed);
+  BOOST_TEST_EQ(slab.GetNumBlocks(), 1U);
+
+  // A slot far away from the existing block needs a new one.
+  std::uintptr_t const far_target = 0x500000000ULL;
+  auto const far_slot =
+    slab.AllocateNear(reinterpret_cast<void*>(far_target), 16);
+  BOOST_TEST_EQ(GetAddress(far_slot), far_target);
+  BOOST_TEST_EQ(slab.GetNumBlocks(), 2U);
+
+  // Slots can't straddle the end of the requested range.
+  auto const ranged =
+    slab.Allocate(16, image + 0x100000, image + 0x100000 + 0x10000, 0);
+  BOOST_TEST(GetAddress(ranged) >= image + 0x100000);
+  BOOST_TEST(GetAddress(ranged) + 16 <= image + 0x110000);
+
+  // Filling a block moves on to the next one.
+  std::vector<SimulatedSlab::SlotT> fill;
+  for (std::size_t i = 0; i < kGranularity / 256 + 1; ++i)
+  {
+    fill.emplace_back(slab.Allocate(256, 0, image, image));
+  }
+  BOOST_TEST_EQ(slab.GetNumBlocks(), 4U);
+  BOOST_TEST_EQ(GetAddress(fill.back()), image - 2 * kGranularity);
+
+  // Nothing free in range.
+  BOOST_TEST_THROWS(slab.Allocate(16, image, image + 0x100000, image),
+                    hadesmem::Error);
+}
+
+void TestCodeSlabRace()
+{
+  SimulatedMap map;
+  map.num_races = 2;
+  SimulatedSlab slab{SimulatedBackend{map}};
+
+  std::uintptr_t const target = 0x10000000ULL;
+  auto const slot = slab.AllocateNear(reinterpret_cast<void*>(target), 16);
+  // The first two blocks found were taken by 'someone else' between the walk
+  // and the reservation.
+  BOOST_TEST_EQ(map.num_reserves, 3U);
+  BOOST_TEST_EQ(map.num_walks, 3U);
+  BOOST_TEST_EQ(GetAddress(slot), target + 2 * kGranularity);
+  BOOST_TEST_EQ(slab.GetNumBlocks(), 1U);
+}
+
+void TestCodeSlabRelease()
+{
+  SimulatedMap map;
+  {
+    SimulatedSlab slab{SimulatedBackend{map}};
+    auto slot = slab.Allocate(16, 0, 0x100000000ULL, 0x20000);
+    auto moved = std::move(slot);
+    BOOST_TEST(slot.GetBase() == nullptr);
+    BOOST_TEST_EQ(GetAddress(moved), 0x20000U);
+    BOOST_TEST_EQ(map.allocated.size(), 1U);
+  }
+  BOOST_TEST(map.allocated.empty());
+}
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+void TestLocalCodeSlab()
+{
+  auto& slab = hadesmem::detail::GetLocalCodeSlab();
+  auto const target = reinterpret_cast<void*>(&TestLocalCodeSlab);
+  auto const slot = slab.AllocateNear(target, 64);
+  auto const distance = reinterpret_cast<std::intptr_t>(slot.GetBase()) -
+                        reinterpret_cast<std::intptr_t>(target);
+  BOOST_TEST(distance < 0x7FFFFFFFLL && distance > -0x7FFFFFFFLL);
+  *static_cast<std::uint8_t*>(slot.GetBase()) = 0xC3;
+}
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+int main()
+{
+  TestFindCodeSlabBlock();
+  TestCodeSlabPlacement();
+  TestCodeSlabRace();
+  TestCodeSlabRelease();
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  TestLocalCodeSlab();
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return boost::report_errors();
+}
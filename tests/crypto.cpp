@@ -0,0 +1,114 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/crypto.hpp>
+#include <hadesmem/detail/crypto.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+template <typename Hash>
+std::wstring HashString(std::string const& str, Hash hash = Hash())
+{
+  hash.Update(str.data(), str.size());
+  return hadesmem::detail::ByteArrayToString(hash.Final());
+}
+
+// Feeds the data in pieces of varying size, so buffering across block
+// boundaries is exercised, and checks it against the one-shot result.
+template <typename Hash>
+void TestIncremental(std::vector<std::uint8_t> const& data)
+{
+  for (std::size_t const piece : {1U, 3U, 7U, 31U, 63U, 64U, 65U, 200U})
+  {
+    Hash hash;
+    for (std::size_t i = 0; i < data.size(); i += piece)
+    {
+      auto const len = (std::min)(piece, data.size() - i);
+      hash.Update(data.data() + i, len);
+    }
+    BOOST_TEST(hash.Final() ==
+               hadesmem::detail::GetHash<Hash>(data.data(), data.size()));
+  }
+}
+}
+
+void TestKnownDigests()
+{
+  using hadesmem::detail::Md5;
+  using hadesmem::detail::Sha1;
+  using hadesmem::detail::Sha256;
+  using hadesmem::detail::XxHash64;
+
+  BOOST_TEST(HashString<Md5>("") == L"d41d8cd98f00b204e9800998ecf8427e");
+  BOOST_TEST(HashString<Md5>("abc") == L"900150983cd24fb0d6963f7d28e17f72");
+
+  BOOST_TEST(HashString<Sha1>("") ==
+             L"da39a3ee5e6b4b0d3255bfef95601890afd80709");
+  BOOST_TEST(HashString<Sha1>("abc") ==
+             L"a9993e364706816aba3e25717850c26c9cd0d89d");
+
+  BOOST_TEST(
+    HashString<Sha256>("") ==
+    L"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  BOOST_TEST(
+    HashString<Sha256>("abc") ==
+    L"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+  BOOST_TEST(HashString<XxHash64>("") == L"ef46db3751d8e999");
+  BOOST_TEST(HashString<XxHash64>("abc") == L"44bc2cf5ad770999");
+  BOOST_TEST_EQ(hadesmem::detail::GetHash<XxHash64>("abc", 3)[0], 0x44);
+
+  // Long enough to need several blocks, and the padding to spill into an
+  // extra one.
+  std::string const million_a(1000000, 'a');
+  BOOST_TEST(HashString<Sha1>(million_a) ==
+             L"34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+  BOOST_TEST(
+    HashString<Sha256>(million_a) ==
+    L"cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+  std::string seeded;
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    for (std::size_t j = 0; j < 256; ++j)
+    {
+      seeded += static_cast<char>(j);
+    }
+  }
+  BOOST_TEST(HashString(seeded, XxHash64(1)) == L"f4493e5e44988d52");
+}
+
+void TestIncrementalDigests()
+{
+  std::vector<std::uint8_t> data(0x1234);
+  std::uint32_t seed = 12345;
+  for (auto& b : data)
+  {
+    seed = seed * 1103515245 + 12345;
+    b = static_cast<std::uint8_t>(seed >> 16);
+  }
+
+  TestIncremental<hadesmem::detail::Md5>(data);
+  TestIncremental<hadesmem::detail::Sha1>(data);
+  TestIncremental<hadesmem::detail::Sha256>(data);
+  TestIncremental<hadesmem::detail::XxHash64>(data);
+}
+
+int main()
+{
+  TestKnownDigests();
+  TestIncrementalDigests();
+  return boost::report_errors();
+}
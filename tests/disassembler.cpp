@@ -0,0 +1,184 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/disassembly_cache.hpp>
+#include <hadesmem/detail/disassembly_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/disassembler.hpp>
+#include <hadesmem/detail/insn_relocator.hpp>
+#include <hadesmem/error.hpp>
+
+namespace
+{
+using hadesmem::detail::InsnBranch;
+using hadesmem::detail::InsnMode;
+
+// sub rsp, 0x28; mov rax, [rip+0x1000]; jne +0x10; cmp dword ptr [rip+8], 5
+std::vector<std::uint8_t> GetTestCode()
+{
+  return {0x48, 0x83, 0xEC, 0x28, 0x48, 0x8B, 0x05, 0x00, 0x10, 0x00,
+          0x00, 0x75, 0x10, 0x83, 0x3D, 0x08, 0x00, 0x00, 0x00, 0x05};
+}
+
+// Treats every byte as a one byte instruction.
+class ByteDisassembler : public hadesmem::detail::Disassembler
+{
+public:
+  explicit ByteDisassembler(InsnMode mode) noexcept : Disassembler{mode}
+  {
+  }
+
+  virtual void const* GetBackendId() const noexcept override
+  {
+    static char const id{};
+    return &id;
+  }
+
+  virtual bool Decode(std::uint8_t const* code,
+                      std::size_t size,
+                      std::uint64_t address,
+                      hadesmem::detail::InsnRecord& insn) const override
+  {
+    (void)code;
+    (void)address;
+    insn = hadesmem::detail::InsnRecord{};
+    insn.length = 1;
+    return size != 0;
+  }
+};
+}
+
+void TestDisassemblerRecords()
+{
+  hadesmem::detail::InsnDecoderDisassembler const disassembler{
+    InsnMode::kX64};
+  BOOST_TEST(disassembler.GetMode() == InsnMode::kX64);
+
+  auto const code = GetTestCode();
+  auto const insns =
+    disassembler.DecodeUntil(code.data(), code.size(), 0x1000, 12);
+  BOOST_TEST_EQ(insns.size(), 3UL);
+
+  BOOST_TEST_EQ(insns[0].length, 4);
+  BOOST_TEST(insns[0].branch == InsnBranch::kNone);
+  BOOST_TEST(!insns[0].rip_relative);
+  BOOST_TEST_EQ(insns[0].rel_size, 0);
+
+  BOOST_TEST_EQ(insns[1].length, 7);
+  BOOST_TEST(insns[1].rip_relative);
+  BOOST_TEST_EQ(insns[1].rel_offset, 3);
+  BOOST_TEST_EQ(insns[1].rel_size, 4);
+
+  BOOST_TEST_EQ(insns[2].length, 2);
+  BOOST_TEST(insns[2].branch == InsnBranch::kJcc);
+  BOOST_TEST_EQ(insns[2].condition, 5);
+  BOOST_TEST_EQ(insns[2].rel_offset, 1);
+  BOOST_TEST_EQ(insns[2].rel_size, 1);
+
+  // The displacement comes before the immediate.
+  hadesmem::detail::InsnRecord cmp{};
+  BOOST_TEST(disassembler.Decode(code.data() + 13, 7, 0x100D, cmp));
+  BOOST_TEST_EQ(cmp.length, 7);
+  BOOST_TEST(cmp.rip_relative);
+  BOOST_TEST_EQ(cmp.rel_offset, 2);
+
+  // The built-in backend doesn't format.
+  BOOST_TEST(disassembler.Format(code.data(), code.size(), 0x1000).empty());
+
+  BOOST_TEST_THROWS(disassembler.DecodeUntil(code.data(), 5, 0x1000, 5),
+                    hadesmem::Error);
+
+  // Relocating pre-decoded records gives the same result as decoding in
+  // place.
+  auto const from_records =
+    hadesmem::detail::RelocateCode(code.data(), insns, 0x1000, 0x2000,
+                                   InsnMode::kX64);
+  auto const from_bytes = hadesmem::detail::RelocateCode(
+    code.data(), code.size(), 0x1000, 0x2000, 12, InsnMode::kX64);
+  BOOST_TEST(from_records.code == from_bytes.code);
+  BOOST_TEST_EQ(from_records.source_size, 13UL);
+}
+
+void TestDisassemblyCache()
+{
+  hadesmem::detail::InsnDecoderDisassembler const disassembler{
+    InsnMode::kX64};
+  hadesmem::detail::DisassemblyCache cache{4};
+
+  auto code = GetTestCode();
+  auto const first =
+    cache.DecodeUntil(disassembler, code.data(), code.size(), 0x1000, 5);
+  BOOST_TEST_EQ(first.size(), 2UL);
+  BOOST_TEST_EQ(cache.GetNumMisses(), 1UL);
+  BOOST_TEST_EQ(cache.GetNumHits(), 0UL);
+
+  auto const second =
+    cache.DecodeUntil(disassembler, code.data(), code.size(), 0x1000, 5);
+  BOOST_TEST_EQ(second.size(), first.size());
+  BOOST_TEST_EQ(cache.GetNumHits(), 1UL);
+  BOOST_TEST_EQ(cache.GetSize(), 1UL);
+
+  // Same address, different code.
+  code[0] = 0x90;
+  auto const changed =
+    cache.DecodeUntil(disassembler, code.data(), code.size(), 0x1000, 5);
+  BOOST_TEST_EQ(changed[0].length, 1);
+  BOOST_TEST_EQ(cache.GetNumMisses(), 2UL);
+
+  // Only the tail of a covered instruction changed, so the hash of the
+  // requested bytes still matches, but the result can't be reused.
+  code[0] = 0x48;
+  code[9] = 0xFF;
+  auto const tail =
+    cache.DecodeUntil(disassembler, code.data(), code.size(), 0x1000, 5);
+  BOOST_TEST_EQ(tail.size(), 2UL);
+  BOOST_TEST_EQ(cache.GetNumMisses(), 3UL);
+
+  // Same code, different address or size.
+  cache.DecodeUntil(disassembler, code.data(), code.size(), 0x2000, 5);
+  cache.DecodeUntil(disassembler, code.data(), code.size(), 0x1000, 12);
+  BOOST_TEST_EQ(cache.GetNumMisses(), 5UL);
+
+  // Same code, address, mode and size, but a different backend.
+  ByteDisassembler const byte_disassembler{InsnMode::kX64};
+  BOOST_TEST(byte_disassembler.GetBackendId() != disassembler.GetBackendId());
+  auto const bytes =
+    cache.DecodeUntil(byte_disassembler, code.data(), code.size(), 0x1000, 5);
+  BOOST_TEST_EQ(bytes.size(), 5UL);
+  BOOST_TEST_EQ(cache.GetNumMisses(), 6UL);
+  BOOST_TEST_EQ(
+    cache.DecodeUntil(byte_disassembler, code.data(), code.size(), 0x1000, 5)
+      .size(),
+    5UL);
+  BOOST_TEST_EQ(cache.GetNumHits(), 2UL);
+  auto const insns =
+    cache.DecodeUntil(disassembler, code.data(), code.size(), 0x1000, 5);
+  BOOST_TEST_EQ(insns.size(), 2UL);
+
+  // Bounded.
+  cache.DecodeUntil(disassembler, code.data(), code.size(), 0x3000, 5);
+  BOOST_TEST(cache.GetSize() <= 4UL);
+
+  BOOST_TEST_THROWS(
+    cache.DecodeUntil(disassembler, code.data(), 5, 0x4000, 5),
+    hadesmem::Error);
+
+  cache.Clear();
+  BOOST_TEST_EQ(cache.GetSize(), 0UL);
+}
+
+int main()
+{
+  TestDisassemblerRecords();
+  TestDisassemblyCache();
+  return boost::report_errors();
+}
@@ -0,0 +1,156 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/dump_capture.hpp>
+#include <hadesmem/detail/dump_capture.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/memory_snapshot.hpp>
+#include <hadesmem/region_snapshot.hpp>
+#include <hadesmem/scanner.hpp>
+
+namespace
+{
+wchar_t const* const kCapturePath = L"hadesmem_dump_capture_test.bin";
+char const* const kCapturePathNarrow = "hadesmem_dump_capture_test.bin";
+char const* const kCaptureMemoryPathNarrow =
+  "hadesmem_dump_capture_test.bin.mem";
+}
+
+void TestDumpCaptureFile()
+{
+  hadesmem::detail::DumpCapture capture;
+  capture.pid = 1234;
+  capture.process_path = L"C:\\Games\\game.exe";
+  capture.modules.push_back(
+    hadesmem::detail::DumpCaptureModule{0x400000,
+                                        0x5000,
+                                        1,
+                                        L"\\Device\\HarddiskVolume1\\game.exe",
+                                        L"game.exe"});
+  capture.modules.push_back(hadesmem::detail::DumpCaptureModule{
+    0x76000000, 0x100000, 3, L"", L"kernel32.dll"});
+  capture.exports.push_back(
+    hadesmem::detail::DumpCaptureExport{0x76001000, 1, 1, true, "Sleep"});
+  capture.exports.push_back(
+    hadesmem::detail::DumpCaptureExport{0x76001000, 0, 7, false, ""});
+
+  hadesmem::detail::SaveDumpCapture(capture, kCapturePath);
+  auto const loaded = hadesmem::detail::LoadDumpCapture(kCapturePath);
+  BOOST_TEST_EQ(loaded.pid, 1234U);
+  BOOST_TEST(loaded.process_path == capture.process_path);
+  BOOST_TEST_EQ(loaded.modules.size(), 2U);
+  BOOST_TEST_EQ(loaded.modules[1].base, 0x76000000U);
+  BOOST_TEST_EQ(loaded.modules[1].size, 0x100000U);
+  BOOST_TEST_EQ(loaded.modules[1].priority, 3);
+  BOOST_TEST(loaded.modules[0].path == capture.modules[0].path);
+  BOOST_TEST(loaded.modules[1].name == L"kernel32.dll");
+  BOOST_TEST_EQ(loaded.exports.size(), 2U);
+  BOOST_TEST_EQ(loaded.exports[0].va, 0x76001000U);
+  BOOST_TEST_EQ(loaded.exports[0].module, 1U);
+  BOOST_TEST(loaded.exports[0].by_name);
+  BOOST_TEST(loaded.exports[0].name == "Sleep");
+  BOOST_TEST(!loaded.exports[1].by_name);
+  BOOST_TEST_EQ(loaded.exports[1].ordinal, 7U);
+
+  std::vector<char> data;
+  {
+    std::ifstream file(kCapturePathNarrow, std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+  }
+
+  // Truncated.
+  {
+    std::ofstream file(kCapturePathNarrow, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size() - 1));
+  }
+  BOOST_TEST_THROWS(hadesmem::detail::LoadDumpCapture(kCapturePath),
+                    hadesmem::Error);
+
+  // Export referencing a module which doesn't exist.
+  capture.exports[1].module = 2;
+  hadesmem::detail::SaveDumpCapture(capture, kCapturePath);
+  BOOST_TEST_THROWS(hadesmem::detail::LoadDumpCapture(kCapturePath),
+                    hadesmem::Error);
+
+  {
+    std::ofstream file(kCapturePathNarrow, std::ios::binary | std::ios::trunc);
+    file << "Not a dump capture.";
+  }
+  BOOST_TEST_THROWS(hadesmem::detail::LoadDumpCapture(kCapturePath),
+                    hadesmem::Error);
+
+  std::remove(kCapturePathNarrow);
+}
+
+void TestSpanScanSource()
+{
+  std::vector<std::uint8_t> image(0x4000, 0x11);
+  std::vector<std::uint8_t> heap(0x4000, 0x22);
+  std::vector<std::uint8_t> stub(0x1000, 0x33);
+  hadesmem::BufferScanSource buffers;
+  buffers.AddBuffer(0x400000, image.data(), image.size(), PAGE_READONLY);
+  buffers.AddBuffer(0x10000000, heap.data(), heap.size());
+  buffers.AddBuffer(0x20000000, stub.data(), stub.size(), PAGE_EXECUTE_READ);
+
+  // Only the image and the stub, with the image span extending past the end
+  // of its buffer.
+  hadesmem::detail::SpanScanSource source(buffers);
+  source.Add(0x400000, 0x402000);
+  source.Add(0x401000, 0x406000);
+  source.Add(0x20000000, 0x20001000);
+  source.Finalize();
+
+  hadesmem::RegionSnapshot regions;
+  source.GetRegions(regions);
+  BOOST_TEST_EQ(regions.size(), 2U);
+  BOOST_TEST_EQ(regions[0].base, 0x400000U);
+  BOOST_TEST_EQ(regions[0].size, 0x4000U);
+  BOOST_TEST_EQ(regions[1].protect, static_cast<DWORD>(PAGE_EXECUTE_READ));
+
+  std::uint8_t byte = 0;
+  BOOST_TEST(source.Read(0x403FFF, &byte, 1));
+  BOOST_TEST_EQ(byte, 0x11);
+  BOOST_TEST(!source.Read(0x10000000, &byte, 1));
+  BOOST_TEST(!source.Read(0x1FFFFFFF, &byte, 2));
+
+  hadesmem::detail::SpanScanSource clipped(buffers);
+  clipped.Add(0x10001000, 0x10002000);
+  clipped.Finalize();
+  clipped.GetRegions(regions);
+  BOOST_TEST_EQ(regions.size(), 1U);
+  BOOST_TEST_EQ(regions[0].base, 0x10001000U);
+  BOOST_TEST_EQ(regions[0].size, 0x1000U);
+  BOOST_TEST(!clipped.Read(0x10001FFF, &byte, 2));
+
+  {
+    hadesmem::MemorySnapshot const snapshot(
+      source, hadesmem::detail::GetDumpCaptureMemoryPath(kCapturePath));
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 2U);
+    BOOST_TEST(snapshot.Read(0x20000FFF, &byte, 1));
+    BOOST_TEST_EQ(byte, 0x33);
+    BOOST_TEST(!snapshot.Read(0x10000000, &byte, 1));
+  }
+
+  std::remove(kCaptureMemoryPathNarrow);
+}
+
+int main()
+{
+  TestDumpCaptureFile();
+  TestSpanScanSource();
+  return boost::report_errors();
+}
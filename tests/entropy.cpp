@@ -0,0 +1,136 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/entropy.hpp>
+#include <hadesmem/detail/entropy.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+std::vector<std::uint8_t> MakeTestData(std::size_t size)
+{
+  // A mix of runs (which stress the counting lanes), text-like data and
+  // pseudo-random data.
+  std::vector<std::uint8_t> data(size);
+  std::uint32_t seed = 12345;
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    auto const region = (i / 0x1000) % 3;
+    data[i] =
+      region == 0 ? 0xCC : region == 1 ? static_cast<std::uint8_t>(
+                                           'a' + (seed >> 16) % 26)
+                                       : static_cast<std::uint8_t>(seed >> 16);
+  }
+  return data;
+}
+
+double GetEntropySimple(std::uint8_t const* p, std::size_t s)
+{
+  std::vector<std::size_t> counts(256);
+  for (std::size_t i = 0; i < s; ++i)
+  {
+    ++counts[p[i]];
+  }
+
+  double entropy = 0;
+  for (auto const c : counts)
+  {
+    if (c)
+    {
+      auto const freq = static_cast<double>(c) / static_cast<double>(s);
+      entropy -= freq * std::log(freq) / std::log(2.0);
+    }
+  }
+  return entropy;
+}
+
+bool IsClose(double a, double b)
+{
+  return std::fabs(a - b) < 1e-9;
+}
+}
+
+void TestByteHistogram()
+{
+  auto const data = MakeTestData(0x10003);
+
+  // Unaligned start and a tail which isn't a multiple of the lane width.
+  auto const histogram =
+    hadesmem::detail::GetByteHistogram(data.data() + 1, data.size() - 1);
+  std::vector<std::uint64_t> expected(256);
+  for (std::size_t i = 1; i < data.size(); ++i)
+  {
+    ++expected[data[i]];
+  }
+  BOOST_TEST(std::equal(
+    std::begin(histogram), std::end(histogram), std::begin(expected)));
+
+  BOOST_TEST_EQ(hadesmem::detail::GetEntropy(data.data(), 0), 0.0);
+  std::vector<std::uint8_t> const zeroes(0x1000);
+  BOOST_TEST_EQ(hadesmem::detail::GetEntropy(zeroes.data(), zeroes.size()),
+                0.0);
+
+  std::vector<std::uint8_t> all_bytes(0x10000);
+  for (std::size_t i = 0; i < all_bytes.size(); ++i)
+  {
+    all_bytes[i] = static_cast<std::uint8_t>(i);
+  }
+  BOOST_TEST(IsClose(
+    hadesmem::detail::GetEntropy(all_bytes.data(), all_bytes.size()), 8.0));
+
+  BOOST_TEST(
+    IsClose(hadesmem::detail::GetEntropy(data.data(), data.size()),
+            GetEntropySimple(data.data(), data.size())));
+}
+
+void TestEntropyMap()
+{
+  auto const data = MakeTestData(0x3100);
+
+  // Non-overlapping, with a final block aligned to the end.
+  auto blocks =
+    hadesmem::detail::GetEntropyMap(data.data(), data.size(), 0x1000, 0x1000);
+  BOOST_TEST_EQ(blocks.size(), 4U);
+  BOOST_TEST_EQ(blocks[3].offset, 0x2100U);
+  BOOST_TEST_EQ(blocks[0].entropy, 0.0);
+  BOOST_TEST(blocks[2].entropy > 7.5);
+
+  // Overlapping windows are updated incrementally, so check them against
+  // recounting each one.
+  for (std::size_t const block_size : {0x100U, 0x1000U, 0x20000U})
+  {
+    blocks =
+      hadesmem::detail::GetEntropyMap(data.data(), data.size(), block_size, 48);
+    auto const expected_size = (std::min)(block_size, data.size());
+    BOOST_TEST_EQ(blocks.back().offset + blocks.back().size, data.size());
+    for (auto const& block : blocks)
+    {
+      BOOST_TEST_EQ(block.size, expected_size);
+      BOOST_TEST(IsClose(
+        block.entropy,
+        GetEntropySimple(data.data() + block.offset, block.size)));
+    }
+  }
+
+  BOOST_TEST(hadesmem::detail::GetEntropyMap(data.data(), 0, 0x100, 0x100)
+               .empty());
+}
+
+int main()
+{
+  TestByteHistogram();
+  TestEntropyMap();
+  return boost::report_errors();
+}
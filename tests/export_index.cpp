@@ -0,0 +1,221 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/export_index.hpp>
+#include <hadesmem/detail/export_index.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+struct TestExport
+{
+  int priority;
+  std::string name;
+};
+
+void WritePointer(std::vector<std::uint8_t>& buffer,
+                  std::size_t offset,
+                  std::uintptr_t value)
+{
+  std::memcpy(&buffer[offset], &value, sizeof(value));
+}
+}
+
+void TestFlatAddressMap()
+{
+  hadesmem::detail::FlatAddressMap<TestExport> map;
+  BOOST_TEST(map.empty());
+
+  // Enough keys to force the table to grow, with some sharing a VA (as
+  // forwarded exports do).
+  std::uintptr_t const kBase = 0x77000000;
+  for (std::uintptr_t i = 0; i < 1000; ++i)
+  {
+    map.Insert(kBase + i * 0x10, TestExport{0, "e" + std::to_string(i)});
+  }
+  map.Insert(kBase, TestExport{2, "forward_b"});
+  map.Insert(kBase, TestExport{1, "forward_a"});
+  map.Finalize();
+
+  BOOST_TEST_EQ(map.size(), 1000U);
+  BOOST_TEST_EQ(map.GetMinKey(), kBase);
+  BOOST_TEST_EQ(map.GetMaxKey(), kBase + 999 * 0x10);
+
+  for (std::uintptr_t i = 1; i < 1000; ++i)
+  {
+    auto const range = map.Find(kBase + i * 0x10);
+    BOOST_TEST_EQ(range.size(), 1U);
+    BOOST_TEST(!range.empty() &&
+               range.back().name == "e" + std::to_string(i));
+  }
+  BOOST_TEST(map.Find(kBase + 8).empty());
+  BOOST_TEST(map.Find(0).empty());
+  BOOST_TEST(map.Find(kBase + 1000 * 0x10).empty());
+
+  // Values for the same key keep their insertion order until sorted.
+  auto range = map.Find(kBase);
+  BOOST_TEST_EQ(range.size(), 3U);
+  BOOST_TEST(range.back().name == "forward_a");
+
+  map.SortValues([](TestExport const& lhs, TestExport const& rhs) {
+    return lhs.priority < rhs.priority;
+  });
+  range = map.Find(kBase);
+  BOOST_TEST(range.begin()->name == "e0");
+  BOOST_TEST(range.back().name == "forward_b");
+}
+
+void TestAddressSpanFilter()
+{
+  hadesmem::detail::AddressSpanFilter filter;
+  filter.Add(0x70000000, 0x70001000);
+  filter.Add(0x70000800, 0x70002000);
+  filter.Add(0x70003000, 0x70004000);
+  filter.Add(0x7F000000, 0x7F001000);
+  filter.Add(0x10, 0x10);
+  filter.Finalize();
+  BOOST_TEST_EQ(filter.size(), 3U);
+
+  BOOST_TEST(filter.Contains(0x70000000));
+  BOOST_TEST(filter.Contains(0x70001FFF));
+  BOOST_TEST(!filter.Contains(0x70002000));
+  BOOST_TEST(filter.Contains(0x70003000));
+  BOOST_TEST(!filter.Contains(0x6FFFFFFF));
+  BOOST_TEST(!filter.Contains(0x7F001000));
+  BOOST_TEST(!filter.Contains(0x10));
+  BOOST_TEST(!filter.Contains(0));
+
+  // Merging across small gaps only ever adds addresses.
+  hadesmem::detail::AddressSpanFilter merged;
+  merged.Add(0x70000000, 0x70002000);
+  merged.Add(0x70003000, 0x70004000);
+  merged.Add(0x7F000000, 0x7F001000);
+  merged.Finalize(0x1000);
+  BOOST_TEST_EQ(merged.size(), 2U);
+  BOOST_TEST(merged.Contains(0x70002000));
+  BOOST_TEST(!merged.Contains(0x70004000));
+
+  // A clear bit must mean the candidate is not in any span. A set bit may be
+  // a false positive (the prefilter only looks at the range of all spans).
+  std::vector<std::uint8_t> buffer(4 * sizeof(void*) + 16);
+  WritePointer(buffer, 0, 0x70000010);
+  WritePointer(buffer, 4 + sizeof(void*), 0x12345678);
+  WritePointer(buffer, 8 + sizeof(void*) * 2, 0x7F000FFF);
+  for (std::size_t i = 0; i + filter.kPrefilterReadSize <= buffer.size();
+       i += 4)
+  {
+    auto const mask = filter.Prefilter(&buffer[i]);
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      std::uintptr_t value = 0;
+      std::memcpy(&value, &buffer[i + j * 4], sizeof(value));
+      if (filter.Contains(value))
+      {
+        BOOST_TEST(!!(mask & (1U << j)));
+      }
+    }
+  }
+
+#if defined(HADESMEM_DETAIL_ARCH_X86)
+  WritePointer(buffer, 0, 0x70000010);
+  WritePointer(buffer, 4, 0x12345678);
+  WritePointer(buffer, 8, 0x80000000);
+  WritePointer(buffer, 12, 0x7F000FFF);
+  BOOST_TEST_EQ(filter.Prefilter(buffer.data()), 0x9U);
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X86)
+
+  hadesmem::detail::AddressSpanFilter empty;
+  empty.Finalize();
+  BOOST_TEST(!empty.Contains(0x70000000));
+  BOOST_TEST_EQ(empty.Prefilter(buffer.data()), 0U);
+}
+
+void TestImportScan()
+{
+  // A synthetic image with a handful of references to exports, scanned the
+  // same way as the dumper's import reconstruction.
+  auto const module_base = static_cast<std::uintptr_t>(
+    sizeof(void*) == 8 ? 0x7FF000000000ULL : 0x76000000ULL);
+
+  hadesmem::detail::FlatAddressMap<TestExport> map;
+  hadesmem::detail::AddressSpanFilter filter;
+  for (std::uintptr_t i = 0; i < 0x100; ++i)
+  {
+    auto const va = module_base + 0x1000 + i * 0x40;
+    map.Insert(va, TestExport{0, std::to_string(i)});
+    filter.Add(va, va + 1);
+  }
+  map.Finalize();
+  filter.Finalize(0x10000);
+  BOOST_TEST_EQ(filter.size(), 1U);
+
+  std::vector<std::uint8_t> image(0x10000);
+  for (std::size_t i = 0; i < image.size(); ++i)
+  {
+    image[i] = static_cast<std::uint8_t>(i * 7);
+  }
+  std::vector<std::size_t> const expected = {0x100, 0x108, 0x2004, 0xFFF0};
+  for (auto const offset : expected)
+  {
+    WritePointer(image, offset, module_base + 0x1000 + offset % 0x100 * 0x40);
+  }
+  // Near misses which pass the filter but not the lookup.
+  WritePointer(image, 0x3000, module_base + 0x1001);
+  WritePointer(image, 0x4000, module_base + 0x1000 + 0x100 * 0x40);
+
+  std::vector<std::size_t> found;
+  std::size_t block_beg = 0;
+  std::size_t block_end = 0;
+  std::uint32_t block_mask = 0;
+  auto const data = image.data();
+  for (auto p = data; p + sizeof(void*) <= data + image.size(); p += 4)
+  {
+    auto const pos = static_cast<std::size_t>(p - data);
+    if (pos >= block_end)
+    {
+      block_beg = pos;
+      if (pos + filter.kPrefilterReadSize <= image.size())
+      {
+        block_end = pos + 16;
+        block_mask = filter.Prefilter(p);
+      }
+      else
+      {
+        block_end = image.size();
+        block_mask = 0xFFFFFFFFUL;
+      }
+    }
+
+    std::uintptr_t va = 0;
+    std::memcpy(&va, p, sizeof(va));
+    if (!((block_mask >> ((pos - block_beg) / 4)) & 1) ||
+        !filter.Contains(va) || map.Find(va).empty())
+    {
+      continue;
+    }
+
+    found.push_back(pos);
+    p += sizeof(void*) - 4;
+  }
+
+  BOOST_TEST(found == expected);
+}
+
+int main()
+{
+  TestFlatAddressMap();
+  TestAddressSpanFilter();
+  TestImportScan();
+  return boost::report_errors();
+}
@@ -0,0 +1,228 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/hook_dispatch_table.hpp>
+#include <hadesmem/detail/hook_dispatch_table.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+// Spread out like function addresses, with the low bits in common.
+std::uintptr_t GetTestKey(std::size_t i)
+{
+  return 0x10000000 + i * 0x70;
+}
+
+std::uintptr_t GetTestValue(std::size_t i)
+{
+  return i * 3 + 1;
+}
+}
+
+void TestHookDispatchTableBasic()
+{
+  hadesmem::detail::HookDispatchTable<std::uintptr_t> table;
+  BOOST_TEST_EQ(table.GetSize(), 0UL);
+  BOOST_TEST(!table.Contains(GetTestKey(0)));
+  BOOST_TEST(!table.Erase(GetTestKey(0)));
+
+  BOOST_TEST(table.Insert(GetTestKey(0), GetTestValue(0)));
+  BOOST_TEST(!table.Insert(GetTestKey(0), GetTestValue(1)));
+  std::uintptr_t value = 0;
+  BOOST_TEST(table.Find(GetTestKey(0), value));
+  BOOST_TEST_EQ(value, GetTestValue(0));
+
+  // Enough to grow the table several times.
+  std::size_t const kNumKeys = 1000;
+  for (std::size_t i = 1; i < kNumKeys; ++i)
+  {
+    BOOST_TEST(table.Insert(GetTestKey(i), GetTestValue(i)));
+  }
+  BOOST_TEST_EQ(table.GetSize(), kNumKeys);
+
+  for (std::size_t i = 0; i < kNumKeys; ++i)
+  {
+    value = 0;
+    BOOST_TEST(table.Find(GetTestKey(i), value));
+    BOOST_TEST_EQ(value, GetTestValue(i));
+  }
+  BOOST_TEST(!table.Contains(GetTestKey(kNumKeys)));
+  BOOST_TEST(!table.Contains(GetTestKey(0) + 1));
+
+  for (std::size_t i = 0; i < kNumKeys; i += 2)
+  {
+    BOOST_TEST(table.Erase(GetTestKey(i)));
+  }
+  BOOST_TEST_EQ(table.GetSize(), kNumKeys / 2);
+  for (std::size_t i = 0; i < kNumKeys; ++i)
+  {
+    BOOST_TEST_EQ(table.Contains(GetTestKey(i)), i % 2 != 0);
+  }
+
+  // Nothing is reading, so old snapshots are freed straight away.
+  BOOST_TEST_EQ(table.GetNumRetired(), 0UL);
+}
+
+void TestHookDispatchTableConcurrent()
+{
+  hadesmem::detail::HookDispatchTable<std::uintptr_t> table;
+
+  // Readers only look for these, which are never removed, while the writer
+  // churns through other keys.
+  std::size_t const kNumStable = 64;
+  for (std::size_t i = 0; i < kNumStable; ++i)
+  {
+    table.Insert(GetTestKey(i), GetTestValue(i));
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> num_failures{0};
+  std::vector<std::thread> readers;
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    readers.emplace_back([&, t]() {
+      std::size_t i = t;
+      while (!stop.load())
+      {
+        std::size_t const key = i++ % kNumStable;
+        std::uintptr_t value = 0;
+        if (!table.Find(GetTestKey(key), value) ||
+            value != GetTestValue(key))
+        {
+          ++num_failures;
+        }
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    std::size_t const key = kNumStable + i % 100;
+    if (!table.Insert(GetTestKey(key), GetTestValue(key)))
+    {
+      table.Erase(GetTestKey(key));
+    }
+  }
+
+  stop = true;
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+
+  BOOST_TEST_EQ(num_failures.load(), 0UL);
+
+  // With the readers gone, the next write frees everything left over.
+  table.Insert(GetTestKey(0) + 1, 0);
+  BOOST_TEST_EQ(table.GetNumRetired(), 0UL);
+}
+
+// Lookup cost under concurrent readers, compared to the shared lock and
+// std::map the VEH patches used to use. Only run when asked for
+// ("--benchmark"), as the timings are meaningless in a debug build.
+template <typename FindFunc>
+double BenchmarkLookups(std::size_t num_threads,
+                        std::size_t num_keys,
+                        FindFunc find)
+{
+  std::size_t const kNumLookups = 1 << 21;
+  std::atomic<std::size_t> num_ready{0};
+  std::atomic<bool> go{false};
+  std::atomic<std::size_t> num_found{0};
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      ++num_ready;
+      while (!go.load())
+      {
+      }
+
+      std::size_t found = 0;
+      for (std::size_t i = 0; i < kNumLookups; ++i)
+      {
+        found += find(GetTestKey((i + t) % num_keys));
+      }
+      num_found += found;
+    });
+  }
+
+  while (num_ready.load() != num_threads)
+  {
+  }
+  auto const start = std::chrono::steady_clock::now();
+  go = true;
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  BOOST_TEST_EQ(num_found.load(), num_threads * kNumLookups);
+
+  // Wall time per lookup, per thread (i.e. the latency a single exception
+  // handler would see).
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(kNumLookups);
+}
+
+void BenchmarkHookDispatchTable()
+{
+  std::size_t const kNumKeys = 32;
+
+  hadesmem::detail::HookDispatchTable<std::uintptr_t> table;
+  std::shared_timed_mutex map_mutex;
+  std::map<std::uintptr_t, std::uintptr_t> map;
+  for (std::size_t i = 0; i < kNumKeys; ++i)
+  {
+    table.Insert(GetTestKey(i), GetTestValue(i));
+    map[GetTestKey(i)] = GetTestValue(i);
+  }
+
+  std::size_t const max_threads =
+    (std::max)(std::thread::hardware_concurrency(), 1U);
+  std::cout << "Threads, HookDispatchTable (ns), shared lock + map (ns)\n";
+  for (std::size_t num_threads = 1; num_threads <= max_threads;
+       num_threads *= 2)
+  {
+    double const table_ns =
+      BenchmarkLookups(num_threads, kNumKeys, [&](std::uintptr_t key) {
+        std::uintptr_t value = 0;
+        return table.Find(key, value) ? 1 : 0;
+      });
+    double const map_ns =
+      BenchmarkLookups(num_threads, kNumKeys, [&](std::uintptr_t key) {
+        std::shared_lock<std::shared_timed_mutex> const lock{map_mutex};
+        return map.find(key) != std::end(map) ? 1 : 0;
+      });
+    std::cout << num_threads << ", " << table_ns << ", " << map_ns << "\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  TestHookDispatchTableBasic();
+  TestHookDispatchTableConcurrent();
+  if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0)
+  {
+    BenchmarkHookDispatchTable();
+  }
+  return boost::report_errors();
+}
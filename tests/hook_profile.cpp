@@ -0,0 +1,191 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/hook_profile.hpp>
+#include <hadesmem/detail/hook_profile.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+void TestHookProfileBuckets()
+{
+  using hadesmem::detail::GetHookProfileBucket;
+  using hadesmem::detail::GetHookProfileBucketMin;
+  using hadesmem::detail::kHookProfileNumBuckets;
+
+  for (std::uint64_t i = 0; i < 8; ++i)
+  {
+    BOOST_TEST_EQ(GetHookProfileBucket(i), i);
+  }
+  BOOST_TEST_EQ(GetHookProfileBucket(8), 8UL);
+  BOOST_TEST_EQ(GetHookProfileBucket(9), 8UL);
+  BOOST_TEST_EQ(GetHookProfileBucket(10), 9UL);
+  BOOST_TEST_EQ(GetHookProfileBucket(16), 12UL);
+  BOOST_TEST_EQ(GetHookProfileBucket(~std::uint64_t{}),
+                kHookProfileNumBuckets - 1);
+
+  // Every bucket's minimum maps back to it, and the one before it maps to the
+  // previous bucket.
+  for (std::size_t i = 1; i < kHookProfileNumBuckets; ++i)
+  {
+    auto const min = GetHookProfileBucketMin(i);
+    BOOST_TEST_EQ(GetHookProfileBucket(min), i);
+    BOOST_TEST_EQ(GetHookProfileBucket(min - 1), i - 1);
+  }
+
+  // Log-linear, so never more than 25% wide.
+  for (std::size_t i = 8; i + 1 < kHookProfileNumBuckets; ++i)
+  {
+    auto const min = GetHookProfileBucketMin(i);
+    auto const next = GetHookProfileBucketMin(i + 1);
+    BOOST_TEST((next - min) * 4 <= min);
+  }
+}
+
+void TestHookProfileCounts()
+{
+  int target = 0;
+  hadesmem::detail::HookProfile profile{&target};
+  BOOST_TEST_EQ(profile.GetTarget(), static_cast<void const*>(&target));
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    hadesmem::detail::HookProfileScope const scope{&profile};
+  }
+
+  auto snapshot = profile.GetSnapshot();
+  BOOST_TEST_EQ(snapshot.num_calls, 100UL);
+  BOOST_TEST_EQ(snapshot.num_samples, 100UL);
+  std::uint64_t bucket_total = 0;
+  for (auto const count : snapshot.buckets)
+  {
+    bucket_total += count;
+  }
+  BOOST_TEST_EQ(bucket_total, 100UL);
+  BOOST_TEST(snapshot.GetPercentileTicks(50) <=
+             snapshot.GetPercentileTicks(99));
+
+  // Sampling only times some calls, but still counts all of them.
+  profile.Reset();
+  profile.SetSampleShift(3);
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    hadesmem::detail::HookProfileScope const scope{&profile};
+  }
+  snapshot = profile.GetSnapshot();
+  BOOST_TEST_EQ(snapshot.num_calls, 64UL);
+  BOOST_TEST_EQ(snapshot.num_samples, 8UL);
+
+  // Null profile (i.e. profiling not enabled for the hook).
+  {
+    hadesmem::detail::HookProfileScope const scope{nullptr};
+  }
+
+  // Known distribution.
+  profile.Reset();
+  profile.SetSampleShift(0);
+  for (std::uint64_t i = 0; i < 90; ++i)
+  {
+    profile.BeginCall();
+    profile.EndCall(5);
+  }
+  for (std::uint64_t i = 0; i < 10; ++i)
+  {
+    profile.BeginCall();
+    profile.EndCall(1000);
+  }
+  snapshot = profile.GetSnapshot();
+  BOOST_TEST_EQ(snapshot.total_ticks, 90UL * 5 + 10 * 1000);
+  BOOST_TEST_EQ(snapshot.GetPercentileTicks(50), 5UL);
+  BOOST_TEST_EQ(snapshot.GetPercentileTicks(89), 5UL);
+  auto const p99 = snapshot.GetPercentileTicks(99);
+  BOOST_TEST(p99 >= 1000 && p99 < 1250);
+  BOOST_TEST_EQ(snapshot.GetMeanTicks(), 104.5);
+}
+
+void TestHookProfileThreads()
+{
+  int target = 0;
+  hadesmem::detail::HookProfile profile{&target};
+
+  std::size_t const kNumThreads = 8;
+  std::size_t const kNumCalls = 10000;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&]() {
+      for (std::size_t i = 0; i < kNumCalls; ++i)
+      {
+        hadesmem::detail::HookProfileScope const scope{&profile};
+      }
+    });
+  }
+
+  // Snapshots while calls are in flight are fine, they're just not exact.
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    BOOST_TEST(profile.GetSnapshot().num_calls <= kNumThreads * kNumCalls);
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  auto const snapshot = profile.GetSnapshot();
+  BOOST_TEST_EQ(snapshot.num_calls, kNumThreads * kNumCalls);
+  BOOST_TEST_EQ(snapshot.num_samples, kNumThreads * kNumCalls);
+}
+
+void TestHookProfileRegistry()
+{
+  auto& registry = hadesmem::detail::GetHookProfileRegistry();
+  BOOST_TEST_EQ(registry.GetSnapshots().size(), 0UL);
+
+  int targets[2] = {};
+  auto first = std::make_unique<hadesmem::detail::HookProfile>(&targets[0]);
+  hadesmem::detail::HookProfile second{&targets[1]};
+  {
+    hadesmem::detail::HookProfileScope const scope{&second};
+  }
+
+  auto snapshots = registry.GetSnapshots();
+  BOOST_TEST_EQ(snapshots.size(), 2UL);
+  BOOST_TEST_EQ(snapshots[0].target, static_cast<void const*>(&targets[0]));
+  BOOST_TEST_EQ(snapshots[1].num_calls, 1UL);
+
+  std::ostringstream csv;
+  hadesmem::detail::WriteHookProfilesCsv(csv, snapshots);
+  std::string const csv_str = csv.str();
+  BOOST_TEST_EQ(csv_str.find("Target,Calls,"), 0UL);
+  BOOST_TEST_EQ(std::count(std::begin(csv_str), std::end(csv_str), '\n'), 3);
+
+  registry.Reset();
+  BOOST_TEST_EQ(second.GetSnapshot().num_calls, 0UL);
+
+  first.reset();
+  snapshots = registry.GetSnapshots();
+  BOOST_TEST_EQ(snapshots.size(), 1UL);
+  BOOST_TEST_EQ(snapshots[0].target, static_cast<void const*>(&targets[1]));
+}
+
+int main()
+{
+  TestHookProfileBuckets();
+  TestHookProfileCounts();
+  TestHookProfileThreads();
+  TestHookProfileRegistry();
+  return boost::report_errors();
+}
@@ -0,0 +1,413 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/import_index.hpp>
+#include <hadesmem/detail/import_index.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+
+namespace
+{
+struct TestImport
+{
+  std::string module;
+  // Imported by ordinal if the name is empty.
+  std::vector<std::pair<std::string, WORD>> functions;
+};
+
+// Fails reads past the given offset, and counts them.
+class FailingImageReader : public hadesmem::detail::ImageReader
+{
+public:
+  FailingImageReader(hadesmem::detail::ImageReader const& reader,
+                     std::size_t readable)
+    : reader_{&reader}, readable_{readable}
+  {
+  }
+
+  virtual bool
+    Read(std::size_t offset, void* data, std::size_t len) const override
+  {
+    ++num_reads_;
+    return offset + len <= readable_ && reader_->Read(offset, data, len);
+  }
+
+  std::size_t GetNumReads() const noexcept
+  {
+    return num_reads_;
+  }
+
+private:
+  hadesmem::detail::ImageReader const* reader_;
+  std::size_t readable_;
+  mutable std::size_t num_reads_{};
+};
+
+class TestImage
+{
+public:
+  explicit TestImage(bool is_64) : is_64_{is_64}, image_(0x200)
+  {
+  }
+
+  void Put16(std::size_t offset, WORD value)
+  {
+    Reserve(offset + sizeof(value));
+    std::memcpy(&image_[offset], &value, sizeof(value));
+  }
+
+  void Put32(std::size_t offset, DWORD value)
+  {
+    Reserve(offset + sizeof(value));
+    std::memcpy(&image_[offset], &value, sizeof(value));
+  }
+
+  void PutThunk(std::size_t offset, std::uint64_t value)
+  {
+    if (is_64_)
+    {
+      Reserve(offset + sizeof(value));
+      std::memcpy(&image_[offset], &value, sizeof(value));
+    }
+    else
+    {
+      Put32(offset, static_cast<DWORD>(value));
+    }
+  }
+
+  DWORD PutString(std::string const& str)
+  {
+    auto const offset = static_cast<DWORD>(image_.size());
+    image_.insert(std::end(image_), std::begin(str), std::end(str));
+    image_.push_back('\0');
+    return offset;
+  }
+
+  // Lays out headers, descriptors, INTs, IATs and names. Returns the RVA of
+  // each module's IAT.
+  std::vector<DWORD> Build(std::vector<TestImport> const& imports,
+                           DWORD time_stamp = 0x12345678)
+  {
+    std::size_t const kNtOffset = 0x80;
+    std::size_t const kOptOffset = kNtOffset + 24;
+    std::size_t const kImportDirOffset = 0x200;
+    std::size_t const thunk_size = is_64_ ? 8 : 4;
+
+    Put16(0, 0x5A4D);
+    Put32(0x3C, static_cast<DWORD>(kNtOffset));
+    Put32(kNtOffset, 0x00004550);
+    Put32(kNtOffset + 8, time_stamp);
+    Put16(kOptOffset, is_64_ ? 0x20B : 0x10B);
+    std::size_t const num_dirs_offset = kOptOffset + (is_64_ ? 108 : 92);
+    Put32(num_dirs_offset, 16);
+    Put32(num_dirs_offset + 4 + 8, static_cast<DWORD>(kImportDirOffset));
+
+    // Descriptors (plus a terminator), then all the thunks, then the strings.
+    std::size_t thunks = kImportDirOffset + (imports.size() + 1) * 20;
+    std::size_t thunks_end = thunks;
+    for (auto const& import : imports)
+    {
+      thunks_end += (import.functions.size() + 1) * thunk_size * 2;
+    }
+    Reserve(thunks_end);
+    std::vector<DWORD> iats;
+    for (std::size_t i = 0; i < imports.size(); ++i)
+    {
+      auto const& functions = imports[i].functions;
+      auto const num_thunks = functions.size() + 1;
+      auto const int_rva = thunks;
+      auto const iat_rva = thunks + num_thunks * thunk_size;
+      thunks = iat_rva + num_thunks * thunk_size;
+
+      std::size_t const desc = kImportDirOffset + i * 20;
+      Put32(desc, static_cast<DWORD>(int_rva));
+      Put32(desc + 12, PutString(imports[i].module));
+      Put32(desc + 16, static_cast<DWORD>(iat_rva));
+      iats.push_back(static_cast<DWORD>(iat_rva));
+
+      for (std::size_t j = 0; j < functions.size(); ++j)
+      {
+        std::uint64_t thunk;
+        if (functions[j].first.empty())
+        {
+          std::uint64_t const ordinal_flag =
+            is_64_ ? 0x8000000000000000ULL : 0x80000000ULL;
+          thunk = ordinal_flag | functions[j].second;
+        }
+        else
+        {
+          auto const hint_name = static_cast<DWORD>(image_.size());
+          image_.push_back(0);
+          image_.push_back(0);
+          PutString(functions[j].first);
+          thunk = hint_name;
+        }
+        PutThunk(int_rva + j * thunk_size, thunk);
+        // Bound (or resolved) IAT entry, which the index must ignore.
+        PutThunk(iat_rva + j * thunk_size, 0x7FFF0000 + j);
+      }
+    }
+
+    return iats;
+  }
+
+  std::uint8_t const* GetData() const noexcept
+  {
+    return image_.data();
+  }
+
+  std::uint8_t* GetData() noexcept
+  {
+    return image_.data();
+  }
+
+  std::size_t GetSize() const noexcept
+  {
+    return image_.size();
+  }
+
+  std::size_t GetThunkSize() const noexcept
+  {
+    return is_64_ ? 8 : 4;
+  }
+
+private:
+  void Reserve(std::size_t size)
+  {
+    if (image_.size() < size)
+    {
+      image_.resize(size);
+    }
+  }
+
+  bool is_64_;
+  std::vector<std::uint8_t> image_;
+};
+
+std::vector<TestImport> GetTestImports()
+{
+  return {{"kernel32.dll",
+           {{"GetLastError", 0}, {"", 42}, {"SetLastError", 0}}},
+          {"USER32.dll", {{"MessageBoxW", 0}}},
+          {"api-ms-win-core-file-l1-1-0.dll", {{"CreateFileW", 0}}},
+          {"KERNEL32.DLL", {{"GetLastError", 0}}}};
+}
+}
+
+void TestImportIndexImage(bool is_64)
+{
+  TestImage image{is_64};
+  auto const iats = image.Build(GetTestImports());
+  auto const thunk_size = image.GetThunkSize();
+
+  hadesmem::detail::ImportIndex index;
+  std::uintptr_t const base = 0x10000000;
+  index.AddImage(base, image.GetData(), image.GetSize());
+  BOOST_TEST_EQ(index.GetNumImages(), 1UL);
+  BOOST_TEST_EQ(index.GetNumImports(), 5UL);
+  BOOST_TEST(index.HasImage(base, image.GetData(), image.GetSize()));
+
+  // Duplicate import descriptors for the same module (in different cases) are
+  // both found.
+  auto const get_last_error = index.Find("Kernel32.dll", "GetLastError");
+  BOOST_TEST_EQ(get_last_error.size(), 2UL);
+  BOOST_TEST_EQ(get_last_error[0], base + iats[0]);
+  BOOST_TEST_EQ(get_last_error[1], base + iats[3]);
+
+  auto const set_last_error = index.Find("kernel32.DLL", "SetLastError");
+  BOOST_TEST_EQ(set_last_error.size(), 1UL);
+  BOOST_TEST_EQ(set_last_error[0], base + iats[0] + 2 * thunk_size);
+
+  auto const ordinal = index.Find("kernel32.dll", static_cast<WORD>(42));
+  BOOST_TEST_EQ(ordinal.size(), 1UL);
+  BOOST_TEST_EQ(ordinal[0], base + iats[0] + thunk_size);
+
+  BOOST_TEST_EQ(index.Find("user32.dll", "MessageBoxW").size(), 1UL);
+  BOOST_TEST_EQ(
+    index.Find("API-MS-WIN-CORE-FILE-L1-1-0.DLL", "CreateFileW").size(), 1UL);
+
+  // Function names are case sensitive, and only match the module they're
+  // imported from.
+  BOOST_TEST(index.Find("kernel32.dll", "getlasterror").empty());
+  BOOST_TEST(index.Find("user32.dll", "GetLastError").empty());
+  BOOST_TEST(index.Find("kernel32.dll", static_cast<WORD>(43)).empty());
+}
+
+void TestImportIndexIncremental()
+{
+  TestImage first{true};
+  first.Build(GetTestImports());
+  TestImage second{true};
+  second.Build({{"kernel32.dll", {{"GetLastError", 0}}}});
+
+  hadesmem::detail::ImportIndex index;
+  std::uintptr_t const first_base = 0x10000000;
+  std::uintptr_t const second_base = 0x20000000;
+  index.AddImage(first_base, first.GetData(), first.GetSize());
+  index.AddImage(second_base, second.GetData(), second.GetSize());
+  BOOST_TEST_EQ(index.GetNumImages(), 2UL);
+  BOOST_TEST_EQ(index.Find("kernel32.dll", "GetLastError").size(), 3UL);
+
+  // Re-adding an image replaces it rather than duplicating its slots.
+  index.AddImage(first_base, first.GetData(), first.GetSize());
+  BOOST_TEST_EQ(index.Find("kernel32.dll", "GetLastError").size(), 3UL);
+
+  BOOST_TEST(index.RemoveImage(first_base));
+  BOOST_TEST(!index.RemoveImage(first_base));
+  auto const remaining = index.Find("kernel32.dll", "GetLastError");
+  BOOST_TEST_EQ(remaining.size(), 1UL);
+  BOOST_TEST(remaining[0] >= second_base);
+  BOOST_TEST(index.Find("user32.dll", "MessageBoxW").empty());
+  BOOST_TEST_EQ(index.GetNumImports(), 1UL);
+
+  // A different image loaded at the same base is detected.
+  TestImage replacement{true};
+  replacement.Build({{"user32.dll", {{"MessageBoxW", 0}}}}, 0x87654321);
+  BOOST_TEST(
+    !index.HasImage(second_base, replacement.GetData(), replacement.GetSize()));
+  index.AddImage(second_base, replacement.GetData(), replacement.GetSize());
+  BOOST_TEST(index.Find("kernel32.dll", "GetLastError").empty());
+  BOOST_TEST_EQ(index.Find("user32.dll", "MessageBoxW").size(), 1UL);
+
+  auto const images = index.GetImages();
+  BOOST_TEST_EQ(images.size(), 1UL);
+  BOOST_TEST_EQ(images[0], second_base);
+
+  index.Clear();
+  BOOST_TEST_EQ(index.GetNumImages(), 0UL);
+  BOOST_TEST_EQ(index.GetNumImports(), 0UL);
+}
+
+void TestImportIndexEdgeCases()
+{
+  hadesmem::detail::ImportIndex index;
+
+  // No import directory.
+  TestImage no_imports{false};
+  no_imports.Build({});
+  no_imports.Put32(0x80 + 24 + 96 + 8, 0);
+  index.AddImage(0x1000, no_imports.GetData(), no_imports.GetSize());
+  BOOST_TEST_EQ(index.GetNumImages(), 1UL);
+  BOOST_TEST_EQ(index.GetNumImports(), 0UL);
+
+  // Descriptors after one with no IAT are ignored, like the loader does, and
+  // descriptors with no INT are skipped.
+  TestImage terminated{false};
+  terminated.Build({{"a.dll", {{"A", 0}}},
+                    {"b.dll", {{"B", 0}}},
+                    {"c.dll", {{"C", 0}}}});
+  terminated.Put32(0x200 + 0, 0);
+  terminated.Put32(0x200 + 20 + 16, 0);
+  index.AddImage(0x2000, terminated.GetData(), terminated.GetSize());
+  BOOST_TEST(index.Find("a.dll", "A").empty());
+  BOOST_TEST(index.Find("b.dll", "B").empty());
+  BOOST_TEST(index.Find("c.dll", "C").empty());
+}
+
+void TestImportIndexInvalid()
+{
+  hadesmem::detail::ImportIndex index;
+
+  auto const expect_throw = [&](TestImage const& image) {
+    bool thrown = false;
+    try
+    {
+      index.AddImage(0x1000, image.GetData(), image.GetSize());
+    }
+    catch (hadesmem::Error const& /*e*/)
+    {
+      thrown = true;
+    }
+    BOOST_TEST(thrown);
+  };
+
+  TestImage bad_dos{true};
+  bad_dos.Build(GetTestImports());
+  bad_dos.Put16(0, 0);
+  expect_throw(bad_dos);
+
+  TestImage bad_nt{true};
+  bad_nt.Build(GetTestImports());
+  bad_nt.Put32(0x3C, 0xFFFFFFF0);
+  expect_throw(bad_nt);
+
+  TestImage bad_magic{true};
+  bad_magic.Build(GetTestImports());
+  bad_magic.Put16(0x80 + 24, 0x107);
+  expect_throw(bad_magic);
+
+  TestImage bad_dir{true};
+  bad_dir.Build(GetTestImports());
+  bad_dir.Put32(0x80 + 24 + 112 + 8, 0x7FFFFFF0);
+  expect_throw(bad_dir);
+
+  TestImage bad_name{false};
+  bad_name.Build(GetTestImports());
+  bad_name.Put32(0x200 + 12, 0x7FFFFFF0);
+  expect_throw(bad_name);
+
+  // Name runs off the end of the image.
+  TestImage unterminated{false};
+  unterminated.Build(GetTestImports());
+  unterminated.GetData()[unterminated.GetSize() - 1] = 'X';
+  expect_throw(unterminated);
+
+  // Nothing from a failed image is left behind.
+  BOOST_TEST_EQ(index.GetNumImages(), 0UL);
+  BOOST_TEST_EQ(index.GetNumImports(), 0UL);
+}
+
+void TestImportIndexUnreadable()
+{
+  TestImage image{true};
+  image.Build(GetTestImports());
+
+  hadesmem::detail::ImportIndex index;
+  hadesmem::detail::BufferImageReader const buffer{image.GetData()};
+
+  // Like an image which is unloaded part way through being parsed.
+  FailingImageReader const headers_only{buffer, 0x200};
+  bool thrown = false;
+  try
+  {
+    index.AddImage(0x1000, headers_only, image.GetSize());
+  }
+  catch (hadesmem::Error const& /*e*/)
+  {
+    thrown = true;
+  }
+  BOOST_TEST(thrown);
+  BOOST_TEST_EQ(index.GetNumImages(), 0UL);
+  BOOST_TEST(!index.HasImage(
+    0x1000, FailingImageReader{buffer, 0}, image.GetSize()));
+
+  // Everything is read through the page cache, i.e. once per page.
+  FailingImageReader const counting{buffer, image.GetSize()};
+  index.AddImage(0x1000, counting, image.GetSize());
+  BOOST_TEST_EQ(index.GetNumImports(), 5UL);
+  // One read for the time stamp's offset and one for the time stamp itself.
+  BOOST_TEST_EQ(counting.GetNumReads(), (image.GetSize() + 0xFFF) / 0x1000 + 2);
+}
+
+int main()
+{
+  TestImportIndexImage(false);
+  TestImportIndexImage(true);
+  TestImportIndexIncremental();
+  TestImportIndexEdgeCases();
+  TestImportIndexInvalid();
+  TestImportIndexUnreadable();
+  return boost::report_errors();
+}
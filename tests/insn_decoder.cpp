@@ -0,0 +1,243 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/insn_decoder.hpp>
+#include <hadesmem/detail/insn_decoder.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+using hadesmem::detail::InsnBranch;
+using hadesmem::detail::InsnMode;
+
+struct DecodeCase
+{
+  InsnMode mode;
+  std::vector<std::uint8_t> bytes;
+  // Zero if decoding should fail.
+  std::size_t length;
+  InsnBranch branch;
+  bool rip_relative;
+  // Offset of the displacement or immediate (depending on which is
+  // relevant), or zero to skip the check.
+  std::size_t operand_offset;
+};
+
+std::vector<DecodeCase> GetDecodeCases()
+{
+  auto const x64 = InsnMode::kX64;
+  auto const x86 = InsnMode::kX86;
+  auto const none = InsnBranch::kNone;
+  return {
+    // push rbp
+    {x64, {0x55}, 1, none, false, 0},
+    // mov rbp, rsp
+    {x64, {0x48, 0x89, 0xE5}, 3, none, false, 0},
+    // sub rsp, 0x20
+    {x64, {0x48, 0x83, 0xEC, 0x20}, 4, none, false, 3},
+    // sub rsp, 0x100
+    {x64, {0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00}, 7, none, false, 3},
+    // mov rax, [rip+0x10]
+    {x64, {0x48, 0x8B, 0x05, 0x10, 0, 0, 0}, 7, none, true, 3},
+    // cmp dword ptr [rip+0x10], 5
+    {x64, {0x83, 0x3D, 0x10, 0, 0, 0, 0x05}, 7, none, true, 2},
+    // mov rax, imm64
+    {x64, {0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8}, 10, none, false, 2},
+    // mov ax, imm16
+    {x64, {0x66, 0xB8, 0x34, 0x12}, 4, none, false, 2},
+    // mov eax, imm32
+    {x64, {0xB8, 1, 2, 3, 4}, 5, none, false, 1},
+    // mov rax, [rsp+8]
+    {x64, {0x48, 0x8B, 0x44, 0x24, 0x08}, 5, none, false, 4},
+    // mov rax, [0x10] (SIB, no base)
+    {x64, {0x48, 0x8B, 0x04, 0x25, 0x10, 0, 0, 0}, 8, none, false, 4},
+    // mov eax, [rsp+0x100]
+    {x64, {0x8B, 0x84, 0x24, 0x00, 0x01, 0, 0}, 7, none, false, 3},
+    // test ecx, imm32
+    {x64, {0xF7, 0xC1, 1, 2, 3, 4}, 6, none, false, 2},
+    // not eax
+    {x64, {0xF7, 0xD0}, 2, none, false, 0},
+    // test cl, 1
+    {x64, {0xF6, 0xC1, 0x01}, 3, none, false, 2},
+    // enter 0x10, 0
+    {x64, {0xC8, 0x10, 0x00, 0x00}, 4, none, false, 1},
+    // ret 8
+    {x64, {0xC2, 0x08, 0x00}, 3, none, false, 1},
+    // je short
+    {x64, {0x74, 0x05}, 2, InsnBranch::kJcc, false, 1},
+    // je near
+    {x64, {0x0F, 0x84, 1, 2, 3, 4}, 6, InsnBranch::kJcc, false, 2},
+    // call rel32
+    {x64, {0xE8, 1, 2, 3, 4}, 5, InsnBranch::kCall, false, 1},
+    // jmp rel32
+    {x64, {0xE9, 1, 2, 3, 4}, 5, InsnBranch::kJmp, false, 1},
+    // jmp short
+    {x64, {0xEB, 0x10}, 2, InsnBranch::kJmp, false, 1},
+    // jrcxz
+    {x64, {0xE3, 0x05}, 2, InsnBranch::kLoop, false, 1},
+    // jecxz
+    {x64, {0x67, 0xE3, 0x05}, 3, InsnBranch::kLoop, false, 2},
+    // loop
+    {x64, {0xE2, 0xFC}, 2, InsnBranch::kLoop, false, 1},
+    // jmp qword ptr [rip+0x10]
+    {x64, {0xFF, 0x25, 0x10, 0, 0, 0}, 6, none, true, 2},
+    // call qword ptr [rip+0x10]
+    {x64, {0xFF, 0x15, 0x10, 0, 0, 0}, 6, none, true, 2},
+    // nop dword ptr [rax+rax]
+    {x64, {0x0F, 0x1F, 0x44, 0x00, 0x00}, 5, none, false, 4},
+    // nop word ptr [rax+rax+0]
+    {x64, {0x66, 0x0F, 0x1F, 0x84, 0, 0, 0, 0, 0}, 9, none, false, 5},
+    // pshufb mm0, mm1
+    {x64, {0x0F, 0x38, 0x00, 0xC1}, 4, none, false, 0},
+    // palignr xmm0, xmm1, 8
+    {x64, {0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08}, 6, none, false, 5},
+    // vzeroupper
+    {x64, {0xC5, 0xF8, 0x77}, 3, none, false, 0},
+    // vmovaps ymm0, ymm1
+    {x64, {0xC5, 0xFC, 0x28, 0xC1}, 4, none, false, 0},
+    // vinsertf128 ymm0, ymm0, xmm1, 1
+    {x64, {0xC4, 0xE3, 0x7D, 0x18, 0xC1, 0x01}, 6, none, false, 5},
+    // vbroadcastss ymm0, [rip+0x10]
+    {x64, {0xC4, 0xE2, 0x7D, 0x18, 0x05, 0x10, 0, 0, 0}, 9, none, true, 5},
+    // mov eax, [moffs64]
+    {x64, {0xA1, 1, 2, 3, 4, 5, 6, 7, 8}, 9, none, false, 1},
+    // mov rax, gs:[0x30]
+    {x64, {0x65, 0x48, 0x8B, 0x04, 0x25, 0x30, 0, 0, 0}, 9, none, false, 5},
+    // rep stosq
+    {x64, {0xF3, 0x48, 0xAB}, 3, none, false, 0},
+    // xbegin
+    {x64, {0xC7, 0xF8, 1, 2, 3, 4}, 6, InsnBranch::kUnsupported, false, 2},
+    // syscall
+    {x64, {0x0F, 0x05}, 2, none, false, 0},
+    // int 3
+    {x64, {0xCC}, 1, none, false, 0},
+    // fldz
+    {x64, {0xD9, 0xEE}, 2, none, false, 0},
+    // lock cmpxchg [rdx], ecx
+    {x64, {0xF0, 0x0F, 0xB1, 0x0A}, 4, none, false, 0},
+    // imul eax, eax, 5
+    {x64, {0x6B, 0xC0, 0x05}, 3, none, false, 2},
+    // imul eax, eax, imm32
+    {x64, {0x69, 0xC0, 1, 2, 3, 4}, 6, none, false, 2},
+    // bt eax, 5
+    {x64, {0x0F, 0xBA, 0xE0, 0x05}, 4, none, false, 3},
+    // push es (invalid in long mode)
+    {x64, {0x06}, 0, none, false, 0},
+    // EVEX
+    {x64, {0x62, 0xF1, 0x7C, 0x48, 0x28, 0xC1}, 0, none, false, 0},
+    // pop qword [rax]
+    {x64, {0x8F, 0x00}, 2, none, false, 0},
+    // XOP vprotb xmm0, xmm1, 1
+    {x64, {0x8F, 0xE8, 0x78, 0xC0, 0xC1, 0x01}, 0, none, false, 0},
+    // Truncated.
+    {x64, {0x48, 0x8B}, 0, none, false, 0},
+    {x64, {0x48, 0x8B, 0x05, 0x10, 0}, 0, none, false, 0},
+    // mov eax, imm32
+    {x86, {0xB8, 1, 2, 3, 4}, 5, none, false, 1},
+    // mov ax, imm16
+    {x86, {0x66, 0xB8, 0x34, 0x12}, 4, none, false, 2},
+    // mov eax, [moffs32]
+    {x86, {0xA1, 1, 2, 3, 4}, 5, none, false, 1},
+    // mov eax, [moffs16]
+    {x86, {0x67, 0xA1, 1, 2}, 4, none, false, 2},
+    // mov eax, [0x10] (absolute, not RIP-relative)
+    {x86, {0x8B, 0x05, 0x10, 0, 0, 0}, 6, none, false, 2},
+    // mov eax, [bp+8]
+    {x86, {0x67, 0x8B, 0x46, 0x08}, 4, none, false, 3},
+    // mov eax, [0x1234]
+    {x86, {0x67, 0x8B, 0x06, 0x34, 0x12}, 5, none, false, 3},
+    // les eax, [esi]
+    {x86, {0xC4, 0x06}, 2, none, false, 0},
+    // vzeroupper
+    {x86, {0xC5, 0xF8, 0x77}, 3, none, false, 0},
+    // inc eax
+    {x86, {0x40}, 1, none, false, 0},
+    // call far ptr16:32
+    {x86, {0x9A, 1, 2, 3, 4, 5, 6}, 7, none, false, 1},
+    // jmp rel16
+    {x86, {0x66, 0xE9, 1, 2}, 4, InsnBranch::kUnsupported, false, 2},
+    // push es
+    {x86, {0x06}, 1, none, false, 0},
+  };
+}
+}
+
+void TestDecodeInsn()
+{
+  auto const cases = GetDecodeCases();
+  for (std::size_t i = 0; i < cases.size(); ++i)
+  {
+    auto const& c = cases[i];
+    hadesmem::detail::InsnInfo info;
+    bool const decoded = hadesmem::detail::DecodeInsn(
+      c.bytes.data(), c.bytes.size(), c.mode, info);
+    BOOST_TEST_EQ(decoded, c.length != 0);
+    if (!decoded || !c.length)
+    {
+      continue;
+    }
+
+    BOOST_TEST_EQ(info.length, c.length);
+    BOOST_TEST(info.branch == c.branch);
+    BOOST_TEST_EQ(info.rip_relative, c.rip_relative);
+    if (c.operand_offset)
+    {
+      BOOST_TEST(info.disp_offset == c.operand_offset ||
+                 info.imm_offset == c.operand_offset);
+    }
+  }
+}
+
+void TestDecodeInsnFields()
+{
+  // cmp dword ptr [rip+0x10], 5. The displacement is relative to the end of
+  // the instruction, which is after the immediate.
+  std::uint8_t const cmp[] = {0x83, 0x3D, 0x10, 0, 0, 0, 0x05};
+  hadesmem::detail::InsnInfo info;
+  BOOST_TEST(hadesmem::detail::DecodeInsn(
+    cmp, sizeof(cmp), hadesmem::detail::InsnMode::kX64, info));
+  BOOST_TEST_EQ(info.opcode, 0x83);
+  BOOST_TEST(info.has_modrm);
+  BOOST_TEST_EQ(info.modrm, 0x3D);
+  BOOST_TEST_EQ(info.disp_offset, 2);
+  BOOST_TEST_EQ(info.disp_size, 4);
+  BOOST_TEST_EQ(info.imm_offset, 6);
+  BOOST_TEST_EQ(info.imm_size, 1);
+
+  // jne near, with a branch hint prefix.
+  std::uint8_t const jne[] = {0x3E, 0x0F, 0x85, 1, 2, 3, 4};
+  BOOST_TEST(hadesmem::detail::DecodeInsn(
+    jne, sizeof(jne), hadesmem::detail::InsnMode::kX86, info));
+  BOOST_TEST(info.map == hadesmem::detail::InsnMap::k0F);
+  BOOST_TEST_EQ(info.opcode_offset, 2);
+  BOOST_TEST_EQ(info.condition, 5);
+  BOOST_TEST_EQ(info.imm_offset, 3);
+  BOOST_TEST_EQ(info.imm_size, 4);
+
+  // Only looks at the first instruction, and never past the maximum length.
+  std::uint8_t const nops[] = {0x90, 0x90, 0x90};
+  BOOST_TEST(hadesmem::detail::DecodeInsn(
+    nops, sizeof(nops), hadesmem::detail::InsnMode::kX64, info));
+  BOOST_TEST_EQ(info.length, 1);
+  std::uint8_t const prefixes[20] = {0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+                                     0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+                                     0x66, 0x66, 0x66, 0x66, 0x66, 0x90};
+  BOOST_TEST(!hadesmem::detail::DecodeInsn(
+    prefixes, sizeof(prefixes), hadesmem::detail::InsnMode::kX64, info));
+}
+
+int main()
+{
+  TestDecodeInsn();
+  TestDecodeInsnFields();
+  return boost::report_errors();
+}
@@ -0,0 +1,511 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/insn_relocator.hpp>
+#include <hadesmem/detail/insn_relocator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <windows.h>
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <sys/mman.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+namespace
+{
+using hadesmem::detail::InsnMode;
+
+// A small x64 function (no arguments, result in EAX, only touches volatile
+// registers) with something in its prologue which has to be rewritten.
+struct RelocateCase
+{
+  char const* name;
+  std::vector<std::uint8_t> code;
+  std::size_t min_size;
+  std::uint32_t expected;
+  // Reads data relative to RIP, so can't be moved out of rel32 range.
+  bool rip_data;
+  // If non-zero, the absolute address of code + abs_target is written to
+  // code + abs_offset (for indirect branches through memory).
+  std::size_t abs_offset;
+  std::size_t abs_target;
+};
+
+std::vector<RelocateCase> GetRelocateCases()
+{
+  return {
+    // push rbx; mov ebx, 5; mov eax, ebx; pop rbx; ret
+    {"plain",
+     {0x53, 0xBB, 0x05, 0, 0, 0, 0x89, 0xD8, 0x5B, 0xC3},
+     5,
+     5,
+     false,
+     0,
+     0},
+    // push rbp; mov rbp, rsp; sub rsp, 0x20; mov eax, 42; add rsp, 0x20;
+    // pop rbp; ret
+    {"frame",
+     {0x55, 0x48, 0x89, 0xE5, 0x48, 0x83, 0xEC, 0x20, 0xB8, 0x2A,
+      0,    0,    0,    0x48, 0x83, 0xC4, 0x20, 0x5D, 0xC3},
+     5,
+     42,
+     false,
+     0,
+     0},
+    // lea rax, [rip+data]; mov eax, [rax]; ret; data
+    {"lea_rip",
+     {0x48, 0x8D, 0x05, 0x03, 0, 0, 0, 0x8B, 0x00, 0xC3, 0x44, 0x33, 0x22,
+      0x11},
+     5,
+     0x11223344,
+     true,
+     0,
+     0},
+    // mov eax, [rip+data]; ret; data
+    {"mov_rip",
+     {0x8B, 0x05, 0x01, 0, 0, 0, 0xC3, 0x88, 0x77, 0x66, 0x55},
+     5,
+     0x55667788,
+     true,
+     0,
+     0},
+    // cmp dword ptr [rip+data], 5; je +6; mov eax, 1; ret; mov eax, 2; ret;
+    // data
+    {"cmp_rip_imm",
+     {0x83, 0x3D, 0x0E, 0, 0, 0, 0x05, 0x74, 0x06, 0xB8, 0x01, 0, 0, 0, 0xC3,
+      0xB8, 0x02, 0, 0, 0, 0xC3, 0x05, 0, 0, 0},
+     8,
+     2,
+     true,
+     0,
+     0},
+    // xor eax, eax; je +6; mov eax, 1; ret; mov eax, 3; ret
+    {"jcc_rel8",
+     {0x31, 0xC0, 0x74, 0x06, 0xB8, 0x01, 0, 0, 0, 0xC3, 0xB8, 0x03, 0, 0, 0,
+      0xC3},
+     4,
+     3,
+     false,
+     0,
+     0},
+    // mov eax, 1; test eax, eax; je +6; add eax, 10; ret; int3; int3;
+    // mov eax, 99; ret
+    {"jcc_rel8_not_taken",
+     {0xB8, 0x01, 0, 0, 0, 0x85, 0xC0, 0x74, 0x06, 0x83, 0xC0, 0x0A, 0xC3,
+      0xCC, 0xCC, 0xB8, 0x63, 0, 0, 0, 0xC3},
+     9,
+     11,
+     false,
+     0,
+     0},
+    // xor eax, eax; je near +6; mov eax, 1; ret; mov eax, 4; ret
+    {"jcc_rel32",
+     {0x31, 0xC0, 0x0F, 0x84, 0x06, 0, 0, 0, 0xB8, 0x01, 0, 0, 0, 0xC3,
+      0xB8, 0x04, 0, 0, 0, 0xC3},
+     5,
+     4,
+     false,
+     0,
+     0},
+    // xor eax, eax; je +2; inc eax; add eax, 10; ret
+    {"jcc_internal",
+     {0x31, 0xC0, 0x74, 0x02, 0xFF, 0xC0, 0x83, 0xC0, 0x0A, 0xC3},
+     9,
+     10,
+     false,
+     0,
+     0},
+    // jmp short +6; mov eax, 1; ret; mov eax, 4; ret
+    {"jmp_rel8",
+     {0xEB, 0x06, 0xB8, 0x01, 0, 0, 0, 0xC3, 0xB8, 0x04, 0, 0, 0, 0xC3},
+     2,
+     4,
+     false,
+     0,
+     0},
+    // jmp +6; mov eax, 1; ret; mov eax, 6; ret
+    {"jmp_rel32",
+     {0xE9, 0x06, 0, 0, 0, 0xB8, 0x01, 0, 0, 0, 0xC3, 0xB8, 0x06, 0, 0, 0,
+      0xC3},
+     5,
+     6,
+     false,
+     0,
+     0},
+    // call +7; add eax, 1; ret; int3 x3; mov eax, 7; ret
+    {"call_rel32",
+     {0xE8, 0x07, 0, 0, 0, 0x83, 0xC0, 0x01, 0xC3, 0xCC, 0xCC, 0xCC, 0xB8,
+      0x07, 0, 0, 0, 0xC3},
+     5,
+     8,
+     false,
+     0,
+     0},
+    // xor eax, eax; mov ecx, 5; inc eax; loop -4; ret
+    {"loop_internal",
+     {0x31, 0xC0, 0xB9, 0x05, 0, 0, 0, 0xFF, 0xC0, 0xE2, 0xFC, 0xC3},
+     11,
+     5,
+     false,
+     0,
+     0},
+    // xor ecx, ecx; jrcxz +6; mov eax, 1; ret; mov eax, 2; ret
+    {"jrcxz",
+     {0x31, 0xC9, 0xE3, 0x06, 0xB8, 0x01, 0, 0, 0, 0xC3, 0xB8, 0x02, 0, 0, 0,
+      0xC3},
+     4,
+     2,
+     false,
+     0,
+     0},
+    // xor ecx, ecx; jecxz +6; mov eax, 1; ret; mov eax, 3; ret
+    {"jecxz",
+     {0x31, 0xC9, 0x67, 0xE3, 0x06, 0xB8, 0x01, 0, 0, 0, 0xC3, 0xB8, 0x03, 0,
+      0, 0, 0xC3},
+     5,
+     3,
+     false,
+     0,
+     0},
+    // call [rip+2]; jmp short +8; dq helper; ret; helper: mov eax, 11; ret
+    {"call_rip",
+     {0xFF, 0x15, 0x02, 0, 0, 0, 0xEB, 0x08, 0, 0, 0, 0, 0, 0, 0, 0, 0xC3,
+      0xB8, 0x0B, 0, 0, 0, 0xC3},
+     6,
+     11,
+     true,
+     8,
+     17},
+    // jmp [rip+0]; dq target; target: mov eax, 12; ret
+    {"jmp_rip",
+     {0xFF, 0x25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xB8, 0x0C, 0, 0, 0,
+      0xC3},
+     6,
+     12,
+     true,
+     6,
+     14},
+  };
+}
+
+std::size_t const kRegionSize = 0x10000;
+std::size_t const kSourceOffset = 0x100;
+std::size_t const kNearDestOffset = 0x8000;
+
+std::uint8_t* AllocateExecutable(void* hint)
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  auto const region = static_cast<std::uint8_t*>(::VirtualAlloc(
+    hint, kRegionSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+  if (!region && hint)
+  {
+    return AllocateExecutable(nullptr);
+  }
+  return region;
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  void* const region = ::mmap(hint,
+                              kRegionSize,
+                              PROT_READ | PROT_WRITE | PROT_EXEC,
+                              MAP_PRIVATE | MAP_ANONYMOUS,
+                              -1,
+                              0);
+  return region == MAP_FAILED ? nullptr : static_cast<std::uint8_t*>(region);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+
+void FreeExecutable(std::uint8_t* region)
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  ::VirtualFree(region, 0, MEM_RELEASE);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  ::munmap(region, kRegionSize);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+
+void WriteCase(RelocateCase const& c, std::uint8_t* source)
+{
+  std::memcpy(source, c.code.data(), c.code.size());
+  if (c.abs_offset)
+  {
+    std::uint64_t const target =
+      reinterpret_cast<std::uintptr_t>(source + c.abs_target);
+    std::memcpy(source + c.abs_offset, &target, sizeof(target));
+  }
+}
+
+std::uint64_t ReadPointer(std::uint64_t address)
+{
+  std::uint64_t value = 0;
+  std::memcpy(&value,
+              reinterpret_cast<void const*>(
+                static_cast<std::uintptr_t>(address)),
+              sizeof(value));
+  return value;
+}
+
+std::uint32_t Execute(void* code)
+{
+  using CodeFn = std::uint32_t (*)();
+  return reinterpret_cast<CodeFn>(code)();
+}
+
+// Relocates the prologue, overwrites it with INT3 (so anything which still
+// depends on the original bytes crashes), then runs the trampoline.
+void RunRelocateCase(
+  RelocateCase const& c,
+  std::uint8_t* source,
+  std::uint8_t* dest,
+  hadesmem::detail::insn_relocator::PointerReader const& read_pointer =
+    nullptr)
+{
+  WriteCase(c, source);
+  BOOST_TEST_EQ(Execute(source), c.expected);
+
+  auto const relocated = hadesmem::detail::RelocateCode(
+    source,
+    c.code.size(),
+    reinterpret_cast<std::uintptr_t>(source),
+    reinterpret_cast<std::uintptr_t>(dest),
+    c.min_size,
+    InsnMode::kX64,
+    read_pointer);
+  BOOST_TEST(relocated.source_size >= c.min_size);
+  BOOST_TEST_EQ(relocated.ip_map.GetSize() != 0, true);
+  std::size_t dest_offset = 1;
+  BOOST_TEST(relocated.ip_map.Remap(0, dest_offset));
+  BOOST_TEST_EQ(dest_offset, 0UL);
+
+  std::memcpy(dest, relocated.code.data(), relocated.code.size());
+  std::memset(source, 0xCC, relocated.source_size);
+
+  std::uint32_t const result = Execute(dest);
+  BOOST_TEST_EQ(result, c.expected);
+  if (result != c.expected)
+  {
+    BOOST_ERROR(c.name);
+  }
+}
+}
+
+void TestRelocateExecute()
+{
+#if defined(HADESMEM_DETAIL_ARCH_X64)
+  std::uint8_t* const region = AllocateExecutable(nullptr);
+  BOOST_TEST(region != nullptr);
+  if (!region)
+  {
+    return;
+  }
+
+  // Try to get somewhere out of rel32 range too, to test the absolute forms.
+  // Not guaranteed, so skip that part if it doesn't work out.
+  std::uint8_t* far_region = AllocateExecutable(region + 0x200000000ULL);
+  if (far_region &&
+      hadesmem::detail::insn_relocator::FitsRel32(
+        static_cast<std::int64_t>(far_region - region)))
+  {
+    FreeExecutable(far_region);
+    far_region = nullptr;
+  }
+
+  std::uint8_t* const source = region + kSourceOffset;
+  for (auto const& c : GetRelocateCases())
+  {
+    RunRelocateCase(c, source, region + kNearDestOffset);
+
+    if (!far_region)
+    {
+      continue;
+    }
+
+    if (c.rip_data)
+    {
+      WriteCase(c, source);
+      BOOST_TEST_THROWS(
+        hadesmem::detail::RelocateCode(
+          source,
+          c.code.size(),
+          reinterpret_cast<std::uintptr_t>(source),
+          reinterpret_cast<std::uintptr_t>(far_region),
+          c.min_size,
+          InsnMode::kX64),
+        hadesmem::Error);
+    }
+    else
+    {
+      RunRelocateCase(c, source, far_region);
+    }
+
+    // Branches through a pointer can be resolved instead.
+    if (c.abs_offset)
+    {
+      RunRelocateCase(c, source, far_region, &ReadPointer);
+    }
+  }
+
+  if (far_region)
+  {
+    FreeExecutable(far_region);
+  }
+  FreeExecutable(region);
+#endif // #if defined(HADESMEM_DETAIL_ARCH_X64)
+}
+
+void TestRelocateEncoding()
+{
+  using hadesmem::detail::RelocateCode;
+
+  // jmp short +6 moved out of rel32 range becomes an absolute jump, followed
+  // by the jump back (also absolute).
+  std::uint8_t const jmp_short[] = {0xEB, 0x06};
+  auto const far_jmp = RelocateCode(
+    jmp_short, sizeof(jmp_short), 0x10000000, 0x7FF000000000ULL, 2,
+    InsnMode::kX64);
+  std::vector<std::uint8_t> const far_jmp_expected = {
+    0xFF, 0x25, 0, 0, 0, 0, 0x08, 0, 0, 0x10, 0, 0, 0, 0,
+    0xFF, 0x25, 0, 0, 0, 0, 0x02, 0, 0, 0x10, 0, 0, 0, 0};
+  BOOST_TEST(far_jmp.code == far_jmp_expected);
+  BOOST_TEST_EQ(far_jmp.source_size, 2UL);
+
+  // Far Jcc is an inverted short Jcc over an absolute jump.
+  std::uint8_t const jne_short[] = {0x75, 0x10};
+  auto const far_jcc = RelocateCode(
+    jne_short, sizeof(jne_short), 0x10000000, 0x7FF000000000ULL, 2,
+    InsnMode::kX64);
+  BOOST_TEST_EQ(far_jcc.code.size(), 16UL + 14UL);
+  BOOST_TEST_EQ(far_jcc.code[0], 0x74);
+  BOOST_TEST_EQ(far_jcc.code[1], 14);
+  BOOST_TEST_EQ(far_jcc.code[2], 0xFF);
+  BOOST_TEST_EQ(far_jcc.code[3], 0x25);
+
+  // Target just out of range from the end of a rel32 Jcc, but in range from
+  // the end of the short Jcc. Still has to be the absolute form the skip
+  // expects.
+  std::uint64_t const edge_source = 0x100000000000ULL;
+  std::uint64_t const edge_dest = edge_source + 2 + 0x10 - 6 - 0x80000000ULL;
+  auto const edge_jcc = RelocateCode(
+    jne_short, sizeof(jne_short), edge_source, edge_dest, 2, InsnMode::kX64);
+  BOOST_TEST_EQ(edge_jcc.code.size(), 16UL + 5UL);
+  BOOST_TEST_EQ(edge_jcc.code[1], 14);
+  BOOST_TEST_EQ(edge_jcc.code[2], 0xFF);
+  BOOST_TEST_EQ(edge_jcc.code[3], 0x25);
+  std::uint64_t edge_target = 0;
+  std::memcpy(&edge_target, &edge_jcc.code[8], sizeof(edge_target));
+  BOOST_TEST_EQ(edge_target, edge_source + 2 + 0x10);
+  BOOST_TEST_EQ(edge_jcc.code[16], 0xE9);
+
+  // jmp [rip+0x100] (e.g. a hook chain) moved out of range of its pointer is
+  // resolved to an absolute jump to the pointer's value, and can't be moved
+  // without a way to read it.
+  std::uint8_t const jmp_rip[] = {0xFF, 0x25, 0x00, 0x01, 0, 0};
+  std::uint64_t const jmp_rip_target = 0x20000000;
+  auto const read_pointer = [&](std::uint64_t address) {
+    BOOST_TEST_EQ(address, 0x10000000ULL + 6 + 0x100);
+    return jmp_rip_target;
+  };
+  auto const far_jmp_rip = RelocateCode(jmp_rip,
+                                        sizeof(jmp_rip),
+                                        0x10000000,
+                                        0x7FF000000000ULL,
+                                        6,
+                                        InsnMode::kX64,
+                                        read_pointer);
+  BOOST_TEST_EQ(far_jmp_rip.source_size, 6UL);
+  BOOST_TEST_EQ(far_jmp_rip.code.size(), 14UL + 14UL);
+  std::uint64_t resolved = 0;
+  std::memcpy(&resolved, &far_jmp_rip.code[6], sizeof(resolved));
+  BOOST_TEST_EQ(resolved, jmp_rip_target);
+  BOOST_TEST_THROWS(RelocateCode(jmp_rip,
+                                 sizeof(jmp_rip),
+                                 0x10000000,
+                                 0x7FF000000000ULL,
+                                 6,
+                                 InsnMode::kX64),
+                    hadesmem::Error);
+
+  // In range, the pointer is still read live through an adjusted
+  // displacement.
+  auto const near_jmp_rip = RelocateCode(jmp_rip,
+                                         sizeof(jmp_rip),
+                                         0x10000000,
+                                         0x10001000,
+                                         6,
+                                         InsnMode::kX64,
+                                         read_pointer);
+  BOOST_TEST_EQ(near_jmp_rip.code[0], 0xFF);
+  BOOST_TEST_EQ(near_jmp_rip.code[1], 0x25);
+  std::int32_t disp = 0;
+  std::memcpy(&disp, &near_jmp_rip.code[2], sizeof(disp));
+  BOOST_TEST_EQ(0x10001000 + 6 + disp, 0x10000000 + 6 + 0x100);
+
+  // Outside of long mode everything is in range of a rel32, and addresses
+  // wrap at 4GB.
+  std::uint8_t const x86_prologue[] = {
+    0x8B, 0xFF, 0x55, 0x8B, 0xEC, 0x74, 0x10, 0x90};
+  auto const x86 = RelocateCode(
+    x86_prologue, sizeof(x86_prologue), 0x00401000, 0xFFFF0000, 6,
+    InsnMode::kX86);
+  BOOST_TEST_EQ(x86.source_size, 7UL);
+  BOOST_TEST_EQ(x86.code.size(), 5UL + 6UL + 5UL);
+  std::vector<std::uint8_t> const x86_expected_head = {
+    0x8B, 0xFF, 0x55, 0x8B, 0xEC, 0x0F, 0x84};
+  BOOST_TEST(std::equal(std::begin(x86_expected_head),
+                        std::end(x86_expected_head),
+                        std::begin(x86.code)));
+  std::uint32_t jcc_rel = 0;
+  std::memcpy(&jcc_rel, &x86.code[7], sizeof(jcc_rel));
+  BOOST_TEST_EQ(static_cast<std::uint32_t>(0xFFFF0000 + 11 + jcc_rel),
+                0x00401000UL + 7 + 0x10);
+  std::size_t dest_offset = 0;
+  BOOST_TEST(x86.ip_map.Remap(5, dest_offset));
+  BOOST_TEST_EQ(dest_offset, 5UL);
+  BOOST_TEST(!x86.ip_map.Remap(6, dest_offset));
+
+  // Branch into the middle of a relocated instruction.
+  std::uint8_t const jmp_self[] = {0xEB, 0xFF};
+  BOOST_TEST_THROWS(RelocateCode(jmp_self,
+                                 sizeof(jmp_self),
+                                 0x10000000,
+                                 0x10001000,
+                                 2,
+                                 InsnMode::kX64),
+                    hadesmem::Error);
+
+  // XBEGIN.
+  std::uint8_t const xbegin[] = {0xC7, 0xF8, 0, 0, 0, 0};
+  BOOST_TEST_THROWS(RelocateCode(xbegin,
+                                 sizeof(xbegin),
+                                 0x10000000,
+                                 0x10001000,
+                                 5,
+                                 InsnMode::kX64),
+                    hadesmem::Error);
+
+  // Runs out of bytes.
+  std::uint8_t const truncated[] = {0x90, 0x48};
+  BOOST_TEST_THROWS(RelocateCode(truncated,
+                                 sizeof(truncated),
+                                 0x10000000,
+                                 0x10001000,
+                                 5,
+                                 InsnMode::kX64),
+                    hadesmem::Error);
+}
+
+int main()
+{
+  TestRelocateExecute();
+  TestRelocateEncoding();
+  return boost::report_errors();
+}
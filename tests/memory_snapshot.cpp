@@ -0,0 +1,191 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/memory_snapshot.hpp>
+#include <hadesmem/memory_snapshot.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/scanner.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <windows.h>
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+namespace
+{
+wchar_t const* const kSnapshotPath = L"hadesmem_memory_snapshot_test.bin";
+char const* const kSnapshotPathNarrow = "hadesmem_memory_snapshot_test.bin";
+}
+
+void TestMemorySnapshot()
+{
+  std::vector<std::uint8_t> heap(0x5000);
+  std::vector<std::uint8_t> code(0x1800, 0xCC);
+  std::uint32_t const value = 0xDEADBEEF;
+  std::memcpy(&heap[0x10], &value, sizeof(value));
+  std::memcpy(&heap[0x4FFC], &value, sizeof(value));
+
+  hadesmem::BufferScanSource source;
+  source.AddBuffer(0x10000000, heap.data(), heap.size());
+  source.AddBuffer(0x400000, code.data(), code.size(), PAGE_EXECUTE_READ);
+
+  {
+    hadesmem::MemorySnapshotOptions options;
+    options.buffer_size = 0x2000;
+    options.num_threads = 2;
+    hadesmem::MemorySnapshot snapshot(source, kSnapshotPath, options);
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 2U);
+    BOOST_TEST_EQ(snapshot.GetRegionTable()[0].base, 0x400000U);
+
+    auto captured = static_cast<std::uint8_t const*>(
+      snapshot.GetData(0x10000000, heap.size()));
+    BOOST_TEST(captured != nullptr);
+    BOOST_TEST(captured && std::equal(heap.begin(), heap.end(), captured));
+    BOOST_TEST(snapshot.GetData(0x10000000, heap.size() + 1) == nullptr);
+    BOOST_TEST(snapshot.GetData(0x401800, 1) == nullptr);
+
+    std::uint8_t byte = 0;
+    BOOST_TEST(snapshot.Read(0x4017FF, &byte, 1));
+    BOOST_TEST_EQ(byte, 0xCC);
+
+    // Scans run against the frozen copy, not the live buffers.
+    heap[0x10] = 0;
+    hadesmem::Scanner<std::uint32_t> scanner(snapshot);
+    scanner.First(hadesmem::ScanFilter::kEqual, value);
+    BOOST_TEST_EQ(scanner.GetCount(), 2U);
+
+    // Only the page which changed is written.
+    BOOST_TEST_EQ(snapshot.Update(source), 1U);
+    BOOST_TEST_EQ(snapshot.Update(source), 0U);
+    scanner.First(hadesmem::ScanFilter::kEqual, value);
+    BOOST_TEST_EQ(scanner.GetCount(), 1U);
+
+    // A change in layout keeps the data of the regions which are still
+    // there, so only new non-zero pages are written.
+    std::vector<std::uint8_t> zero(0x3000);
+    source.AddBuffer(0x20000000, zero.data(), zero.size());
+    BOOST_TEST_EQ(snapshot.Update(source), 0U);
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 3U);
+
+    // Moves the heap and the zero region further into the file.
+    std::vector<std::uint8_t> data(0x2000, 0x11);
+    source.AddBuffer(0x500000, data.data(), data.size());
+    BOOST_TEST_EQ(snapshot.Update(source), 2U);
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 4U);
+    BOOST_TEST_EQ(snapshot.GetRegionTable()[1].base, 0x500000U);
+    captured = static_cast<std::uint8_t const*>(
+      snapshot.GetData(0x10000000, heap.size()));
+    BOOST_TEST(captured && std::equal(heap.begin(), heap.end(), captured));
+    scanner.First(hadesmem::ScanFilter::kEqual, value);
+    BOOST_TEST_EQ(scanner.GetCount(), 1U);
+    BOOST_TEST_EQ(snapshot.Update(source), 0U);
+
+    // Moves them back again.
+    hadesmem::BufferScanSource smaller;
+    smaller.AddBuffer(0x10000000, heap.data(), heap.size());
+    smaller.AddBuffer(0x400000, code.data(), code.size(), PAGE_EXECUTE_READ);
+    smaller.AddBuffer(0x20000000, zero.data(), zero.size());
+    BOOST_TEST_EQ(snapshot.Update(smaller), 0U);
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 3U);
+    captured = static_cast<std::uint8_t const*>(
+      snapshot.GetData(0x10000000, heap.size()));
+    BOOST_TEST(captured && std::equal(heap.begin(), heap.end(), captured));
+    BOOST_TEST_EQ(snapshot.Update(source), 2U);
+  }
+
+  {
+    hadesmem::MemorySnapshot const snapshot(kSnapshotPath);
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 4U);
+    auto const captured = static_cast<std::uint8_t const*>(
+      snapshot.GetData(0x10000000, heap.size()));
+    BOOST_TEST(captured && std::equal(heap.begin(), heap.end(), captured));
+
+    hadesmem::RegionSnapshot regions;
+    snapshot.GetRegions(regions);
+    BOOST_TEST_EQ(regions.size(), 4U);
+    BOOST_TEST_EQ(regions[0].protect, static_cast<DWORD>(PAGE_EXECUTE_READ));
+  }
+
+  {
+    hadesmem::MemorySnapshot snapshot(kSnapshotPath);
+    BOOST_TEST_THROWS(snapshot.Update(source), hadesmem::Error);
+  }
+
+  {
+    std::ofstream file(kSnapshotPathNarrow,
+                       std::ios::binary | std::ios::trunc);
+    file << "Not a snapshot.";
+  }
+  BOOST_TEST_THROWS(hadesmem::MemorySnapshot{kSnapshotPath}, hadesmem::Error);
+
+  std::remove(kSnapshotPathNarrow);
+}
+
+void TestMemorySnapshotProcess()
+{
+  std::size_t const kSize = 0x10000;
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  hadesmem::Process const process(::GetCurrentProcessId());
+  auto const address = static_cast<std::uint8_t*>(
+    ::VirtualAlloc(nullptr, kSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+  BOOST_TEST(address != nullptr);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  hadesmem::Process const process(static_cast<DWORD>(::getpid()));
+  auto const address = static_cast<std::uint8_t*>(
+    ::mmap(nullptr,
+           kSize,
+           PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS,
+           -1,
+           0));
+  BOOST_TEST(address != MAP_FAILED);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  address[0x1234] = 0x42;
+
+  hadesmem::ProcessScanSource const source(process);
+  hadesmem::MemorySnapshotOptions options;
+  options.start = reinterpret_cast<std::uintptr_t>(address);
+  options.end = options.start + kSize;
+
+  {
+    hadesmem::MemorySnapshot snapshot(source, kSnapshotPath, options);
+    BOOST_TEST_EQ(snapshot.GetRegionTable().size(), 1U);
+    std::uint8_t byte = 0;
+    BOOST_TEST(snapshot.Read(options.start + 0x1234, &byte, 1));
+    BOOST_TEST_EQ(byte, 0x42);
+
+    address[0x1234] = 0x43;
+    address[0x8000] = 0x44;
+    BOOST_TEST_EQ(snapshot.Update(source), 2U);
+  }
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  BOOST_TEST(::VirtualFree(address, 0, MEM_RELEASE));
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  BOOST_TEST(!::munmap(address, kSize));
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  std::remove(kSnapshotPathNarrow);
+}
+
+int main()
+{
+  TestMemorySnapshot();
+  TestMemorySnapshotProcess();
+  return boost::report_errors();
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/patch_ip_map.hpp>
+#include <hadesmem/detail/patch_ip_map.hpp>
+
+#include <cstddef>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+void TestPatchIpMapEmpty()
+{
+  hadesmem::detail::PatchIpMap const ip_map;
+  BOOST_TEST_EQ(ip_map.GetSize(), 0UL);
+  std::size_t trampoline_offset = 0x1234;
+  BOOST_TEST(!ip_map.Remap(0, trampoline_offset));
+  BOOST_TEST_EQ(trampoline_offset, 0x1234UL);
+}
+
+void TestPatchIpMapRemap()
+{
+  // push ebp (1), mov ebp, esp (2), jmp short (2 -> relocated to 5), nop (1).
+  hadesmem::detail::PatchIpMap ip_map;
+  ip_map.Add(0, 0);
+  ip_map.Add(1, 1);
+  ip_map.Add(3, 3);
+  ip_map.Add(5, 8);
+  BOOST_TEST_EQ(ip_map.GetSize(), 4UL);
+
+  std::size_t trampoline_offset = 0;
+  BOOST_TEST(ip_map.Remap(0, trampoline_offset));
+  BOOST_TEST_EQ(trampoline_offset, 0UL);
+  BOOST_TEST(ip_map.Remap(3, trampoline_offset));
+  BOOST_TEST_EQ(trampoline_offset, 3UL);
+  BOOST_TEST(ip_map.Remap(5, trampoline_offset));
+  BOOST_TEST_EQ(trampoline_offset, 8UL);
+
+  // Not an instruction boundary.
+  BOOST_TEST(!ip_map.Remap(2, trampoline_offset));
+  BOOST_TEST(!ip_map.Remap(4, trampoline_offset));
+  // Past the end of the relocated instructions.
+  BOOST_TEST(!ip_map.Remap(6, trampoline_offset));
+  BOOST_TEST_EQ(trampoline_offset, 8UL);
+
+  ip_map.Clear();
+  BOOST_TEST_EQ(ip_map.GetSize(), 0UL);
+  BOOST_TEST(!ip_map.Remap(0, trampoline_offset));
+}
+
+int main()
+{
+  TestPatchIpMapEmpty();
+  TestPatchIpMapRemap();
+  return boost::report_errors();
+}
@@ -0,0 +1,136 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/pe_checksum.hpp>
+#include <hadesmem/detail/pe_checksum.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+
+namespace
+{
+std::size_t const kLfanew = 0x80;
+std::size_t const kChecksumOffset = kLfanew + 88;
+
+std::vector<std::uint8_t> MakeTestFile(std::size_t size)
+{
+  std::vector<std::uint8_t> data(size);
+  std::uint32_t seed = 12345;
+  for (auto& b : data)
+  {
+    seed = seed * 1103515245 + 12345;
+    b = static_cast<std::uint8_t>(seed >> 16);
+  }
+
+  std::uint32_t const lfanew = kLfanew;
+  std::memcpy(&data[0x3C], &lfanew, sizeof(lfanew));
+  return data;
+}
+
+// Straight from the definition, with the checksum field read as zero rather
+// than skipped.
+std::uint32_t GetPeChecksumSimple(std::vector<std::uint8_t> const& data)
+{
+  auto const get_byte = [&](std::size_t i) -> std::uint32_t {
+    return (i >= kChecksumOffset && i < kChecksumOffset + 4) ? 0 : data[i];
+  };
+
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; i < data.size(); i += 2)
+  {
+    std::uint32_t word = get_byte(i);
+    if (i + 1 < data.size())
+    {
+      word |= get_byte(i + 1) << 8;
+    }
+    sum += word;
+    sum = (sum & 0xFFFF) + (sum >> 16);
+  }
+  return sum + static_cast<std::uint32_t>(data.size());
+}
+}
+
+void TestPeChecksum()
+{
+  for (std::size_t const size : {0x1000U, 0x1001U, 0x12345U})
+  {
+    auto const data = MakeTestFile(size);
+    auto const expected = GetPeChecksumSimple(data);
+
+    BOOST_TEST_EQ(hadesmem::detail::GetPeChecksumOffset(data.data(), size),
+                  kChecksumOffset);
+    BOOST_TEST_EQ(hadesmem::detail::GetPeChecksum(data.data(), size),
+                  expected);
+
+    // Odd sized pieces split words (and the checksum field) across calls.
+    for (std::size_t const piece : {1U, 3U, 7U, 0x1001U})
+    {
+      hadesmem::detail::PeChecksum checksum(kChecksumOffset);
+      for (std::size_t i = 0; i < size; i += piece)
+      {
+        checksum.Update(data.data() + i, (std::min)(piece, size - i));
+      }
+      BOOST_TEST_EQ(checksum.Final(), expected);
+    }
+  }
+
+  // The stored checksum doesn't affect the result.
+  auto data = MakeTestFile(0x1000);
+  auto const checksum = hadesmem::detail::GetPeChecksum(data.data(), 0x1000);
+  std::memcpy(&data[kChecksumOffset], &checksum, sizeof(checksum));
+  BOOST_TEST_EQ(hadesmem::detail::GetPeChecksum(data.data(), 0x1000),
+                checksum);
+}
+
+void TestFixPeChecksum()
+{
+  auto data = MakeTestFile(0x2345);
+  auto const checksum = hadesmem::detail::GetPeChecksum(data.data(), 0x2345);
+  BOOST_TEST(!hadesmem::detail::IsPeChecksumValid(data.data(), 0x2345));
+
+  BOOST_TEST(hadesmem::detail::FixPeChecksum(data.data(), 0x2345));
+  BOOST_TEST_EQ(hadesmem::detail::GetPeStoredChecksum(data.data(), 0x2345),
+                checksum);
+  BOOST_TEST(hadesmem::detail::IsPeChecksumValid(data.data(), 0x2345));
+
+  // Any change outside the checksum field invalidates it.
+  ++data[0x1000];
+  BOOST_TEST(!hadesmem::detail::IsPeChecksumValid(data.data(), 0x2345));
+
+  std::vector<std::uint8_t> no_headers(0x20);
+  BOOST_TEST(!hadesmem::detail::FixPeChecksum(no_headers.data(), 0x20));
+  BOOST_TEST_EQ(hadesmem::detail::GetPeStoredChecksum(no_headers.data(), 0x20),
+                0U);
+}
+
+void TestPeChecksumNoHeaders()
+{
+  std::vector<std::uint8_t> data(0x20, 0x01);
+  BOOST_TEST_EQ(hadesmem::detail::GetPeChecksumOffset(data.data(), 0x20), 0U);
+  BOOST_TEST_EQ(hadesmem::detail::GetPeChecksum(data.data(), 0x20),
+                0x0101U * 0x10 + 0x20);
+
+  // e_lfanew pointing past the end of the buffer.
+  auto const file = MakeTestFile(0x100);
+  BOOST_TEST_EQ(hadesmem::detail::GetPeChecksumOffset(file.data(), 0x100),
+                kChecksumOffset);
+  BOOST_TEST_EQ(hadesmem::detail::GetPeChecksumOffset(file.data(), 0xA0),
+                0U);
+}
+
+int main()
+{
+  TestPeChecksum();
+  TestPeChecksumNoHeaders();
+  TestFixPeChecksum();
+  return boost::report_errors();
+}
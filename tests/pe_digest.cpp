@@ -0,0 +1,316 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/pe_digest.hpp>
+#include <hadesmem/detail/pe_digest.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/crypto.hpp>
+#include <hadesmem/detail/pe_checksum.hpp>
+#include <hadesmem/error.hpp>
+
+namespace
+{
+std::size_t const kNtOffset = 0x80;
+std::size_t const kOptOffset = kNtOffset + 24;
+std::size_t const kHeadersSize = 0x400;
+
+// Module names, and the functions imported from each. Imports by ordinal if
+// the name is empty.
+using TestFunctions = std::vector<std::pair<std::string, WORD>>;
+using TestImports = std::vector<std::pair<std::string, TestFunctions>>;
+
+// A PE file (i.e. file layout) with a big .text section which spans more
+// than one of GetPeDigest's chunks, an .idata section holding the imports,
+// and a certificate table appended after the last section.
+class TestFile
+{
+public:
+  explicit TestFile(bool is_64) : is_64_{is_64}, data_(kHeadersSize)
+  {
+    Put16(0, 0x5A4D);
+    Put32(0x3C, kNtOffset);
+    Put32(kNtOffset, 0x00004550);
+    Put16(kNtOffset + 20,
+          static_cast<WORD>(GetDirsOffset() + 16 * 8 - kOptOffset));
+    Put16(kOptOffset, is_64_ ? 0x20B : 0x10B);
+    Put32(kOptOffset + 60, kHeadersSize);
+    Put32(kOptOffset + 64, 0xDEADBEEF);
+    Put32(GetDirsOffset() - 4, 16);
+
+    std::uint32_t seed = 12345;
+    text_ = AddSection(".text", 0x1000, 0x48000);
+    for (std::size_t i = text_.first; i < text_.first + text_.second; ++i)
+    {
+      seed = seed * 1103515245 + 12345;
+      data_[i] = static_cast<std::uint8_t>(seed >> 16);
+    }
+  }
+
+  void AddImports(TestImports const& modules)
+  {
+    DWORD const kIdataRva = 0x50000;
+    std::size_t const thunk_size = is_64_ ? 8 : 4;
+    std::vector<std::uint8_t> idata(0x1000);
+    std::size_t pos = (modules.size() + 1) * 20;
+    auto const put = [&](std::size_t offset, void const* p, std::size_t len) {
+      std::memcpy(&idata[offset], p, len);
+    };
+    for (std::size_t i = 0; i < modules.size(); ++i)
+    {
+      auto const& functions = modules[i].second;
+      std::size_t const int_offset = pos;
+      std::size_t const iat_offset =
+        int_offset + (functions.size() + 1) * thunk_size;
+      pos = iat_offset + (functions.size() + 1) * thunk_size;
+
+      for (std::size_t j = 0; j < functions.size(); ++j)
+      {
+        std::uint64_t thunk = 0;
+        if (functions[j].first.empty())
+        {
+          thunk = functions[j].second |
+                  (is_64_ ? 0x8000000000000000ULL : 0x80000000ULL);
+        }
+        else
+        {
+          thunk = kIdataRva + pos;
+          pos += 2;
+          put(pos, functions[j].first.c_str(), functions[j].first.size());
+          pos += functions[j].first.size() + 1;
+        }
+        put(int_offset + j * thunk_size, &thunk, thunk_size);
+        put(iat_offset + j * thunk_size, &thunk, thunk_size);
+      }
+
+      DWORD const name_rva = static_cast<DWORD>(kIdataRva + pos);
+      put(pos, modules[i].first.c_str(), modules[i].first.size());
+      pos += modules[i].first.size() + 1;
+
+      DWORD const oft = static_cast<DWORD>(kIdataRva + int_offset);
+      DWORD const ft = static_cast<DWORD>(kIdataRva + iat_offset);
+      put(i * 20, &oft, sizeof(oft));
+      put(i * 20 + 12, &name_rva, sizeof(name_rva));
+      put(i * 20 + 16, &ft, sizeof(ft));
+    }
+
+    auto const idata_range = AddSection(".idata", kIdataRva, idata.size());
+    std::memcpy(&data_[idata_range.first], idata.data(), idata.size());
+    Put32(GetDirsOffset() + 8, kIdataRva);
+    Put32(GetDirsOffset() + 12,
+          static_cast<DWORD>((modules.size() + 1) * 20));
+  }
+
+  void AddCertTable(std::size_t size)
+  {
+    cert_ = std::make_pair(data_.size(), size);
+    data_.resize(data_.size() + size, 0xCE);
+    Put32(GetDirsOffset() + 4 * 8, static_cast<DWORD>(cert_.first));
+    Put32(GetDirsOffset() + 4 * 8 + 4, static_cast<DWORD>(cert_.second));
+  }
+
+  void Put16(std::size_t offset, WORD value)
+  {
+    std::memcpy(&data_[offset], &value, sizeof(value));
+  }
+
+  void Put32(std::size_t offset, DWORD value)
+  {
+    std::memcpy(&data_[offset], &value, sizeof(value));
+  }
+
+  std::size_t GetDirsOffset() const noexcept
+  {
+    return kOptOffset + (is_64_ ? 112 : 96);
+  }
+
+  std::size_t GetSectionHeaderOffset(std::size_t index) const noexcept
+  {
+    return GetDirsOffset() + 16 * 8 + index * 40;
+  }
+
+  // File offset and size of the raw data.
+  std::pair<std::size_t, std::size_t> GetText() const noexcept
+  {
+    return text_;
+  }
+
+  std::pair<std::size_t, std::size_t> GetCert() const noexcept
+  {
+    return cert_;
+  }
+
+  std::vector<std::uint8_t>& GetData() noexcept
+  {
+    return data_;
+  }
+
+private:
+  std::pair<std::size_t, std::size_t>
+    AddSection(char const* name, DWORD rva, std::size_t size)
+  {
+    std::size_t const header = GetSectionHeaderOffset(num_sections_++);
+    Put16(kNtOffset + 6, static_cast<WORD>(num_sections_));
+    std::memcpy(&data_[header], name, std::strlen(name));
+    Put32(header + 8, static_cast<DWORD>(size));
+    Put32(header + 12, rva);
+    Put32(header + 16, static_cast<DWORD>(size));
+    Put32(header + 20, static_cast<DWORD>(data_.size()));
+    auto const range = std::make_pair(data_.size(), size);
+    data_.resize(data_.size() + size);
+    return range;
+  }
+
+  bool is_64_;
+  std::vector<std::uint8_t> data_;
+  std::size_t num_sections_{};
+  std::pair<std::size_t, std::size_t> text_;
+  std::pair<std::size_t, std::size_t> cert_;
+};
+
+TestImports GetTestImports()
+{
+  return {{"KERNEL32.dll", {{"GetLastError", 0}, {"", 42}}},
+          {"user32.DLL", {{"MessageBoxW", 0}}},
+          {"shell.ocx", {{"Foo", 0}}},
+          {"no_ext", {{"Bar", 0}}}};
+}
+
+std::wstring GetTestImpHash()
+{
+  std::string const expected = "kernel32.getlasterror,kernel32.ord42,"
+                               "user32.messageboxw,shell.foo,no_ext.bar";
+  return hadesmem::detail::ByteArrayToString(
+    hadesmem::detail::GetHash<hadesmem::detail::Md5>(expected.data(),
+                                                     expected.size()));
+}
+}
+
+void TestPeDigest(bool is_64)
+{
+  TestFile file{is_64};
+  file.AddImports(GetTestImports());
+  file.AddCertTable(0x80);
+  auto const& data = file.GetData();
+
+  auto const digest = hadesmem::detail::GetPeDigest(data.data(), data.size());
+  BOOST_TEST_EQ(digest.size, data.size());
+  BOOST_TEST(digest.sha1 ==
+             hadesmem::detail::GetHash<hadesmem::detail::Sha1>(data.data(),
+                                                               data.size()));
+  BOOST_TEST(digest.sha256 ==
+             hadesmem::detail::GetHash<hadesmem::detail::Sha256>(
+               data.data(), data.size()));
+  BOOST_TEST(digest.xxhash ==
+             hadesmem::detail::GetHash<hadesmem::detail::XxHash64>(
+               data.data(), data.size()));
+  BOOST_TEST_EQ(digest.checksum,
+                hadesmem::detail::GetPeChecksum(data.data(), data.size()));
+  BOOST_TEST_EQ(digest.header_checksum, 0xDEADBEEFUL);
+  BOOST_TEST(digest.imphash == GetTestImpHash());
+  BOOST_TEST(hadesmem::detail::GetImpHash(data.data(), data.size()) ==
+             GetTestImpHash());
+
+  BOOST_TEST_EQ(digest.sections.size(), 2UL);
+  auto const text = file.GetText();
+  BOOST_TEST_EQ(digest.sections[0].name, ".text");
+  BOOST_TEST_EQ(digest.sections[0].pointer_to_raw_data, text.first);
+  BOOST_TEST_EQ(digest.sections[0].size_of_raw_data, text.second);
+  BOOST_TEST(digest.sections[0].sha256 ==
+             hadesmem::detail::GetHash<hadesmem::detail::Sha256>(
+               data.data() + text.first, text.second));
+  BOOST_TEST_EQ(digest.sections[1].name, ".idata");
+
+  // Everything but the checksum, the certificate table directory entry and
+  // the certificate table itself.
+  std::size_t const checksum_offset = kOptOffset + 64;
+  std::size_t const cert_dir_offset = file.GetDirsOffset() + 4 * 8;
+  auto const cert = file.GetCert();
+  hadesmem::detail::Sha256 authenticode;
+  authenticode.Update(data.data(), checksum_offset);
+  authenticode.Update(data.data() + checksum_offset + 4,
+                      cert_dir_offset - checksum_offset - 4);
+  authenticode.Update(data.data() + cert_dir_offset + 8,
+                      cert.first - cert_dir_offset - 8);
+  BOOST_TEST_EQ(cert.first + cert.second, data.size());
+  BOOST_TEST(digest.authenticode_sha256 == authenticode.Final());
+
+  // Re-signing (i.e. changing the checksum and certificate) doesn't change
+  // the Authenticode digest, but changing the code does.
+  file.Put32(checksum_offset, 0x12345678);
+  file.GetData()[cert.first] ^= 0xFF;
+  auto const resigned =
+    hadesmem::detail::GetPeDigest(data.data(), data.size());
+  BOOST_TEST(resigned.authenticode_sha256 == digest.authenticode_sha256);
+  BOOST_TEST(resigned.sha256 != digest.sha256);
+  file.GetData()[text.first + 0x40000] ^= 0xFF;
+  auto const patched = hadesmem::detail::GetPeDigest(data.data(), data.size());
+  BOOST_TEST(patched.authenticode_sha256 != digest.authenticode_sha256);
+  BOOST_TEST(patched.sections[0].sha256 != digest.sections[0].sha256);
+}
+
+void TestPeDigestEdgeCases()
+{
+  // No imports, no certificate table, and a section running off the end of
+  // the file.
+  TestFile file{false};
+  auto& data = file.GetData();
+  data.resize(data.size() - 0x100);
+  file.Put32(file.GetDirsOffset() + 8, 0);
+
+  auto digest = hadesmem::detail::GetPeDigest(data.data(), data.size());
+  BOOST_TEST(digest.imphash.empty());
+  BOOST_TEST(hadesmem::detail::GetImpHash(data.data(), data.size()).empty());
+  BOOST_TEST_EQ(digest.sections[0].size_of_raw_data,
+                file.GetText().second - 0x100);
+
+  hadesmem::detail::Sha256 authenticode;
+  std::size_t const checksum_offset = kOptOffset + 64;
+  authenticode.Update(data.data(), checksum_offset);
+  authenticode.Update(data.data() + checksum_offset + 4,
+                      file.GetDirsOffset() + 4 * 8 - checksum_offset - 4);
+  authenticode.Update(data.data() + file.GetDirsOffset() + 5 * 8,
+                      data.size() - file.GetDirsOffset() - 5 * 8);
+  BOOST_TEST(digest.authenticode_sha256 == authenticode.Final());
+
+  // Malformed imports only lose the imphash.
+  TestFile bad_imports{true};
+  bad_imports.AddImports(GetTestImports());
+  bad_imports.Put32(bad_imports.GetDirsOffset() + 8, 0x7FFFFFF0);
+  auto const& bad_data = bad_imports.GetData();
+  digest = hadesmem::detail::GetPeDigest(bad_data.data(), bad_data.size());
+  BOOST_TEST(digest.imphash.empty());
+  BOOST_TEST(digest.sha256 ==
+             hadesmem::detail::GetHash<hadesmem::detail::Sha256>(
+               bad_data.data(), bad_data.size()));
+  BOOST_TEST_THROWS(
+    hadesmem::detail::GetImpHash(bad_data.data(), bad_data.size()),
+    hadesmem::Error);
+
+  // Not a PE file at all.
+  std::vector<std::uint8_t> not_pe(0x1000, 0x90);
+  BOOST_TEST_THROWS(
+    hadesmem::detail::GetPeDigest(not_pe.data(), not_pe.size()),
+    hadesmem::Error);
+  BOOST_TEST_THROWS(hadesmem::detail::GetPeDigest(not_pe.data(), 0x20),
+                    hadesmem::Error);
+}
+
+int main()
+{
+  TestPeDigest(false);
+  TestPeDigest(true);
+  TestPeDigestEdgeCases();
+  return boost::report_errors();
+}
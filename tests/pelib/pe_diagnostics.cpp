@@ -0,0 +1,429 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+#include <hadesmem/pelib/pe_diagnostics.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/module.hpp>
+#include <hadesmem/module_list.hpp>
+#include <hadesmem/pelib/export_list.hpp>
+#include <hadesmem/pelib/import_dir.hpp>
+#include <hadesmem/pelib/import_dir_list.hpp>
+#include <hadesmem/pelib/import_thunk.hpp>
+#include <hadesmem/pelib/import_thunk_list.hpp>
+#include <hadesmem/pelib/pe_file.hpp>
+#include <hadesmem/pelib/relocation_block_list.hpp>
+#include <hadesmem/process.hpp>
+
+// Export something to ensure tests pass...
+extern "C" __declspec(dllexport) void Dummy();
+extern "C" __declspec(dllexport) void Dummy()
+{
+}
+
+namespace
+{
+// A PE32 file with a single section whose file offset is the same as its
+// RVA, so the same buffer can be parsed as either a data file or an image,
+// and 'truncating' it is just a matter of passing a smaller size to PeFile.
+class TestFile
+{
+public:
+  TestFile() : data_(kSectionRva * 2)
+  {
+    IMAGE_DOS_HEADER dos_header{};
+    dos_header.e_magic = IMAGE_DOS_SIGNATURE;
+    dos_header.e_lfanew = kNtHeadersOffset;
+    Put(0, dos_header);
+
+    IMAGE_NT_HEADERS32 nt_headers{};
+    nt_headers.Signature = IMAGE_NT_SIGNATURE;
+    nt_headers.FileHeader.Machine = IMAGE_FILE_MACHINE_I386;
+    nt_headers.FileHeader.NumberOfSections = 1;
+    nt_headers.FileHeader.SizeOfOptionalHeader =
+      sizeof(IMAGE_OPTIONAL_HEADER32);
+    nt_headers.OptionalHeader.Magic = IMAGE_NT_OPTIONAL_HDR32_MAGIC;
+    nt_headers.OptionalHeader.FileAlignment = 0x200;
+    nt_headers.OptionalHeader.SectionAlignment = kSectionRva;
+    nt_headers.OptionalHeader.SizeOfImage = kSectionRva * 2;
+    nt_headers.OptionalHeader.SizeOfHeaders = 0x400;
+    nt_headers.OptionalHeader.NumberOfRvaAndSizes =
+      IMAGE_NUMBEROF_DIRECTORY_ENTRIES;
+    Put(kNtHeadersOffset, nt_headers);
+
+    IMAGE_SECTION_HEADER section{};
+    section.VirtualAddress = kSectionRva;
+    section.Misc.VirtualSize = kSectionRva;
+    section.PointerToRawData = kSectionRva;
+    section.SizeOfRawData = kSectionRva;
+    Put(kNtHeadersOffset + sizeof(nt_headers), section);
+  }
+
+  template <typename T> void Put(DWORD rva, T const& value)
+  {
+    std::memcpy(&data_[rva], &value, sizeof(value));
+  }
+
+  void PutString(DWORD rva, char const* str)
+  {
+    std::memcpy(&data_[rva], str, std::strlen(str) + 1);
+  }
+
+  void SetDataDir(DWORD index, DWORD rva, DWORD size)
+  {
+    DWORD const data_dir_offset =
+      kNtHeadersOffset + offsetof(IMAGE_NT_HEADERS32, OptionalHeader) +
+      offsetof(IMAGE_OPTIONAL_HEADER32, DataDirectory) +
+      index * sizeof(IMAGE_DATA_DIRECTORY);
+    Put(data_dir_offset, IMAGE_DATA_DIRECTORY{rva, size});
+  }
+
+  void* GetBase() noexcept
+  {
+    return data_.data();
+  }
+
+  DWORD GetSize() const noexcept
+  {
+    return static_cast<DWORD>(data_.size());
+  }
+
+  static DWORD const kSectionRva = 0x1000;
+
+private:
+  static DWORD const kNtHeadersOffset = 0x40;
+
+  std::vector<std::uint8_t> data_;
+};
+
+// Two exports by name ("Foo" and "Bar").
+DWORD const kExportDirRva = 0x1400;
+DWORD const kExportFunctionsRva = 0x1440;
+DWORD const kExportNamesRva = 0x1450;
+DWORD const kExportOrdinalsRva = 0x1460;
+
+void PutExports(TestFile& file, DWORD ordinal_base = 1)
+{
+  IMAGE_EXPORT_DIRECTORY export_dir{};
+  export_dir.Base = ordinal_base;
+  export_dir.NumberOfFunctions = 2;
+  export_dir.NumberOfNames = 2;
+  export_dir.AddressOfFunctions = kExportFunctionsRva;
+  export_dir.AddressOfNames = kExportNamesRva;
+  export_dir.AddressOfNameOrdinals = kExportOrdinalsRva;
+  file.Put(kExportDirRva, export_dir);
+  file.SetDataDir(
+    IMAGE_DIRECTORY_ENTRY_EXPORT, kExportDirRva, sizeof(export_dir));
+
+  file.Put(kExportFunctionsRva, DWORD{0x1010});
+  file.Put(kExportFunctionsRva + 4, DWORD{0x1020});
+  file.Put(kExportNamesRva, DWORD{0x1480});
+  file.Put(kExportNamesRva + 4, DWORD{0x1490});
+  file.Put(kExportOrdinalsRva, WORD{0});
+  file.Put(kExportOrdinalsRva + 2, WORD{1});
+  file.PutString(0x1480, "Foo");
+  file.PutString(0x1490, "Bar");
+}
+
+std::size_t CountExports(hadesmem::Process const& process,
+                         hadesmem::PeFile const& pe_file)
+{
+  hadesmem::ExportList const exports(process, pe_file);
+  return static_cast<std::size_t>(
+    std::distance(std::begin(exports), std::end(exports)));
+}
+
+bool HasOnly(hadesmem::PeDiagnostics const& diagnostics,
+             hadesmem::PeDiagnosticCode code,
+             hadesmem::PeComponent component,
+             DWORD rva)
+{
+  return diagnostics.GetSize() == 1 && diagnostics[0].code == code &&
+         diagnostics[0].component == component && diagnostics[0].rva == rva;
+}
+}
+
+void TestPeDiagnosticsList()
+{
+  hadesmem::PeDiagnostics diagnostics;
+  BOOST_TEST(diagnostics.IsEmpty());
+  BOOST_TEST(!diagnostics.Has(hadesmem::PeComponent::kImports));
+
+  diagnostics.Add(hadesmem::PeDiagnosticCode::kDirInvalid,
+                  hadesmem::PeComponent::kImports,
+                  0x1000);
+  diagnostics.Add(hadesmem::PeDiagnosticCode::kDirInvalid,
+                  hadesmem::PeComponent::kImports,
+                  0x1000);
+  BOOST_TEST_EQ(diagnostics.GetSize(), 1UL);
+  BOOST_TEST(diagnostics.Has(hadesmem::PeComponent::kImports));
+  BOOST_TEST(diagnostics.Has(hadesmem::PeDiagnosticCode::kDirInvalid));
+  BOOST_TEST(!diagnostics.Has(hadesmem::PeComponent::kExports));
+  BOOST_TEST(!diagnostics.Has(hadesmem::PeDiagnosticCode::kEntryInvalid));
+
+  // Past the inline storage and across several chunks.
+  std::size_t const count = hadesmem::PeDiagnostics::kInlineSize +
+                            hadesmem::PeDiagnostics::kChunkSize * 2 + 1;
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    diagnostics.Add(hadesmem::PeDiagnosticCode::kEntryInvalid,
+                    hadesmem::PeComponent::kRelocations,
+                    static_cast<DWORD>(i));
+  }
+  BOOST_TEST_EQ(diagnostics.GetSize(), count);
+  BOOST_TEST(!diagnostics.IsTruncated());
+  BOOST_TEST(diagnostics[0].code == hadesmem::PeDiagnosticCode::kDirInvalid);
+  BOOST_TEST_EQ(diagnostics[0].rva, 0x1000UL);
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    BOOST_TEST(diagnostics[i].component ==
+               hadesmem::PeComponent::kRelocations);
+    BOOST_TEST_EQ(diagnostics[i].rva, static_cast<DWORD>(i));
+  }
+
+  diagnostics.Clear();
+  BOOST_TEST(diagnostics.IsEmpty());
+  diagnostics.Add(hadesmem::PeDiagnosticCode::kOrdinalOverflow,
+                  hadesmem::PeComponent::kExports,
+                  0);
+  BOOST_TEST_EQ(diagnostics.GetSize(), 1UL);
+  BOOST_TEST(diagnostics[0].code ==
+             hadesmem::PeDiagnosticCode::kOrdinalOverflow);
+
+  std::size_t const max_size = hadesmem::PeDiagnostics::kMaxSize;
+  for (std::size_t i = 0; i < max_size + 1; ++i)
+  {
+    diagnostics.Add(hadesmem::PeDiagnosticCode::kEntryOverflow,
+                    hadesmem::PeComponent::kBoundImports,
+                    static_cast<DWORD>(i));
+  }
+  BOOST_TEST_EQ(diagnostics.GetSize(), max_size);
+  BOOST_TEST(diagnostics.IsTruncated());
+}
+
+void TestPeDiagnosticsWellFormed()
+{
+  hadesmem::Process const process(::GetCurrentProcessId());
+
+  // Loaded modules are well formed, so walking them shouldn't find anything.
+  hadesmem::ModuleList modules(process);
+  for (auto const& mod : modules)
+  {
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(process,
+                                   mod.GetHandle(),
+                                   hadesmem::PeFileType::kImage,
+                                   0,
+                                   &diagnostics);
+    BOOST_TEST(pe_file.GetDiagnostics() == &diagnostics);
+
+    hadesmem::ExportList const exports(process, pe_file);
+    for (auto const& e : exports)
+    {
+      (void)e;
+    }
+
+    hadesmem::ImportDirList const import_dirs(process, pe_file);
+    for (auto const& dir : import_dirs)
+    {
+      hadesmem::ImportThunkList const thunks(
+        process, pe_file, dir.GetFirstThunk());
+      for (auto const& thunk : thunks)
+      {
+        (void)thunk;
+      }
+    }
+
+    hadesmem::RelocationBlockList const reloc_blocks(process, pe_file);
+    for (auto const& block : reloc_blocks)
+    {
+      (void)block;
+    }
+
+    BOOST_TEST(diagnostics.IsEmpty());
+  }
+}
+
+void TestPeDiagnosticsImports(hadesmem::PeFileType type)
+{
+  hadesmem::Process const process(::GetCurrentProcessId());
+
+  DWORD const import_dir_rva = 0x1100;
+  DWORD const desc_size = sizeof(IMAGE_IMPORT_DESCRIPTOR);
+  DWORD const thunks_rva = 0x1200;
+  TestFile file;
+  IMAGE_IMPORT_DESCRIPTOR desc{};
+  desc.OriginalFirstThunk = thunks_rva;
+  desc.Name = 0x1300;
+  desc.FirstThunk = thunks_rva;
+  file.Put(import_dir_rva, desc);
+  file.SetDataDir(IMAGE_DIRECTORY_ENTRY_IMPORT, import_dir_rva, 0);
+  file.Put(thunks_rva, DWORD{0x1310});
+  file.Put(thunks_rva + 4, DWORD{0x1320});
+  file.PutString(0x1300, "test.dll");
+
+  // File ends part way through the second descriptor.
+  {
+    hadesmem::PeDiagnostics diagnostics;
+    DWORD const size = import_dir_rva + desc_size + 8;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, size, &diagnostics);
+    hadesmem::ImportDirList const import_dirs(process, pe_file);
+    BOOST_TEST_EQ(std::distance(std::begin(import_dirs), std::end(import_dirs)),
+                  1);
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kEntryOutOfBounds,
+                       hadesmem::PeComponent::kImports,
+                       import_dir_rva + desc_size));
+  }
+
+  // File ends part way through the first descriptor.
+  {
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, import_dir_rva + 8, &diagnostics);
+    hadesmem::ImportDirList const import_dirs(process, pe_file);
+    BOOST_TEST(std::begin(import_dirs) == std::end(import_dirs));
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kEntryOutOfBounds,
+                       hadesmem::PeComponent::kImports,
+                       import_dir_rva));
+  }
+
+  // File ends part way through the second thunk.
+  {
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, thunks_rva + 6, &diagnostics);
+    hadesmem::ImportThunkList const thunks(process, pe_file, thunks_rva);
+    BOOST_TEST_EQ(std::distance(std::begin(thunks), std::end(thunks)), 1);
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kEntryOutOfBounds,
+                       hadesmem::PeComponent::kImports,
+                       thunks_rva + 4));
+  }
+
+  // Terminator is entirely past the end of a data file, so it's in the zero
+  // fill of the section once mapped, which is fine.
+  if (type == hadesmem::PeFileType::kData)
+  {
+    hadesmem::PeDiagnostics diagnostics;
+    DWORD const size = import_dir_rva + desc_size;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, size, &diagnostics);
+    hadesmem::ImportDirList const import_dirs(process, pe_file);
+    BOOST_TEST_EQ(std::distance(std::begin(import_dirs), std::end(import_dirs)),
+                  1);
+    BOOST_TEST(diagnostics.IsEmpty());
+  }
+}
+
+void TestPeDiagnosticsExports(hadesmem::PeFileType type)
+{
+  hadesmem::Process const process(::GetCurrentProcessId());
+
+  // Well formed.
+  {
+    TestFile file;
+    PutExports(file);
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, file.GetSize(), &diagnostics);
+    BOOST_TEST_EQ(CountExports(process, pe_file), 2UL);
+    BOOST_TEST(diagnostics.IsEmpty());
+  }
+
+  // Second name is past the end of the file.
+  {
+    TestFile file;
+    PutExports(file);
+    file.Put(kExportNamesRva + 4, DWORD{0x1F00});
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, 0x1800, &diagnostics);
+    BOOST_TEST_EQ(CountExports(process, pe_file), 1UL);
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kEntryInvalid,
+                       hadesmem::PeComponent::kExports,
+                       kExportNamesRva + 4));
+  }
+
+  // Second name ordinal is past the end of the function table, so the
+  // function is still exported, but only by ordinal.
+  {
+    TestFile file;
+    PutExports(file);
+    file.Put(kExportOrdinalsRva + 2, WORD{7});
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, file.GetSize(), &diagnostics);
+    hadesmem::ExportList const exports(process, pe_file);
+    std::size_t by_ordinal = 0;
+    for (auto const& e : exports)
+    {
+      by_ordinal += e.ByOrdinal() ? 1 : 0;
+    }
+    BOOST_TEST_EQ(by_ordinal, 1UL);
+    BOOST_TEST_EQ(CountExports(process, pe_file), 2UL);
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kOrdinalOutOfBounds,
+                       hadesmem::PeComponent::kExports,
+                       kExportOrdinalsRva + 2));
+  }
+
+  // Function table runs off the end of the file.
+  {
+    TestFile file;
+    PutExports(file);
+    IMAGE_EXPORT_DIRECTORY export_dir{};
+    std::memcpy(&export_dir,
+                static_cast<std::uint8_t*>(file.GetBase()) + kExportDirRva,
+                sizeof(export_dir));
+    export_dir.NumberOfFunctions = 0x1000;
+    file.Put(kExportDirRva, export_dir);
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, file.GetSize(), &diagnostics);
+    BOOST_TEST_EQ(CountExports(process, pe_file), 0UL);
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kEntryOutOfBounds,
+                       hadesmem::PeComponent::kExports,
+                       kExportFunctionsRva));
+  }
+
+  // Procedure numbers wrap around after the first export.
+  {
+    TestFile file;
+    PutExports(file, 0xFFFF);
+    hadesmem::PeDiagnostics diagnostics;
+    hadesmem::PeFile const pe_file(
+      process, file.GetBase(), type, file.GetSize(), &diagnostics);
+    BOOST_TEST_EQ(CountExports(process, pe_file), 1UL);
+    BOOST_TEST(HasOnly(diagnostics,
+                       hadesmem::PeDiagnosticCode::kOrdinalOverflow,
+                       hadesmem::PeComponent::kExports,
+                       kExportDirRva));
+  }
+}
+
+int main()
+{
+  TestPeDiagnosticsList();
+  TestPeDiagnosticsWellFormed();
+  TestPeDiagnosticsImports(hadesmem::PeFileType::kData);
+  TestPeDiagnosticsImports(hadesmem::PeFileType::kImage);
+  TestPeDiagnosticsExports(hadesmem::PeFileType::kData);
+  TestPeDiagnosticsExports(hadesmem::PeFileType::kImage);
+  return boost::report_errors();
+}
@@ -0,0 +1,110 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/pointer_scanner.hpp>
+#include <hadesmem/pointer_scanner.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/scanner.hpp>
+
+namespace
+{
+std::uintptr_t const kModuleBase = 0x400000;
+std::uintptr_t const kHeapBase = 0x10000000;
+
+void WritePointer(std::vector<std::uint8_t>& buffer,
+                  std::size_t offset,
+                  std::uintptr_t value)
+{
+  std::memcpy(&buffer[offset], &value, sizeof(value));
+}
+}
+
+void TestPointerScanner()
+{
+  // [[game.exe+0x100]+0x20]+0x10 and [game.exe+0x200]+0x8 both lead to the
+  // target. The heap also contains a self-referencing pointer, which must
+  // not cause the search to loop.
+  std::vector<std::uint8_t> module(0x1000);
+  std::vector<std::uint8_t> heap(0x10000);
+  std::uintptr_t const target = kHeapBase + 0x8010;
+  WritePointer(module, 0x100, kHeapBase + 0x4000);
+  WritePointer(module, 0x200, kHeapBase + 0x8008);
+  WritePointer(heap, 0x4020, kHeapBase + 0x8000);
+  WritePointer(heap, 0x6000, kHeapBase + 0x6000);
+  WritePointer(heap, 0x8000, kHeapBase + 0x6000);
+
+  hadesmem::BufferScanSource source;
+  source.AddBuffer(kModuleBase, module.data(), module.size(), PAGE_READONLY);
+  source.AddBuffer(kHeapBase, heap.data(), heap.size());
+
+  hadesmem::PointerScanOptions options;
+  options.max_depth = 3;
+  options.max_offset = 0x100;
+  options.buffer_size = 0x1000;
+  options.num_threads = 4;
+  hadesmem::PointerIndex const index(source, options);
+  BOOST_TEST_EQ(index.size(), 5U);
+
+  std::vector<hadesmem::PointerScanModule> const modules = {
+    {L"game.exe", kModuleBase, module.size()}};
+  auto const paths =
+    hadesmem::FindPointerPaths(index, modules, target, options);
+  BOOST_TEST_EQ(paths.size(), 2U);
+  if (paths.size() != 2U)
+  {
+    return;
+  }
+
+  BOOST_TEST(paths[0].module == L"game.exe");
+  BOOST_TEST_EQ(paths[0].module_offset, 0x200U);
+  BOOST_TEST_EQ(paths[0].offsets.size(), 1U);
+  BOOST_TEST(paths[1].offsets == (std::vector<std::uintptr_t>{0x20, 0x10}));
+
+  auto const str = hadesmem::FormatPointerPath(paths[1]);
+  BOOST_TEST(str == L"[[game.exe+0x100]+0x20]+0x10");
+  BOOST_TEST(hadesmem::ParsePointerPath(str) == paths[1]);
+  BOOST_TEST(hadesmem::ParsePointerPath(L"game.exe+0x10").offsets.empty());
+  BOOST_TEST_THROWS(hadesmem::ParsePointerPath(L"[game.exe+0x10"),
+                    hadesmem::Error);
+  BOOST_TEST_THROWS(hadesmem::ParsePointerPath(L"[game.exe+10]+0x8"),
+                    hadesmem::Error);
+
+  for (auto const& path : paths)
+  {
+    std::uintptr_t address = 0;
+    BOOST_TEST(hadesmem::ResolvePointerPath(source, modules, path, address));
+    BOOST_TEST_EQ(address, target);
+  }
+
+  // Simulate the heap moving between runs of the target.
+  WritePointer(heap, 0x4020, kHeapBase + 0x9000);
+  std::uintptr_t address = 0;
+  BOOST_TEST(hadesmem::ResolvePointerPath(source, modules, paths[1], address));
+  BOOST_TEST_EQ(address, kHeapBase + 0x9010);
+
+  hadesmem::PointerPath unknown_module = paths[0];
+  unknown_module.module = L"other.dll";
+  BOOST_TEST(
+    !hadesmem::ResolvePointerPath(source, modules, unknown_module, address));
+
+  options.max_depth = 1;
+  BOOST_TEST_EQ(
+    hadesmem::FindPointerPaths(index, modules, target, options).size(), 1U);
+}
+
+int main()
+{
+  TestPointerScanner();
+  return boost::report_errors();
+}
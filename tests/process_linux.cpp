@@ -0,0 +1,214 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/process.hpp>
+#include <hadesmem/process.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/read.hpp>
+#include <hadesmem/region.hpp>
+#include <hadesmem/region_list.hpp>
+#include <hadesmem/write.hpp>
+
+// Exercises the Linux backend (process_vm_readv/writev, /proc/<pid>/mem and
+// /proc/<pid>/maps) against the current process. The Windows backend is
+// covered by the existing per-API tests.
+
+#if defined(HADESMEM_DETAIL_OS_LINUX)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+std::size_t const kPageSize = 0x1000;
+
+// Three pages (read-write, read-only, no access) with a reserved page either
+// side, so the kernel never merges them with a neighbouring mapping.
+class TestPages
+{
+public:
+  TestPages()
+  {
+    void* const reservation = ::mmap(nullptr,
+                                     kPageSize * 5,
+                                     PROT_NONE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS,
+                                     -1,
+                                     0);
+    BOOST_TEST(reservation != MAP_FAILED);
+    reservation_ = static_cast<std::uint8_t*>(reservation);
+    BOOST_TEST(!::mprotect(GetReadWrite(), kPageSize, PROT_READ | PROT_WRITE));
+    GetReadWrite()[0] = 0x11;
+    BOOST_TEST(!::mprotect(GetReadOnly(), kPageSize, PROT_READ | PROT_WRITE));
+    GetReadOnly()[0] = 0x22;
+    BOOST_TEST(!::mprotect(GetReadOnly(), kPageSize, PROT_READ));
+  }
+
+  TestPages(TestPages const&) = delete;
+
+  TestPages& operator=(TestPages const&) = delete;
+
+  ~TestPages()
+  {
+    ::munmap(reservation_, kPageSize * 5);
+  }
+
+  std::uint8_t* GetReadWrite() const noexcept
+  {
+    return reservation_ + kPageSize;
+  }
+
+  std::uint8_t* GetReadOnly() const noexcept
+  {
+    return reservation_ + kPageSize * 2;
+  }
+
+  std::uint8_t* GetNoAccess() const noexcept
+  {
+    return reservation_ + kPageSize * 3;
+  }
+
+private:
+  std::uint8_t* reservation_{};
+};
+
+hadesmem::Process GetCurrentProcess()
+{
+  return hadesmem::Process(static_cast<DWORD>(::getpid()));
+}
+}
+
+void TestProcessLinux()
+{
+  hadesmem::Process const process(GetCurrentProcess());
+  BOOST_TEST_EQ(process.GetId(), static_cast<DWORD>(::getpid()));
+
+  hadesmem::Process const copy(process);
+  BOOST_TEST_EQ(copy.GetId(), process.GetId());
+
+  BOOST_TEST_THROWS(hadesmem::Process(0), hadesmem::Error);
+}
+
+void TestReadWriteLinux()
+{
+  hadesmem::Process const process(GetCurrentProcess());
+  TestPages const pages;
+
+  std::uint32_t value = 0x12345678;
+  BOOST_TEST_EQ(hadesmem::Read<std::uint32_t>(process, &value), value);
+  hadesmem::Write(process, &value, std::uint32_t{0xDEADBEEF});
+  BOOST_TEST_EQ(value, 0xDEADBEEFU);
+
+  std::vector<int> const ints = {1, 2, 3, 4, 5};
+  hadesmem::WriteVector(process, pages.GetReadWrite() + 0x10, ints);
+  BOOST_TEST(hadesmem::ReadVector<int>(
+               process, pages.GetReadWrite() + 0x10, ints.size()) == ints);
+
+  std::string const str = "Hello, world!";
+  hadesmem::WriteString(process, pages.GetReadWrite() + 0x100, str);
+  BOOST_TEST_EQ(hadesmem::ReadString<char>(process,
+                                           pages.GetReadWrite() + 0x100),
+                str);
+
+  // Spans the read-write and read-only pages in a single call.
+  auto const span = hadesmem::ReadVector<std::uint8_t>(
+    process, pages.GetReadOnly() - 2, 3);
+  BOOST_TEST_EQ(span[2], 0x22);
+
+  // Writes through the mem file ignore page protections, like the Windows
+  // backend temporarily changing them, and leave the protection alone.
+  hadesmem::Write(process, pages.GetReadOnly(), std::uint8_t{0x33});
+  BOOST_TEST_EQ(pages.GetReadOnly()[0], 0x33);
+  BOOST_TEST_EQ(hadesmem::Region(process, pages.GetReadOnly()).GetProtect(),
+                static_cast<DWORD>(PAGE_READONLY));
+
+  // Anonymous PROT_NONE mappings are reservations, which can be zero filled.
+  auto const reserved = hadesmem::ReadVectorEx<std::uint8_t>(
+    process, pages.GetNoAccess(), 0x10, hadesmem::ReadFlags::kZeroFillReserved);
+  BOOST_TEST(reserved == std::vector<std::uint8_t>(0x10));
+
+  void* const unmapped = ::mmap(
+    nullptr, kPageSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  BOOST_TEST(unmapped != MAP_FAILED);
+  BOOST_TEST(!::munmap(unmapped, kPageSize));
+  BOOST_TEST_THROWS(hadesmem::Read<std::uint8_t>(process, unmapped),
+                    hadesmem::Error);
+  BOOST_TEST_THROWS(hadesmem::Write(process, unmapped, std::uint8_t{0}),
+                    hadesmem::Error);
+}
+
+void TestRegionListLinux()
+{
+  hadesmem::Process const process(GetCurrentProcess());
+  TestPages const pages;
+
+  bool found_read_write = false;
+  bool found_read_only = false;
+  bool found_no_access = false;
+  std::uintptr_t prev_end = 0;
+  for (auto const& region : hadesmem::RegionList(process))
+  {
+    auto const base = reinterpret_cast<std::uintptr_t>(region.GetBase());
+    // Gaps are reported as free regions, so the walk is contiguous.
+    BOOST_TEST_EQ(base, prev_end);
+    BOOST_TEST(region.GetSize() != 0);
+    prev_end = base + region.GetSize();
+
+    if (region.GetBase() == pages.GetReadWrite())
+    {
+      found_read_write = true;
+      BOOST_TEST_EQ(region.GetSize(), kPageSize);
+      BOOST_TEST_EQ(region.GetState(), static_cast<DWORD>(MEM_COMMIT));
+      BOOST_TEST_EQ(region.GetProtect(), static_cast<DWORD>(PAGE_READWRITE));
+      BOOST_TEST_EQ(region.GetType(), static_cast<DWORD>(MEM_PRIVATE));
+    }
+    else if (region.GetBase() == pages.GetReadOnly())
+    {
+      found_read_only = true;
+      BOOST_TEST_EQ(region.GetProtect(), static_cast<DWORD>(PAGE_READONLY));
+    }
+    else if (region.GetBase() == pages.GetNoAccess())
+    {
+      found_no_access = true;
+      BOOST_TEST_EQ(region.GetState(), static_cast<DWORD>(MEM_RESERVE));
+    }
+  }
+  BOOST_TEST(found_read_write);
+  BOOST_TEST(found_read_only);
+  BOOST_TEST(found_no_access);
+
+  // The executable is a loaded image.
+  hadesmem::Region const code{
+    process, reinterpret_cast<void const*>(&TestRegionListLinux)};
+  BOOST_TEST_EQ(code.GetType(), static_cast<DWORD>(MEM_IMAGE));
+  BOOST_TEST(code.GetProtect() == PAGE_EXECUTE_READ ||
+             code.GetProtect() == PAGE_EXECUTE_READWRITE);
+}
+
+int main()
+{
+  TestProcessLinux();
+  TestReadWriteLinux();
+  TestRegionListLinux();
+  return boost::report_errors();
+}
+
+#else // #if defined(HADESMEM_DETAIL_OS_LINUX)
+
+int main()
+{
+  return boost::report_errors();
+}
+
+#endif // #if defined(HADESMEM_DETAIL_OS_LINUX)
@@ -0,0 +1,243 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/region_snapshot.hpp>
+#include <hadesmem/region_snapshot.hpp>
+
+#include <algorithm>
+
+#include <sstream>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/detail/linux_maps.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+#include <hadesmem/region.hpp>
+#include <hadesmem/region_list.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <windows.h>
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+namespace
+{
+MEMORY_BASIC_INFORMATION MakeMbi(std::uintptr_t base,
+                                 std::size_t size,
+                                 DWORD protect,
+                                 std::uintptr_t alloc_base = 0)
+{
+  MEMORY_BASIC_INFORMATION mbi{};
+  mbi.BaseAddress = reinterpret_cast<PVOID>(base);
+  mbi.AllocationBase = reinterpret_cast<PVOID>(alloc_base ? alloc_base : base);
+  mbi.RegionSize = size;
+  mbi.State = MEM_COMMIT;
+  mbi.Protect = protect;
+  mbi.Type = MEM_PRIVATE;
+  return mbi;
+}
+
+hadesmem::Process GetCurrentProcess()
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return hadesmem::Process(::GetCurrentProcessId());
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return hadesmem::Process(static_cast<DWORD>(::getpid()));
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+
+std::size_t const kAllocSize = 0x10000;
+
+void* AllocPages()
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return ::VirtualAlloc(
+    nullptr, kAllocSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  // Reserve a page either side, so the mapping is never merged with its
+  // neighbours (which would change its allocation base).
+  void* const reservation = ::mmap(nullptr,
+                                   kAllocSize + 0x2000,
+                                   PROT_NONE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS,
+                                   -1,
+                                   0);
+  if (reservation == MAP_FAILED)
+  {
+    return nullptr;
+  }
+  void* const address = static_cast<char*>(reservation) + 0x1000;
+  return ::mprotect(address, kAllocSize, PROT_READ | PROT_WRITE) ? nullptr
+                                                                   : address;
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+
+bool ProtectFirstPageReadOnly(void* address)
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  DWORD old_protect = 0;
+  return !!::VirtualProtect(address, 0x1000, PAGE_READONLY, &old_protect);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return !::mprotect(address, 0x1000, PROT_READ);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+
+bool FreePages(void* address)
+{
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return !!::VirtualFree(address, 0, MEM_RELEASE);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  return !::munmap(static_cast<char*>(address) - 0x1000, kAllocSize + 0x2000);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+}
+}
+
+void TestRegionSnapshot()
+{
+  hadesmem::Process const process(GetCurrentProcess());
+
+  hadesmem::RegionSnapshot const snapshot(process);
+  BOOST_TEST(!snapshot.empty());
+
+  std::size_t num_regions = 0;
+  for (auto const& region : hadesmem::RegionList(process))
+  {
+    if (region.GetState() == MEM_FREE)
+    {
+      continue;
+    }
+
+    auto const record = snapshot.Find(region.GetBase());
+    BOOST_TEST(record != nullptr);
+    if (record)
+    {
+      BOOST_TEST_EQ(record->base,
+                    reinterpret_cast<std::uintptr_t>(region.GetBase()));
+      BOOST_TEST_EQ(record->size, region.GetSize());
+      BOOST_TEST_EQ(record->protect, region.GetProtect());
+    }
+
+    ++num_regions;
+  }
+  BOOST_TEST_EQ(snapshot.size(), num_regions);
+
+  BOOST_TEST(snapshot.Find(nullptr) == nullptr);
+}
+
+void TestRegionSnapshotDiff()
+{
+  std::vector<MEMORY_BASIC_INFORMATION> const old_regions = {
+    MakeMbi(0x10000, 0x2000, PAGE_READWRITE),
+    MakeMbi(0x20000, 0x1000, PAGE_READONLY),
+    MakeMbi(0x30000, 0x1000, PAGE_READWRITE)};
+  std::vector<MEMORY_BASIC_INFORMATION> const new_regions = {
+    MakeMbi(0x10000, 0x1000, PAGE_READWRITE),
+    MakeMbi(0x11000, 0x1000, PAGE_EXECUTE_READ, 0x10000),
+    MakeMbi(0x30000, 0x1000, PAGE_READWRITE, 0x2F000),
+    MakeMbi(0x40000, 0x3000, PAGE_READWRITE)};
+
+  hadesmem::RegionSnapshot const old_snapshot(std::begin(old_regions),
+                                              std::end(old_regions));
+  hadesmem::RegionSnapshot const new_snapshot(std::begin(new_regions),
+                                              std::end(new_regions));
+
+  auto const diff = hadesmem::Diff(old_snapshot, new_snapshot);
+  BOOST_TEST_EQ(diff.protect_changed.size(), 1U);
+  BOOST_TEST(diff.protect_changed[0] ==
+             (hadesmem::RegionRange{0x11000, 0x1000}));
+  BOOST_TEST_EQ(diff.removed.size(), 2U);
+  BOOST_TEST(diff.removed[0] == (hadesmem::RegionRange{0x20000, 0x1000}));
+  BOOST_TEST(diff.removed[1] == (hadesmem::RegionRange{0x30000, 0x1000}));
+  BOOST_TEST_EQ(diff.added.size(), 2U);
+  BOOST_TEST(diff.added[0] == (hadesmem::RegionRange{0x30000, 0x1000}));
+  BOOST_TEST(diff.added[1] == (hadesmem::RegionRange{0x40000, 0x3000}));
+
+  auto const reverse_diff = hadesmem::Diff(new_snapshot, old_snapshot);
+  BOOST_TEST_EQ(reverse_diff.added.size(), 2U);
+  BOOST_TEST_EQ(reverse_diff.removed.size(), 2U);
+  BOOST_TEST(reverse_diff.removed[1] ==
+             (hadesmem::RegionRange{0x40000, 0x3000}));
+
+  BOOST_TEST(hadesmem::Diff(old_snapshot, old_snapshot).Empty());
+  hadesmem::RegionSnapshot const empty_snapshot;
+  BOOST_TEST(hadesmem::Diff(empty_snapshot, empty_snapshot).Empty());
+}
+
+void TestRegionSnapshotMaps()
+{
+  std::istringstream maps{
+    "00400000-00401000 r-xp 00000000 08:01 42 /usr/bin/test\n"
+    "00401000-00403000 rw-p 00001000 08:01 42 /usr/bin/test\n"
+    "7f0000000000-7f0000010000 ---p 00000000 00:00 0\n"
+    "7ffd00000000-7ffd00021000 rw-p 00000000 00:00 0 [stack]\n"};
+  auto const regions = hadesmem::detail::ParseLinuxMaps(maps);
+  hadesmem::RegionSnapshot const snapshot(std::begin(regions),
+                                          std::end(regions));
+  BOOST_TEST_EQ(snapshot.size(), 4U);
+  BOOST_TEST_EQ(snapshot[0].type, static_cast<DWORD>(MEM_IMAGE));
+  BOOST_TEST_EQ(snapshot[1].alloc_base, 0x400000U);
+  BOOST_TEST_EQ(snapshot[2].state, static_cast<DWORD>(MEM_RESERVE));
+  BOOST_TEST_EQ(snapshot[3].type, static_cast<DWORD>(MEM_PRIVATE));
+}
+
+void TestRegionSnapshotRefresh()
+{
+  hadesmem::Process const process(GetCurrentProcess());
+
+  hadesmem::RegionSnapshot old_snapshot(process);
+
+  void* const address = AllocPages();
+  BOOST_TEST(address != nullptr);
+  auto const address_num = reinterpret_cast<std::uintptr_t>(address);
+
+  hadesmem::RegionSnapshot new_snapshot(process);
+  hadesmem::RegionDiff diff;
+  hadesmem::Diff(old_snapshot, new_snapshot, diff);
+  BOOST_TEST(std::any_of(std::begin(diff.added),
+                         std::end(diff.added),
+                         [&](hadesmem::RegionRange const& range)
+                         {
+                           return address_num >= range.base &&
+                                  address_num < range.base + range.size;
+                         }));
+
+  BOOST_TEST(ProtectFirstPageReadOnly(address));
+
+  old_snapshot = new_snapshot;
+  new_snapshot.Refresh(process);
+  hadesmem::Diff(old_snapshot, new_snapshot, diff);
+  BOOST_TEST(std::find(std::begin(diff.protect_changed),
+                       std::end(diff.protect_changed),
+                       (hadesmem::RegionRange{address_num, 0x1000})) !=
+             std::end(diff.protect_changed));
+
+  BOOST_TEST(FreePages(address));
+
+  old_snapshot = new_snapshot;
+  new_snapshot.Refresh(process);
+  hadesmem::Diff(old_snapshot, new_snapshot, diff);
+  BOOST_TEST(std::any_of(std::begin(diff.removed),
+                         std::end(diff.removed),
+                         [&](hadesmem::RegionRange const& range)
+                         {
+                           return address_num >= range.base &&
+                                  address_num + kAllocSize <=
+                                    range.base + range.size;
+                         }));
+}
+
+int main()
+{
+  TestRegionSnapshot();
+  TestRegionSnapshotDiff();
+  TestRegionSnapshotMaps();
+  TestRegionSnapshotRefresh();
+  return boost::report_errors();
+}
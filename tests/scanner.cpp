@@ -0,0 +1,227 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/scanner.hpp>
+#include <hadesmem/scanner.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/process.hpp>
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <windows.h>
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+
+namespace
+{
+std::uintptr_t const kBufferBase = 0x10000000;
+
+template <typename T> void TestScannerType(T value, T other)
+{
+  std::vector<T> buffer(0x3000, other);
+  std::vector<std::size_t> const indices = {0, 1, 17, 0x1000, 0x2FFF};
+  for (auto const i : indices)
+  {
+    buffer[i] = value;
+  }
+
+  hadesmem::BufferScanSource source;
+  source.AddBuffer(kBufferBase, buffer.data(), buffer.size() * sizeof(T));
+
+  hadesmem::ScanOptions options;
+  options.buffer_size = 0x1000;
+  options.num_threads = 4;
+  hadesmem::Scanner<T> scanner(source, options);
+
+  scanner.First(hadesmem::ScanFilter::kEqual, value);
+  auto const results = scanner.GetResults();
+  BOOST_TEST_EQ(results.size(), indices.size());
+  for (std::size_t i = 0; i < results.size() && i < indices.size(); ++i)
+  {
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(results[i].address),
+                  kBufferBase + indices[i] * sizeof(T));
+    BOOST_TEST(results[i].value == value);
+  }
+
+  scanner.First(hadesmem::ScanFilter::kNotEqual, value);
+  BOOST_TEST_EQ(scanner.GetCount(), buffer.size() - indices.size());
+
+  buffer[17] = other;
+  scanner.First(hadesmem::ScanFilter::kEqual, value);
+  BOOST_TEST_EQ(scanner.GetCount(), indices.size() - 1);
+}
+}
+
+void TestScannerTypes()
+{
+  TestScannerType<std::int8_t>(-5, 7);
+  TestScannerType<std::uint16_t>(0xBEEF, 0xBEEE);
+  TestScannerType<std::int32_t>(-1337, 1337);
+  TestScannerType<std::uint64_t>(0xDEADBEEF00000001ULL, 0xDEADBEEF00000000ULL);
+  TestScannerType<float>(1.5f, -1.5f);
+  TestScannerType<double>(-0.25, 0.25);
+}
+
+void TestScannerNext()
+{
+  std::vector<std::uint32_t> buffer(0x4000);
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    buffer[i] = static_cast<std::uint32_t>(i);
+  }
+
+  hadesmem::BufferScanSource source;
+  source.AddBuffer(
+    kBufferBase, buffer.data(), buffer.size() * sizeof(buffer[0]));
+
+  hadesmem::ScanOptions options;
+  options.buffer_size = 0x2000;
+  hadesmem::Scanner<std::uint32_t> scanner(source, options);
+
+  scanner.First(hadesmem::ScanFilter::kUnknown);
+  BOOST_TEST_EQ(scanner.GetCount(), buffer.size());
+
+  scanner.Next(hadesmem::ScanFilter::kUnchanged);
+  BOOST_TEST_EQ(scanner.GetCount(), buffer.size());
+
+  buffer[10] += 1;
+  buffer[0x1234] -= 1;
+  buffer[0x3FFF] += 5;
+  scanner.Next(hadesmem::ScanFilter::kChanged);
+  BOOST_TEST_EQ(scanner.GetCount(), 3U);
+
+  scanner.Next(hadesmem::ScanFilter::kUnknown);
+  buffer[10] += 1;
+  buffer[0x1234] -= 1;
+  scanner.Next(hadesmem::ScanFilter::kIncreased);
+  auto results = scanner.GetResults();
+  BOOST_TEST_EQ(results.size(), 1U);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(results[0].address),
+                kBufferBase + 10 * sizeof(buffer[0]));
+  BOOST_TEST_EQ(results[0].value, 12U);
+
+  scanner.First(hadesmem::ScanFilter::kLess, 0x100);
+  BOOST_TEST_EQ(scanner.GetCount(), 0x100U);
+  buffer[0x20] = 0x1000;
+  scanner.Next(hadesmem::ScanFilter::kUnchanged);
+  BOOST_TEST_EQ(scanner.GetCount(), 0xFFU);
+  buffer[0x30] = 0;
+  scanner.Next(hadesmem::ScanFilter::kDecreased);
+  BOOST_TEST_EQ(scanner.GetCount(), 1U);
+  scanner.Next(hadesmem::ScanFilter::kEqual, 0);
+  BOOST_TEST_EQ(scanner.GetCount(), 1U);
+  scanner.Next(hadesmem::ScanFilter::kGreater, 0);
+  BOOST_TEST_EQ(scanner.GetCount(), 0U);
+
+  scanner.Reset();
+  BOOST_TEST_EQ(scanner.GetCount(), 0U);
+
+  BOOST_TEST_THROWS(scanner.First(hadesmem::ScanFilter::kChanged),
+                    hadesmem::Error);
+}
+
+void TestScannerOptions()
+{
+  std::vector<std::uint8_t> buffer(0x1000);
+  std::uint32_t const value = 0x12345678;
+  std::memcpy(&buffer[0x101], &value, sizeof(value));
+  std::memcpy(&buffer[0xFFC], &value, sizeof(value));
+
+  std::vector<std::uint8_t> read_only(buffer);
+
+  hadesmem::BufferScanSource source;
+  source.AddBuffer(kBufferBase, buffer.data(), buffer.size());
+  source.AddBuffer(
+    kBufferBase + 0x10000, read_only.data(), read_only.size(), PAGE_READONLY);
+
+  hadesmem::ScanOptions options;
+  hadesmem::Scanner<std::uint32_t> aligned_scanner(source, options);
+  aligned_scanner.First(hadesmem::ScanFilter::kEqual, value);
+  BOOST_TEST_EQ(aligned_scanner.GetCount(), 1U);
+
+  options.alignment = 1;
+  hadesmem::Scanner<std::uint32_t> unaligned_scanner(source, options);
+  unaligned_scanner.First(hadesmem::ScanFilter::kEqual, value);
+  BOOST_TEST_EQ(unaligned_scanner.GetCount(), 2U);
+
+  options.protection = hadesmem::ScanProtection::kRead;
+  hadesmem::Scanner<std::uint32_t> read_scanner(source, options);
+  read_scanner.First(hadesmem::ScanFilter::kEqual, value);
+  BOOST_TEST_EQ(read_scanner.GetCount(), 4U);
+
+  options.start = kBufferBase + 0x200;
+  hadesmem::Scanner<std::uint32_t> range_scanner(source, options);
+  range_scanner.First(hadesmem::ScanFilter::kEqual, value);
+  BOOST_TEST_EQ(range_scanner.GetCount(), 3U);
+
+  options.alignment = 3;
+  BOOST_TEST_THROWS(hadesmem::Scanner<std::uint32_t>(source, options),
+                    hadesmem::Error);
+}
+
+void TestScannerProcess()
+{
+  std::size_t const kSize = 0x40000;
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  hadesmem::Process const process(::GetCurrentProcessId());
+  auto const address = static_cast<std::uint64_t*>(
+    ::VirtualAlloc(nullptr, kSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+  BOOST_TEST(address != nullptr);
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  hadesmem::Process const process(static_cast<DWORD>(::getpid()));
+  auto const address = static_cast<std::uint64_t*>(
+    ::mmap(nullptr,
+           kSize,
+           PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS,
+           -1,
+           0));
+  BOOST_TEST(address != MAP_FAILED);
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  std::uint64_t const value = 0xCAFEBABEDEADBEEFULL;
+  address[3] = value;
+  address[0x1000] = value;
+  address[kSize / sizeof(value) - 1] = value;
+
+  hadesmem::ProcessScanSource const source(process);
+  hadesmem::ScanOptions options;
+  options.buffer_size = 0x10000;
+  options.start = reinterpret_cast<std::uintptr_t>(address);
+  options.end = options.start + kSize;
+  hadesmem::Scanner<std::uint64_t> scanner(source, options);
+  scanner.First(hadesmem::ScanFilter::kEqual, value);
+  BOOST_TEST_EQ(scanner.GetCount(), 3U);
+
+  address[0x1000] = 0;
+  scanner.Next(hadesmem::ScanFilter::kUnchanged);
+  BOOST_TEST_EQ(scanner.GetCount(), 2U);
+
+#if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  BOOST_TEST(::VirtualFree(address, 0, MEM_RELEASE));
+#else // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  BOOST_TEST(!::munmap(address, kSize));
+#endif // #if defined(HADESMEM_DETAIL_OS_WINDOWS)
+  scanner.Next(hadesmem::ScanFilter::kUnchanged);
+  BOOST_TEST_EQ(scanner.GetCount(), 0U);
+}
+
+int main()
+{
+  TestScannerTypes();
+  TestScannerNext();
+  TestScannerOptions();
+  TestScannerProcess();
+  return boost::report_errors();
+}
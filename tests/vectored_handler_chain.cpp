@@ -0,0 +1,327 @@
+// Copyright (C) 2010-2015 Joshua Boyce
+// See the file COPYING for copying permission.
+
+#include <hadesmem/detail/vectored_handler_chain.hpp>
+#include <hadesmem/detail/vectored_handler_chain.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hadesmem/detail/warning_disable_prefix.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <hadesmem/detail/warning_disable_suffix.hpp>
+
+#include <hadesmem/config.hpp>
+#include <hadesmem/error.hpp>
+#include <hadesmem/scanner.hpp>
+
+namespace
+{
+// Counts reads, to check the walk only touches each page once.
+class CountingScanSource : public hadesmem::ScanSource
+{
+public:
+  explicit CountingScanSource(hadesmem::ScanSource const& source)
+    : source_{&source}
+  {
+  }
+
+  virtual void GetRegions(hadesmem::RegionSnapshot& snapshot) const override
+  {
+    source_->GetRegions(snapshot);
+  }
+
+  virtual bool
+    Read(std::uintptr_t address, void* data, std::size_t len) const override
+  {
+    ++num_reads_;
+    return source_->Read(address, data, len);
+  }
+
+  std::size_t GetNumReads() const noexcept
+  {
+    return num_reads_;
+  }
+
+private:
+  hadesmem::ScanSource const* source_;
+  mutable std::size_t num_reads_{};
+};
+
+// A captured ntdll data page holding the list head, plus a heap page holding
+// the entries, laid out the way the loader does it.
+class TestChain
+{
+public:
+  TestChain(hadesmem::detail::VectoredHandlerLayout const& layout,
+            std::uint32_t cookie)
+    : layout_(layout), cookie_{cookie}, ntdll_(0x1000), heap_(0x1000)
+  {
+    // Empty list, i.e. the head points at itself.
+    PutPointer(ntdll_, kListOffset + PtrSize(), GetHead());
+    PutPointer(ntdll_, kListOffset + PtrSize() * 2, GetHead());
+  }
+
+  void AddHandler(std::uint64_t handler)
+  {
+    std::size_t const entry_offset = entries_.size() * 0x40;
+    std::uint64_t const entry = kHeapBase + entry_offset;
+    std::uint64_t const prev = entries_.empty() ? GetHead() : entries_.back();
+    PutPointer(heap_, entry_offset, GetHead());
+    PutPointer(heap_, entry_offset + PtrSize(), prev);
+    PutPointer(heap_,
+               entry_offset + layout_.handler_offset,
+               hadesmem::detail::EncodeVectoredHandlerPointer(
+                 handler, cookie_, layout_.is_64));
+    if (entries_.empty())
+    {
+      PutPointer(ntdll_, kListOffset + PtrSize(), entry);
+    }
+    else
+    {
+      PutPointer(
+        heap_, static_cast<std::size_t>(entries_.back() - kHeapBase), entry);
+    }
+    PutPointer(ntdll_, kListOffset + PtrSize() * 2, entry);
+    entries_.push_back(entry);
+  }
+
+  // Overwrites the forward link of the given entry.
+  void SetNext(std::size_t index, std::uint64_t next)
+  {
+    PutPointer(
+      heap_, static_cast<std::size_t>(entries_[index] - kHeapBase), next);
+  }
+
+  void AddTo(hadesmem::BufferScanSource& source) const
+  {
+    source.AddBuffer(kNtdllBase, ntdll_.data(), ntdll_.size());
+    source.AddBuffer(kHeapBase, heap_.data(), heap_.size());
+  }
+
+  std::uintptr_t GetList() const noexcept
+  {
+    return static_cast<std::uintptr_t>(kNtdllBase + kListOffset);
+  }
+
+  std::vector<std::uint64_t> const& GetEntries() const noexcept
+  {
+    return entries_;
+  }
+
+  static std::uint64_t const kNtdllBase = 0x7FF00000;
+  static std::uint64_t const kHeapBase = 0x00500000;
+
+private:
+  static std::size_t const kListOffset = 0x3A0;
+
+  std::size_t PtrSize() const noexcept
+  {
+    return layout_.is_64 ? 8 : 4;
+  }
+
+  std::uint64_t GetHead() const noexcept
+  {
+    return kNtdllBase + kListOffset + PtrSize();
+  }
+
+  void PutPointer(std::vector<std::uint8_t>& page,
+                  std::size_t offset,
+                  std::uint64_t value) const
+  {
+    std::memcpy(&page[offset], &value, PtrSize());
+  }
+
+  hadesmem::detail::VectoredHandlerLayout layout_;
+  std::uint32_t cookie_;
+  std::vector<std::uint8_t> ntdll_;
+  std::vector<std::uint8_t> heap_;
+  std::vector<std::uint64_t> entries_;
+};
+
+bool ReadThrows(hadesmem::ScanSource const& source,
+                std::uintptr_t list,
+                std::uint32_t cookie,
+                hadesmem::detail::VectoredHandlerLayout const& layout)
+{
+  try
+  {
+    hadesmem::detail::ReadVectoredHandlerChain(source, list, cookie, layout);
+  }
+  catch (hadesmem::Error const& /*e*/)
+  {
+    return true;
+  }
+
+  return false;
+}
+}
+
+void TestPointerEncoding()
+{
+  std::uint32_t const cookies[] = {0, 1, 0x1F, 0x20, 0x3F, 0xDEADBEEF};
+  std::uint64_t const ptrs[] = {0, 0x401000, 0x7FFE12345678, 0xFFFFFFFF};
+  for (auto const cookie : cookies)
+  {
+    for (bool const is_64 : {false, true})
+    {
+      std::vector<std::uint64_t> encoded;
+      for (auto const ptr : ptrs)
+      {
+        encoded.push_back(
+          hadesmem::detail::EncodeVectoredHandlerPointer(ptr, cookie, is_64));
+      }
+      hadesmem::detail::DecodeVectoredHandlerPointers(
+        encoded.data(), encoded.size(), cookie, is_64);
+      for (std::size_t i = 0; i < encoded.size(); ++i)
+      {
+        std::uint64_t const expected =
+          is_64 ? ptrs[i] : static_cast<std::uint32_t>(ptrs[i]);
+        BOOST_TEST_EQ(encoded[i], expected);
+      }
+    }
+  }
+
+  // Known value, i.e. ror64(ptr ^ cookie, cookie & 0x3F).
+  BOOST_TEST_EQ(
+    hadesmem::detail::EncodeVectoredHandlerPointer(0x1000, 0x104, true),
+    0x4000000000000110ULL);
+  BOOST_TEST_EQ(
+    hadesmem::detail::EncodeVectoredHandlerPointer(0x1, 0x1, false),
+    0x0ULL);
+}
+
+void TestModuleIntervalTable()
+{
+  hadesmem::detail::ModuleIntervalTable modules;
+  modules.Add(0x20000, 0x1000, L"b.dll");
+  modules.Add(0x10000, 0x1000, L"a.dll");
+  modules.Add(0x30000, 0x8000, L"c.dll");
+  modules.Finalize();
+  BOOST_TEST_EQ(modules.GetSize(), 3UL);
+
+  auto const a = modules.Find(0x10000);
+  BOOST_TEST(a != hadesmem::detail::kNoModuleIndex);
+  BOOST_TEST(modules.GetName(a) == L"a.dll");
+  BOOST_TEST_EQ(modules.GetBase(a), 0x10000UL);
+  BOOST_TEST(modules.GetName(modules.Find(0x20FFF)) == L"b.dll");
+  BOOST_TEST(modules.GetName(modules.Find(0x37000)) == L"c.dll");
+  BOOST_TEST_EQ(modules.Find(0xFFFF), hadesmem::detail::kNoModuleIndex);
+  BOOST_TEST_EQ(modules.Find(0x11000), hadesmem::detail::kNoModuleIndex);
+  BOOST_TEST_EQ(modules.Find(0x38000), hadesmem::detail::kNoModuleIndex);
+
+  hadesmem::detail::ModuleIntervalTable const empty;
+  BOOST_TEST_EQ(empty.Find(0x10000), hadesmem::detail::kNoModuleIndex);
+}
+
+void TestReadChain(bool is_64, bool is_win8_or_later)
+{
+  auto const layout =
+    hadesmem::detail::GetVectoredHandlerLayout(is_64, is_win8_or_later);
+  std::uint32_t const cookie = 0x5A17C0DE;
+
+  hadesmem::detail::ModuleIntervalTable modules;
+  modules.Add(0x10000000, 0x10000, L"first.dll");
+  modules.Add(0x20000000, 0x10000, L"second.exe");
+  modules.Finalize();
+
+  TestChain chain{layout, cookie};
+  hadesmem::BufferScanSource buffers;
+  chain.AddTo(buffers);
+
+  auto handlers = hadesmem::detail::ReadVectoredHandlerChain(
+    buffers, chain.GetList(), cookie, layout, &modules);
+  BOOST_TEST(handlers.empty());
+
+  chain.AddHandler(0x20001234);
+  chain.AddHandler(0x10000010);
+  chain.AddHandler(0x00401000);
+
+  CountingScanSource counting{buffers};
+  handlers = hadesmem::detail::ReadVectoredHandlerChain(
+    counting, chain.GetList(), cookie, layout, &modules);
+  BOOST_TEST_EQ(handlers.size(), 3UL);
+  // One read for the list head's page and one for the heap page.
+  BOOST_TEST_EQ(counting.GetNumReads(), 2UL);
+
+  auto const& entries = chain.GetEntries();
+  for (std::size_t i = 0; i < handlers.size(); ++i)
+  {
+    BOOST_TEST_EQ(handlers[i].entry, entries[i]);
+  }
+  BOOST_TEST_EQ(handlers[0].handler, 0x20001234UL);
+  BOOST_TEST(modules.GetName(handlers[0].module) == L"second.exe");
+  BOOST_TEST_EQ(handlers[1].handler, 0x10000010UL);
+  BOOST_TEST(modules.GetName(handlers[1].module) == L"first.dll");
+  BOOST_TEST_EQ(handlers[2].handler, 0x00401000UL);
+  BOOST_TEST_EQ(handlers[2].module, hadesmem::detail::kNoModuleIndex);
+
+  // Without a module table nothing is resolved.
+  handlers = hadesmem::detail::ReadVectoredHandlerChain(
+    buffers, chain.GetList(), cookie, layout);
+  BOOST_TEST_EQ(handlers.size(), 3UL);
+  BOOST_TEST_EQ(handlers[0].module, hadesmem::detail::kNoModuleIndex);
+
+  // Wrong cookie means garbage handlers, but the walk itself still works.
+  handlers = hadesmem::detail::ReadVectoredHandlerChain(
+    buffers, chain.GetList(), cookie ^ 0x1234, layout);
+  BOOST_TEST_EQ(handlers.size(), 3UL);
+  BOOST_TEST(handlers[0].handler != 0x20001234UL);
+}
+
+void TestReadChainInvalid()
+{
+  auto const layout = hadesmem::detail::GetVectoredHandlerLayout(true, true);
+  std::uint32_t const cookie = 0x1234;
+
+  // List head not captured.
+  {
+    hadesmem::BufferScanSource buffers;
+    BOOST_TEST(ReadThrows(buffers, 0x1000, cookie, layout));
+  }
+
+  // Cyclic chain which never gets back to the head.
+  {
+    TestChain chain{layout, cookie};
+    chain.AddHandler(0x401000);
+    chain.AddHandler(0x402000);
+    chain.SetNext(1, chain.GetEntries()[0]);
+    hadesmem::BufferScanSource buffers;
+    chain.AddTo(buffers);
+    BOOST_TEST(ReadThrows(buffers, chain.GetList(), cookie, layout));
+  }
+
+  // Null link.
+  {
+    TestChain chain{layout, cookie};
+    chain.AddHandler(0x401000);
+    chain.SetNext(0, 0);
+    hadesmem::BufferScanSource buffers;
+    chain.AddTo(buffers);
+    BOOST_TEST(ReadThrows(buffers, chain.GetList(), cookie, layout));
+  }
+
+  // Link into memory which wasn't captured.
+  {
+    TestChain chain{layout, cookie};
+    chain.AddHandler(0x401000);
+    chain.SetNext(0, 0x900000);
+    hadesmem::BufferScanSource buffers;
+    chain.AddTo(buffers);
+    BOOST_TEST(ReadThrows(buffers, chain.GetList(), cookie, layout));
+  }
+}
+
+int main()
+{
+  TestPointerEncoding();
+  TestModuleIntervalTable();
+  TestReadChain(false, false);
+  TestReadChain(false, true);
+  TestReadChain(true, false);
+  TestReadChain(true, true);
+  TestReadChainInvalid();
+  return boost::report_errors();
+}